@@ -7,11 +7,94 @@
 #include <chrono>    // Para std::chrono::system_clock
 #include <ctime>     // Para std::localtime, std::time_t
 #include <cstring>   // Para std::strncpy, std::memcpy
+#include <cstddef>   // Para size_t
+#include "../data_storage/cabeceras_bloques.h"
+#include "../data_storage/gestor_wal.h"
+
+namespace {
+
+// Formato binario de las entradas del catálogo
+constexpr uint8_t TIPO_ENTRADA_LONGITUD_FIJA = 1;
+constexpr uint8_t TIPO_ENTRADA_LONGITUD_VARIABLE = 2;
+constexpr uint32_t MAGIC_DIRECTORIO_CATALOGO = 0x54414342; // "BCAT"
+constexpr uint32_t VERSION_CATALOGO_BINARIO = 1;
+constexpr uint32_t ID_DIRECTORIO = 0;
+constexpr size_t CAPACIDAD_BLOQUE_CATALOGO = BLOCK_SIZE - sizeof(CabeceraComun) - sizeof(CabeceraBloqueCatalogo);
+
+template <typename T>
+void EscribirValor(std::vector<Byte>& destino, T valor) {
+    const Byte* bytes = reinterpret_cast<const Byte*>(&valor);
+    destino.insert(destino.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool LeerValor(const Byte*& cursor, const Byte* fin, T& valor) {
+    if (static_cast<size_t>(fin - cursor) < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&valor, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+void EscribirTexto(std::vector<Byte>& destino, const std::string& texto) {
+    EscribirValor<uint16_t>(destino, static_cast<uint16_t>(texto.size()));
+    destino.insert(destino.end(), texto.begin(), texto.end());
+}
+
+bool LeerTexto(const Byte*& cursor, const Byte* fin, std::string& texto) {
+    uint16_t longitud = 0;
+    if (!LeerValor(cursor, fin, longitud) || static_cast<size_t>(fin - cursor) < longitud) {
+        return false;
+    }
+    texto.assign(cursor, cursor + longitud);
+    cursor += longitud;
+    return true;
+}
+
+void EscribirLista(std::vector<Byte>& destino, const std::vector<uint32_t>& valores) {
+    EscribirValor<uint32_t>(destino, static_cast<uint32_t>(valores.size()));
+    for (uint32_t valor : valores) {
+        EscribirValor<uint32_t>(destino, valor);
+    }
+}
+
+bool LeerLista(const Byte*& cursor, const Byte* fin, std::vector<uint32_t>& valores) {
+    uint32_t numero = 0;
+    if (!LeerValor(cursor, fin, numero) || static_cast<size_t>(fin - cursor) / sizeof(uint32_t) < numero) {
+        return false;
+    }
+    valores.resize(numero);
+    for (uint32_t& valor : valores) {
+        LeerValor(cursor, fin, valor);
+    }
+    return true;
+}
+
+/**
+ * FNV-1a de 64 bits: detecta si una entrada o un bloque cambió desde la última escritura.
+ */
+uint64_t Huella(const Byte* datos, size_t longitud) {
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < longitud; ++i) {
+        h ^= static_cast<uint8_t>(datos[i]);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+uint32_t ChecksumEntrada(uint64_t huella) {
+    return static_cast<uint32_t>(huella ^ (huella >> 32));
+}
+
+} // namespace
 
 // ===== IMPLEMENTACIÓN DE MetadataTabla (Clase Base) =====
 
 MetadataTabla::MetadataTabla(const std::string& nombre_tabla, uint32_t id_tabla)
-    : nombre_tabla_(nombre_tabla), id_tabla_(id_tabla), numero_registros_(0) {
+    : nombre_tabla_(nombre_tabla), id_tabla_(id_tabla), numero_registros_(0),
+      id_mapa_espacio_libre_(INVALID_PAGE_ID), version_estructura_(0),
+      formato_almacenamiento_(FormatoAlmacenamiento::FILAS), codificacion_ligera_(true) {
     // Constructor base - inicializa valores comunes
 }
 
@@ -43,6 +126,7 @@ Status MetadataTabla::AñadirColumna(const std::string& nombre_columna, ColumnTy
 
     // Añadir la columna al esquema
     esquema_tabla_.push_back(nueva_columna);
+    version_estructura_++;
 
     std::cout << "Columna '" << nombre_columna << "' añadida a la tabla '" << nombre_tabla_ << "'." << std::endl;
     return Status::OK;
@@ -65,6 +149,13 @@ std::string MetadataTabla::SerializarMetadataComun() const {
     ss << "ID_TABLA:" << id_tabla_ << std::endl;
     ss << "NUMERO_REGISTROS:" << numero_registros_ << std::endl;
     ss << "NUMERO_COLUMNAS:" << esquema_tabla_.size() << std::endl;
+    if (id_mapa_espacio_libre_ != INVALID_PAGE_ID) {
+        ss << "MAPA_ESPACIO_LIBRE:" << id_mapa_espacio_libre_ << std::endl;
+    }
+    if (formato_almacenamiento_ != FormatoAlmacenamiento::FILAS) {
+        ss << "FORMATO_ALMACENAMIENTO:" << static_cast<int>(formato_almacenamiento_) << ":"
+           << (codificacion_ligera_ ? 1 : 0) << std::endl;
+    }
     
     // Serializar esquema de columnas
     ss << "ESQUEMA_INICIO" << std::endl;
@@ -130,6 +221,13 @@ Status MetadataTabla::DeserializarMetadataComun(const std::string& contenido) {
                     id_tabla_ = std::stoul(valor);
                 } else if (clave == "NUMERO_REGISTROS") {
                     numero_registros_ = std::stoul(valor);
+                } else if (clave == "MAPA_ESPACIO_LIBRE") {
+                    id_mapa_espacio_libre_ = std::stoul(valor);
+                } else if (clave == "FORMATO_ALMACENAMIENTO") {
+                    // FORMATO_ALMACENAMIENTO:formato:codificacion_ligera
+                    size_t separador = valor.find(':');
+                    formato_almacenamiento_ = static_cast<FormatoAlmacenamiento>(std::stoi(valor.substr(0, separador)));
+                    codificacion_ligera_ = separador == std::string::npos || valor.substr(separador + 1) != "0";
                 }
             }
         }
@@ -138,6 +236,145 @@ Status MetadataTabla::DeserializarMetadataComun(const std::string& contenido) {
     return Status::OK;
 }
 
+void MetadataTabla::AñadirPaginaDatos(PageId id_pagina) {
+    if (!extensiones_.empty()) {
+        // La siguiente reservada, o la contigua a una extensión ya llena
+        ExtensionPaginas& ultima = extensiones_.back();
+        if (id_pagina == ultima.primera_pagina + ultima.paginas_usadas) {
+            ultima.paginas_usadas++;
+            ultima.numero_paginas = std::max(ultima.numero_paginas, ultima.paginas_usadas);
+            paginas_datos_.push_back(id_pagina);
+            version_estructura_++;
+            return;
+        }
+    }
+    extensiones_.push_back(ExtensionPaginas{id_pagina, 1, 1});
+    paginas_datos_.push_back(id_pagina);
+    version_estructura_++;
+}
+
+void MetadataTabla::AñadirExtension(PageId primera_pagina, uint32_t numero_paginas) {
+    extensiones_.push_back(ExtensionPaginas{primera_pagina, numero_paginas, 0});
+    version_estructura_++;
+}
+
+PageId MetadataTabla::ObtenerPaginaReservada() const {
+    if (extensiones_.empty() || extensiones_.back().paginas_usadas == extensiones_.back().numero_paginas) {
+        return INVALID_PAGE_ID;
+    }
+    return extensiones_.back().primera_pagina + extensiones_.back().paginas_usadas;
+}
+
+uint32_t MetadataTabla::ObtenerNumeroPaginasAsignadas() const {
+    uint32_t total = 0;
+    for (const auto& extension : extensiones_) {
+        total += extension.numero_paginas;
+    }
+    return total;
+}
+
+void MetadataTabla::SerializarBinario(std::vector<Byte>& destino) const {
+    EscribirValor<uint8_t>(destino, EsLongitudFija() ? TIPO_ENTRADA_LONGITUD_FIJA : TIPO_ENTRADA_LONGITUD_VARIABLE);
+    EscribirValor<uint32_t>(destino, id_tabla_);
+    EscribirTexto(destino, nombre_tabla_);
+    EscribirValor<uint32_t>(destino, numero_registros_);
+    EscribirValor<BlockId>(destino, id_mapa_espacio_libre_);
+
+    EscribirValor<uint32_t>(destino, static_cast<uint32_t>(esquema_tabla_.size()));
+    for (const auto& columna : esquema_tabla_) {
+        EscribirTexto(destino, columna.name);
+        EscribirValor<uint8_t>(destino, static_cast<uint8_t>(columna.type));
+        EscribirValor<uint32_t>(destino, columna.size);
+        EscribirValor<uint8_t>(destino, static_cast<uint8_t>((columna.is_primary_key ? 1 : 0) | (columna.is_nullable ? 2 : 0)));
+    }
+
+    SerializarBinarioEspecifico(destino);
+    EscribirValor<uint32_t>(destino, static_cast<uint32_t>(extensiones_.size()));
+    for (const auto& extension : extensiones_) {
+        EscribirValor<PageId>(destino, extension.primera_pagina);
+        EscribirValor<uint32_t>(destino, extension.numero_paginas);
+        EscribirValor<uint32_t>(destino, extension.paginas_usadas);
+    }
+    EscribirValor<uint8_t>(destino, static_cast<uint8_t>(formato_almacenamiento_));
+    EscribirValor<uint8_t>(destino, codificacion_ligera_ ? 1 : 0);
+}
+
+Status MetadataTabla::DeserializarBinario(const Byte* datos, size_t longitud, std::shared_ptr<MetadataTabla>& tabla) {
+    const Byte* cursor = datos;
+    const Byte* fin = datos + longitud;
+    uint8_t tipo = 0;
+    uint32_t id_tabla = 0;
+    std::string nombre_tabla;
+    if (!LeerValor(cursor, fin, tipo) || !LeerValor(cursor, fin, id_tabla) || !LeerTexto(cursor, fin, nombre_tabla)) {
+        return Status::INVALID_FORMAT;
+    }
+
+    std::shared_ptr<MetadataTabla> nueva_tabla;
+    if (tipo == TIPO_ENTRADA_LONGITUD_FIJA) {
+        nueva_tabla = std::make_shared<MetadataTablaLongitudFija>(nombre_tabla, id_tabla);
+    } else if (tipo == TIPO_ENTRADA_LONGITUD_VARIABLE) {
+        nueva_tabla = std::make_shared<MetadataTablaLongitudVariable>(nombre_tabla, id_tabla);
+    } else {
+        return Status::INVALID_FORMAT;
+    }
+
+    uint32_t numero_columnas = 0;
+    if (!LeerValor(cursor, fin, nueva_tabla->numero_registros_) ||
+        !LeerValor(cursor, fin, nueva_tabla->id_mapa_espacio_libre_) ||
+        !LeerValor(cursor, fin, numero_columnas)) {
+        return Status::INVALID_FORMAT;
+    }
+
+    // Las columnas ya se validaron al crearse: se restauran sin pasar por AñadirColumna()
+    for (uint32_t i = 0; i < numero_columnas; ++i) {
+        std::string nombre_columna;
+        uint8_t tipo_columna = 0;
+        uint32_t tamaño_columna = 0;
+        uint8_t banderas = 0;
+        if (!LeerTexto(cursor, fin, nombre_columna) || !LeerValor(cursor, fin, tipo_columna) ||
+            !LeerValor(cursor, fin, tamaño_columna) || !LeerValor(cursor, fin, banderas)) {
+            return Status::INVALID_FORMAT;
+        }
+        nueva_tabla->esquema_tabla_.emplace_back(nombre_columna, static_cast<ColumnType>(tipo_columna),
+                                                 tamaño_columna, (banderas & 1) != 0, (banderas & 2) != 0);
+    }
+
+    uint32_t numero_extensiones = 0;
+    if (nueva_tabla->DeserializarBinarioEspecifico(cursor, fin) != Status::OK ||
+        !LeerValor(cursor, fin, numero_extensiones)) {
+        return Status::INVALID_FORMAT;
+    }
+    for (uint32_t i = 0; i < numero_extensiones; ++i) {
+        ExtensionPaginas extension;
+        if (!LeerValor(cursor, fin, extension.primera_pagina) || !LeerValor(cursor, fin, extension.numero_paginas) ||
+            !LeerValor(cursor, fin, extension.paginas_usadas) || extension.numero_paginas == 0 ||
+            extension.paginas_usadas > extension.numero_paginas) {
+            return Status::INVALID_FORMAT;
+        }
+        nueva_tabla->extensiones_.push_back(extension);
+        for (uint32_t j = 0; j < extension.paginas_usadas; ++j) {
+            nueva_tabla->paginas_datos_.push_back(extension.primera_pagina + j);
+        }
+    }
+    if (cursor != fin) {
+        // Las entradas escritas antes de existir el formato terminan tras las extensiones
+        uint8_t formato = 0;
+        uint8_t codificacion_ligera = 0;
+        if (!LeerValor(cursor, fin, formato) || !LeerValor(cursor, fin, codificacion_ligera) ||
+            formato > static_cast<uint8_t>(FormatoAlmacenamiento::COLUMNAS_PAX)) {
+            return Status::INVALID_FORMAT;
+        }
+        nueva_tabla->formato_almacenamiento_ = static_cast<FormatoAlmacenamiento>(formato);
+        nueva_tabla->codificacion_ligera_ = codificacion_ligera != 0;
+    }
+    if (cursor != fin) {
+        return Status::INVALID_FORMAT;
+    }
+
+    tabla = std::move(nueva_tabla);
+    return Status::OK;
+}
+
 bool MetadataTabla::ValidarTipoColumna(ColumnType tipo_columna) const {
     // Implementación base - acepta todos los tipos
     // Las clases derivadas pueden sobrescribir para restricciones específicas
@@ -270,6 +507,15 @@ Status MetadataTablaLongitudFija::DeserializarMetadataEspecifica(const std::stri
     return Status::OK;
 }
 
+void MetadataTablaLongitudFija::SerializarBinarioEspecifico(std::vector<Byte>&) const {
+    // Tamaños y offsets se derivan del esquema: no se guardan
+}
+
+Status MetadataTablaLongitudFija::DeserializarBinarioEspecifico(const Byte*&, const Byte*) {
+    RecalcularTamaños();
+    return Status::OK;
+}
+
 // ===== IMPLEMENTACIÓN DE MetadataTablaLongitudVariable =====
 
 MetadataTablaLongitudVariable::MetadataTablaLongitudVariable(const std::string& nombre_tabla, uint32_t id_tabla)
@@ -431,10 +677,25 @@ Status MetadataTablaLongitudVariable::DeserializarMetadataEspecifica(const std::
     return Status::OK;
 }
 
+void MetadataTablaLongitudVariable::SerializarBinarioEspecifico(std::vector<Byte>& destino) const {
+    EscribirValor<uint32_t>(destino, tamaño_estimado_promedio_);
+    EscribirLista(destino, longitudes_minimas_);
+    EscribirLista(destino, longitudes_maximas_);
+}
+
+Status MetadataTablaLongitudVariable::DeserializarBinarioEspecifico(const Byte*& cursor, const Byte* fin) {
+    if (!LeerValor(cursor, fin, tamaño_estimado_promedio_) || !LeerLista(cursor, fin, longitudes_minimas_) ||
+        !LeerLista(cursor, fin, longitudes_maximas_)) {
+        return Status::INVALID_FORMAT;
+    }
+    return Status::OK;
+}
+
 // ===== IMPLEMENTACIÓN DE GestorCatalogo =====
 
 GestorCatalogo::GestorCatalogo(std::shared_ptr<GestorDisco> gestor_disco)
-    : gestor_disco_(gestor_disco), siguiente_id_tabla_(1), bloque_catalogo_(0) {
+    : gestor_disco_(gestor_disco), siguiente_id_tabla_(1), bloque_catalogo_(0), directorio_pendiente_(false),
+      gestor_wal_(nullptr) {
     
     if (!gestor_disco_) {
         throw std::invalid_argument("GestorCatalogo: El gestor de disco no puede ser nulo.");
@@ -452,7 +713,8 @@ GestorCatalogo::~GestorCatalogo() {
 }
 
 uint32_t GestorCatalogo::CrearTablaLongitudFija(const std::string& nombre_tabla, 
-                                               const std::vector<ColumnMetadata>& esquema) {
+                                               const std::vector<ColumnMetadata>& esquema,
+                                               const OpcionesAlmacenamiento& opciones) {
     
     if (!ValidarNombreTabla(nombre_tabla)) {
         std::cerr << "Error: Nombre de tabla inválido: '" << nombre_tabla << "'." << std::endl;
@@ -482,16 +744,26 @@ uint32_t GestorCatalogo::CrearTablaLongitudFija(const std::string& nombre_tabla,
     // Recalcular tamaños para la tabla de longitud fija
     nueva_tabla->RecalcularTamaños();
     
+    nueva_tabla->EstablecerAlmacenamiento(opciones);
+
     // Añadir al catálogo
     tablas_[id_tabla] = nueva_tabla;
-    indices_nombres_[nombre_tabla] = id_tabla;
+    tablas_por_nombre_[nombre_tabla] = nueva_tabla;
+
+    std::vector<Byte> carga;
+    nueva_tabla->SerializarBinario(carga);
+    if (EscribirEntradaTabla(*nueva_tabla, carga) != Status::OK) {
+        std::cerr << "Advertencia: La tabla '" << nombre_tabla << "' se guardará en el próximo GuardarCatalogo()." << std::endl;
+    }
     
-    std::cout << "Tabla de longitud fija '" << nombre_tabla << "' creada con ID " << id_tabla << "." << std::endl;
+    std::cout << "Tabla de longitud fija '" << nombre_tabla << "' creada con ID " << id_tabla
+              << " (" << FormatoAlmacenamientoToString(opciones.formato) << ")." << std::endl;
     return id_tabla;
 }
 
 uint32_t GestorCatalogo::CrearTablaLongitudVariable(const std::string& nombre_tabla, 
-                                                   const std::vector<ColumnMetadata>& esquema) {
+                                                   const std::vector<ColumnMetadata>& esquema,
+                                                   const OpcionesAlmacenamiento& opciones) {
     
     if (!ValidarNombreTabla(nombre_tabla)) {
         std::cerr << "Error: Nombre de tabla inválido: '" << nombre_tabla << "'." << std::endl;
@@ -518,18 +790,31 @@ uint32_t GestorCatalogo::CrearTablaLongitudVariable(const std::string& nombre_ta
         }
     }
     
+    nueva_tabla->EstablecerAlmacenamiento(opciones);
+
     // Añadir al catálogo
     tablas_[id_tabla] = nueva_tabla;
-    indices_nombres_[nombre_tabla] = id_tabla;
+    tablas_por_nombre_[nombre_tabla] = nueva_tabla;
+
+    std::vector<Byte> carga;
+    nueva_tabla->SerializarBinario(carga);
+    if (EscribirEntradaTabla(*nueva_tabla, carga) != Status::OK) {
+        std::cerr << "Advertencia: La tabla '" << nombre_tabla << "' se guardará en el próximo GuardarCatalogo()." << std::endl;
+    }
     
-    std::cout << "Tabla de longitud variable '" << nombre_tabla << "' creada con ID " << id_tabla << "." << std::endl;
+    std::cout << "Tabla de longitud variable '" << nombre_tabla << "' creada con ID " << id_tabla
+              << " (" << FormatoAlmacenamientoToString(opciones.formato) << ")." << std::endl;
     return id_tabla;
 }
 
 std::shared_ptr<MetadataTabla> GestorCatalogo::BuscarTablaPorNombre(const std::string& nombre_tabla) {
-    auto it = indices_nombres_.find(nombre_tabla);
-    if (it != indices_nombres_.end()) {
-        return tablas_[it->second];
+    return ObtenerMetadataTabla(nombre_tabla);
+}
+
+std::shared_ptr<MetadataTabla> GestorCatalogo::ObtenerMetadataTabla(const std::string& nombre_tabla) const {
+    auto it = tablas_por_nombre_.find(nombre_tabla);
+    if (it != tablas_por_nombre_.end()) {
+        return it->second;
     }
     return nullptr;
 }
@@ -544,7 +829,7 @@ std::shared_ptr<MetadataTabla> GestorCatalogo::BuscarTablaPorId(uint32_t id_tabl
 
 std::vector<std::string> GestorCatalogo::ListarTablas() const {
     std::vector<std::string> nombres_tablas;
-    for (const auto& par : indices_nombres_) {
+    for (const auto& par : tablas_por_nombre_) {
         nombres_tablas.push_back(par.first);
     }
     return nombres_tablas;
@@ -600,203 +885,438 @@ void GestorCatalogo::ImprimirCatalogoCompleto() const {
 
 // Implementación de EliminarTabla que recibe nombre
 Status GestorCatalogo::EliminarTabla(const std::string& nombre_tabla) {
-    auto it = indices_nombres_.find(nombre_tabla);
-    if (it == indices_nombres_.end()) {
+    auto it = tablas_por_nombre_.find(nombre_tabla);
+    if (it == tablas_por_nombre_.end()) {
         std::cerr << "Error: No existe una tabla con el nombre '" << nombre_tabla << "'." << std::endl;
         return Status::NOT_FOUND;
     }
     
-    uint32_t id_tabla = it->second;
+    uint32_t id_tabla = it->second->ObtenerIdTabla();
     
     // Eliminar de ambos mapas
     tablas_.erase(id_tabla);
-    indices_nombres_.erase(it);
+    tablas_por_nombre_.erase(it);
+    tablas_pendientes_.erase(id_tabla);
+
+    auto entrada = entradas_persistidas_.find(id_tabla);
+    if (entrada != entradas_persistidas_.end()) {
+        // Primero el directorio sin la tabla; después se liberan sus bloques
+        EntradaPersistida cadena = std::move(entrada->second);
+        entradas_persistidas_.erase(entrada);
+        directorio_pendiente_ = true;
+        Status estado = EscribirDirectorio();
+        if (estado != Status::OK) {
+            std::cerr << "Error: No se pudo actualizar el directorio del catálogo al eliminar '" << nombre_tabla << "'." << std::endl;
+            return estado;
+        }
+        LiberarCadena(cadena);
+    }
     
     std::cout << "Tabla '" << nombre_tabla << "' eliminada del catálogo." << std::endl;
     return Status::OK;
 }
 
+Status GestorCatalogo::ActualizarMetadataTabla(const std::shared_ptr<MetadataTabla>& tabla) {
+    if (!tabla) {
+        return Status::INVALID_PARAMETER;
+    }
+    auto it = entradas_persistidas_.find(tabla->ObtenerIdTabla());
+    if (it != entradas_persistidas_.end() && it->second.version_estructura == tabla->ObtenerVersionEstructura()) {
+        return Status::OK; // Solo contadores o estadísticas: van con el siguiente GuardarCatalogo()
+    }
+    if (gestor_wal_) {
+        // Se escribe en el punto de confirmación, registrada en el mismo log que los datos
+        tablas_pendientes_.insert(tabla->ObtenerIdTabla());
+        return Status::OK;
+    }
+    std::vector<Byte> carga;
+    tabla->SerializarBinario(carga);
+    return EscribirEntradaTabla(*tabla, carga);
+}
+
+Status GestorCatalogo::PersistirCambiosPendientes() {
+    Status resultado = Status::OK;
+    bool escritas = false;
+    for (auto it = tablas_pendientes_.begin(); it != tablas_pendientes_.end();) {
+        auto tabla = tablas_.find(*it);
+        if (tabla == tablas_.end()) {
+            it = tablas_pendientes_.erase(it);
+            continue;
+        }
+        std::vector<Byte> carga;
+        tabla->second->SerializarBinario(carga);
+        Status estado = EscribirEntradaTabla(*tabla->second, carga, false);
+        if (estado != Status::OK) {
+            resultado = estado; // Sigue pendiente para el siguiente intento
+            ++it;
+        } else {
+            escritas = true;
+            it = tablas_pendientes_.erase(it);
+        }
+    }
+    // Un único cambio de directorio publica todas las entradas escritas
+    if (escritas || directorio_pendiente_) {
+        Status estado = EscribirDirectorio();
+        if (estado != Status::OK) {
+            resultado = estado;
+        }
+    }
+    return resultado;
+}
+
 Status GestorCatalogo::CargarCatalogo() {
-    // Verificar si existe un bloque de catálogo asignado
-    // El bloque_catalogo_ se inicializa a 0, lo que podría indicar que no hay catálogo persistido.
-    // En un sistema real, se podría buscar un bloque especial o un archivo de metadatos.
+    tablas_.clear();
+    tablas_por_nombre_.clear();
+    entradas_persistidas_.clear();
+    entradas_danadas_.clear();
+    tablas_pendientes_.clear();
+    directorio_persistido_ = EntradaPersistida();
+    siguiente_id_tabla_ = 1;
+
     if (bloque_catalogo_ == 0) {
-        // Intentar asignar un nuevo bloque para el catálogo si no hay uno.
-        // Esto solo debería pasar la primera vez que se inicia el SGBD.
-        BlockId nuevo_bloque;
-        Status estado = gestor_disco_->AsignarBloque(PageType::CATALOG, nuevo_bloque);
+        Status estado = BuscarDirectorio();
+        if (estado == Status::NOT_FOUND) {
+            // Disco nuevo: el directorio se crea con la primera escritura
+            directorio_pendiente_ = true;
+            std::cout << "GestorCatalogo: El disco no tiene catálogo; se creará al guardar." << std::endl;
+            return Status::OK;
+        }
         if (estado != Status::OK) {
-            std::cerr << "Error: No se pudo asignar bloque para el catálogo." << std::endl;
             return estado;
         }
-        bloque_catalogo_ = nuevo_bloque;
-        std::cout << "Nuevo bloque de catálogo asignado: " << bloque_catalogo_ << std::endl;
-        // Si es un catálogo nuevo, no hay nada que cargar, solo se inicializa.
-        return Status::OK; 
     }
-    
-    // Cargar el bloque de catálogo desde disco
-    BloqueMemoria bloque_memoria;
-    Status estado = gestor_disco_->LeerBloque(bloque_catalogo_, bloque_memoria);
+
+    std::vector<Byte> carga;
+    Status estado = LeerCadena(bloque_catalogo_, ID_DIRECTORIO, carga, directorio_persistido_);
     if (estado != Status::OK) {
-        std::cerr << "Error: No se pudo leer el bloque de catálogo " << bloque_catalogo_ << "." << std::endl;
+        std::cerr << "Error: No se pudo leer el directorio del catálogo (bloque " << bloque_catalogo_ << ")." << std::endl;
         return estado;
     }
-    
-    // Deserializar el contenido del catálogo
-    // Asegurarse de que el tamaño usado sea válido antes de construir la string
-    if (bloque_memoria.tamaño_usado > 0 && bloque_memoria.tamaño_usado <= BLOCK_SIZE) {
-        std::string contenido_catalogo(bloque_memoria.data.data(), bloque_memoria.tamaño_usado);
-        return DeserializarCatalogo(contenido_catalogo);
-    } else {
-        std::cerr << "Advertencia: Bloque de catálogo vacío o tamaño usado inválido. Inicializando catálogo vacío." << std::endl;
-        // Si el bloque está vacío o corrupto, inicializar un catálogo vacío.
-        tablas_.clear();
-        indices_nombres_.clear();
-        siguiente_id_tabla_ = 1;
-        return Status::OK; // Catálogo vacío cargado (o inicializado)
+
+    const Byte* cursor = carga.data();
+    const Byte* fin = carga.data() + carga.size();
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t numero_tablas = 0;
+    if (!LeerValor(cursor, fin, magic) || !LeerValor(cursor, fin, version) ||
+        !LeerValor(cursor, fin, siguiente_id_tabla_) || !LeerValor(cursor, fin, numero_tablas) ||
+        magic != MAGIC_DIRECTORIO_CATALOGO || version != VERSION_CATALOGO_BINARIO) {
+        std::cerr << "Error: El directorio del catálogo no tiene un formato válido." << std::endl;
+        return Status::INVALID_FORMAT;
+    }
+
+    for (uint32_t i = 0; i < numero_tablas; ++i) {
+        uint32_t id_tabla = 0;
+        BlockId primer_bloque = INVALID_PAGE_ID;
+        if (!LeerValor(cursor, fin, id_tabla) || !LeerValor(cursor, fin, primer_bloque)) {
+            return Status::INVALID_FORMAT;
+        }
+        if (id_tabla >= siguiente_id_tabla_) {
+            siguiente_id_tabla_ = id_tabla + 1;
+        }
+
+        EntradaPersistida entrada;
+        std::vector<Byte> carga_tabla;
+        std::shared_ptr<MetadataTabla> tabla;
+        estado = LeerCadena(primer_bloque, id_tabla, carga_tabla, entrada);
+        if (estado == Status::OK) {
+            estado = MetadataTabla::DeserializarBinario(carga_tabla.data(), carga_tabla.size(), tabla);
+        }
+        if (estado == Status::OK && (tabla->ObtenerIdTabla() != id_tabla || tablas_.count(id_tabla) ||
+                                     tablas_por_nombre_.count(tabla->ObtenerNombreTabla()))) {
+            estado = Status::INVALID_FORMAT;
+        }
+        if (estado != Status::OK) {
+            // Una entrada dañada no impide cargar las demás; el directorio la conserva
+            std::cerr << "Advertencia: Se omite la tabla con ID " << id_tabla << " del catálogo (bloque "
+                      << primer_bloque << "): " << StatusToString(estado) << std::endl;
+            entradas_danadas_[id_tabla] = primer_bloque;
+            continue;
+        }
+
+        tablas_[id_tabla] = tabla;
+        tablas_por_nombre_[tabla->ObtenerNombreTabla()] = tabla;
+        entrada.version_estructura = tabla->ObtenerVersionEstructura();
+        entradas_persistidas_[id_tabla] = std::move(entrada);
     }
+
+    directorio_pendiente_ = false;
+    std::cout << "Catálogo cargado: " << tablas_.size() << " tablas";
+    if (!entradas_danadas_.empty()) {
+        std::cout << " (" << entradas_danadas_.size() << " entrada(s) dañada(s) omitida(s))";
+    }
+    std::cout << "." << std::endl;
+    return Status::OK;
 }
 
 Status GestorCatalogo::GuardarCatalogo() {
-    // Verificar que tenemos un bloque asignado
-    if (bloque_catalogo_ == 0) {
-        BlockId nuevo_bloque;
-        Status estado = gestor_disco_->AsignarBloque(PageType::CATALOG, nuevo_bloque);
+    if (gestor_disco_->EsSoloLectura()) {
+        return Status::OK; // Réplica de consulta: el catálogo en disco es de otra instancia
+    }
+    Status resultado = Status::OK;
+    uint32_t entradas_escritas = 0;
+
+    for (const auto& par : tablas_) {
+        std::vector<Byte> carga;
+        par.second->SerializarBinario(carga);
+        auto it = entradas_persistidas_.find(par.first);
+        if (it != entradas_persistidas_.end() && it->second.huella == Huella(carga.data(), carga.size())) {
+            tablas_pendientes_.erase(par.first);
+            continue; // Sin cambios desde la última escritura
+        }
+        Status estado = EscribirEntradaTabla(*par.second, carga, false);
         if (estado != Status::OK) {
-            std::cerr << "Error: No se pudo asignar bloque para guardar el catálogo." << std::endl;
-            return estado;
+            resultado = estado;
+        } else {
+            tablas_pendientes_.erase(par.first);
+            entradas_escritas++;
         }
-        bloque_catalogo_ = nuevo_bloque;
     }
-    
-    // Serializar el catálogo completo
-    std::string contenido_serializado = SerializarCatalogo();
-    
-    // Verificar que el contenido cabe en un bloque
-    if (contenido_serializado.size() > BLOCK_SIZE) {
-        std::cerr << "Error: El catálogo es demasiado grande para un solo bloque (" 
-                  << contenido_serializado.size() << " bytes > " << BLOCK_SIZE << " bytes)." << std::endl;
-        return Status::BUFFER_OVERFLOW;
+
+    if (directorio_pendiente_ || bloque_catalogo_ == 0) {
+        Status estado = EscribirDirectorio();
+        if (estado != Status::OK) {
+            resultado = estado;
+        }
     }
-    
-    // Preparar el bloque de memoria
-    BloqueMemoria bloque_memoria; // Se inicializa con data.fill(0) y tamaño_usado = 0
-    std::memcpy(bloque_memoria.data.data(), contenido_serializado.c_str(), contenido_serializado.size());
-    bloque_memoria.tamaño_usado = contenido_serializado.size();
-    
-    // Escribir al disco
-    Status estado = gestor_disco_->EscribirBloque(bloque_catalogo_, bloque_memoria);
-    if (estado == Status::OK) {
-        std::cout << "Catálogo guardado exitosamente en bloque " << bloque_catalogo_ << "." << std::endl;
-    } else {
+
+    if (resultado == Status::OK && entradas_escritas > 0) {
+        std::cout << "Catálogo guardado: " << entradas_escritas << " entrada(s) actualizada(s)." << std::endl;
+    } else if (resultado != Status::OK) {
         std::cerr << "Error: No se pudo guardar el catálogo en disco." << std::endl;
     }
-    
-    return estado;
+    return resultado;
 }
 
-std::string GestorCatalogo::SerializarCatalogo() const {
-    std::stringstream ss;
-    
-    // Cabecera del catálogo
-    ss << "CATALOGO_SGBD_VERSION:1.0" << std::endl;
-    ss << "NUMERO_TABLAS:" << tablas_.size() << std::endl;
-    ss << "SIGUIENTE_ID_TABLA:" << siguiente_id_tabla_ << std::endl;
-    ss << "BLOQUE_CATALOGO:" << bloque_catalogo_ << std::endl;
-    ss << "FECHA_GUARDADO:" << ObtenerTimestampActual() << std::endl;
-    ss << "===INICIO_TABLAS===" << std::endl;
-    
-    // Serializar cada tabla
-    for (const auto& par : tablas_) {
-        const auto& tabla = par.second;
-        
-        ss << "---INICIO_TABLA---" << std::endl;
-        ss << tabla->SerializarMetadataComun();
-        ss << tabla->SerializarMetadataEspecifica();
-        ss << "---FIN_TABLA---" << std::endl;
+Status GestorCatalogo::EscribirEntradaTabla(const MetadataTabla& tabla, const std::vector<Byte>& carga, bool publicar) {
+    EntradaPersistida& entrada = entradas_persistidas_[tabla.ObtenerIdTabla()];
+    Status estado = EscribirCadena(tabla.ObtenerIdTabla(), carga, entrada);
+    if (estado != Status::OK) {
+        std::cerr << "Error: No se pudo escribir la entrada del catálogo de la tabla '" << tabla.ObtenerNombreTabla() << "'." << std::endl;
+        return estado;
     }
-    
-    ss << "===FIN_TABLAS===" << std::endl;
-    
-    return ss.str();
+    entrada.version_estructura = tabla.ObtenerVersionEstructura();
+    directorio_pendiente_ = true; // La entrada está en una cadena nueva
+    return publicar ? EscribirDirectorio() : Status::OK;
 }
 
-Status GestorCatalogo::DeserializarCatalogo(const std::string& contenido) {
-    std::istringstream iss(contenido);
-    std::string linea;
-    bool en_tablas = false;
-    bool en_tabla_individual = false;
-    std::string contenido_tabla_actual;
-    
-    // Limpiar catálogo actual antes de cargar
-    tablas_.clear();
-    indices_nombres_.clear();
-    
-    while (std::getline(iss, linea)) {
-        if (linea.empty()) continue;
-        
-        if (linea == "===INICIO_TABLAS===") {
-            en_tablas = true;
-            continue;
-        } else if (linea == "===FIN_TABLAS===") {
-            en_tablas = false;
-            if (en_tabla_individual) { // Si una tabla no se cerró correctamente
-                std::cerr << "Error: Fin de tablas inesperado, tabla individual no cerrada." << std::endl;
-                return Status::INVALID_FORMAT;
-            }
+Status GestorCatalogo::EscribirDirectorio() {
+    std::vector<Byte> tablas;
+    uint32_t numero_tablas = 0;
+    for (const auto& par : entradas_persistidas_) {
+        if (par.second.bloques.empty() || !tablas_.count(par.first)) {
             continue;
-        } else if (linea == "---INICIO_TABLA---") {
-            if (en_tabla_individual) { // Si ya estamos procesando una tabla y encontramos otra
-                std::cerr << "Error: Inicio de tabla inesperado, tabla anterior no cerrada." << std::endl;
-                return Status::INVALID_FORMAT;
-            }
-            en_tabla_individual = true;
-            contenido_tabla_actual.clear();
-            continue;
-        } else if (linea == "---FIN_TABLA---") {
-            if (!en_tabla_individual) { // Si no estamos procesando una tabla y encontramos fin de tabla
-                std::cerr << "Error: Fin de tabla inesperado, no hay tabla en proceso." << std::endl;
-                return Status::INVALID_FORMAT;
+        }
+        EscribirValor<uint32_t>(tablas, par.first);
+        EscribirValor<BlockId>(tablas, par.second.bloques.front());
+        numero_tablas++;
+    }
+    for (const auto& par : entradas_danadas_) {
+        EscribirValor<uint32_t>(tablas, par.first);
+        EscribirValor<BlockId>(tablas, par.second);
+        numero_tablas++;
+    }
+
+    std::vector<Byte> carga;
+    EscribirValor<uint32_t>(carga, MAGIC_DIRECTORIO_CATALOGO);
+    EscribirValor<uint32_t>(carga, VERSION_CATALOGO_BINARIO);
+    EscribirValor<uint32_t>(carga, siguiente_id_tabla_);
+    EscribirValor<uint32_t>(carga, numero_tablas);
+    carga.insert(carga.end(), tablas.begin(), tablas.end());
+
+    Status estado = EscribirCadena(ID_DIRECTORIO, carga, directorio_persistido_);
+    directorio_pendiente_ = (estado != Status::OK);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    bloque_catalogo_ = directorio_persistido_.bloques.front();
+
+    // Ningún directorio en disco apunta ya a las cadenas sustituidas
+    for (BlockId id_bloque : bloques_por_liberar_) {
+        gestor_disco_->DesasignarBloque(id_bloque);
+    }
+    bloques_por_liberar_.clear();
+    return Status::OK;
+}
+
+Status GestorCatalogo::EscribirCadena(uint32_t id_tabla, const std::vector<Byte>& carga, EntradaPersistida& entrada) {
+    size_t necesarios = std::max<size_t>(1, (carga.size() + CAPACIDAD_BLOQUE_CATALOGO - 1) / CAPACIDAD_BLOQUE_CATALOGO);
+
+    // Copia en sombra: la entrada se escribe en bloques nuevos, a los que aún no
+    // apunta nada. Solo el primer bloque del directorio se reescribe en su sitio:
+    // esa escritura de un único bloque publica la nueva versión del catálogo.
+    bool primero_en_sitio = (id_tabla == ID_DIRECTORIO && !entrada.bloques.empty());
+    size_t reutilizados = primero_en_sitio ? 1 : 0;
+    std::vector<BlockId> cadena(entrada.bloques.begin(), entrada.bloques.begin() + reutilizados);
+    while (cadena.size() < necesarios) {
+        BlockId id_bloque = gestor_disco_->AsignarBloque(PageType::CATALOG);
+        if (id_bloque == 0) {
+            std::cerr << "Error: No hay bloques libres para el catálogo." << std::endl;
+            for (size_t i = reutilizados; i < cadena.size(); ++i) {
+                gestor_disco_->DesasignarBloque(cadena[i]);
             }
-            en_tabla_individual = false;
-            // Procesar la tabla actual
-            Status estado = DeserializarTablaIndividual(contenido_tabla_actual);
-            if (estado != Status::OK) {
-                std::cerr << "Error: No se pudo deserializar una tabla del catálogo. Estado: " << static_cast<int>(estado) << std::endl;
-                return estado;
+            return Status::DISK_FULL;
+        }
+        cadena.push_back(id_bloque);
+    }
+
+    uint64_t huella = Huella(carga.data(), carga.size());
+    std::vector<uint64_t> huellas(necesarios, 0);
+    std::vector<Byte> imagenes(necesarios * BLOCK_SIZE, 0);
+    std::vector<size_t> cambiados; // En orden de escritura
+    Status estado = Status::OK;
+
+    // El primer bloque lleva el checksum de toda la entrada: se escribe el último
+    for (size_t i = necesarios; i-- > 0;) {
+        size_t inicio = i * CAPACIDAD_BLOQUE_CATALOGO;
+        size_t bytes = (carga.size() > inicio) ? std::min(CAPACIDAD_BLOQUE_CATALOGO, carga.size() - inicio) : 0;
+
+        CabeceraComun cabecera;
+        cabecera.id_bloque = cadena[i];
+        cabecera.tipo_pagina = PageType::CATALOG;
+        cabecera.bytes_usados = static_cast<uint32_t>(sizeof(CabeceraComun) + sizeof(CabeceraBloqueCatalogo) + bytes);
+        cabecera.bytes_disponibles = BLOCK_SIZE - cabecera.bytes_usados;
+        cabecera.checksum = (i == 0) ? ChecksumEntrada(huella) : 0;
+
+        CabeceraBloqueCatalogo cabecera_catalogo;
+        cabecera_catalogo.id_tabla = id_tabla;
+        cabecera_catalogo.numero_bloque = static_cast<uint32_t>(i);
+        cabecera_catalogo.siguiente_bloque = (i + 1 < necesarios) ? cadena[i + 1] : INVALID_PAGE_ID;
+        cabecera_catalogo.bytes_carga = static_cast<uint32_t>(bytes);
+        cabecera_catalogo.longitud_entrada = static_cast<uint32_t>(carga.size());
+
+        Byte* bloque = imagenes.data() + i * BLOCK_SIZE;
+        std::memcpy(bloque, &cabecera, sizeof(CabeceraComun));
+        std::memcpy(bloque + sizeof(CabeceraComun), &cabecera_catalogo, sizeof(CabeceraBloqueCatalogo));
+        if (bytes > 0) {
+            std::memcpy(bloque + sizeof(CabeceraComun) + sizeof(CabeceraBloqueCatalogo), carga.data() + inicio, bytes);
+        }
+
+        huellas[i] = Huella(bloque, BLOCK_SIZE);
+        if (i < reutilizados && entrada.huellas_bloques.size() > i && entrada.huellas_bloques[i] == huellas[i]) {
+            continue; // El bloque ya tiene este contenido en disco
+        }
+        cambiados.push_back(i);
+    }
+
+    // Regla del WAL: antes de sobrescribir el primer bloque del directorio, las
+    // imágenes de todos los bloques (incluidas las de las cadenas nuevas) son duraderas
+    if (gestor_wal_ && !cambiados.empty()) {
+        LSN ultimo = LSN_INVALIDO;
+        for (size_t i : cambiados) {
+            ultimo = gestor_wal_->Añadir(TipoRegistroWAL::IMAGEN_PAGINA, cadena[i], 0, imagenes.data() + i * BLOCK_SIZE, BLOCK_SIZE);
+            if (ultimo == LSN_INVALIDO) {
+                estado = Status::ERROR;
+                break;
             }
-            continue;
         }
-        
-        if (en_tabla_individual) {
-            contenido_tabla_actual += linea + "\n";
-        } else if (!en_tablas) { // Procesar cabecera del catálogo
-            size_t pos = linea.find(':');
-            if (pos != std::string::npos) {
-                std::string clave = linea.substr(0, pos);
-                std::string valor = linea.substr(pos + 1);
-                
-                if (clave == "SIGUIENTE_ID_TABLA") {
-                    siguiente_id_tabla_ = std::stoul(valor);
-                } else if (clave == "BLOQUE_CATALOGO") {
-                    bloque_catalogo_ = std::stoul(valor);
-                }
-                // Otros campos de cabecera como VERSION, NUMERO_TABLAS, FECHA_GUARDADO pueden ser ignorados si no se necesitan
+        if (estado == Status::OK && primero_en_sitio) {
+            estado = gestor_wal_->AsegurarDuradero(ultimo);
+        }
+    }
+    for (size_t k = 0; estado == Status::OK && k < cambiados.size(); ++k) {
+        size_t i = cambiados[k];
+        estado = gestor_disco_->EscribirBloque(cadena[i], imagenes.data() + i * BLOCK_SIZE, BLOCK_SIZE);
+    }
+
+    if (estado != Status::OK) {
+        if (!primero_en_sitio) {
+            // La cadena anterior sigue intacta y es la que apunta el directorio
+            for (size_t i = reutilizados; i < cadena.size(); ++i) {
+                gestor_disco_->DesasignarBloque(cadena[i]);
             }
+            return estado;
         }
+        // El primer bloque del directorio puede haber quedado a medias: el siguiente
+        // intento lo reescribe entero. Sus bloques anteriores no se liberan, por si
+        // el disco aún los referencia.
+        entrada.bloques = std::move(cadena);
+        entrada.huellas_bloques.assign(necesarios, 0);
+        entrada.huella = 0;
+        return estado;
     }
-    
-    // Si al final en_tabla_individual es true, significa que la última tabla no se cerró
-    if (en_tabla_individual) {
-        std::cerr << "Error: Archivo de catálogo terminó inesperadamente, última tabla no cerrada." << std::endl;
-        return Status::INVALID_FORMAT;
+
+    // Los bloques sustituidos se liberan cuando el directorio ya no los referencia
+    bloques_por_liberar_.insert(bloques_por_liberar_.end(), entrada.bloques.begin() + reutilizados, entrada.bloques.end());
+    entrada.bloques = std::move(cadena);
+    entrada.huellas_bloques = std::move(huellas);
+    entrada.huella = huella;
+    return Status::OK;
+}
+
+Status GestorCatalogo::LeerCadena(BlockId primer_bloque, uint32_t id_tabla, std::vector<Byte>& carga, EntradaPersistida& entrada) {
+    carga.clear();
+    entrada = EntradaPersistida();
+    std::vector<Byte> bloque(BLOCK_SIZE);
+    uint32_t checksum = 0;
+    uint32_t longitud_entrada = 0;
+
+    for (BlockId actual = primer_bloque; actual != INVALID_PAGE_ID;) {
+        if (entrada.bloques.size() > gestor_disco_->ObtenerMaximoBloques()) {
+            return Status::INVALID_FORMAT; // Cadena con un ciclo
+        }
+        Status estado = gestor_disco_->LeerBloque(actual, bloque.data(), BLOCK_SIZE);
+        if (estado != Status::OK) {
+            return estado;
+        }
+
+        CabeceraComun cabecera;
+        CabeceraBloqueCatalogo cabecera_catalogo;
+        std::memcpy(&cabecera, bloque.data(), sizeof(CabeceraComun));
+        std::memcpy(&cabecera_catalogo, bloque.data() + sizeof(CabeceraComun), sizeof(CabeceraBloqueCatalogo));
+        if (cabecera.magic_number != MAGIC_NUMBER_SGBD || cabecera.tipo_pagina != PageType::CATALOG ||
+            cabecera_catalogo.id_tabla != id_tabla || cabecera_catalogo.numero_bloque != entrada.bloques.size() ||
+            cabecera_catalogo.bytes_carga > CAPACIDAD_BLOQUE_CATALOGO) {
+            std::cerr << "Error: El bloque " << actual << " no pertenece a la entrada del catálogo de la tabla "
+                      << id_tabla << "." << std::endl;
+            return Status::INVALID_FORMAT;
+        }
+        if (entrada.bloques.empty()) {
+            checksum = cabecera.checksum;
+            longitud_entrada = cabecera_catalogo.longitud_entrada;
+        }
+
+        const Byte* datos = bloque.data() + sizeof(CabeceraComun) + sizeof(CabeceraBloqueCatalogo);
+        carga.insert(carga.end(), datos, datos + cabecera_catalogo.bytes_carga);
+        entrada.bloques.push_back(actual);
+        entrada.huellas_bloques.push_back(Huella(bloque.data(), BLOCK_SIZE));
+        actual = cabecera_catalogo.siguiente_bloque;
     }
 
-    std::cout << "Catálogo cargado: " << tablas_.size() << " tablas." << std::endl;
+    entrada.huella = Huella(carga.data(), carga.size());
+    if (entrada.bloques.empty() || carga.size() != longitud_entrada || ChecksumEntrada(entrada.huella) != checksum) {
+        std::cerr << "Error: Checksum incorrecto en la entrada del catálogo de la tabla " << id_tabla << "." << std::endl;
+        return Status::INVALID_FORMAT;
+    }
     return Status::OK;
 }
 
+void GestorCatalogo::LiberarCadena(EntradaPersistida& entrada) {
+    for (BlockId id_bloque : entrada.bloques) {
+        gestor_disco_->DesasignarBloque(id_bloque);
+    }
+    entrada = EntradaPersistida();
+}
+
+Status GestorCatalogo::BuscarDirectorio() {
+    std::vector<Byte> bloque(BLOCK_SIZE);
+    for (BlockId id_bloque : gestor_disco_->ListarBloquesPorTipo(PageType::CATALOG)) {
+        if (gestor_disco_->LeerBloque(id_bloque, bloque.data(), BLOCK_SIZE) != Status::OK) {
+            continue;
+        }
+        CabeceraComun cabecera;
+        CabeceraBloqueCatalogo cabecera_catalogo;
+        std::memcpy(&cabecera, bloque.data(), sizeof(CabeceraComun));
+        std::memcpy(&cabecera_catalogo, bloque.data() + sizeof(CabeceraComun), sizeof(CabeceraBloqueCatalogo));
+        if (cabecera.magic_number == MAGIC_NUMBER_SGBD && cabecera_catalogo.id_tabla == ID_DIRECTORIO &&
+            cabecera_catalogo.numero_bloque == 0) {
+            bloque_catalogo_ = id_bloque;
+            return Status::OK;
+        }
+    }
+    return Status::NOT_FOUND;
+}
+
 // Implementación de DeserializarTablaIndividual (ahora retorna Status)
 Status GestorCatalogo::DeserializarTablaIndividual(const std::string& contenido_tabla) {
     // Primero, determinar el tipo de tabla
@@ -847,13 +1367,13 @@ Status GestorCatalogo::DeserializarTablaIndividual(const std::string& contenido_
     std::string nombre_tabla = nueva_tabla->ObtenerNombreTabla();
 
     // Verificar si ya existe una tabla con este ID o nombre (podría ser un catálogo corrupto)
-    if (tablas_.count(id_tabla) || indices_nombres_.count(nombre_tabla)) {
+    if (tablas_.count(id_tabla) || tablas_por_nombre_.count(nombre_tabla)) {
         std::cerr << "Advertencia: Se encontró una tabla duplicada (ID: " << id_tabla << ", Nombre: " << nombre_tabla << ") durante la deserialización. Se ignorará esta entrada." << std::endl;
         return Status::DUPLICATE_ENTRY; // O un error más específico si se desea detener la carga
     }
     
     tablas_[id_tabla] = nueva_tabla;
-    indices_nombres_[nombre_tabla] = id_tabla;
+    tablas_por_nombre_[nombre_tabla] = nueva_tabla;
     
     // Actualizar siguiente ID si es necesario
     if (id_tabla >= siguiente_id_tabla_) {
@@ -968,9 +1488,9 @@ std::vector<std::pair<std::string, std::string>> GestorCatalogo::GetTableSchema(
 }
 
 uint32_t GestorCatalogo::GetTableId(const std::string& nombre_tabla) {
-    auto it = indices_nombres_.find(nombre_tabla);
-    if (it != indices_nombres_.end()) {
-        return it->second;
+    auto it = tablas_por_nombre_.find(nombre_tabla);
+    if (it != tablas_por_nombre_.end()) {
+        return it->second->ObtenerIdTabla();
     }
     return 0; // 0 indica no encontrado
 }
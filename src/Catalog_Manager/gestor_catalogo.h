@@ -4,15 +4,37 @@
 
 #include "../include/common.h" // Para ColumnType, ColumnMetadata, Status, BloqueMemoria, BlockId
 #include "../data_storage/gestor_disco.h" // Para GestorDisco
+#include "../data_storage/cabeceras_bloques.h" // Para FormatoAlmacenamiento
 #include <string>              // Para std::string
 #include <vector>              // Para std::vector
 #include <unordered_map>       // Para std::unordered_map
+#include <unordered_set>       // Para std::unordered_set
 #include <memory>              // Para std::shared_ptr
 #include <fstream>             // Para std::ifstream, std::ofstream
 #include <chrono>              // Para std::chrono::system_clock
 #include <ctime>               // Para std::localtime, std::put_time
 #include <iomanip>             // Para std::put_time
 
+/**
+ * Tramo de páginas de datos contiguas asignado de una vez a una tabla.
+ * Las paginas_usadas primeras ya son páginas de datos; el resto está reservado
+ * en disco para las siguientes páginas de la tabla.
+ */
+struct ExtensionPaginas {
+    PageId primera_pagina;
+    uint32_t numero_paginas;
+    uint32_t paginas_usadas;
+};
+
+/**
+ * Disposición de las páginas de datos de una tabla, elegida al crearla.
+ * COLUMNAS_PAX conviene a las tablas anchas que se recorren leyendo pocas columnas.
+ */
+struct OpcionesAlmacenamiento {
+    FormatoAlmacenamiento formato = FormatoAlmacenamiento::FILAS;
+    bool codificacion_ligera = true;   // PAX: diccionario en textos y referencia + bits en INT
+};
+
 /**
  * Clase base MetadataTabla: Contiene la información común de todas las tablas
  * * Responsabilidades principales:
@@ -78,6 +100,44 @@ public:
      */
     void EstablecerNumeroRegistros(uint32_t num_registros) { numero_registros_ = num_registros; }
 
+    // === MÉTODOS DE GESTIÓN DE PÁGINAS ===
+
+    /**
+     * Páginas de datos de la tabla, en orden de asignación (extensión a extensión)
+     */
+    const std::vector<PageId>& ObtenerPaginasDatos() const { return paginas_datos_; }
+
+    /**
+     * Extensiones de la tabla; es lo que guarda el catálogo en lugar de la lista de páginas
+     */
+    const std::vector<ExtensionPaginas>& ObtenerExtensiones() const { return extensiones_; }
+
+    /**
+     * Añade una página de datos a la tabla. Si es la siguiente página reservada de
+     * la última extensión solo se marca como usada; si no, se añade como extensión
+     * de una página (o alarga la última si es contigua a ella).
+     * @param id_pagina ID de la nueva página
+     */
+    void AñadirPaginaDatos(PageId id_pagina);
+
+    /**
+     * Registra una extensión recién reservada en disco, todavía sin páginas usadas
+     * @param primera_pagina Primera página de la extensión
+     * @param numero_paginas Longitud de la extensión
+     */
+    void AñadirExtension(PageId primera_pagina, uint32_t numero_paginas);
+
+    /**
+     * Siguiente página reservada de la última extensión, sin marcarla como usada
+     * @return INVALID_PAGE_ID si hay que reservar otra extensión
+     */
+    PageId ObtenerPaginaReservada() const;
+
+    /**
+     * Páginas asignadas a la tabla en disco, usadas o reservadas
+     */
+    uint32_t ObtenerNumeroPaginasAsignadas() const;
+
     // === MÉTODOS DE CONSULTA ===
 
     std::string ObtenerNombreTabla() const { return nombre_tabla_; }
@@ -85,6 +145,34 @@ public:
     uint32_t ObtenerNumeroRegistros() const { return numero_registros_; }
     uint32_t ObtenerNumeroColumnas() const { return static_cast<uint32_t>(esquema_tabla_.size()); }
 
+    /**
+     * Primera página del mapa de espacio libre de la tabla (INVALID_PAGE_ID si aún no tiene)
+     */
+    BlockId ObtenerIdMapaEspacioLibre() const { return id_mapa_espacio_libre_; }
+    void EstablecerIdMapaEspacioLibre(BlockId id_pagina) {
+        id_mapa_espacio_libre_ = id_pagina;
+        version_estructura_++;
+    }
+
+    /**
+     * Versión de la estructura de la tabla: cambia con el esquema, las páginas de
+     * datos o el mapa de espacio libre, pero no con el número de registros ni con
+     * las estadísticas de longitud. El catálogo la usa para decidir si un cambio
+     * se escribe en el momento o con el siguiente GuardarCatalogo().
+     */
+    uint64_t ObtenerVersionEstructura() const { return version_estructura_; }
+
+    /**
+     * Formato de las páginas de datos; no se puede cambiar con la tabla ya poblada
+     */
+    FormatoAlmacenamiento ObtenerFormatoAlmacenamiento() const { return formato_almacenamiento_; }
+    bool UsaCodificacionLigera() const { return codificacion_ligera_; }
+    void EstablecerAlmacenamiento(const OpcionesAlmacenamiento& opciones) {
+        formato_almacenamiento_ = opciones.formato;
+        codificacion_ligera_ = opciones.codificacion_ligera;
+        version_estructura_++;
+    }
+
     // === MÉTODOS VIRTUALES PUROS ===
 
     /**
@@ -112,6 +200,20 @@ public:
      */
     virtual Status DeserializarMetadataEspecifica(const std::string& contenido) = 0;
 
+    /**
+     * Serializa la metadata específica en el formato binario del catálogo
+     * @param destino Buffer al que se añaden los bytes
+     */
+    virtual void SerializarBinarioEspecifico(std::vector<Byte>& destino) const = 0;
+
+    /**
+     * Deserializa la metadata específica del formato binario del catálogo
+     * @param cursor [in/out] Posición de lectura; avanza sobre los bytes leídos
+     * @param fin Fin de los datos disponibles
+     * @return Status::INVALID_FORMAT si los datos están truncados
+     */
+    virtual Status DeserializarBinarioEspecifico(const Byte*& cursor, const Byte* fin) = 0;
+
     // === MÉTODOS DE SERIALIZACIÓN COMÚN ===
 
     /**
@@ -127,11 +229,35 @@ public:
      */
     Status DeserializarMetadataComun(const std::string& contenido);
 
+    /**
+     * Serializa la entrada completa de la tabla en el formato binario del catálogo.
+     * Las extensiones van al final como (primera, longitud, usadas), así que añadir
+     * una página solo cambia la cola de la entrada. Tras ellas va el formato de
+     * almacenamiento; las entradas anteriores sin él se leen como FILAS.
+     * @param destino Buffer al que se añaden los bytes
+     */
+    void SerializarBinario(std::vector<Byte>& destino) const;
+
+    /**
+     * Reconstruye una tabla desde su entrada binaria
+     * @param datos Entrada completa
+     * @param longitud Bytes de la entrada
+     * @param tabla [out] Tabla del tipo indicado en la entrada
+     * @return Status::INVALID_FORMAT si la entrada está truncada o es de un tipo desconocido
+     */
+    static Status DeserializarBinario(const Byte* datos, size_t longitud, std::shared_ptr<MetadataTabla>& tabla);
+
 protected:
     std::string nombre_tabla_;                    // Nombre de la tabla
     uint32_t id_tabla_;                          // Identificador único de la tabla
     std::vector<ColumnMetadata> esquema_tabla_;  // Esquema de la tabla (columnas)
     uint32_t numero_registros_;                  // Número de registros en la tabla
+    BlockId id_mapa_espacio_libre_;              // Primera página del mapa de espacio libre
+    std::vector<ExtensionPaginas> extensiones_;  // Páginas asignadas a la tabla, por tramos contiguos
+    std::vector<PageId> paginas_datos_;          // Páginas usadas de extensiones_, desplegadas
+    uint64_t version_estructura_;                // Ver ObtenerVersionEstructura()
+    FormatoAlmacenamiento formato_almacenamiento_; // Disposición de las páginas de datos
+    bool codificacion_ligera_;                   // Solo con COLUMNAS_PAX
 
     /**
      * Valida que un tipo de columna sea compatible con el tipo de tabla
@@ -190,6 +316,8 @@ public:
     bool EsLongitudFija() const override { return true; }
     std::string SerializarMetadataEspecifica() const override;
     Status DeserializarMetadataEspecifica(const std::string& contenido) override;
+    void SerializarBinarioEspecifico(std::vector<Byte>& destino) const override;
+    Status DeserializarBinarioEspecifico(const Byte*& cursor, const Byte* fin) override;
 
     // === MÉTODOS DE CONSULTA ESPECÍFICOS ===
 
@@ -273,6 +401,8 @@ public:
     bool EsLongitudFija() const override { return false; }
     std::string SerializarMetadataEspecifica() const override;
     Status DeserializarMetadataEspecifica(const std::string& contenido) override;
+    void SerializarBinarioEspecifico(std::vector<Byte>& destino) const override;
+    Status DeserializarBinarioEspecifico(const Byte*& cursor, const Byte* fin) override;
 
     // === MÉTODOS DE CONSULTA ESPECÍFICOS ===
 
@@ -302,7 +432,28 @@ private:
  * - Persistir metadatos en bloques específicos del disco
  * - Gestionar parámetros del disco
  * - Proporcionar acceso rápido a metadatos de tablas
+ *
+ * PERSISTENCIA BINARIA:
+ * - El catálogo se guarda en bloques CATALOG: un directorio (id de tabla →
+ *   primer bloque de su entrada) y una cadena de bloques por tabla.
+ * - Un cambio solo reescribe la entrada de su tabla, en una cadena de bloques
+ *   nueva (copia en sombra). El primer bloque del directorio se reescribe
+ *   después en su sitio, en una única escritura de bloque, y solo entonces se
+ *   liberan los bloques de la cadena anterior: una escritura a medias deja en
+ *   disco la versión anterior completa.
+ * - ActualizarMetadataTabla() solo escribe los cambios de estructura (esquema,
+ *   páginas, mapa de espacio libre). Con WAL, la escritura se aplaza al punto de
+ *   confirmación de la operación (PersistirCambiosPendientes()), y cada bloque
+ *   escrito se registra antes como IMAGEN_PAGINA: la recuperación rehace también
+ *   el catálogo.
+ * - El número de registros y las estadísticas se escriben de forma perezosa, con
+ *   el siguiente GuardarCatalogo() (punto de control o cierre). Tras una caída el
+ *   GestorRegistros los recuenta desde las páginas (RecontarRegistros()).
+ * - CargarCatalogo() omite con un aviso las entradas dañadas; el directorio las
+ *   sigue referenciando para no perderlas.
  */
+class GestorWAL;
+
 class GestorCatalogo {
 public:
     /**
@@ -322,19 +473,23 @@ public:
      * Crea una nueva tabla de longitud fija
      * @param nombre_tabla Nombre de la tabla
      * @param esquema Esquema de columnas de la tabla
+     * @param opciones Formato de las páginas de datos
      * @return ID de la tabla creada, o 0 si hubo error
      */
     uint32_t CrearTablaLongitudFija(const std::string& nombre_tabla, 
-                                   const std::vector<ColumnMetadata>& esquema);
+                                   const std::vector<ColumnMetadata>& esquema,
+                                   const OpcionesAlmacenamiento& opciones = OpcionesAlmacenamiento());
 
     /**
      * Crea una nueva tabla de longitud variable
      * @param nombre_tabla Nombre de la tabla
      * @param esquema Esquema de columnas de la tabla
+     * @param opciones Formato de las páginas de datos
      * @return ID de la tabla creada, o 0 si hubo error
      */
     uint32_t CrearTablaLongitudVariable(const std::string& nombre_tabla, 
-                                       const std::vector<ColumnMetadata>& esquema);
+                                       const std::vector<ColumnMetadata>& esquema,
+                                       const OpcionesAlmacenamiento& opciones = OpcionesAlmacenamiento());
 
     /**
      * Elimina una tabla del catálogo
@@ -357,17 +512,54 @@ public:
      */
     std::shared_ptr<MetadataTabla> BuscarTablaPorId(uint32_t id_tabla);
 
+    /**
+     * Obtiene la metadata de una tabla por nombre (igual que BuscarTablaPorNombre)
+     * @param nombre_tabla Nombre de la tabla
+     * @return Puntero a la metadata de la tabla, o nullptr si no existe
+     */
+    std::shared_ptr<MetadataTabla> ObtenerMetadataTabla(const std::string& nombre_tabla) const;
+
+    /**
+     * Persiste los cambios de estructura de una tabla ya registrada en el catálogo.
+     * Si la versión de estructura no ha cambiado desde la última escritura (solo
+     * el número de registros o las estadísticas) no hace E/S: se escriben con el
+     * siguiente GuardarCatalogo(). Con WAL, la escritura se aplaza a
+     * PersistirCambiosPendientes().
+     * @param tabla Tabla modificada
+     * @return Status::OK si se guardó o no había nada que escribir todavía
+     */
+    Status ActualizarMetadataTabla(const std::shared_ptr<MetadataTabla>& tabla);
+
+    /**
+     * Escribe las entradas que cambiaron desde el último punto de confirmación y
+     * el directorio una sola vez. El GestorRegistros la llama antes de
+     * GestorWAL::Confirmar().
+     * @return Status::OK si no queda nada pendiente
+     */
+    Status PersistirCambiosPendientes();
+
+    /**
+     * Asocia el WAL en el que se registran los bloques del catálogo antes de
+     * escribirlos. Debe vivir más que el GestorCatalogo, o desasociarse antes.
+     */
+    void EstablecerWAL(GestorWAL* wal) { gestor_wal_ = wal; }
+
     // === MÉTODOS DE PERSISTENCIA ===
 
     /**
-     * Guarda el catálogo completo en bloques específicos del disco
+     * Escribe las entradas que han cambiado desde su última escritura (incluidos
+     * los contadores de registros pendientes) y el directorio si hace falta.
+     * Con el disco en solo lectura no escribe nada.
      * @return Status::OK si se guardó correctamente
      */
     Status GuardarCatalogo();
 
     /**
-     * Carga el catálogo desde bloques específicos del disco
-     * @return Status::OK si se cargó correctamente
+     * Carga el catálogo desde sus bloques CATALOG. El directorio se localiza
+     * por su cabecera entre los bloques de ese tipo del mapa de asignación.
+     * Las entradas de tabla dañadas se omiten con un aviso.
+     * @return Status::OK si se cargó (también si el disco no tiene catálogo);
+     *         INVALID_FORMAT si el directorio está dañado
      */
     Status CargarCatalogo();
 
@@ -462,7 +654,7 @@ public:
     std::vector<std::pair<std::string, std::string>> GetTableSchema(const std::string& nombre_tabla);
     
     /**
-     * @brief Obtiene el ID de una tabla por nombre (Delega en indices_nombres_)
+     * @brief Obtiene el ID de una tabla por nombre (Delega en tablas_por_nombre_)
      * @param nombre_tabla Nombre de la tabla
      * @return ID de la tabla o 0 si no existe
      */
@@ -506,9 +698,27 @@ public:
 private:
     std::shared_ptr<GestorDisco> gestor_disco_;                              // Gestor de disco
     std::unordered_map<uint32_t, std::shared_ptr<MetadataTabla>> tablas_;   // Mapa de tablas por ID
-    std::unordered_map<std::string, uint32_t> indices_nombres_;             // Índice de nombres a IDs
+    std::unordered_map<std::string, std::shared_ptr<MetadataTabla>> tablas_por_nombre_; // Mapa de tablas por nombre
     uint32_t siguiente_id_tabla_;                                           // Próximo ID de tabla disponible
-    BlockId bloque_catalogo_;                                               // ID del bloque que contiene el catálogo
+    BlockId bloque_catalogo_;                                               // Primer bloque del directorio (0 = aún no existe)
+
+    /**
+     * Estado en disco de una entrada del catálogo (directorio o tabla)
+     */
+    struct EntradaPersistida {
+        std::vector<BlockId> bloques;           // Cadena de bloques, en orden
+        std::vector<uint64_t> huellas_bloques;  // Huella del contenido escrito en cada bloque
+        uint64_t huella = 0;                    // Huella de la entrada completa
+        uint64_t version_estructura = 0;        // Versión de la tabla cuando se escribió
+    };
+
+    std::unordered_map<uint32_t, EntradaPersistida> entradas_persistidas_;  // Por ID de tabla
+    EntradaPersistida directorio_persistido_;
+    bool directorio_pendiente_;                                             // El directorio en disco no está al día
+    GestorWAL* gestor_wal_;                                                 // Registro de escritura anticipada (opcional)
+    std::unordered_set<uint32_t> tablas_pendientes_;                        // Cambiadas, sin escribir todavía (con WAL)
+    std::unordered_map<uint32_t, BlockId> entradas_danadas_;                // Omitidas al cargar: ID → primer bloque
+    std::vector<BlockId> bloques_por_liberar_;                              // Cadenas sustituidas, aún en el directorio en disco
 
     /**
      * Genera un nuevo ID único para una tabla
@@ -524,17 +734,46 @@ private:
     bool ValidarNombreTabla(const std::string& nombre_tabla) const;
 
     /**
-     * Serializa el catálogo completo a texto
-     * @return String con el catálogo serializado
+     * Escribe la entrada de una tabla en una cadena nueva
+     * @param tabla Tabla a escribir
+     * @param carga Entrada ya serializada con SerializarBinario()
+     * @param publicar Escribir también el directorio; si no, queda pendiente
      */
-    std::string SerializarCatalogo() const;
+    Status EscribirEntradaTabla(const MetadataTabla& tabla, const std::vector<Byte>& carga, bool publicar = true);
 
     /**
-     * Deserializa el catálogo desde texto
-     * @param contenido Contenido a deserializar
-     * @return Status::OK si se deserializó correctamente
+     * Escribe el directorio: siguiente ID de tabla y primer bloque de cada entrada.
+     * Después libera los bloques de las cadenas sustituidas.
+     */
+    Status EscribirDirectorio();
+
+    /**
+     * Escribe una entrada en una cadena de bloques nueva; la anterior pasa a
+     * bloques_por_liberar_. Solo el primer bloque del directorio se reutiliza, y
+     * se escribe el último y solo si su contenido cambia. Con WAL, los bloques se
+     * registran y el log es duradero antes de sobrescribir ese bloque.
+     * @param id_tabla ID de la tabla (0 para el directorio)
+     * @param carga Contenido de la entrada
+     * @param entrada [in/out] Cadena actual; sale con la nueva
+     */
+    Status EscribirCadena(uint32_t id_tabla, const std::vector<Byte>& carga, EntradaPersistida& entrada);
+
+    /**
+     * Lee una entrada completa siguiendo su cadena de bloques
+     * @return Status::INVALID_FORMAT si la cadena o su checksum no son válidos
+     */
+    Status LeerCadena(BlockId primer_bloque, uint32_t id_tabla, std::vector<Byte>& carga, EntradaPersistida& entrada);
+
+    /**
+     * Devuelve al disco los bloques de una cadena
+     */
+    void LiberarCadena(EntradaPersistida& entrada);
+
+    /**
+     * Busca el primer bloque del directorio entre los bloques CATALOG asignados
+     * @return Status::NOT_FOUND si el disco aún no tiene catálogo
      */
-    Status DeserializarCatalogo(const std::string& contenido);
+    Status BuscarDirectorio();
 };
 
 #endif // GESTOR_CATALOGO_H
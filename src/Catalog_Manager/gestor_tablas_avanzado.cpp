@@ -6,6 +6,10 @@
 #include <regex>
 #include <cctype>
 #include <limits> // Para std::numeric_limits
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 // === CONSTRUCTOR Y DESTRUCTOR ===
 
@@ -84,24 +88,13 @@ Status GestorTablasAvanzado::CrearTablaPorArchivo(const std::string& ruta_archiv
     }
 
     // Insertar datos desde el archivo CSV (resto de las líneas)
-    while (std::getline(archivo, linea)) {
-        if (linea.empty()) continue; // Saltar líneas vacías
-        std::stringstream ss_datos(linea);
-        std::string valor_campo;
-        DatosRegistro registro;
-        for (size_t i = 0; i < nombres_columnas.size(); ++i) {
-            if (std::getline(ss_datos, valor_campo, ',')) {
-                registro.AñadirCampo(nombres_columnas[i], Trim(valor_campo));
-            } else {
-                std::cerr << "Advertencia: Faltan campos en el registro. Se usará valor vacío." << std::endl;
-                registro.AñadirCampo(nombres_columnas[i], "");
-            }
-        }
-        Status insert_status = gestor_registros_->InsertarRegistro(nombre_tabla, registro);
-        if (insert_status != Status::OK) {
-            std::cerr << "Advertencia: Fallo al insertar registro: " << StatusToString(insert_status) << std::endl;
-            // Podríamos decidir si esto es un error fatal o solo una advertencia
-        }
+    uint32_t registros_insertados = 0;
+    uint32_t registros_fallidos = 0;
+    Status carga_status = CargarLineasCSV(archivo, nombre_tabla, nombres_columnas.size(), true,
+                                          registros_insertados, registros_fallidos);
+    if (carga_status != Status::OK || registros_fallidos > 0) {
+        std::cerr << "Advertencia: " << registros_fallidos << " registros no se pudieron insertar ("
+                  << StatusToString(carga_status) << ")." << std::endl;
     }
 
     std::cout << "Tabla '" << nombre_tabla << "' creada y datos insertados desde archivo." << std::endl;
@@ -183,7 +176,8 @@ Status GestorTablasAvanzado::CrearTablaInteractiva() {
     return status;
 }
 
-Status GestorTablasAvanzado::InsertarRegistroPorArchivo(const std::string& ruta_archivo, const std::string& nombre_tabla) {
+Status GestorTablasAvanzado::InsertarRegistrosPorCSV(const std::string& nombre_tabla, const std::string& ruta_archivo,
+                                                     bool analizar_en_hilo) {
     std::cout << "\n=== INSERTANDO REGISTROS POR ARCHIVO ===\n";
     std::cout << "Archivo: " << ruta_archivo << "\n";
     std::cout << "Tabla: " << nombre_tabla << "\n";
@@ -205,44 +199,119 @@ Status GestorTablasAvanzado::InsertarRegistroPorArchivo(const std::string& ruta_
         return Status::ERROR;
     }
 
-    std::string linea;
-    uint32_t registros_insertados = 0;
-    uint32_t registros_fallidos = 0;
-
     // Asumimos que el archivo CSV no tiene cabecera de columnas en este caso,
     // o que la primera línea de datos es el primer registro.
     // Si el archivo siempre tiene cabecera, se debería leer y descartar la primera línea.
+    uint32_t registros_insertados = 0;
+    uint32_t registros_fallidos = 0;
+    Status carga_status = CargarLineasCSV(archivo, nombre_tabla, metadata_tabla->ObtenerColumnas().size(),
+                                          analizar_en_hilo, registros_insertados, registros_fallidos);
+    if (carga_status != Status::OK) {
+        std::cerr << "Error durante la carga masiva: " << StatusToString(carga_status) << std::endl;
+    }
 
-    while (std::getline(archivo, linea)) {
-        if (linea.empty()) continue;
+    std::cout << "\nResumen de inserción en '" << nombre_tabla << "':\n";
+    std::cout << "  Registros insertados: " << registros_insertados << "\n";
+    std::cout << "  Registros fallidos: " << registros_fallidos << "\n";
+    if (carga_status != Status::OK) {
+        return carga_status;
+    }
+    return (registros_fallidos == 0) ? Status::OK : Status::OPERATION_FAILED;
+}
 
-        std::stringstream ss_datos(linea);
-        std::string valor_campo;
-        DatosRegistro registro;
+Status GestorTablasAvanzado::CargarLineasCSV(std::istream& entrada, const std::string& nombre_tabla,
+                                             size_t numero_columnas, bool analizar_en_hilo,
+                                             uint32_t& registros_insertados, uint32_t& registros_fallidos) {
+    registros_insertados = 0;
+    registros_fallidos = 0;
+    uint32_t lineas_incompletas = 0; // Solo lo modifica quien analiza
 
-        const auto& columnas = metadata_tabla->ObtenerColumnas();
-        for (const auto& col_meta : columnas) {
-            if (std::getline(ss_datos, valor_campo, ',')) {
-                registro.AñadirCampo(col_meta.nombre, Trim(valor_campo));
-            } else {
-                std::cerr << "Advertencia: Faltan campos para la columna '" << col_meta.nombre << "' en el registro. Se usará valor vacío." << std::endl;
-                registro.AñadirCampo(col_meta.nombre, "");
+    auto leer_lote = [&](std::vector<DatosRegistro>& lote) {
+        lote.clear();
+        std::string linea;
+        std::string valor_campo;
+        while (lote.size() < TAMANO_LOTE_CSV && std::getline(entrada, linea)) {
+            if (linea.empty()) continue;
+            std::stringstream ss_datos(linea);
+            std::vector<std::string> campos;
+            campos.reserve(numero_columnas);
+            bool incompleta = false;
+            for (size_t i = 0; i < numero_columnas; ++i) {
+                if (std::getline(ss_datos, valor_campo, ',')) {
+                    campos.push_back(Trim(valor_campo));
+                } else {
+                    campos.emplace_back(); // Faltan campos: se usará valor vacío
+                    incompleta = true;
+                }
             }
+            if (incompleta) lineas_incompletas++;
+            lote.emplace_back(std::move(campos));
+        }
+        return !lote.empty();
+    };
+
+    Status estado = Status::OK;
+    auto insertar_lote = [&](const std::vector<DatosRegistro>& lote) {
+        uint32_t insertados = 0;
+        Status estado_lote = gestor_registros_->InsertarRegistrosLote(nombre_tabla, lote, insertados);
+        registros_insertados += insertados;
+        registros_fallidos += static_cast<uint32_t>(lote.size()) - insertados;
+        if (estado_lote != Status::OK && estado_lote != Status::OPERATION_FAILED) {
+            estado = estado_lote; // Error de almacenamiento: no seguir cargando
         }
+        return estado == Status::OK;
+    };
 
-        Status insert_status = gestor_registros_->InsertarRegistro(nombre_tabla, registro);
-        if (insert_status == Status::OK) {
-            registros_insertados++;
-        } else {
-            std::cerr << "Error al insertar registro: " << StatusToString(insert_status) << " -> " << linea << std::endl;
-            registros_fallidos++;
+    if (!analizar_en_hilo) {
+        std::vector<DatosRegistro> lote;
+        while (leer_lote(lote) && insertar_lote(lote)) {}
+    } else {
+        // Un hilo lector analiza los lotes siguientes mientras este inserta el actual.
+        // La cola está acotada para que la memoria no dependa del tamaño del archivo.
+        std::mutex mutex_cola;
+        std::condition_variable condicion_cola;
+        std::deque<std::vector<DatosRegistro>> cola;
+        bool lectura_terminada = false;
+        bool cancelar = false;
+
+        std::thread lector([&]() {
+            std::vector<DatosRegistro> lote;
+            while (leer_lote(lote)) {
+                std::unique_lock<std::mutex> lock(mutex_cola);
+                condicion_cola.wait(lock, [&]() { return cola.size() < MAX_LOTES_CSV_EN_COLA || cancelar; });
+                if (cancelar) break;
+                cola.push_back(std::move(lote));
+                condicion_cola.notify_all();
+            }
+            std::lock_guard<std::mutex> lock(mutex_cola);
+            lectura_terminada = true;
+            condicion_cola.notify_all();
+        });
+
+        while (true) {
+            std::vector<DatosRegistro> lote;
+            {
+                std::unique_lock<std::mutex> lock(mutex_cola);
+                condicion_cola.wait(lock, [&]() { return !cola.empty() || lectura_terminada; });
+                if (cola.empty()) break;
+                lote = std::move(cola.front());
+                cola.pop_front();
+                condicion_cola.notify_all();
+            }
+            if (!insertar_lote(lote)) {
+                std::lock_guard<std::mutex> lock(mutex_cola);
+                cancelar = true;
+                condicion_cola.notify_all();
+                break;
+            }
         }
+        lector.join();
     }
 
-    std::cout << "\nResumen de inserción en '" << nombre_tabla << "':\n";
-    std::cout << "  Registros insertados: " << registros_insertados << "\n";
-    std::cout << "  Registros fallidos: " << registros_fallidos << "\n";
-    return (registros_fallidos == 0) ? Status::OK : Status::OPERATION_FAILED;
+    if (lineas_incompletas > 0) {
+        std::cerr << "Advertencia: " << lineas_incompletas << " líneas tenían campos de menos; se usó valor vacío." << std::endl;
+    }
+    return estado;
 }
 
 Status GestorTablasAvanzado::InsertarRegistroInteractivo(const std::string& nombre_tabla) {
@@ -291,98 +360,36 @@ Status GestorTablasAvanzado::EliminarRegistrosPorCondiciones(const std::string&
         return Status::NOT_FOUND;
     }
 
-    std::shared_ptr<MetadataTabla> metadata_tabla = gestor_catalogo_->ObtenerMetadataTabla(nombre_tabla);
-    if (!metadata_tabla) {
-        std::cerr << "Error interno: Metadata de tabla no encontrada para '" << nombre_tabla << "'." << std::endl;
-        return Status::ERROR;
+    // Las condiciones se compilan una vez contra el esquema y el cursor las evalúa
+    // sobre cada página entera: solo los registros que las cumplen llegan a este bucle
+    std::vector<CondicionFiltro> condiciones;
+    Status estado = ParsearCondiciones(condiciones_str, condiciones);
+    if (estado != Status::OK) {
+        return estado;
     }
-
-    std::vector<DatosRegistro> todos_registros;
-    Status fetch_status = gestor_registros_->ConsultarTodosLosRegistros(nombre_tabla, todos_registros);
-    if (fetch_status != Status::OK) {
-        std::cerr << "Error al consultar registros para eliminación: " << StatusToString(fetch_status) << std::endl;
-        return fetch_status;
+    std::shared_ptr<const FiltroCompilado> filtro;
+    estado = gestor_registros_->CompilarFiltro(nombre_tabla, condiciones, filtro);
+    if (estado != Status::OK) {
+        return (estado == Status::NOT_FOUND) ? Status::INVALID_ARGUMENT : estado;
     }
 
-    // Parsear condiciones (simplificado: "columna=valor" o "columna>valor", etc.)
-    // Esto es una simplificación. Un parser de SQL real sería mucho más complejo.
-    std::string columna_condicion;
-    std::string operador_condicion;
-    std::string valor_condicion_str;
-
-    std::regex cond_regex("(\\w+)\\s*([=<>!]+)\\s*(.+)", std::regex::icase);
-    std::smatch matches;
-
-    if (std::regex_match(condiciones_str, matches, cond_regex) && matches.size() == 4) {
-        columna_condicion = Trim(matches[1].str());
-        operador_condicion = Trim(matches[2].str());
-        valor_condicion_str = Trim(matches[3].str());
-    } else {
-        std::cerr << "Error: Formato de condición inválido. Use 'columna_nombre operador valor'." << std::endl;
-        return Status::INVALID_ARGUMENT;
+    CursorRegistros cursor;
+    Status estado_cursor = gestor_registros_->AbrirCursorFiltrado(nombre_tabla, cursor, filtro);
+    if (estado_cursor != Status::OK) {
+        std::cerr << "Error al consultar registros para eliminación: " << StatusToString(estado_cursor) << std::endl;
+        return estado_cursor;
     }
 
-    // Validar que la columna de condición existe
-    int idx_columna = -1;
-    for (size_t i = 0; i < metadata_tabla->ObtenerColumnas().size(); ++i) {
-        if (metadata_tabla->ObtenerColumnas()[i].nombre == columna_condicion) {
-            idx_columna = i;
-            break;
-        }
-    }
-
-    if (idx_columna == -1) {
-        std::cerr << "Error: Columna '" << columna_condicion << "' no encontrada en la tabla '" << nombre_tabla << "'." << std::endl;
-        return Status::INVALID_ARGUMENT;
-    }
-
-    ColumnType tipo_columna_condicion = metadata_tabla->ObtenerColumnas()[idx_columna].tipo;
-
+    // Los slots son estables: eliminar el registro actual no mueve el cursor
     uint32_t registros_eliminados_count = 0;
-    for (size_t i = 0; i < todos_registros.size(); ++i) {
-        const DatosRegistro& registro = todos_registros[i];
-        if (registro.campos.size() <= idx_columna) {
-            continue; // Registro incompleto o malformado
-        }
-        std::string valor_registro_str = registro.campos[idx_columna];
-
-        bool cumple_condicion = false;
-
-        // Evaluación de la condición
-        if (tipo_columna_condicion == TipoDatoTabla::INT) {
-            try {
-                long long valor_registro = std::stoll(valor_registro_str);
-                long long valor_condicion = std::stoll(valor_condicion_str);
-                if (operador_condicion == "=") cumple_condicion = (valor_registro == valor_condicion);
-                else if (operador_condicion == "!=") cumple_condicion = (valor_registro != valor_condicion);
-                else if (operador_condicion == ">") cumple_condicion = (valor_registro > valor_condicion);
-                else if (operador_condicion == "<") cumple_condicion = (valor_registro < valor_condicion);
-                else if (operador_condicion == ">=") cumple_condicion = (valor_registro >= valor_condicion);
-                else if (operador_condicion == "<=") cumple_condicion = (valor_registro <= valor_condicion);
-            } catch (const std::exception& e) {
-                std::cerr << "Advertencia: Error de conversión INT en condición: " << e.what() << std::endl;
-                continue;
-            }
-        } else { // STR o CHAR (comparación de cadenas)
-            if (operador_condicion == "=") cumple_condicion = (valor_registro_str == valor_condicion_str);
-            else if (operador_condicion == "!=") cumple_condicion = (valor_registro_str != valor_condicion_str);
-            // Otras comparaciones de cadena (>, <, etc.) son más complejas y no se implementan aquí.
-            else {
-                std::cerr << "Advertencia: Operador '" << operador_condicion << "' no soportado para tipos de cadena." << std::endl;
-                continue;
-            }
-        }
-
-        if (cumple_condicion) {
-            // Asumimos que el RecordId es el índice en el vector de todos_registros para esta simulación.
-            // En un sistema real, necesitaríamos el RecordId real del registro.
-            RecordId id_registro_a_eliminar = i + 1; // Simplificado: RecordId = índice + 1
-            Status delete_status = gestor_registros_->EliminarRegistroPorID(nombre_tabla, id_registro_a_eliminar);
-            if (delete_status == Status::OK) {
-                registros_eliminados_count++;
-            } else {
-                std::cerr << "Advertencia: Fallo al eliminar registro con ID " << id_registro_a_eliminar << ": " << StatusToString(delete_status) << std::endl;
-            }
+    RecordId id_registro_a_eliminar;
+    VistaRegistro vista;
+    while (cursor.Siguiente(id_registro_a_eliminar, vista)) {
+        Status delete_status = gestor_registros_->EliminarRegistroPorID(nombre_tabla, id_registro_a_eliminar);
+        if (delete_status == Status::OK) {
+            registros_eliminados_count++;
+        } else {
+            std::cerr << "Advertencia: Fallo al eliminar registro con ID " << id_registro_a_eliminar << ": " << StatusToString(delete_status) << std::endl;
         }
     }
 
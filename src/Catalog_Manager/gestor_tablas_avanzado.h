@@ -125,6 +125,22 @@ private:
     std::string LimpiarValor(const std::string& valor) const;
     Status ValidarEsquemaConDatos(const EsquemaTablaAvanzado& esquema, 
                                   const std::vector<std::string>& datos) const;
+
+    static constexpr size_t TAMANO_LOTE_CSV = 4096;       // Registros por llamada a InsertarRegistrosLote
+    static constexpr size_t MAX_LOTES_CSV_EN_COLA = 2;    // Lotes analizados pendientes de insertar
+
+    /**
+     * @brief Analiza las líneas CSV restantes de la entrada y las inserta por lotes.
+     * @param entrada Flujo posicionado en la primera línea de datos
+     * @param nombre_tabla Tabla destino
+     * @param numero_columnas Campos esperados por línea
+     * @param analizar_en_hilo Si es true, el análisis se hace en un hilo aparte
+     * @param registros_insertados Registros insertados (salida)
+     * @param registros_fallidos Registros rechazados (salida)
+     * @return Status distinto de OK si la carga se detuvo por un error de almacenamiento
+     */
+    Status CargarLineasCSV(std::istream& entrada, const std::string& nombre_tabla, size_t numero_columnas,
+                           bool analizar_en_hilo, uint32_t& registros_insertados, uint32_t& registros_fallidos);
     
     /**
      * @brief Convierte un vector de DefinicionColumna a un vector de ColumnMetadata.
@@ -172,11 +188,14 @@ public:
     /**
      * @brief Inserta registros desde un archivo CSV en una tabla existente.
      * Valida que los datos del CSV coincidan con el esquema de la tabla.
+     * Los registros se insertan por lotes con GestorRegistros::InsertarRegistrosLote.
      * * @param nombre_tabla Nombre de la tabla destino
      * @param ruta_archivo_csv Ruta al archivo CSV con los datos
+     * @param analizar_en_hilo Analiza el CSV en un hilo aparte mientras se inserta
      * @return Status del resultado de la operación
      */
-    Status InsertarRegistrosPorCSV(const std::string& nombre_tabla, const std::string& ruta_archivo_csv);
+    Status InsertarRegistrosPorCSV(const std::string& nombre_tabla, const std::string& ruta_archivo_csv,
+                                   bool analizar_en_hilo = true);
     
     /**
      * @brief Inserta un registro individual en una tabla.
@@ -0,0 +1,385 @@
+// audio_processor/cliente_voz.cpp - Cliente del servicio persistente de voz a SQL
+#include "cliente_voz.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "ws2_32.lib")
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+const std::intptr_t SOCKET_INVALIDO = -1;
+
+#ifdef _WIN32
+using DescriptorSocket = SOCKET;
+
+bool InicializarSockets() {
+    static const bool inicializado = []() {
+        WSADATA datos;
+        return WSAStartup(MAKEWORD(2, 2), &datos) == 0;
+    }();
+    return inicializado;
+}
+
+void CerrarDescriptor(std::intptr_t descriptor) {
+    closesocket(static_cast<DescriptorSocket>(descriptor));
+}
+#else
+using DescriptorSocket = int;
+
+bool InicializarSockets() {
+    return true;
+}
+
+void CerrarDescriptor(std::intptr_t descriptor) {
+    ::close(static_cast<DescriptorSocket>(descriptor));
+}
+#endif
+
+#ifdef MSG_NOSIGNAL
+const int OPCIONES_ENVIO = MSG_NOSIGNAL; // Un servicio caído no debe matar al SGBD con SIGPIPE
+#else
+const int OPCIONES_ENVIO = 0;
+#endif
+
+void EscribirU32LE(char* destino, uint32_t valor) {
+    for (int i = 0; i < 4; ++i) {
+        destino[i] = static_cast<char>((valor >> (8 * i)) & 0xFF);
+    }
+}
+
+uint32_t LeerLE(const unsigned char* origen, int bytes) {
+    uint32_t valor = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        valor = (valor << 8) | origen[i];
+    }
+    return valor;
+}
+
+// Los campos del protocolo van separados por tabuladores y líneas
+std::string LimpiarCampo(const std::string& texto) {
+    std::string resultado = texto;
+    for (char& c : resultado) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    return resultado;
+}
+
+std::vector<std::string> DividirPorTabuladores(const std::string& linea) {
+    std::vector<std::string> campos;
+    size_t inicio = 0;
+    while (true) {
+        size_t fin = linea.find('\t', inicio);
+        campos.push_back(linea.substr(inicio, fin == std::string::npos ? std::string::npos : fin - inicio));
+        if (fin == std::string::npos) break;
+        inicio = fin + 1;
+    }
+    return campos;
+}
+
+} // namespace
+
+// ===== CONEXIÓN =====
+
+ClienteVoz::ClienteVoz(const OpcionesServicioVoz& opciones)
+    : opciones_(opciones)
+    , socket_(SOCKET_INVALIDO) {
+}
+
+ClienteVoz::~ClienteVoz() {
+    Cerrar();
+}
+
+bool ClienteVoz::Conectado() const {
+    return socket_ != SOCKET_INVALIDO;
+}
+
+void ClienteVoz::Cerrar() {
+    if (socket_ != SOCKET_INVALIDO) {
+        CerrarDescriptor(socket_);
+        socket_ = SOCKET_INVALIDO;
+    }
+}
+
+Status ClienteVoz::IntentarConexion() {
+    if (!InicializarSockets()) {
+        return Status::IO_ERROR;
+    }
+    DescriptorSocket descriptor = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (static_cast<std::intptr_t>(descriptor) == SOCKET_INVALIDO) {
+        return Status::IO_ERROR;
+    }
+    sockaddr_in direccion{};
+    direccion.sin_family = AF_INET;
+    direccion.sin_port = htons(opciones_.puerto);
+    direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Solo local: el servicio no escucha fuera
+    if (::connect(descriptor, reinterpret_cast<const sockaddr*>(&direccion), sizeof(direccion)) != 0) {
+        CerrarDescriptor(static_cast<std::intptr_t>(descriptor));
+        return Status::IO_ERROR;
+    }
+    // Peticiones pequeñas (COMPILAR, PING) sin esperar al algoritmo de Nagle
+    int sin_retardo = 1;
+    setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&sin_retardo), sizeof(sin_retardo));
+    socket_ = static_cast<std::intptr_t>(descriptor);
+    return Status::OK;
+}
+
+Status ClienteVoz::ArrancarServicio() {
+    std::ostringstream comando;
+#ifdef _WIN32
+    comando << "start \"servicio_voz\" /B /D \"" << opciones_.directorio << "\" cmd /C \""
+            << opciones_.interprete << " servicio_voz.py --puerto " << opciones_.puerto
+            << " > servicio_voz.log 2>&1\"";
+#else
+    comando << "cd \"" << opciones_.directorio << "\" && nohup " << opciones_.interprete
+            << " servicio_voz.py --puerto " << opciones_.puerto << " > servicio_voz.log 2>&1 &";
+#endif
+    std::cout << "Iniciando el servicio de voz en segundo plano (puerto " << opciones_.puerto << ")..." << std::endl;
+    if (std::system(comando.str().c_str()) != 0) {
+        std::cerr << "Error: No se pudo lanzar servicio_voz.py con '" << opciones_.interprete << "'." << std::endl;
+        return Status::IO_ERROR;
+    }
+    servicio_lanzado_ = true;
+    return Status::OK;
+}
+
+Status ClienteVoz::Conectar() {
+    if (Conectado()) {
+        return Status::OK;
+    }
+    if (IntentarConexion() == Status::OK) {
+        return Status::OK;
+    }
+    if (!opciones_.arrancar_si_no_responde) {
+        return Status::IO_ERROR;
+    }
+    if (!servicio_lanzado_) {
+        Status estado = ArrancarServicio();
+        if (estado != Status::OK) {
+            return estado;
+        }
+    }
+    // El servicio escucha antes de cargar Whisper: la conexión llega pronto y la
+    // primera petición espera a que termine la carga.
+    auto limite = std::chrono::steady_clock::now() + std::chrono::milliseconds(opciones_.espera_arranque_ms);
+    while (std::chrono::steady_clock::now() < limite) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        if (IntentarConexion() == Status::OK) {
+            return Status::OK;
+        }
+    }
+    std::cerr << "Error: El servicio de voz no respondió en " << opciones_.espera_arranque_ms
+              << " ms (ver " << opciones_.directorio << "/servicio_voz.log)." << std::endl;
+    return Status::IO_ERROR;
+}
+
+// ===== PROTOCOLO =====
+
+Status ClienteVoz::EnviarTodo(const char* datos, size_t longitud) {
+    while (longitud > 0) {
+        int fragmento = static_cast<int>(std::min<size_t>(longitud, 1u << 20));
+        int enviados = ::send(static_cast<DescriptorSocket>(socket_), datos, fragmento, OPCIONES_ENVIO);
+        if (enviados <= 0) {
+            return Status::IO_ERROR;
+        }
+        datos += enviados;
+        longitud -= static_cast<size_t>(enviados);
+    }
+    return Status::OK;
+}
+
+Status ClienteVoz::RecibirTodo(char* datos, size_t longitud) {
+    while (longitud > 0) {
+        int fragmento = static_cast<int>(std::min<size_t>(longitud, 1u << 20));
+        int recibidos = ::recv(static_cast<DescriptorSocket>(socket_), datos, fragmento, 0);
+        if (recibidos <= 0) {
+            return Status::IO_ERROR;
+        }
+        datos += recibidos;
+        longitud -= static_cast<size_t>(recibidos);
+    }
+    return Status::OK;
+}
+
+Status ClienteVoz::Solicitar(const std::string& cabecera, const char* cuerpo, size_t longitud_cuerpo,
+                             RespuestaVoz& respuesta) {
+    respuesta = RespuestaVoz();
+    const size_t longitud_carga = cabecera.size() + 1 + longitud_cuerpo;
+    char prefijo[4];
+    EscribirU32LE(prefijo, static_cast<uint32_t>(longitud_carga));
+
+    for (int intento = 0; intento < 2; ++intento) {
+        Status estado = Conectar();
+        if (estado != Status::OK) {
+            return estado;
+        }
+        std::string inicio(prefijo, sizeof(prefijo));
+        inicio += cabecera;
+        inicio += '\n';
+        estado = EnviarTodo(inicio.data(), inicio.size());
+        if (estado == Status::OK && longitud_cuerpo > 0) {
+            estado = EnviarTodo(cuerpo, longitud_cuerpo);
+        }
+        char prefijo_respuesta[4];
+        if (estado == Status::OK) {
+            estado = RecibirTodo(prefijo_respuesta, sizeof(prefijo_respuesta));
+        }
+        if (estado != Status::OK) {
+            // Conexión perdida (p. ej. el servicio se reinició): reconectar una vez
+            Cerrar();
+            continue;
+        }
+        uint32_t longitud = LeerLE(reinterpret_cast<const unsigned char*>(prefijo_respuesta), 4);
+        if (longitud > MAX_RESPUESTA) {
+            Cerrar();
+            return Status::INVALID_FORMAT;
+        }
+        std::string carga(longitud, '\0');
+        if (RecibirTodo(&carga[0], longitud) != Status::OK) {
+            Cerrar();
+            return Status::IO_ERROR;
+        }
+        return InterpretarRespuesta(carga, respuesta);
+    }
+    return Status::IO_ERROR;
+}
+
+Status ClienteVoz::InterpretarRespuesta(const std::string& carga, RespuestaVoz& respuesta) {
+    bool correcta = false;
+    std::istringstream lineas(carga);
+    std::string linea;
+    while (std::getline(lineas, linea)) {
+        if (linea.empty()) continue;
+        std::vector<std::string> campos = DividirPorTabuladores(linea);
+        const std::string& clave = campos[0];
+        const std::string valor = campos.size() > 1 ? campos[1] : "";
+        if (clave == "ESTADO") {
+            correcta = (valor == "OK");
+        } else if (clave == "MENSAJE") {
+            respuesta.mensaje = valor;
+        } else if (clave == "TRANSCRIPCION") {
+            respuesta.transcripcion = valor;
+        } else if (clave == "SQL") {
+            respuesta.sql = valor;
+        } else if (clave == "REVISION" && campos.size() > 1) {
+            RevisionVoz revision;
+            revision.original = campos[1];
+            revision.sugerencias.assign(campos.begin() + 2, campos.end());
+            respuesta.revisiones.push_back(std::move(revision));
+        }
+    }
+    return correcta ? Status::OK : Status::OPERATION_FAILED;
+}
+
+// ===== OPERACIONES =====
+
+Status ClienteVoz::Ping(std::string& mensaje) {
+    RespuestaVoz respuesta;
+    Status estado = Solicitar("PING", nullptr, 0, respuesta);
+    mensaje = respuesta.mensaje;
+    return estado;
+}
+
+Status ClienteVoz::TranscribirYCompilar(const std::vector<int16_t>& muestras, uint32_t frecuencia, uint16_t canales,
+                                        RespuestaVoz& respuesta) {
+    if (muestras.empty() || frecuencia == 0 || canales == 0) {
+        return Status::INVALID_ARGUMENT;
+    }
+    // PCM little-endian independientemente del orden de bytes del equipo
+    std::vector<char> pcm(muestras.size() * 2);
+    for (size_t i = 0; i < muestras.size(); ++i) {
+        uint16_t muestra = static_cast<uint16_t>(muestras[i]);
+        pcm[2 * i] = static_cast<char>(muestra & 0xFF);
+        pcm[2 * i + 1] = static_cast<char>(muestra >> 8);
+    }
+    std::string cabecera = "TRANSCRIBIR " + std::to_string(frecuencia) + " " + std::to_string(canales);
+    return Solicitar(cabecera, pcm.data(), pcm.size(), respuesta);
+}
+
+Status ClienteVoz::Compilar(const std::string& texto,
+                            const std::vector<std::pair<std::string, std::string>>& correcciones,
+                            RespuestaVoz& respuesta) {
+    std::string cuerpo;
+    for (const auto& correccion : correcciones) {
+        cuerpo += LimpiarCampo(correccion.first) + "\t" + LimpiarCampo(correccion.second) + "\n";
+    }
+    cuerpo += texto;
+    std::string cabecera = "COMPILAR " + std::to_string(correcciones.size());
+    return Solicitar(cabecera, cuerpo.data(), cuerpo.size(), respuesta);
+}
+
+Status ClienteVoz::DetenerServicio() {
+    if (!Conectado() && IntentarConexion() != Status::OK) {
+        return Status::NOT_FOUND; // No hay servicio en marcha
+    }
+    RespuestaVoz respuesta;
+    Status estado = Solicitar("TERMINAR", nullptr, 0, respuesta);
+    Cerrar();
+    servicio_lanzado_ = false;
+    return estado;
+}
+
+// ===== WAV =====
+
+Status ClienteVoz::LeerWAV(const std::string& ruta, std::vector<int16_t>& muestras,
+                           uint32_t& frecuencia, uint16_t& canales) {
+    muestras.clear();
+    std::ifstream archivo(ruta, std::ios::binary);
+    if (!archivo.is_open()) {
+        return Status::NOT_FOUND;
+    }
+    unsigned char riff[12];
+    if (!archivo.read(reinterpret_cast<char*>(riff), sizeof(riff)) ||
+        std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+        return Status::INVALID_FORMAT;
+    }
+
+    bool formato_leido = false;
+    unsigned char cabecera_fragmento[8];
+    while (archivo.read(reinterpret_cast<char*>(cabecera_fragmento), sizeof(cabecera_fragmento))) {
+        uint32_t tamano = LeerLE(cabecera_fragmento + 4, 4);
+        if (std::memcmp(cabecera_fragmento, "fmt ", 4) == 0) {
+            unsigned char formato[16];
+            if (tamano < sizeof(formato) || !archivo.read(reinterpret_cast<char*>(formato), sizeof(formato))) {
+                return Status::INVALID_FORMAT;
+            }
+            uint16_t codificacion = static_cast<uint16_t>(LeerLE(formato, 2));
+            canales = static_cast<uint16_t>(LeerLE(formato + 2, 2));
+            frecuencia = LeerLE(formato + 4, 4);
+            uint16_t bits = static_cast<uint16_t>(LeerLE(formato + 14, 2));
+            if (codificacion != 1 || bits != 16 || canales == 0) {
+                return Status::INVALID_FORMAT; // Solo PCM de 16 bits, como graba voz.cpp
+            }
+            formato_leido = true;
+            archivo.seekg(tamano - sizeof(formato) + (tamano & 1), std::ios::cur);
+        } else if (std::memcmp(cabecera_fragmento, "data", 4) == 0) {
+            if (!formato_leido) {
+                return Status::INVALID_FORMAT;
+            }
+            std::vector<unsigned char> datos(tamano);
+            archivo.read(reinterpret_cast<char*>(datos.data()), tamano);
+            size_t leidos = static_cast<size_t>(archivo.gcount());
+            muestras.resize(leidos / 2);
+            for (size_t i = 0; i < muestras.size(); ++i) {
+                muestras[i] = static_cast<int16_t>(LeerLE(&datos[2 * i], 2));
+            }
+            return Status::OK;
+        } else {
+            archivo.seekg(tamano + (tamano & 1), std::ios::cur); // Los fragmentos se alinean a 2 bytes
+        }
+    }
+    return Status::INVALID_FORMAT;
+}
@@ -0,0 +1,118 @@
+// audio_processor/cliente_voz.h - Cliente del servicio persistente de voz a SQL
+// Envía el audio en memoria a servicio_voz.py por un socket local y recibe la SQL
+
+#ifndef CLIENTE_VOZ_H
+#define CLIENTE_VOZ_H
+
+#include "../include/common.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct OpcionesServicioVoz {
+    std::string directorio = "src/audio_processor"; // Donde están servicio_voz.py y relaciones_tablas.txt
+#ifdef _WIN32
+    std::string interprete = "python";
+#else
+    std::string interprete = "python3";
+#endif
+    uint16_t puerto = 50517;
+    bool arrancar_si_no_responde = true;   // Lanzar el servicio en segundo plano si no hay nadie escuchando
+    uint32_t espera_arranque_ms = 20000;   // Tiempo máximo para que el servicio recién lanzado acepte conexiones
+};
+
+/**
+ * @brief Palabra que no está entre las tablas/columnas válidas, con sus sugerencias.
+ */
+struct RevisionVoz {
+    std::string original;
+    std::vector<std::string> sugerencias;
+};
+
+struct RespuestaVoz {
+    std::string transcripcion;
+    std::string sql;
+    std::vector<RevisionVoz> revisiones;
+    std::string mensaje;   // Mensaje del servicio (error o estado)
+};
+
+/**
+ * @brief Conexión con servicio_voz.py, que mantiene cargados Whisper y el Trie de vocabulario.
+ *
+ * La conexión se abre una vez y se reutiliza entre consultas de voz; si el servicio
+ * no está en marcha se lanza en segundo plano (una sola vez) y se reintenta hasta
+ * espera_arranque_ms. Al destruir el cliente se cierra la conexión pero el servicio
+ * sigue vivo para el siguiente arranque del SGBD; DetenerServicio() lo termina.
+ *
+ * El protocolo (tramas con longitud de 4 bytes little-endian) se describe en
+ * servicio_voz.py.
+ */
+class ClienteVoz {
+public:
+    explicit ClienteVoz(const OpcionesServicioVoz& opciones = OpcionesServicioVoz());
+    ~ClienteVoz();
+
+    ClienteVoz(const ClienteVoz&) = delete;
+    ClienteVoz& operator=(const ClienteVoz&) = delete;
+
+    /**
+     * @brief Conecta con el servicio, lanzándolo si hace falta.
+     * @return IO_ERROR si no responde dentro de espera_arranque_ms
+     */
+    Status Conectar();
+    bool Conectado() const;
+
+    /**
+     * @brief Comprueba que el servicio responde; mensaje indica si Whisper está cargado.
+     */
+    Status Ping(std::string& mensaje);
+
+    /**
+     * @brief Transcribe muestras PCM de 16 bits y compila el texto a SQL.
+     * @return OPERATION_FAILED si el servicio informa de un error (ver respuesta.mensaje)
+     */
+    Status TranscribirYCompilar(const std::vector<int16_t>& muestras, uint32_t frecuencia, uint16_t canales,
+                                RespuestaVoz& respuesta);
+
+    /**
+     * @brief Compila texto a SQL aplicando las correcciones (original, elegida) del usuario.
+     */
+    Status Compilar(const std::string& texto, const std::vector<std::pair<std::string, std::string>>& correcciones,
+                    RespuestaVoz& respuesta);
+
+    /**
+     * @brief Pide al servicio que termine y cierra la conexión.
+     */
+    Status DetenerServicio();
+
+    /**
+     * @brief Lee un WAV PCM de 16 bits (p. ej. el que deja grabadora_audio.exe).
+     * @return INVALID_FORMAT si no es RIFF/WAVE PCM de 16 bits
+     */
+    static Status LeerWAV(const std::string& ruta, std::vector<int16_t>& muestras,
+                          uint32_t& frecuencia, uint16_t& canales);
+
+private:
+    static constexpr uint32_t MAX_RESPUESTA = 16u * 1024 * 1024;
+
+    OpcionesServicioVoz opciones_;
+    std::intptr_t socket_;
+    bool servicio_lanzado_ = false;
+
+    Status IntentarConexion();
+    Status ArrancarServicio();
+    void Cerrar();
+
+    /**
+     * @brief Envía una petición (cabecera + cuerpo) y recibe la respuesta ya interpretada.
+     * Si la conexión se perdió se reconecta una vez antes de fallar.
+     */
+    Status Solicitar(const std::string& cabecera, const char* cuerpo, size_t longitud_cuerpo,
+                     RespuestaVoz& respuesta);
+    Status EnviarTodo(const char* datos, size_t longitud);
+    Status RecibirTodo(char* datos, size_t longitud);
+    static Status InterpretarRespuesta(const std::string& carga, RespuestaVoz& respuesta);
+};
+
+#endif // CLIENTE_VOZ_H
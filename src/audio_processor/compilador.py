@@ -523,6 +523,68 @@ def revisar_y_sugerir_traduccion(sql_query, estructura, diccionario_valido_trie,
     
     return nueva_sql_query
 
+# === Vocabulario de tablas y columnas ===
+def crear_vocabulario_ejemplo(ruta):
+    """Crea un esquema de ejemplo con tablas y columnas válidas si no existe."""
+    if os.path.exists(ruta):
+        return
+    print(f"Creando '{ruta}' de ejemplo con tablas y columnas válidas.")
+    with open(ruta, "w", encoding="utf-8") as f:
+        for palabra in ("clientes", "productos", "ventas", "nombre", "edad",
+                        "id", "dept", "precio", "fecha", "cantidad"):
+            f.write(palabra + "\n")
+
+# === Revisión no interactiva (la usa servicio_voz.py) ===
+def buscar_revisiones(estructura, diccionario_valido_trie, todas_palabras_validas=None, aceptadas=()):
+    """
+    Igual que la detección de revisar_y_sugerir_traduccion, pero sin preguntar:
+    devuelve las palabras de la estructura que no están en el Trie con sus
+    sugerencias, y deja la elección a quien llama.
+
+    Args:
+        estructura (dict): La estructura sintáctica analizada.
+        diccionario_valido_trie (Trie): Tablas y columnas válidas.
+        todas_palabras_validas (list): get_all_words() ya calculado (opcional).
+        aceptadas (iterable): Palabras que el usuario ya confirmó; no se revisan.
+
+    Returns:
+        list: Pares (palabra, [sugerencias]) en el orden en que aparecen.
+    """
+    if todas_palabras_validas is None:
+        todas_palabras_validas = diccionario_valido_trie.get_all_words()
+    aceptadas = set(aceptadas)
+
+    candidatas = []
+    if estructura.get("entidad"):
+        candidatas.append(estructura["entidad"])
+    candidatas.extend(estructura.get("atributos_mostrar", []))
+    candidatas.extend(c.get("atributo") for c in estructura.get("condiciones", []) if c.get("atributo"))
+
+    revisiones = []
+    vistas = set()
+    for palabra in candidatas:
+        if palabra in vistas or palabra in aceptadas or diccionario_valido_trie.search(palabra):
+            continue
+        vistas.add(palabra)
+        sugerencias = get_close_matches(palabra, todas_palabras_validas, n=5, cutoff=0.6)
+        revisiones.append((palabra, sugerencias))
+    return revisiones
+
+def aplicar_correcciones(estructura, correcciones):
+    """
+    Sustituye en la estructura cada palabra original por la elegida
+    (entidad, atributos a mostrar y atributos de las condiciones).
+    La SQL debe regenerarse después con generar_sql(estructura).
+    """
+    if estructura.get("entidad") in correcciones:
+        estructura["entidad"] = correcciones[estructura["entidad"]]
+    if "atributos_mostrar" in estructura:
+        estructura["atributos_mostrar"] = [correcciones.get(a, a) for a in estructura["atributos_mostrar"]]
+    for cond in estructura.get("condiciones", []):
+        if cond.get("atributo") in correcciones:
+            cond["atributo"] = correcciones[cond["atributo"]]
+    return estructura
+
 # === Compilador Principal ===
 def compilador_nl2sql_texto(texto): #
     print("Texto de entrada:", texto) #
@@ -551,20 +613,7 @@ if __name__ == "__main__":
     
     nombre_archivo_para_gestor = "consulta_para_gestor.txt" #
 
-    # Crear un esquema_db.txt de ejemplo si no existe
-    if not os.path.exists(input_db_schema_file):
-        print(f"Creando '{input_db_schema_file}' de ejemplo con tablas y columnas válidas.")
-        with open(input_db_schema_file, "w", encoding="utf-8") as f:
-            f.write("clientes\n")
-            f.write("productos\n")
-            f.write("ventas\n")
-            f.write("nombre\n")
-            f.write("edad\n")
-            f.write("id\n")
-            f.write("dept\n")
-            f.write("precio\n")
-            f.write("fecha\n")
-            f.write("cantidad\n") # Añadimos una columna de ejemplo para probar
+    crear_vocabulario_ejemplo(input_db_schema_file)
 
     # Generar el Trie con las tablas y columnas válidas de la DB
     diccionario_valido_trie = generate_dataset_and_trie(input_db_schema_file)
@@ -0,0 +1,173 @@
+// audio_processor/grabadora_voz.cpp - Captura del micrófono a memoria con PortAudio
+#include "grabadora_voz.h"
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <portaudio.h>
+
+namespace {
+
+const PaSampleFormat SAMPLE_FORMAT = paInt16; // Formato de sampleo: 16-bit signed integer
+
+// --- Estructura para almacenar los datos de audio ---
+struct AudioData {
+    std::vector<int16_t> buffer;
+};
+
+// --- Función de callback de PortAudio para el stream de entrada ---
+// Esta función se llama automáticamente cuando hay nuevos datos de audio disponibles.
+static int recordCallback(const void* inputBuffer, void* outputBuffer,unsigned long framesPerBuffer,const PaStreamCallbackTimeInfo* timeInfo,PaStreamCallbackFlags statusFlags,void* userData) {
+    // Recuperar el puntero a nuestra estructura AudioData
+    AudioData* data = static_cast<AudioData*>(userData);
+    // Convertir el buffer de entrada al tipo de datos correcto (int16_t)
+    const int16_t* in = static_cast<const int16_t*>(inputBuffer);
+
+    // Asegurarse de que el buffer de entrada no sea nulo (aunque en PortAudio no debería serlo para streams de entrada)
+    if (in != nullptr) {
+        // Calcular el número total de samples (frames * canales)
+        size_t numSamplesToInsert = framesPerBuffer * NUM_CHANNELS;
+        // Añadir los samples del buffer de entrada al vector de audioData
+        data->buffer.insert(data->buffer.end(), in, in + numSamplesToInsert);
+    }
+
+    // Indicar a PortAudio que el stream debe continuar
+    return paContinue;
+}
+
+} // namespace
+
+bool recordFromMicrophone(std::vector<int16_t>& buffer) {
+    buffer.clear();
+    PaError err = paNoError; // Inicializar err a paNoError
+    PaStream* stream = nullptr; // Inicializar stream a nullptr para un manejo seguro
+
+    // 1. Inicializar PortAudio
+    err = Pa_Initialize();
+    if (err != paNoError) {
+        std::cerr << "Error de inicialización de PortAudio: " << Pa_GetErrorText(err) << std::endl;
+        return false;
+    }
+
+    // 2. Obtener y listar los dispositivos de entrada disponibles
+    int numDevices = Pa_GetDeviceCount();
+    if (numDevices < 0) {
+        std::cerr << "Error al obtener la cuenta de dispositivos de PortAudio: " << Pa_GetErrorText(numDevices) << std::endl;
+        Pa_Terminate();
+        return false;
+    }
+    if (numDevices == 0) {
+        std::cerr << "Error: No se encontraron dispositivos de audio de PortAudio." << std::endl;
+        Pa_Terminate();
+        return false;
+    }
+
+    std::cout << "Dispositivos de entrada de PortAudio disponibles:" << std::endl;
+    int inputDeviceCount = 0;
+    // vector para almacenar solo los índices de dispositivos de entrada válidos
+    std::vector<int> inputDeviceIndices;
+
+    for (int i = 0; i < numDevices; ++i) {
+        const PaDeviceInfo* deviceInfo = Pa_GetDeviceInfo(i);
+        if (deviceInfo != nullptr && deviceInfo->maxInputChannels > 0) {
+            std::cout << "[" << i << "] " << deviceInfo->name << std::endl;
+            inputDeviceCount++;
+            inputDeviceIndices.push_back(i); // Almacenar el índice real del dispositivo
+        }
+    }
+
+    if (inputDeviceCount == 0) {
+        std::cerr << "Error: No se encontraron dispositivos de entrada de audio." << std::endl;
+        Pa_Terminate();
+        return false;
+    }
+
+    // 3. Permitir al usuario seleccionar un dispositivo
+    int selectedDeviceIndex = -1;
+    std::cout << "Ingrese el índice del dispositivo de entrada a usar: ";
+    std::cin >> selectedDeviceIndex;
+
+    // Consumir el resto de la línea después de leer el entero para evitar problemas con std::cin.get()
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+    // Validar la selección del usuario
+    bool isValidSelection = false;
+    for (int idx : inputDeviceIndices) {
+        if (idx == selectedDeviceIndex) {
+            isValidSelection = true;
+            break;
+        }
+    }
+
+    if (!isValidSelection) {
+        std::cerr << "Índice de dispositivo seleccionado inválido o no es un dispositivo de entrada." << std::endl;
+        Pa_Terminate();
+        return false;
+    }
+
+    const PaDeviceInfo* selectedDeviceInfo = Pa_GetDeviceInfo(selectedDeviceIndex);
+    std::cout << "Usando el dispositivo de entrada: " << selectedDeviceInfo->name << std::endl;
+    std::cout << "Frecuencia de muestreo nativa por defecto: " << selectedDeviceInfo->defaultSampleRate << " Hz" << std::endl;
+    std::cout << "Formatos de sampleo comúnmente soportados (puede variar): Int16, Float32" << std::endl;
+
+    if (selectedDeviceInfo->maxInputChannels < NUM_CHANNELS) {
+        std::cerr << "Error: El dispositivo de entrada seleccionado no soporta " << NUM_CHANNELS << " canales." << std::endl;
+        Pa_Terminate();
+        return false;
+    }
+
+    // 4. Configurar parámetros del stream de PortAudio
+    AudioData audioData; // Los callbacks añaden aquí las muestras
+
+    PaStreamParameters inputParameters;
+    inputParameters.device = selectedDeviceIndex;
+    inputParameters.channelCount = NUM_CHANNELS;
+    inputParameters.sampleFormat = SAMPLE_FORMAT;
+    inputParameters.suggestedLatency = selectedDeviceInfo->defaultLowInputLatency;
+    inputParameters.hostApiSpecificStreamInfo = nullptr;
+
+    // 5. Abrir el stream de PortAudio
+    err = Pa_OpenStream(
+        &stream,
+        &inputParameters,
+        nullptr, // No stream de salida (solo grabación)
+        SAMPLE_RATE,
+        FRAMES_PER_BUFFER,
+        paClipOff, // No necesitamos clipping, ya que estamos capturando
+        recordCallback, // Nuestro callback para procesar el audio
+        &audioData);    // Datos de usuario que se pasan al callback
+    if (err != paNoError) {
+        std::cerr << "Error al abrir el stream: " << Pa_GetErrorText(err) << std::endl;
+        Pa_Terminate();
+        return false;
+    }
+
+    // 6. Iniciar el stream de grabación
+    err = Pa_StartStream(stream);
+    if (err != paNoError) {
+        std::cerr << "Error al iniciar el stream: " << Pa_GetErrorText(err) << std::endl;
+        Pa_CloseStream(stream); // Intentar cerrar el stream si no se pudo iniciar
+        Pa_Terminate();
+        return false;
+    }
+
+    std::cout << "Grabando audio... Presione Enter para detener." << std::endl;
+    std::cin.get(); // Esperar a que el usuario presione Enter
+
+    // 7. Detener el stream
+    err = Pa_StopStream(stream);
+    if (err != paNoError) {
+        std::cerr << "Error al detener el stream: " << Pa_GetErrorText(err) << std::endl;
+    }
+
+    // 8. Cerrar el stream
+    err = Pa_CloseStream(stream);
+    if (err != paNoError) {
+        std::cerr << "Error al cerrar el stream: " << Pa_GetErrorText(err) << std::endl;
+    }
+
+    // 9. Terminar PortAudio
+    Pa_Terminate();
+
+    buffer = std::move(audioData.buffer);
+    return true;
+}
@@ -0,0 +1,23 @@
+// audio_processor/grabadora_voz.h - Captura del micrófono a memoria con PortAudio
+// La usan grabadora_audio (voz.cpp, que además guarda grabacion.wav) y el SGBD
+
+#ifndef GRABADORA_VOZ_H
+#define GRABADORA_VOZ_H
+
+#include <cstdint>
+#include <vector>
+
+// --- Formato de la grabación (el que espera Whisper) ---
+const int SAMPLE_RATE = 16000;          // Frecuencia de muestreo en Hz
+const int FRAMES_PER_BUFFER = 512;      // Número de frames por buffer
+const int NUM_CHANNELS = 1;             // 1 para mono, 2 para estéreo
+
+/**
+ * @brief Lista los dispositivos de entrada, pide uno al usuario y graba hasta
+ * que pulse Enter.
+ * @param buffer [out] Muestras PCM de 16 bits a SAMPLE_RATE Hz y NUM_CHANNELS canales
+ * @return false si PortAudio falla o el dispositivo elegido no es válido
+ */
+bool recordFromMicrophone(std::vector<int16_t>& buffer);
+
+#endif // GRABADORA_VOZ_H
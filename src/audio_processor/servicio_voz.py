@@ -0,0 +1,223 @@
+# servicio_voz.py - Servicio persistente de voz a SQL para el SGBD
+"""
+Proceso de larga duración que sustituye a la cadena
+grabadora_audio.exe -> transcribir_audio.py -> compilador.py.
+
+El modelo Whisper se carga una sola vez al arrancar y el Trie de tablas y
+columnas válidas se construye una vez y solo se reconstruye si cambia
+relaciones_tablas.txt. El audio llega en memoria por un socket local (solo
+127.0.0.1) y la SQL se devuelve por el mismo socket, sin archivos intermedios.
+
+PROTOCOLO (lo implementa también audio_processor/cliente_voz.cpp):
+  Cada mensaje, en ambos sentidos, es una trama: longitud de 4 bytes
+  little-endian seguida de la carga. La carga de una petición empieza con una
+  línea de cabecera terminada en '\\n':
+    PING
+    TRANSCRIBIR <frecuencia_hz> <canales>   + muestras PCM int16 little-endian
+    COMPILAR <numero_correcciones>          + n líneas "original\\telegida" + texto
+    TERMINAR
+  La respuesta son líneas "CLAVE\\tvalor":
+    ESTADO OK | ESTADO ERROR, MENSAJE, TRANSCRIPCION, SQL y una línea
+    REVISION\\tpalabra\\tsugerencia1\\t... por palabra que no está en el Trie.
+
+Uso: python servicio_voz.py [--puerto 50517] [--modelo base] [--sin-precarga]
+"""
+
+import argparse
+import os
+import socket
+import struct
+import sys
+import time
+
+import compilador
+
+PUERTO_POR_DEFECTO = 50517
+FRECUENCIA_WHISPER = 16000
+MAX_TRAMA = 64 * 1024 * 1024  # 64 MiB: unos 30 minutos de audio mono a 16 kHz
+
+
+def limpiar_campo(texto):
+    """Los campos viajan separados por tabuladores y líneas."""
+    return " ".join(str(texto).replace("\t", " ").split())
+
+
+class ServicioVoz:
+    def __init__(self, nombre_modelo, ruta_vocabulario):
+        self.nombre_modelo = nombre_modelo
+        self.ruta_vocabulario = ruta_vocabulario
+        self.modelo = None
+        self.trie = None
+        self.palabras_validas = []
+        self.mtime_vocabulario = None
+
+    # --- Recursos que se mantienen cargados ---
+
+    def cargar_modelo(self):
+        if self.modelo is None:
+            import whisper  # Solo hace falta para transcribir
+            inicio = time.time()
+            print(f"Cargando el modelo Whisper '{self.nombre_modelo}'...")
+            self.modelo = whisper.load_model(self.nombre_modelo)
+            print(f"Modelo cargado en {time.time() - inicio:.1f} s.")
+        return self.modelo
+
+    def vocabulario(self):
+        """Trie de tablas y columnas; se reconstruye solo si el archivo cambió."""
+        try:
+            mtime = os.path.getmtime(self.ruta_vocabulario)
+        except OSError:
+            return None, []
+        if self.trie is None or mtime != self.mtime_vocabulario:
+            trie = compilador.generate_dataset_and_trie(self.ruta_vocabulario)
+            if trie is not None:
+                self.trie = trie
+                self.palabras_validas = trie.get_all_words()
+                self.mtime_vocabulario = mtime
+                print(f"Vocabulario cargado: {len(self.palabras_validas)} palabras.")
+        return self.trie, self.palabras_validas
+
+    # --- Operaciones ---
+
+    def transcribir(self, pcm, frecuencia, canales):
+        import numpy as np
+        muestras = np.frombuffer(pcm, dtype="<i2").astype(np.float32) / 32768.0
+        if canales > 1:
+            muestras = muestras[: len(muestras) - len(muestras) % canales].reshape(-1, canales).mean(axis=1)
+        if frecuencia != FRECUENCIA_WHISPER and len(muestras) > 0:
+            # Remuestreo lineal: Whisper espera 16 kHz
+            duracion = len(muestras) / float(frecuencia)
+            destino = np.linspace(0.0, duracion, int(duracion * FRECUENCIA_WHISPER), endpoint=False)
+            origen = np.arange(len(muestras)) / float(frecuencia)
+            muestras = np.interp(destino, origen, muestras).astype(np.float32)
+        resultado = self.cargar_modelo().transcribe(muestras)
+        return resultado["text"].strip()
+
+    def compilar(self, texto, correcciones):
+        sql, estructura = compilador.compilador_nl2sql_texto(texto)
+        trie, palabras = self.vocabulario()
+        if correcciones:
+            compilador.aplicar_correcciones(estructura, correcciones)
+            sql = compilador.generar_sql(estructura)
+        revisiones = []
+        if trie is not None:
+            revisiones = compilador.buscar_revisiones(estructura, trie, palabras, correcciones.values())
+        return sql, revisiones
+
+    # --- Protocolo ---
+
+    def atender(self, carga):
+        """Devuelve (lineas_respuesta, terminar)."""
+        fin_cabecera = carga.find(b"\n")
+        if fin_cabecera < 0:
+            fin_cabecera = len(carga)
+        cabecera = carga[:fin_cabecera].decode("utf-8", errors="replace").split()
+        cuerpo = carga[fin_cabecera + 1:]
+        if not cabecera:
+            return [("ESTADO", "ERROR"), ("MENSAJE", "Petición vacía")], False
+        orden = cabecera[0]
+
+        if orden == "PING":
+            return [("ESTADO", "OK"), ("MENSAJE", "modelo cargado" if self.modelo else "modelo sin cargar")], False
+        if orden == "TERMINAR":
+            return [("ESTADO", "OK")], True
+        if orden == "TRANSCRIBIR":
+            frecuencia = int(cabecera[1]) if len(cabecera) > 1 else FRECUENCIA_WHISPER
+            canales = int(cabecera[2]) if len(cabecera) > 2 else 1
+            texto = self.transcribir(cuerpo, frecuencia, canales)
+            lineas = [("ESTADO", "OK"), ("TRANSCRIPCION", texto)]
+            if texto:
+                sql, revisiones = self.compilar(texto, {})
+                lineas.append(("SQL", sql))
+                lineas.extend(("REVISION", palabra, *sugerencias) for palabra, sugerencias in revisiones)
+            return lineas, False
+        if orden == "COMPILAR":
+            numero = int(cabecera[1]) if len(cabecera) > 1 else 0
+            partes = cuerpo.decode("utf-8", errors="replace").split("\n", numero)
+            correcciones = {}
+            for linea in partes[:numero]:
+                original, _, elegida = linea.partition("\t")
+                correcciones[original] = elegida
+            texto = partes[numero] if len(partes) > numero else ""
+            sql, revisiones = self.compilar(texto.strip(), correcciones)
+            lineas = [("ESTADO", "OK"), ("SQL", sql)]
+            lineas.extend(("REVISION", palabra, *sugerencias) for palabra, sugerencias in revisiones)
+            return lineas, False
+        return [("ESTADO", "ERROR"), ("MENSAJE", f"Orden desconocida: {orden}")], False
+
+
+def recibir_exacto(conexion, longitud):
+    datos = bytearray()
+    while len(datos) < longitud:
+        bloque = conexion.recv(min(longitud - len(datos), 1 << 20))
+        if not bloque:
+            return None
+        datos.extend(bloque)
+    return bytes(datos)
+
+
+def enviar_respuesta(conexion, lineas):
+    texto = "\n".join("\t".join(limpiar_campo(campo) for campo in linea) for linea in lineas) + "\n"
+    carga = texto.encode("utf-8")
+    conexion.sendall(struct.pack("<I", len(carga)) + carga)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Servicio persistente de voz a SQL")
+    parser.add_argument("--puerto", type=int, default=PUERTO_POR_DEFECTO)
+    parser.add_argument("--modelo", default="base")
+    parser.add_argument("--vocabulario", default="relaciones_tablas.txt")
+    parser.add_argument("--sin-precarga", action="store_true",
+                        help="No cargar Whisper hasta la primera transcripción")
+    args = parser.parse_args()
+
+    servicio = ServicioVoz(args.modelo, args.vocabulario)
+
+    # Escuchar antes de cargar: los clientes que conecten mientras tanto esperan en la cola
+    servidor = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    servidor.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    try:
+        servidor.bind(("127.0.0.1", args.puerto))
+    except OSError as e:
+        print(f"Error: No se pudo escuchar en 127.0.0.1:{args.puerto}: {e}")
+        return 1
+    servidor.listen(4)
+
+    compilador.crear_vocabulario_ejemplo(args.vocabulario)
+    servicio.vocabulario()
+    if not args.sin_precarga:
+        try:
+            servicio.cargar_modelo()
+        except Exception as e:  # Sin Whisper el servicio sigue compilando texto
+            print(f"Aviso: No se pudo cargar Whisper ({e}); solo se atenderá COMPILAR.")
+    print(f"Servicio de voz escuchando en 127.0.0.1:{args.puerto}")
+    sys.stdout.flush()
+
+    terminar = False
+    while not terminar:
+        conexion, _ = servidor.accept()
+        with conexion:
+            while True:
+                cabecera = recibir_exacto(conexion, 4)
+                if cabecera is None:
+                    break
+                (longitud,) = struct.unpack("<I", cabecera)
+                if longitud > MAX_TRAMA:
+                    enviar_respuesta(conexion, [("ESTADO", "ERROR"), ("MENSAJE", "Trama demasiado grande")])
+                    break
+                carga = recibir_exacto(conexion, longitud)
+                if carga is None:
+                    break
+                try:
+                    lineas, terminar = servicio.atender(carga)
+                except Exception as e:
+                    lineas = [("ESTADO", "ERROR"), ("MENSAJE", str(e))]
+                enviar_respuesta(conexion, lineas)
+                if terminar:
+                    break
+    servidor.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
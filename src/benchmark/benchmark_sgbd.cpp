@@ -0,0 +1,851 @@
+// benchmark/benchmark_sgbd.cpp - Banco de pruebas de rendimiento de cada capa de almacenamiento
+// Mide disco, buffer, registros, índices y consultas sobre datos generados de forma reproducible
+//
+// Uso: benchmark_sgbd [--filas N] [--semilla S] [--directorio RUTA] [--salida ARCHIVO]
+//                     [--operaciones N] [--suites disco,buffer,registros,indices,consultas]
+//
+// Cada medición se escribe como una línea JSON (JSON Lines) para poder comparar
+// ejecuciones entre versiones; los mensajes de progreso de los gestores van a
+// std::cout y std::cerr, así que conviene usar --salida.
+
+#include "../include/common.h"
+#include "../data_storage/gestor_disco.h"
+#include "../data_storage/gestor_buffer.h"
+#include "../replacement_policies/lru_espanol.h"
+#include "../replacement_policies/clock_espanol.h"
+#include "../replacement_policies/dos_colas_espanol.h"
+#include "../replacement_policies/clock_atomico_espanol.h"
+#include "../Catalog_Manager/gestor_catalogo.h"
+#include "../record_manager/gestor_registros.h"
+#include "../record_manager/cursor_registros.h"
+#include "../index/gestor_indices.h"
+#include "../index/ordenador_entradas_indice.h"
+#include "../query_processor/analizador_sql.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t VERSION_FORMATO_RESULTADOS = 1;
+
+// ===== CONFIGURACIÓN =====
+
+struct ConfiguracionBenchmark {
+    uint32_t filas = 20000;              // Filas de la tabla clientes generada
+    uint64_t semilla = 42;
+    uint32_t operaciones = 200000;       // Accesos por caso del buffer
+    std::string directorio = "bench_tmp";
+    std::string salida;                  // Vacío = std::cout
+    std::vector<std::string> suites = {"disco", "buffer", "registros", "indices", "consultas"};
+
+    bool SuiteActiva(const std::string& suite) const {
+        return std::find(suites.begin(), suites.end(), suite) != suites.end();
+    }
+};
+
+// ===== GENERACIÓN REPRODUCIBLE =====
+
+/**
+ * @brief splitmix64: la misma semilla da la misma secuencia en cualquier compilador,
+ *        a diferencia de las distribuciones de <random>.
+ */
+class GeneradorAleatorio {
+public:
+    explicit GeneradorAleatorio(uint64_t semilla) : estado_(semilla) {}
+
+    uint64_t Siguiente() {
+        uint64_t z = (estado_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Entero en [0, limite)
+    uint64_t Menor(uint64_t limite) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(Siguiente()) * limite) >> 64);
+    }
+
+    // Real en [0, 1)
+    double Unidad() { return (Siguiente() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    uint64_t estado_;
+};
+
+/**
+ * @brief Distribución de Zipf sobre [0, n) por búsqueda binaria en la función de distribución.
+ * Los rangos se permutan para que las páginas más calientes no sean contiguas.
+ */
+class DistribucionZipf {
+public:
+    DistribucionZipf(uint32_t n, double exponente, GeneradorAleatorio& generador) : acumulada_(n), permutacion_(n) {
+        double total = 0.0;
+        for (uint32_t i = 0; i < n; ++i) {
+            total += 1.0 / std::pow(static_cast<double>(i + 1), exponente);
+            acumulada_[i] = total;
+            permutacion_[i] = i;
+        }
+        for (double& valor : acumulada_) {
+            valor /= total;
+        }
+        for (uint32_t i = n; i > 1; --i) {
+            std::swap(permutacion_[i - 1], permutacion_[generador.Menor(i)]);
+        }
+    }
+
+    uint32_t Muestra(GeneradorAleatorio& generador) const {
+        double u = generador.Unidad();
+        size_t rango = std::lower_bound(acumulada_.begin(), acumulada_.end(), u) - acumulada_.begin();
+        return permutacion_[std::min(rango, permutacion_.size() - 1)];
+    }
+
+private:
+    std::vector<double> acumulada_;
+    std::vector<uint32_t> permutacion_;
+};
+
+/**
+ * @brief Filas de clientes.txt escaladas: se toman sus nombres y apellidos como
+ *        semillas y se generan id, teléfono y email únicos.
+ */
+std::vector<DatosRegistro> GenerarClientes(uint32_t filas, GeneradorAleatorio& generador) {
+    std::vector<std::string> nombres = {"Juan", "Ana", "Luis", "Sofía"};
+    std::vector<std::string> apellidos = {"Pérez", "Gómez", "Martínez", "Ramos"};
+    for (const char* ruta : {"clientes.txt", "../clientes.txt", "../../clientes.txt"}) {
+        std::ifstream archivo(ruta);
+        if (!archivo.is_open()) {
+            continue;
+        }
+        std::string linea;
+        std::getline(archivo, linea); // Cabecera
+        while (std::getline(archivo, linea)) {
+            std::istringstream campos(linea);
+            std::string id, nombre, apellido;
+            if (campos >> id >> nombre >> apellido) {
+                nombres.push_back(nombre);
+                apellidos.push_back(apellido);
+            }
+        }
+        break;
+    }
+
+    std::vector<DatosRegistro> registros;
+    registros.reserve(filas);
+    for (uint32_t i = 0; i < filas; ++i) {
+        const std::string& nombre = nombres[generador.Menor(nombres.size())];
+        const std::string& apellido = apellidos[generador.Menor(apellidos.size())];
+        std::string telefono = std::to_string(900000000 + generador.Menor(100000000));
+        std::string email = nombre + "." + apellido + std::to_string(i + 1) + "@email.com";
+        registros.emplace_back(std::vector<std::string>{std::to_string(i + 1), nombre, apellido, telefono, email});
+    }
+    return registros;
+}
+
+std::vector<ColumnMetadata> EsquemaClientes() {
+    return {
+        ColumnMetadata("id", ColumnType::INT, 4, true, false),
+        ColumnMetadata("nombre", ColumnType::CHAR, 20),
+        ColumnMetadata("apellido", ColumnType::CHAR, 20),
+        ColumnMetadata("telefono", ColumnType::INT, 4),
+        ColumnMetadata("email", ColumnType::CHAR, 48),
+    };
+}
+
+// ===== RESULTADOS =====
+
+double Segundos(std::chrono::steady_clock::time_point inicio) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+std::string EscaparJSON(const std::string& texto) {
+    std::string resultado;
+    for (char c : texto) {
+        if (c == '"' || c == '\\') {
+            resultado += '\\';
+            resultado += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::ostringstream escape;
+            escape << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+            resultado += escape.str();
+        } else {
+            resultado += c;
+        }
+    }
+    return resultado;
+}
+
+/**
+ * @brief Una medición: parámetros del caso (texto) y métricas (números).
+ */
+struct Medicion {
+    std::string suite;
+    std::string caso;
+    std::vector<std::pair<std::string, std::string>> parametros;
+    std::vector<std::pair<std::string, double>> metricas;
+
+    Medicion& Parametro(const std::string& nombre, const std::string& valor) {
+        parametros.emplace_back(nombre, valor);
+        return *this;
+    }
+    Medicion& Parametro(const std::string& nombre, uint64_t valor) { return Parametro(nombre, std::to_string(valor)); }
+    Medicion& Metrica(const std::string& nombre, double valor) {
+        metricas.emplace_back(nombre, valor);
+        return *this;
+    }
+
+    /**
+     * @brief Operaciones, segundos y operaciones por segundo.
+     */
+    Medicion& Rendimiento(uint64_t operaciones, double segundos) {
+        Metrica("operaciones", static_cast<double>(operaciones));
+        Metrica("segundos", segundos);
+        return Metrica("ops_por_segundo", segundos > 0 ? operaciones / segundos : 0.0);
+    }
+
+    /**
+     * @brief Percentiles de latencia en microsegundos.
+     */
+    Medicion& Latencias(std::vector<double> microsegundos) {
+        if (microsegundos.empty()) {
+            return *this;
+        }
+        std::sort(microsegundos.begin(), microsegundos.end());
+        auto percentil = [&](double p) {
+            return microsegundos[std::min(microsegundos.size() - 1, static_cast<size_t>(p * microsegundos.size()))];
+        };
+        Metrica("p50_us", percentil(0.50));
+        Metrica("p95_us", percentil(0.95));
+        Metrica("p99_us", percentil(0.99));
+        return Metrica("max_us", microsegundos.back());
+    }
+};
+
+class SalidaResultados {
+public:
+    explicit SalidaResultados(std::ostream& salida) : salida_(salida) {}
+
+    void Escribir(const Medicion& medicion) {
+        salida_ << "{\"suite\":\"" << EscaparJSON(medicion.suite) << "\",\"caso\":\"" << EscaparJSON(medicion.caso) << "\"";
+        for (const auto& parametro : medicion.parametros) {
+            salida_ << ",\"" << EscaparJSON(parametro.first) << "\":\"" << EscaparJSON(parametro.second) << "\"";
+        }
+        for (const auto& metrica : medicion.metricas) {
+            salida_ << ",\"" << EscaparJSON(metrica.first) << "\":";
+            if (std::isfinite(metrica.second)) {
+                salida_ << std::setprecision(9) << metrica.second;
+            } else {
+                salida_ << "null";
+            }
+        }
+        salida_ << "}" << std::endl;
+    }
+
+private:
+    std::ostream& salida_;
+};
+
+// ===== ENTORNO =====
+
+/**
+ * @brief Disco de pruebas en un directorio propio, borrado al terminar.
+ * 8 platos x 2 superficies x 64 pistas x 64 sectores de BLOCK_SIZE bytes = 65536 bloques.
+ */
+std::shared_ptr<GestorDisco> CrearDisco(const ConfiguracionBenchmark& configuracion, const std::string& nombre,
+                                        ModoAlmacenamiento modo) {
+    fs::path ruta = fs::path(configuracion.directorio) / nombre;
+    std::error_code error;
+    fs::remove_all(ruta, error);
+    fs::create_directories(ruta, error);
+    auto disco = std::make_shared<GestorDisco>(ruta.string(), nombre, 8, 2, 64, 64, BLOCK_SIZE);
+    disco->EstablecerModoAlmacenamiento(modo);
+    disco->EstablecerModoRegistroAcceso(ModoRegistroAcceso::DESACTIVADO);
+    if (disco->Inicializar() != Status::OK) {
+        std::cerr << "Error: No se pudo inicializar el disco de pruebas en " << ruta << std::endl;
+        return nullptr;
+    }
+    return disco;
+}
+
+std::unique_ptr<IPoliticaReemplazo> CrearPolitica(const std::string& nombre, uint32_t tamano_pool) {
+    if (nombre == "CLOCK") {
+        return std::make_unique<PoliticaClock>(tamano_pool);
+    } else if (nombre == "2Q") {
+        return std::make_unique<PoliticaDosColas>(tamano_pool);
+    } else if (nombre == "CLOCK_ATOMICO") {
+        return std::make_unique<PoliticaClockAtomico>(tamano_pool);
+    }
+    return std::make_unique<PoliticaLRU>();
+}
+
+std::string NombreModo(ModoAlmacenamiento modo) {
+    return (modo == ModoAlmacenamiento::IMAGEN_UNICA) ? "imagen_unica" : "archivo_por_bloque";
+}
+
+/**
+ * @brief Asigna y escribe paginas bloques de datos (en extensiones) y devuelve sus ids.
+ */
+std::vector<BlockId> PrepararBloques(GestorDisco& disco, uint32_t paginas) {
+    std::vector<BlockId> bloques;
+    std::vector<Byte> datos(BLOCK_SIZE, 0);
+    while (bloques.size() < paginas) {
+        uint32_t asignados = 0;
+        BlockId primero = disco.AsignarExtension(PageType::DATA_PAGE, paginas - static_cast<uint32_t>(bloques.size()), asignados);
+        if (primero == 0) {
+            break;
+        }
+        for (uint32_t i = 0; i < asignados; ++i) {
+            bloques.push_back(primero + i);
+        }
+    }
+    for (BlockId bloque : bloques) {
+        std::memcpy(datos.data(), &bloque, sizeof(bloque));
+        disco.EscribirBloque(bloque, datos.data(), BLOCK_SIZE);
+    }
+    return bloques;
+}
+
+// ===== SUITE: DISCO =====
+
+void MedirDisco(const ConfiguracionBenchmark& configuracion, SalidaResultados& salida) {
+    const uint32_t paginas = 4096;
+    for (ModoAlmacenamiento modo : {ModoAlmacenamiento::ARCHIVO_POR_BLOQUE, ModoAlmacenamiento::IMAGEN_UNICA}) {
+        auto disco = CrearDisco(configuracion, "disco_" + NombreModo(modo), modo);
+        if (!disco) {
+            continue;
+        }
+        GeneradorAleatorio generador(configuracion.semilla);
+        std::vector<Byte> buffer(BLOCK_SIZE, 0x5A);
+        const double megabytes = paginas * static_cast<double>(BLOCK_SIZE) / (1024.0 * 1024.0);
+
+        auto inicio = std::chrono::steady_clock::now();
+        std::vector<BlockId> bloques = PrepararBloques(*disco, paginas);
+        double segundos = Segundos(inicio);
+        salida.Escribir(Medicion{"disco", "asignar_y_escribir", {}, {}}
+                            .Parametro("modo", NombreModo(modo)).Parametro("paginas", bloques.size())
+                            .Rendimiento(bloques.size(), segundos).Metrica("mb_por_segundo", megabytes / segundos));
+
+        inicio = std::chrono::steady_clock::now();
+        for (BlockId bloque : bloques) {
+            disco->EscribirBloque(bloque, buffer.data(), BLOCK_SIZE);
+        }
+        segundos = Segundos(inicio);
+        salida.Escribir(Medicion{"disco", "escritura_secuencial", {}, {}}
+                            .Parametro("modo", NombreModo(modo)).Parametro("paginas", bloques.size())
+                            .Rendimiento(bloques.size(), segundos).Metrica("mb_por_segundo", megabytes / segundos));
+
+        inicio = std::chrono::steady_clock::now();
+        for (BlockId bloque : bloques) {
+            disco->LeerBloque(bloque, buffer.data(), BLOCK_SIZE);
+        }
+        segundos = Segundos(inicio);
+        salida.Escribir(Medicion{"disco", "lectura_secuencial", {}, {}}
+                            .Parametro("modo", NombreModo(modo)).Parametro("paginas", bloques.size())
+                            .Rendimiento(bloques.size(), segundos).Metrica("mb_por_segundo", megabytes / segundos));
+
+        std::vector<double> latencias;
+        latencias.reserve(bloques.size());
+        inicio = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < bloques.size(); ++i) {
+            auto inicio_lectura = std::chrono::steady_clock::now();
+            disco->LeerBloque(bloques[generador.Menor(bloques.size())], buffer.data(), BLOCK_SIZE);
+            latencias.push_back(Segundos(inicio_lectura) * 1e6);
+        }
+        segundos = Segundos(inicio);
+        salida.Escribir(Medicion{"disco", "lectura_aleatoria", {}, {}}
+                            .Parametro("modo", NombreModo(modo)).Parametro("paginas", bloques.size())
+                            .Rendimiento(bloques.size(), segundos).Latencias(std::move(latencias)));
+
+        // Lecturas por lotes: el planificador agrupa los bloques contiguos de cada lote
+        const size_t tamano_lote = 64;
+        std::vector<Byte> destino(tamano_lote * BLOCK_SIZE);
+        inicio = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < bloques.size(); i += tamano_lote) {
+            std::vector<SolicitudES> solicitudes;
+            for (size_t j = i; j < std::min(bloques.size(), i + tamano_lote); ++j) {
+                solicitudes.emplace_back(bloques[j], destino.data() + (j - i) * BLOCK_SIZE, BLOCK_SIZE);
+            }
+            disco->LeerBloques(solicitudes);
+        }
+        segundos = Segundos(inicio);
+        salida.Escribir(Medicion{"disco", "lectura_por_lotes", {}, {}}
+                            .Parametro("modo", NombreModo(modo)).Parametro("paginas", bloques.size())
+                            .Parametro("lote", tamano_lote)
+                            .Rendimiento(bloques.size(), segundos).Metrica("mb_por_segundo", megabytes / segundos));
+    }
+}
+
+// ===== SUITE: BUFFER =====
+
+enum class PatronAcceso { UNIFORME, ZIPF, ESCANEO_Y_CALIENTE };
+
+std::string NombrePatron(PatronAcceso patron) {
+    switch (patron) {
+        case PatronAcceso::UNIFORME: return "uniforme";
+        case PatronAcceso::ZIPF: return "zipf";
+        case PatronAcceso::ESCANEO_Y_CALIENTE: return "escaneo_y_caliente";
+    }
+    return "desconocido";
+}
+
+/**
+ * @brief Secuencia de páginas a anclar. ESCANEO_Y_CALIENTE alterna un recorrido
+ *        secuencial de toda la tabla con accesos a un 5 % de páginas calientes,
+ *        el caso en el que LRU expulsa el conjunto caliente.
+ */
+std::vector<uint32_t> GenerarAccesos(PatronAcceso patron, uint32_t paginas, uint32_t operaciones, uint64_t semilla) {
+    GeneradorAleatorio generador(semilla);
+    std::vector<uint32_t> accesos;
+    accesos.reserve(operaciones);
+    if (patron == PatronAcceso::UNIFORME) {
+        for (uint32_t i = 0; i < operaciones; ++i) {
+            accesos.push_back(static_cast<uint32_t>(generador.Menor(paginas)));
+        }
+    } else if (patron == PatronAcceso::ZIPF) {
+        DistribucionZipf zipf(paginas, 0.99, generador);
+        for (uint32_t i = 0; i < operaciones; ++i) {
+            accesos.push_back(zipf.Muestra(generador));
+        }
+    } else {
+        uint32_t calientes = std::max<uint32_t>(1, paginas / 20);
+        uint32_t posicion_escaneo = 0;
+        for (uint32_t i = 0; i < operaciones; ++i) {
+            if (generador.Menor(2) == 0) {
+                accesos.push_back(posicion_escaneo);
+                posicion_escaneo = (posicion_escaneo + 1) % paginas;
+            } else {
+                accesos.push_back(static_cast<uint32_t>(generador.Menor(calientes)));
+            }
+        }
+    }
+    return accesos;
+}
+
+void MedirBuffer(const ConfiguracionBenchmark& configuracion, SalidaResultados& salida) {
+    const uint32_t paginas = 2048;
+    auto disco = CrearDisco(configuracion, "buffer", ModoAlmacenamiento::IMAGEN_UNICA);
+    if (!disco) {
+        return;
+    }
+    std::vector<BlockId> bloques = PrepararBloques(*disco, paginas);
+    if (bloques.empty()) {
+        return;
+    }
+
+    for (PatronAcceso patron : {PatronAcceso::UNIFORME, PatronAcceso::ZIPF, PatronAcceso::ESCANEO_Y_CALIENTE}) {
+        std::vector<uint32_t> accesos = GenerarAccesos(patron, static_cast<uint32_t>(bloques.size()),
+                                                       configuracion.operaciones, configuracion.semilla);
+        for (double proporcion_pool : {0.05, 0.20, 0.50}) {
+            uint32_t tamano_pool = std::max<uint32_t>(8, static_cast<uint32_t>(bloques.size() * proporcion_pool));
+            for (const char* nombre_politica : {"LRU", "CLOCK", "2Q", "CLOCK_ATOMICO"}) {
+                GestorBuffer buffer(disco, tamano_pool, BLOCK_SIZE, CrearPolitica(nombre_politica, tamano_pool));
+                buffer.ResetStats();
+
+                auto inicio = std::chrono::steady_clock::now();
+                uint64_t fallos_anclaje = 0;
+                for (uint32_t acceso : accesos) {
+                    Byte* datos = nullptr;
+                    if (buffer.PinPage(bloques[acceso], datos) != Status::OK) {
+                        fallos_anclaje++;
+                        continue;
+                    }
+                    buffer.UnpinPage(bloques[acceso], false);
+                }
+                double segundos = Segundos(inicio);
+
+                GestorBuffer::BufferStats estadisticas = buffer.GetStats();
+                uint64_t accesos_totales = estadisticas.hits_cache + estadisticas.misses_cache;
+                salida.Escribir(Medicion{"buffer", "anclar_desanclar", {}, {}}
+                                    .Parametro("politica", nombre_politica).Parametro("patron", NombrePatron(patron))
+                                    .Parametro("pool", tamano_pool).Parametro("paginas", bloques.size())
+                                    .Rendimiento(accesos.size(), segundos)
+                                    .Metrica("tasa_aciertos", accesos_totales ? static_cast<double>(estadisticas.hits_cache) / accesos_totales : 0.0)
+                                    .Metrica("lecturas_disco", static_cast<double>(estadisticas.lecturas_disco))
+                                    .Metrica("desalojos", static_cast<double>(estadisticas.desalojos))
+                                    .Metrica("fallos_anclaje", static_cast<double>(fallos_anclaje)));
+            }
+        }
+    }
+}
+
+// ===== SUITE: REGISTROS =====
+
+/**
+ * @brief Disco, buffer, catálogo y gestor de registros con la tabla clientes cargada.
+ */
+struct EntornoRegistros {
+    std::shared_ptr<GestorDisco> disco;
+    std::unique_ptr<GestorBuffer> buffer;
+    std::unique_ptr<GestorCatalogo> catalogo;
+    std::unique_ptr<GestorRegistros> registros;
+    std::vector<RecordId> ids;
+
+    bool Preparar(const ConfiguracionBenchmark& configuracion, const std::string& nombre, uint32_t tamano_pool) {
+        disco = CrearDisco(configuracion, nombre, ModoAlmacenamiento::IMAGEN_UNICA);
+        if (!disco) {
+            return false;
+        }
+        buffer = std::make_unique<GestorBuffer>(disco, tamano_pool, BLOCK_SIZE, std::make_unique<PoliticaDosColas>(tamano_pool));
+        catalogo = std::make_unique<GestorCatalogo>(disco);
+        registros = std::make_unique<GestorRegistros>(*buffer);
+        registros->SetGestorCatalogo(catalogo.get());
+        return catalogo->CrearTablaLongitudFija("clientes", EsquemaClientes()) != 0;
+    }
+};
+
+void MedirRegistros(const ConfiguracionBenchmark& configuracion, SalidaResultados& salida,
+                    const std::vector<DatosRegistro>& clientes) {
+    EntornoRegistros entorno;
+    if (!entorno.Preparar(configuracion, "registros", 512)) {
+        std::cerr << "Error: No se pudo preparar la tabla de pruebas." << std::endl;
+        return;
+    }
+
+    // Inserción fila a fila sobre el primer 10 %; el resto por lotes
+    size_t individuales = std::max<size_t>(1, clientes.size() / 10);
+    std::vector<double> latencias;
+    auto inicio = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < individuales; ++i) {
+        RecordId id = INVALID_RECORD_ID;
+        auto inicio_insercion = std::chrono::steady_clock::now();
+        if (entorno.registros->InsertarRegistro("clientes", clientes[i], id) == Status::OK) {
+            entorno.ids.push_back(id);
+        }
+        latencias.push_back(Segundos(inicio_insercion) * 1e6);
+    }
+    double segundos = Segundos(inicio);
+    salida.Escribir(Medicion{"registros", "insercion_individual", {}, {}}
+                        .Parametro("filas", individuales).Rendimiento(individuales, segundos)
+                        .Latencias(std::move(latencias)));
+
+    const size_t tamano_lote = 1000;
+    size_t insertadas_lote = 0;
+    inicio = std::chrono::steady_clock::now();
+    for (size_t i = individuales; i < clientes.size(); i += tamano_lote) {
+        std::vector<DatosRegistro> lote(clientes.begin() + i, clientes.begin() + std::min(clientes.size(), i + tamano_lote));
+        std::vector<RecordId> ids_lote;
+        uint32_t insertados = 0;
+        entorno.registros->InsertarRegistrosLote("clientes", lote, insertados, &ids_lote);
+        insertadas_lote += insertados;
+        entorno.ids.insert(entorno.ids.end(), ids_lote.begin(), ids_lote.end());
+    }
+    segundos = Segundos(inicio);
+    salida.Escribir(Medicion{"registros", "insercion_por_lotes", {}, {}}
+                        .Parametro("filas", insertadas_lote).Parametro("lote", tamano_lote)
+                        .Rendimiento(insertadas_lote, segundos));
+
+    inicio = std::chrono::steady_clock::now();
+    CursorRegistros cursor;
+    uint64_t leidos = 0;
+    if (entorno.registros->AbrirCursor("clientes", cursor) == Status::OK) {
+        RecordId id;
+        VistaRegistro vista;
+        while (cursor.Siguiente(id, vista)) {
+            leidos++;
+        }
+    }
+    segundos = Segundos(inicio);
+    salida.Escribir(Medicion{"registros", "recorrido_completo", {}, {}}
+                        .Parametro("filas", leidos).Rendimiento(leidos, segundos));
+
+    GeneradorAleatorio generador(configuracion.semilla + 1);
+    const size_t consultas = std::min<size_t>(entorno.ids.size(), 10000);
+    latencias.clear();
+    inicio = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < consultas; ++i) {
+        DatosRegistro resultado;
+        auto inicio_consulta = std::chrono::steady_clock::now();
+        entorno.registros->ConsultarRegistroPorID("clientes", entorno.ids[generador.Menor(entorno.ids.size())], resultado);
+        latencias.push_back(Segundos(inicio_consulta) * 1e6);
+    }
+    segundos = Segundos(inicio);
+    salida.Escribir(Medicion{"registros", "consulta_por_id", {}, {}}
+                        .Parametro("filas", entorno.ids.size()).Rendimiento(consultas, segundos)
+                        .Latencias(std::move(latencias)));
+}
+
+// ===== SUITE: ÍNDICES =====
+
+/**
+ * @brief Construye un índice insertando clave a clave y mide búsquedas puntuales.
+ * @param clave_de Clave (texto, entero) de la fila i
+ */
+void MedirIndice(const std::string& nombre_indice, IndiceBase& indice, size_t filas,
+                 const std::function<std::pair<std::string, int64_t>(size_t)>& clave_de,
+                 uint64_t semilla, SalidaResultados& salida) {
+    GeneradorAleatorio generador(semilla);
+    std::vector<size_t> orden(filas);
+    for (size_t i = 0; i < filas; ++i) {
+        orden[i] = i;
+    }
+    for (size_t i = filas; i > 1; --i) {
+        std::swap(orden[i - 1], orden[generador.Menor(i)]);
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    for (size_t fila : orden) {
+        auto clave = clave_de(fila);
+        indice.Insertar(clave.first, clave.second, ConstruirRecordId(static_cast<PageId>(fila / 64 + 1), fila % 64));
+    }
+    double segundos = Segundos(inicio);
+    salida.Escribir(Medicion{"indices", "construccion_incremental", {}, {}}
+                        .Parametro("indice", nombre_indice).Parametro("entradas", filas)
+                        .Rendimiento(filas, segundos).Metrica("altura", indice.ObtenerAltura()));
+
+    const size_t busquedas = std::min<size_t>(filas, 20000);
+    std::vector<double> latencias;
+    latencias.reserve(busquedas);
+    uint64_t encontrados = 0;
+    inicio = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < busquedas; ++i) {
+        auto clave = clave_de(generador.Menor(filas));
+        auto inicio_busqueda = std::chrono::steady_clock::now();
+        auto resultado = indice.Buscar(clave.first, clave.second);
+        latencias.push_back(Segundos(inicio_busqueda) * 1e6);
+        encontrados += (resultado && !resultado->empty()) ? 1 : 0;
+    }
+    segundos = Segundos(inicio);
+    salida.Escribir(Medicion{"indices", "busqueda_puntual", {}, {}}
+                        .Parametro("indice", nombre_indice).Parametro("entradas", filas)
+                        .Rendimiento(busquedas, segundos).Metrica("encontrados", static_cast<double>(encontrados))
+                        .Latencias(std::move(latencias)));
+}
+
+/**
+ * @brief Construcción masiva de un B+ Tree: ordenación externa y carga de hojas.
+ */
+void MedirConstruccionMasiva(const std::string& nombre_indice, IndiceBTreePaginado& indice, size_t filas,
+                             const std::function<std::pair<std::string, int64_t>(size_t)>& clave_de,
+                             const ConfiguracionBenchmark& configuracion, SalidaResultados& salida) {
+    auto inicio = std::chrono::steady_clock::now();
+    OrdenadorEntradasIndice ordenador(indice.ObtenerLongitudClave(), 4 * 1024 * 1024,
+                                      (fs::path(configuracion.directorio) / "runs").string(), 4);
+    std::vector<Byte> clave_codificada(indice.ObtenerLongitudClave());
+    for (size_t fila = 0; fila < filas; ++fila) {
+        auto clave = clave_de(fila);
+        indice.CodificarClave(clave.first, clave.second, clave_codificada.data());
+        ordenador.Añadir(clave_codificada.data(), ConstruirRecordId(static_cast<PageId>(fila / 64 + 1), fila % 64));
+    }
+    Status estado = ordenador.Finalizar();
+    if (estado == Status::OK) {
+        estado = indice.ConstruirMasivo(ordenador, 0.9);
+    }
+    double segundos = Segundos(inicio);
+    if (estado != Status::OK) {
+        std::cerr << "Error: Falló la construcción masiva de " << nombre_indice << ": " << StatusToString(estado) << std::endl;
+        return;
+    }
+    salida.Escribir(Medicion{"indices", "construccion_masiva", {}, {}}
+                        .Parametro("indice", nombre_indice).Parametro("entradas", filas)
+                        .Rendimiento(filas, segundos).Metrica("altura", indice.ObtenerAltura()));
+}
+
+void MedirIndices(const ConfiguracionBenchmark& configuracion, SalidaResultados& salida,
+                  const std::vector<DatosRegistro>& clientes) {
+    auto disco = CrearDisco(configuracion, "indices", ModoAlmacenamiento::IMAGEN_UNICA);
+    if (!disco) {
+        return;
+    }
+    std::error_code error;
+    fs::create_directories(fs::path(configuracion.directorio) / "runs", error);
+    GestorBuffer buffer(disco, 1024, BLOCK_SIZE, std::make_unique<PoliticaDosColas>(1024));
+
+    auto clave_entera = [&](size_t fila) { return std::make_pair(clientes[fila].campos[0], static_cast<int64_t>(std::stoll(clientes[fila].campos[0]))); };
+    auto clave_email = [&](size_t fila) { return std::make_pair(clientes[fila].campos[4], int64_t{0}); };
+
+    {
+        IndiceBTreeEntero indice(buffer);
+        MedirIndice("btree_entero", indice, clientes.size(), clave_entera, configuracion.semilla, salida);
+    }
+    {
+        IndiceBTreeEntero indice(buffer);
+        MedirConstruccionMasiva("btree_entero", indice, clientes.size(), clave_entera, configuracion, salida);
+    }
+    {
+        IndiceBTreeCadena indice(buffer);
+        MedirIndice("btree_cadena", indice, clientes.size(), clave_email, configuracion.semilla, salida);
+    }
+    {
+        IndiceBTreeCadena indice(buffer);
+        MedirConstruccionMasiva("btree_cadena", indice, clientes.size(), clave_email, configuracion, salida);
+    }
+    {
+        IndiceHashCadena indice;
+        MedirIndice("hash_cadena", indice, clientes.size(), clave_email, configuracion.semilla, salida);
+    }
+}
+
+// ===== SUITE: CONSULTAS =====
+
+/**
+ * @brief Ejecuta un SELECT de principio a fin: análisis, compilación del WHERE y
+ *        recorrido (o agregación en paralelo si la sentencia tiene agregados).
+ * @return Filas del resultado
+ */
+uint64_t EjecutarConsulta(GestorRegistros& registros, const std::string& texto) {
+    SentenciaSQL sentencia;
+    std::string error;
+    if (AnalizarSQL(texto, sentencia, error) != Status::OK || sentencia.tipo != TipoSentencia::SELECT) {
+        std::cerr << "Error: Consulta de prueba no válida: " << error << std::endl;
+        return 0;
+    }
+    std::shared_ptr<const FiltroCompilado> filtro;
+    if (!sentencia.condiciones.empty() &&
+        registros.CompilarFiltro(sentencia.tabla, sentencia.condiciones, filtro) != Status::OK) {
+        return 0;
+    }
+    if (!sentencia.agregados.empty()) {
+        std::vector<AgregadoParcial> agregados;
+        return registros.AgregarEnParalelo(sentencia.tabla, filtro, sentencia.agregados, agregados) == Status::OK ? 1 : 0;
+    }
+
+    CursorRegistros cursor;
+    Status estado = filtro ? registros.AbrirCursorFiltrado(sentencia.tabla, cursor, filtro)
+                           : registros.AbrirCursor(sentencia.tabla, cursor);
+    if (estado != Status::OK) {
+        return 0;
+    }
+    uint64_t filas = 0;
+    RecordId id;
+    VistaRegistro vista;
+    while (cursor.Siguiente(id, vista)) {
+        filas++;
+    }
+    return filas;
+}
+
+void MedirConsultas(const ConfiguracionBenchmark& configuracion, SalidaResultados& salida,
+                    const std::vector<DatosRegistro>& clientes) {
+    EntornoRegistros entorno;
+    if (!entorno.Preparar(configuracion, "consultas", 1024)) {
+        return;
+    }
+    for (size_t i = 0; i < clientes.size(); i += 1000) {
+        std::vector<DatosRegistro> lote(clientes.begin() + i, clientes.begin() + std::min(clientes.size(), i + 1000));
+        uint32_t insertados = 0;
+        entorno.registros->InsertarRegistrosLote("clientes", lote, insertados);
+    }
+
+    const std::string id_medio = std::to_string(clientes.size() / 2);
+    const std::vector<std::pair<std::string, std::string>> consultas = {
+        {"seleccion_puntual", "SELECT * FROM clientes WHERE id = " + id_medio},
+        {"seleccion_rango", "SELECT * FROM clientes WHERE id >= " + id_medio + " AND id < " + std::to_string(clientes.size() / 2 + 100)},
+        {"seleccion_texto", "SELECT * FROM clientes WHERE nombre = 'Ana'"},
+        {"recorrido_completo", "SELECT * FROM clientes"},
+        {"agregado_count", "SELECT COUNT(*) FROM clientes"},
+        {"agregado_filtrado", "SELECT COUNT(*), MIN(telefono), MAX(telefono) FROM clientes WHERE apellido = 'Gómez'"},
+    };
+
+    const uint32_t repeticiones = 20;
+    for (const auto& consulta : consultas) {
+        EjecutarConsulta(*entorno.registros, consulta.second); // Calentar el buffer
+        std::vector<double> latencias;
+        uint64_t filas = 0;
+        auto inicio = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < repeticiones; ++i) {
+            auto inicio_consulta = std::chrono::steady_clock::now();
+            filas = EjecutarConsulta(*entorno.registros, consulta.second);
+            latencias.push_back(Segundos(inicio_consulta) * 1e6);
+        }
+        double segundos = Segundos(inicio);
+        salida.Escribir(Medicion{"consultas", consulta.first, {}, {}}
+                            .Parametro("sql", consulta.second).Parametro("filas_tabla", clientes.size())
+                            .Rendimiento(repeticiones, segundos).Metrica("filas_resultado", static_cast<double>(filas))
+                            .Latencias(std::move(latencias)));
+    }
+}
+
+// ===== LÍNEA DE ÓRDENES =====
+
+bool LeerArgumentos(int argc, char* argv[], ConfiguracionBenchmark& configuracion) {
+    for (int i = 1; i < argc; ++i) {
+        std::string opcion = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Error: Falta el valor de " << opcion << std::endl;
+            return false;
+        }
+        std::string valor = argv[++i];
+        try {
+            if (opcion == "--filas") {
+                configuracion.filas = static_cast<uint32_t>(std::stoul(valor));
+            } else if (opcion == "--semilla") {
+                configuracion.semilla = std::stoull(valor);
+            } else if (opcion == "--operaciones") {
+                configuracion.operaciones = static_cast<uint32_t>(std::stoul(valor));
+            } else if (opcion == "--directorio") {
+                configuracion.directorio = valor;
+            } else if (opcion == "--salida") {
+                configuracion.salida = valor;
+            } else if (opcion == "--suites") {
+                configuracion.suites.clear();
+                std::stringstream lista(valor);
+                std::string suite;
+                while (std::getline(lista, suite, ',')) {
+                    configuracion.suites.push_back(suite);
+                }
+            } else {
+                std::cerr << "Error: Opción desconocida " << opcion << std::endl;
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: Valor no válido para " << opcion << ": " << valor << std::endl;
+            return false;
+        }
+    }
+    if (configuracion.filas == 0) {
+        std::cerr << "Error: --filas debe ser mayor que 0" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ConfiguracionBenchmark configuracion;
+    if (!LeerArgumentos(argc, argv, configuracion)) {
+        return 2;
+    }
+
+    std::ofstream archivo_salida;
+    if (!configuracion.salida.empty()) {
+        archivo_salida.open(configuracion.salida, std::ios::out | std::ios::trunc);
+        if (!archivo_salida.is_open()) {
+            std::cerr << "Error: No se pudo abrir " << configuracion.salida << std::endl;
+            return 1;
+        }
+    }
+    SalidaResultados salida(archivo_salida.is_open() ? static_cast<std::ostream&>(archivo_salida) : std::cout);
+
+    // Primera línea: lo necesario para saber si dos ejecuciones son comparables
+    salida.Escribir(Medicion{"meta", "configuracion", {}, {}}
+                        .Parametro("filas", configuracion.filas).Parametro("semilla", configuracion.semilla)
+                        .Parametro("operaciones", configuracion.operaciones)
+                        .Metrica("version_formato", VERSION_FORMATO_RESULTADOS)
+                        .Metrica("tamano_bloque", BLOCK_SIZE));
+
+    GeneradorAleatorio generador(configuracion.semilla);
+    std::vector<DatosRegistro> clientes = GenerarClientes(configuracion.filas, generador);
+
+    if (configuracion.SuiteActiva("disco")) MedirDisco(configuracion, salida);
+    if (configuracion.SuiteActiva("buffer")) MedirBuffer(configuracion, salida);
+    if (configuracion.SuiteActiva("registros")) MedirRegistros(configuracion, salida, clientes);
+    if (configuracion.SuiteActiva("indices")) MedirIndices(configuracion, salida, clientes);
+    if (configuracion.SuiteActiva("consultas")) MedirConsultas(configuracion, salida, clientes);
+
+    std::error_code error;
+    fs::remove_all(configuracion.directorio, error);
+    return 0;
+}
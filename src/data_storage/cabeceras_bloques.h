@@ -6,7 +6,7 @@
 
 // ===== CONSTANTES GLOBALES DE CABECERAS =====
 constexpr uint32_t MAGIC_NUMBER_SGBD = 0x42534442; // "BSDB" en ASCII (Base de Datos Simple)
-constexpr uint32_t VERSION_CABECERAS = 1;          // Versión del formato de cabeceras
+constexpr uint32_t VERSION_CABECERAS = 2;          // Versión del formato de cabeceras (2: lsn_pagina)
 
 // ===== ENUMERACIONES ESPECÍFICAS DE ALMACENAMIENTO =====
 
@@ -41,6 +41,44 @@ inline std::string BlockStatusToString(BlockStatus status) {
     }
 }
 
+/**
+ * @enum TipoIndice
+ * @brief Estructura usada por un índice secundario.
+ */
+enum class TipoIndice : uint8_t {
+    BTREE_ENTERO = 0,  // Árbol B+ paginado sobre claves INT
+    BTREE_CADENA,      // Árbol B+ paginado sobre el prefijo de claves de texto
+    HASH_CADENA        // Tabla hash sobre claves de texto
+};
+
+// Función de utilidad para convertir TipoIndice a string
+inline std::string TipoIndiceToString(TipoIndice tipo) {
+    switch (tipo) {
+        case TipoIndice::BTREE_ENTERO: return "BTREE_ENTERO";
+        case TipoIndice::BTREE_CADENA: return "BTREE_CADENA";
+        case TipoIndice::HASH_CADENA: return "HASH_CADENA";
+        default: return "UNKNOWN_INDEX_TYPE";
+    }
+}
+
+/**
+ * @enum FormatoAlmacenamiento
+ * @brief Disposición de los registros dentro de las páginas de datos de una tabla.
+ */
+enum class FormatoAlmacenamiento : uint8_t {
+    FILAS = 0,      // Página ranurada: cada registro contiguo (CabeceraBloqueDatos + slots)
+    COLUMNAS_PAX    // Página PAX: los registros de la página agrupados columna a columna
+};
+
+// Función de utilidad para convertir FormatoAlmacenamiento a string
+inline std::string FormatoAlmacenamientoToString(FormatoAlmacenamiento formato) {
+    switch (formato) {
+        case FormatoAlmacenamiento::FILAS: return "FILAS";
+        case FormatoAlmacenamiento::COLUMNAS_PAX: return "COLUMNAS_PAX";
+        default: return "UNKNOWN_STORAGE_FORMAT";
+    }
+}
+
 // ==== ESTRUCTURAS DE CABECERAS DE BLOQUES ====
 
 /**
@@ -59,16 +97,117 @@ struct CabeceraComun {
     uint32_t bytes_disponibles;     // Cantidad de bytes disponibles dentro del bloque
     uint64_t timestamp_ultima_modificacion; // Timestamp de la última modificación (epoch ms)
     uint32_t checksum;              // Suma de verificación para integridad de datos
+    LSN lsn_pagina;                 // Fin del último registro del WAL aplicado a la página
 
     CabeceraComun()
         : magic_number(MAGIC_NUMBER_SGBD), version(VERSION_CABECERAS), id_bloque(INVALID_PAGE_ID),
           tamano_bloque_total(BLOCK_SIZE), tipo_pagina(PageType::DATA_PAGE), bytes_usados(0),
-          bytes_disponibles(BLOCK_SIZE - sizeof(CabeceraComun)), timestamp_ultima_modificacion(0), checksum(0) {}
+          bytes_disponibles(BLOCK_SIZE - sizeof(CabeceraComun)), timestamp_ultima_modificacion(0), checksum(0),
+          lsn_pagina(LSN_INVALIDO) {}
+};
+
+/**
+ * @struct CabeceraBloqueDatos
+ * @brief Cabecera de una página de datos con directorio de slots (va tras CabeceraComun).
+ *
+ * Los registros crecen desde offset_espacio_libre hacia el final del bloque y el
+ * directorio de slots crece desde el final del bloque hacia el principio, empezando
+ * en offset_directorio_slots. El espacio entre ambos es el hueco contiguo libre.
+ */
+struct CabeceraBloqueDatos {
+    uint32_t espacio_libre_total;       // Bytes disponibles para un registro nuevo (hueco + fragmentación)
+    uint32_t fragmentacion_interna;     // Bytes de registros borrados o encogidos, recuperables al compactar
+    uint32_t offset_espacio_libre;      // Primer byte libre tras el último registro
+    uint32_t numero_registros_activos;
+    uint32_t numero_registros_eliminados;
+    uint32_t offset_directorio_slots;   // Inicio del directorio (BLOCK_SIZE si está vacío)
+    uint32_t tamano_directorio_slots;   // Número de slots del directorio, libres incluidos
+    uint32_t factor_carga_porcentaje;
+    bool necesita_compactacion;
+    uint16_t pista_slot_libre;          // Ningún slot por debajo está libre (cabe en el relleno; 0 es siempre válido)
+};
+
+/**
+ * @struct EntradaSlot
+ * @brief Entrada del directorio de slots. El slot i ocupa los bytes
+ * [BLOCK_SIZE - (i + 1) * sizeof(EntradaSlot), BLOCK_SIZE - i * sizeof(EntradaSlot)).
+ */
+struct EntradaSlot {
+    uint16_t offset;    // 0 si el slot está libre
+    uint16_t longitud;
+};
+
+constexpr uint32_t MARCA_PAGINA_PAX = 0x58415050; // "PPAX"
+
+/**
+ * @struct CabeceraPaginaPAX
+ * @brief Cabecera de una página de datos PAX (va tras CabeceraComun y CabeceraBloqueDatos).
+ *
+ * Le siguen un DescriptorMinipagina por columna, el mapa de slots eliminados
+ * (un bit por slot) y las minipáginas. CabeceraBloqueDatos se mantiene con los
+ * contadores y el espacio libre, así que las estadísticas y el mapa de espacio
+ * libre no distinguen entre formatos.
+ */
+struct CabeceraPaginaPAX {
+    uint32_t marca;                 // MARCA_PAGINA_PAX
+    uint16_t numero_columnas;
+    uint16_t numero_slots;          // Slots de la página, eliminados incluidos
+    uint32_t version_contenido;     // Aumenta con cada escritura de la página
+    uint8_t codificacion_ligera;    // 0: todas las minipáginas en codificación PLANA
+    uint8_t reservado[3];
+};
+
+/**
+ * @enum CodificacionMinipagina
+ * @brief Codificación de los valores de una minipágina.
+ */
+enum class CodificacionMinipagina : uint8_t {
+    PLANA = 0,          // INT/REAL: 8 bytes por valor; BOOL: 1 bit; texto: fines uint16 + bytes
+    REFERENCIA_BITS,    // INT: (valor - mínimo) en ancho_bits bits por valor
+    DICCIONARIO         // CHAR/VARCHAR: valores distintos ordenados + códigos de ancho_bits bits
+};
+
+/**
+ * @struct DescriptorMinipagina
+ * @brief Posición, codificación y rango de valores de la minipágina de una columna.
+ *
+ * minimo/maximo se calculan sobre los valores no nulos de los registros vivos:
+ * int64 (INT y BOOL), double (REAL) o los primeros bytes del texto (CHAR sin el
+ * relleno de espacios, VARCHAR). Permiten descartar la página sin decodificarla.
+ */
+struct DescriptorMinipagina {
+    uint16_t offset;                // Desde el inicio de la página
+    uint16_t longitud;
+    uint8_t codificacion;           // CodificacionMinipagina
+    uint8_t ancho_bits;             // REFERENCIA_BITS y DICCIONARIO
+    uint8_t banderas;               // MINIPAGINA_CON_VALORES | MINIPAGINA_CON_NULOS | MINIPAGINA_CON_RANGO
+    uint8_t longitudes_prefijo;     // Texto: bytes de minimo (4 bits bajos) y de maximo (4 altos)
+    Byte minimo[8];
+    Byte maximo[8];
+};
+
+constexpr uint8_t MINIPAGINA_CON_VALORES = 1;  // Algún valor no nulo
+constexpr uint8_t MINIPAGINA_CON_NULOS = 2;    // Lleva mapa de nulos (uno por slot) antes de los valores
+constexpr uint8_t MINIPAGINA_CON_RANGO = 4;    // minimo/maximo utilizables (no lo está un REAL con NaN)
+
+/**
+ * @struct CabeceraBloqueCatalogo
+ * @brief Cabecera de un bloque del catálogo binario (va tras CabeceraComun).
+ *
+ * Cada entrada del catálogo (el directorio o una tabla) ocupa una cadena de
+ * bloques CATALOG y su contenido se reparte entre ellos en orden. El checksum de
+ * la CabeceraComun del primer bloque cubre la entrada completa.
+ */
+struct CabeceraBloqueCatalogo {
+    uint32_t id_tabla;          // 0 para el directorio del catálogo
+    uint32_t numero_bloque;     // Posición del bloque en su cadena
+    BlockId siguiente_bloque;   // INVALID_PAGE_ID en el último bloque
+    uint32_t bytes_carga;       // Bytes de la entrada guardados en este bloque
+    uint32_t longitud_entrada;  // Bytes de la entrada completa
 };
 
-// Nota: Las cabeceras específicas para datos, catálogo, índices, etc., se definirán
+// Nota: Las cabeceras específicas para catálogo, índices, etc., se definirán
 // en 'cabeceras_especificas.h' si son muy grandes o complejas, o se manejarán
 // directamente como parte del contenido del bloque si son simples.
-// Para este enfoque de texto plano, la CabeceraComun es lo más relevante a nivel de bloque físico.
 
 #endif // CABECERAS_BLOQUES_H
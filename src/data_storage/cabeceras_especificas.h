@@ -21,7 +21,7 @@
 // ===== CONSTANTES CRÍTICAS =====
 
 constexpr uint32_t MAGIC_NUMBER_SGBD = 0x42534442; // "BSDB" en ASCII
-constexpr uint32_t VERSION_CABECERAS = 1;
+constexpr uint32_t VERSION_CABECERAS = 2;
 constexpr uint32_t MAX_MAPAS_TABLA = 16;
 constexpr uint32_t MAX_ENTRADAS_INDICE = 256;
 
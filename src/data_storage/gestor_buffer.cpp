@@ -1,202 +1,285 @@
 // data_storage/gestor_buffer.cpp
 #include "gestor_buffer.h"
+#include "gestor_wal.h"
 #include <iostream>  // Para std::cout, std::cerr
 #include <iomanip>   // Para std::setw, std::setfill
 #include <algorithm> // Para std::find_if
 #include <cstring>   // Para std::memcpy
 #include <chrono>    // Para std::chrono::system_clock, etc.
+#include <sstream>   // Para std::stringstream
+#include <ctime>     // Para std::localtime
+#include <cstdlib>   // Para posix_memalign, std::free
+#include <new>       // Para std::bad_alloc
+#if defined(__linux__)
+#include <sys/mman.h> // Para mmap con MAP_HUGETLB
+#endif
 
 // ===== CONSTRUCTOR Y DESTRUCTOR =====
 
 GestorBuffer::GestorBuffer(std::shared_ptr<GestorDisco> gestor_disco,
                            uint32_t tamaño_pool,
                            BlockSizeType tamaño_bloque,
-                           std::unique_ptr<IReplacementPolicy> politica_reemplazo)
+                           std::unique_ptr<IReplacementPolicy> politica_reemplazo,
+                           const OpcionesPool& opciones)
     : gestor_disco_(gestor_disco)
     , tamaño_pool_(tamaño_pool)
     , tamaño_bloque_(tamaño_bloque)
+    , opciones_(opciones)
     , politica_reemplazo_(std::move(politica_reemplazo)) {
-    
+
     if (!gestor_disco_) {
         throw std::invalid_argument("GestorBuffer: El gestor de disco no puede ser nulo.");
     }
-    
+
     if (tamaño_pool_ == 0) {
         throw std::invalid_argument("GestorBuffer: El tamaño del pool debe ser mayor que 0.");
     }
-    
+
     if (!politica_reemplazo_) {
         throw std::invalid_argument("GestorBuffer: La política de reemplazo no puede ser nula.");
     }
-    
-    // Inicializar el pool de datos del buffer
-    pool_datos_buffer_.resize(tamaño_pool_);
-    for (auto& frame : pool_datos_buffer_) {
-        frame.resize(tamaño_bloque_); // Cada frame tiene el tamaño de un bloque
+
+    // Reservar la arena de datos: un único bloque contiguo alineado a página
+    paso_frame_ = (static_cast<size_t>(tamaño_bloque_) + TAMAÑO_LINEA_CACHE - 1) & ~(TAMAÑO_LINEA_CACHE - 1);
+    ReservarArena();
+
+    // Inicializar metadatos de control (todos los frames empiezan libres)
+    control_frames_ = std::make_unique<ControlFrame[]>(tamaño_pool_);
+    latches_ = std::make_unique<std::shared_mutex[]>(tamaño_pool_);
+    if (opciones_.estadisticas_por_frame) {
+        estadisticas_frames_ = std::make_unique<EstadisticasFrame[]>(tamaño_pool_);
     }
+    lsn_recuperacion_ = std::make_unique<std::atomic<LSN>[]>(tamaño_pool_);
 
-    // Inicializar metadatos de los frames
-    frames_.resize(tamaño_pool_);
-    for (FrameId i = 0; i < tamaño_pool_; ++i) {
-        frames_[i].id_frame = i;
-        frames_[i].es_valida = false; // Inicialmente no contienen datos válidos
-        frames_[i].esta_sucia = false;
-        frames_[i].contador_anclajes = 0;
-        frames_[i].id_bloque = INVALID_PAGE_ID; // No asociado a ningún bloque de disco inicialmente
-        frames_[i].tipo_pagina = PageType::INVALID_PAGE;
-        frames_[i].contador_accesos = 0;
-        frames_[i].contador_modificaciones = 0;
-        frames_[i].timestamp_ultimo_acceso = 0;
-        frames_[i].timestamp_ultima_modificacion = 0;
-        frames_[i].cambios_pendientes = false;
+    // Lista de frames libres; se apilan al revés para entregar primero el frame 0
+    frames_libres_.reserve(tamaño_pool_);
+    for (FrameId i = tamaño_pool_; i > 0; --i) {
+        frames_libres_.push_back(i - 1);
     }
 
     // Inicializar la política de reemplazo con el tamaño del pool
-    politica_reemplazo_->Inicializar(tamaño_pool_);
-
-    std::cout << "GestorBuffer inicializado con " << tamaño_pool_ << " frames de " 
-              << tamaño_bloque_ << " bytes cada uno." << std::endl;
+    politica_reemplazo_->Initialize(tamaño_pool_);
+    politica_segura_entre_hilos_ = politica_reemplazo_->EsSeguraEntreHilos();
+    ult_timestamp_reset_ = ObtenerTimestampActualMs();
+    umbral_paginas_sucias_alto_ = static_cast<uint32_t>(config_escritor_.umbral_sucias_alto * tamaño_pool_);
+
+    std::cout << "GestorBuffer inicializado con " << tamaño_pool_ << " frames de "
+              << tamaño_bloque_ << " bytes cada uno (" << NUM_PARTICIONES_TABLA
+              << " particiones de tabla de páginas, arena de " << (paso_frame_ * tamaño_pool_)
+              << " bytes" << (arena_paginas_enormes_ ? " en páginas enormes" : "") << ", política "
+              << politica_reemplazo_->ObtenerNombre() << ")." << std::endl;
+
+    if (config_escritor_.activo) {
+        IniciarEscritor();
+    }
 }
 
 GestorBuffer::~GestorBuffer() {
     std::cout << "Destructor de GestorBuffer: Forzando la escritura de todas las páginas sucias a disco..." << std::endl;
+    cerrando_ = true;
+    pool_lectura_anticipada_.reset(); // Espera a las precargas en curso
+    DetenerEscritor();
     FlushAllPages();
+    LiberarArena();
     std::cout << "GestorBuffer destruido." << std::endl;
 }
 
 // === MÉTODOS PÚBLICOS DE GESTIÓN DE PÁGINAS ===
 
 Status GestorBuffer::PinPage(BlockId id_bloque, Pagina& pagina_info) {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
-    ActualizarEstadisticas("tiempo_total_espera_pin"); // Simula el tiempo de espera para el lock
-
-    // 1. Buscar la página en el buffer pool
-    auto it = tabla_paginas_.find(id_bloque);
-    if (it != tabla_paginas_.end()) {
-        // Cache Hit: La página ya está en el buffer
-        FrameId id_frame = it->second;
-        frames_[id_frame].contador_anclajes++;
-        frames_[id_frame].contador_accesos++;
-        frames_[id_frame].timestamp_ultimo_acceso = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count();
-        politica_reemplazo_->Acceder(id_frame); // Notificar a la política de reemplazo
-        pagina_info = frames_[id_frame]; // Copiar información del frame
-        ActualizarEstadisticas("cache_hit");
-        return Status::OK;
-    }
-
-    // Cache Miss: La página no está en el buffer
-    ActualizarEstadisticas("cache_miss");
-
-    // 2. Encontrar un frame libre o desalojar una página
-    FrameId id_frame_disponible = EncontrarFrameLibre();
-    if (id_frame_disponible == INVALID_FRAME_ID) {
-        // No hay frames libres, intentar desalojar una página
-        Status desalojo_status = DesalojarPagina();
-        if (desalojo_status != Status::OK) {
-            std::cerr << "Error: No se pudo desalojar una página para anclar el bloque " << id_bloque << "." << std::endl;
-            return desalojo_status;
-        }
-        // Después del desalojo, debería haber un frame libre (el que fue desalojado)
-        id_frame_disponible = politica_reemplazo_->ObtenerVictima(); // La política debe devolver el frame desalojado
-        if (id_frame_disponible == INVALID_FRAME_ID) {
-            std::cerr << "Error crítico: La política de reemplazo no devolvió un frame válido después del desalojo." << std::endl;
-            return Status::ERROR;
+    Byte* datos_pagina = nullptr;
+    Status estado = PinPage(id_bloque, datos_pagina);
+    if (estado == Status::OK) {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        auto it = particion.mapa.find(id_bloque);
+        if (it != particion.mapa.end()) {
+            CopiarInfoPagina(it->second, pagina_info);
         }
     }
+    return estado;
+}
 
-    // 3. Cargar la página desde disco al frame disponible
-    Status read_status = LeerPaginaDesdeDisco(id_bloque, id_frame_disponible);
-    if (read_status != Status::OK) {
-        std::cerr << "Error al leer el bloque " << id_bloque << " desde disco." << std::endl;
-        // Marcar el frame como no válido si la lectura falla
-        frames_[id_frame_disponible].es_valida = false;
-        frames_[id_frame_disponible].id_bloque = INVALID_PAGE_ID;
-        politica_reemplazo_->RemoverFrame(id_frame_disponible); // Remover de la política
-        return read_status;
-    }
+Status GestorBuffer::PinPage(BlockId id_bloque, Byte*& datos_pagina) {
+    datos_pagina = nullptr;
+    MedidorLatencia medidor_anclaje(OperacionMetrica::ANCLAR_PAGINA);
+    auto& particion = ObtenerParticion(id_bloque);
+
+    while (true) {
+        // 1. Buscar la página en la tabla (solo el mutex de su partición)
+        FrameId id_frame = INVALID_FRAME_ID;
+        {
+            std::lock_guard<std::mutex> lock(particion.mutex);
+            auto it = particion.mapa.find(id_bloque);
+            if (it != particion.mapa.end()) {
+                id_frame = it->second;
+                // Anclar bajo el mutex de la partición: el desalojo comprueba el
+                // contador bajo el mismo mutex antes de retirar la entrada.
+                control_frames_[id_frame].contador_anclajes.fetch_add(1);
+            }
+        }
 
-    // 4. Actualizar metadatos del frame y tabla de páginas
-    frames_[id_frame_disponible].id_bloque = id_bloque;
-    frames_[id_frame_disponible].es_valida = true;
-    frames_[id_frame_disponible].esta_sucia = false; // Recién cargada, no está sucia
-    frames_[id_frame_disponible].contador_anclajes = 1; // Anclada por esta operación
-    frames_[id_frame_disponible].contador_accesos = 1;
-    frames_[id_frame_disponible].timestamp_ultimo_acceso = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
-    frames_[id_frame_disponible].timestamp_ultima_modificacion = 0; // No modificada aún
-    frames_[id_frame_disponible].cambios_pendientes = false;
+        if (id_frame != INVALID_FRAME_ID) {
+            ControlFrame& control = control_frames_[id_frame];
+            if (!control.es_valida.load()) {
+                // Si otro hilo la está cargando, esperar solo sobre este frame
+                std::shared_lock<std::shared_mutex> espera(latches_[id_frame]);
+            }
+            if (!control.es_valida.load() || control.id_bloque.load() != id_bloque) {
+                // La carga concurrente falló: soltar el anclaje y reintentar (la
+                // entrada ya no está en la tabla, así que este hilo hará la lectura)
+                control.contador_anclajes.fetch_sub(1);
+                continue;
+            }
+            if (control.precargada.load(std::memory_order_relaxed) && control.precargada.exchange(false)) {
+                aciertos_precarga_.fetch_add(1, std::memory_order_relaxed);
+                DetectarAccesoSecuencial(id_bloque); // El recorrido alcanza lo precargado
+            }
+            RegistrarAccesoFrame(id_frame);
+            if (politica_segura_entre_hilos_) {
+                politica_reemplazo_->Acceder(id_frame); // Sin mutex: p. ej. CLOCK atómico
+            } else {
+                std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+                if (!control.en_desalojo.load()) {
+                    politica_reemplazo_->Acceder(id_frame);
+                }
+            }
+            ActualizarEstadisticas(OperacionBuffer::CACHE_HIT);
+            datos_pagina = DatosFrame(id_frame);
+            medidor_anclaje.EstablecerTipoPagina(TipoPaginaDeFrame(id_frame));
+            return Status::OK;
+        }
 
-    // Asumir el tipo de página si no se conoce, o obtenerlo de la cabecera del bloque
-    // Para simplificar, asumiremos que es una DATA_PAGE por defecto si no se especifica.
-    // En un sistema real, se leería la cabecera del bloque para obtener el tipo.
-    frames_[id_frame_disponible].tipo_pagina = PageType::DATA_PAGE; 
+        // 2. Cache Miss: reservar un frame (libre o desalojado) sin mantener la partición
+        ActualizarEstadisticas(OperacionBuffer::CACHE_MISS);
+        MedidorLatencia medidor_fallo(OperacionMetrica::FALLO_BUFFER);
+        NotificarEscritorSiNecesario();
+        DetectarAccesoSecuencial(id_bloque); // La precarga se solapa con esta lectura
+        FrameId id_frame_disponible = INVALID_FRAME_ID;
+        Status reserva_status = ReservarFrame(id_frame_disponible);
+        if (reserva_status != Status::OK) {
+            std::cerr << "Error: No se pudo obtener un frame para anclar el bloque " << id_bloque << "." << std::endl;
+            return reserva_status;
+        }
 
-    tabla_paginas_[id_bloque] = id_frame_disponible;
-    politica_reemplazo_->AgregarFrame(id_frame_disponible); // Notificar a la política que el frame está en uso
-    politica_reemplazo_->Acceder(id_frame_disponible); // Registrar el acceso inicial
+        ControlFrame& control = control_frames_[id_frame_disponible];
+        bool cargada_por_otro = false;
+        {
+            std::lock_guard<std::mutex> lock(particion.mutex);
+            if (particion.mapa.count(id_bloque) > 0) {
+                cargada_por_otro = true;
+            } else {
+                // Publicar la entrada con el latch exclusivo tomado: quien la encuentre
+                // esperará a que termine la lectura.
+                latches_[id_frame_disponible].lock();
+                control.id_bloque.store(id_bloque);
+                control.es_valida.store(false);
+                MarcarLimpia(control);
+                control.contador_anclajes.store(1);
+                particion.mapa[id_bloque] = id_frame_disponible;
+            }
+        }
+        if (cargada_por_otro) {
+            // Otro hilo cargó la misma página mientras reservábamos: usar la suya.
+            // LiberarFrame toma mutex_politica_, por eso fuera de la partición.
+            LiberarFrame(id_frame_disponible);
+            medidor_fallo.Cancelar();
+            continue;
+        }
+        ReiniciarEstadisticasFrame(id_frame_disponible, 1, false);
+
+        // 3. Cargar la página desde disco sin ningún mutex compartido
+        Status read_status = LeerPaginaDesdeDisco(id_bloque, id_frame_disponible);
+        if (read_status != Status::OK) {
+            std::cerr << "Error al leer el bloque " << id_bloque << " desde disco." << std::endl;
+            DescartarCargaFallida(id_bloque, id_frame_disponible);
+            return read_status;
+        }
+        control.es_valida.store(true);
+        latches_[id_frame_disponible].unlock();
+
+        // 4. Registrar el frame en la política de reemplazo
+        {
+            std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+            politica_reemplazo_->AsignarBloque(id_frame_disponible, id_bloque);
+            politica_reemplazo_->AgregarFrame(id_frame_disponible); // Cuenta como primera referencia
+        }
 
-    pagina_info = frames_[id_frame_disponible]; // Copiar información del frame
-    return Status::OK;
+        datos_pagina = DatosFrame(id_frame_disponible);
+        PageType tipo_pagina = TipoPaginaDeFrame(id_frame_disponible);
+        medidor_fallo.EstablecerTipoPagina(tipo_pagina);
+        medidor_anclaje.EstablecerTipoPagina(tipo_pagina);
+        return Status::OK;
+    }
 }
 
 Status GestorBuffer::UnpinPage(BlockId id_bloque, bool is_dirty) {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
-
-    auto it = tabla_paginas_.find(id_bloque);
-    if (it == tabla_paginas_.end()) {
-        std::cerr << "Error: Intentando desanclar una página que no está en el buffer: " << id_bloque << std::endl;
-        return Status::NOT_FOUND;
-    }
-
-    FrameId id_frame = it->second;
-    if (frames_[id_frame].contador_anclajes <= 0) {
-        std::cerr << "Advertencia: Intentando desanclar una página con contador de anclajes cero o negativo: " << id_bloque << std::endl;
-        return Status::INVALID_ARGUMENT; // O un status más específico
+    FrameId id_frame = INVALID_FRAME_ID;
+    {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        auto it = particion.mapa.find(id_bloque);
+        if (it == particion.mapa.end()) {
+            std::cerr << "Error: Intentando desanclar una página que no está en el buffer: " << id_bloque << std::endl;
+            return Status::NOT_FOUND;
+        }
+        id_frame = it->second;
     }
 
-    frames_[id_frame].contador_anclajes--;
+    ControlFrame& control = control_frames_[id_frame];
+    // Marcar sucia antes de soltar el anclaje para que el desalojo la vea
     if (is_dirty) {
-        frames_[id_frame].esta_sucia = true;
-        frames_[id_frame].timestamp_ultima_modificacion = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count();
-        frames_[id_frame].contador_modificaciones++;
+        MarcarSucia(control);
+        RegistrarModificacionFrame(id_frame);
     }
-    politica_reemplazo_->Desanclar(id_frame); // Notificar a la política de reemplazo
+
+    uint32_t anclajes = control.contador_anclajes.load();
+    do {
+        if (anclajes == 0) {
+            std::cerr << "Advertencia: Intentando desanclar una página con contador de anclajes cero: " << id_bloque << std::endl;
+            return Status::INVALID_ARGUMENT;
+        }
+    } while (!control.contador_anclajes.compare_exchange_weak(anclajes, anclajes - 1));
 
     return Status::OK;
 }
 
 Byte* GestorBuffer::GetPageData(BlockId id_bloque) {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
+    auto& particion = ObtenerParticion(id_bloque);
+    std::lock_guard<std::mutex> lock(particion.mutex);
 
-    auto it = tabla_paginas_.find(id_bloque);
-    if (it == tabla_paginas_.end()) {
+    auto it = particion.mapa.find(id_bloque);
+    if (it == particion.mapa.end()) {
         std::cerr << "Error: Intentando obtener datos de una página no presente en el buffer: " << id_bloque << std::endl;
         return nullptr;
     }
 
     FrameId id_frame = it->second;
-    if (frames_[id_frame].contador_anclajes <= 0) {
+    if (control_frames_[id_frame].contador_anclajes.load() == 0) {
         std::cerr << "Advertencia: Acceso a datos de página no anclada. Esto podría ser un error lógico: " << id_bloque << std::endl;
         // Dependiendo de la política, se podría permitir o no. Por seguridad, retornamos nullptr.
         return nullptr;
     }
 
-    // Notificar acceso a la política de reemplazo (ya se hizo en PinPage, pero si se llama GetPageData directamente)
-    politica_reemplazo_->Acceder(id_frame);
-    frames_[id_frame].timestamp_ultimo_acceso = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
-
-    return pool_datos_buffer_[id_frame].data();
+    return DatosFrame(id_frame);
 }
 
 Status GestorBuffer::NewPage(BlockId& id_bloque, Pagina& pagina_info) {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
+    Byte* datos_pagina = nullptr;
+    Status estado = NewPage(id_bloque, datos_pagina);
+    if (estado == Status::OK) {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        auto it = particion.mapa.find(id_bloque);
+        if (it != particion.mapa.end()) {
+            CopiarInfoPagina(it->second, pagina_info);
+        }
+    }
+    return estado;
+}
+
+Status GestorBuffer::NewPage(BlockId& id_bloque, Byte*& datos_pagina) {
+    datos_pagina = nullptr;
 
     // 1. Asignar un nuevo bloque en disco
     BlockId nuevo_id_bloque = gestor_disco_->AsignarBloque(PageType::DATA_PAGE); // Asumimos DATA_PAGE para nuevos bloques
@@ -206,78 +289,109 @@ Status GestorBuffer::NewPage(BlockId& id_bloque, Pagina& pagina_info) {
     }
     id_bloque = nuevo_id_bloque; // Devolver el ID del nuevo bloque
 
-    // 2. Encontrar un frame libre o desalojar una página para el nuevo bloque
-    FrameId id_frame_disponible = EncontrarFrameLibre();
-    if (id_frame_disponible == INVALID_FRAME_ID) {
-        Status desalojo_status = DesalojarPagina();
-        if (desalojo_status != Status::OK) {
-            std::cerr << "Error: No se pudo desalojar una página para crear el nuevo bloque " << id_bloque << "." << std::endl;
-            // Desasignar el bloque recién creado en disco si no se puede cargar en buffer
-            gestor_disco_->DesasignarBloque(id_bloque);
-            return desalojo_status;
-        }
-        id_frame_disponible = politica_reemplazo_->ObtenerVictima();
-        if (id_frame_disponible == INVALID_FRAME_ID) {
-            std::cerr << "Error crítico: La política de reemplazo no devolvió un frame válido después del desalojo para NewPage." << std::endl;
-            gestor_disco_->DesasignarBloque(id_bloque);
-            return Status::ERROR;
-        }
+    Status estado = NewPageInExtent(id_bloque, datos_pagina);
+    if (estado != Status::OK) {
+        // Desasignar el bloque recién creado en disco si no se puede cargar en buffer
+        gestor_disco_->DesasignarBloque(id_bloque);
     }
+    return estado;
+}
 
-    // 3. Inicializar el frame en el buffer con los metadatos del nuevo bloque
-    frames_[id_frame_disponible].id_bloque = id_bloque;
-    frames_[id_frame_disponible].id_frame = id_frame_disponible;
-    frames_[id_frame_disponible].es_valida = true;
-    frames_[id_frame_disponible].esta_sucia = true; // Nuevo bloque, se considera sucio para ser escrito a disco
-    frames_[id_frame_disponible].contador_anclajes = 1; // Anclada por esta operación
-    frames_[id_frame_disponible].contador_accesos = 1;
-    frames_[id_frame_disponible].timestamp_creacion = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
-    frames_[id_frame_disponible].timestamp_ultimo_acceso = frames_[id_frame_disponible].timestamp_creacion;
-    frames_[id_frame_disponible].timestamp_ultima_modificacion = frames_[id_frame_disponible].timestamp_creacion;
-    frames_[id_frame_disponible].cambios_pendientes = true;
-    frames_[id_frame_disponible].tipo_pagina = PageType::DATA_PAGE; // Tipo de página del nuevo bloque
+Status GestorBuffer::ReservarExtension(uint32_t paginas_deseadas, BlockId& primer_bloque, uint32_t& paginas_reservadas) {
+    primer_bloque = gestor_disco_->AsignarExtension(PageType::DATA_PAGE, paginas_deseadas, paginas_reservadas);
+    if (primer_bloque == 0) {
+        std::cerr << "Error: No se pudo asignar una extensión de " << paginas_deseadas << " páginas en disco." << std::endl;
+        return Status::DISK_FULL;
+    }
+    return Status::OK;
+}
+
+Status GestorBuffer::NewPageInExtent(BlockId id_bloque, Byte*& datos_pagina) {
+    datos_pagina = nullptr;
+    {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        if (particion.mapa.count(id_bloque)) {
+            std::cerr << "Error: El bloque " << id_bloque << " ya está en el buffer." << std::endl;
+            return Status::DUPLICATE_ENTRY;
+        }
+    }
 
-    // Limpiar el contenido del frame para el nuevo bloque
-    std::memset(pool_datos_buffer_[id_frame_disponible].data(), 0, tamaño_bloque_);
+    // 2. Reservar un frame libre o desalojar una página para el nuevo bloque
+    NotificarEscritorSiNecesario();
+    FrameId id_frame_disponible = INVALID_FRAME_ID;
+    Status reserva_status = ReservarFrame(id_frame_disponible);
+    if (reserva_status != Status::OK) {
+        std::cerr << "Error: No se pudo obtener un frame para crear el nuevo bloque " << id_bloque << "." << std::endl;
+        return reserva_status;
+    }
 
-    // Actualizar tabla de páginas
-    tabla_paginas_[id_bloque] = id_frame_disponible;
-    politica_reemplazo_->AgregarFrame(id_frame_disponible); // Notificar a la política
-    politica_reemplazo_->Anclar(id_frame_disponible); // Anclar en la política
+    // 3. Inicializar el frame: nuevo bloque, sucio para que se escriba a disco
+    std::memset(DatosFrame(id_frame_disponible), 0, tamaño_bloque_);
+    ControlFrame& control = control_frames_[id_frame_disponible];
+    control.id_bloque.store(id_bloque);
+    lsn_recuperacion_[id_frame_disponible].store(LSN_INVALIDO);
+    MarcarSucia(control);
+    control.contador_anclajes.store(1);
+    ReiniciarEstadisticasFrame(id_frame_disponible, 1, true);
+    control.es_valida.store(true);
+
+    {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        particion.mapa[id_bloque] = id_frame_disponible;
+    }
+    {
+        std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+        politica_reemplazo_->AsignarBloque(id_frame_disponible, id_bloque);
+        politica_reemplazo_->AgregarFrame(id_frame_disponible);
+    }
 
-    pagina_info = frames_[id_frame_disponible]; // Copiar información del frame
+    datos_pagina = DatosFrame(id_frame_disponible);
     return Status::OK;
 }
 
 Status GestorBuffer::DeletePage(BlockId id_bloque) {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
+    FrameId id_frame = INVALID_FRAME_ID;
+    {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+
+        auto it = particion.mapa.find(id_bloque);
+        if (it != particion.mapa.end()) {
+            id_frame = it->second;
+            ControlFrame& control = control_frames_[id_frame];
+
+            // Si la página está anclada, no se puede eliminar
+            if (control.contador_anclajes.load() > 0) {
+                std::cerr << "Error: No se puede eliminar la página " << id_bloque << " porque está anclada ("
+                          << control.contador_anclajes.load() << " anclajes)." << std::endl;
+                return Status::PAGE_PINNED;
+            }
+            // Un desalojo en curso ya es dueño del frame
+            if (control.en_desalojo.load()) {
+                return Status::RESOURCE_BUSY;
+            }
+            particion.mapa.erase(it);
+            control.es_valida.store(false);
+            MarcarLimpia(control); // El bloque se descarta: no hace falta escribirlo
+            lsn_recuperacion_[id_frame].store(LSN_INVALIDO);
+            control.id_bloque.store(INVALID_PAGE_ID);
+        }
+    }
 
-    auto it = tabla_paginas_.find(id_bloque);
-    if (it == tabla_paginas_.end()) {
+    if (id_frame == INVALID_FRAME_ID) {
         std::cerr << "Advertencia: Intentando eliminar una página que no está en el buffer: " << id_bloque << std::endl;
         // Si no está en el buffer, intentar desasignar directamente del disco
         return gestor_disco_->DesasignarBloque(id_bloque);
     }
 
-    FrameId id_frame = it->second;
-
-    // Si la página está anclada, no se puede eliminar
-    if (frames_[id_frame].contador_anclajes > 0) {
-        std::cerr << "Error: No se puede eliminar la página " << id_bloque << " porque está anclada (" 
-                  << frames_[id_frame].contador_anclajes << " anclajes)." << std::endl;
-        return Status::PAGE_PINNED;
-    }
-
-    // Si la página está sucia, forzar la escritura a disco antes de eliminar
-    if (frames_[id_frame].esta_sucia) {
-        Status flush_status = EscribirPaginaADisco(id_bloque);
-        if (flush_status != Status::OK) {
-            std::cerr << "Error: No se pudo escribir la página sucia " << id_bloque << " a disco antes de eliminarla." << std::endl;
-            return flush_status;
-        }
+    {
+        std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+        politica_reemplazo_->RemoverFrame(id_frame);
     }
+    std::memset(DatosFrame(id_frame), 0, tamaño_bloque_);
+    LiberarFrame(id_frame);
 
     // Desasignar el bloque del disco
     Status disk_status = gestor_disco_->DesasignarBloque(id_bloque);
@@ -286,72 +400,177 @@ Status GestorBuffer::DeletePage(BlockId id_bloque) {
         return disk_status;
     }
 
-    // Limpiar el frame en el buffer
-    std::memset(pool_datos_buffer_[id_frame].data(), 0, tamaño_bloque_);
-    frames_[id_frame] = Pagina(); // Resetear metadatos del frame
-    frames_[id_frame].id_frame = id_frame; // Mantener el ID del frame
-    
-    // Remover de la tabla de páginas y de la política de reemplazo
-    tabla_paginas_.erase(id_bloque);
-    politica_reemplazo_->RemoverFrame(id_frame);
-
     std::cout << "Página " << id_bloque << " eliminada exitosamente del buffer y disco." << std::endl;
     return Status::OK;
 }
 
-Status GestorBuffer::FlushPage(BlockId id_bloque) {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
+Status GestorBuffer::DescartarPagina(BlockId id_bloque) {
+    FrameId id_frame = INVALID_FRAME_ID;
+    {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
 
-    auto it = tabla_paginas_.find(id_bloque);
-    if (it == tabla_paginas_.end()) {
-        std::cerr << "Advertencia: Intentando forzar escritura de una página no presente en el buffer: " << id_bloque << std::endl;
-        return Status::NOT_FOUND;
+        auto it = particion.mapa.find(id_bloque);
+        if (it == particion.mapa.end()) {
+            return Status::OK;
+        }
+        id_frame = it->second;
+        ControlFrame& control = control_frames_[id_frame];
+        if (control.contador_anclajes.load() > 0) {
+            return Status::PAGE_PINNED;
+        }
+        // Una página sucia perdería cambios; un desalojo en curso ya es dueño del frame
+        if (control.esta_sucia.load() || control.en_desalojo.load()) {
+            return Status::RESOURCE_BUSY;
+        }
+        particion.mapa.erase(it);
+        control.es_valida.store(false);
+        lsn_recuperacion_[id_frame].store(LSN_INVALIDO);
+        control.id_bloque.store(INVALID_PAGE_ID);
     }
 
-    FrameId id_frame = it->second;
-    if (frames_[id_frame].esta_sucia) {
-        Status write_status = EscribirPaginaADisco(id_bloque);
+    {
+        std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+        politica_reemplazo_->RemoverFrame(id_frame);
+    }
+    std::memset(DatosFrame(id_frame), 0, tamaño_bloque_);
+    LiberarFrame(id_frame);
+    return Status::OK;
+}
+
+Status GestorBuffer::FlushPage(BlockId id_bloque) {
+    FrameId id_frame = INVALID_FRAME_ID;
+    {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        auto it = particion.mapa.find(id_bloque);
+        if (it == particion.mapa.end()) {
+            std::cerr << "Advertencia: Intentando forzar escritura de una página no presente en el buffer: " << id_bloque << std::endl;
+            return Status::NOT_FOUND;
+        }
+        id_frame = it->second;
+        // Anclar mientras se escribe para que no pueda desalojarse
+        control_frames_[id_frame].contador_anclajes.fetch_add(1);
+    }
+
+    ControlFrame& control = control_frames_[id_frame];
+    Status write_status = Status::OK;
+    if (control.esta_sucia.load()) {
+        write_status = EscribirFrameADisco(id_frame);
         if (write_status != Status::OK) {
             std::cerr << "Error al forzar la escritura de la página " << id_bloque << " a disco." << std::endl;
-            return write_status;
+        } else {
+            std::cout << "Página " << id_bloque << " forzada a disco exitosamente." << std::endl;
         }
-        frames_[id_frame].esta_sucia = false;
-        frames_[id_frame].cambios_pendientes = false;
-        std::cout << "Página " << id_bloque << " forzada a disco exitosamente." << std::endl;
     } else {
         std::cout << "Página " << id_bloque << " no está sucia, no se requiere escritura." << std::endl;
     }
-    return Status::OK;
+    control.contador_anclajes.fetch_sub(1);
+    return write_status;
 }
 
 Status GestorBuffer::FlushAllPages() {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
-    Status overall_status = Status::OK;
-
-    for (FrameId i = 0; i < tamaño_pool_; ++i) {
-        if (frames_[i].es_valida && frames_[i].esta_sucia) {
-            Status flush_status = EscribirPaginaADisco(frames_[i].id_bloque);
-            if (flush_status != Status::OK) {
-                std::cerr << "Error al escribir la página sucia " << frames_[i].id_bloque << " a disco durante FlushAllPages." << std::endl;
-                overall_status = Status::ERROR; // Continuar, pero registrar el error
-            } else {
-                frames_[i].esta_sucia = false;
-                frames_[i].cambios_pendientes = false;
+    // Anclar todas las páginas sucias (así no pueden desalojarse durante la escritura)
+    // y enviarlas al disco en un único lote: el GestorDisco las ordena por cilindro
+    // y agrupa las que son contiguas.
+    std::vector<FrameId> frames_lote;
+    for (auto& particion : particiones_) {
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        for (const auto& entrada : particion.mapa) {
+            ControlFrame& control = control_frames_[entrada.second];
+            if (control.es_valida.load() && control.esta_sucia.load()) {
+                control.contador_anclajes.fetch_add(1);
+                frames_lote.push_back(entrada.second);
             }
         }
     }
+    if (frames_lote.empty()) {
+        return Status::OK;
+    }
+
+    uint32_t escritas = 0;
+    Status overall_status = EscribirFramesEnLote(frames_lote, escritas);
+    if (overall_status != Status::OK) {
+        std::cerr << "Error: FlushAllPages escribió " << escritas << " de " << frames_lote.size()
+                  << " páginas sucias." << std::endl;
+    }
     return overall_status;
 }
 
-uint32_t GestorBuffer::GetNumFreeFrames() const {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
-    uint32_t free_frames = 0;
-    for (const auto& frame : frames_) {
-        if (!frame.es_valida || frame.id_bloque == INVALID_PAGE_ID) { // Considerar inválido o no asignado como libre
-            free_frames++;
-        }
+Status GestorBuffer::ConfigurarEscritorSegundoPlano(const ConfiguracionEscritor& config) {
+    if (config.umbral_sucias_bajo < 0.0 || config.umbral_sucias_alto > 1.0 ||
+        config.umbral_sucias_bajo > config.umbral_sucias_alto ||
+        config.intervalo_ms == 0 || config.max_paginas_lote == 0) {
+        std::cerr << "Error: Configuración del escritor en segundo plano no válida." << std::endl;
+        return Status::INVALID_ARGUMENT;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_escritor_);
+        config_escritor_ = config;
+    }
+    umbral_paginas_sucias_alto_.store(static_cast<uint32_t>(config.umbral_sucias_alto * tamaño_pool_));
+
+    if (config.activo) {
+        IniciarEscritor();
+        cv_escritor_.notify_one(); // Aplicar el nuevo intervalo de inmediato
+    } else {
+        DetenerEscritor();
+    }
+    return Status::OK;
+}
+
+GestorBuffer::ConfiguracionEscritor GestorBuffer::ObtenerConfiguracionEscritor() const {
+    std::lock_guard<std::mutex> lock(mutex_escritor_);
+    return config_escritor_;
+}
+
+size_t GestorBuffer::DeclararLecturaSecuencial(const std::vector<BlockId>& paginas) {
+    if (ventana_lectura_anticipada_.load(std::memory_order_relaxed) == 0) {
+        return paginas.size(); // Desactivada: nada pendiente de solicitar
+    }
+    size_t limite = std::min<size_t>(ObtenerVentanaEfectiva(), paginas.size());
+    PrecargarPaginas(std::vector<BlockId>(paginas.begin(), paginas.begin() + limite));
+    return limite;
+}
+
+void GestorBuffer::AvanzarLecturaSecuencial(const std::vector<BlockId>& paginas, size_t posicion, size_t& limite) {
+    if (limite >= paginas.size()) {
+        return;
+    }
+    uint32_t ventana = ObtenerVentanaEfectiva();
+    if (ventana_lectura_anticipada_.load(std::memory_order_relaxed) == 0 || posicion + ventana / 2 + 1 < limite) {
+        return;
+    }
+    size_t hasta = std::min(paginas.size(), posicion + 1 + ventana);
+    if (hasta <= limite) {
+        return;
     }
-    return free_frames;
+    std::vector<BlockId> siguientes(paginas.begin() + limite, paginas.begin() + hasta);
+    limite = hasta;
+    PrecargarPaginas(std::move(siguientes));
+}
+
+void GestorBuffer::PrecargarPaginas(std::vector<BlockId> paginas) {
+    if (paginas.empty() || cerrando_.load()) {
+        return;
+    }
+    std::call_once(inicializacion_pool_lectura_, [this]() {
+        pool_lectura_anticipada_ = std::make_unique<PoolHilos>(HILOS_LECTURA_ANTICIPADA);
+    });
+    pool_lectura_anticipada_->Encolar([this, paginas = std::move(paginas)]() {
+        EjecutarPrecarga(paginas);
+    });
+}
+
+void GestorBuffer::ConfigurarLecturaAnticipada(uint32_t ventana_paginas, bool deteccion_secuencial) {
+    ventana_lectura_anticipada_ = ventana_paginas;
+    deteccion_secuencial_ = deteccion_secuencial;
+}
+
+uint32_t GestorBuffer::GetNumFreeFrames() const {
+    std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+    return static_cast<uint32_t>(frames_libres_.size());
 }
 
 uint32_t GestorBuffer::GetPoolSize() const {
@@ -359,80 +578,120 @@ uint32_t GestorBuffer::GetPoolSize() const {
 }
 
 void GestorBuffer::ResetStats() {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
-    estadisticas_ = BufferStats(); // Resetear a valores por defecto
-    estadisticas_.ult_timestamp_reset = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+    hits_cache_ = 0;
+    misses_cache_ = 0;
+    lecturas_disco_ = 0;
+    escrituras_disco_ = 0;
+    desalojos_ = 0;
+    tiempo_total_io_us_ = 0;
+    escrituras_segundo_plano_ = 0;
+    desalojos_sucios_ = 0;
+    paginas_precargadas_ = 0;
+    aciertos_precarga_ = 0;
+    ult_timestamp_reset_ = ObtenerTimestampActualMs();
     std::cout << "Estadísticas del GestorBuffer reiniciadas." << std::endl;
 }
 
 void GestorBuffer::PrintStats() const {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
+    BufferStats estadisticas = GetStats();
     std::cout << "\n=== ESTADÍSTICAS DEL GESTOR DE BUFFER ===" << std::endl;
     std::cout << "Tamaño del Pool: " << tamaño_pool_ << " frames" << std::endl;
     std::cout << "Frames Libres: " << GetNumFreeFrames() << std::endl;
-    std::cout << "Hits de Cache: " << estadisticas_.hits_cache << std::endl;
-    std::cout << "Misses de Cache: " << estadisticas_.misses_cache << std::endl;
-    std::cout << "Lecturas de Disco: " << estadisticas_.lecturas_disco << std::endl;
-    std::cout << "Escrituras de Disco: " << estadisticas_.escrituras_disco << std::endl;
-    std::cout << "Desalojos: " << estadisticas_.desalojos << std::endl;
-    std::cout << "Páginas Ancladas: " << estadisticas_.paginas_ancladas << std::endl; // Actualizar este contador
-    std::cout << "Páginas Sucias: " << estadisticas_.paginas_sucias << std::endl;     // Actualizar este contador
-    std::cout << "Tiempo Total de Espera (ms): " << estadisticas_.tiempo_total_espera_pin << std::endl;
-    std::cout << "Tiempo Total de I/O (ms): " << estadisticas_.tiempo_total_io << std::endl;
-    std::cout << "Tiempo Política Reemplazo (ms): " << estadisticas_.tiempo_total_procesamiento_politica << std::endl;
+    std::cout << "Hits de Cache: " << estadisticas.hits_cache << std::endl;
+    std::cout << "Misses de Cache: " << estadisticas.misses_cache << std::endl;
+    std::cout << "Lecturas de Disco: " << estadisticas.lecturas_disco << std::endl;
+    std::cout << "Escrituras de Disco: " << estadisticas.escrituras_disco << std::endl;
+    std::cout << "Desalojos: " << estadisticas.desalojos << std::endl;
+    std::cout << "Desalojos con Escritura Síncrona: " << estadisticas.desalojos_sucios << std::endl;
+    std::cout << "Escrituras en Segundo Plano: " << estadisticas.escrituras_segundo_plano << std::endl;
+    std::cout << "Páginas Precargadas: " << estadisticas.paginas_precargadas
+              << " (aprovechadas: " << estadisticas.aciertos_precarga << ")" << std::endl;
+    std::cout << "Páginas Ancladas (actual): " << estadisticas.paginas_ancladas << std::endl;
+    std::cout << "Páginas Sucias (actual): " << estadisticas.paginas_sucias << std::endl;
+    std::cout << "Tiempo Total de I/O (ms): " << estadisticas.tiempo_total_io << std::endl;
     std::cout << "Último Reset de Estadísticas: " << ObtenerTimestampActualString() << std::endl;
     std::cout << "---------------------------------------" << std::endl;
-
-    // Actualizar paginas_ancladas y paginas_sucias para la impresión
-    uint64_t current_pinned = 0;
-    uint64_t current_dirty = 0;
-    for (const auto& frame : frames_) {
-        if (frame.es_valida && frame.contador_anclajes > 0) {
-            current_pinned++;
-        }
-        if (frame.es_valida && frame.esta_sucia) {
-            current_dirty++;
-        }
-    }
-    // No modificar estadisticas_ aquí, solo para la impresión actual
-    std::cout << "Páginas Ancladas (actual): " << current_pinned << std::endl;
-    std::cout << "Páginas Sucias (actual): " << current_dirty << std::endl;
 }
 
 GestorBuffer::BufferStats GestorBuffer::GetStats() const {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
-    return estadisticas_;
+    BufferStats estadisticas;
+    estadisticas.hits_cache = hits_cache_.load();
+    estadisticas.misses_cache = misses_cache_.load();
+    estadisticas.lecturas_disco = lecturas_disco_.load();
+    estadisticas.escrituras_disco = escrituras_disco_.load();
+    estadisticas.desalojos = desalojos_.load();
+    estadisticas.desalojos_sucios = desalojos_sucios_.load();
+    estadisticas.escrituras_segundo_plano = escrituras_segundo_plano_.load();
+    estadisticas.paginas_precargadas = paginas_precargadas_.load();
+    estadisticas.aciertos_precarga = aciertos_precarga_.load();
+    estadisticas.tiempo_total_io = tiempo_total_io_us_.load() / 1000;
+    estadisticas.ult_timestamp_reset = ult_timestamp_reset_.load();
+    if (GestorWAL* wal = wal_.load()) {
+        estadisticas.confirmaciones = wal->ObtenerEstadisticas().confirmaciones;
+    }
+
+    // Las páginas ancladas y sucias se calculan al consultar, no en cada operación
+    for (FrameId i = 0; i < tamaño_pool_; ++i) {
+        const ControlFrame& control = control_frames_[i];
+        if (!control.es_valida.load(std::memory_order_relaxed)) continue;
+        if (control.contador_anclajes.load(std::memory_order_relaxed) > 0) estadisticas.paginas_ancladas++;
+        if (control.esta_sucia.load(std::memory_order_relaxed)) estadisticas.paginas_sucias++;
+    }
+    return estadisticas;
 }
 
 Status GestorBuffer::ValidarConsistencia() const {
-    std::lock_guard<std::mutex> lock(mutex_buffer_);
-    // 1. Verificar que el tamaño del pool sea consistente
-    if (pool_datos_buffer_.size() != tamaño_pool_ || frames_.size() != tamaño_pool_) {
-        std::cerr << "Error de consistencia: Tamaños de pool o frames inconsistentes." << std::endl;
-        return Status::ERROR;
+    // Validación global: bloquea la política y todas las particiones (en orden)
+    std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(NUM_PARTICIONES_TABLA);
+    for (const auto& particion : particiones_) {
+        locks.emplace_back(particion.mutex);
     }
 
-    // 2. Verificar que la tabla_paginas_ refleje correctamente los frames válidos
-    if (tabla_paginas_.size() > tamaño_pool_) {
-        std::cerr << "Error de consistencia: tabla_paginas_ tiene más entradas que frames en el pool." << std::endl;
+    // 1. Verificar la arena y la lista de frames libres
+    if (arena_datos_ == nullptr || paso_frame_ < tamaño_bloque_) {
+        std::cerr << "Error de consistencia: Arena de datos del pool inconsistente." << std::endl;
         return Status::ERROR;
     }
-
-    for (const auto& entry : tabla_paginas_) {
-        BlockId page_id = entry.first;
-        FrameId frame_id = entry.second;
-
-        if (frame_id >= tamaño_pool_) {
-            std::cerr << "Error de consistencia: FrameId en tabla_paginas_ fuera de rango." << std::endl;
+    if (frames_libres_.size() > tamaño_pool_) {
+        std::cerr << "Error de consistencia: La lista de frames libres excede el tamaño del pool." << std::endl;
+        return Status::ERROR;
+    }
+    for (FrameId libre : frames_libres_) {
+        if (libre >= tamaño_pool_ || control_frames_[libre].en_uso.load()) {
+            std::cerr << "Error de consistencia: Frame " << libre << " en la lista de libres pero en uso." << std::endl;
             return Status::ERROR;
         }
-        if (!frames_[frame_id].es_valida || frames_[frame_id].id_bloque != page_id) {
-            std::cerr << "Error de consistencia: Entrada en tabla_paginas_ no coincide con metadatos del frame." << std::endl;
-            return Status::ERROR;
+    }
+
+    // 2. Verificar que la tabla de páginas refleje correctamente los frames válidos
+    size_t total_entradas = 0;
+    for (uint32_t p = 0; p < NUM_PARTICIONES_TABLA; ++p) {
+        for (const auto& entry : particiones_[p].mapa) {
+            BlockId page_id = entry.first;
+            FrameId frame_id = entry.second;
+            total_entradas++;
+
+            if (page_id % NUM_PARTICIONES_TABLA != p) {
+                std::cerr << "Error de consistencia: Página " << page_id << " en una partición incorrecta." << std::endl;
+                return Status::ERROR;
+            }
+            if (frame_id >= tamaño_pool_) {
+                std::cerr << "Error de consistencia: FrameId en la tabla de páginas fuera de rango." << std::endl;
+                return Status::ERROR;
+            }
+            const ControlFrame& control = control_frames_[frame_id];
+            if (!control.en_uso.load() || control.id_bloque.load() != page_id) {
+                std::cerr << "Error de consistencia: Entrada en la tabla de páginas no coincide con metadatos del frame." << std::endl;
+                return Status::ERROR;
+            }
         }
     }
+    if (total_entradas > tamaño_pool_) {
+        std::cerr << "Error de consistencia: la tabla de páginas tiene más entradas que frames en el pool." << std::endl;
+        return Status::ERROR;
+    }
 
     // 3. Verificar la consistencia de la política de reemplazo
     if (politica_reemplazo_->ValidarConsistencia() != Status::OK) {
@@ -446,66 +705,563 @@ Status GestorBuffer::ValidarConsistencia() const {
 
 // === MÉTODOS AUXILIARES PRIVADOS ===
 
-FrameId GestorBuffer::EncontrarFrameLibre() {
-    for (FrameId i = 0; i < tamaño_pool_; ++i) {
-        if (!frames_[i].es_valida || frames_[i].id_bloque == INVALID_PAGE_ID) {
-            return i; // Encontrado un frame realmente libre o no asignado
+Status GestorBuffer::ReservarFrame(FrameId& id_frame, bool permitir_escritura) {
+    {
+        std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+        id_frame = EncontrarFrameLibre();
+        if (id_frame != INVALID_FRAME_ID) {
+            control_frames_[id_frame].en_uso.store(true);
+            return Status::OK;
         }
     }
-    return INVALID_FRAME_ID; // No hay frames completamente libres
+    // No hay frames libres: desalojar una página. El frame conserva los datos
+    // de la víctima hasta la siguiente lectura, de ahí sale su tipo de página.
+    MedidorLatencia medidor_desalojo(OperacionMetrica::DESALOJO);
+    Status estado = DesalojarPagina(id_frame, permitir_escritura);
+    if (estado == Status::OK) {
+        medidor_desalojo.EstablecerTipoPagina(TipoPaginaDeFrame(id_frame));
+    } else {
+        medidor_desalojo.Cancelar();
+    }
+    return estado;
 }
 
-Status GestorBuffer::DesalojarPagina() {
-    FrameId victima_id = politica_reemplazo_->ObtenerVictima();
-    if (victima_id == INVALID_FRAME_ID) {
-        std::cerr << "Error: No se encontró una página víctima para desalojar. Posiblemente todas están ancladas." << std::endl;
-        return Status::BUFFER_FULL;
+void GestorBuffer::LiberarFrame(FrameId id_frame) {
+    ControlFrame& control = control_frames_[id_frame];
+    control.es_valida.store(false);
+    MarcarLimpia(control);
+    control.en_desalojo.store(false);
+    control.precargada.store(false);
+    control.id_bloque.store(INVALID_PAGE_ID);
+    control.contador_anclajes.store(0);
+    std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+    control.en_uso.store(false);
+    frames_libres_.push_back(id_frame);
+}
+
+FrameId GestorBuffer::EncontrarFrameLibre() {
+    // Requiere mutex_politica_ tomado
+    if (frames_libres_.empty()) {
+        return INVALID_FRAME_ID; // No hay frames completamente libres
     }
+    FrameId id_frame = frames_libres_.back();
+    frames_libres_.pop_back();
+    return id_frame;
+}
 
-    // Si la página víctima está sucia, escribirla a disco
-    if (frames_[victima_id].esta_sucia) {
-        Status write_status = EscribirPaginaADisco(frames_[victima_id].id_bloque);
-        if (write_status != Status::OK) {
-            std::cerr << "Error: No se pudo escribir la página víctima " << frames_[victima_id].id_bloque << " a disco durante el desalojo." << std::endl;
-            return write_status;
+Status GestorBuffer::DesalojarPagina(FrameId& id_frame, bool permitir_escritura) {
+    id_frame = INVALID_FRAME_ID;
+    // La política no conoce los anclajes (son atómicos en el frame): si propone
+    // un frame anclado se pospone y se pide otra víctima.
+    // Las víctimas sucias también se saltan, hasta MAX_VICTIMAS_SUCIAS_OMITIDAS,
+    // para que el fallo de caché no pague una escritura: de ellas se ocupa el escritor.
+    const uint32_t max_intentos = tamaño_pool_ * 2;
+    uint32_t sucias_omitidas = 0;
+
+    for (uint32_t intento = 0; intento < max_intentos; ++intento) {
+        FrameId victima_id = INVALID_FRAME_ID;
+        BlockId bloque_victima = INVALID_PAGE_ID;
+        {
+            std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+            victima_id = politica_reemplazo_->Desalojar();
+            if (victima_id == INVALID_FRAME_ID) {
+                break;
+            }
+            ControlFrame& control = control_frames_[victima_id];
+            bloque_victima = control.id_bloque.load();
+            if (bloque_victima == INVALID_PAGE_ID) {
+                politica_reemplazo_->RemoverFrame(victima_id);
+                continue;
+            }
+
+            auto& particion = ObtenerParticion(bloque_victima);
+            std::lock_guard<std::mutex> lock(particion.mutex);
+            if (control.contador_anclajes.load() > 0 || control.en_desalojo.load()) {
+                politica_reemplazo_->Posponer(victima_id);
+                continue;
+            }
+            if (control.esta_sucia.load() && (!permitir_escritura || sucias_omitidas < MAX_VICTIMAS_SUCIAS_OMITIDAS)) {
+                sucias_omitidas++;
+                politica_reemplazo_->Posponer(victima_id);
+                continue;
+            }
+            control.en_desalojo.store(true);
+            politica_reemplazo_->RemoverFrame(victima_id);
+        }
+
+        ControlFrame& control = control_frames_[victima_id];
+
+        // Si la víctima está sucia, escribirla sin mantener ningún mutex. La entrada
+        // sigue en la tabla: si alguien la pide mientras tanto, la encuentra en memoria.
+        if (control.esta_sucia.load()) {
+            ActualizarEstadisticas(OperacionBuffer::DESALOJO_SUCIO);
+            Status write_status = EscribirFrameADisco(victima_id);
+            if (write_status != Status::OK) {
+                std::cerr << "Error: No se pudo escribir la página víctima " << bloque_victima << " a disco durante el desalojo." << std::endl;
+                control.en_desalojo.store(false);
+                std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+                politica_reemplazo_->AgregarFrame(victima_id);
+                return write_status;
+            }
         }
-    }
 
-    // Remover la página de la tabla de páginas
-    tabla_paginas_.erase(frames_[victima_id].id_bloque);
+        // Retirar la entrada solo si nadie la ancló ni la ensució durante la escritura
+        bool desalojada = false;
+        {
+            auto& particion = ObtenerParticion(bloque_victima);
+            std::lock_guard<std::mutex> lock(particion.mutex);
+            if (control.contador_anclajes.load() == 0 && !control.esta_sucia.load()) {
+                particion.mapa.erase(bloque_victima);
+                control.es_valida.store(false);
+                control.precargada.store(false);
+                control.id_bloque.store(INVALID_PAGE_ID);
+                lsn_recuperacion_[victima_id].store(LSN_INVALIDO);
+                desalojada = true;
+            }
+            control.en_desalojo.store(false);
+        }
 
-    // Resetear los metadatos del frame desalojado
-    frames_[victima_id] = Pagina(); // Resetear a valores por defecto
-    frames_[victima_id].id_frame = victima_id; // Mantener el ID del frame
-    
-    ActualizarEstadisticas("desalojo");
-    return Status::OK;
-}
+        if (desalojada) {
+            ActualizarEstadisticas(OperacionBuffer::DESALOJO);
+            id_frame = victima_id; // en_uso sigue a true: el frame queda reservado
+            return Status::OK;
+        }
 
-Status GestorBuffer::EscribirPaginaADisco(BlockId id_bloque) {
-    auto it = tabla_paginas_.find(id_bloque);
-    if (it == tabla_paginas_.end()) {
-        std::cerr << "Error: Intentando escribir a disco una página no presente en el buffer: " << id_bloque << std::endl;
-        return Status::NOT_FOUND;
+        // Volvió a usarse: devolverlo a la política y probar con otra víctima
+        std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+        politica_reemplazo_->AgregarFrame(victima_id);
+        politica_reemplazo_->Acceder(victima_id);
     }
 
-    FrameId id_frame = it->second;
-    if (!frames_[id_frame].es_valida) {
-        std::cerr << "Error: Intentando escribir a disco un frame no válido: " << id_frame << " (Bloque: " << id_bloque << ")" << std::endl;
+    if (permitir_escritura) {
+        std::cerr << "Error: No se encontró una página víctima para desalojar. Posiblemente todas están ancladas." << std::endl;
+    }
+    return Status::BUFFER_FULL;
+}
+
+Status GestorBuffer::EscribirFrameADisco(FrameId id_frame) {
+    ControlFrame& control = control_frames_[id_frame];
+    if (!control.es_valida.load()) {
+        std::cerr << "Error: Intentando escribir a disco un frame no válido: " << id_frame << std::endl;
         return Status::INVALID_ARGUMENT;
     }
 
-    ActualizarEstadisticas("escritura_disco");
-    Status write_status = gestor_disco_->EscribirBloque(id_bloque, pool_datos_buffer_[id_frame].data(), tamaño_bloque_);
+    BlockId id_bloque = control.id_bloque.load();
+    Status estado_log = AsegurarLogDeFrames(&id_frame, 1);
+    if (estado_log != Status::OK) {
+        std::cerr << "Error: El log no es duradero; no se escribe el bloque " << id_bloque << "." << std::endl;
+        return estado_log;
+    }
+    // Limpiar la marca antes de escribir: si alguien modifica la página durante
+    // la escritura volverá a marcarla y no se pierde el cambio.
+    LSN lsn_recuperacion = lsn_recuperacion_[id_frame].load();
+    MarcarLimpia(control);
+
+    ActualizarEstadisticas(OperacionBuffer::ESCRITURA_DISCO);
+    auto inicio = std::chrono::steady_clock::now();
+    Status write_status = gestor_disco_->EscribirBloque(id_bloque, DatosFrame(id_frame), tamaño_bloque_);
+    tiempo_total_io_us_.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - inicio).count());
+
     if (write_status != Status::OK) {
         std::cerr << "Error de E/S: Falló la escritura del bloque " << id_bloque << " a disco." << std::endl;
+        MarcarSucia(control);
         return write_status;
     }
-    frames_[id_frame].esta_sucia = false; // Ya no está sucia después de escribir
-    frames_[id_frame].cambios_pendientes = false;
+    LimpiarLSNRecuperacion(id_frame, lsn_recuperacion);
     return Status::OK;
 }
 
+Status GestorBuffer::EscribirFramesEnLote(std::vector<FrameId>& frames, uint32_t& escritas) {
+    escritas = 0;
+    // Orden de BlockId: el GestorDisco agrupa después los bloques contiguos
+    std::sort(frames.begin(), frames.end(), [this](FrameId a, FrameId b) {
+        return control_frames_[a].id_bloque.load() < control_frames_[b].id_bloque.load();
+    });
+
+    Status estado_log = AsegurarLogDeFrames(frames.data(), frames.size());
+    if (estado_log != Status::OK) {
+        std::cerr << "Error: El log no es duradero; no se escriben " << frames.size() << " páginas." << std::endl;
+        for (FrameId id_frame : frames) {
+            control_frames_[id_frame].contador_anclajes.fetch_sub(1);
+        }
+        return estado_log;
+    }
+
+    std::vector<SolicitudES> solicitudes;
+    std::vector<LSN> lsn_recuperacion;
+    solicitudes.reserve(frames.size());
+    lsn_recuperacion.reserve(frames.size());
+    for (FrameId id_frame : frames) {
+        // Limpiar la marca antes de escribir: una modificación concurrente la repone
+        lsn_recuperacion.push_back(lsn_recuperacion_[id_frame].load());
+        MarcarLimpia(control_frames_[id_frame]);
+        solicitudes.emplace_back(control_frames_[id_frame].id_bloque.load(),
+                                 DatosFrame(id_frame), tamaño_bloque_);
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    Status overall_status = gestor_disco_->EscribirBloques(solicitudes);
+    tiempo_total_io_us_.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - inicio).count());
+
+    for (size_t k = 0; k < solicitudes.size(); ++k) {
+        ControlFrame& control = control_frames_[frames[k]];
+        ActualizarEstadisticas(OperacionBuffer::ESCRITURA_DISCO);
+        if (solicitudes[k].resultado != Status::OK) {
+            std::cerr << "Error al escribir la página sucia " << solicitudes[k].id_bloque << " a disco." << std::endl;
+            MarcarSucia(control);
+            overall_status = Status::ERROR; // Continuar, pero registrar el error
+        } else {
+            LimpiarLSNRecuperacion(frames[k], lsn_recuperacion[k]);
+            escritas++;
+        }
+        control.contador_anclajes.fetch_sub(1);
+    }
+    return overall_status;
+}
+
+// ===== REGISTRO DE ESCRITURA ANTICIPADA =====
+
+Status GestorBuffer::MarcarModificada(BlockId id_bloque, LSN lsn_recuperacion) {
+    FrameId id_frame = INVALID_FRAME_ID;
+    {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        auto it = particion.mapa.find(id_bloque);
+        if (it == particion.mapa.end()) {
+            return Status::NOT_FOUND;
+        }
+        id_frame = it->second;
+    }
+    ControlFrame& control = control_frames_[id_frame];
+    if (!control.esta_sucia.exchange(true)) {
+        paginas_sucias_.fetch_add(1);
+        // Si aún conserva el LSN de una escritura en curso, ese es más antiguo y se mantiene
+        LSN sin_lsn = LSN_INVALIDO;
+        lsn_recuperacion_[id_frame].compare_exchange_strong(sin_lsn, lsn_recuperacion);
+    }
+    // Si ya estaba sucia conserva su LSN: el más antiguo, o ninguno si se ensució sin WAL
+    return Status::OK;
+}
+
+Status GestorBuffer::VolcarParaPuntoControl(LSN limite, LSN& lsn_rehacer) {
+    std::vector<FrameId> frames_lote;
+    for (auto& particion : particiones_) {
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        for (const auto& entrada : particion.mapa) {
+            ControlFrame& control = control_frames_[entrada.second];
+            if (!control.es_valida.load()) continue;
+            LSN lsn_recuperacion = lsn_recuperacion_[entrada.second].load();
+            if (control.esta_sucia.load() && (lsn_recuperacion == LSN_INVALIDO || lsn_recuperacion < limite)) {
+                control.contador_anclajes.fetch_add(1);
+                frames_lote.push_back(entrada.second);
+            } else if (lsn_recuperacion != LSN_INVALIDO) {
+                // Sucia, o limpia con su escritura aún en curso
+                lsn_rehacer = std::min(lsn_rehacer, lsn_recuperacion);
+            }
+        }
+    }
+
+    if (!frames_lote.empty()) {
+        uint32_t escritas = 0;
+        Status estado = EscribirFramesEnLote(frames_lote, escritas);
+        if (estado != Status::OK) {
+            return estado;
+        }
+    }
+    // También las escrituras anteriores del escritor y de los desalojos
+    return gestor_disco_->SincronizarDatos();
+}
+
+LSN GestorBuffer::LSNDeFrame(FrameId id_frame) const {
+    if (tamaño_bloque_ < sizeof(CabeceraComun)) {
+        return LSN_INVALIDO;
+    }
+    const CabeceraComun* cabecera = reinterpret_cast<const CabeceraComun*>(DatosFrame(id_frame));
+    return (cabecera->magic_number == MAGIC_NUMBER_SGBD) ? cabecera->lsn_pagina : LSN_INVALIDO;
+}
+
+PageType GestorBuffer::TipoPaginaDeFrame(FrameId id_frame) const {
+    if (tamaño_bloque_ < sizeof(CabeceraComun)) {
+        return PageType::INVALID_PAGE;
+    }
+    const CabeceraComun* cabecera = reinterpret_cast<const CabeceraComun*>(DatosFrame(id_frame));
+    return (cabecera->magic_number == MAGIC_NUMBER_SGBD) ? cabecera->tipo_pagina : PageType::INVALID_PAGE;
+}
+
+Status GestorBuffer::AsegurarLogDeFrames(const FrameId* frames, size_t numero_frames) {
+    GestorWAL* wal = wal_.load();
+    if (!wal) {
+        return Status::OK;
+    }
+    LSN maximo = LSN_INVALIDO;
+    for (size_t i = 0; i < numero_frames; ++i) {
+        maximo = std::max(maximo, LSNDeFrame(frames[i]));
+    }
+    return (maximo == LSN_INVALIDO) ? Status::OK : wal->AsegurarDuradero(maximo);
+}
+
+void GestorBuffer::LimpiarLSNRecuperacion(FrameId id_frame, LSN lsn_escrito) {
+    if (!control_frames_[id_frame].esta_sucia.load()) {
+        lsn_recuperacion_[id_frame].compare_exchange_strong(lsn_escrito, LSN_INVALIDO);
+    }
+}
+
+// ===== LECTURA ANTICIPADA =====
+
+uint32_t GestorBuffer::ObtenerVentanaEfectiva() const {
+    uint32_t ventana = ventana_lectura_anticipada_.load(std::memory_order_relaxed);
+    return std::min(ventana, std::max<uint32_t>(1, tamaño_pool_ / 4));
+}
+
+void GestorBuffer::DetectarAccesoSecuencial(BlockId id_bloque) {
+    if (!deteccion_secuencial_.load(std::memory_order_relaxed) ||
+        ventana_lectura_anticipada_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    BlockId anterior = ultimo_bloque_anclado_.exchange(id_bloque, std::memory_order_relaxed);
+    if (id_bloque == anterior) {
+        return;
+    }
+    if (anterior == INVALID_PAGE_ID || id_bloque != anterior + 1) {
+        longitud_secuencia_.store(1, std::memory_order_relaxed);
+        limite_precarga_.store(id_bloque, std::memory_order_relaxed);
+        return;
+    }
+    if (longitud_secuencia_.fetch_add(1, std::memory_order_relaxed) + 1 < UMBRAL_ACCESO_SECUENCIAL) {
+        return;
+    }
+
+    uint32_t ventana = ObtenerVentanaEfectiva();
+    BlockId limite = limite_precarga_.load(std::memory_order_relaxed);
+    BlockId hasta = id_bloque + ventana;
+    if (limite > id_bloque + ventana / 2 ||
+        !limite_precarga_.compare_exchange_strong(limite, hasta, std::memory_order_relaxed)) {
+        return; // Aún quedan páginas solicitadas por delante, u otro hilo pidió esta ventana
+    }
+    std::vector<BlockId> a_precargar;
+    for (BlockId b = std::max(id_bloque, limite) + 1; b <= hasta; ++b) {
+        a_precargar.push_back(b);
+    }
+    PrecargarPaginas(std::move(a_precargar));
+}
+
+void GestorBuffer::EjecutarPrecarga(const std::vector<BlockId>& paginas) {
+    // 1. Reservar y publicar un frame por página ausente, con el latch exclusivo tomado
+    std::vector<SolicitudES> solicitudes;
+    std::vector<FrameId> frames;
+    for (BlockId id_bloque : paginas) {
+        if (cerrando_.load()) break;
+        if (!gestor_disco_->ExisteBloque(id_bloque)) continue;
+
+        auto& particion = ObtenerParticion(id_bloque);
+        {
+            std::lock_guard<std::mutex> lock(particion.mutex);
+            if (particion.mapa.count(id_bloque) > 0) continue;
+        }
+
+        // Solo frames libres o víctimas limpias: la precarga nunca paga una escritura
+        FrameId id_frame = INVALID_FRAME_ID;
+        if (ReservarFrame(id_frame, false) != Status::OK) {
+            break;
+        }
+
+        ControlFrame& control = control_frames_[id_frame];
+        bool cargada_por_otro = false;
+        {
+            std::lock_guard<std::mutex> lock(particion.mutex);
+            if (particion.mapa.count(id_bloque) > 0) {
+                cargada_por_otro = true;
+            } else {
+                latches_[id_frame].lock();
+                control.id_bloque.store(id_bloque);
+                control.es_valida.store(false);
+                control.contador_anclajes.store(1); // Anclaje propio mientras dura la lectura
+                particion.mapa[id_bloque] = id_frame;
+            }
+        }
+        if (cargada_por_otro) {
+            LiberarFrame(id_frame);
+            continue;
+        }
+        ReiniciarEstadisticasFrame(id_frame, 0, false);
+
+        solicitudes.emplace_back(id_bloque, DatosFrame(id_frame), tamaño_bloque_);
+        frames.push_back(id_frame);
+    }
+    if (frames.empty()) {
+        return;
+    }
+
+    // 2. Una sola petición por lotes: el GestorDisco ordena y agrupa bloques contiguos
+    auto inicio = std::chrono::steady_clock::now();
+    gestor_disco_->LeerBloques(solicitudes);
+    tiempo_total_io_us_.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - inicio).count());
+
+    // 3. Publicar las páginas leídas con prioridad baja en la política
+    for (size_t k = 0; k < frames.size(); ++k) {
+        ControlFrame& control = control_frames_[frames[k]];
+        ActualizarEstadisticas(OperacionBuffer::LECTURA_DISCO);
+        if (solicitudes[k].resultado != Status::OK) {
+            DescartarCargaFallida(solicitudes[k].id_bloque, frames[k]);
+            continue;
+        }
+        control.precargada.store(true);
+        control.es_valida.store(true);
+        latches_[frames[k]].unlock();
+        {
+            std::lock_guard<std::mutex> lock_politica(mutex_politica_);
+            politica_reemplazo_->AsignarBloque(frames[k], solicitudes[k].id_bloque);
+            politica_reemplazo_->AgregarFrameBajaPrioridad(frames[k]);
+        }
+        control.contador_anclajes.fetch_sub(1);
+        paginas_precargadas_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void GestorBuffer::DescartarCargaFallida(BlockId id_bloque, FrameId id_frame) {
+    ControlFrame& control = control_frames_[id_frame];
+    // Soltar el latch antes de tomar la partición: el orden es partición → latch.
+    // Quien encuentre la entrada mientras tanto la verá no válida y reintentará.
+    control.es_valida.store(false);
+    latches_[id_frame].unlock();
+    {
+        auto& particion = ObtenerParticion(id_bloque);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        auto it = particion.mapa.find(id_bloque);
+        if (it != particion.mapa.end() && it->second == id_frame) {
+            particion.mapa.erase(it);
+        }
+    }
+
+    // Quien encontró la entrada antes de retirarla ya la ancló: esperar a que la suelte
+    while (control.contador_anclajes.load() > 1) {
+        std::this_thread::yield();
+    }
+    LiberarFrame(id_frame);
+}
+
+// ===== ESCRITOR EN SEGUNDO PLANO =====
+
+void GestorBuffer::NotificarEscritorSiNecesario() {
+    if (paginas_sucias_.load(std::memory_order_relaxed) <= umbral_paginas_sucias_alto_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_escritor_);
+        if (!hilo_escritor_.joinable() || escritor_solicitado_) {
+            return;
+        }
+        escritor_solicitado_ = true;
+    }
+    cv_escritor_.notify_one();
+}
+
+void GestorBuffer::IniciarEscritor() {
+    std::lock_guard<std::mutex> lock(mutex_escritor_);
+    if (hilo_escritor_.joinable()) {
+        return;
+    }
+    detener_escritor_ = false;
+    escritor_solicitado_ = false;
+    hilo_escritor_ = std::thread([this]() { BucleEscritor(); });
+}
+
+void GestorBuffer::DetenerEscritor() {
+    std::thread hilo;
+    {
+        std::lock_guard<std::mutex> lock(mutex_escritor_);
+        if (!hilo_escritor_.joinable()) {
+            return;
+        }
+        detener_escritor_ = true;
+        hilo = std::move(hilo_escritor_);
+    }
+    cv_escritor_.notify_one();
+    hilo.join();
+}
+
+void GestorBuffer::BucleEscritor() {
+    std::unique_lock<std::mutex> lock(mutex_escritor_);
+    while (!detener_escritor_) {
+        cv_escritor_.wait_for(lock, std::chrono::milliseconds(config_escritor_.intervalo_ms),
+                              [this]() { return detener_escritor_ || escritor_solicitado_; });
+        if (detener_escritor_) {
+            break;
+        }
+        escritor_solicitado_ = false;
+        ConfiguracionEscritor config = config_escritor_;
+        lock.unlock();
+
+        // Escribir solo el exceso sobre el umbral bajo, como mucho un lote por pasada
+        uint32_t objetivo = static_cast<uint32_t>(config.umbral_sucias_bajo * tamaño_pool_);
+        uint32_t sucias = paginas_sucias_.load();
+        uint32_t escritas = 0;
+        if (sucias > objetivo) {
+            escritas = EscribirLoteSegundoPlano(std::min(sucias - objetivo, config.max_paginas_lote));
+        }
+        bool queda_exceso = escritas > 0 && paginas_sucias_.load() > objetivo;
+
+        lock.lock();
+        if (queda_exceso) {
+            escritor_solicitado_ = true; // Siguiente lote sin esperar el intervalo
+        }
+    }
+}
+
+uint32_t GestorBuffer::EscribirLoteSegundoPlano(uint32_t max_paginas) {
+    // Candidatas: válidas, sucias, no ancladas y sin desalojo en curso (lectura sin bloqueo)
+    std::vector<std::pair<BlockId, FrameId>> candidatas;
+    for (FrameId i = 0; i < tamaño_pool_; ++i) {
+        const ControlFrame& control = control_frames_[i];
+        if (control.es_valida.load() && control.esta_sucia.load() &&
+            control.contador_anclajes.load() == 0 && !control.en_desalojo.load()) {
+            candidatas.emplace_back(control.id_bloque.load(), i);
+        }
+    }
+    if (candidatas.empty()) {
+        return 0;
+    }
+
+    // Barrido en orden de BlockId a partir de donde terminó la pasada anterior
+    std::sort(candidatas.begin(), candidatas.end());
+    auto inicio_barrido = std::lower_bound(candidatas.begin(), candidatas.end(),
+                                           std::make_pair(siguiente_bloque_escritor_, FrameId(0)));
+    std::rotate(candidatas.begin(), inicio_barrido, candidatas.end());
+
+    // Anclar las elegidas revalidando bajo el mutex de su partición y el latch del
+    // frame: una página que alguien ancló desde la lectura sin bloqueo puede estar
+    // modificándose y no se escribe ahora
+    std::vector<FrameId> frames_lote;
+    for (const auto& candidata : candidatas) {
+        if (frames_lote.size() >= max_paginas) break;
+        auto& particion = ObtenerParticion(candidata.first);
+        std::lock_guard<std::mutex> lock(particion.mutex);
+        auto it = particion.mapa.find(candidata.first);
+        if (it == particion.mapa.end() || it->second != candidata.second) continue;
+        std::shared_lock<std::shared_mutex> latch(latches_[candidata.second], std::try_to_lock);
+        if (!latch.owns_lock()) continue; // Carga en curso
+        ControlFrame& control = control_frames_[candidata.second];
+        if (!control.es_valida.load() || !control.esta_sucia.load() || control.en_desalojo.load() ||
+            control.contador_anclajes.load() != 0) {
+            continue;
+        }
+        control.contador_anclajes.fetch_add(1);
+        frames_lote.push_back(candidata.second);
+    }
+    if (frames_lote.empty()) {
+        return 0;
+    }
+    siguiente_bloque_escritor_ = control_frames_[frames_lote.back()].id_bloque.load() + 1;
+
+    uint32_t escritas = 0;
+    EscribirFramesEnLote(frames_lote, escritas);
+    escrituras_segundo_plano_.fetch_add(escritas, std::memory_order_relaxed);
+    return escritas;
+}
+
 Status GestorBuffer::LeerPaginaDesdeDisco(BlockId id_bloque, FrameId id_frame) {
     if (id_frame >= tamaño_pool_) {
         std::cerr << "Error: ID de frame inválido para lectura desde disco: " << id_frame << std::endl;
@@ -516,8 +1272,12 @@ Status GestorBuffer::LeerPaginaDesdeDisco(BlockId id_bloque, FrameId id_frame) {
         return Status::NOT_FOUND;
     }
 
-    ActualizarEstadisticas("lectura_disco");
-    Status read_status = gestor_disco_->LeerBloque(id_bloque, pool_datos_buffer_[id_frame].data(), tamaño_bloque_);
+    ActualizarEstadisticas(OperacionBuffer::LECTURA_DISCO);
+    auto inicio = std::chrono::steady_clock::now();
+    Status read_status = gestor_disco_->LeerBloque(id_bloque, DatosFrame(id_frame), tamaño_bloque_);
+    tiempo_total_io_us_.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - inicio).count());
+
     if (read_status != Status::OK) {
         std::cerr << "Error de E/S: Falló la lectura del bloque " << id_bloque << " desde disco." << std::endl;
         return read_status;
@@ -525,47 +1285,112 @@ Status GestorBuffer::LeerPaginaDesdeDisco(BlockId id_bloque, FrameId id_frame) {
     return Status::OK;
 }
 
+void GestorBuffer::ReservarArena() {
+    const size_t tamaño_arena = paso_frame_ * tamaño_pool_;
+    arena_paginas_enormes_ = false;
+    arena_datos_ = nullptr;
+
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    if (opciones_.usar_paginas_enormes) {
+        const size_t tamaño_mapeo = (tamaño_arena + TAMAÑO_PAGINA_ENORME - 1) & ~(TAMAÑO_PAGINA_ENORME - 1);
+        void* mapeo = mmap(nullptr, tamaño_mapeo, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapeo != MAP_FAILED) {
+            arena_datos_ = static_cast<Byte*>(mapeo);
+            tamaño_mapeo_arena_ = tamaño_mapeo;
+            arena_paginas_enormes_ = true;
+            return; // mmap anónimo ya entrega la memoria a cero
+        }
+        std::cerr << "Advertencia: No hay páginas enormes disponibles; se usan páginas normales." << std::endl;
+    }
+#endif
+
+    void* memoria = nullptr;
+    if (posix_memalign(&memoria, ALINEACION_ARENA, tamaño_arena) != 0) {
+        throw std::bad_alloc();
+    }
+    arena_datos_ = static_cast<Byte*>(memoria);
+    tamaño_mapeo_arena_ = tamaño_arena;
+    std::memset(arena_datos_, 0, tamaño_arena);
+}
+
+void GestorBuffer::LiberarArena() {
+    if (arena_datos_ == nullptr) {
+        return;
+    }
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    if (arena_paginas_enormes_) {
+        munmap(arena_datos_, tamaño_mapeo_arena_);
+        arena_datos_ = nullptr;
+        return;
+    }
+#endif
+    std::free(arena_datos_);
+    arena_datos_ = nullptr;
+}
+
+void GestorBuffer::RegistrarAccesoFrame(FrameId id_frame) {
+    if (!EstadisticasActivas()) return;
+    EstadisticasFrame& estadisticas = estadisticas_frames_[id_frame];
+    estadisticas.contador_accesos.fetch_add(1, std::memory_order_relaxed);
+    estadisticas.timestamp_ultimo_acceso.store(ObtenerTimestampActualMs(), std::memory_order_relaxed);
+}
+
+void GestorBuffer::RegistrarModificacionFrame(FrameId id_frame) {
+    if (!EstadisticasActivas()) return;
+    EstadisticasFrame& estadisticas = estadisticas_frames_[id_frame];
+    estadisticas.contador_modificaciones.fetch_add(1, std::memory_order_relaxed);
+    estadisticas.timestamp_ultima_modificacion.store(ObtenerTimestampActualMs(), std::memory_order_relaxed);
+}
+
+void GestorBuffer::ReiniciarEstadisticasFrame(FrameId id_frame, uint64_t accesos_iniciales, bool modificada) {
+    if (!EstadisticasActivas()) return;
+    EstadisticasFrame& estadisticas = estadisticas_frames_[id_frame];
+    uint64_t ahora = ObtenerTimestampActualMs();
+    estadisticas.contador_accesos.store(accesos_iniciales, std::memory_order_relaxed);
+    estadisticas.contador_modificaciones.store(0, std::memory_order_relaxed);
+    estadisticas.timestamp_ultimo_acceso.store(ahora, std::memory_order_relaxed);
+    estadisticas.timestamp_ultima_modificacion.store(modificada ? ahora : 0, std::memory_order_relaxed);
+}
+
+void GestorBuffer::CopiarInfoPagina(FrameId id_frame, Pagina& pagina_info) const {
+    const ControlFrame& control = control_frames_[id_frame];
+    pagina_info.id_bloque = control.id_bloque.load();
+    pagina_info.id_frame = id_frame;
+    pagina_info.contador_anclajes = static_cast<int>(control.contador_anclajes.load());
+    pagina_info.es_valida = control.es_valida.load();
+    pagina_info.esta_sucia = control.esta_sucia.load();
+    pagina_info.cambios_pendientes = pagina_info.esta_sucia;
+    pagina_info.tipo_pagina = PageType::DATA_PAGE;
+    if (EstadisticasActivas()) {
+        const EstadisticasFrame& estadisticas = estadisticas_frames_[id_frame];
+        pagina_info.contador_accesos = estadisticas.contador_accesos.load(std::memory_order_relaxed);
+        pagina_info.contador_modificaciones = estadisticas.contador_modificaciones.load(std::memory_order_relaxed);
+    } else {
+        pagina_info.contador_accesos = 0;
+        pagina_info.contador_modificaciones = 0;
+    }
+}
+
 bool GestorBuffer::ValidarFrameId(FrameId id_frame) const {
-    return id_frame >= 0 && id_frame < static_cast<FrameId>(frames_.size());
-}
-
-void GestorBuffer::ActualizarEstadisticas(const std::string& tipo_operacion) {
-    if (tipo_operacion == "cache_hit") {
-        estadisticas_.hits_cache++;
-    } else if (tipo_operacion == "cache_miss") {
-        estadisticas_.misses_cache++;
-    } else if (tipo_operacion == "lectura_disco") {
-        estadisticas_.lecturas_disco++;
-    } else if (tipo_operacion == "escritura_disco") {
-        estadisticas_.escrituras_disco++;
-    } else if (tipo_operacion == "desalojo") {
-        estadisticas_.desalojos++;
-    } else if (tipo_operacion == "confirmacion") {
-        estadisticas_.confirmaciones++;
-    } else if (tipo_operacion == "reversion") {
-        estadisticas_.reversiones++;
-    } else if (tipo_operacion == "tiempo_total_espera_pin") {
-        // Simulación de tiempo de espera, en un entorno real se mediría
-        estadisticas_.tiempo_total_espera_pin += 1; // Incremento arbitrario para simulación
-    } else if (tipo_operacion == "tiempo_total_io") {
-        estadisticas_.tiempo_total_io += 10; // Incremento arbitrario para simulación
-    } else if (tipo_operacion == "tiempo_total_procesamiento_politica") {
-        estadisticas_.tiempo_total_procesamiento_politica += 2; // Incremento arbitrario
-    }
-
-    // Actualizar contadores de páginas ancladas y sucias dinámicamente
-    uint64_t current_pinned = 0;
-    uint64_t current_dirty = 0;
-    for (const auto& frame : frames_) {
-        if (frame.es_valida && frame.contador_anclajes > 0) {
-            current_pinned++;
-        }
-        if (frame.es_valida && frame.esta_sucia) {
-            current_dirty++;
-        }
-    }
-    estadisticas_.paginas_ancladas = current_pinned;
-    estadisticas_.paginas_sucias = current_dirty;
+    return id_frame < tamaño_pool_;
+}
+
+void GestorBuffer::ActualizarEstadisticas(OperacionBuffer operacion) {
+    switch (operacion) {
+        case OperacionBuffer::CACHE_HIT:       hits_cache_.fetch_add(1, std::memory_order_relaxed); break;
+        case OperacionBuffer::CACHE_MISS:      misses_cache_.fetch_add(1, std::memory_order_relaxed); break;
+        case OperacionBuffer::LECTURA_DISCO:   lecturas_disco_.fetch_add(1, std::memory_order_relaxed); break;
+        case OperacionBuffer::ESCRITURA_DISCO: escrituras_disco_.fetch_add(1, std::memory_order_relaxed); break;
+        case OperacionBuffer::DESALOJO:        desalojos_.fetch_add(1, std::memory_order_relaxed); break;
+        case OperacionBuffer::DESALOJO_SUCIO:  desalojos_sucios_.fetch_add(1, std::memory_order_relaxed); break;
+    }
+}
+
+uint64_t GestorBuffer::ObtenerTimestampActualMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
 }
 
 std::string GestorBuffer::ObtenerTimestampActualString() const {
@@ -9,6 +9,10 @@
 #include "../replacement_policies/ipolitica_reemplazo.h" // Para la interfaz de política de reemplazo
 #include "../replacement_policies/lru_espanol.h"         // Para PoliticaLRU
 #include "../replacement_policies/clock_espanol.h"       // Para PoliticaClock
+#include "../replacement_policies/clock_atomico_espanol.h" // Para PoliticaClockAtomico
+#include "../replacement_policies/dos_colas_espanol.h"   // Para PoliticaDosColas
+#include "../include/pool_hilos.h"                       // Para la lectura anticipada asíncrona
+#include "../include/metricas.h"                         // Para los histogramas de latencia por tipo de página
 
 #include <vector>                        // Para std::vector
 #include <unordered_map>                 // Para mapear PageId a FrameId
@@ -16,11 +20,20 @@
 #include <optional>                      // Para std::optional
 #include <chrono>                        // Para timestamps
 #include <mutex>                         // Para std::mutex
+#include <shared_mutex>                  // Para el latch por frame
+#include <atomic>                        // Para contadores de anclaje y estadísticas
+#include <array>                         // Para las particiones de la tabla de páginas
+#include <thread>                        // Para el escritor en segundo plano
+#include <condition_variable>            // Para despertar al escritor en segundo plano
 
 // Aliases para compatibilidad con main.cpp - MOVED AFTER INCLUDES
 using IReplacementPolicy = IPoliticaReemplazo;
 using LRUReplacementPolicy = PoliticaLRU;
 using ClockReplacementPolicy = PoliticaClock;
+using LockFreeClockReplacementPolicy = PoliticaClockAtomico;
+using TwoQueueReplacementPolicy = PoliticaDosColas;
+
+class GestorWAL;
 
 /**
  * @brief Gestor del Buffer Pool - Maneja páginas (copias de bloques) en memoria
@@ -39,11 +52,50 @@ using ClockReplacementPolicy = PoliticaClock;
  * - Proporcionar acceso a los datos de las páginas
  *
  * ESTRUCTURA INTERNA:
- * - `pool_datos_buffer_`: Vector de vectores de bytes (o char arrays) que representan los frames físicos.
- * - `frames_`: Vector de estructuras `Pagina` que contienen los metadatos de cada frame.
- * - `tabla_paginas_`: Un `unordered_map` que mapea `PageId` (ID de bloque en disco) a `FrameId` (ID de frame en buffer).
+ * - `arena_datos_`: Una sola reserva contigua, alineada a 4096 bytes, con todos los frames.
+ *   El frame f empieza en `arena_datos_ + f * paso_frame_` (paso redondeado a 64 bytes).
+ *   Con tamaños de bloque múltiplos de 4096 cada frame queda alineado para O_DIRECT.
+ * - `control_frames_`: Metadatos calientes de cada frame (16 bytes: anclajes, bloque y banderas).
+ * - `latches_`: Latch de carga de cada frame, fuera de los metadatos calientes.
+ * - `estadisticas_frames_`: Contadores y timestamps por frame, opcionales (OpcionesPool).
+ * - `frames_libres_`: Pila de frames libres; reservar y liberar un frame es O(1).
+ * - `particiones_`: Tabla de páginas (PageId → FrameId) repartida en particiones con su propio mutex.
  * - `politica_reemplazo_`: Puntero a la política de reemplazo activa.
  * - `gestor_disco_`: Puntero al gestor de disco para operaciones de E/S.
+ *
+ * CONCURRENCIA:
+ * - Un acierto solo toma el mutex de la partición del bloque y un incremento atómico;
+ *   el latch del frame solo se consulta si la página aún se está cargando.
+ * - La política de reemplazo se protege con `mutex_politica_`. Si la política declara
+ *   EsSeguraEntreHilos() (CLOCK atómico), los aciertos la actualizan sin ese mutex.
+ * - Ningún mutex se mantiene durante la E/S de disco. Mientras una página se carga,
+ *   el latch del frame está en modo exclusivo y los demás hilos que la piden esperan
+ *   en modo compartido solo sobre ese frame.
+ * - Orden de adquisición: mutex_politica_ → mutex de partición → latch de frame.
+ * - El contenido de una página anclada lo protege el llamador.
+ *
+ * ESCRITOR EN SEGUNDO PLANO:
+ * - Un hilo propio escribe páginas sucias no ancladas, en orden de BlockId y por lotes,
+ *   para mantener una reserva de frames limpios. Así un fallo de caché normalmente
+ *   solo cuesta una lectura: el desalojo prefiere víctimas limpias y solo escribe de
+ *   forma síncrona si no encuentra ninguna.
+ *
+ * LECTURA ANTICIPADA:
+ * - Un recorrido puede declarar la lista de páginas que va a visitar
+ *   (DeclararLecturaSecuencial); además se detectan accesos a BlockIds consecutivos.
+ * - En ambos casos las páginas N+1..N+k se leen en segundo plano, en un lote, y
+ *   entran en la política con prioridad baja para no expulsar al conjunto de trabajo.
+ * - Ningún mutex en el camino de anclaje: el estado de una secuencia declarada lo
+ *   guarda el propio recorrido, y el detector (atómico) solo mira los fallos y el
+ *   primer anclaje de una página precargada; un acierto normal no lo toca.
+ *
+ * REGISTRO DE ESCRITURA ANTICIPADA:
+ * - Con un GestorWAL asociado, antes de escribir una página se espera a que el log
+ *   sea duradero hasta el lsn_pagina de su cabecera.
+ * - Cada frame guarda su LSN de recuperación: la posición del log desde la que hay
+ *   que rehacer para reconstruirlo. Se fija con MarcarModificada() y se borra cuando
+ *   la escritura termina; las páginas ensuciadas sin él (catálogo, índices) quedan
+ *   sin LSN y las escribe el siguiente punto de control.
  */
 class GestorBuffer {
 public:
@@ -64,12 +116,45 @@ public:
         uint64_t tiempo_total_io;   // Tiempo total gastado en operaciones de E/S
         uint64_t tiempo_total_procesamiento_politica; // Tiempo en política de reemplazo
         uint64_t ult_timestamp_reset; // Último timestamp de reseteo de estadísticas
+        uint64_t escrituras_segundo_plano; // Páginas escritas por el escritor en segundo plano
+        uint64_t desalojos_sucios;  // Desalojos que tuvieron que escribir la víctima de forma síncrona
+        uint64_t paginas_precargadas; // Páginas traídas por lectura anticipada
+        uint64_t aciertos_precarga; // Precargadas que luego se anclaron (lectura ahorrada)
 
         BufferStats()
             : hits_cache(0), misses_cache(0), lecturas_disco(0), escrituras_disco(0),
               desalojos(0), confirmaciones(0), reversiones(0), paginas_ancladas(0),
               paginas_sucias(0), tiempo_total_espera_pin(0), tiempo_total_io(0),
-              tiempo_total_procesamiento_politica(0), ult_timestamp_reset(0) {}
+              tiempo_total_procesamiento_politica(0), ult_timestamp_reset(0),
+              escrituras_segundo_plano(0), desalojos_sucios(0),
+              paginas_precargadas(0), aciertos_precarga(0) {}
+    };
+
+    /**
+     * @brief Parámetros del escritor de páginas sucias en segundo plano.
+     * Las proporciones se expresan sobre el tamaño total del pool.
+     */
+    struct ConfiguracionEscritor {
+        bool activo;                  // Si es false no se lanza el hilo
+        double umbral_sucias_alto;    // Por encima, los fallos de caché despiertan al escritor
+        double umbral_sucias_bajo;    // El escritor escribe hasta bajar de esta proporción
+        uint32_t intervalo_ms;        // Periodo entre pasadas del escritor
+        uint32_t max_paginas_lote;    // Máximo de páginas escritas por pasada
+
+        ConfiguracionEscritor()
+            : activo(true), umbral_sucias_alto(0.40), umbral_sucias_bajo(0.10),
+              intervalo_ms(100), max_paginas_lote(64) {}
+    };
+
+    /**
+     * @brief Opciones de la reserva de memoria del pool, fijadas al construirlo.
+     */
+    struct OpcionesPool {
+        bool usar_paginas_enormes;    // Intentar mmap con MAP_HUGETLB (solo Linux); si falla, páginas normales
+        bool estadisticas_por_frame;  // Mantener contadores y timestamps de cada frame
+
+        OpcionesPool()
+            : usar_paginas_enormes(false), estadisticas_por_frame(true) {}
     };
 
     /**
@@ -78,11 +163,13 @@ public:
      * @param tamano_pool Tamaño del pool de buffer en número de frames
      * @param tamano_bloque Tamaño de cada bloque/página en bytes
      * @param politica_reemplazo Política de reemplazo a utilizar (LRU, CLOCK, etc.)
+     * @param opciones Opciones de memoria del pool (páginas enormes, estadísticas por frame)
      */
     GestorBuffer(std::shared_ptr<GestorDisco> gestor_disco,
                  uint32_t tamano_pool,
                  BlockSizeType tamano_bloque,
-                 std::unique_ptr<IReplacementPolicy> politica_reemplazo);
+                 std::unique_ptr<IReplacementPolicy> politica_reemplazo,
+                 const OpcionesPool& opciones = OpcionesPool());
 
     /**
      * @brief Destructor del GestorBuffer
@@ -102,6 +189,15 @@ public:
      */
     Status PinPage(BlockId id_bloque, Pagina& pagina_info);
 
+    /**
+     * @brief Ancla una página y devuelve directamente el puntero a sus datos.
+     * Evita la segunda búsqueda de GetPageData() tras PinPage().
+     * @param id_bloque ID del bloque a anclar
+     * @param datos_pagina [out] Puntero a los datos del frame (válido hasta UnpinPage)
+     * @return Status de la operación
+     */
+    Status PinPage(BlockId id_bloque, Byte*& datos_pagina);
+
     /**
      * @brief Desancla una página del buffer pool.
      * Decrementa el contador de anclajes de la página.
@@ -126,6 +222,33 @@ public:
      */
     Status NewPage(BlockId& id_bloque, Pagina& pagina_info);
 
+    /**
+     * @brief Crea una nueva página anclada y devuelve el puntero a sus datos.
+     * @param id_bloque ID del nuevo bloque (salida)
+     * @param datos_pagina [out] Puntero a los datos del frame (inicializados a cero)
+     * @return Status de la operación
+     */
+    Status NewPage(BlockId& id_bloque, Byte*& datos_pagina);
+
+    /**
+     * @brief Reserva en disco una extensión de páginas de datos contiguas, sin cargarlas.
+     * Cada página se trae al buffer con NewPageInExtent() cuando se va a usar.
+     * @param paginas_deseadas Longitud pedida; puede obtenerse menos si el disco está fragmentado
+     * @param primer_bloque [out] Primer bloque de la extensión
+     * @param paginas_reservadas [out] Longitud obtenida
+     * @return Status::DISK_FULL si no queda ni un bloque libre
+     */
+    Status ReservarExtension(uint32_t paginas_deseadas, BlockId& primer_bloque, uint32_t& paginas_reservadas);
+
+    /**
+     * @brief Como NewPage(), pero sobre un bloque ya asignado con ReservarExtension().
+     * Si falla, el bloque sigue asignado a la extensión.
+     * @param id_bloque Bloque reservado que todavía no está en el buffer
+     * @param datos_pagina [out] Puntero a los datos del frame (inicializados a cero)
+     * @return Status::DUPLICATE_ENTRY si el bloque ya está en el buffer
+     */
+    Status NewPageInExtent(BlockId id_bloque, Byte*& datos_pagina);
+
     /**
      * @brief Elimina una página del buffer pool y del disco.
      * @param id_bloque ID del bloque a eliminar
@@ -133,6 +256,16 @@ public:
      */
     Status DeletePage(BlockId id_bloque);
 
+    /**
+     * @brief Saca del buffer pool una página limpia sin tocar el disco.
+     * Para bloques que se escriben directamente en el disco (catálogo) y que la
+     * recuperación ha tenido que anclar: así la copia en memoria no queda obsoleta.
+     * @param id_bloque ID del bloque a descartar
+     * @return Status::OK también si no estaba en el buffer; PAGE_PINNED o
+     *         RESOURCE_BUSY si está anclada, sucia o en desalojo
+     */
+    Status DescartarPagina(BlockId id_bloque);
+
     /**
      * @brief Fuerza la escritura de una página específica a disco, si está sucia.
      * @param id_bloque ID del bloque a escribir
@@ -146,6 +279,78 @@ public:
      */
     Status FlushAllPages();
 
+    /**
+     * @brief Cambia la configuración del escritor en segundo plano.
+     * Arranca o detiene el hilo según config.activo.
+     * @param config Nueva configuración
+     * @return Status::INVALID_ARGUMENT si los umbrales no son coherentes
+     */
+    Status ConfigurarEscritorSegundoPlano(const ConfiguracionEscritor& config);
+
+    /**
+     * @brief Obtiene la configuración actual del escritor en segundo plano.
+     */
+    ConfiguracionEscritor ObtenerConfiguracionEscritor() const;
+
+    /**
+     * @brief Declara las páginas que un recorrido va a visitar, en orden, y precarga
+     *        de inmediato la primera ventana.
+     * El buffer no guarda la secuencia: el recorrido conserva el límite devuelto y lo
+     * pasa a AvanzarLecturaSecuencial(), así que varios recorridos simultáneos no se
+     * pisan ni comparten ningún mutex.
+     * @param paginas Páginas en el orden en que se van a anclar
+     * @return Límite de la secuencia: las posiciones [0, límite) ya están solicitadas
+     */
+    size_t DeclararLecturaSecuencial(const std::vector<BlockId>& paginas);
+
+    /**
+     * @brief Avisa de que el recorrido va a anclar paginas[posicion]; solicita la
+     *        siguiente ventana al consumir la mitad de la anterior.
+     * @param paginas Las mismas páginas pasadas a DeclararLecturaSecuencial()
+     * @param posicion Posición que se va a anclar
+     * @param limite [in/out] Límite de la secuencia, propiedad del recorrido
+     */
+    void AvanzarLecturaSecuencial(const std::vector<BlockId>& paginas, size_t posicion, size_t& limite);
+
+    /**
+     * @brief Solicita la precarga asíncrona de un conjunto de páginas.
+     * Las páginas ya presentes o inexistentes se ignoran; nunca se desaloja una
+     * página sucia ni anclada para hacer sitio.
+     * @param paginas Páginas a precargar
+     */
+    void PrecargarPaginas(std::vector<BlockId> paginas);
+
+    /**
+     * @brief Configura la lectura anticipada.
+     * @param ventana_paginas Páginas a leer por delante (0 la desactiva; se limita a 1/4 del pool)
+     * @param deteccion_secuencial Detectar anclajes de BlockIds consecutivos
+     */
+    void ConfigurarLecturaAnticipada(uint32_t ventana_paginas, bool deteccion_secuencial);
+
+    /**
+     * @brief Asocia el WAL cuyo log debe ser duradero antes de escribir una página.
+     * El WAL debe vivir más que el GestorBuffer (el destructor escribe las páginas sucias).
+     */
+    void EstablecerWAL(GestorWAL* wal) { wal_.store(wal); }
+
+    /**
+     * @brief Marca sucia una página anclada que va a recibir un registro del WAL.
+     * Si estaba limpia, su LSN de recuperación pasa a ser lsn_recuperacion.
+     * @param lsn_recuperacion Posición del log antes de añadir el registro (GestorWAL::LSNFinal())
+     * @return NOT_FOUND si la página no está en el buffer
+     */
+    Status MarcarModificada(BlockId id_bloque, LSN lsn_recuperacion);
+
+    /**
+     * @brief Parte del punto de control que toca al buffer.
+     * Escribe las páginas sucias sin LSN de recuperación o con uno anterior a limite,
+     * sincroniza el disco y reduce lsn_rehacer al menor LSN de recuperación restante.
+     * @param limite Inicio del punto de control anterior
+     * @param lsn_rehacer [in/out] Fin del log al empezar; sale con el punto de rehacer
+     * @return Status de la operación
+     */
+    Status VolcarParaPuntoControl(LSN limite, LSN& lsn_rehacer);
+
     /**
      * @brief Obtiene el número de frames disponibles en el buffer pool.
      * @return Número de frames libres.
@@ -181,39 +386,250 @@ public:
     Status ValidarConsistencia() const;
 
 private:
+    // === ESTRUCTURAS INTERNAS ===
+
+    /**
+     * @brief Metadatos calientes de un frame, accesibles sin mutex global.
+     * Caben cuatro por línea de caché; el latch y las estadísticas van aparte.
+     */
+    struct alignas(16) ControlFrame {
+        std::atomic<uint32_t> contador_anclajes{0};
+        std::atomic<bool> en_uso{false};             // Asignado a un bloque o reservado para una carga
+        std::atomic<bool> es_valida{false};          // Contiene una copia válida del bloque
+        std::atomic<bool> esta_sucia{false};
+        std::atomic<bool> en_desalojo{false};        // Seleccionado como víctima, escritura en curso
+        std::atomic<bool> precargada{false};         // Traída por lectura anticipada y aún no anclada
+        std::atomic<BlockId> id_bloque{INVALID_PAGE_ID};
+    };
+
+    /**
+     * @brief Contadores y timestamps de un frame (solo informativos).
+     */
+    struct EstadisticasFrame {
+        std::atomic<uint64_t> contador_accesos{0};
+        std::atomic<uint64_t> contador_modificaciones{0};
+        std::atomic<uint64_t> timestamp_ultimo_acceso{0};
+        std::atomic<uint64_t> timestamp_ultima_modificacion{0};
+    };
+
+    /**
+     * @brief Una partición de la tabla de páginas.
+     */
+    struct ParticionTabla {
+        mutable std::mutex mutex;
+        std::unordered_map<PageId, FrameId> mapa;
+    };
+
+    /**
+     * @brief Operaciones contabilizadas en las estadísticas.
+     */
+    enum class OperacionBuffer {
+        CACHE_HIT,
+        CACHE_MISS,
+        LECTURA_DISCO,
+        ESCRITURA_DISCO,
+        DESALOJO,
+        DESALOJO_SUCIO
+    };
+
+    static constexpr uint32_t NUM_PARTICIONES_TABLA = 16;
+    static constexpr uint32_t MAX_VICTIMAS_SUCIAS_OMITIDAS = 8; // Antes de escribir una víctima en el fallo
+    static constexpr uint32_t UMBRAL_ACCESO_SECUENCIAL = 4;     // Anclajes consecutivos para activar la precarga
+    static constexpr uint32_t HILOS_LECTURA_ANTICIPADA = 2;
+    static constexpr size_t ALINEACION_ARENA = 4096;              // Alineación de la arena de datos
+    static constexpr size_t TAMAÑO_LINEA_CACHE = 64;              // Paso mínimo entre frames
+    static constexpr size_t TAMAÑO_PAGINA_ENORME = 2 * 1024 * 1024;
+
     // === MIEMBROS PRIVADOS ===
     std::shared_ptr<GestorDisco> gestor_disco_;              // Gestor de disco
     uint32_t tamaño_pool_;                                   // Tamaño del pool de buffer (número de frames)
     BlockSizeType tamaño_bloque_;                            // Tamaño de cada bloque/página
+    OpcionesPool opciones_;                                  // Opciones de memoria del pool
     std::unique_ptr<IReplacementPolicy> politica_reemplazo_; // Política de reemplazo
-    std::mutex mutex_buffer_;                                // Mutex para proteger el acceso concurrente al buffer
+    mutable std::mutex mutex_politica_;                      // Protege la política y la búsqueda de frames libres
+    bool politica_segura_entre_hilos_ = false;               // Acceder() sin mutex_politica_
+
+    Byte* arena_datos_ = nullptr;                            // Datos físicos de todos los frames
+    size_t paso_frame_ = 0;                                  // Bytes entre el inicio de dos frames
+    size_t tamaño_mapeo_arena_ = 0;                          // Bytes reservados para la arena
+    bool arena_paginas_enormes_ = false;                     // La arena viene de mmap(MAP_HUGETLB)
+    std::unique_ptr<ControlFrame[]> control_frames_;         // Metadatos calientes de cada frame
+    std::unique_ptr<std::shared_mutex[]> latches_;           // Exclusivo mientras se carga la página
+    std::unique_ptr<EstadisticasFrame[]> estadisticas_frames_; // Nulo si estadisticas_por_frame == false
+    std::unique_ptr<std::atomic<LSN>[]> lsn_recuperacion_;   // LSN_INVALIDO = sin registro en el WAL
+    std::vector<FrameId> frames_libres_;                     // Pila de frames libres (mutex_politica_)
+    std::array<ParticionTabla, NUM_PARTICIONES_TABLA> particiones_; // Tabla de páginas particionada
+
+    // Contadores de estadísticas (atómicos: GetStats no bloquea el pool)
+    std::atomic<uint64_t> hits_cache_{0};
+    std::atomic<uint64_t> misses_cache_{0};
+    std::atomic<uint64_t> lecturas_disco_{0};
+    std::atomic<uint64_t> escrituras_disco_{0};
+    std::atomic<uint64_t> desalojos_{0};
+    std::atomic<uint64_t> tiempo_total_io_us_{0};
+    std::atomic<uint64_t> ult_timestamp_reset_{0};
+    std::atomic<uint64_t> escrituras_segundo_plano_{0};
+    std::atomic<uint64_t> desalojos_sucios_{0};
+    std::atomic<uint32_t> paginas_sucias_{0};                // Frames con esta_sucia == true
+    std::atomic<uint32_t> umbral_paginas_sucias_alto_{0};    // umbral_sucias_alto * tamaño_pool_
+    std::atomic<GestorWAL*> wal_{nullptr};
+
+    // Escritor de páginas sucias en segundo plano
+    ConfiguracionEscritor config_escritor_;                  // Protegida por mutex_escritor_
+    mutable std::mutex mutex_escritor_;
+    std::condition_variable cv_escritor_;
+    std::thread hilo_escritor_;
+    bool detener_escritor_ = false;                          // Protegida por mutex_escritor_
+    bool escritor_solicitado_ = false;                       // Un fallo de caché pidió una pasada
+    BlockId siguiente_bloque_escritor_ = 0;                  // Solo lo usa el hilo escritor
+
+    // Lectura anticipada
+    std::atomic<uint32_t> ventana_lectura_anticipada_{8};
+    std::atomic<bool> deteccion_secuencial_{true};
+    std::atomic<bool> cerrando_{false};                      // El destructor descarta precargas pendientes
+    std::atomic<uint64_t> paginas_precargadas_{0};
+    std::atomic<uint64_t> aciertos_precarga_{0};
+    // Detector de BlockIds consecutivos (heurístico: las carreras solo cambian cuándo se precarga)
+    std::atomic<BlockId> ultimo_bloque_anclado_{INVALID_PAGE_ID};
+    std::atomic<uint32_t> longitud_secuencia_{0};
+    std::atomic<BlockId> limite_precarga_{0};                // Último BlockId ya solicitado por el detector
+    std::unique_ptr<PoolHilos> pool_lectura_anticipada_;
+    std::once_flag inicializacion_pool_lectura_;
+
+    // === MÉTODOS AUXILIARES PRIVADOS ===
 
-    std::vector<std::vector<Byte>> pool_datos_buffer_;       // Pool de datos físicos (frames)
-    std::vector<Pagina> frames_;                             // Metadatos de cada frame en el pool
-    std::unordered_map<PageId, FrameId> tabla_paginas_;      // Mapeo de PageId a FrameId
+    ParticionTabla& ObtenerParticion(BlockId id_bloque) {
+        return particiones_[id_bloque % NUM_PARTICIONES_TABLA];
+    }
 
-    BufferStats estadisticas_;                               // Estadísticas del buffer
+    // Cambian la marca de sucio manteniendo el contador paginas_sucias_
+    void MarcarSucia(ControlFrame& control) {
+        if (!control.esta_sucia.exchange(true)) paginas_sucias_.fetch_add(1);
+    }
+    void MarcarLimpia(ControlFrame& control) {
+        if (control.esta_sucia.exchange(false)) paginas_sucias_.fetch_sub(1);
+    }
 
-    // === MÉTODOS AUXILIARES PRIVADOS ===
+    /**
+     * @brief Reserva un frame para una nueva página: uno libre o uno desalojado.
+     * @param id_frame [out] Frame reservado (en_uso = true, sin entrada en la tabla)
+     * @param permitir_escritura Si es false nunca se desaloja una página sucia
+     * @return Status de la operación
+     */
+    Status ReservarFrame(FrameId& id_frame, bool permitir_escritura = true);
 
     /**
-     * @brief Encuentra un frame libre en el buffer pool
-     * @return FrameId del frame libre, o -1 si no hay frames libres
+     * @brief Devuelve al conjunto de libres un frame reservado que no llegó a usarse.
+     * Toma mutex_politica_: no debe llamarse con el mutex de una partición tomado.
+     * @param id_frame Frame a liberar
+     */
+    void LiberarFrame(FrameId id_frame);
+
+    /**
+     * @brief Encuentra un frame libre en el buffer pool. Requiere mutex_politica_.
+     * @return FrameId del frame libre, o INVALID_FRAME_ID si no hay frames libres
      */
     FrameId EncontrarFrameLibre();
 
     /**
-     * @brief Desaloja una página del buffer pool usando la política de reemplazo
+     * @brief Desaloja una página del buffer pool usando la política de reemplazo.
+     * La escritura de una víctima sucia se hace sin mantener ningún mutex.
+     * @param id_frame [out] Frame liberado, reservado para el llamador
+     * @param permitir_escritura Si es false solo se aceptan víctimas limpias
      * @return Status de la operación
      */
-    Status DesalojarPagina();
+    Status DesalojarPagina(FrameId& id_frame, bool permitir_escritura = true);
 
     /**
-     * @brief Escribe una página específica al disco
-     * @param id_bloque ID del bloque a escribir
+     * @brief Deshace la publicación de un frame cuya carga falló.
+     * Retira la entrada de la tabla, suelta el latch exclusivo y espera a que los
+     * hilos que la encontraron suelten su anclaje antes de liberar el frame.
+     */
+    void DescartarCargaFallida(BlockId id_bloque, FrameId id_frame);
+
+    /**
+     * @brief Actualiza el detector de acceso secuencial y encola la siguiente ventana
+     *        de precarga si corresponde. Solo se llama en un fallo de caché o en el
+     *        primer anclaje de una página precargada; no toma ningún mutex.
+     */
+    void DetectarAccesoSecuencial(BlockId id_bloque);
+
+    /**
+     * @brief Lee en un lote las páginas indicadas (ejecutado en el pool de lectura anticipada).
+     */
+    void EjecutarPrecarga(const std::vector<BlockId>& paginas);
+
+    /**
+     * @brief Ventana efectiva de lectura anticipada (limitada a 1/4 del pool).
+     */
+    uint32_t ObtenerVentanaEfectiva() const;
+
+    /**
+     * @brief lsn_pagina de la cabecera del frame, o LSN_INVALIDO si no es una página del SGBD.
+     */
+    LSN LSNDeFrame(FrameId id_frame) const;
+
+    /**
+     * @brief tipo_pagina de la cabecera del frame (etiqueta de las métricas de latencia).
+     */
+    PageType TipoPaginaDeFrame(FrameId id_frame) const;
+
+    /**
+     * @brief Regla WAL: espera a que el log cubra el mayor lsn_pagina de los frames.
+     */
+    Status AsegurarLogDeFrames(const FrameId* frames, size_t numero_frames);
+
+    /**
+     * @brief Borra el LSN de recuperación tras escribir el frame, salvo que se haya
+     *        vuelto a ensuciar o a marcar mientras tanto.
+     */
+    void LimpiarLSNRecuperacion(FrameId id_frame, LSN lsn_escrito);
+
+    /**
+     * @brief Escribe a disco el contenido de un frame. El llamador debe garantizar
+     *        que el frame no se reutiliza (anclado o marcado en_desalojo).
+     * @param id_frame Frame a escribir
      * @return Status de la operación
      */
-    Status EscribirPaginaADisco(BlockId id_bloque);
+    Status EscribirFrameADisco(FrameId id_frame);
+
+    /**
+     * @brief Escribe en un solo lote los frames dados, que el llamador ya ha anclado.
+     * Limpia la marca de sucio antes de escribir y la repone si la escritura falla.
+     * Los frames se desanclan al terminar.
+     * @param frames Frames anclados a escribir (se ordenan por BlockId)
+     * @param escritas [out] Número de páginas escritas con éxito
+     * @return Status::OK si todas las escrituras tuvieron éxito
+     */
+    Status EscribirFramesEnLote(std::vector<FrameId>& frames, uint32_t& escritas);
+
+    /**
+     * @brief Despierta al escritor si la proporción de páginas sucias supera el umbral alto.
+     */
+    void NotificarEscritorSiNecesario();
+
+    /**
+     * @brief Arranca el hilo escritor (si no está en marcha).
+     */
+    void IniciarEscritor();
+
+    /**
+     * @brief Detiene el hilo escritor y espera a que termine.
+     */
+    void DetenerEscritor();
+
+    /**
+     * @brief Bucle del hilo escritor: cada intervalo, o al ser despertado, escribe lotes
+     *        de páginas sucias no ancladas hasta bajar del umbral bajo.
+     */
+    void BucleEscritor();
+
+    /**
+     * @brief Una pasada del escritor: ancla y escribe hasta max_paginas páginas sucias.
+     * @param max_paginas Máximo de páginas a escribir
+     * @return Número de páginas escritas
+     */
+    uint32_t EscribirLoteSegundoPlano(uint32_t max_paginas);
 
     /**
      * @brief Lee una página del disco y la carga en un frame específico
@@ -223,6 +639,38 @@ private:
      */
     Status LeerPaginaDesdeDisco(BlockId id_bloque, FrameId id_frame);
 
+    /**
+     * @brief Puntero a los datos de un frame dentro de la arena.
+     */
+    Byte* DatosFrame(FrameId id_frame) const {
+        return arena_datos_ + static_cast<size_t>(id_frame) * paso_frame_;
+    }
+
+    /**
+     * @brief Reserva la arena de datos (páginas enormes si se pidieron y hay disponibles).
+     * Lanza std::bad_alloc si no se puede reservar.
+     */
+    void ReservarArena();
+
+    /**
+     * @brief Devuelve la arena con el mismo mecanismo con que se reservó.
+     */
+    void LiberarArena();
+
+    bool EstadisticasActivas() const { return estadisticas_frames_ != nullptr; }
+
+    /**
+     * @brief Actualizan la tabla de estadísticas por frame; no hacen nada si está desactivada.
+     */
+    void RegistrarAccesoFrame(FrameId id_frame);
+    void RegistrarModificacionFrame(FrameId id_frame);
+    void ReiniciarEstadisticasFrame(FrameId id_frame, uint64_t accesos_iniciales, bool modificada);
+
+    /**
+     * @brief Rellena una estructura Pagina con el estado actual de un frame.
+     */
+    void CopiarInfoPagina(FrameId id_frame, Pagina& pagina_info) const;
+
     /**
      * @brief Valida que un frame ID sea válido
      * @param id_frame ID del frame a validar
@@ -232,9 +680,14 @@ private:
 
     /**
      * @brief Actualiza las estadísticas del buffer
-     * @param tipo_operacion Tipo de operación realizada
+     * @param operacion Operación realizada
+     */
+    void ActualizarEstadisticas(OperacionBuffer operacion);
+
+    /**
+     * @brief Obtiene timestamp actual en milisegundos
      */
-    void ActualizarEstadisticas(const std::string& tipo_operacion);
+    static uint64_t ObtenerTimestampActualMs();
 
     /**
      * @brief Obtiene timestamp actual para logging
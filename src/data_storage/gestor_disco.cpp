@@ -8,10 +8,12 @@
 #include <cstdint>
 #include <vector>
 #include <map>
+#include <algorithm>
 #include <string>
 #include <chrono>
 #include <iomanip>
 #include <cstdlib>
+#include <cstdio>
 #include <cerrno>
 #include <sys/stat.h>
 
@@ -148,6 +150,80 @@ std::string UnirRutas(const std::string& base, const std::string& nombre) {
     }
 }
 
+// ============================================
+// Instantánea binaria de metadatos
+// ============================================
+
+namespace {
+
+constexpr uint32_t MAGIC_METADATOS_DISCO = 0x4D444442; // "BDDM" en ASCII
+constexpr uint32_t VERSION_METADATOS_DISCO = 1;
+constexpr uint32_t MAGIC_ACCESOS_BLOQUES = 0x41444442; // "BDDA" en ASCII
+
+/**
+ * @brief Contenido completo de metadatos.bin. Se reescribe entero (archivo
+ *        temporal + rename) en cada guardado, así que nunca queda a medias.
+ */
+struct InstantaneaMetadatosDisco {
+    uint32_t magic_number;
+    uint32_t version;
+    uint32_t num_platos;
+    uint32_t num_superficies_por_plato;
+    uint32_t num_pistas;
+    uint32_t sectores_por_pista;
+    uint32_t tamaño_sector;
+    uint32_t siguiente_id_bloque;
+    uint64_t bloques_por_segmento;
+    uint8_t modo_almacenamiento;    // ModoAlmacenamiento
+    uint8_t relleno[7];
+    char nombre_disco[64];
+    char fecha_creacion[32];
+    char ultima_modificacion[32];
+};
+
+/**
+ * @brief Entrada de accesos_bloques.bin, tras una cabecera {magic, número de entradas}.
+ */
+struct EntradaAccesoBloque {
+    uint32_t id_bloque;
+    uint32_t relleno;
+    uint64_t timestamp;
+};
+
+void CopiarCadenaFija(char* destino, size_t capacidad, const std::string& origen) {
+    size_t longitud = std::min(origen.size(), capacidad - 1);
+    std::memcpy(destino, origen.data(), longitud);
+    std::memset(destino + longitud, 0, capacidad - longitud);
+}
+
+std::string LeerCadenaFija(const char* origen, size_t capacidad) {
+    return std::string(origen, strnlen(origen, capacidad));
+}
+
+/**
+ * @brief Escribe un archivo binario completo a través de un temporal y lo renombra.
+ */
+Status EscribirArchivoAtomico(const std::string& ruta, const void* datos, size_t longitud) {
+    std::string ruta_temporal = ruta + ".tmp";
+    std::ofstream archivo(ruta_temporal, std::ios::binary | std::ios::trunc);
+    if (!archivo.is_open()) {
+        std::cerr << "Error: No se pudo abrir " << ruta_temporal << " para escritura" << std::endl;
+        return Status::IO_ERROR;
+    }
+    archivo.write(static_cast<const char*>(datos), static_cast<std::streamsize>(longitud));
+    archivo.close();
+    if (!archivo) {
+        return Status::IO_ERROR;
+    }
+    if (std::rename(ruta_temporal.c_str(), ruta.c_str()) != 0) {
+        std::cerr << "Error: No se pudo reemplazar " << ruta << std::endl;
+        return Status::IO_ERROR;
+    }
+    return Status::OK;
+}
+
+} // namespace
+
 // ============================================
 // Implementación de la clase GestorDisco
 // ============================================
@@ -190,35 +266,41 @@ GestorDisco::GestorDisco(const std::string& ruta_base,
  * @details Guarda los metadatos del disco antes de destruir la instancia
  */
 GestorDisco::~GestorDisco() {
-    std::cout << "GestorDisco: Guardando metadatos del disco antes de la destrucción." << std::endl;
-    Estado estado = GuardarMetadatosDisco();
-    if (estado != Estado::EXITO) {
-        // No se puede usar ObtenerMensajeError aquí directamente, ya que no es un método de GestorDisco
-        std::cerr << "Error (Destructor GestorDisco): Fallo al guardar los metadatos del disco." << std::endl;
+    DetenerVolcadoAccesos();
+    if (!solo_lectura_) {
+        std::cout << "GestorDisco: Guardando metadatos del disco antes de la destrucción." << std::endl;
+        Estado estado = GuardarMetadatosDisco();
+        if (estado != Estado::EXITO) {
+            // No se puede usar ObtenerMensajeError aquí directamente, ya que no es un método de GestorDisco
+            std::cerr << "Error (Destructor GestorDisco): Fallo al guardar los metadatos del disco." << std::endl;
+        }
     }
     
+    // Forzar a disco lo escrito en la imagen antes de cerrar los descriptores
+    if (imagen_disco_ && imagen_disco_->EstaAbierta()) {
+        imagen_disco_->Sincronizar();
+        imagen_disco_->Cerrar();
+    }
+
     // Liberar recursos
-    cilindros_.clear();
-    bloques_activos_.clear();
+    asignacion_.Cerrar();
 }
 
 /**
- * @brief Inicializa la estructura de cilindros en memoria
+ * @brief Valida la geometría del disco
+ * @details No reserva nada: la dirección física de un sector sale de su índice lineal
+ *          (DireccionDesdeIndiceLineal) y la ocupación de cada cilindro del mapa de
+ *          asignación, así que arrancar no depende del tamaño del disco.
  */
-void GestorDisco::InicializarCilindros() {
+void GestorDisco::InicializarGeometria() {
     // Asegurarse de que num_pistas_ esté inicializado antes de usarlo
-    // Si no se carga de metadatos, se puede asumir un valor por defecto o calcularlo
     if (num_pistas_ == 0) { // Asumir un valor si no está cargado
         num_pistas_ = 100; // Ejemplo: 100 pistas por superficie
     }
-
-    cilindros_.reserve(num_pistas_); // Pre-reservar espacio
-    for (uint32_t pista = 0; pista < num_pistas_; ++pista) {
-        cilindros_.emplace_back(pista, num_platos_, NUM_SUPERFICIES, sectores_por_pista_);
-    }
-    std::cout << "GestorDisco: Inicializados " << cilindros_.size() 
-              << " cilindros con " << num_platos_ << " platos y " 
-              << sectores_por_pista_ << " sectores por pista." << std::endl;
+    std::cout << "GestorDisco: Geometría de " << num_pistas_
+              << " cilindros con " << num_platos_ << " platos y "
+              << sectores_por_pista_ << " sectores por pista ("
+              << ObtenerNumeroSectoresTotales() << " sectores)." << std::endl;
 }
 
 /**
@@ -270,18 +352,28 @@ Estado GestorDisco::CrearEstructuraDisco() {
     archivo_metadata << "sectores_por_pista=" << sectores_por_pista_ << "\n";
     archivo_metadata << "tamaño_sector=" << tamaño_sector_ << "\n";
     archivo_metadata << "siguiente_id_bloque=0\n";
+    archivo_metadata << "modo_almacenamiento="
+                     << (modo_almacenamiento_ == ModoAlmacenamiento::IMAGEN_UNICA ? "imagen" : "archivos") << "\n";
+    archivo_metadata << "bloques_por_segmento=" << bloques_por_segmento_ << "\n";
     fecha_creacion_ = ObtenerTimestampActual();
     ultima_modificacion_ = fecha_creacion_;
     archivo_metadata << "fecha_creacion=" << fecha_creacion_ << "\n";
     archivo_metadata << "ultima_modificacion=" << ultima_modificacion_ << "\n";
     archivo_metadata.close();
+
+    if (GuardarInstantaneaMetadatos() != Status::OK) {
+        std::cerr << "Advertencia: No se pudo escribir la instantánea de metadatos" << std::endl;
+    }
     
     std::cout << "GestorDisco: Estructura de disco creada correctamente en " << ruta_disco_completa << std::endl;
     return Estado::EXITO;
 }
 
 /**
- * @brief Carga los metadatos del disco desde archivos de texto
+ * @brief Carga los metadatos del disco
+ * @details Lee la instantánea binaria (metadatos.bin); solo los discos creados antes
+ *          de que existiera se interpretan desde el archivo de texto, y en ese caso se
+ *          escribe la instantánea para los siguientes arranques.
  * @return Estado con el resultado de la operación
  */
 Estado GestorDisco::CargarMetadatosDisco() {
@@ -290,7 +382,44 @@ Estado GestorDisco::CargarMetadatosDisco() {
         std::cerr << "Error: El directorio del disco no existe: " << ruta_disco_completa << std::endl;
         return Estado::NO_ENCONTRADO;
     }
-    
+
+    Status estado = CargarInstantaneaMetadatos();
+    bool desde_texto = false;
+    if (estado == Status::NOT_FOUND || estado == Status::INVALID_FORMAT) {
+        estado = CargarMetadatosTexto();
+        desde_texto = true;
+    }
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    InicializarGeometria();
+
+    // Recuperar las marcas de acceso persistidas (solo en modo POR_LOTES)
+    CargarAccesosBloques();
+
+    // Abrir (o crear) el mapa binario de asignación de bloques
+    Status estado_asignacion = asignacion_.Abrir(ObtenerRutaAsignacion(), ObtenerNumeroSectoresTotales(), solo_lectura_);
+    if (estado_asignacion != Status::OK) {
+        std::cerr << "Error al cargar el mapa de asignación de bloques" << std::endl;
+        return estado_asignacion;
+    }
+
+    if (desde_texto && !solo_lectura_ && GuardarInstantaneaMetadatos() != Status::OK) {
+        std::cerr << "Advertencia: No se pudo escribir la instantánea de metadatos" << std::endl;
+    }
+
+    std::cout << "GestorDisco: Metadatos cargados correctamente" << (solo_lectura_ ? " (solo lectura)" : "")
+              << ". Bloques en uso: " << asignacion_.ObtenerBloquesEnUso() << std::endl;
+    return Estado::EXITO;
+}
+
+/**
+ * @brief Carga los metadatos del disco desde el archivo de texto (formato anterior a metadatos.bin)
+ * @return Estado con el resultado de la operación
+ */
+Estado GestorDisco::CargarMetadatosTexto() {
+    std::string ruta_disco_completa = UnirRutas(ruta_base_, nombre_disco_);
     std::string ruta_metadata = UnirRutas(ruta_disco_completa, NOMBRE_ARCHIVO_METADATOS);
     
     if (!RutaExiste(ruta_metadata)) {
@@ -343,6 +472,11 @@ Estado GestorDisco::CargarMetadatosDisco() {
                 ultima_modificacion_ = valor;
             } else if (clave == "siguiente_id_bloque") {
                 siguiente_id_bloque_ = std::stoul(valor);
+            } else if (clave == "modo_almacenamiento") {
+                modo_almacenamiento_ = (valor == "imagen") ? ModoAlmacenamiento::IMAGEN_UNICA
+                                                          : ModoAlmacenamiento::ARCHIVO_POR_BLOQUE;
+            } else if (clave == "bloques_por_segmento") {
+                bloques_por_segmento_ = std::stoull(valor);
             }
         }
         
@@ -361,92 +495,177 @@ Estado GestorDisco::CargarMetadatosDisco() {
         num_pistas_ = num_pistas_leido;
         sectores_por_pista_ = sectores_pista_leido;
         tamaño_sector_ = tamaño_sector_leido;
-
-        // Re-inicializar cilindros con los valores cargados
-        InicializarCilindros();
-
-        // Cargar el mapeo lógico a físico
-        Estado estado_mapeo = CargarMapeoLogicoFisico();
-        if (estado_mapeo != Estado::EXITO) {
-            std::cerr << "Error al cargar el mapeo lógico a físico: " << std::endl;
-            return estado_mapeo;
-        }
-
-        // Cargar la información de bloques activos (si aplica, o si se usa un bitmap)
-        // En este diseño, bloques_activos_ es un mapa de BlockId a TipoPagina.
-        // Se debería cargar desde un archivo separado o reconstruir desde el mapeo.
-        // Por simplicidad, si el mapeo ya está cargado, bloques_activos_ se puede poblar desde ahí.
-        // Si se usa un archivo de "bloques_activos.txt", se debería cargar aquí.
-        Estado estado_bloques_activos = CargarBloquesActivos(); // Asumiendo que esta función existe
-        if (estado_bloques_activos != Estado::EXITO) {
-            std::cerr << "Error al cargar la información de bloques activos" << std::endl;
-            return estado;
-        }
-        
-        std::cout << "GestorDisco: Metadatos cargados correctamente. "
-                  << "Siguiente ID de bloque: " << siguiente_id_bloque_ << std::endl;
-        
         return Estado::EXITO;
         
     } catch (const std::exception& e) {
         std::cerr << "Excepción al cargar metadatos: " << e.what() << std::endl;
         return Estado::ERROR;
- * @brief Carga la información de bloques activos desde disco
- * @return Estado con el resultado de la operación (EXITO si se cargó o no hay nada que cargar)
+    }
+}
+
+/**
+ * @brief Obtiene la ruta al archivo binario de asignación de bloques
+ * @return Ruta completa al archivo de asignación
  */
-Estado GestorDisco::CargarBloquesActivos() {
-    std::string ruta_disco_completa = UnirRutas(ruta_base_, nombre_disco_);
-    std::string ruta_activos = UnirRutas(ruta_disco_completa, "bloques_activos.txt"); // Archivo para bloques activos
+std::string GestorDisco::ObtenerRutaAsignacion() const {
+    return UnirRutas(UnirRutas(ruta_base_, nombre_disco_), "asignacion.bin");
+}
 
-    // Si no existe el archivo, no hay bloques activos
-    if (!RutaExiste(ruta_activos)) {
-        bloques_activos_.clear();
-        return Estado::EXITO;
+std::string GestorDisco::ObtenerRutaInstantaneaMetadatos() const {
+    return UnirRutas(UnirRutas(ruta_base_, nombre_disco_), "metadatos.bin");
+}
+
+Status GestorDisco::GuardarInstantaneaMetadatos() {
+    if (solo_lectura_) {
+        return Status::OK;
     }
-    
-    try {
-        std::ifstream archivo_activos(ruta_activos);
-        if (!archivo_activos.is_open()) {
-            std::cerr << "Error: No se pudo abrir el archivo de bloques activos" << std::endl;
-            return Estado::ERROR_IO;
+    InstantaneaMetadatosDisco instantanea{};
+    instantanea.magic_number = MAGIC_METADATOS_DISCO;
+    instantanea.version = VERSION_METADATOS_DISCO;
+    instantanea.num_platos = num_platos_;
+    instantanea.num_superficies_por_plato = num_superficies_por_plato_;
+    instantanea.num_pistas = num_pistas_;
+    instantanea.sectores_por_pista = sectores_por_pista_;
+    instantanea.tamaño_sector = tamaño_sector_;
+    instantanea.siguiente_id_bloque = siguiente_id_bloque_;
+    instantanea.bloques_por_segmento = bloques_por_segmento_;
+    instantanea.modo_almacenamiento = static_cast<uint8_t>(modo_almacenamiento_);
+    CopiarCadenaFija(instantanea.nombre_disco, sizeof(instantanea.nombre_disco), nombre_disco_);
+    CopiarCadenaFija(instantanea.fecha_creacion, sizeof(instantanea.fecha_creacion), fecha_creacion_);
+    CopiarCadenaFija(instantanea.ultima_modificacion, sizeof(instantanea.ultima_modificacion), ultima_modificacion_);
+    return EscribirArchivoAtomico(ObtenerRutaInstantaneaMetadatos(), &instantanea, sizeof(instantanea));
+}
+
+Status GestorDisco::CargarInstantaneaMetadatos() {
+    std::ifstream archivo(ObtenerRutaInstantaneaMetadatos(), std::ios::binary);
+    if (!archivo.is_open()) {
+        return Status::NOT_FOUND;
+    }
+    InstantaneaMetadatosDisco instantanea{};
+    archivo.read(reinterpret_cast<char*>(&instantanea), sizeof(instantanea));
+    if (archivo.gcount() != static_cast<std::streamsize>(sizeof(instantanea)) ||
+        instantanea.magic_number != MAGIC_METADATOS_DISCO || instantanea.version != VERSION_METADATOS_DISCO) {
+        std::cerr << "Advertencia: Instantánea de metadatos no válida; se usa el archivo de texto" << std::endl;
+        return Status::INVALID_FORMAT;
+    }
+    std::string nombre_leido = LeerCadenaFija(instantanea.nombre_disco, sizeof(instantanea.nombre_disco));
+    if (nombre_leido != nombre_disco_) {
+        std::cerr << "Error: El nombre del disco cargado ('" << nombre_leido
+                  << "') no coincide con el nombre esperado ('" << nombre_disco_ << "')." << std::endl;
+        return Status::ERROR;
+    }
+
+    num_platos_ = instantanea.num_platos;
+    num_superficies_por_plato_ = instantanea.num_superficies_por_plato;
+    num_pistas_ = instantanea.num_pistas;
+    sectores_por_pista_ = instantanea.sectores_por_pista;
+    tamaño_sector_ = instantanea.tamaño_sector;
+    siguiente_id_bloque_ = instantanea.siguiente_id_bloque;
+    bloques_por_segmento_ = instantanea.bloques_por_segmento;
+    modo_almacenamiento_ = static_cast<ModoAlmacenamiento>(instantanea.modo_almacenamiento);
+    fecha_creacion_ = LeerCadenaFija(instantanea.fecha_creacion, sizeof(instantanea.fecha_creacion));
+    ultima_modificacion_ = LeerCadenaFija(instantanea.ultima_modificacion, sizeof(instantanea.ultima_modificacion));
+    return Status::OK;
+}
+
+/**
+ * @brief Asigna un nuevo bloque lógico y un sector físico libre
+ * @param tipo_pagina Tipo de página del nuevo bloque
+ * @return ID del bloque asignado, o 0 si no hay espacio
+ */
+BlockId GestorDisco::AsignarBloque(PageType tipo_pagina) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (solo_lectura_) {
+        std::cerr << "Error: El disco está abierto en solo lectura" << std::endl;
+        return 0;
+    }
+    if (!asignacion_.EstaAbierto()) {
+        std::cerr << "Error: El mapa de asignación no está abierto" << std::endl;
+        return 0;
+    }
+
+    // Buscar el sector desde la posición simulada del cabezal para conservar la localidad
+    DireccionFisica inicio_cabezal(0, 0, pista_cabezal_, 0);
+    uint64_t indice_sector = 0;
+    BlockId id_bloque = asignacion_.AsignarBloque(tipo_pagina, CalcularIndiceLineal(inicio_cabezal), indice_sector);
+    if (id_bloque == 0) {
+        std::cerr << "Error: No hay bloques libres en el disco" << std::endl;
+        return 0;
+    }
+
+    if (modo_almacenamiento_ == ModoAlmacenamiento::ARCHIVO_POR_BLOQUE && CrearArchivoBloque(id_bloque) != Status::OK) {
+        asignacion_.LiberarBloque(id_bloque);
+        return 0;
+    }
+
+    // Solo se escriben las páginas del mapa que han cambiado, no la lista completa
+    if (asignacion_.Sincronizar() != Status::OK) {
+        std::cerr << "Advertencia: No se pudo sincronizar el mapa de asignación después de asignar el bloque" << std::endl;
+    }
+    return id_bloque;
+}
+
+BlockId GestorDisco::AsignarExtension(PageType tipo_pagina, uint32_t bloques_deseados, uint32_t& bloques_asignados) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bloques_asignados = 0;
+    if (solo_lectura_) {
+        std::cerr << "Error: El disco está abierto en solo lectura" << std::endl;
+        return 0;
+    }
+    if (!asignacion_.EstaAbierto()) {
+        std::cerr << "Error: El mapa de asignación no está abierto" << std::endl;
+        return 0;
+    }
+
+    DireccionFisica inicio_cabezal(0, 0, pista_cabezal_, 0);
+    uint64_t sector_sugerido = CalcularIndiceLineal(inicio_cabezal);
+
+    // Si no queda un tramo contiguo del tamaño pedido se prueba con la mitad
+    for (uint32_t numero_bloques = bloques_deseados; numero_bloques > 0; numero_bloques /= 2) {
+        uint64_t primer_sector = 0;
+        BlockId primer_bloque = asignacion_.AsignarExtension(tipo_pagina, numero_bloques, sector_sugerido, primer_sector);
+        if (primer_bloque == 0) {
+            continue;
         }
-        
-        bloques_activos_.clear();
-        std::string linea;
 
-        // Leer cada línea con el formato: id_bloque tipo_pagina_int tipo_pagina_string
-        while (std::getline(archivo_activos, linea)) {
-            if (linea.empty() || linea[0] == '#') continue;
-            
-            std::istringstream iss(linea);
-            std::string id_str, tipo_int_str, tipo_string_str;
-            
-            if (iss >> id_str >> tipo_int_str >> tipo_string_str) {
-                try {
-                    BloqueId id_bloque = std::stoul(id_str);
-                    TipoPagina tipo_pagina = static_cast<TipoPagina>(std::stoi(tipo_int_str));
-
-                    if (tipo_pagina != TipoPagina::DESCONOCIDO) {
-                        bloques_activos_[id_bloque] = tipo_pagina;
-                    } else {
-                        std::cerr << "Advertencia: Tipo de página desconocido: " << tipo_str << std::endl;
-                    }
-                } catch (const std::exception& e) {
-                    std::cerr << "Error al procesar línea de bloques activos: " << linea << std::endl;
-                    continue;
+        uint32_t creados = 0;
+        for (; creados < numero_bloques; ++creados) {
+            if (modo_almacenamiento_ == ModoAlmacenamiento::ARCHIVO_POR_BLOQUE &&
+                CrearArchivoBloque(primer_bloque + creados) != Status::OK) {
+                break;
+            }
+        }
+        if (creados < numero_bloques) {
+            // Deshacer la extensión entera: o se asigna completa o no se asigna
+            for (uint32_t i = 0; i < numero_bloques; ++i) {
+                if (i < creados) {
+                    EliminarArchivo(ObtenerRutaBloque(primer_bloque + i));
                 }
+                asignacion_.LiberarBloque(primer_bloque + i);
             }
+            return 0;
         }
-        
-        archivo_activos.close();
-        std::cout << "Cargados " << bloques_activos_.size() << " bloques activos" << std::endl;
-        return Estado::EXITO;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Excepción al cargar bloques activos: " << e.what() << std::endl;
-        return Estado::ERROR;
+
+        if (asignacion_.Sincronizar() != Status::OK) {
+            std::cerr << "Advertencia: No se pudo sincronizar el mapa de asignación después de asignar la extensión" << std::endl;
+        }
+        bloques_asignados = numero_bloques;
+        return primer_bloque;
     }
+
+    std::cerr << "Error: No hay bloques libres en el disco" << std::endl;
+    return 0;
 }
+
+Status GestorDisco::CrearArchivoBloque(BlockId id_bloque) {
+    std::string ruta_bloque = ObtenerRutaBloque(id_bloque);
+    std::ofstream archivo_bloque(ruta_bloque, std::ios::binary | std::ios::trunc);
+    if (!archivo_bloque.is_open()) {
+        std::cerr << "Error: No se pudo crear el archivo de bloque: " << ruta_bloque << std::endl;
+        return Status::IO_ERROR;
+    }
+
+    CabeceraBloque cabecera;
     cabecera.timestamp_creacion = ObtenerTimestampActual();
     cabecera.timestamp_modificacion = cabecera.timestamp_creacion;
     
@@ -457,23 +676,22 @@ Estado GestorDisco::CargarBloquesActivos() {
     // Rellenar el resto del bloque con ceros
     std::vector<char> ceros(tamaño_sector_ - buffer_cabecera.size(), 0);
     archivo_bloque.write(ceros.data(), ceros.size());
-    
     archivo_bloque.close();
-    
-    // Actualizar la lista de bloques activos
-    bloques_activos_[id_bloque] = tipo_pagina;
-    
-    // Actualizar los metadatos del disco
-    Estado estado = ActualizarMetadatos();
-    if (estado != Estado::EXITO) {
-        std::cerr << "Advertencia: No se pudieron actualizar los metadatos después de asignar el bloque" << std::endl;
-        // No fallamos la operación por esto, solo registramos la advertencia
+    return Status::OK;
+}
+
+uint64_t GestorDisco::ObtenerSectoresPorCilindro() const {
+    uint64_t superficies = (num_superficies_por_plato_ == 0) ? 1 : num_superficies_por_plato_;
+    return static_cast<uint64_t>(num_platos_) * superficies * sectores_por_pista_;
+}
+
+uint64_t GestorDisco::ObtenerSectoresLibresCilindro(uint32_t pista) const {
+    if (pista >= num_pistas_) {
+        return 0;
     }
-    
-    std::cout << "GestorDisco: Bloque " << id_bloque << " asignado correctamente (" 
-              << TipoPaginaAString(tipo_pagina) << ")" << std::endl;
-    
-    return Estado::EXITO;
+    // CalcularIndiceLineal pone la pista en la posición más significativa
+    uint64_t sectores = ObtenerSectoresPorCilindro();
+    return sectores - asignacion_.ContarSectoresOcupados(static_cast<uint64_t>(pista) * sectores, sectores);
 }
 
 /**
@@ -494,14 +712,6 @@ std::string GestorDisco::ObtenerRutaMetadatos() const {
     return UnirRutas(UnirRutas(ruta_base_, nombre_disco_), NOMBRE_ARCHIVO_METADATOS);
 }
 
-/**
- * @brief Obtiene la ruta al archivo de bloques activos
- * @return Ruta completa al archivo de bloques activos
- */
-std::string GestorDisco::ObtenerRutaBloquesActivos() const { // Esta función ya existe en el archivo
-    return UnirRutas(UnirRutas(ruta_base_, "bloques"), "bloques_activos.txt");
-}
-
 /**
  * @brief Actualiza los metadatos del disco en el sistema de archivos
  * @return Estado con el resultado de la operación
@@ -534,39 +744,28 @@ Estado GestorDisco::ActualizarMetadatos() {
     archivo_metadata << "sectores_por_pista=" << sectores_por_pista_ << "\n";
     archivo_metadata << "tamaño_sector=" << tamaño_sector_ << "\n";
     archivo_metadata << "siguiente_id_bloque=" << siguiente_id_bloque_ << "\n";
+    archivo_metadata << "modo_almacenamiento="
+                     << (modo_almacenamiento_ == ModoAlmacenamiento::IMAGEN_UNICA ? "imagen" : "archivos") << "\n";
+    archivo_metadata << "bloques_por_segmento=" << bloques_por_segmento_ << "\n";
     archivo_metadata << "fecha_creacion=" << fecha_creacion_ << "\n";
     archivo_metadata << "ultima_modificacion=" << ObtenerTimestampActual() << "\n";
     
     archivo_metadata.close();
-    
-    // Actualizar el archivo de bloques activos
-    std::string ruta_activos = UnirRutas(ruta_disco_completa, "bloques_activos.txt");
-    
-    // Asegurarse de que el directorio de bloques existe
-    if (!CrearDirectorios(UnirRutas(ruta_disco_completa, "bloques"))) {
-        std::cerr << "Error: No se pudo crear el directorio de bloques: " << dir_activos << std::endl;
-        return Estado::ERROR_IO;
-    }
-    
-    std::ofstream archivo_activos(ruta_activos);
-    
-    if (!archivo_activos.is_open()) {
-        std::cerr << "Error: No se pudo abrir el archivo de bloques activos: " 
-                  << ruta_activos << std::endl;
-        return Estado::ERROR_IO;
+
+    // El arranque lee la instantánea binaria, no este archivo
+    Status estado_instantanea = GuardarInstantaneaMetadatos();
+    if (estado_instantanea != Status::OK) {
+        return estado_instantanea;
     }
     
-    // Escribir la lista de bloques activos
-    archivo_activos << "# Lista de bloques activos\n";
-    archivo_activos << "# Formato: id_bloque tipo_pagina\n";
-    
-    for (const auto& par : bloques_activos_) { // bloques_activos_ es un std::unordered_map<BlockId, TipoPagina>
-        archivo_activos << par.first << " " << static_cast<int>(par.second) << " " 
-                       << TipoPaginaAString(par.second) << "\n";
+    // La asignación de bloques vive en el archivo binario: solo se escriben
+    // las páginas que cambiaron desde la última sincronización
+    Status estado_asignacion = asignacion_.Sincronizar();
+    if (estado_asignacion != Status::OK) {
+        std::cerr << "Error: No se pudo sincronizar el archivo de asignación" << std::endl;
+        return estado_asignacion;
     }
     
-    archivo_activos.close();
-    
     return Estado::EXITO;
 }
 
@@ -582,9 +781,20 @@ Estado GestorDisco::LeerBloque(BloqueId id_bloque, char* buffer, size_t tamano)
         std::cerr << "Error: Buffer inválido o tamaño insuficiente" << std::endl;
         return Estado::ARGUMENTO_INVALIDO;
     }
+
+    // El tipo de página etiqueta la latencia; solo se consulta con las métricas activas
+    MedidorLatencia medidor(OperacionMetrica::LECTURA_DISCO);
+    if (medidor.Activo()) {
+        medidor.EstablecerTipoPagina(asignacion_.ObtenerTipoPagina(id_bloque));
+    }
+
+    // Con imagen única el bloque se lee con un pread sobre el descriptor abierto
+    if (modo_almacenamiento_ == ModoAlmacenamiento::IMAGEN_UNICA) {
+        return LeerBloqueImagen(id_bloque, buffer, tamano);
+    }
     
     // Verificar que el bloque existe y está activo
-    if (bloques_activos_.find(id_bloque) == bloques_activos_.end()) {
+    if (!asignacion_.EstaAsignado(id_bloque)) {
         std::cerr << "Error: Intento de leer un bloque no asignado: " << id_bloque << std::endl;
         return Estado::NO_ENCONTRADO;
     }
@@ -617,24 +827,9 @@ Estado GestorDisco::LeerBloque(BloqueId id_bloque, char* buffer, size_t tamano)
         return estado;
     }
     
-    // Actualizar el timestamp de último acceso
-    cabecera.timestamp_acceso = ObtenerTimestampActual();
-
-    // Escribir la cabecera actualizada en el buffer (para que el llamador la tenga)
-    std::string buffer_cabecera_str = SerializarCabecera(cabecera);
-    std::memcpy(buffer, buffer_cabecera_str.c_str(), buffer_cabecera_str.size());
-
-    // Persistir la cabecera actualizada en el archivo del bloque
-    std::fstream archivo_actualizacion(ruta_bloque, std::ios::in | std::ios::out | std::ios::binary);
-    if (archivo_actualizacion.is_open()) {
-        archivo_actualizacion.seekp(0, std::ios::beg); // Ir al inicio del archivo
-        archivo_actualizacion.write(buffer_cabecera_str.c_str(), buffer_cabecera_str.size());
-        archivo_actualizacion.close();
-    } else {
-            std::cerr << "Advertencia: No se pudo actualizar la marca de tiempo de acceso del bloque " << id_bloque << std::endl;
-            // No fallamos la operación por esto, solo registramos la advertencia
-        }
-    }
+    // La marca de acceso ya no se reescribe en el archivo del bloque: una lectura
+    // solo genera E/S de lectura. El acceso se registra según modo_registro_acceso_.
+    RegistrarAccesoBloque(id_bloque);
     
     return Estado::EXITO;
 }
@@ -651,9 +846,22 @@ Estado GestorDisco::EscribirBloque(BloqueId id_bloque, const char* buffer, size_
         std::cerr << "Error: Buffer inválido o tamaño excesivo" << std::endl;
         return Estado::ARGUMENTO_INVALIDO;
     }
+    if (solo_lectura_) {
+        std::cerr << "Error: Escritura del bloque " << id_bloque << " en un disco de solo lectura" << std::endl;
+        return Status::OPERATION_FAILED;
+    }
+
+    MedidorLatencia medidor(OperacionMetrica::ESCRITURA_DISCO);
+    if (medidor.Activo()) {
+        medidor.EstablecerTipoPagina(asignacion_.ObtenerTipoPagina(id_bloque));
+    }
+
+    if (modo_almacenamiento_ == ModoAlmacenamiento::IMAGEN_UNICA) {
+        return EscribirBloqueImagen(id_bloque, buffer, tamano);
+    }
     
     // Verificar que el bloque existe y está activo (ya se hace en LeerBloque, pero es bueno repetirlo aquí)
-    if (bloques_activos_.find(id_bloque) == bloques_activos_.end()) {
+    if (!asignacion_.EstaAsignado(id_bloque)) {
         std::cerr << "Error: Intento de escribir en un bloque no asignado: " << id_bloque << std::endl;
         return Estado::NO_ENCONTRADO;
     }
@@ -715,29 +923,31 @@ Estado GestorDisco::EscribirBloque(BloqueId id_bloque, const char* buffer, size_
 
 // Guarda los metadatos del disco en archivos de texto
 Status GestorDisco::GuardarMetadatosDisco() { // Esta función ya existe en el archivo
-    // Actualizar el archivo de metadatos principal
-    std::string ruta_metadata = ObtenerRutaMetadatos();
+    if (solo_lectura_) {
+        return Status::OK;
+    }
 
     try {
-        std::ofstream archivo_metadata(ruta_metadata);
-        if (!archivo_metadata.is_open()) {
-            std::cerr << "Error: No se pudo abrir el archivo de metadatos para escritura: " 
-                      << ruta_metadata << std::endl;
-            return Estado::ERROR_IO;
+        // La configuración va en la instantánea binaria; el mapeo lógico → físico
+        // se guarda en el archivo de asignación binario
+        ultima_modificacion_ = std::to_string(ObtenerTimestampActual());
+        Status estado_instantanea = GuardarInstantaneaMetadatos();
+        if (estado_instantanea != Status::OK) {
+            std::cerr << "Error: No se pudo guardar la instantánea de metadatos" << std::endl;
+            return estado_instantanea;
         }
 
-        // Escribir el siguiente ID de bloque lógico y el mapeo
-        archivo_metadata << siguiente_id_bloque_ << std::endl; // Usar siguiente_id_bloque_
-        // Escribir el mapeo lógico a físico
-        for (const auto& par : mapeo_logico_fisico_) {
-            const BlockId& id_bloque = par.first;
-            const DireccionFisica& direccion = par.second;
-            archivo_metadata << id_bloque << " " << direccion.id_plato << " " 
-                           << direccion.id_superficie << " " << direccion.id_pista << " " 
-                           << direccion.id_sector << std::endl;
+        Status estado_asignacion = asignacion_.Sincronizar();
+        if (estado_asignacion != Status::OK) {
+            std::cerr << "Error: No se pudo sincronizar el archivo de asignación" << std::endl;
+            return estado_asignacion;
         }
 
-        archivo_metadata.close();
+        // Volcar en lote las marcas de acceso acumuladas desde el último guardado
+        Status estado_accesos = VolcarAccesosPendientes();
+        if (estado_accesos != Status::OK) {
+            std::cerr << "Advertencia: No se pudieron guardar las marcas de acceso de los bloques" << std::endl;
+        }
         return Status::OK;
         
     } catch (const std::exception& e) {
@@ -747,49 +957,514 @@ Status GestorDisco::GuardarMetadatosDisco() { // Esta función ya existe en el a
 }
 
 /**
- * @brief Libera un bloque lógico en el disco
- * @param id_bloque ID del bloque a liberar
- * @return Estado con el resultado de la operación
+ * @brief Desasigna un bloque lógico y libera su sector físico
+ * @param id_bloque ID del bloque a desasignar
+ * @return Status de la operación
  */
-Estado GestorDisco::LiberarBloque(BloqueId id_bloque) {
-    // Verificar que el bloque existe en el mapeo lógico a físico
-    auto it_mapeo = mapeo_logico_fisico_.find(id_bloque);
-    if (it_mapeo == mapeo_logico_fisico_.end()) {
+Status GestorDisco::DesasignarBloque(BlockId id_bloque) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (solo_lectura_) {
+        std::cerr << "Error: El disco está abierto en solo lectura" << std::endl;
+        return Status::OPERATION_FAILED;
+    }
+    uint64_t indice_sector = 0;
+    if (!asignacion_.ObtenerSector(id_bloque, indice_sector)) {
         std::cerr << "Advertencia: Intento de liberar un bloque no asignado: " << id_bloque << std::endl;
-        return Estado::NO_ENCONTRADO;
+        return Status::NOT_FOUND;
     }
 
-    // Eliminar el archivo del bloque
-    std::string ruta_bloque = ObtenerRutaBloque(id_bloque);
+    // En la imagen única el espacio del bloque es fijo: basta con liberarlo en el mapa
+    if (modo_almacenamiento_ == ModoAlmacenamiento::ARCHIVO_POR_BLOQUE) {
+        std::string ruta_bloque = ObtenerRutaBloque(id_bloque);
+        if (!EliminarArchivo(ruta_bloque)) {
+            std::cerr << "Error: No se pudo eliminar el archivo del bloque: " << ruta_bloque << std::endl;
+            return Status::IO_ERROR;
+        }
+    }
+
+    Status estado = asignacion_.LiberarBloque(id_bloque);
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    if (asignacion_.Sincronizar() != Status::OK) {
+        std::cerr << "Advertencia: No se pudo sincronizar el mapa de asignación después de liberar el bloque" << std::endl;
+    }
     
-    if (EliminarArchivo(ruta_bloque)) {
-        // Eliminar de la lista de bloques activos
-        bloques_activos_.erase(it);
-        
-        // Marcar los sectores físicos como libres en la estructura de cilindros
-        const DireccionFisica& dir_fisica = it_mapeo->second;
-        // Asumiendo que un bloque lógico ocupa un sector físico para simplificar
-        // Si un bloque ocupa múltiples sectores, se necesitaría un bucle
-        cilindros_[dir_fisica.id_pista].sectores_ocupados[dir_fisica.id_plato][dir_fisica.id_superficie * sectores_por_pista_ + dir_fisica.id_sector] = false;
-        cilindros_[dir_fisica.id_pista].sectores_libres_total++;
+    std::cout << "GestorDisco: Bloque " << id_bloque << " liberado correctamente" << std::endl;
+    return Status::OK;
+}
 
-        // Eliminar del mapeo lógico a físico
-        mapeo_logico_fisico_.erase(it_mapeo);
+/**
+ * @brief Verifica si un bloque está asignado
+ */
+bool GestorDisco::ExisteBloque(BlockId id_bloque) const {
+    return asignacion_.EstaAsignado(id_bloque);
+}
 
-        Estado estado = ActualizarMetadatos();
-        if (estado != Estado::EXITO) {
-            std::cerr << "Advertencia: No se pudieron actualizar los metadatos después de liberar el bloque" << std::endl;
-            // No fallamos la operación por esto, solo registramos la advertencia
+/**
+ * @brief Lista los bloques asignados de un tipo recorriendo el mapa de asignación
+ */
+std::vector<BlockId> GestorDisco::ListarBloquesPorTipo(PageType tipo_pagina) const {
+    std::vector<BlockId> bloques;
+    for (uint64_t id_bloque = 1; id_bloque < asignacion_.ObtenerCapacidad(); ++id_bloque) {
+        BlockId id = static_cast<BlockId>(id_bloque);
+        if (asignacion_.EstaAsignado(id) && asignacion_.ObtenerTipoPagina(id) == tipo_pagina) {
+            bloques.push_back(id);
         }
-        
-        std::cout << "GestorDisco: Bloque " << id_bloque << " liberado correctamente" << std::endl;
-        return Estado::EXITO;
+    }
+    return bloques;
+}
+
+/**
+ * @brief Vuelca el mapa de asignación en texto (id_bloque tipo_pagina indice_sector), solo para depuración
+ * @param ruta Archivo de destino
+ * @return Status de la operación
+ */
+Status GestorDisco::ExportarMetadatosTexto(const std::string& ruta) const {
+    return asignacion_.ExportarTexto(ruta);
+}
+
+// ============================================
+// Backend de imagen única (pread/pwrite)
+// ============================================
+
+void GestorDisco::EstablecerModoAlmacenamiento(ModoAlmacenamiento modo, uint64_t bloques_por_segmento) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (imagen_disco_ && imagen_disco_->EstaAbierta()) {
+        std::cerr << "Advertencia: El modo de almacenamiento no puede cambiarse con la imagen abierta" << std::endl;
+        return;
+    }
+    modo_almacenamiento_ = modo;
+    bloques_por_segmento_ = bloques_por_segmento;
+}
+
+void GestorDisco::EstablecerSoloLectura(bool solo_lectura) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ((imagen_disco_ && imagen_disco_->EstaAbierta()) || asignacion_.EstaAbierto()) {
+        std::cerr << "Advertencia: El modo de solo lectura no puede cambiarse con el disco abierto" << std::endl;
+        return;
+    }
+    solo_lectura_ = solo_lectura;
+    if (solo_lectura_ && modo_registro_acceso_ == ModoRegistroAcceso::POR_LOTES) {
+        // Registrar accesos no puede escribir en el disco de otra instancia
+        std::lock_guard<std::mutex> lock_accesos(mutex_accesos_);
+        modo_registro_acceso_ = ModoRegistroAcceso::EN_MEMORIA;
+    }
+}
+
+uint64_t GestorDisco::ObtenerNumeroSectoresTotales() const {
+    uint64_t superficies = (num_superficies_por_plato_ == 0) ? 1 : num_superficies_por_plato_;
+    return static_cast<uint64_t>(num_platos_) * superficies * num_pistas_ * sectores_por_pista_;
+}
+
+uint64_t GestorDisco::CalcularIndiceLineal(const DireccionFisica& direccion) const {
+    uint64_t superficies = (num_superficies_por_plato_ == 0) ? 1 : num_superficies_por_plato_;
+    uint64_t indice = direccion.id_pista;
+    indice = indice * num_platos_ + direccion.id_plato;
+    indice = indice * superficies + direccion.id_superficie;
+    indice = indice * sectores_por_pista_ + direccion.id_sector;
+    return indice;
+}
+
+DireccionFisica GestorDisco::DireccionDesdeIndiceLineal(uint64_t indice) const {
+    uint64_t superficies = (num_superficies_por_plato_ == 0) ? 1 : num_superficies_por_plato_;
+    DireccionFisica direccion;
+    direccion.id_sector = static_cast<uint32_t>(indice % sectores_por_pista_);
+    indice /= sectores_por_pista_;
+    direccion.id_superficie = static_cast<uint32_t>(indice % superficies);
+    indice /= superficies;
+    direccion.id_plato = static_cast<uint32_t>(indice % num_platos_);
+    direccion.id_pista = static_cast<uint32_t>(indice / num_platos_);
+    return direccion;
+}
+
+std::string GestorDisco::ObtenerRutaImagen() const {
+    return UnirRutas(UnirRutas(ruta_base_, nombre_disco_), "disco.img");
+}
+
+Status GestorDisco::AbrirImagenDisco() {
+    // Una sola apertura aunque la pidan a la vez el hilo principal y los de precarga
+    // y escritura del buffer; el resultado se conserva para las llamadas siguientes
+    std::call_once(apertura_imagen_, [this]() {
+        std::unique_ptr<ImagenDisco> imagen;
+        try {
+            imagen = std::make_unique<ImagenDisco>(ObtenerRutaImagen(), tamaño_sector_, bloques_por_segmento_);
+        } catch (const std::exception& e) {
+            std::cerr << "Error (AbrirImagenDisco): " << e.what() << std::endl;
+            estado_apertura_imagen_ = Status::INVALID_ARGUMENT;
+            return;
+        }
+        estado_apertura_imagen_ = solo_lectura_ ? imagen->AbrirSoloLectura(ObtenerNumeroSectoresTotales())
+                                                : imagen->Abrir(ObtenerNumeroSectoresTotales());
+        imagen_disco_ = std::move(imagen);
+    });
+    return estado_apertura_imagen_;
+}
+
+Status GestorDisco::LeerBloqueImagen(BlockId id_bloque, Byte* buffer, BlockSizeType tamano_buffer) {
+    uint64_t indice_sector = 0;
+    if (!asignacion_.ObtenerSector(id_bloque, indice_sector)) {
+        std::cerr << "Error: Intento de leer un bloque no asignado: " << id_bloque << std::endl;
+        return Status::NOT_FOUND;
+    }
+    if (tamano_buffer < tamaño_sector_) {
+        return Status::INVALID_ARGUMENT;
+    }
+    Status estado = AbrirImagenDisco();
+    if (estado != Status::OK) {
+        return estado;
+    }
+    estado = imagen_disco_->LeerBloque(indice_sector, buffer);
+    if (estado == Status::OK) {
+        RegistrarAccesoBloque(id_bloque);
+    }
+    return estado;
+}
+
+Status GestorDisco::EscribirBloqueImagen(BlockId id_bloque, const Byte* datos, BlockSizeType tamano_datos) {
+    uint64_t indice_sector = 0;
+    if (!asignacion_.ObtenerSector(id_bloque, indice_sector)) {
+        std::cerr << "Error: Intento de escribir en un bloque no asignado: " << id_bloque << std::endl;
+        return Status::NOT_FOUND;
+    }
+    Status estado = AbrirImagenDisco();
+    if (estado != Status::OK) {
+        return estado;
+    }
+    return imagen_disco_->EscribirBloque(indice_sector, datos, tamano_datos);
+}
+
+// ============================================
+// E/S por lotes con planificación por cilindro
+// ============================================
+
+/**
+ * @brief Ordena las solicitudes en recorrido de ascensor (SCAN) por cilindro.
+ * Se atienden primero los cilindros en el sentido actual del cabezal y luego
+ * los restantes en sentido contrario. Dentro de cada cilindro el orden es el
+ * de la imagen, para que los sectores contiguos puedan agruparse.
+ */
+std::vector<GestorDisco::SolicitudPlanificada>
+GestorDisco::PlanificarSolicitudes(std::vector<SolicitudES>& solicitudes) {
+    std::vector<SolicitudPlanificada> planificadas;
+    planificadas.reserve(solicitudes.size());
+
+    for (auto& solicitud : solicitudes) {
+        uint64_t indice_sector = 0;
+        bool asignado = asignacion_.ObtenerSector(solicitud.id_bloque, indice_sector);
+        if (!asignado || solicitud.buffer == nullptr) {
+            solicitud.resultado = (solicitud.buffer == nullptr) ? Status::INVALID_ARGUMENT : Status::NOT_FOUND;
+            continue;
+        }
+        solicitud.resultado = Status::OK;
+        planificadas.push_back({&solicitud, indice_sector, DireccionDesdeIndiceLineal(indice_sector).id_pista});
+    }
+
+    std::sort(planificadas.begin(), planificadas.end(),
+              [](const SolicitudPlanificada& a, const SolicitudPlanificada& b) {
+                  return a.indice_lineal < b.indice_lineal;
+              });
+
+    std::lock_guard<std::mutex> lock(mutex_planificador_);
+    auto en_sentido_actual = [this](const SolicitudPlanificada& p) {
+        return cabezal_ascendente_ ? (p.pista >= pista_cabezal_) : (p.pista <= pista_cabezal_);
+    };
+    // stable_partition conserva el orden ascendente dentro de cada mitad
+    auto frontera = std::stable_partition(planificadas.begin(), planificadas.end(), en_sentido_actual);
+
+    // Invertir el orden de cilindros (no el de sectores) en el tramo descendente
+    auto invertir_cilindros = [](std::vector<SolicitudPlanificada>::iterator inicio,
+                                 std::vector<SolicitudPlanificada>::iterator fin) {
+        std::stable_sort(inicio, fin, [](const SolicitudPlanificada& a, const SolicitudPlanificada& b) {
+            return a.pista > b.pista;
+        });
+    };
+    if (cabezal_ascendente_) {
+        invertir_cilindros(frontera, planificadas.end());
     } else {
-        std::cerr << "Error: No se pudo eliminar el archivo del bloque: " << ruta_bloque << std::endl;
-        return Estado::ERROR_IO;
+        invertir_cilindros(planificadas.begin(), frontera);
+    }
+
+    if (!planificadas.empty()) {
+        // Si hubo tramo de retorno, el cabezal termina moviéndose en sentido contrario
+        if (frontera != planificadas.end()) {
+            cabezal_ascendente_ = !cabezal_ascendente_;
+        }
+        pista_cabezal_ = planificadas.back().pista;
+    }
+    return planificadas;
+}
+
+Status GestorDisco::EjecutarLoteES(std::vector<SolicitudES>& solicitudes, bool es_escritura) {
+    if (es_escritura && solo_lectura_) {
+        for (auto& solicitud : solicitudes) solicitud.resultado = Status::OPERATION_FAILED;
+        std::cerr << "Error: Escritura por lotes en un disco de solo lectura" << std::endl;
+        return Status::OPERATION_FAILED;
+    }
+    std::vector<SolicitudPlanificada> plan = PlanificarSolicitudes(solicitudes);
+    Status estado_global = Status::OK;
+    for (const auto& solicitud : solicitudes) {
+        if (solicitud.resultado != Status::OK) {
+            estado_global = solicitud.resultado;
+            break;
+        }
+    }
+
+    auto ejecutar_individual = [this, es_escritura](SolicitudES& s) {
+        s.resultado = es_escritura ? EscribirBloque(s.id_bloque, s.buffer, s.tamano)
+                                   : LeerBloque(s.id_bloque, s.buffer, s.tamano);
+        return s.resultado;
+    };
+
+    if (modo_almacenamiento_ != ModoAlmacenamiento::IMAGEN_UNICA) {
+        // Un archivo por bloque: no hay agrupación posible, pero se respeta el orden SCAN
+        for (auto& p : plan) {
+            Status estado = ejecutar_individual(*p.solicitud);
+            if (estado != Status::OK && estado_global == Status::OK) estado_global = estado;
+        }
+        return estado_global;
+    }
+
+    Status estado_apertura = AbrirImagenDisco();
+    if (estado_apertura != Status::OK) {
+        for (auto& p : plan) p.solicitud->resultado = estado_apertura;
+        return estado_apertura;
+    }
+
+    std::vector<Byte> buffer_agrupado;
+    size_t i = 0;
+    while (i < plan.size()) {
+        // Extender el tramo mientras los sectores sean consecutivos en la imagen
+        size_t j = i + 1;
+        while (j < plan.size() && (j - i) < MAX_BLOQUES_COALESCIDOS &&
+               plan[j].indice_lineal == plan[j - 1].indice_lineal + 1 &&
+               plan[j].solicitud->tamano == tamaño_sector_ && plan[i].solicitud->tamano == tamaño_sector_) {
+            ++j;
+        }
+        uint32_t cantidad = static_cast<uint32_t>(j - i);
+
+        Status estado = Status::OK;
+        if (cantidad == 1) {
+            estado = ejecutar_individual(*plan[i].solicitud);
+        } else {
+            // Un tramo coalescido cuenta como una sola operación de E/S
+            MedidorLatencia medidor(es_escritura ? OperacionMetrica::ESCRITURA_DISCO : OperacionMetrica::LECTURA_DISCO);
+            if (medidor.Activo()) {
+                medidor.EstablecerTipoPagina(asignacion_.ObtenerTipoPagina(plan[i].solicitud->id_bloque));
+            }
+            buffer_agrupado.resize(static_cast<size_t>(cantidad) * tamaño_sector_);
+            if (es_escritura) {
+                for (size_t k = i; k < j; ++k) {
+                    std::memcpy(buffer_agrupado.data() + (k - i) * tamaño_sector_, plan[k].solicitud->buffer, tamaño_sector_);
+                }
+                estado = imagen_disco_->EscribirBloquesContiguos(plan[i].indice_lineal, cantidad, buffer_agrupado.data());
+            } else {
+                estado = imagen_disco_->LeerBloquesContiguos(plan[i].indice_lineal, cantidad, buffer_agrupado.data());
+            }
+
+            if (estado == Status::INVALID_ARGUMENT) {
+                // El tramo cruza un límite de segmento: atender bloque a bloque
+                // (cada lectura o escritura individual registra su propia latencia)
+                medidor.Cancelar();
+                estado = Status::OK;
+                for (size_t k = i; k < j; ++k) {
+                    Status estado_k = ejecutar_individual(*plan[k].solicitud);
+                    if (estado_k != Status::OK) estado = estado_k;
+                }
+            } else {
+                medidor.Terminar();
+                static ContadorMetrica& bloques_coalescidos = RegistroMetricas::Global().Contador("disco_bloques_coalescidos");
+                if (estado == Status::OK) {
+                    bloques_coalescidos.Sumar(cantidad);
+                }
+                for (size_t k = i; k < j; ++k) {
+                    plan[k].solicitud->resultado = estado;
+                    if (estado == Status::OK && !es_escritura) {
+                        std::memcpy(plan[k].solicitud->buffer, buffer_agrupado.data() + (k - i) * tamaño_sector_, tamaño_sector_);
+                        RegistrarAccesoBloque(plan[k].solicitud->id_bloque);
+                    }
+                }
+            }
+        }
+
+        if (estado != Status::OK && estado_global == Status::OK) estado_global = estado;
+        i = j;
+    }
+    return estado_global;
+}
+
+Status GestorDisco::LeerBloques(std::vector<SolicitudES>& solicitudes) {
+    return EjecutarLoteES(solicitudes, false);
+}
+
+Status GestorDisco::EscribirBloques(std::vector<SolicitudES>& solicitudes) {
+    return EjecutarLoteES(solicitudes, true);
+}
+
+// ============================================
+// Registro de accesos a bloques
+// ============================================
+
+void GestorDisco::EstablecerModoRegistroAcceso(ModoRegistroAcceso modo, uint32_t umbral_lote) {
+    std::lock_guard<std::mutex> lock(mutex_accesos_);
+    modo_registro_acceso_ = modo;
+    umbral_lote_accesos_ = umbral_lote;
+    if (modo == ModoRegistroAcceso::DESACTIVADO) {
+        tiempos_acceso_.clear();
+        accesos_pendientes_ = 0;
+    }
+}
+
+std::string GestorDisco::ObtenerRutaAccesos() const {
+    return UnirRutas(UnirRutas(ruta_base_, nombre_disco_), "accesos_bloques.bin");
+}
+
+void GestorDisco::RegistrarAccesoBloque(BlockId id_bloque) {
+    ModoRegistroAcceso modo = modo_registro_acceso_.load(std::memory_order_relaxed);
+    if (modo == ModoRegistroAcceso::DESACTIVADO) {
+        return;
+    }
+
+    bool volcar = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_accesos_);
+        tiempos_acceso_[id_bloque] = ObtenerTimestampActual();
+        if (modo == ModoRegistroAcceso::POR_LOTES) {
+            accesos_pendientes_++;
+            volcar = (umbral_lote_accesos_ > 0 && accesos_pendientes_ >= umbral_lote_accesos_ &&
+                      !volcado_accesos_solicitado_);
+            if (volcar) {
+                volcado_accesos_solicitado_ = true;
+            }
+        }
+    }
+
+    if (volcar) {
+        // El volcado escribe un archivo entero: lo hace un hilo propio, no el lector
+        std::call_once(inicio_volcado_accesos_, [this]() {
+            hilo_volcado_accesos_ = std::thread(&GestorDisco::BucleVolcadoAccesos, this);
+        });
+        cv_volcado_accesos_.notify_one();
+    }
+}
+
+void GestorDisco::BucleVolcadoAccesos() {
+    std::unique_lock<std::mutex> lock(mutex_accesos_);
+    while (true) {
+        cv_volcado_accesos_.wait(lock, [this]() { return detener_volcado_accesos_ || volcado_accesos_solicitado_; });
+        if (detener_volcado_accesos_) {
+            return;
+        }
+        volcado_accesos_solicitado_ = false;
+        lock.unlock();
+        if (VolcarAccesosPendientes() != Status::OK) {
+            std::cerr << "Advertencia: No se pudieron volcar las marcas de acceso de los bloques" << std::endl;
+        }
+        lock.lock();
     }
 }
 
+void GestorDisco::DetenerVolcadoAccesos() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_accesos_);
+        detener_volcado_accesos_ = true;
+    }
+    cv_volcado_accesos_.notify_one();
+    if (hilo_volcado_accesos_.joinable()) {
+        hilo_volcado_accesos_.join();
+    }
+}
+
+uint64_t GestorDisco::ObtenerUltimoAcceso(BlockId id_bloque) const {
+    std::lock_guard<std::mutex> lock(mutex_accesos_);
+    auto it = tiempos_acceso_.find(id_bloque);
+    return (it != tiempos_acceso_.end()) ? it->second : 0;
+}
+
+Status GestorDisco::PuntoControlAccesos() {
+    return VolcarAccesosPendientes();
+}
+
+Status GestorDisco::SincronizarDatos() {
+    if (imagen_disco_ && imagen_disco_->EstaAbierta()) {
+        return imagen_disco_->Sincronizar();
+    }
+    return Status::OK;
+}
+
+/**
+ * @brief Escribe la tabla de accesos completa en un único archivo binario secuencial.
+ * Sustituye a la reescritura de la cabecera de cada bloque en cada lectura.
+ */
+Status GestorDisco::VolcarAccesosPendientes() {
+    std::lock_guard<std::mutex> lock_volcado(mutex_volcado_accesos_);
+
+    // Cabecera {magic, número de entradas} y las entradas, en un solo buffer. La
+    // tabla se copia bajo el mutex y el archivo se escribe sin él: las lecturas
+    // que registran accesos no esperan a la E/S.
+    std::vector<EntradaAccesoBloque> contenido;
+    uint32_t volcados = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_accesos_);
+        if (modo_registro_acceso_ != ModoRegistroAcceso::POR_LOTES || accesos_pendientes_ == 0) {
+            return Status::OK;
+        }
+        contenido.resize(1 + tiempos_acceso_.size());
+        contenido[0].id_bloque = MAGIC_ACCESOS_BLOQUES;
+        contenido[0].timestamp = tiempos_acceso_.size();
+        size_t i = 1;
+        for (const auto& par : tiempos_acceso_) {
+            contenido[i].id_bloque = par.first;
+            contenido[i].timestamp = par.second;
+            ++i;
+        }
+        volcados = accesos_pendientes_;
+    }
+
+    // Reemplazo atómico para no dejar un archivo a medias si se interrumpe el volcado
+    Status estado = EscribirArchivoAtomico(ObtenerRutaAccesos(), contenido.data(),
+                                           contenido.size() * sizeof(EntradaAccesoBloque));
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    // Los accesos registrados durante la escritura siguen pendientes
+    std::lock_guard<std::mutex> lock(mutex_accesos_);
+    accesos_pendientes_ -= std::min(volcados, accesos_pendientes_);
+    return Status::OK;
+}
+
+Status GestorDisco::CargarAccesosBloques() {
+    std::lock_guard<std::mutex> lock(mutex_accesos_);
+    tiempos_acceso_.clear();
+    accesos_pendientes_ = 0;
+    if (modo_registro_acceso_ != ModoRegistroAcceso::POR_LOTES) {
+        return Status::OK;
+    }
+
+    std::ifstream archivo_accesos(ObtenerRutaAccesos(), std::ios::binary);
+    if (!archivo_accesos.is_open()) {
+        return Status::OK; // Aún no se ha volcado ningún acceso
+    }
+
+    EntradaAccesoBloque cabecera{};
+    archivo_accesos.read(reinterpret_cast<char*>(&cabecera), sizeof(cabecera));
+    if (!archivo_accesos || cabecera.id_bloque != MAGIC_ACCESOS_BLOQUES) {
+        std::cerr << "Advertencia: Archivo de accesos no válido; se ignora" << std::endl;
+        return Status::INVALID_FORMAT;
+    }
+    std::vector<EntradaAccesoBloque> entradas(static_cast<size_t>(cabecera.timestamp));
+    archivo_accesos.read(reinterpret_cast<char*>(entradas.data()),
+                         static_cast<std::streamsize>(entradas.size() * sizeof(EntradaAccesoBloque)));
+    entradas.resize(static_cast<size_t>(archivo_accesos.gcount()) / sizeof(EntradaAccesoBloque));
+    tiempos_acceso_.reserve(entradas.size());
+    for (const auto& entrada : entradas) {
+        tiempos_acceso_[entrada.id_bloque] = entrada.timestamp;
+    }
+    return Status::OK;
+}
+
 /**
  * @brief Obtiene el número máximo de bloques que puede almacenar el disco
  * @return Número máximo de bloques
@@ -805,7 +1480,20 @@ uint32_t GestorDisco::ObtenerMaximoBloques() const {
  * @return Número de bloques en uso
  */
 uint32_t GestorDisco::ObtenerBloquesEnUso() const {
-    return static_cast<uint32_t>(bloques_activos_.size());
+    return static_cast<uint32_t>(asignacion_.ObtenerBloquesEnUso());
+}
+
+/**
+ * @brief Obtiene el número de bloques libres según el mapa de asignación
+ * @return Número de bloques libres
+ */
+uint32_t GestorDisco::ObtenerBloquesLibres() const {
+    uint64_t capacidad = asignacion_.ObtenerCapacidad();
+    if (capacidad == 0) {
+        return 0;
+    }
+    // El BlockId 0 está reservado y nunca se asigna
+    return static_cast<uint32_t>(capacidad - 1 - asignacion_.ObtenerBloquesEnUso());
 }
 
 /**
@@ -844,10 +1532,9 @@ double GestorDisco::ObtenerPorcentajeUso() const {
     std::cout << "Número total de cilindros (pistas): " << num_pistas_ << std::endl;
     
     for (uint32_t pista = 0; pista < std::min(static_cast<uint32_t>(5), num_pistas_); ++pista) {
-        const auto& cilindro = matrices_cilindros_[pista];
-        std::cout << "Cilindro " << pista << " (Pista " << cilindro.numero_pista << "):" << std::endl;
-        std::cout << "  Sectores libres: " << cilindro.sectores_libres_total << std::endl;
-        std::cout << "  Sectores totales: " << (num_platos_ * num_superficies_por_plato_ * num_sectores_por_pista_) << std::endl;
+        std::cout << "Cilindro " << pista << ":" << std::endl;
+        std::cout << "  Sectores libres: " << ObtenerSectoresLibresCilindro(pista) << std::endl;
+        std::cout << "  Sectores totales: " << ObtenerSectoresPorCilindro() << std::endl;
     }
     
     if (num_pistas_ > 5) {
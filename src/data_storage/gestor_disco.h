@@ -4,6 +4,9 @@
 #include "../include/common.h"     // Tipos básicos y Status
 #include "bloque.h"                // Clase Bloque
 #include "cabeceras_bloques.h"     // Estructuras de cabeceras
+#include "imagen_disco.h"          // Backend de imagen única con E/S posicional
+#include "mapa_asignacion.h"       // Mapa binario de bloques y sectores asignados
+#include "../include/metricas.h"   // Latencia de lectura/escritura por tipo de página
 #include <vector>
 #include <unordered_map>
 #include <array>
@@ -13,6 +16,9 @@
 #include <sstream>
 #include <mutex>
 #include <map>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
 
 #ifdef _WIN32
     #include <direct.h>  // _mkdir
@@ -115,16 +121,38 @@ struct Plato {
 };
 
 /**
- * @struct Cilindro
- * Representa un cilindro de disco (conjunto de pistas a la misma distancia del centro).
+ * @struct SolicitudES
+ * Una entrada de una operación de E/S por lotes (LeerBloques/EscribirBloques).
+ * En lectura 'buffer' es el destino; en escritura es el origen de los datos.
  */
-struct Cilindro {
-    uint32_t numero_pista; // El número de pista que define este cilindro
-    std::vector<DireccionFisica> sectores_en_cilindro; // Direcciones físicas de todos los sectores en este cilindro
+struct SolicitudES {
+    BlockId id_bloque;
+    Byte* buffer;
+    BlockSizeType tamano;
+    Status resultado;
+
+    SolicitudES(BlockId id, Byte* buf, BlockSizeType tam)
+        : id_bloque(id), buffer(buf), tamano(tam), resultado(Status::OK) {}
+};
 
-    Cilindro(uint32_t pista_idx) : numero_pista(pista_idx) {}
+/**
+ * @enum ModoAlmacenamiento
+ * Define cómo se guardan físicamente los bloques del disco simulado.
+ */
+enum class ModoAlmacenamiento : uint8_t {
+    ARCHIVO_POR_BLOQUE, // Un archivo por bloque dentro del árbol plato/superficie/pista
+    IMAGEN_UNICA        // Imagen preasignada con bloques en offsets fijos (pread/pwrite)
 };
 
+/**
+ * @enum ModoRegistroAcceso
+ * Define cómo se registra la marca de tiempo del último acceso a cada bloque.
+ */
+enum class ModoRegistroAcceso : uint8_t {
+    DESACTIVADO, // No se registran accesos: una lectura no genera ninguna escritura
+    EN_MEMORIA,  // Solo en memoria; se pierde al cerrar el disco
+    POR_LOTES    // En memoria y volcado por lotes en GuardarMetadatosDisco() o un punto de control
+};
 
 /**
  * @brief Gestor de Disco: Simula el almacenamiento persistente en un disco.
@@ -183,6 +211,24 @@ public:
      */
     Status EscribirBloque(BlockId id_bloque, const Byte* datos, BlockSizeType tamano_datos);
 
+    /**
+     * @brief Lee varios bloques en una sola llamada.
+     * Las solicitudes se ordenan por cilindro en orden de ascensor (SCAN) a partir
+     * de la posición actual del cabezal, y los bloques físicamente contiguos se
+     * leen con una única operación de E/S.
+     * @param solicitudes Lista de bloques a leer; cada entrada recibe su propio resultado.
+     * @return Status::OK si todas las lecturas tuvieron éxito, o el primer error encontrado.
+     */
+    Status LeerBloques(std::vector<SolicitudES>& solicitudes);
+
+    /**
+     * @brief Escribe varios bloques en una sola llamada, con el mismo orden y
+     *        agrupación que LeerBloques().
+     * @param solicitudes Lista de bloques a escribir; cada entrada recibe su propio resultado.
+     * @return Status::OK si todas las escrituras tuvieron éxito, o el primer error encontrado.
+     */
+    Status EscribirBloques(std::vector<SolicitudES>& solicitudes);
+
     /**
      * @brief Asigna un nuevo bloque lógico en el disco.
      * @param tipo_pagina Tipo de página para el nuevo bloque.
@@ -190,6 +236,19 @@ public:
      */
     BlockId AsignarBloque(PageType tipo_pagina);
 
+    /**
+     * @brief Asigna una extensión: bloques con BlockIds consecutivos en sectores
+     *        físicamente consecutivos, de modo que recorrerlos en orden es una lectura
+     *        secuencial que LeerBloques() agrupa en pocas operaciones de E/S.
+     * Si no queda un tramo libre de bloques_deseados bloques se prueba con la mitad,
+     * hasta un único bloque.
+     * @param tipo_pagina Tipo de página de todos los bloques.
+     * @param bloques_deseados Longitud pedida.
+     * @param bloques_asignados [out] Longitud obtenida (0 si falla).
+     * @return El primer BlockId de la extensión, o 0 si no hay espacio.
+     */
+    BlockId AsignarExtension(PageType tipo_pagina, uint32_t bloques_deseados, uint32_t& bloques_asignados);
+
     /**
      * @brief Desasigna un bloque lógico del disco, marcándolo como libre.
      * @param id_bloque ID del bloque a desasignar.
@@ -204,6 +263,14 @@ public:
      */
     bool ExisteBloque(BlockId id_bloque) const;
 
+    /**
+     * @brief Lista los bloques asignados de un tipo, en orden de BlockId.
+     * Solo consulta el mapa de asignación en memoria; no lee ningún bloque.
+     * @param tipo_pagina Tipo de página buscado.
+     * @return IDs de los bloques de ese tipo.
+     */
+    std::vector<BlockId> ListarBloquesPorTipo(PageType tipo_pagina) const;
+
     /**
      * @brief Obtiene el número total de bloques en el disco.
      * @return Número total de bloques.
@@ -227,6 +294,14 @@ public:
      */
     void ImprimirEstadisticas() const;
 
+    /**
+     * @brief Vuelca la asignación de bloques en texto legible, solo para depuración.
+     * La fuente de verdad es el archivo binario asignacion.bin.
+     * @param ruta Archivo de destino.
+     * @return Status de la operación.
+     */
+    Status ExportarMetadatosTexto(const std::string& ruta) const;
+
     /**
      * @brief Obtiene el espacio total del disco en bytes.
      * @return Espacio total en bytes.
@@ -251,6 +326,66 @@ public:
      */
     double ObtenerPorcentajeUso() const;
 
+    /**
+     * @brief Selecciona el backend de almacenamiento. Debe llamarse antes de Inicializar().
+     * @param modo Modo de almacenamiento deseado.
+     * @param bloques_por_segmento Solo para IMAGEN_UNICA: bloques por archivo de segmento (0 = un archivo).
+     */
+    void EstablecerModoAlmacenamiento(ModoAlmacenamiento modo, uint64_t bloques_por_segmento = 0);
+
+    ModoAlmacenamiento ObtenerModoAlmacenamiento() const { return modo_almacenamiento_; }
+
+    /**
+     * @brief Abre el disco en solo lectura. Debe llamarse antes de Inicializar().
+     *
+     * Con IMAGEN_UNICA la imagen se proyecta en memoria en vez de abrirse para
+     * pread/pwrite (ver ImagenDisco::AbrirSoloLectura), de modo que varias réplicas
+     * de consulta sobre la misma imagen arrancan sin leerla y comparten la caché de
+     * páginas. Escribir, asignar o liberar bloques devuelve OPERATION_FAILED, los
+     * metadatos no se guardan al cerrar y los accesos solo se registran EN_MEMORIA.
+     */
+    void EstablecerSoloLectura(bool solo_lectura);
+
+    bool EsSoloLectura() const { return solo_lectura_; }
+
+    /**
+     * @brief Configura el registro de la marca de tiempo de acceso de los bloques.
+     * @param modo Modo de registro.
+     * @param umbral_lote En modo POR_LOTES, número de accesos pendientes que dispara
+     *        un volcado automático en un hilo propio (0 = solo al guardar metadatos o
+     *        en punto de control).
+     */
+    void EstablecerModoRegistroAcceso(ModoRegistroAcceso modo, uint32_t umbral_lote = 0);
+
+    ModoRegistroAcceso ObtenerModoRegistroAcceso() const { return modo_registro_acceso_; }
+
+    /**
+     * @brief Vuelca a disco los accesos pendientes (modo POR_LOTES).
+     * @return Status de la operación.
+     */
+    Status PuntoControlAccesos();
+
+    /**
+     * @brief Fuerza a disco los bloques ya escritos (fsync de la imagen).
+     * En modo ARCHIVO_POR_BLOQUE no quedan descriptores abiertos y no hace nada.
+     * @return Status de la operación.
+     */
+    Status SincronizarDatos();
+
+    /**
+     * @brief Sectores libres de un cilindro, contados sobre el mapa de asignación.
+     * Los sectores de un cilindro son contiguos en el índice lineal, así que no
+     * hace falta ninguna tabla por cilindro ni por sector.
+     */
+    uint64_t ObtenerSectoresLibresCilindro(uint32_t pista) const;
+
+    /**
+     * @brief Obtiene la marca de tiempo del último acceso registrado a un bloque.
+     * @param id_bloque ID del bloque.
+     * @return Timestamp del último acceso, o 0 si no hay registro.
+     */
+    uint64_t ObtenerUltimoAcceso(BlockId id_bloque) const;
+
 private:
     // === Configuración del disco ===
     std::string ruta_base_;
@@ -265,10 +400,35 @@ private:
     std::string ultima_modificacion_;
 
     // === Estructuras de control ===
-    std::vector<Cilindro> cilindros_;
-    std::unordered_map<BlockId, DireccionFisica> mapeo_logico_fisico_;
-    std::vector<bool> bloques_libres_;
+    MapaAsignacionBloques asignacion_;    // Mapeo lógico → físico y bitmaps de ocupación (asignacion.bin)
     std::mutex mutex_;
+    bool solo_lectura_ = false;
+
+    // === Backend de imagen única ===
+    ModoAlmacenamiento modo_almacenamiento_ = ModoAlmacenamiento::ARCHIVO_POR_BLOQUE;
+    uint64_t bloques_por_segmento_ = 0;
+    std::unique_ptr<ImagenDisco> imagen_disco_;
+    std::once_flag apertura_imagen_;      // Varios hilos del buffer pueden pedir la imagen a la vez
+    Status estado_apertura_imagen_ = Status::OK;
+
+    // === Registro de accesos ===
+    std::atomic<ModoRegistroAcceso> modo_registro_acceso_{ModoRegistroAcceso::POR_LOTES}; // Se lee en cada lectura sin mutex
+    uint32_t umbral_lote_accesos_ = 0;
+    std::unordered_map<BlockId, uint64_t> tiempos_acceso_;
+    uint32_t accesos_pendientes_ = 0;
+    mutable std::mutex mutex_accesos_;
+    std::mutex mutex_volcado_accesos_;    // Serializa los volcados: el archivo no retrocede
+    std::thread hilo_volcado_accesos_;    // Volcados por umbral, fuera del hilo que lee
+    std::once_flag inicio_volcado_accesos_;
+    std::condition_variable cv_volcado_accesos_;
+    bool volcado_accesos_solicitado_ = false; // Protegida por mutex_accesos_
+    bool detener_volcado_accesos_ = false;    // Protegida por mutex_accesos_
+
+    // === E/S por lotes ===
+    static constexpr uint32_t MAX_BLOQUES_COALESCIDOS = 64; // Bloques máximos por operación agrupada
+    uint32_t pista_cabezal_ = 0;         // Posición simulada del cabezal (cilindro actual)
+    bool cabezal_ascendente_ = true;     // Sentido actual del recorrido SCAN
+    std::mutex mutex_planificador_;
 
     // === Métodos auxiliares privados ===
     std::string ObtenerRutaDisco() const;
@@ -277,6 +437,7 @@ private:
     DireccionFisica ObtenerDireccionFisica(BlockId id_bloque) const;
     Status CrearEstructuraDirectorios() const;
     Status CargarMetadatosDisco();
+    Status CargarMetadatosTexto();                          // Discos sin metadatos.bin
     Status ActualizarMetadatos();
     Status GuardarMetadatosDisco();
     Status ActualizarFechaModificacion();
@@ -286,9 +447,50 @@ private:
     uint64_t StringToTimestamp(const std::string& timestamp_str) const;
 
     /**
-     * @brief Inicializa la estructura de cilindros del disco.
+     * @brief Valida la geometría cargada. Las direcciones físicas se derivan del
+     *        índice lineal, así que no se reserva nada por cilindro ni por sector.
+     */
+    void InicializarGeometria();
+
+    Status CrearArchivoBloque(BlockId id_bloque);           // Solo ARCHIVO_POR_BLOQUE
+
+    /**
+     * @brief Instantánea binaria de la configuración del disco (metadatos.bin),
+     *        leída al arrancar con una sola lectura en lugar de interpretar texto.
      */
-    void InicializarCilindros();
+    std::string ObtenerRutaInstantaneaMetadatos() const;
+    Status GuardarInstantaneaMetadatos();
+    Status CargarInstantaneaMetadatos();                    // NOT_FOUND si no existe
+
+    /**
+     * @brief Posición de una dirección física dentro de la imagen de disco.
+     * El orden es cilindro → plato → superficie → sector, de modo que los sectores
+     * de un mismo cilindro quedan contiguos en el archivo.
+     */
+    uint64_t CalcularIndiceLineal(const DireccionFisica& direccion) const;
+    DireccionFisica DireccionDesdeIndiceLineal(uint64_t indice) const; // Inversa de CalcularIndiceLineal
+    std::string ObtenerRutaAsignacion() const;
+    uint64_t ObtenerNumeroSectoresTotales() const;
+    uint64_t ObtenerSectoresPorCilindro() const;
+    std::string ObtenerRutaImagen() const;
+    Status AbrirImagenDisco();
+    Status LeerBloqueImagen(BlockId id_bloque, Byte* buffer, BlockSizeType tamano_buffer);
+    Status EscribirBloqueImagen(BlockId id_bloque, const Byte* datos, BlockSizeType tamano_datos);
+
+    struct SolicitudPlanificada {
+        SolicitudES* solicitud;
+        uint64_t indice_lineal;
+        uint32_t pista;
+    };
+    std::vector<SolicitudPlanificada> PlanificarSolicitudes(std::vector<SolicitudES>& solicitudes);
+    Status EjecutarLoteES(std::vector<SolicitudES>& solicitudes, bool es_escritura);
+
+    std::string ObtenerRutaAccesos() const;
+    void RegistrarAccesoBloque(BlockId id_bloque);
+    Status VolcarAccesosPendientes();
+    void BucleVolcadoAccesos();
+    void DetenerVolcadoAccesos();
+    Status CargarAccesosBloques();
 };
 
 #endif // GESTOR_DISCO_H
@@ -0,0 +1,745 @@
+// data_storage/gestor_wal.cpp - Registro de escritura anticipada (WAL) con confirmación en grupo
+#include "gestor_wal.h"
+#include "gestor_buffer.h"
+#include "cabeceras_bloques.h"
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    // Sin pread/pwrite: se emulan con lseek + read/write bajo un mutex.
+    static std::mutex g_mutex_posicion_wal;
+#else
+    #include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Cabecera de cada registro en el log; los datos van a continuación.
+ */
+struct CabeceraRegistroWAL {
+    uint32_t longitud;      // Bytes del registro, cabecera incluida
+    uint32_t crc;           // CRC32 de datos y cabecera, con este campo a cero
+    LSN lsn;                // Posición del registro + longitud
+    BlockId id_bloque;
+    uint32_t slot;
+    uint8_t tipo;
+    uint8_t reservado[7];
+};
+static_assert(sizeof(CabeceraRegistroWAL) == 32, "La cabecera de registro del WAL debe ocupar 32 bytes");
+
+/**
+ * @brief Contenido de wal.control.
+ */
+struct ControlWAL {
+    uint32_t magic;
+    uint32_t version;
+    LSN lsn_rehacer;
+    LSN posicion_punto_control;
+    uint32_t crc;
+    uint32_t reservado;
+};
+
+constexpr uint32_t MAX_DATOS_REGISTRO_WAL = 1u << 20; // Un registro mayor se considera corrupto
+
+uint32_t Crc32(const void* datos, size_t longitud, uint32_t crc = 0) {
+    static const std::array<uint32_t, 256> tabla = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    const uint8_t* p = static_cast<const uint8_t*>(datos);
+    crc = ~crc;
+    for (size_t i = 0; i < longitud; ++i) {
+        crc = tabla[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+int AbrirArchivo(const std::string& ruta, bool crear) {
+#ifdef _WIN32
+    return _open(ruta.c_str(), _O_RDWR | _O_BINARY | (crear ? _O_CREAT : 0), _S_IREAD | _S_IWRITE);
+#else
+    return open(ruta.c_str(), O_RDWR | (crear ? O_CREAT : 0), 0644);
+#endif
+}
+
+void CerrarArchivo(int descriptor) {
+#ifdef _WIN32
+    _close(descriptor);
+#else
+    close(descriptor);
+#endif
+}
+
+bool SincronizarArchivo(int descriptor) {
+#ifdef _WIN32
+    return _commit(descriptor) == 0;
+#else
+    return fsync(descriptor) == 0;
+#endif
+}
+
+bool TruncarArchivo(int descriptor, uint64_t tamano) {
+#ifdef _WIN32
+    return _chsize_s(descriptor, static_cast<__int64>(tamano)) == 0;
+#else
+    return ftruncate(descriptor, static_cast<off_t>(tamano)) == 0;
+#endif
+}
+
+// La creación o el borrado de un archivo solo es duradero tras sincronizar su directorio
+void SincronizarDirectorio(const std::string& directorio) {
+#ifndef _WIN32
+    int descriptor = open(directorio.c_str(), O_RDONLY);
+    if (descriptor >= 0) {
+        fsync(descriptor);
+        close(descriptor);
+    }
+#else
+    (void)directorio;
+#endif
+}
+
+bool EscribirEn(int descriptor, const Byte* datos, uint64_t longitud, uint64_t offset) {
+#ifdef _WIN32
+    std::lock_guard<std::mutex> lock(g_mutex_posicion_wal);
+    if (_lseeki64(descriptor, static_cast<__int64>(offset), SEEK_SET) < 0) return false;
+#endif
+    uint64_t escritos = 0;
+    while (escritos < longitud) {
+#ifdef _WIN32
+        int n = _write(descriptor, datos + escritos, static_cast<unsigned int>(longitud - escritos));
+#else
+        ssize_t n = pwrite(descriptor, datos + escritos, longitud - escritos, static_cast<off_t>(offset + escritos));
+#endif
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        escritos += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+bool LeerEn(int descriptor, Byte* datos, uint64_t longitud, uint64_t offset, uint64_t& leidos) {
+#ifdef _WIN32
+    std::lock_guard<std::mutex> lock(g_mutex_posicion_wal);
+    if (_lseeki64(descriptor, static_cast<__int64>(offset), SEEK_SET) < 0) return false;
+#endif
+    leidos = 0;
+    while (leidos < longitud) {
+#ifdef _WIN32
+        int n = _read(descriptor, datos + leidos, static_cast<unsigned int>(longitud - leidos));
+#else
+        ssize_t n = pread(descriptor, datos + leidos, longitud - leidos, static_cast<off_t>(offset + leidos));
+#endif
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (n == 0) break; // Fin del segmento
+        leidos += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+// ===== CONSTRUCCIÓN Y APERTURA =====
+
+GestorWAL::GestorWAL(const std::string& directorio, const OpcionesWAL& opciones)
+    : directorio_(directorio), opciones_(opciones) {
+    if (directorio_.empty() || opciones_.tamano_segmento < 2 * sizeof(CabeceraRegistroWAL)) {
+        throw std::invalid_argument("GestorWAL: directorio vacío o segmento demasiado pequeño");
+    }
+}
+
+GestorWAL::~GestorWAL() {
+    if (abierto_) {
+        if (Confirmar() != Status::OK) {
+            std::cerr << "Error (Destructor GestorWAL): No se pudo escribir la cola del log." << std::endl;
+        }
+    }
+    CerrarSegmentos();
+}
+
+std::string GestorWAL::RutaSegmento(uint64_t numero) const {
+    char nombre[32];
+    std::snprintf(nombre, sizeof(nombre), "wal.%06llu", static_cast<unsigned long long>(numero));
+    return (std::filesystem::path(directorio_) / nombre).string();
+}
+
+std::string GestorWAL::RutaControl() const {
+    return (std::filesystem::path(directorio_) / "wal.control").string();
+}
+
+Status GestorWAL::ListarSegmentos(std::vector<uint64_t>& segmentos) const {
+    segmentos.clear();
+    std::error_code error;
+    for (const auto& entrada : std::filesystem::directory_iterator(directorio_, error)) {
+        std::string nombre = entrada.path().filename().string();
+        if (nombre.size() != 10 || nombre.compare(0, 4, "wal.") != 0 ||
+            nombre.find_first_not_of("0123456789", 4) != std::string::npos) {
+            continue;
+        }
+        segmentos.push_back(std::stoull(nombre.substr(4)));
+    }
+    if (error) {
+        std::cerr << "Error (GestorWAL): No se pudo listar " << directorio_ << ": " << error.message() << std::endl;
+        return Status::IO_ERROR;
+    }
+    std::sort(segmentos.begin(), segmentos.end());
+    return Status::OK;
+}
+
+Status GestorWAL::Abrir() {
+    if (abierto_) {
+        return Status::OK;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(directorio_, error);
+
+    LSN lsn_rehacer = 0;
+    LSN posicion_punto_control = 0;
+    Status estado = LeerControl(lsn_rehacer, posicion_punto_control);
+    if (estado != Status::OK) {
+        if (estado != Status::NOT_FOUND) {
+            std::cerr << "Advertencia (GestorWAL): wal.control no es válido; se recorre el log desde el primer segmento." << std::endl;
+        }
+        // Sin punto de control nunca se ha borrado un segmento: el primero empieza en un registro
+        std::vector<uint64_t> segmentos;
+        if (ListarSegmentos(segmentos) != Status::OK) {
+            return Status::IO_ERROR;
+        }
+        lsn_rehacer = segmentos.empty() ? 0 : segmentos.front() * opciones_.tamano_segmento;
+        posicion_punto_control = lsn_rehacer;
+    }
+
+    // El final del log es el primer registro incompleto o corrupto a partir del punto de rehacer
+    LSN fin = lsn_rehacer;
+    uint64_t registros = 0;
+    RegistroWAL registro;
+    while (LeerRegistro(fin, registro) == Status::OK) {
+        fin = registro.lsn;
+        registros++;
+    }
+    estado = Truncar(fin);
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer_.clear();
+        inicio_buffer_ = fin;
+        siguiente_lsn_ = fin;
+        lsn_duradero_.store(fin);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_punto_control_);
+        lsn_rehacer_ = lsn_rehacer;
+        posicion_punto_control_ = posicion_punto_control;
+        fin_punto_control_.store(fin);
+    }
+    abierto_ = true;
+    std::cout << "GestorWAL: Log abierto en " << directorio_ << " (" << registros
+              << " registro(s) desde el punto de rehacer " << lsn_rehacer << ", fin en " << fin << ")." << std::endl;
+    return Status::OK;
+}
+
+// ===== AÑADIR Y CONFIRMAR =====
+
+LSN GestorWAL::Añadir(TipoRegistroWAL tipo, BlockId id_bloque, uint32_t slot, const Byte* datos, uint32_t longitud) {
+    if (!abierto_ || (longitud > 0 && datos == nullptr) || longitud > MAX_DATOS_REGISTRO_WAL) {
+        std::cerr << "Error (GestorWAL::Añadir): Log cerrado o registro no válido." << std::endl;
+        return LSN_INVALIDO;
+    }
+    CabeceraRegistroWAL cabecera{};
+    cabecera.longitud = static_cast<uint32_t>(sizeof(CabeceraRegistroWAL)) + longitud;
+    cabecera.id_bloque = id_bloque;
+    cabecera.slot = slot;
+    cabecera.tipo = static_cast<uint8_t>(tipo);
+    // Los datos se resumen fuera del mutex; la cabecera (con el LSN) dentro
+    uint32_t crc_datos = Crc32(datos, longitud);
+
+    LSN lsn;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lsn = siguiente_lsn_ + cabecera.longitud;
+        cabecera.lsn = lsn;
+        cabecera.crc = 0;
+        cabecera.crc = Crc32(&cabecera, sizeof(cabecera), crc_datos);
+        const Byte* bytes_cabecera = reinterpret_cast<const Byte*>(&cabecera);
+        buffer_.insert(buffer_.end(), bytes_cabecera, bytes_cabecera + sizeof(cabecera));
+        buffer_.insert(buffer_.end(), datos, datos + longitud);
+        siguiente_lsn_ = lsn;
+    }
+    std::lock_guard<std::mutex> lock_estadisticas(mutex_estadisticas_);
+    estadisticas_.registros++;
+    estadisticas_.bytes += cabecera.longitud;
+    return lsn;
+}
+
+LSN GestorWAL::LSNFinal() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return siguiente_lsn_;
+}
+
+Status GestorWAL::AsegurarDuradero(LSN lsn) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    LSN objetivo = std::min(lsn, siguiente_lsn_);
+    while (lsn_duradero_.load() < objetivo) {
+        if (escribiendo_) {
+            // Otro hilo está escribiendo: esperar a su fsync o a ser el siguiente líder
+            cv_duradero_.wait(lock);
+            continue;
+        }
+        escribiendo_ = true;
+        if (opciones_.espera_grupo_us > 0) {
+            lock.unlock();
+            std::this_thread::sleep_for(std::chrono::microseconds(opciones_.espera_grupo_us));
+            lock.lock();
+        }
+        std::vector<Byte> lote;
+        lote.swap(buffer_);
+        LSN desde = inicio_buffer_;
+        LSN hasta = siguiente_lsn_;
+        inicio_buffer_ = hasta;
+        lock.unlock();
+
+        std::vector<uint64_t> tocados;
+        Status estado = EscribirTramo(desde, lote.data(), lote.size(), tocados);
+        uint64_t sincronizaciones = 0;
+        if (estado == Status::OK && opciones_.sincronizar) {
+            std::lock_guard<std::mutex> lock_segmentos(mutex_segmentos_);
+            for (uint64_t numero : tocados) {
+                auto it = descriptores_.find(numero);
+                if (it == descriptores_.end() || !SincronizarArchivo(it->second)) {
+                    std::cerr << "Error (GestorWAL): fsync falló en " << RutaSegmento(numero) << std::endl;
+                    estado = Status::IO_ERROR;
+                    break;
+                }
+                sincronizaciones++;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock_estadisticas(mutex_estadisticas_);
+            estadisticas_.escrituras++;
+            estadisticas_.sincronizaciones += sincronizaciones;
+        }
+
+        lock.lock();
+        escribiendo_ = false;
+        if (estado != Status::OK) {
+            // Devolver el lote delante de lo añadido mientras tanto para reintentarlo
+            lote.insert(lote.end(), buffer_.begin(), buffer_.end());
+            buffer_.swap(lote);
+            inicio_buffer_ = desde;
+            cv_duradero_.notify_all();
+            return estado;
+        }
+        lsn_duradero_.store(hasta);
+        cv_duradero_.notify_all();
+    }
+    return Status::OK;
+}
+
+Status GestorWAL::Confirmar() {
+    {
+        std::lock_guard<std::mutex> lock_estadisticas(mutex_estadisticas_);
+        estadisticas_.confirmaciones++;
+    }
+    return AsegurarDuradero(LSNFinal());
+}
+
+// ===== RECUPERACIÓN Y PUNTO DE CONTROL =====
+
+Status GestorWAL::Recuperar(GestorBuffer& gestor_buffer, const AplicadorRegistro& aplicador) {
+    if (!abierto_) {
+        return Status::ERROR;
+    }
+    gestor_buffer.EstablecerWAL(this);
+
+    LSN posicion;
+    LSN fin;
+    {
+        std::lock_guard<std::mutex> lock(mutex_punto_control_);
+        posicion = lsn_rehacer_;
+    }
+    fin = LSNDuradero();
+
+    uint64_t rehechos = 0;
+    uint64_t omitidos = 0;
+    uint64_t fallidos = 0;
+    std::vector<BlockId> bloques_catalogo; // Se escriben fuera del buffer: no deben quedarse en él
+    RegistroWAL registro;
+    while (posicion < fin && LeerRegistro(posicion, registro) == Status::OK) {
+        LSN inicio = posicion;
+        posicion = registro.lsn;
+        if (registro.tipo == TipoRegistroWAL::PUNTO_CONTROL || registro.id_bloque == INVALID_PAGE_ID) {
+            continue;
+        }
+        Byte* datos_pagina = nullptr;
+        if (gestor_buffer.PinPage(registro.id_bloque, datos_pagina) != Status::OK || !datos_pagina) {
+            std::cerr << "Advertencia (GestorWAL::Recuperar): No se pudo anclar el bloque " << registro.id_bloque
+                      << "; se omite el registro " << registro.lsn << "." << std::endl;
+            fallidos++;
+            continue;
+        }
+        CabeceraComun* cabecera = reinterpret_cast<CabeceraComun*>(datos_pagina);
+        LSN lsn_pagina = (cabecera->magic_number == MAGIC_NUMBER_SGBD) ? cabecera->lsn_pagina : LSN_INVALIDO;
+        if (registro.tipo == TipoRegistroWAL::IMAGEN_PAGINA &&
+            registro.datos.size() >= sizeof(CabeceraComun) &&
+            reinterpret_cast<const CabeceraComun*>(registro.datos.data())->tipo_pagina == PageType::CATALOG) {
+            bloques_catalogo.push_back(registro.id_bloque);
+        }
+        if (lsn_pagina >= registro.lsn) {
+            // La página ya llegó al disco con este cambio
+            gestor_buffer.UnpinPage(registro.id_bloque, false);
+            omitidos++;
+            continue;
+        }
+        gestor_buffer.MarcarModificada(registro.id_bloque, inicio);
+        Status estado = aplicador(registro, datos_pagina);
+        if (estado == Status::OK) {
+            cabecera->lsn_pagina = registro.lsn;
+            rehechos++;
+        } else {
+            std::cerr << "Advertencia (GestorWAL::Recuperar): El registro " << registro.lsn << " no se pudo aplicar al bloque "
+                      << registro.id_bloque << ": " << StatusToString(estado) << std::endl;
+            fallidos++;
+        }
+        gestor_buffer.UnpinPage(registro.id_bloque, estado == Status::OK);
+    }
+    {
+        std::lock_guard<std::mutex> lock_estadisticas(mutex_estadisticas_);
+        estadisticas_.registros_rehechos = rehechos;
+        estadisticas_.registros_recuperados = rehechos + omitidos + fallidos;
+    }
+    std::cout << "GestorWAL: Recuperación terminada (" << rehechos << " rehechos, " << omitidos
+              << " ya aplicados, " << fallidos << " omitidos por error)." << std::endl;
+
+    // El catálogo se lee del disco sin pasar por el buffer: las páginas rehechas
+    // tienen que estar escritas antes de cargarlo
+    Status estado_volcado = gestor_buffer.FlushAllPages();
+    if (estado_volcado != Status::OK) {
+        std::cerr << "Error (GestorWAL::Recuperar): No se pudieron escribir las páginas rehechas." << std::endl;
+        return estado_volcado;
+    }
+    for (BlockId id_bloque : bloques_catalogo) {
+        gestor_buffer.DescartarPagina(id_bloque);
+    }
+    return PuntoControl(gestor_buffer);
+}
+
+Status GestorWAL::PuntoControl(GestorBuffer& gestor_buffer) {
+    if (!abierto_) {
+        return Status::ERROR;
+    }
+    std::lock_guard<std::mutex> lock_punto_control(mutex_punto_control_);
+
+    // Las páginas sucias desde antes del punto de control anterior se escriben ahora;
+    // las demás fijan el punto de rehacer con su LSN de recuperación
+    LSN lsn_rehacer = LSNFinal();
+    Status estado = gestor_buffer.VolcarParaPuntoControl(posicion_punto_control_, lsn_rehacer);
+    if (estado != Status::OK) {
+        std::cerr << "Error (GestorWAL::PuntoControl): No se pudieron escribir las páginas pendientes." << std::endl;
+        return estado;
+    }
+
+    Byte carga[sizeof(LSN)];
+    std::memcpy(carga, &lsn_rehacer, sizeof(LSN));
+    LSN lsn = Añadir(TipoRegistroWAL::PUNTO_CONTROL, INVALID_PAGE_ID, 0, carga, sizeof(carga));
+    if (lsn == LSN_INVALIDO) {
+        return Status::ERROR;
+    }
+    LSN posicion = lsn - sizeof(CabeceraRegistroWAL) - sizeof(carga);
+    estado = AsegurarDuradero(lsn);
+    if (estado == Status::OK) {
+        estado = EscribirControl(lsn_rehacer, posicion);
+    }
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    lsn_rehacer_ = lsn_rehacer;
+    posicion_punto_control_ = posicion;
+    fin_punto_control_.store(lsn);
+    EliminarSegmentosAnteriores(lsn_rehacer);
+
+    std::lock_guard<std::mutex> lock_estadisticas(mutex_estadisticas_);
+    estadisticas_.puntos_control++;
+    return Status::OK;
+}
+
+bool GestorWAL::NecesitaPuntoControl() const {
+    return abierto_ && LSNFinal() - fin_punto_control_.load() >= opciones_.bytes_entre_puntos_control;
+}
+
+// ===== SEGMENTOS =====
+
+int GestorWAL::ObtenerDescriptor(uint64_t numero_segmento, bool crear) {
+    std::lock_guard<std::mutex> lock(mutex_segmentos_);
+    auto it = descriptores_.find(numero_segmento);
+    if (it != descriptores_.end()) {
+        return it->second;
+    }
+    std::string ruta = RutaSegmento(numero_segmento);
+    bool existia = std::filesystem::exists(ruta);
+    if (!existia && !crear) {
+        return -1;
+    }
+    int descriptor = AbrirArchivo(ruta, crear);
+    if (descriptor < 0) {
+        std::cerr << "Error (GestorWAL): No se pudo abrir " << ruta << ": " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    if (!existia) {
+        SincronizarDirectorio(directorio_);
+    }
+    descriptores_[numero_segmento] = descriptor;
+    return descriptor;
+}
+
+void GestorWAL::CerrarSegmentos() {
+    std::lock_guard<std::mutex> lock(mutex_segmentos_);
+    for (const auto& entrada : descriptores_) {
+        CerrarArchivo(entrada.second);
+    }
+    descriptores_.clear();
+}
+
+Status GestorWAL::EscribirTramo(LSN posicion, const Byte* datos, uint64_t longitud, std::vector<uint64_t>& tocados) {
+    while (longitud > 0) {
+        uint64_t numero = posicion / opciones_.tamano_segmento;
+        uint64_t offset = posicion % opciones_.tamano_segmento;
+        uint64_t cantidad = std::min(longitud, opciones_.tamano_segmento - offset);
+        int descriptor = ObtenerDescriptor(numero, true);
+        if (descriptor < 0 || !EscribirEn(descriptor, datos, cantidad, offset)) {
+            std::cerr << "Error (GestorWAL): Fallo de escritura en " << RutaSegmento(numero) << std::endl;
+            return (errno == ENOSPC) ? Status::DISK_FULL : Status::IO_ERROR;
+        }
+        tocados.push_back(numero);
+        posicion += cantidad;
+        datos += cantidad;
+        longitud -= cantidad;
+    }
+    return Status::OK;
+}
+
+Status GestorWAL::LeerTramo(LSN posicion, Byte* datos, uint64_t longitud, uint64_t& leidos) {
+    leidos = 0;
+    while (leidos < longitud) {
+        uint64_t numero = posicion / opciones_.tamano_segmento;
+        uint64_t offset = posicion % opciones_.tamano_segmento;
+        uint64_t cantidad = std::min(longitud - leidos, opciones_.tamano_segmento - offset);
+        int descriptor = ObtenerDescriptor(numero, false);
+        if (descriptor < 0) {
+            return Status::OK; // Segmento inexistente: el log termina aquí
+        }
+        uint64_t leidos_segmento = 0;
+        if (!LeerEn(descriptor, datos + leidos, cantidad, offset, leidos_segmento)) {
+            std::cerr << "Error (GestorWAL): Fallo de lectura en " << RutaSegmento(numero) << std::endl;
+            return Status::IO_ERROR;
+        }
+        leidos += leidos_segmento;
+        posicion += leidos_segmento;
+        if (leidos_segmento < cantidad) {
+            break;
+        }
+    }
+    return Status::OK;
+}
+
+Status GestorWAL::LeerRegistro(LSN posicion, RegistroWAL& registro) {
+    CabeceraRegistroWAL cabecera;
+    uint64_t leidos = 0;
+    Status estado = LeerTramo(posicion, reinterpret_cast<Byte*>(&cabecera), sizeof(cabecera), leidos);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    if (leidos == 0) {
+        return Status::NOT_FOUND;
+    }
+    if (leidos < sizeof(cabecera) || cabecera.longitud < sizeof(cabecera) ||
+        cabecera.longitud - sizeof(cabecera) > MAX_DATOS_REGISTRO_WAL ||
+        cabecera.lsn != posicion + cabecera.longitud) {
+        return Status::INVALID_FORMAT;
+    }
+
+    registro.datos.resize(cabecera.longitud - sizeof(cabecera));
+    estado = LeerTramo(posicion + sizeof(cabecera), registro.datos.data(), registro.datos.size(), leidos);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    if (leidos < registro.datos.size()) {
+        return Status::INVALID_FORMAT;
+    }
+    uint32_t crc = cabecera.crc;
+    cabecera.crc = 0;
+    if (Crc32(&cabecera, sizeof(cabecera), Crc32(registro.datos.data(), registro.datos.size())) != crc) {
+        return Status::INVALID_FORMAT;
+    }
+
+    registro.lsn = cabecera.lsn;
+    registro.tipo = static_cast<TipoRegistroWAL>(cabecera.tipo);
+    registro.id_bloque = cabecera.id_bloque;
+    registro.slot = cabecera.slot;
+    return Status::OK;
+}
+
+Status GestorWAL::Truncar(LSN fin) {
+    std::vector<uint64_t> segmentos;
+    if (ListarSegmentos(segmentos) != Status::OK) {
+        return Status::IO_ERROR;
+    }
+    uint64_t segmento_fin = fin / opciones_.tamano_segmento;
+    bool borrados = false;
+    for (uint64_t numero : segmentos) {
+        if (numero < segmento_fin) continue;
+        if (numero == segmento_fin) {
+            int descriptor = ObtenerDescriptor(numero, false);
+            if (descriptor < 0 || !TruncarArchivo(descriptor, fin % opciones_.tamano_segmento)) {
+                std::cerr << "Error (GestorWAL): No se pudo recortar " << RutaSegmento(numero) << std::endl;
+                return Status::IO_ERROR;
+            }
+            continue;
+        }
+        // Posterior al final: solo puede contener restos de una escritura interrumpida
+        {
+            std::lock_guard<std::mutex> lock(mutex_segmentos_);
+            auto it = descriptores_.find(numero);
+            if (it != descriptores_.end()) {
+                CerrarArchivo(it->second);
+                descriptores_.erase(it);
+            }
+        }
+        std::error_code error;
+        std::filesystem::remove(RutaSegmento(numero), error);
+        borrados = true;
+    }
+    if (borrados) {
+        SincronizarDirectorio(directorio_);
+    }
+    return Status::OK;
+}
+
+void GestorWAL::EliminarSegmentosAnteriores(LSN lsn) {
+    std::vector<uint64_t> segmentos;
+    if (ListarSegmentos(segmentos) != Status::OK) {
+        return;
+    }
+    uint64_t eliminados = 0;
+    for (uint64_t numero : segmentos) {
+        if ((numero + 1) * opciones_.tamano_segmento > lsn) break;
+        {
+            std::lock_guard<std::mutex> lock(mutex_segmentos_);
+            auto it = descriptores_.find(numero);
+            if (it != descriptores_.end()) {
+                CerrarArchivo(it->second);
+                descriptores_.erase(it);
+            }
+        }
+        std::error_code error;
+        if (std::filesystem::remove(RutaSegmento(numero), error)) {
+            eliminados++;
+        }
+    }
+    if (eliminados > 0) {
+        std::lock_guard<std::mutex> lock_estadisticas(mutex_estadisticas_);
+        estadisticas_.segmentos_eliminados += eliminados;
+    }
+}
+
+// ===== ARCHIVO DE CONTROL =====
+
+Status GestorWAL::LeerControl(LSN& lsn_rehacer, LSN& posicion_punto_control) const {
+    std::ifstream archivo(RutaControl(), std::ios::binary);
+    if (!archivo.is_open()) {
+        return Status::NOT_FOUND;
+    }
+    ControlWAL control{};
+    archivo.read(reinterpret_cast<char*>(&control), sizeof(control));
+    if (!archivo || control.magic != MAGIC_CONTROL_WAL || control.version != VERSION_CONTROL_WAL) {
+        return Status::INVALID_FORMAT;
+    }
+    uint32_t crc = control.crc;
+    control.crc = 0;
+    if (Crc32(&control, sizeof(control)) != crc || control.posicion_punto_control < control.lsn_rehacer) {
+        return Status::INVALID_FORMAT;
+    }
+    lsn_rehacer = control.lsn_rehacer;
+    posicion_punto_control = control.posicion_punto_control;
+    return Status::OK;
+}
+
+Status GestorWAL::EscribirControl(LSN lsn_rehacer, LSN posicion_punto_control) {
+    ControlWAL control{};
+    control.magic = MAGIC_CONTROL_WAL;
+    control.version = VERSION_CONTROL_WAL;
+    control.lsn_rehacer = lsn_rehacer;
+    control.posicion_punto_control = posicion_punto_control;
+    control.crc = Crc32(&control, sizeof(control));
+
+    std::string ruta = RutaControl();
+    std::string ruta_temporal = ruta + ".tmp";
+    int descriptor = AbrirArchivo(ruta_temporal, true);
+    if (descriptor < 0) {
+        std::cerr << "Error (GestorWAL): No se pudo crear " << ruta_temporal << std::endl;
+        return Status::IO_ERROR;
+    }
+    bool correcto = TruncarArchivo(descriptor, 0) &&
+                    EscribirEn(descriptor, reinterpret_cast<const Byte*>(&control), sizeof(control), 0) &&
+                    SincronizarArchivo(descriptor);
+    CerrarArchivo(descriptor);
+    // Reemplazo atómico: una caída deja el punto de control anterior o el nuevo, nunca uno a medias
+    if (!correcto || std::rename(ruta_temporal.c_str(), ruta.c_str()) != 0) {
+        std::cerr << "Error (GestorWAL): No se pudo guardar " << ruta << std::endl;
+        return Status::IO_ERROR;
+    }
+    SincronizarDirectorio(directorio_);
+    return Status::OK;
+}
+
+// ===== ESTADÍSTICAS =====
+
+EstadisticasWAL GestorWAL::ObtenerEstadisticas() const {
+    std::lock_guard<std::mutex> lock(mutex_estadisticas_);
+    return estadisticas_;
+}
+
+void GestorWAL::ImprimirEstadisticas() const {
+    EstadisticasWAL estadisticas = ObtenerEstadisticas();
+    std::cout << "\n=== ESTADÍSTICAS DEL WAL ===" << std::endl;
+    std::cout << "Registros: " << estadisticas.registros << " (" << estadisticas.bytes << " bytes)" << std::endl;
+    std::cout << "Confirmaciones: " << estadisticas.confirmaciones << std::endl;
+    std::cout << "Escrituras del log: " << estadisticas.escrituras
+              << " (fsync: " << estadisticas.sincronizaciones << ")" << std::endl;
+    if (estadisticas.escrituras > 0) {
+        std::cout << "Confirmaciones por escritura: "
+                  << static_cast<double>(estadisticas.confirmaciones) / estadisticas.escrituras << std::endl;
+    }
+    std::cout << "Puntos de control: " << estadisticas.puntos_control
+              << " (segmentos eliminados: " << estadisticas.segmentos_eliminados << ")" << std::endl;
+    std::cout << "Registros rehechos en la última recuperación: " << estadisticas.registros_rehechos << std::endl;
+    std::cout << "LSN final: " << LSNFinal() << ", duradero: " << LSNDuradero() << std::endl;
+    std::cout << "---------------------------------------" << std::endl;
+}
@@ -0,0 +1,240 @@
+// data_storage/gestor_wal.h - Registro de escritura anticipada (WAL) con confirmación en grupo
+// Hace duradera cada operación con una escritura secuencial del log en lugar de FlushAllPages()
+
+#ifndef GESTOR_WAL_H
+#define GESTOR_WAL_H
+
+#include "../include/common.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class GestorBuffer;
+
+/**
+ * @brief Cambio físico-lógico registrado sobre una página de datos.
+ * Se rehace con las mismas operaciones de PaginaRanurada, que son deterministas:
+ * la misma página en el mismo estado vuelve a asignar el mismo slot.
+ */
+enum class TipoRegistroWAL : uint8_t {
+    INICIALIZAR_PAGINA = 1, // Página de datos nueva, vacía
+    INSERTAR,               // slot + bytes del registro
+    ACTUALIZAR,             // slot + bytes nuevos
+    ELIMINAR,               // slot
+    COMPACTAR,              // Reorganización de la página (sin datos)
+    IMAGEN_PAGINA,          // Página completa, para cambios sin registro específico
+    PUNTO_CONTROL           // LSN desde el que empieza la recuperación
+};
+
+/**
+ * @brief Registro del WAL ya leído o pendiente de añadir.
+ */
+struct RegistroWAL {
+    LSN lsn = LSN_INVALIDO;         // Fin del registro en el log; se copia a lsn_pagina al aplicarlo
+    TipoRegistroWAL tipo = TipoRegistroWAL::IMAGEN_PAGINA;
+    BlockId id_bloque = INVALID_PAGE_ID;
+    uint32_t slot = 0;
+    std::vector<Byte> datos;
+};
+
+struct OpcionesWAL {
+    uint64_t tamano_segmento = 16ull * 1024 * 1024;       // Bytes por archivo wal.NNNNNN
+    uint32_t espera_grupo_us = 0;                         // Espera del líder para juntar más confirmaciones
+    uint64_t bytes_entre_puntos_control = 4ull * 1024 * 1024; // NecesitaPuntoControl() a partir de aquí
+    bool sincronizar = true;                              // fsync tras cada escritura del log
+};
+
+struct EstadisticasWAL {
+    uint64_t registros = 0;
+    uint64_t bytes = 0;
+    uint64_t confirmaciones = 0;    // Llamadas a Confirmar()
+    uint64_t escrituras = 0;        // Escrituras del log (una por grupo)
+    uint64_t sincronizaciones = 0;  // fsync del log
+    uint64_t puntos_control = 0;
+    uint64_t segmentos_eliminados = 0;
+    uint64_t registros_rehechos = 0; // Aplicados en la última recuperación
+    uint64_t registros_recuperados = 0; // Posteriores al punto de control en la última recuperación (aplicados o no)
+};
+
+/**
+ * @brief Registro de escritura anticipada de un disco.
+ *
+ * El log es una secuencia de bytes repartida en segmentos de tamano_segmento
+ * bytes (wal.000000, wal.000001, ...); el LSN de un registro es la posición en
+ * esa secuencia del byte siguiente a su final, así que crece de forma monótona
+ * también entre reinicios y LSN_INVALIDO (0) no corresponde a ningún registro.
+ * Cada registro lleva longitud, CRC32 y su propio LSN, de modo que una cola a
+ * medio escribir se reconoce al abrir y se descarta.
+ *
+ * CONFIRMACIÓN EN GRUPO:
+ * - Añadir() solo copia el registro al buffer en memoria bajo mutex_.
+ * - Confirmar()/AsegurarDuradero() esperan a que el log sea duradero hasta un LSN.
+ *   El primer hilo que lo necesita hace de líder: se lleva el buffer entero, lo
+ *   escribe y hace fsync sin mantener mutex_. Los que llegan mientras tanto añaden
+ *   al buffer nuevo y esperan; el siguiente líder escribe todos sus registros con
+ *   un único fsync.
+ *
+ * REGLA WAL:
+ * - El GestorBuffer llama a AsegurarDuradero(lsn_pagina) antes de escribir una
+ *   página, así que una página nunca llega al disco antes que su log.
+ *
+ * PUNTO DE CONTROL (difuso):
+ * - No escribe todas las páginas sucias: solo las que no están cubiertas por el
+ *   log (catálogo, índices, mapas) y las sucias desde antes del punto de control
+ *   anterior. El punto de rehacer es el menor LSN de recuperación de las demás.
+ * - Guarda ese punto en wal.control (reemplazo atómico) y borra los segmentos
+ *   que quedan enteros por debajo.
+ */
+class GestorWAL {
+public:
+    /**
+     * @brief Aplica un registro a la página anclada durante la recuperación.
+     * Debe ser idempotente frente a una página escrita a mitad de la operación.
+     */
+    using AplicadorRegistro = std::function<Status(const RegistroWAL& registro, Byte* datos_pagina)>;
+
+    /**
+     * @param directorio Directorio del disco; el log vive en sus archivos wal.*
+     */
+    GestorWAL(const std::string& directorio, const OpcionesWAL& opciones = OpcionesWAL());
+
+    /**
+     * @brief Hace duradero lo pendiente y cierra los segmentos.
+     */
+    ~GestorWAL();
+
+    GestorWAL(const GestorWAL&) = delete;
+    GestorWAL& operator=(const GestorWAL&) = delete;
+
+    /**
+     * @brief Lee wal.control y busca el final del log desde el punto de rehacer.
+     * Una cola con un registro incompleto o con CRC erróneo se trunca.
+     * @return IO_ERROR si no se puede leer el directorio o un segmento
+     */
+    Status Abrir();
+
+    /**
+     * @brief Rehace sobre las páginas los registros posteriores al punto de control.
+     * Solo se aplica un registro si su LSN es mayor que el lsn_pagina de la página.
+     * Escribe las páginas rehechas y termina con un punto de control: el catálogo,
+     * que lee sus bloques directamente del disco, ve así las imágenes rehechas.
+     * Debe llamarse tras Abrir() y antes de cargar el catálogo o modificar nada.
+     * @param gestor_buffer Buffer del disco; el WAL queda asociado a él
+     * @param aplicador Aplica cada registro (lo proporciona el GestorRegistros)
+     * @return Status de la operación; las páginas que no se pueden anclar se saltan con un aviso
+     */
+    Status Recuperar(GestorBuffer& gestor_buffer, const AplicadorRegistro& aplicador);
+
+    /**
+     * @brief Añade un registro al buffer del log (no espera a disco).
+     * @return LSN del registro: el que debe copiarse a lsn_pagina
+     */
+    LSN Añadir(TipoRegistroWAL tipo, BlockId id_bloque, uint32_t slot, const Byte* datos, uint32_t longitud);
+
+    /**
+     * @brief Fin actual del log: el siguiente registro empezará aquí.
+     */
+    LSN LSNFinal() const;
+
+    LSN LSNDuradero() const { return lsn_duradero_.load(); }
+
+    /**
+     * @brief Espera a que el log sea duradero hasta lsn (como mucho hasta LSNFinal()).
+     * @return IO_ERROR si falla la escritura del log
+     */
+    Status AsegurarDuradero(LSN lsn);
+
+    /**
+     * @brief Punto de confirmación de una operación: AsegurarDuradero(LSNFinal()).
+     */
+    Status Confirmar();
+
+    /**
+     * @brief Punto de control difuso (ver descripción de la clase).
+     * Puede ejecutarse mientras otros hilos añaden y confirman registros, pero no a
+     * la vez que se modifican páginas de datos ancladas.
+     */
+    Status PuntoControl(GestorBuffer& gestor_buffer);
+
+    /**
+     * @brief true si el log ha crecido bytes_entre_puntos_control desde el último punto de control.
+     */
+    bool NecesitaPuntoControl() const;
+
+    EstadisticasWAL ObtenerEstadisticas() const;
+    void ImprimirEstadisticas() const;
+
+private:
+    static constexpr uint32_t MAGIC_CONTROL_WAL = 0x4C415757; // "WWAL"
+    static constexpr uint32_t VERSION_CONTROL_WAL = 1;
+
+    std::string directorio_;
+    OpcionesWAL opciones_;
+    bool abierto_ = false;
+
+    // Buffer en memoria y posiciones del log (mutex_)
+    mutable std::mutex mutex_;
+    std::condition_variable cv_duradero_;
+    std::vector<Byte> buffer_;
+    LSN inicio_buffer_ = 0;             // Posición en el log del primer byte de buffer_
+    LSN siguiente_lsn_ = 0;             // Fin del log (incluido lo que está en buffer_)
+    bool escribiendo_ = false;          // Hay un líder escribiendo
+    std::atomic<LSN> lsn_duradero_{0};  // Todo lo anterior está en disco
+
+    // Punto de control (mutex_punto_control_)
+    std::mutex mutex_punto_control_;
+    LSN lsn_rehacer_ = 0;               // La recuperación empieza aquí
+    LSN posicion_punto_control_ = 0;    // Inicio del último registro PUNTO_CONTROL
+    std::atomic<LSN> fin_punto_control_{0}; // LSNFinal() tras el último punto de control
+
+    // Segmentos abiertos, por número (mutex_segmentos_)
+    std::mutex mutex_segmentos_;
+    std::map<uint64_t, int> descriptores_;
+
+    mutable std::mutex mutex_estadisticas_;
+    EstadisticasWAL estadisticas_;
+
+    std::string RutaSegmento(uint64_t numero) const;
+    std::string RutaControl() const;
+
+    /**
+     * @brief Números de los segmentos presentes en el directorio, ordenados.
+     */
+    Status ListarSegmentos(std::vector<uint64_t>& segmentos) const;
+
+    int ObtenerDescriptor(uint64_t numero_segmento, bool crear);
+    void CerrarSegmentos();
+
+    /**
+     * @brief E/S de un tramo del log que puede cruzar límites de segmento.
+     * Leer devuelve en leidos los bytes disponibles (menos si el log termina antes).
+     */
+    Status EscribirTramo(LSN posicion, const Byte* datos, uint64_t longitud, std::vector<uint64_t>& tocados);
+    Status LeerTramo(LSN posicion, Byte* datos, uint64_t longitud, uint64_t& leidos);
+
+    /**
+     * @brief Lee el registro que empieza en posicion.
+     * @return NOT_FOUND al final del log; INVALID_FORMAT si está incompleto o corrupto
+     */
+    Status LeerRegistro(LSN posicion, RegistroWAL& registro);
+
+    /**
+     * @brief Deja el log exactamente hasta fin: recorta su segmento y borra los posteriores.
+     */
+    Status Truncar(LSN fin);
+
+    Status LeerControl(LSN& lsn_rehacer, LSN& posicion_punto_control) const;
+    Status EscribirControl(LSN lsn_rehacer, LSN posicion_punto_control);
+
+    /**
+     * @brief Borra los segmentos que terminan antes de lsn.
+     */
+    void EliminarSegmentosAnteriores(LSN lsn);
+};
+
+#endif // GESTOR_WAL_H
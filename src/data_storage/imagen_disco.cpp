@@ -0,0 +1,361 @@
+// data_storage/imagen_disco.cpp
+#include "imagen_disco.h"
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    // Windows no ofrece pread/pwrite: se emulan con lseek + read/write bajo un mutex.
+    static std::mutex g_mutex_posicion_imagen;
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+// ============================================
+// Construcción y apertura
+// ============================================
+
+ImagenDisco::ImagenDisco(const std::string& ruta_imagen, BlockSizeType tamano_bloque,
+                         uint64_t bloques_por_segmento)
+    : ruta_imagen_(ruta_imagen),
+      tamano_bloque_(tamano_bloque),
+      bloques_por_segmento_(bloques_por_segmento),
+      numero_bloques_(0) {
+    if (ruta_imagen_.empty() || tamano_bloque_ == 0) {
+        throw std::invalid_argument("ImagenDisco: ruta vacía o tamaño de bloque cero");
+    }
+}
+
+ImagenDisco::~ImagenDisco() {
+    Cerrar();
+}
+
+std::string ImagenDisco::ObtenerRutaSegmento(uint32_t numero_segmento) const {
+    if (bloques_por_segmento_ == 0) {
+        return ruta_imagen_;
+    }
+    char sufijo[16];
+    std::snprintf(sufijo, sizeof(sufijo), ".%03u", numero_segmento);
+    return ruta_imagen_ + sufijo;
+}
+
+Status ImagenDisco::Abrir(uint64_t numero_bloques, bool preasignar) {
+    if (EstaAbierta()) {
+        return Status::OK;
+    }
+    if (numero_bloques == 0) {
+        std::cerr << "Error (ImagenDisco::Abrir): La imagen debe tener al menos un bloque." << std::endl;
+        return Status::INVALID_ARGUMENT;
+    }
+
+    numero_bloques_ = numero_bloques;
+    uint64_t bloques_segmento = (bloques_por_segmento_ == 0) ? numero_bloques_ : bloques_por_segmento_;
+    uint32_t numero_segmentos = static_cast<uint32_t>((numero_bloques_ + bloques_segmento - 1) / bloques_segmento);
+
+    for (uint32_t i = 0; i < numero_segmentos; ++i) {
+        std::string ruta = ObtenerRutaSegmento(i);
+#ifdef _WIN32
+        int descriptor = _open(ruta.c_str(), _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        int descriptor = open(ruta.c_str(), O_RDWR | O_CREAT, 0644);
+#endif
+        if (descriptor < 0) {
+            std::cerr << "Error (ImagenDisco::Abrir): No se pudo abrir el segmento " << ruta
+                      << ": " << std::strerror(errno) << std::endl;
+            Cerrar();
+            return Status::IO_ERROR;
+        }
+        segmentos_.push_back({ruta, descriptor});
+
+        // Último segmento puede ser más corto que el resto.
+        uint64_t bloques_en_segmento = std::min<uint64_t>(bloques_segmento,
+                                                          numero_bloques_ - static_cast<uint64_t>(i) * bloques_segmento);
+        uint64_t tamano_segmento = bloques_en_segmento * tamano_bloque_;
+
+        if (preasignar) {
+#ifdef _WIN32
+            int resultado = _chsize_s(descriptor, static_cast<__int64>(tamano_segmento));
+#elif defined(__linux__)
+            // posix_fallocate reserva los bloques reales; si el sistema de archivos
+            // no lo soporta se recurre a ftruncate (archivo disperso).
+            int resultado = posix_fallocate(descriptor, 0, static_cast<off_t>(tamano_segmento));
+            if (resultado != 0) {
+                resultado = ftruncate(descriptor, static_cast<off_t>(tamano_segmento));
+            }
+#else
+            int resultado = ftruncate(descriptor, static_cast<off_t>(tamano_segmento));
+#endif
+            if (resultado != 0) {
+                std::cerr << "Error (ImagenDisco::Abrir): No se pudo reservar espacio para " << ruta << std::endl;
+                Cerrar();
+                return Status::DISK_FULL;
+            }
+        }
+    }
+
+    std::cout << "ImagenDisco: Abierta " << ruta_imagen_ << " (" << numero_bloques_ << " bloques de "
+              << tamano_bloque_ << " bytes, " << segmentos_.size() << " segmento(s))." << std::endl;
+    return Status::OK;
+}
+
+Status ImagenDisco::AbrirSoloLectura(uint64_t numero_bloques) {
+    if (EstaAbierta()) {
+        return solo_lectura_ ? Status::OK : Status::RESOURCE_BUSY;
+    }
+    if (numero_bloques == 0) {
+        std::cerr << "Error (ImagenDisco::AbrirSoloLectura): La imagen debe tener al menos un bloque." << std::endl;
+        return Status::INVALID_ARGUMENT;
+    }
+
+    numero_bloques_ = numero_bloques;
+    solo_lectura_ = true;
+    uint64_t bloques_segmento = (bloques_por_segmento_ == 0) ? numero_bloques_ : bloques_por_segmento_;
+    uint32_t numero_segmentos = static_cast<uint32_t>((numero_bloques_ + bloques_segmento - 1) / bloques_segmento);
+
+    for (uint32_t i = 0; i < numero_segmentos; ++i) {
+        std::string ruta = ObtenerRutaSegmento(i);
+#ifdef _WIN32
+        int descriptor = _open(ruta.c_str(), _O_RDONLY | _O_BINARY);
+#else
+        int descriptor = open(ruta.c_str(), O_RDONLY);
+#endif
+        if (descriptor < 0) {
+            std::cerr << "Error (ImagenDisco::AbrirSoloLectura): No se pudo abrir el segmento " << ruta
+                      << ": " << std::strerror(errno) << std::endl;
+            Cerrar();
+            return (errno == ENOENT) ? Status::NOT_FOUND : Status::IO_ERROR;
+        }
+        segmentos_.push_back({ruta, descriptor});
+
+        uint64_t bloques_en_segmento = std::min<uint64_t>(bloques_segmento,
+                                                          numero_bloques_ - static_cast<uint64_t>(i) * bloques_segmento);
+        uint64_t tamano_segmento = bloques_en_segmento * tamano_bloque_;
+#ifndef _WIN32
+        // Una imagen creada con Abrir() está preasignada: un segmento corto no es de esta geometría
+        struct stat informacion;
+        if (fstat(descriptor, &informacion) != 0 || static_cast<uint64_t>(informacion.st_size) < tamano_segmento) {
+            std::cerr << "Error (ImagenDisco::AbrirSoloLectura): El segmento " << ruta
+                      << " es más corto que " << tamano_segmento << " bytes." << std::endl;
+            Cerrar();
+            return Status::INVALID_FORMAT;
+        }
+        void* proyeccion = mmap(nullptr, tamano_segmento, PROT_READ, MAP_SHARED, descriptor, 0);
+        if (proyeccion == MAP_FAILED) {
+            std::cerr << "Error (ImagenDisco::AbrirSoloLectura): mmap falló en " << ruta
+                      << ": " << std::strerror(errno) << std::endl;
+            Cerrar();
+            return Status::IO_ERROR;
+        }
+        segmentos_.back().proyeccion = static_cast<const Byte*>(proyeccion);
+        segmentos_.back().tamano_proyeccion = tamano_segmento;
+#endif
+    }
+
+    std::cout << "ImagenDisco: Abierta en solo lectura " << ruta_imagen_ << " (" << numero_bloques_
+              << " bloques, " << segmentos_.size() << " segmento(s) proyectado(s))." << std::endl;
+    return Status::OK;
+}
+
+void ImagenDisco::Cerrar() {
+    for (auto& segmento : segmentos_) {
+#ifndef _WIN32
+        if (segmento.proyeccion) {
+            munmap(const_cast<Byte*>(segmento.proyeccion), segmento.tamano_proyeccion);
+            segmento.proyeccion = nullptr;
+        }
+#endif
+        if (segmento.descriptor >= 0) {
+#ifdef _WIN32
+            _close(segmento.descriptor);
+#else
+            close(segmento.descriptor);
+#endif
+            segmento.descriptor = -1;
+        }
+    }
+    segmentos_.clear();
+    solo_lectura_ = false;
+}
+
+// ============================================
+// E/S posicional
+// ============================================
+
+Status ImagenDisco::LocalizarBloque(uint64_t indice_bloque, uint32_t cantidad,
+                                    const Segmento*& segmento_bloque, uint64_t& offset) const {
+    if (!EstaAbierta()) {
+        return Status::ERROR;
+    }
+    if (cantidad == 0 || indice_bloque + cantidad > numero_bloques_) {
+        return Status::INVALID_BLOCK_ID;
+    }
+
+    uint64_t bloques_segmento = (bloques_por_segmento_ == 0) ? numero_bloques_ : bloques_por_segmento_;
+    uint64_t segmento = indice_bloque / bloques_segmento;
+    uint64_t indice_local = indice_bloque % bloques_segmento;
+
+    // Una operación contigua no puede cruzar el límite de un segmento.
+    if (indice_local + cantidad > bloques_segmento) {
+        return Status::INVALID_ARGUMENT;
+    }
+
+    segmento_bloque = &segmentos_[segmento];
+    offset = indice_local * tamano_bloque_;
+    return Status::OK;
+}
+
+Status ImagenDisco::LeerPosicional(int descriptor, Byte* buffer, uint64_t tamano, uint64_t offset) {
+    uint64_t leidos = 0;
+#ifdef _WIN32
+    std::lock_guard<std::mutex> lock(g_mutex_posicion_imagen);
+    if (_lseeki64(descriptor, static_cast<__int64>(offset), SEEK_SET) < 0) {
+        return Status::IO_ERROR;
+    }
+#endif
+    while (leidos < tamano) {
+#ifdef _WIN32
+        int n = _read(descriptor, buffer + leidos, static_cast<unsigned int>(tamano - leidos));
+#else
+        ssize_t n = pread(descriptor, buffer + leidos, tamano - leidos, static_cast<off_t>(offset + leidos));
+#endif
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error (ImagenDisco): Fallo de lectura en offset " << offset
+                      << ": " << std::strerror(errno) << std::endl;
+            return Status::IO_ERROR;
+        }
+        if (n == 0) {
+            // Región nunca escrita de una imagen dispersa: se lee como ceros.
+            std::memset(buffer + leidos, 0, tamano - leidos);
+            break;
+        }
+        leidos += static_cast<uint64_t>(n);
+    }
+
+    std::lock_guard<std::mutex> lock_estadisticas(mutex_estadisticas_);
+    estadisticas_.lecturas++;
+    estadisticas_.bytes_leidos += tamano;
+    return Status::OK;
+}
+
+Status ImagenDisco::EscribirPosicional(int descriptor, const Byte* datos, uint64_t tamano, uint64_t offset) {
+    uint64_t escritos = 0;
+#ifdef _WIN32
+    std::lock_guard<std::mutex> lock(g_mutex_posicion_imagen);
+    if (_lseeki64(descriptor, static_cast<__int64>(offset), SEEK_SET) < 0) {
+        return Status::IO_ERROR;
+    }
+#endif
+    while (escritos < tamano) {
+#ifdef _WIN32
+        int n = _write(descriptor, datos + escritos, static_cast<unsigned int>(tamano - escritos));
+#else
+        ssize_t n = pwrite(descriptor, datos + escritos, tamano - escritos, static_cast<off_t>(offset + escritos));
+#endif
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error (ImagenDisco): Fallo de escritura en offset " << offset
+                      << ": " << std::strerror(errno) << std::endl;
+            return (errno == ENOSPC) ? Status::DISK_FULL : Status::IO_ERROR;
+        }
+        escritos += static_cast<uint64_t>(n);
+    }
+
+    std::lock_guard<std::mutex> lock_estadisticas(mutex_estadisticas_);
+    estadisticas_.escrituras++;
+    estadisticas_.bytes_escritos += tamano;
+    return Status::OK;
+}
+
+// ============================================
+// Operaciones sobre bloques
+// ============================================
+
+Status ImagenDisco::LeerBloque(uint64_t indice_bloque, Byte* buffer) {
+    return LeerBloquesContiguos(indice_bloque, 1, buffer);
+}
+
+Status ImagenDisco::EscribirBloque(uint64_t indice_bloque, const Byte* datos, BlockSizeType tamano_datos) {
+    if (datos == nullptr || tamano_datos > tamano_bloque_) {
+        return Status::INVALID_ARGUMENT;
+    }
+    if (tamano_datos == tamano_bloque_) {
+        return EscribirBloquesContiguos(indice_bloque, 1, datos);
+    }
+
+    // Escritura parcial: completar el bloque con ceros para no dejar restos antiguos.
+    std::vector<Byte> bloque_completo(tamano_bloque_, 0);
+    std::memcpy(bloque_completo.data(), datos, tamano_datos);
+    return EscribirBloquesContiguos(indice_bloque, 1, bloque_completo.data());
+}
+
+Status ImagenDisco::LeerBloquesContiguos(uint64_t indice_inicial, uint32_t cantidad, Byte* buffer) {
+    if (buffer == nullptr) {
+        return Status::INVALID_ARGUMENT;
+    }
+    const Segmento* segmento = nullptr;
+    uint64_t offset = 0;
+    Status estado = LocalizarBloque(indice_inicial, cantidad, segmento, offset);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    uint64_t tamano = static_cast<uint64_t>(cantidad) * tamano_bloque_;
+    if (segmento->proyeccion) {
+        std::memcpy(buffer, segmento->proyeccion + offset, tamano);
+        std::lock_guard<std::mutex> lock_estadisticas(mutex_estadisticas_);
+        estadisticas_.lecturas++;
+        estadisticas_.bytes_leidos += tamano;
+        return Status::OK;
+    }
+    return LeerPosicional(segmento->descriptor, buffer, tamano, offset);
+}
+
+Status ImagenDisco::EscribirBloquesContiguos(uint64_t indice_inicial, uint32_t cantidad, const Byte* datos) {
+    if (datos == nullptr) {
+        return Status::INVALID_ARGUMENT;
+    }
+    if (solo_lectura_) {
+        std::cerr << "Error (ImagenDisco): La imagen está abierta en solo lectura." << std::endl;
+        return Status::OPERATION_FAILED;
+    }
+    const Segmento* segmento = nullptr;
+    uint64_t offset = 0;
+    Status estado = LocalizarBloque(indice_inicial, cantidad, segmento, offset);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    return EscribirPosicional(segmento->descriptor, datos, static_cast<uint64_t>(cantidad) * tamano_bloque_, offset);
+}
+
+Status ImagenDisco::Sincronizar() {
+    if (solo_lectura_) {
+        return Status::OK; // Nada que forzar
+    }
+    for (const auto& segmento : segmentos_) {
+#ifdef _WIN32
+        int resultado = _commit(segmento.descriptor);
+#else
+        int resultado = fsync(segmento.descriptor);
+#endif
+        if (resultado != 0) {
+            std::cerr << "Error (ImagenDisco::Sincronizar): fsync falló en " << segmento.ruta << std::endl;
+            return Status::IO_ERROR;
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_estadisticas_);
+    estadisticas_.sincronizaciones++;
+    return Status::OK;
+}
+
+EstadisticasImagenDisco ImagenDisco::ObtenerEstadisticas() const {
+    std::lock_guard<std::mutex> lock(mutex_estadisticas_);
+    return estadisticas_;
+}
@@ -0,0 +1,156 @@
+#ifndef IMAGEN_DISCO_H
+#define IMAGEN_DISCO_H
+
+#include "../include/common.h"     // Tipos básicos y Status
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @struct EstadisticasImagenDisco
+ * Contadores de E/S de la imagen de disco.
+ */
+struct EstadisticasImagenDisco {
+    uint64_t lecturas = 0;
+    uint64_t escrituras = 0;
+    uint64_t bytes_leidos = 0;
+    uint64_t bytes_escritos = 0;
+    uint64_t sincronizaciones = 0;
+};
+
+/**
+ * @brief Imagen de disco en uno o varios archivos de segmento preasignados.
+ *
+ * Cada bloque ocupa una posición fija dentro de la imagen:
+ *   offset = indice_bloque * tamano_bloque
+ * Los descriptores de archivo permanecen abiertos mientras la imagen está abierta
+ * y el acceso se hace con E/S posicional (pread/pwrite), por lo que no hay
+ * apertura/cierre de archivos ni búsqueda en directorios por cada bloque.
+ *
+ * Si bloques_por_segmento es 0 toda la imagen vive en un único archivo;
+ * en otro caso se reparte en segmentos "<ruta>.000", "<ruta>.001", ...
+ *
+ * Abierta con AbrirSoloLectura() cada segmento se proyecta en memoria (mmap de
+ * solo lectura, compartido): abrir no lee nada, leer un bloque es una copia desde
+ * la proyección y varios procesos sobre la misma imagen comparten la caché de
+ * páginas del sistema. Las escrituras fallan.
+ */
+class ImagenDisco {
+public:
+    /**
+     * @brief Constructor de la imagen de disco.
+     * @param ruta_imagen Ruta del archivo de imagen (o prefijo de los segmentos).
+     * @param tamano_bloque Tamaño de cada bloque en bytes.
+     * @param bloques_por_segmento Bloques por archivo de segmento (0 = un solo archivo).
+     */
+    ImagenDisco(const std::string& ruta_imagen, BlockSizeType tamano_bloque,
+                uint64_t bloques_por_segmento = 0);
+
+    /**
+     * @brief Destructor. Cierra los descriptores abiertos.
+     */
+    ~ImagenDisco();
+
+    ImagenDisco(const ImagenDisco&) = delete;
+    ImagenDisco& operator=(const ImagenDisco&) = delete;
+
+    /**
+     * @brief Abre (o crea) la imagen con capacidad para numero_bloques bloques.
+     * @param numero_bloques Número total de bloques de la imagen.
+     * @param preasignar Si es true reserva el espacio en el sistema de archivos.
+     * @return Status de la operación.
+     */
+    Status Abrir(uint64_t numero_bloques, bool preasignar = true);
+
+    /**
+     * @brief Abre una imagen existente en solo lectura proyectándola en memoria.
+     * Donde no hay mmap (Windows) los segmentos se abren en solo lectura y se leen con E/S posicional.
+     * @param numero_bloques Número total de bloques de la imagen.
+     * @return NOT_FOUND si falta un segmento; INVALID_FORMAT si es más corto de lo esperado.
+     */
+    Status AbrirSoloLectura(uint64_t numero_bloques);
+
+    /**
+     * @brief Cierra todos los segmentos de la imagen.
+     */
+    void Cerrar();
+
+    bool EstaAbierta() const { return !segmentos_.empty(); }
+    bool EsSoloLectura() const { return solo_lectura_; }
+
+    /**
+     * @brief Lee un bloque completo de la imagen.
+     * @param indice_bloque Posición del bloque dentro de la imagen.
+     * @param buffer Buffer destino (al menos tamano_bloque bytes).
+     * @return Status de la operación.
+     */
+    Status LeerBloque(uint64_t indice_bloque, Byte* buffer);
+
+    /**
+     * @brief Escribe un bloque en la imagen. Si tamano_datos es menor que el
+     *        tamaño del bloque, el resto del bloque se rellena con ceros.
+     * @param indice_bloque Posición del bloque dentro de la imagen.
+     * @param datos Datos a escribir.
+     * @param tamano_datos Tamaño de los datos (como máximo tamano_bloque).
+     * @return Status de la operación.
+     */
+    Status EscribirBloque(uint64_t indice_bloque, const Byte* datos, BlockSizeType tamano_datos);
+
+    /**
+     * @brief Lee 'cantidad' bloques consecutivos con una sola operación cuando
+     *        no cruzan un límite de segmento.
+     * @param indice_inicial Posición del primer bloque.
+     * @param cantidad Número de bloques consecutivos.
+     * @param buffer Buffer destino (al menos cantidad * tamano_bloque bytes).
+     * @return Status de la operación.
+     */
+    Status LeerBloquesContiguos(uint64_t indice_inicial, uint32_t cantidad, Byte* buffer);
+
+    /**
+     * @brief Escribe 'cantidad' bloques consecutivos con una sola operación
+     *        cuando no cruzan un límite de segmento.
+     * @param indice_inicial Posición del primer bloque.
+     * @param cantidad Número de bloques consecutivos.
+     * @param datos Datos a escribir (cantidad * tamano_bloque bytes).
+     * @return Status de la operación.
+     */
+    Status EscribirBloquesContiguos(uint64_t indice_inicial, uint32_t cantidad, const Byte* datos);
+
+    /**
+     * @brief Fuerza a disco los datos escritos (fsync de cada segmento).
+     * @return Status de la operación.
+     */
+    Status Sincronizar();
+
+    uint64_t ObtenerNumeroBloques() const { return numero_bloques_; }
+    BlockSizeType ObtenerTamanoBloque() const { return tamano_bloque_; }
+    EstadisticasImagenDisco ObtenerEstadisticas() const;
+
+private:
+    struct Segmento {
+        std::string ruta;
+        int descriptor;
+        const Byte* proyeccion = nullptr;   // Solo lectura: segmento proyectado en memoria
+        uint64_t tamano_proyeccion = 0;
+    };
+
+    std::string ruta_imagen_;
+    BlockSizeType tamano_bloque_;
+    uint64_t bloques_por_segmento_;
+    uint64_t numero_bloques_;
+    std::vector<Segmento> segmentos_;
+    bool solo_lectura_ = false;
+
+    // Solo protege las estadísticas: pread/pwrite son seguros entre hilos.
+    mutable std::mutex mutex_estadisticas_;
+    EstadisticasImagenDisco estadisticas_;
+
+    std::string ObtenerRutaSegmento(uint32_t numero_segmento) const;
+    Status LocalizarBloque(uint64_t indice_bloque, uint32_t cantidad,
+                           const Segmento*& segmento, uint64_t& offset) const;
+    Status LeerPosicional(int descriptor, Byte* buffer, uint64_t tamano, uint64_t offset);
+    Status EscribirPosicional(int descriptor, const Byte* datos, uint64_t tamano, uint64_t offset);
+};
+
+#endif // IMAGEN_DISCO_H
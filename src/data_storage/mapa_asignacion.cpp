@@ -0,0 +1,393 @@
+// data_storage/mapa_asignacion.cpp
+#include "mapa_asignacion.h"
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+uint64_t RedondearAPagina(uint64_t bytes) {
+    const uint64_t pagina = MapaAsignacionBloques::TAMAÑO_PAGINA_METADATOS;
+    return (bytes + pagina - 1) / pagina * pagina;
+}
+
+uint64_t PalabrasParaBits(uint64_t bits) {
+    return (bits + 63) / 64;
+}
+
+} // namespace
+
+// ============================================
+// Construcción y apertura
+// ============================================
+
+MapaAsignacionBloques::MapaAsignacionBloques()
+    : capacidad_(0),
+      offset_bits_bloques_(0),
+      offset_bits_sectores_(0),
+      offset_tabla_(0),
+      siguiente_bloque_busqueda_(1),
+      hay_paginas_sucias_(false),
+      solo_lectura_(false) {
+}
+
+MapaAsignacionBloques::~MapaAsignacionBloques() {
+    Cerrar();
+}
+
+void MapaAsignacionBloques::CalcularDisposicion(uint64_t capacidad) {
+    capacidad_ = capacidad;
+    uint64_t bytes_mapa = PalabrasParaBits(capacidad_) * sizeof(uint64_t);
+    offset_bits_bloques_ = TAMAÑO_PAGINA_METADATOS;
+    offset_bits_sectores_ = offset_bits_bloques_ + RedondearAPagina(bytes_mapa);
+    offset_tabla_ = offset_bits_sectores_ + RedondearAPagina(bytes_mapa);
+    uint64_t tamaño_total = offset_tabla_ + RedondearAPagina(capacidad_ * sizeof(EntradaMapeo));
+    imagen_.assign(tamaño_total, 0);
+    paginas_sucias_.assign(PalabrasParaBits(tamaño_total / TAMAÑO_PAGINA_METADATOS), 0);
+    hay_paginas_sucias_ = false;
+}
+
+Status MapaAsignacionBloques::Abrir(const std::string& ruta, uint64_t capacidad, bool solo_lectura) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (archivo_.is_open()) {
+        return Status::OK;
+    }
+    if (capacidad < 2) {
+        std::cerr << "Error (MapaAsignacionBloques::Abrir): Capacidad insuficiente." << std::endl;
+        return Status::INVALID_ARGUMENT;
+    }
+    ruta_ = ruta;
+    solo_lectura_ = solo_lectura;
+    CalcularDisposicion(capacidad);
+
+    std::ifstream existente(ruta_, std::ios::binary);
+    if (!existente.is_open() && solo_lectura_) {
+        std::cerr << "Error: El archivo de asignación " << ruta_ << " no existe (apertura en solo lectura)." << std::endl;
+        return Status::NOT_FOUND;
+    }
+    if (existente.is_open()) {
+        existente.read(reinterpret_cast<char*>(imagen_.data()), static_cast<std::streamsize>(imagen_.size()));
+        if (static_cast<uint64_t>(existente.gcount()) != imagen_.size() ||
+            Cabecera()->magic_number != MAGIC_MAPA_ASIGNACION ||
+            Cabecera()->version != VERSION_MAPA_ASIGNACION ||
+            Cabecera()->capacidad != capacidad_) {
+            std::cerr << "Error: El archivo de asignación " << ruta_
+                      << " está dañado o no corresponde a la geometría del disco." << std::endl;
+            return Status::INVALID_FORMAT;
+        }
+        existente.close();
+        archivo_.open(ruta_, solo_lectura_ ? (std::ios::in | std::ios::binary)
+                                           : (std::ios::in | std::ios::out | std::ios::binary));
+    } else {
+        // Archivo nuevo: todo libre salvo el BlockId 0, que está reservado
+        CabeceraMapaAsignacion* cabecera = Cabecera();
+        cabecera->magic_number = MAGIC_MAPA_ASIGNACION;
+        cabecera->version = VERSION_MAPA_ASIGNACION;
+        cabecera->capacidad = capacidad_;
+        cabecera->bloques_en_uso = 0;
+        EntradaMapeo* tabla = Tabla();
+        for (uint64_t i = 0; i < capacidad_; ++i) {
+            tabla[i].indice_sector = SIN_SECTOR;
+            tabla[i].tipo_pagina = PageType::FREE;
+        }
+        BitsBloques()[0] |= 1ULL;
+        archivo_.open(ruta_, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (archivo_.is_open()) {
+            archivo_.write(reinterpret_cast<const char*>(imagen_.data()), static_cast<std::streamsize>(imagen_.size()));
+            archivo_.close();
+        }
+        archivo_.open(ruta_, std::ios::in | std::ios::out | std::ios::binary);
+    }
+
+    if (!archivo_.is_open() || !archivo_.good()) {
+        std::cerr << "Error: No se pudo abrir el archivo de asignación " << ruta_ << std::endl;
+        archivo_.close();
+        return Status::IO_ERROR;
+    }
+    siguiente_bloque_busqueda_ = 1;
+    return Status::OK;
+}
+
+void MapaAsignacionBloques::Cerrar() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!archivo_.is_open()) {
+        return;
+    }
+    SincronizarSinBloqueo();
+    archivo_.close();
+}
+
+// ============================================
+// Asignación y consulta
+// ============================================
+
+uint64_t MapaAsignacionBloques::BuscarBitLibre(const uint64_t* palabras, uint64_t num_bits, uint64_t desde) {
+    if (num_bits == 0) {
+        return num_bits;
+    }
+    const uint64_t num_palabras = PalabrasParaBits(num_bits);
+    if (desde >= num_bits) {
+        desde = 0;
+    }
+    uint64_t palabra_inicial = desde / 64;
+    for (uint64_t n = 0; n <= num_palabras; ++n) {
+        uint64_t p = (palabra_inicial + n) % num_palabras;
+        uint64_t libres = ~palabras[p];
+        if (n == 0) {
+            libres &= ~0ULL << (desde % 64); // En la primera palabra, solo a partir de 'desde'
+        }
+        if (libres == 0) {
+            continue;
+        }
+        uint64_t bit = p * 64 + static_cast<uint64_t>(__builtin_ctzll(libres));
+        if (bit < num_bits) {
+            return bit;
+        }
+    }
+    return num_bits;
+}
+
+uint64_t MapaAsignacionBloques::BuscarTramoLibre(const uint64_t* palabras, uint64_t num_bits, uint64_t longitud, uint64_t desde) {
+    if (longitud == 0 || longitud > num_bits) {
+        return num_bits;
+    }
+    if (desde >= num_bits) {
+        desde = 0;
+    }
+    // Segunda pasada: tramos que empiezan antes de 'desde' (pueden terminar después)
+    for (int pasada = 0; pasada < 2; ++pasada) {
+        uint64_t inicio = (pasada == 0) ? desde : 0;
+        uint64_t limite = (pasada == 0) ? num_bits : std::min(num_bits, desde + longitud - 1);
+        uint64_t libres_seguidos = 0;
+        for (uint64_t i = inicio; i < limite;) {
+            uint64_t palabra = palabras[i / 64];
+            if (i % 64 == 0 && i + 64 <= limite && (palabra == 0 || palabra == ~0ULL)) {
+                libres_seguidos = (palabra == 0) ? libres_seguidos + 64 : 0;
+                i += 64;
+            } else {
+                libres_seguidos = ((palabra >> (i % 64)) & 1ULL) ? 0 : libres_seguidos + 1;
+                ++i;
+            }
+            if (libres_seguidos >= longitud) {
+                return i - libres_seguidos;
+            }
+        }
+    }
+    return num_bits;
+}
+
+BlockId MapaAsignacionBloques::AsignarBloque(PageType tipo_pagina, uint64_t sector_sugerido, uint64_t& sector_asignado) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    sector_asignado = SIN_SECTOR;
+    if (!archivo_.is_open() || solo_lectura_ || Cabecera()->bloques_en_uso + 1 >= capacidad_) {
+        return 0;
+    }
+
+    uint64_t bloque = BuscarBitLibre(BitsBloques(), capacidad_, siguiente_bloque_busqueda_);
+    uint64_t sector = BuscarBitLibre(BitsSectores(), capacidad_, sector_sugerido);
+    if (bloque >= capacidad_ || sector >= capacidad_ || bloque == 0) {
+        return 0;
+    }
+
+    BitsBloques()[bloque / 64] |= (1ULL << (bloque % 64));
+    BitsSectores()[sector / 64] |= (1ULL << (sector % 64));
+    MarcarSucioBit(offset_bits_bloques_, bloque);
+    MarcarSucioBit(offset_bits_sectores_, sector);
+
+    EntradaMapeo& entrada = Tabla()[bloque];
+    entrada.indice_sector = sector;
+    entrada.tipo_pagina = tipo_pagina;
+    MarcarSucio(offset_tabla_ + bloque * sizeof(EntradaMapeo), sizeof(EntradaMapeo));
+
+    Cabecera()->bloques_en_uso++;
+    MarcarSucio(0, sizeof(CabeceraMapaAsignacion));
+
+    siguiente_bloque_busqueda_ = bloque + 1;
+    sector_asignado = sector;
+    return static_cast<BlockId>(bloque);
+}
+
+BlockId MapaAsignacionBloques::AsignarExtension(PageType tipo_pagina, uint64_t numero_bloques, uint64_t sector_sugerido, uint64_t& primer_sector) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    primer_sector = SIN_SECTOR;
+    if (!archivo_.is_open() || solo_lectura_ || numero_bloques == 0 ||
+        Cabecera()->bloques_en_uso + numero_bloques >= capacidad_) {
+        return 0;
+    }
+
+    uint64_t bloque = BuscarTramoLibre(BitsBloques(), capacidad_, numero_bloques, siguiente_bloque_busqueda_);
+    uint64_t sector = BuscarTramoLibre(BitsSectores(), capacidad_, numero_bloques, sector_sugerido);
+    if (bloque >= capacidad_ || sector >= capacidad_ || bloque == 0) {
+        return 0;
+    }
+
+    for (uint64_t i = 0; i < numero_bloques; ++i) {
+        BitsBloques()[(bloque + i) / 64] |= (1ULL << ((bloque + i) % 64));
+        BitsSectores()[(sector + i) / 64] |= (1ULL << ((sector + i) % 64));
+        MarcarSucioBit(offset_bits_bloques_, bloque + i);
+        MarcarSucioBit(offset_bits_sectores_, sector + i);
+
+        EntradaMapeo& entrada = Tabla()[bloque + i];
+        entrada.indice_sector = sector + i;
+        entrada.tipo_pagina = tipo_pagina;
+    }
+    MarcarSucio(offset_tabla_ + bloque * sizeof(EntradaMapeo), numero_bloques * sizeof(EntradaMapeo));
+
+    Cabecera()->bloques_en_uso += numero_bloques;
+    MarcarSucio(0, sizeof(CabeceraMapaAsignacion));
+
+    siguiente_bloque_busqueda_ = bloque + numero_bloques;
+    primer_sector = sector;
+    return static_cast<BlockId>(bloque);
+}
+
+Status MapaAsignacionBloques::LiberarBloque(BlockId id_bloque) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (id_bloque == 0 || id_bloque >= capacidad_) {
+        return Status::INVALID_BLOCK_ID;
+    }
+    if (solo_lectura_) {
+        return Status::OPERATION_FAILED;
+    }
+    EntradaMapeo& entrada = Tabla()[id_bloque];
+    if (entrada.indice_sector == SIN_SECTOR) {
+        return Status::NOT_FOUND;
+    }
+    uint64_t sector = entrada.indice_sector;
+    BitsBloques()[id_bloque / 64] &= ~(1ULL << (id_bloque % 64));
+    BitsSectores()[sector / 64] &= ~(1ULL << (sector % 64));
+    MarcarSucioBit(offset_bits_bloques_, id_bloque);
+    MarcarSucioBit(offset_bits_sectores_, sector);
+
+    entrada.indice_sector = SIN_SECTOR;
+    entrada.tipo_pagina = PageType::FREE;
+    MarcarSucio(offset_tabla_ + static_cast<uint64_t>(id_bloque) * sizeof(EntradaMapeo), sizeof(EntradaMapeo));
+
+    Cabecera()->bloques_en_uso--;
+    MarcarSucio(0, sizeof(CabeceraMapaAsignacion));
+    return Status::OK;
+}
+
+bool MapaAsignacionBloques::ObtenerSector(BlockId id_bloque, uint64_t& indice_sector) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id_bloque >= capacidad_) {
+        return false;
+    }
+    indice_sector = Tabla()[id_bloque].indice_sector;
+    return indice_sector != SIN_SECTOR;
+}
+
+bool MapaAsignacionBloques::EstaAsignado(BlockId id_bloque) const {
+    uint64_t sector;
+    return ObtenerSector(id_bloque, sector);
+}
+
+PageType MapaAsignacionBloques::ObtenerTipoPagina(BlockId id_bloque) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id_bloque >= capacidad_) {
+        return PageType::INVALID_PAGE;
+    }
+    return Tabla()[id_bloque].tipo_pagina;
+}
+
+uint64_t MapaAsignacionBloques::ObtenerBloquesEnUso() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return imagen_.empty() ? 0 : Cabecera()->bloques_en_uso;
+}
+
+uint64_t MapaAsignacionBloques::ContarSectoresOcupados(uint64_t primer_sector, uint64_t numero_sectores) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (imagen_.empty() || primer_sector >= capacidad_) {
+        return 0;
+    }
+    uint64_t fin = std::min(primer_sector + numero_sectores, capacidad_);
+    const uint64_t* palabras = BitsSectores();
+    uint64_t ocupados = 0;
+    uint64_t bit = primer_sector;
+    while (bit < fin) {
+        uint64_t palabra = palabras[bit / 64] >> (bit % 64);
+        uint64_t bits_en_palabra = std::min<uint64_t>(64 - bit % 64, fin - bit);
+        if (bits_en_palabra < 64) {
+            palabra &= (1ULL << bits_en_palabra) - 1;
+        }
+        ocupados += static_cast<uint64_t>(__builtin_popcountll(palabra));
+        bit += bits_en_palabra;
+    }
+    return ocupados;
+}
+
+// ============================================
+// Persistencia incremental
+// ============================================
+
+void MapaAsignacionBloques::MarcarSucio(uint64_t offset, uint64_t longitud) {
+    uint64_t primera = offset / TAMAÑO_PAGINA_METADATOS;
+    uint64_t ultima = (offset + longitud - 1) / TAMAÑO_PAGINA_METADATOS;
+    for (uint64_t p = primera; p <= ultima; ++p) {
+        paginas_sucias_[p / 64] |= (1ULL << (p % 64));
+    }
+    hay_paginas_sucias_ = true;
+}
+
+void MapaAsignacionBloques::MarcarSucioBit(uint64_t offset_mapa, uint64_t bit) {
+    MarcarSucio(offset_mapa + (bit / 64) * sizeof(uint64_t), sizeof(uint64_t));
+}
+
+Status MapaAsignacionBloques::Sincronizar() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return SincronizarSinBloqueo();
+}
+
+Status MapaAsignacionBloques::SincronizarSinBloqueo() {
+    if (!hay_paginas_sucias_) {
+        return Status::OK;
+    }
+    if (!archivo_.is_open()) {
+        return Status::IO_ERROR;
+    }
+    const uint64_t num_paginas = imagen_.size() / TAMAÑO_PAGINA_METADATOS;
+    uint64_t p = 0;
+    while (p < num_paginas) {
+        if (!(paginas_sucias_[p / 64] & (1ULL << (p % 64)))) {
+            ++p;
+            continue;
+        }
+        // Agrupar páginas sucias consecutivas en una sola escritura
+        uint64_t fin = p;
+        while (fin < num_paginas && (paginas_sucias_[fin / 64] & (1ULL << (fin % 64)))) {
+            ++fin;
+        }
+        uint64_t offset = p * TAMAÑO_PAGINA_METADATOS;
+        archivo_.seekp(static_cast<std::streamoff>(offset));
+        archivo_.write(reinterpret_cast<const char*>(imagen_.data() + offset),
+                       static_cast<std::streamsize>((fin - p) * TAMAÑO_PAGINA_METADATOS));
+        if (!archivo_.good()) {
+            std::cerr << "Error: No se pudo escribir el archivo de asignación " << ruta_ << std::endl;
+            archivo_.clear();
+            return Status::IO_ERROR;
+        }
+        p = fin;
+    }
+    archivo_.flush();
+    std::fill(paginas_sucias_.begin(), paginas_sucias_.end(), 0);
+    hay_paginas_sucias_ = false;
+    return Status::OK;
+}
+
+Status MapaAsignacionBloques::ExportarTexto(const std::string& ruta) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::ofstream archivo(ruta);
+    if (!archivo.is_open()) {
+        std::cerr << "Error: No se pudo abrir " << ruta << " para exportar la asignación." << std::endl;
+        return Status::IO_ERROR;
+    }
+    archivo << "# Lista de bloques activos (exportación de depuración de " << ruta_ << ")\n";
+    archivo << "# Formato: id_bloque tipo_pagina indice_sector\n";
+    const EntradaMapeo* tabla = Tabla();
+    for (uint64_t i = 1; i < capacidad_; ++i) {
+        if (tabla[i].indice_sector == SIN_SECTOR) continue;
+        archivo << i << " " << static_cast<int>(tabla[i].tipo_pagina) << " " << tabla[i].indice_sector << "\n";
+    }
+    return Status::OK;
+}
@@ -0,0 +1,182 @@
+#ifndef MAPA_ASIGNACION_H
+#define MAPA_ASIGNACION_H
+
+#include "../include/common.h"     // Tipos básicos y Status
+#include <cstdint>
+#include <fstream>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Metadatos de asignación del disco en formato binario.
+ *
+ * Sustituye a la lista de bloques activos en texto. El archivo tiene una
+ * disposición fija, alineada a páginas de TAMAÑO_PAGINA_METADATOS bytes:
+ *
+ *   [cabecera][mapa de bits de bloques lógicos][mapa de bits de sectores][tabla de mapeo]
+ *
+ * - Mapa de bits de bloques: bit i a 1 si el BlockId i está asignado.
+ * - Mapa de bits de sectores: bit s a 1 si el sector físico (índice lineal) s está ocupado.
+ * - Tabla de mapeo: una EntradaMapeo por BlockId con su sector y tipo de página.
+ *
+ * Todo el archivo se mantiene en memoria. Asignar o liberar un bloque solo marca
+ * como sucias las páginas del archivo que toca (una palabra de cada mapa de bits
+ * y una entrada de la tabla), y Sincronizar() escribe únicamente esos tramos.
+ *
+ * La búsqueda de bits libres recorre palabras de 64 bits: se saltan las palabras
+ * llenas y el bit libre se localiza con una sola instrucción (ctz).
+ *
+ * El BlockId 0 queda reservado: AsignarBloque() devuelve 0 cuando no hay espacio.
+ *
+ * Abierto en solo lectura el archivo no se modifica: asignar y liberar fallan.
+ */
+class MapaAsignacionBloques {
+public:
+    static constexpr uint32_t MAGIC_MAPA_ASIGNACION = 0x41504D42; // "BMPA" en ASCII
+    static constexpr uint32_t VERSION_MAPA_ASIGNACION = 1;
+    static constexpr uint64_t TAMAÑO_PAGINA_METADATOS = 4096;
+    static constexpr uint64_t SIN_SECTOR = UINT64_MAX;
+
+    /**
+     * @brief Entrada de la tabla de mapeo lógico → físico.
+     */
+    struct EntradaMapeo {
+        uint64_t indice_sector;     // SIN_SECTOR si el bloque no está asignado
+        PageType tipo_pagina;
+        uint8_t relleno[7];
+    };
+
+    MapaAsignacionBloques();
+    ~MapaAsignacionBloques();
+
+    MapaAsignacionBloques(const MapaAsignacionBloques&) = delete;
+    MapaAsignacionBloques& operator=(const MapaAsignacionBloques&) = delete;
+
+    /**
+     * @brief Abre el archivo de asignación o lo crea vacío si no existe.
+     * @param ruta Ruta del archivo binario.
+     * @param capacidad Número de bloques (y de sectores) que gestiona.
+     * @param solo_lectura El archivo debe existir; no se crea ni se escribe.
+     * @return Status::INVALID_FORMAT si el archivo existe pero no corresponde a esta capacidad;
+     *         NOT_FOUND si no existe y se abre en solo lectura.
+     */
+    Status Abrir(const std::string& ruta, uint64_t capacidad, bool solo_lectura = false);
+
+    /**
+     * @brief Escribe los tramos pendientes y cierra el archivo.
+     */
+    void Cerrar();
+
+    bool EstaAbierto() const { return archivo_.is_open(); }
+    bool EsSoloLectura() const { return solo_lectura_; }
+
+    /**
+     * @brief Reserva un BlockId y un sector físico libre.
+     * @param tipo_pagina Tipo de página del nuevo bloque.
+     * @param sector_sugerido Sector desde el que buscar (para mantener la localidad).
+     * @param sector_asignado [out] Sector físico reservado.
+     * @return BlockId asignado, o 0 si no hay bloques o sectores libres.
+     */
+    BlockId AsignarBloque(PageType tipo_pagina, uint64_t sector_sugerido, uint64_t& sector_asignado);
+
+    /**
+     * @brief Reserva numero_bloques BlockIds consecutivos sobre otros tantos sectores consecutivos.
+     * El bloque primero+i queda en el sector primer_sector+i, así que recorrer la
+     * extensión en orden de BlockId es un recorrido físico secuencial.
+     * @param tipo_pagina Tipo de página de todos los bloques.
+     * @param numero_bloques Longitud de la extensión.
+     * @param sector_sugerido Sector desde el que buscar (para mantener la localidad).
+     * @param primer_sector [out] Sector físico del primer bloque.
+     * @return Primer BlockId de la extensión, o 0 si no hay un tramo libre de esa longitud.
+     */
+    BlockId AsignarExtension(PageType tipo_pagina, uint64_t numero_bloques, uint64_t sector_sugerido, uint64_t& primer_sector);
+
+    /**
+     * @brief Libera un bloque y su sector físico.
+     * @return Status::NOT_FOUND si el bloque no estaba asignado.
+     */
+    Status LiberarBloque(BlockId id_bloque);
+
+    /**
+     * @brief Obtiene el sector físico de un bloque asignado.
+     * @return false si el bloque no está asignado.
+     */
+    bool ObtenerSector(BlockId id_bloque, uint64_t& indice_sector) const;
+
+    bool EstaAsignado(BlockId id_bloque) const;
+    PageType ObtenerTipoPagina(BlockId id_bloque) const;
+    uint64_t ObtenerCapacidad() const { return capacidad_; }
+    uint64_t ObtenerBloquesEnUso() const;
+
+    /**
+     * @brief Sectores ocupados en [primer_sector, primer_sector + numero_sectores).
+     * Cuenta bits del mapa de sectores palabra a palabra (popcount).
+     */
+    uint64_t ContarSectoresOcupados(uint64_t primer_sector, uint64_t numero_sectores) const;
+
+    /**
+     * @brief Escribe en el archivo los tramos modificados desde la última sincronización.
+     * @return Status de la operación.
+     */
+    Status Sincronizar();
+
+    /**
+     * @brief Vuelca la lista de bloques asignados en texto, solo para depuración.
+     * Formato por línea: id_bloque tipo_pagina indice_sector
+     */
+    Status ExportarTexto(const std::string& ruta) const;
+
+    /**
+     * @brief Primer bit a 0 en [desde, num_bits), continuando desde 0 si no hay ninguno.
+     * @return Índice del bit, o num_bits si todos están a 1.
+     */
+    static uint64_t BuscarBitLibre(const uint64_t* palabras, uint64_t num_bits, uint64_t desde);
+
+    /**
+     * @brief Primer tramo de longitud bits a 0 que empieza en [desde, num_bits),
+     *        o en [0, desde) si no hay ninguno. Las palabras llenas o vacías se saltan enteras.
+     * @return Índice del primer bit del tramo, o num_bits si no existe.
+     */
+    static uint64_t BuscarTramoLibre(const uint64_t* palabras, uint64_t num_bits, uint64_t longitud, uint64_t desde);
+
+private:
+    /**
+     * @brief Cabecera del archivo (primera página).
+     */
+    struct CabeceraMapaAsignacion {
+        uint32_t magic_number;
+        uint32_t version;
+        uint64_t capacidad;
+        uint64_t bloques_en_uso;
+    };
+
+    std::string ruta_;
+    std::fstream archivo_;
+    uint64_t capacidad_;
+    std::vector<uint8_t> imagen_;            // Copia en memoria de todo el archivo
+    uint64_t offset_bits_bloques_;
+    uint64_t offset_bits_sectores_;
+    uint64_t offset_tabla_;
+    uint64_t siguiente_bloque_busqueda_;     // Cursor de la búsqueda de BlockIds libres
+
+    std::vector<uint64_t> paginas_sucias_;   // Un bit por página del archivo
+    bool hay_paginas_sucias_;
+    bool solo_lectura_;
+    mutable std::shared_mutex mutex_;
+
+    CabeceraMapaAsignacion* Cabecera() { return reinterpret_cast<CabeceraMapaAsignacion*>(imagen_.data()); }
+    const CabeceraMapaAsignacion* Cabecera() const { return reinterpret_cast<const CabeceraMapaAsignacion*>(imagen_.data()); }
+    uint64_t* BitsBloques() { return reinterpret_cast<uint64_t*>(imagen_.data() + offset_bits_bloques_); }
+    uint64_t* BitsSectores() { return reinterpret_cast<uint64_t*>(imagen_.data() + offset_bits_sectores_); }
+    const uint64_t* BitsSectores() const { return reinterpret_cast<const uint64_t*>(imagen_.data() + offset_bits_sectores_); }
+    EntradaMapeo* Tabla() { return reinterpret_cast<EntradaMapeo*>(imagen_.data() + offset_tabla_); }
+    const EntradaMapeo* Tabla() const { return reinterpret_cast<const EntradaMapeo*>(imagen_.data() + offset_tabla_); }
+
+    void CalcularDisposicion(uint64_t capacidad);
+    void MarcarSucio(uint64_t offset, uint64_t longitud);
+    void MarcarSucioBit(uint64_t offset_mapa, uint64_t bit);
+    Status SincronizarSinBloqueo();
+};
+
+#endif // MAPA_ASIGNACION_H
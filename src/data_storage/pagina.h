@@ -104,18 +104,7 @@ struct Pagina {
      * Inicializa la página a un estado "vacío" o no válido
      */
     Pagina() 
-        : id_bloque(0)
-        , id_frame(-1)
-        , contador_anclajes(0)
-        , es_valida(false)
-        , esta_sucia(false)
-        , cambios_pendientes(false)
-        , ultimo_acceso(std::chrono::steady_clock::now())
-        , ultima_modificacion(std::chrono::steady_clock::now())
-        , ultima_confirmacion(std::chrono::steady_clock::now())
-        , tipo_pagina(PageType::FREE)
-        , contador_accesos(0)
-        , contador_modificaciones(0) {
+        : Pagina(0, PageType::FREE, 0, false, false) {
     }
 
     /**
@@ -128,20 +117,31 @@ struct Pagina {
      */
     Pagina(PageId id_bloque, PageType tipo = PageType::DATA, 
            int anclajes = 0, bool sucia = false, bool valida = true)
+        : Pagina(id_bloque, tipo, anclajes, sucia, valida, std::chrono::steady_clock::now()) {
+    }
+
+private:
+    /**
+     * @brief Constructor común: los tres timestamps comparten una sola lectura del reloj
+     */
+    Pagina(PageId id_bloque, PageType tipo, int anclajes, bool sucia, bool valida,
+           std::chrono::steady_clock::time_point ahora)
         : id_bloque(id_bloque)
         , id_frame(-1)
         , contador_anclajes(anclajes)
         , es_valida(valida)
         , esta_sucia(sucia)
         , cambios_pendientes(false)
-        , ultimo_acceso(std::chrono::steady_clock::now())
-        , ultima_modificacion(std::chrono::steady_clock::now())
-        , ultima_confirmacion(std::chrono::steady_clock::now())
+        , ultimo_acceso(ahora)
+        , ultima_modificacion(ahora)
+        , ultima_confirmacion(ahora)
         , tipo_pagina(tipo)
         , contador_accesos(0)
         , contador_modificaciones(0) {
     }
 
+public:
+
     // ===== MÉTODOS DE GESTIÓN =====
     
     /**
@@ -256,6 +256,7 @@ struct Pagina {
             case PageType::DATA: return "DATOS";
             case PageType::CATALOG: return "CATALOGO";
             case PageType::INDEX: return "INDICE";
+            case PageType::FREE_SPACE_MAP: return "MAPA_ESPACIO";
             case PageType::FREE: return "LIBRE";
             default: return "DESCONOCIDO";
         }
@@ -0,0 +1,138 @@
+// test_gestor_wal.cpp - Archivo de prueba para el GestorWAL
+// Regresión: un cambio confirmado en el log pero no escrito en su página debe rehacerse al reiniciar
+
+#include "gestor_wal.h"
+#include "gestor_disco.h"
+#include "gestor_buffer.h"
+#include "cabeceras_bloques.h"
+#include "../replacement_policies/lru_espanol.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char MARCA_REHECHA[] = "imagen confirmada en el WAL";
+
+std::shared_ptr<GestorDisco> AbrirDisco(const fs::path& ruta) {
+    auto disco = std::make_shared<GestorDisco>(ruta.string(), "wal", 1, 1, 16, 16, BLOCK_SIZE);
+    disco->EstablecerModoRegistroAcceso(ModoRegistroAcceso::DESACTIVADO);
+    Status estado = disco->Inicializar();
+    assert(estado == Status::OK);
+    return disco;
+}
+
+/**
+ * Aplicador mínimo: la prueba solo registra imágenes completas de página
+ */
+Status AplicarImagen(const RegistroWAL& registro, Byte* datos_pagina) {
+    if (registro.tipo != TipoRegistroWAL::IMAGEN_PAGINA || registro.datos.size() != BLOCK_SIZE) {
+        return Status::INVALID_FORMAT;
+    }
+    std::memcpy(datos_pagina, registro.datos.data(), BLOCK_SIZE);
+    return Status::OK;
+}
+
+} // namespace
+
+/**
+ * Confirma una imagen de página en el WAL sin escribir la página ni hacer punto
+ * de control, cierra todo como tras una caída y comprueba que Recuperar la rehace
+ */
+void PruebaRehacerTrasCaida() {
+    std::cout << "\n=== PRUEBA: REHACER UN CAMBIO CONFIRMADO TRAS UNA CAÍDA ===" << std::endl;
+
+    fs::path ruta = fs::temp_directory_path() / "test_gestor_wal";
+    std::error_code error;
+    fs::remove_all(ruta, error);
+    fs::create_directories(ruta, error);
+
+    try {
+        BlockId id_bloque = INVALID_PAGE_ID;
+        LSN lsn_confirmado = LSN_INVALIDO;
+        Status estado;
+
+        // Primera sesión: la página queda en disco sin el cambio; solo el log lo tiene
+        {
+            auto disco = AbrirDisco(ruta);
+            GestorBuffer buffer(disco, 16, BLOCK_SIZE, std::make_unique<PoliticaLRU>());
+            Byte* datos_pagina = nullptr;
+            estado = buffer.NewPage(id_bloque, datos_pagina);
+            assert(estado == Status::OK);
+            estado = buffer.UnpinPage(id_bloque, true);
+            assert(estado == Status::OK);
+            estado = buffer.FlushAllPages();
+            assert(estado == Status::OK);
+
+            std::vector<Byte> imagen(BLOCK_SIZE, 0);
+            CabeceraComun cabecera{};
+            cabecera.magic_number = MAGIC_NUMBER_SGBD;
+            cabecera.id_bloque = id_bloque;
+            cabecera.tamano_bloque_total = BLOCK_SIZE;
+            cabecera.tipo_pagina = PageType::DATA_PAGE;
+            std::memcpy(imagen.data(), &cabecera, sizeof(cabecera));
+            std::memcpy(imagen.data() + sizeof(CabeceraComun), MARCA_REHECHA, sizeof(MARCA_REHECHA));
+
+            GestorWAL wal(ruta.string());
+            estado = wal.Abrir();
+            assert(estado == Status::OK);
+            lsn_confirmado = wal.Añadir(TipoRegistroWAL::IMAGEN_PAGINA, id_bloque, 0,
+                                        imagen.data(), static_cast<uint32_t>(imagen.size()));
+            assert(lsn_confirmado != LSN_INVALIDO);
+            estado = wal.Confirmar();
+            assert(estado == Status::OK);
+            assert(wal.LSNDuradero() >= lsn_confirmado);
+        }
+        std::cout << "✓ Cambio confirmado en el WAL sin punto de control" << std::endl;
+
+        // Segunda sesión: la recuperación debe dejar la página como en el log
+        {
+            auto disco = AbrirDisco(ruta);
+            GestorBuffer buffer(disco, 16, BLOCK_SIZE, std::make_unique<PoliticaLRU>());
+            GestorWAL wal(ruta.string());
+            estado = wal.Abrir();
+            assert(estado == Status::OK);
+            estado = wal.Recuperar(buffer, &AplicarImagen);
+            assert(estado == Status::OK);
+            assert(wal.ObtenerEstadisticas().registros_rehechos == 1);
+
+            Byte* datos_pagina = nullptr;
+            estado = buffer.PinPage(id_bloque, datos_pagina);
+            assert(estado == Status::OK);
+            assert(std::memcmp(datos_pagina + sizeof(CabeceraComun), MARCA_REHECHA, sizeof(MARCA_REHECHA)) == 0);
+            assert(reinterpret_cast<CabeceraComun*>(datos_pagina)->lsn_pagina == lsn_confirmado);
+            estado = buffer.UnpinPage(id_bloque, false);
+            assert(estado == Status::OK);
+            buffer.EstablecerWAL(nullptr);
+        }
+        std::cout << "✓ Recuperar rehace la imagen y deja lsn_pagina en su LSN" << std::endl;
+
+        // Tercera sesión: el punto de control de Recuperar evita rehacerla otra vez
+        {
+            auto disco = AbrirDisco(ruta);
+            GestorBuffer buffer(disco, 16, BLOCK_SIZE, std::make_unique<PoliticaLRU>());
+            GestorWAL wal(ruta.string());
+            estado = wal.Abrir();
+            assert(estado == Status::OK);
+            estado = wal.Recuperar(buffer, &AplicarImagen);
+            assert(estado == Status::OK);
+            assert(wal.ObtenerEstadisticas().registros_rehechos == 0);
+            buffer.EstablecerWAL(nullptr);
+        }
+        std::cout << "✓ Tras la recuperación el cambio no se vuelve a aplicar" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en la prueba: " << e.what() << std::endl;
+        assert(false);
+    }
+
+    fs::remove_all(ruta, error);
+}
+
+int main() {
+    PruebaRehacerTrasCaida();
+    std::cout << "\n=== PRUEBAS DEL GESTOR WAL COMPLETADAS ===" << std::endl;
+    return 0;
+}
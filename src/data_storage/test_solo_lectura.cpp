@@ -0,0 +1,139 @@
+// test_solo_lectura.cpp - Archivo de prueba para el modo de solo lectura del GestorDisco
+// Regresión: un disco abierto como réplica de consulta debe poder recorrerse sin escribir nada
+
+#include "gestor_disco.h"
+#include "gestor_buffer.h"
+#include "cabeceras_bloques.h"
+#include "../Catalog_Manager/gestor_catalogo.h"
+#include "../replacement_policies/lru_espanol.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const uint32_t NUMERO_PAGINAS = 8;
+
+std::shared_ptr<GestorDisco> AbrirDisco(const fs::path& ruta, bool solo_lectura) {
+    auto disco = std::make_shared<GestorDisco>(ruta.string(), "solo_lectura", 1, 1, 16, 16, BLOCK_SIZE);
+    disco->EstablecerModoAlmacenamiento(ModoAlmacenamiento::IMAGEN_UNICA);
+    disco->EstablecerModoRegistroAcceso(ModoRegistroAcceso::DESACTIVADO);
+    disco->EstablecerSoloLectura(solo_lectura);
+    Status estado = disco->Inicializar();
+    assert(estado == Status::OK);
+    return disco;
+}
+
+uint32_t MarcaPagina(BlockId id_bloque) {
+    return 0x5A000000u | id_bloque;
+}
+
+} // namespace
+
+/**
+ * Escribe unas páginas con una marca por bloque, reabre el disco en solo lectura
+ * (imagen proyectada en memoria, sin WAL) y las recorre como lo hace un cursor.
+ * Después comprueba que ni las escrituras ni el cierre tocaron el disco.
+ */
+void PruebaRecorridoEnSoloLectura() {
+    std::cout << "\n=== PRUEBA: RECORRIDO DE UN DISCO ABIERTO EN SOLO LECTURA ===" << std::endl;
+
+    fs::path ruta = fs::temp_directory_path() / "test_solo_lectura";
+    std::error_code error;
+    fs::remove_all(ruta, error);
+    fs::create_directories(ruta, error);
+
+    try {
+        std::vector<BlockId> paginas;
+        uint32_t bloques_en_uso = 0;
+        Status estado;
+
+        // Primera sesión: disco normal con algunas páginas de datos
+        {
+            auto disco = AbrirDisco(ruta, false);
+            GestorBuffer buffer(disco, 16, BLOCK_SIZE, std::make_unique<PoliticaLRU>());
+            for (uint32_t i = 0; i < NUMERO_PAGINAS; ++i) {
+                BlockId id_bloque = INVALID_PAGE_ID;
+                Byte* datos_pagina = nullptr;
+                estado = buffer.NewPage(id_bloque, datos_pagina);
+                assert(estado == Status::OK);
+                uint32_t marca = MarcaPagina(id_bloque);
+                std::memcpy(datos_pagina + sizeof(CabeceraComun), &marca, sizeof(marca));
+                estado = buffer.UnpinPage(id_bloque, true);
+                assert(estado == Status::OK);
+                paginas.push_back(id_bloque);
+            }
+            estado = buffer.FlushAllPages();
+            assert(estado == Status::OK);
+            bloques_en_uso = disco->ObtenerBloquesEnUso();
+        }
+        std::cout << "✓ Disco creado con " << paginas.size() << " páginas" << std::endl;
+
+        // Segunda sesión: réplica de consulta sobre la misma imagen
+        {
+            auto disco = AbrirDisco(ruta, true);
+            assert(disco->EsSoloLectura());
+            GestorBuffer buffer(disco, 4, BLOCK_SIZE, std::make_unique<PoliticaLRU>());
+            GestorCatalogo catalogo(disco);
+            estado = catalogo.CargarCatalogo();
+            assert(estado == Status::OK);
+
+            size_t limite = buffer.DeclararLecturaSecuencial(paginas);
+            for (size_t posicion = 0; posicion < paginas.size(); ++posicion) {
+                buffer.AvanzarLecturaSecuencial(paginas, posicion, limite);
+                Byte* datos_pagina = nullptr;
+                estado = buffer.PinPage(paginas[posicion], datos_pagina);
+                assert(estado == Status::OK);
+                uint32_t marca = 0;
+                std::memcpy(&marca, datos_pagina + sizeof(CabeceraComun), sizeof(marca));
+                assert(marca == MarcaPagina(paginas[posicion]));
+                estado = buffer.UnpinPage(paginas[posicion], false);
+                assert(estado == Status::OK);
+            }
+            std::cout << "✓ El recorrido lee todas las páginas desde la imagen proyectada" << std::endl;
+
+            BlockId id_nuevo = INVALID_PAGE_ID;
+            Byte* datos_nuevo = nullptr;
+            estado = buffer.NewPage(id_nuevo, datos_nuevo);
+            assert(estado != Status::OK);
+            std::vector<Byte> bloque(BLOCK_SIZE, 0);
+            estado = disco->EscribirBloque(paginas.front(), bloque.data(), BLOCK_SIZE);
+            assert(estado != Status::OK);
+            std::cout << "✓ Asignar o escribir bloques se rechaza" << std::endl;
+
+            // El catálogo no tiene directorio: fuera de solo lectura lo crearía aquí
+            estado = catalogo.GuardarCatalogo();
+            assert(estado == Status::OK);
+        }
+
+        // Tercera sesión: nada de lo anterior llegó al disco
+        {
+            auto disco = AbrirDisco(ruta, false);
+            assert(disco->ObtenerBloquesEnUso() == bloques_en_uso);
+            GestorBuffer buffer(disco, 4, BLOCK_SIZE, std::make_unique<PoliticaLRU>());
+            Byte* datos_pagina = nullptr;
+            estado = buffer.PinPage(paginas.front(), datos_pagina);
+            assert(estado == Status::OK);
+            uint32_t marca = 0;
+            std::memcpy(&marca, datos_pagina + sizeof(CabeceraComun), sizeof(marca));
+            assert(marca == MarcaPagina(paginas.front()));
+            estado = buffer.UnpinPage(paginas.front(), false);
+            assert(estado == Status::OK);
+        }
+        std::cout << "✓ El cierre en solo lectura no escribe catálogo, metadatos ni páginas" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en la prueba: " << e.what() << std::endl;
+        assert(false);
+    }
+
+    fs::remove_all(ruta, error);
+}
+
+int main() {
+    PruebaRecorridoEnSoloLectura();
+    std::cout << "\n=== PRUEBAS DEL MODO SOLO LECTURA COMPLETADAS ===" << std::endl;
+    return 0;
+}
@@ -16,11 +16,31 @@ using BlockSizeType = uint32_t; // Tamaño de un bloque en bytes
 using SectorSizeType = uint32_t; // Tamaño de un sector en bytes
 using Byte = char;              // Tipo para representar un byte de datos
 using RecordId = uint32_t;      // Identificador de un registro dentro de una tabla
+using LSN = uint64_t;           // Posición en el registro de escritura anticipada (WAL)
 
 // ==== CONSTANTES DEL SISTEMA ====
 const uint32_t BLOCK_SIZE = 4096;          // Tamaño estándar de un bloque en bytes
 const FrameId INVALID_FRAME_ID = UINT32_MAX; // Valor inválido para un ID de frame
 const PageId INVALID_PAGE_ID = UINT32_MAX;   // Valor inválido para un ID de página/bloque
+const RecordId INVALID_RECORD_ID = UINT32_MAX; // Valor inválido para un ID de registro
+const LSN LSN_INVALIDO = 0;                  // Página nunca modificada a través del WAL
+
+// ==== IDENTIFICADORES DE REGISTRO ====
+// Un RecordId codifica la ubicación del registro: (id_pagina << BITS_SLOT_RECORD_ID) | slot.
+// Con bloques de 4 KiB una página no llega a 1024 slots y quedan 22 bits para la página.
+constexpr uint32_t BITS_SLOT_RECORD_ID = 10;
+constexpr uint32_t MAX_SLOTS_POR_PAGINA = 1u << BITS_SLOT_RECORD_ID;
+constexpr PageId MAX_PAGINA_RECORD_ID = (1u << (32 - BITS_SLOT_RECORD_ID)) - 1;
+
+inline RecordId ConstruirRecordId(PageId id_pagina, uint32_t slot) {
+    return (id_pagina << BITS_SLOT_RECORD_ID) | slot;
+}
+inline PageId PaginaDeRecordId(RecordId id_registro) {
+    return id_registro >> BITS_SLOT_RECORD_ID;
+}
+inline uint32_t SlotDeRecordId(RecordId id_registro) {
+    return id_registro & (MAX_SLOTS_POR_PAGINA - 1);
+}
 
 // ==== ESTADO GENERAL DE LAS OPERACIONES ====
 enum class Status : uint8_t {
@@ -77,6 +97,20 @@ inline std::string StatusToString(Status status) {
     }
 }
 
+// ==== TIPOS DE PÁGINA ====
+// Los alias *_PAGE se mantienen por compatibilidad con el código que ya los usa.
+enum class PageType : uint8_t {
+    FREE = 0,                // Bloque libre / frame sin página
+    DATA,                    // Página de datos de una tabla
+    CATALOG,                 // Página del catálogo del sistema
+    INDEX,                   // Página de un índice
+    FREE_SPACE_MAP,          // Página del mapa de espacio libre de una tabla
+    INVALID_PAGE = 0xFF,     // Valor inválido
+    DATA_PAGE = DATA,
+    CATALOG_PAGE = CATALOG,
+    INDEX_PAGE = INDEX
+};
+
 // ==== TIPOS DE COLUMNAS (UNIFICADO) ====
 enum class ColumnType : uint8_t {
     INT = 0,     // Enteros
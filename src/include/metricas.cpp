@@ -0,0 +1,456 @@
+// include/metricas.cpp - Implementación del registro de métricas
+#include "metricas.h"
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+std::atomic<uint32_t> siguiente_fragmento{0};
+
+uint64_t MarcaTiempoMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+uint32_t Log2Entero(uint64_t valor) {
+    uint32_t resultado = 0;
+    while (valor >>= 1) {
+        ++resultado;
+    }
+    return resultado;
+}
+
+std::string EscaparJSON(const std::string& texto) {
+    std::string resultado;
+    resultado.reserve(texto.size() + 2);
+    for (char c : texto) {
+        switch (c) {
+            case '"': resultado += "\\\""; break;
+            case '\\': resultado += "\\\\"; break;
+            case '\n': resultado += "\\n"; break;
+            case '\r': resultado += "\\r"; break;
+            case '\t': resultado += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    std::ostringstream codigo;
+                    codigo << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+                    resultado += codigo.str();
+                } else {
+                    resultado += c;
+                }
+        }
+    }
+    return resultado;
+}
+
+// Los valores de etiqueta de Prometheus solo escapan \, " y salto de línea
+std::string EscaparEtiqueta(const std::string& texto) {
+    std::string resultado;
+    resultado.reserve(texto.size());
+    for (char c : texto) {
+        if (c == '\\') resultado += "\\\\";
+        else if (c == '"') resultado += "\\\"";
+        else if (c == '\n') resultado += "\\n";
+        else resultado += c;
+    }
+    return resultado;
+}
+
+// Nombre de contador válido en Prometheus: [a-zA-Z0-9_]
+std::string NombrePrometheus(const std::string& nombre) {
+    std::string resultado = nombre;
+    for (char& c : resultado) {
+        bool valido = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        if (!valido) c = '_';
+    }
+    return resultado;
+}
+
+double NsASegundos(uint64_t nanosegundos) {
+    return static_cast<double>(nanosegundos) / 1e9;
+}
+
+} // namespace
+
+uint32_t FragmentoHiloActual() {
+    thread_local uint32_t fragmento = siguiente_fragmento.fetch_add(1, std::memory_order_relaxed) % FRAGMENTOS_METRICA;
+    return fragmento;
+}
+
+// ===== CONTADOR =====
+
+uint64_t ContadorMetrica::Valor() const {
+    uint64_t total = 0;
+    for (const auto& fragmento : fragmentos_) {
+        total += fragmento.valor.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void ContadorMetrica::Reiniciar() {
+    for (auto& fragmento : fragmentos_) {
+        fragmento.valor.store(0, std::memory_order_relaxed);
+    }
+}
+
+// ===== HISTOGRAMA =====
+
+HistogramaLatencia::HistogramaLatencia()
+    : fragmentos_(new Fragmento[FRAGMENTOS_METRICA]) {
+}
+
+uint32_t HistogramaLatencia::IndiceCubeta(uint64_t nanosegundos) {
+    if (nanosegundos < SUBCUBETAS_POR_OCTAVA) {
+        return static_cast<uint32_t>(nanosegundos);
+    }
+    uint32_t octava = Log2Entero(nanosegundos);
+    if (octava > MAXIMA_OCTAVA) {
+        return NUMERO_CUBETAS - 1;
+    }
+    uint32_t subcubeta = static_cast<uint32_t>(nanosegundos >> (octava - BITS_SUBCUBETA)) & (SUBCUBETAS_POR_OCTAVA - 1);
+    return (octava - BITS_SUBCUBETA + 1) * SUBCUBETAS_POR_OCTAVA + subcubeta;
+}
+
+uint64_t HistogramaLatencia::LimiteSuperiorCubeta(uint32_t indice) {
+    if (indice < SUBCUBETAS_POR_OCTAVA) {
+        return indice;
+    }
+    uint32_t octava = indice / SUBCUBETAS_POR_OCTAVA + BITS_SUBCUBETA - 1;
+    uint64_t subcubeta = indice % SUBCUBETAS_POR_OCTAVA;
+    return ((SUBCUBETAS_POR_OCTAVA + subcubeta + 1) << (octava - BITS_SUBCUBETA)) - 1;
+}
+
+void HistogramaLatencia::Registrar(uint64_t nanosegundos) {
+    Fragmento& fragmento = fragmentos_[FragmentoHiloActual()];
+    fragmento.cubetas[IndiceCubeta(nanosegundos)].fetch_add(1, std::memory_order_relaxed);
+    fragmento.cuenta.fetch_add(1, std::memory_order_relaxed);
+    fragmento.suma_ns.fetch_add(nanosegundos, std::memory_order_relaxed);
+    uint64_t maximo = fragmento.maximo_ns.load(std::memory_order_relaxed);
+    while (nanosegundos > maximo &&
+           !fragmento.maximo_ns.compare_exchange_weak(maximo, nanosegundos, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramaLatencia::Resumen HistogramaLatencia::ObtenerResumen() const {
+    Resumen resumen;
+    for (uint32_t f = 0; f < FRAGMENTOS_METRICA; ++f) {
+        const Fragmento& fragmento = fragmentos_[f];
+        resumen.cuenta += fragmento.cuenta.load(std::memory_order_relaxed);
+        resumen.suma_ns += fragmento.suma_ns.load(std::memory_order_relaxed);
+        resumen.maximo_ns = std::max(resumen.maximo_ns, fragmento.maximo_ns.load(std::memory_order_relaxed));
+        for (uint32_t i = 0; i < NUMERO_CUBETAS; ++i) {
+            resumen.cubetas[i] += fragmento.cubetas[i].load(std::memory_order_relaxed);
+        }
+    }
+    return resumen;
+}
+
+void HistogramaLatencia::Reiniciar() {
+    for (uint32_t f = 0; f < FRAGMENTOS_METRICA; ++f) {
+        Fragmento& fragmento = fragmentos_[f];
+        fragmento.cuenta.store(0, std::memory_order_relaxed);
+        fragmento.suma_ns.store(0, std::memory_order_relaxed);
+        fragmento.maximo_ns.store(0, std::memory_order_relaxed);
+        for (auto& cubeta : fragmento.cubetas) {
+            cubeta.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t HistogramaLatencia::Resumen::Percentil(double fraccion) const {
+    // Cuenta de cubetas (no el campo cuenta): los fragmentos se leen sin
+    // sincronizar y ambas sumas pueden diferir en alguna muestra.
+    uint64_t total = 0;
+    for (uint64_t c : cubetas) {
+        total += c;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    fraccion = std::min(std::max(fraccion, 0.0), 1.0);
+    uint64_t objetivo = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraccion * static_cast<double>(total))));
+    uint64_t acumulado = 0;
+    for (uint32_t i = 0; i < NUMERO_CUBETAS; ++i) {
+        acumulado += cubetas[i];
+        if (acumulado >= objetivo) {
+            return std::min(LimiteSuperiorCubeta(i), maximo_ns);
+        }
+    }
+    return maximo_ns;
+}
+
+// ===== REGISTRO =====
+
+RegistroMetricas& RegistroMetricas::Global() {
+    static RegistroMetricas registro;
+    return registro;
+}
+
+RegistroMetricas::RegistroMetricas() {
+    for (auto& fila : por_tipo_) {
+        for (auto& serie : fila) {
+            serie = std::make_unique<HistogramaLatencia>();
+        }
+    }
+}
+
+size_t RegistroMetricas::IndiceTipoPagina(PageType tipo_pagina) {
+    size_t indice = static_cast<size_t>(tipo_pagina);
+    return indice < NUMERO_TIPOS_PAGINA - 1 ? indice : NUMERO_TIPOS_PAGINA - 1;
+}
+
+HistogramaLatencia& RegistroMetricas::HistogramaPorTipo(OperacionMetrica operacion, PageType tipo_pagina) {
+    return *por_tipo_[static_cast<size_t>(operacion)][IndiceTipoPagina(tipo_pagina)];
+}
+
+HistogramaLatencia& RegistroMetricas::HistogramaPorTabla(OperacionMetrica operacion, const std::string& tabla) {
+    auto clave = std::make_pair(operacion, tabla);
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_series_);
+        auto it = por_tabla_.find(clave);
+        if (it != por_tabla_.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_series_);
+    auto& serie = por_tabla_[clave];
+    if (!serie) {
+        serie = std::make_unique<HistogramaLatencia>();
+    }
+    return *serie;
+}
+
+ContadorMetrica& RegistroMetricas::Contador(const std::string& nombre) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_series_);
+        auto it = contadores_.find(nombre);
+        if (it != contadores_.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_series_);
+    auto& contador = contadores_[nombre];
+    if (!contador) {
+        contador = std::make_unique<ContadorMetrica>();
+    }
+    return *contador;
+}
+
+void RegistroMetricas::Registrar(OperacionMetrica operacion, PageType tipo_pagina, const std::string& tabla,
+                                 uint64_t nanosegundos, const std::string& detalle) {
+    if (tabla.empty()) {
+        HistogramaPorTipo(operacion, tipo_pagina).Registrar(nanosegundos);
+    } else {
+        HistogramaPorTabla(operacion, tabla).Registrar(nanosegundos);
+    }
+    if (traza_activa_.load(std::memory_order_relaxed) &&
+        nanosegundos >= umbral_traza_ns_.load(std::memory_order_relaxed)) {
+        RegistrarSiLenta(operacion, tipo_pagina, tabla, nanosegundos, detalle);
+    }
+}
+
+void RegistroMetricas::RegistrarSiLenta(OperacionMetrica operacion, PageType tipo_pagina, const std::string& tabla,
+                                        uint64_t nanosegundos, const std::string& detalle) {
+    uint64_t vista = operaciones_lentas_vistas_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_traza_);
+    if (configuracion_traza_.muestreo > 1 && vista % configuracion_traza_.muestreo != 0) {
+        return;
+    }
+    OperacionLenta lenta;
+    lenta.operacion = operacion;
+    lenta.tipo_pagina = tipo_pagina;
+    lenta.tabla = tabla;
+    lenta.detalle = detalle;
+    lenta.duracion_ns = nanosegundos;
+    lenta.marca_tiempo_ms = MarcaTiempoMs();
+    traza_.push_back(std::move(lenta));
+    while (traza_.size() > configuracion_traza_.capacidad) {
+        traza_.pop_front();
+    }
+}
+
+void RegistroMetricas::ConfigurarTraza(const ConfiguracionTraza& configuracion) {
+    std::lock_guard<std::mutex> lock(mutex_traza_);
+    configuracion_traza_ = configuracion;
+    if (configuracion_traza_.capacidad == 0) {
+        configuracion_traza_.capacidad = 1;
+    }
+    while (traza_.size() > configuracion_traza_.capacidad) {
+        traza_.pop_front();
+    }
+    umbral_traza_ns_.store(configuracion.umbral_ns, std::memory_order_relaxed);
+    traza_activa_.store(configuracion.activa, std::memory_order_relaxed);
+}
+
+ConfiguracionTraza RegistroMetricas::ObtenerConfiguracionTraza() const {
+    std::lock_guard<std::mutex> lock(mutex_traza_);
+    return configuracion_traza_;
+}
+
+std::vector<OperacionLenta> RegistroMetricas::ObtenerOperacionesLentas() const {
+    std::lock_guard<std::mutex> lock(mutex_traza_);
+    return std::vector<OperacionLenta>(traza_.begin(), traza_.end());
+}
+
+void RegistroMetricas::Reiniciar() {
+    for (auto& fila : por_tipo_) {
+        for (auto& serie : fila) {
+            serie->Reiniciar();
+        }
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_series_);
+        for (auto& entrada : por_tabla_) {
+            entrada.second->Reiniciar();
+        }
+        for (auto& entrada : contadores_) {
+            entrada.second->Reiniciar();
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_traza_);
+    traza_.clear();
+    operaciones_lentas_vistas_.store(0, std::memory_order_relaxed);
+}
+
+const char* RegistroMetricas::NombreOperacion(OperacionMetrica operacion) {
+    switch (operacion) {
+        case OperacionMetrica::ANCLAR_PAGINA: return "anclar_pagina";
+        case OperacionMetrica::FALLO_BUFFER: return "fallo_buffer";
+        case OperacionMetrica::LECTURA_DISCO: return "lectura_disco";
+        case OperacionMetrica::ESCRITURA_DISCO: return "escritura_disco";
+        case OperacionMetrica::DESALOJO: return "desalojo";
+        case OperacionMetrica::BUSQUEDA_INDICE: return "busqueda_indice";
+        case OperacionMetrica::EJECUCION_SENTENCIA: return "ejecucion_sentencia";
+        default: return "desconocida";
+    }
+}
+
+const char* RegistroMetricas::NombreTipoPagina(PageType tipo_pagina) {
+    switch (tipo_pagina) {
+        case PageType::FREE: return "FREE";
+        case PageType::DATA: return "DATA";
+        case PageType::CATALOG: return "CATALOG";
+        case PageType::INDEX: return "INDEX";
+        case PageType::FREE_SPACE_MAP: return "FREE_SPACE_MAP";
+        default: return "OTRO";
+    }
+}
+
+// ===== EXPORTACIÓN =====
+
+namespace {
+
+// Serie ya agregada, con la etiqueta que la distingue dentro de su operación
+struct SerieExportada {
+    OperacionMetrica operacion;
+    bool por_tabla;
+    std::string etiqueta;
+    HistogramaLatencia::Resumen resumen;
+};
+
+const PageType TIPOS_EXPORTADOS[] = {
+    PageType::FREE, PageType::DATA, PageType::CATALOG, PageType::INDEX, PageType::FREE_SPACE_MAP, PageType::INVALID_PAGE
+};
+
+} // namespace
+
+std::string RegistroMetricas::ExportarJSON() const {
+    std::vector<SerieExportada> series;
+    for (size_t op = 0; op < NUMERO_OPERACIONES; ++op) {
+        for (PageType tipo : TIPOS_EXPORTADOS) {
+            auto resumen = por_tipo_[op][IndiceTipoPagina(tipo)]->ObtenerResumen();
+            if (resumen.cuenta > 0) {
+                series.push_back({static_cast<OperacionMetrica>(op), false, NombreTipoPagina(tipo), resumen});
+            }
+        }
+    }
+    std::vector<std::pair<std::string, uint64_t>> contadores;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_series_);
+        for (const auto& entrada : por_tabla_) {
+            auto resumen = entrada.second->ObtenerResumen();
+            if (resumen.cuenta > 0) {
+                series.push_back({entrada.first.first, true, entrada.first.second, resumen});
+            }
+        }
+        for (const auto& entrada : contadores_) {
+            contadores.emplace_back(entrada.first, entrada.second->Valor());
+        }
+    }
+
+    std::ostringstream json;
+    json << "{\"activo\":" << (Activo() ? "true" : "false") << ",\"series\":[";
+    for (size_t i = 0; i < series.size(); ++i) {
+        const auto& serie = series[i];
+        json << (i ? "," : "") << "{\"operacion\":\"" << NombreOperacion(serie.operacion) << "\","
+             << (serie.por_tabla ? "\"tabla\":\"" : "\"tipo_pagina\":\"") << EscaparJSON(serie.etiqueta) << "\","
+             << "\"cuenta\":" << serie.resumen.cuenta
+             << ",\"suma_ns\":" << serie.resumen.suma_ns
+             << ",\"media_ns\":" << static_cast<uint64_t>(serie.resumen.MediaNs())
+             << ",\"p50_ns\":" << serie.resumen.Percentil(0.5)
+             << ",\"p99_ns\":" << serie.resumen.Percentil(0.99)
+             << ",\"p999_ns\":" << serie.resumen.Percentil(0.999)
+             << ",\"max_ns\":" << serie.resumen.maximo_ns << "}";
+    }
+    json << "],\"contadores\":{";
+    for (size_t i = 0; i < contadores.size(); ++i) {
+        json << (i ? "," : "") << "\"" << EscaparJSON(contadores[i].first) << "\":" << contadores[i].second;
+    }
+    json << "},\"operaciones_lentas\":[";
+    auto lentas = ObtenerOperacionesLentas();
+    for (size_t i = 0; i < lentas.size(); ++i) {
+        const auto& lenta = lentas[i];
+        json << (i ? "," : "") << "{\"operacion\":\"" << NombreOperacion(lenta.operacion) << "\""
+             << ",\"tipo_pagina\":\"" << NombreTipoPagina(lenta.tipo_pagina) << "\""
+             << ",\"tabla\":\"" << EscaparJSON(lenta.tabla) << "\""
+             << ",\"duracion_ns\":" << lenta.duracion_ns
+             << ",\"marca_tiempo_ms\":" << lenta.marca_tiempo_ms
+             << ",\"detalle\":\"" << EscaparJSON(lenta.detalle) << "\"}";
+    }
+    json << "]}";
+    return json.str();
+}
+
+std::string RegistroMetricas::ExportarPrometheus() const {
+    std::ostringstream texto;
+    texto << std::setprecision(9);
+    texto << "# HELP sgbd_latencia_segundos Latencia de las operaciones de los gestores\n";
+    texto << "# TYPE sgbd_latencia_segundos summary\n";
+
+    auto escribir_serie = [&texto](const std::string& etiquetas, const HistogramaLatencia::Resumen& resumen) {
+        const double cuantiles[] = {0.5, 0.99, 0.999};
+        for (double q : cuantiles) {
+            texto << "sgbd_latencia_segundos{" << etiquetas << ",quantile=\"" << q << "\"} "
+                  << NsASegundos(resumen.Percentil(q)) << "\n";
+        }
+        texto << "sgbd_latencia_segundos_sum{" << etiquetas << "} " << NsASegundos(resumen.suma_ns) << "\n";
+        texto << "sgbd_latencia_segundos_count{" << etiquetas << "} " << resumen.cuenta << "\n";
+    };
+
+    for (size_t op = 0; op < NUMERO_OPERACIONES; ++op) {
+        auto operacion = static_cast<OperacionMetrica>(op);
+        for (PageType tipo : TIPOS_EXPORTADOS) {
+            auto resumen = por_tipo_[op][IndiceTipoPagina(tipo)]->ObtenerResumen();
+            if (resumen.cuenta > 0) {
+                escribir_serie(std::string("operacion=\"") + NombreOperacion(operacion) +
+                               "\",tipo_pagina=\"" + NombreTipoPagina(tipo) + "\"", resumen);
+            }
+        }
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex_series_);
+    for (const auto& entrada : por_tabla_) {
+        auto resumen = entrada.second->ObtenerResumen();
+        if (resumen.cuenta > 0) {
+            escribir_serie(std::string("operacion=\"") + NombreOperacion(entrada.first.first) +
+                           "\",tabla=\"" + EscaparEtiqueta(entrada.first.second) + "\"", resumen);
+        }
+    }
+    for (const auto& entrada : contadores_) {
+        std::string nombre = "sgbd_" + NombrePrometheus(entrada.first) + "_total";
+        texto << "# TYPE " << nombre << " counter\n";
+        texto << nombre << " " << entrada.second->Valor() << "\n";
+    }
+    return texto.str();
+}
@@ -0,0 +1,302 @@
+// include/metricas.h - Registro de métricas compartido por los gestores
+// Histogramas de latencia con cubetas logarítmicas y contadores repartidos por hilo
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include "common.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Operaciones cuya latencia se mide.
+ */
+enum class OperacionMetrica : uint8_t {
+    ANCLAR_PAGINA = 0,   // PinPage completo (acierto o fallo)
+    FALLO_BUFFER,        // PinPage que tuvo que reservar un frame y leer de disco
+    LECTURA_DISCO,       // Una petición de lectura al GestorDisco
+    ESCRITURA_DISCO,     // Una petición de escritura al GestorDisco
+    DESALOJO,            // Búsqueda de víctima y desalojo de un frame
+    BUSQUEDA_INDICE,     // GestorIndices::BuscarEnIndice
+    EJECUCION_SENTENCIA, // Sentencia SQL completa
+    NUMERO_OPERACIONES
+};
+
+/**
+ * @brief Número de fragmentos de cada métrica. Cada hilo escribe siempre en el
+ * mismo fragmento, así que hilos distintos casi nunca comparten línea de caché.
+ */
+constexpr uint32_t FRAGMENTOS_METRICA = 8;
+
+/**
+ * @brief Fragmento asignado al hilo actual (reparto circular al primer uso).
+ */
+uint32_t FragmentoHiloActual();
+
+/**
+ * @brief Contador monótono repartido en FRAGMENTOS_METRICA fragmentos.
+ * Sumar es una suma relajada sobre el fragmento del hilo; Valor() los agrega.
+ */
+class ContadorMetrica {
+public:
+    ContadorMetrica() = default;
+    ContadorMetrica(const ContadorMetrica&) = delete;
+    ContadorMetrica& operator=(const ContadorMetrica&) = delete;
+
+    void Sumar(uint64_t cantidad = 1) {
+        fragmentos_[FragmentoHiloActual()].valor.fetch_add(cantidad, std::memory_order_relaxed);
+    }
+    uint64_t Valor() const;
+    void Reiniciar();
+
+private:
+    struct alignas(64) Fragmento {
+        std::atomic<uint64_t> valor{0};
+    };
+    std::array<Fragmento, FRAGMENTOS_METRICA> fragmentos_;
+};
+
+/**
+ * @brief Histograma de latencias en nanosegundos con cubetas logarítmicas.
+ *
+ * Cada potencia de dos se divide en SUBCUBETAS_POR_OCTAVA cubetas iguales, de
+ * modo que el error relativo de un percentil es como mucho del 25 %. Los valores
+ * menores que SUBCUBETAS_POR_OCTAVA ocupan su propia cubeta y los que pasan de
+ * 2^(MAXIMA_OCTAVA + 1) ns (unos 36 minutos) se acumulan en la última.
+ *
+ * Registrar() no toma ningún mutex: incrementa con orden relajado la cubeta del
+ * fragmento del hilo. ObtenerResumen() suma los fragmentos, así que un resumen
+ * tomado mientras otros hilos registran puede estar desfasado en unas pocas muestras.
+ */
+class HistogramaLatencia {
+public:
+    static constexpr uint32_t BITS_SUBCUBETA = 2;
+    static constexpr uint32_t SUBCUBETAS_POR_OCTAVA = 1u << BITS_SUBCUBETA;
+    static constexpr uint32_t MAXIMA_OCTAVA = 40;
+    static constexpr uint32_t NUMERO_CUBETAS = (MAXIMA_OCTAVA - BITS_SUBCUBETA + 2) * SUBCUBETAS_POR_OCTAVA;
+
+    /**
+     * @brief Copia agregada de un histograma.
+     */
+    struct Resumen {
+        uint64_t cuenta = 0;
+        uint64_t suma_ns = 0;
+        uint64_t maximo_ns = 0;
+        std::array<uint64_t, NUMERO_CUBETAS> cubetas{};
+
+        /**
+         * @brief Percentil aproximado (límite superior de la cubeta que lo contiene).
+         * @param fraccion Entre 0 y 1, p. ej. 0.99
+         * @return 0 si el histograma está vacío; nunca más que maximo_ns
+         */
+        uint64_t Percentil(double fraccion) const;
+        double MediaNs() const { return cuenta ? static_cast<double>(suma_ns) / cuenta : 0.0; }
+    };
+
+    HistogramaLatencia();
+    HistogramaLatencia(const HistogramaLatencia&) = delete;
+    HistogramaLatencia& operator=(const HistogramaLatencia&) = delete;
+
+    void Registrar(uint64_t nanosegundos);
+    Resumen ObtenerResumen() const;
+    void Reiniciar();
+
+    static uint32_t IndiceCubeta(uint64_t nanosegundos);
+    static uint64_t LimiteSuperiorCubeta(uint32_t indice);
+
+private:
+    struct alignas(64) Fragmento {
+        std::atomic<uint64_t> cuenta{0};
+        std::atomic<uint64_t> suma_ns{0};
+        std::atomic<uint64_t> maximo_ns{0};
+        std::array<std::atomic<uint64_t>, NUMERO_CUBETAS> cubetas{};
+    };
+    std::unique_ptr<Fragmento[]> fragmentos_;
+};
+
+/**
+ * @brief Operación que superó el umbral de la traza de operaciones lentas.
+ */
+struct OperacionLenta {
+    OperacionMetrica operacion = OperacionMetrica::ANCLAR_PAGINA;
+    PageType tipo_pagina = PageType::INVALID_PAGE;
+    std::string tabla;
+    std::string detalle;          // Bloque, columna o texto de la sentencia
+    uint64_t duracion_ns = 0;
+    uint64_t marca_tiempo_ms = 0; // Reloj del sistema al terminar
+};
+
+/**
+ * @brief Configuración de la traza de operaciones lentas (desactivada por defecto).
+ */
+struct ConfiguracionTraza {
+    bool activa = false;
+    uint64_t umbral_ns = 10'000'000; // 10 ms
+    uint32_t muestreo = 1;           // Se guarda una de cada `muestreo` operaciones lentas
+    size_t capacidad = 256;          // Las más antiguas se descartan
+};
+
+/**
+ * @brief Registro de métricas de todo el proceso.
+ *
+ * Las series se identifican por operación y por una etiqueta: el PageType para
+ * las operaciones sobre páginas (anclaje, fallo, E/S de disco, desalojo) y el
+ * nombre de la tabla para las que la conocen (búsqueda en índice, sentencia).
+ * Las series por tipo se crean al construir el registro y se indexan en una
+ * tabla fija; las series por tabla se crean a demanda bajo mutex_series_ y
+ * nunca se destruyen, así que las referencias devueltas siguen siendo válidas
+ * (Reiniciar() solo pone los valores a cero).
+ *
+ * Con el registro desactivado (EstablecerActivo(false)) MedidorLatencia no lee
+ * el reloj; el coste que queda es la lectura de un atómico por operación.
+ */
+class RegistroMetricas {
+public:
+    static RegistroMetricas& Global();
+
+    bool Activo() const { return activo_.load(std::memory_order_relaxed); }
+    void EstablecerActivo(bool activo) { activo_.store(activo, std::memory_order_relaxed); }
+
+    /**
+     * @brief Serie de una operación por tipo de página (INVALID_PAGE = sin tipo).
+     */
+    HistogramaLatencia& HistogramaPorTipo(OperacionMetrica operacion, PageType tipo_pagina);
+
+    /**
+     * @brief Serie de una operación por tabla; se crea si no existe.
+     */
+    HistogramaLatencia& HistogramaPorTabla(OperacionMetrica operacion, const std::string& tabla);
+
+    /**
+     * @brief Contador con nombre (p. ej. "disco_bytes_leidos"); se crea si no existe.
+     */
+    ContadorMetrica& Contador(const std::string& nombre);
+
+    /**
+     * @brief Registra una muestra en su serie y la pasa a la traza si es lenta.
+     * Si tabla no está vacía la serie es la de la tabla; si no, la del tipo de página.
+     */
+    void Registrar(OperacionMetrica operacion, PageType tipo_pagina, const std::string& tabla,
+                   uint64_t nanosegundos, const std::string& detalle = "");
+
+    void ConfigurarTraza(const ConfiguracionTraza& configuracion);
+    ConfiguracionTraza ObtenerConfiguracionTraza() const;
+    std::vector<OperacionLenta> ObtenerOperacionesLentas() const;
+
+    /**
+     * @brief Pone a cero todas las series y contadores y vacía la traza.
+     */
+    void Reiniciar();
+
+    /**
+     * @brief Documento JSON con las series no vacías (percentiles en ns),
+     * los contadores y la traza de operaciones lentas.
+     */
+    std::string ExportarJSON() const;
+
+    /**
+     * @brief Formato de texto de Prometheus: un summary sgbd_latencia_segundos con
+     * cuantiles 0.5/0.99/0.999 por serie y un counter sgbd_<nombre>_total por contador.
+     */
+    std::string ExportarPrometheus() const;
+
+    static const char* NombreOperacion(OperacionMetrica operacion);
+    static const char* NombreTipoPagina(PageType tipo_pagina);
+
+private:
+    // FREE, DATA, CATALOG, INDEX, FREE_SPACE_MAP y una serie más para el resto
+    static constexpr size_t NUMERO_TIPOS_PAGINA = 6;
+    static constexpr size_t NUMERO_OPERACIONES = static_cast<size_t>(OperacionMetrica::NUMERO_OPERACIONES);
+
+    RegistroMetricas();
+    RegistroMetricas(const RegistroMetricas&) = delete;
+    RegistroMetricas& operator=(const RegistroMetricas&) = delete;
+
+    static size_t IndiceTipoPagina(PageType tipo_pagina);
+    void RegistrarSiLenta(OperacionMetrica operacion, PageType tipo_pagina, const std::string& tabla,
+                          uint64_t nanosegundos, const std::string& detalle);
+
+    std::atomic<bool> activo_{true};
+    std::array<std::array<std::unique_ptr<HistogramaLatencia>, NUMERO_TIPOS_PAGINA>, NUMERO_OPERACIONES> por_tipo_;
+
+    mutable std::shared_mutex mutex_series_;
+    std::map<std::pair<OperacionMetrica, std::string>, std::unique_ptr<HistogramaLatencia>> por_tabla_;
+    std::map<std::string, std::unique_ptr<ContadorMetrica>> contadores_;
+
+    // Traza de operaciones lentas: umbral leído sin mutex, anillo bajo mutex_traza_
+    std::atomic<bool> traza_activa_{false};
+    std::atomic<uint64_t> umbral_traza_ns_{0};
+    std::atomic<uint64_t> operaciones_lentas_vistas_{0};
+    mutable std::mutex mutex_traza_;
+    ConfiguracionTraza configuracion_traza_;
+    std::deque<OperacionLenta> traza_;
+};
+
+/**
+ * @brief Mide una operación desde su construcción hasta Terminar() o el destructor.
+ *
+ * El tipo de página o el detalle pueden fijarse después de construirlo, cuando
+ * solo se conocen al final (p. ej. el tipo de una página recién leída).
+ */
+class MedidorLatencia {
+public:
+    explicit MedidorLatencia(OperacionMetrica operacion, PageType tipo_pagina = PageType::INVALID_PAGE,
+                             const std::string* tabla = nullptr)
+        : operacion_(operacion)
+        , tipo_pagina_(tipo_pagina)
+        , tabla_(tabla)
+        , activo_(RegistroMetricas::Global().Activo()) {
+        if (activo_) {
+            inicio_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~MedidorLatencia() { Terminar(); }
+
+    MedidorLatencia(const MedidorLatencia&) = delete;
+    MedidorLatencia& operator=(const MedidorLatencia&) = delete;
+
+    /**
+     * @brief false si el registro estaba desactivado al construirlo: permite no
+     * calcular etiquetas caras (p. ej. consultar el tipo de un bloque) en vano.
+     */
+    bool Activo() const { return activo_; }
+
+    void EstablecerTipoPagina(PageType tipo_pagina) { tipo_pagina_ = tipo_pagina; }
+    void EstablecerDetalle(std::string detalle) { detalle_ = std::move(detalle); }
+
+    /**
+     * @brief Descarta la medición (p. ej. una operación que no llegó a hacerse).
+     */
+    void Cancelar() { activo_ = false; }
+
+    void Terminar() {
+        if (!activo_) {
+            return;
+        }
+        activo_ = false;
+        uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - inicio_).count());
+        static const std::string sin_tabla;
+        RegistroMetricas::Global().Registrar(operacion_, tipo_pagina_, tabla_ ? *tabla_ : sin_tabla, ns, detalle_);
+    }
+
+private:
+    OperacionMetrica operacion_;
+    PageType tipo_pagina_;
+    const std::string* tabla_;
+    bool activo_;
+    std::chrono::steady_clock::time_point inicio_;
+    std::string detalle_;
+};
+
+#endif // METRICAS_H
@@ -0,0 +1,100 @@
+// include/pool_hilos.h - Pool de hilos de trabajo para los escaneos paralelos
+// Implementación mínima basada en una cola de tareas protegida por mutex
+
+#ifndef POOL_HILOS_H
+#define POOL_HILOS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool fijo de hilos que ejecuta tareas en orden FIFO.
+ *
+ * Lo usa el GestorRegistros para repartir los escaneos paralelos
+ * (EscaneoParalelo) entre hilos, un rango de páginas por tarea.
+ * Encolar() devuelve un std::future con el resultado de la tarea.
+ */
+class PoolHilos {
+public:
+    /**
+     * @brief Crea el pool con el número de hilos indicado.
+     * @param numero_hilos Número de hilos (0 = hardware_concurrency, mínimo 1).
+     */
+    explicit PoolHilos(uint32_t numero_hilos = 0) : detener_(false) {
+        if (numero_hilos == 0) {
+            numero_hilos = std::thread::hardware_concurrency();
+            if (numero_hilos == 0) numero_hilos = 1;
+        }
+        hilos_.reserve(numero_hilos);
+        for (uint32_t i = 0; i < numero_hilos; ++i) {
+            hilos_.emplace_back([this]() { BucleTrabajo(); });
+        }
+    }
+
+    /**
+     * @brief Espera a que terminen las tareas pendientes y detiene los hilos.
+     */
+    ~PoolHilos() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            detener_ = true;
+        }
+        condicion_.notify_all();
+        for (auto& hilo : hilos_) {
+            if (hilo.joinable()) hilo.join();
+        }
+    }
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    /**
+     * @brief Encola una tarea para su ejecución en algún hilo del pool.
+     * @param tarea Función a ejecutar.
+     * @return Futuro con el valor devuelto por la tarea.
+     */
+    template <typename Funcion>
+    auto Encolar(Funcion&& tarea) -> std::future<decltype(tarea())> {
+        using TipoResultado = decltype(tarea());
+        auto empaquetada = std::make_shared<std::packaged_task<TipoResultado()>>(std::forward<Funcion>(tarea));
+        std::future<TipoResultado> resultado = empaquetada->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tareas_.emplace([empaquetada]() { (*empaquetada)(); });
+        }
+        condicion_.notify_one();
+        return resultado;
+    }
+
+    uint32_t ObtenerNumeroHilos() const { return static_cast<uint32_t>(hilos_.size()); }
+
+private:
+    std::vector<std::thread> hilos_;
+    std::queue<std::function<void()>> tareas_;
+    std::mutex mutex_;
+    std::condition_variable condicion_;
+    bool detener_;
+
+    void BucleTrabajo() {
+        while (true) {
+            std::function<void()> tarea;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condicion_.wait(lock, [this]() { return detener_ || !tareas_.empty(); });
+                if (detener_ && tareas_.empty()) return;
+                tarea = std::move(tareas_.front());
+                tareas_.pop();
+            }
+            tarea();
+        }
+    }
+};
+
+#endif // POOL_HILOS_H
@@ -0,0 +1,712 @@
+// index/arbol_bmas_paginado.cpp - Implementación del árbol B+ paginado
+#include "arbol_bmas_paginado.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+// Acceso a los campos de un nodo: las entradas no están alineadas, se copian con memcpy
+using CabeceraNodo = ArbolBMasPaginado::CabeceraNodoArbol;
+
+CabeceraNodo* Nodo(Byte* datos) {
+    return reinterpret_cast<CabeceraNodo*>(datos + sizeof(CabeceraComun));
+}
+const CabeceraNodo* Nodo(const Byte* datos) {
+    return reinterpret_cast<const CabeceraNodo*>(datos + sizeof(CabeceraComun));
+}
+
+uint32_t LeerU32(const Byte* origen) {
+    uint32_t valor;
+    std::memcpy(&valor, origen, sizeof(valor));
+    return valor;
+}
+void EscribirU32(Byte* destino, uint32_t valor) {
+    std::memcpy(destino, &valor, sizeof(valor));
+}
+
+bool EsPaginaIndice(const Byte* datos) {
+    return reinterpret_cast<const CabeceraComun*>(datos)->tipo_pagina == PageType::INDEX;
+}
+
+} // namespace
+
+// Posiciones dentro de un nodo:
+//   hoja:    INICIO_NODO + i * TamañoEntradaHoja()                -> [clave][RecordId]
+//   interno: INICIO_NODO                                         -> hijo0
+//            INICIO_NODO + sizeof(BlockId) + i * TamañoEntradaInterno() -> [clave][RecordId][hijo i+1]
+#define ENTRADA_HOJA(datos, i) ((datos) + INICIO_NODO + (i) * TamañoEntradaHoja())
+#define ENTRADA_INTERNO(datos, i) ((datos) + INICIO_NODO + sizeof(BlockId) + (i) * TamañoEntradaInterno())
+
+// ===== CONSTRUCCIÓN Y APERTURA =====
+
+ArbolBMasPaginado::ArbolBMasPaginado(GestorBuffer& gestor_buffer, uint32_t longitud_clave)
+    : gestor_buffer_(&gestor_buffer), longitud_clave_(longitud_clave), id_meta_(INVALID_PAGE_ID), meta_() {
+    if (longitud_clave == 0 || longitud_clave > LONGITUD_MAXIMA_CLAVE) {
+        throw std::invalid_argument("ArbolBMasPaginado: longitud de clave fuera de rango");
+    }
+    capacidad_hoja_ = (BLOCK_SIZE - INICIO_NODO) / TamañoEntradaHoja();
+    capacidad_interno_ = (BLOCK_SIZE - INICIO_NODO - sizeof(BlockId)) / TamañoEntradaInterno();
+}
+
+Status ArbolBMasPaginado::Crear() {
+    Byte* datos_meta = nullptr;
+    BlockId id_meta = INVALID_PAGE_ID;
+    Status estado = gestor_buffer_->NewPage(id_meta, datos_meta);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    std::memset(datos_meta, 0, BLOCK_SIZE);
+    CabeceraComun cabecera;
+    cabecera.id_bloque = id_meta;
+    cabecera.tipo_pagina = PageType::INDEX;
+    std::memcpy(datos_meta, &cabecera, sizeof(cabecera));
+    gestor_buffer_->UnpinPage(id_meta, true);
+
+    BlockId id_raiz = INVALID_PAGE_ID;
+    Byte* datos_raiz = nullptr;
+    estado = NuevoNodo(true, id_raiz, datos_raiz);
+    if (estado != Status::OK) {
+        gestor_buffer_->DeletePage(id_meta);
+        return estado;
+    }
+    gestor_buffer_->UnpinPage(id_raiz, true);
+
+    id_meta_ = id_meta;
+    meta_.magic_number = MAGIC_ARBOL_BMAS;
+    meta_.longitud_clave = longitud_clave_;
+    meta_.id_raiz = id_raiz;
+    meta_.altura = 1;
+    meta_.numero_entradas = 0;
+    return GuardarMeta();
+}
+
+Status ArbolBMasPaginado::Abrir(BlockId id_meta) {
+    Byte* datos_meta = nullptr;
+    Status estado = gestor_buffer_->PinPage(id_meta, datos_meta);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    CabeceraMetaArbol meta;
+    std::memcpy(&meta, datos_meta + sizeof(CabeceraComun), sizeof(meta));
+    bool valida = EsPaginaIndice(datos_meta) && meta.magic_number == MAGIC_ARBOL_BMAS &&
+                  meta.longitud_clave == longitud_clave_ && meta.altura > 0;
+    gestor_buffer_->UnpinPage(id_meta, false);
+    if (!valida) {
+        return Status::INVALID_FORMAT;
+    }
+    id_meta_ = id_meta;
+    meta_ = meta;
+    return Status::OK;
+}
+
+// ===== OPERACIONES =====
+
+Status ArbolBMasPaginado::Insertar(const Byte* clave, RecordId id_registro) {
+    if (!EstaAbierto()) {
+        return Status::ERROR;
+    }
+    std::vector<BlockId> camino;
+    BlockId id_hoja = INVALID_PAGE_ID;
+    Status estado = DescenderHastaHoja(clave, id_registro, id_hoja, &camino);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    Byte* hoja = nullptr;
+    estado = gestor_buffer_->PinPage(id_hoja, hoja);
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    uint32_t n = Nodo(hoja)->numero_claves;
+    uint32_t pos = BuscarPosicionHoja(hoja, clave, id_registro);
+    if (pos < n && Comparar(ENTRADA_HOJA(hoja, pos), LeerU32(ENTRADA_HOJA(hoja, pos) + longitud_clave_),
+                            clave, id_registro) == 0) {
+        gestor_buffer_->UnpinPage(id_hoja, false);
+        return Status::DUPLICATE_ENTRY;
+    }
+
+    auto escribir_en_hoja = [this, clave, id_registro](Byte* destino, uint32_t posicion) {
+        uint32_t numero = Nodo(destino)->numero_claves;
+        std::memmove(ENTRADA_HOJA(destino, posicion + 1), ENTRADA_HOJA(destino, posicion),
+                     (numero - posicion) * TamañoEntradaHoja());
+        std::memcpy(ENTRADA_HOJA(destino, posicion), clave, longitud_clave_);
+        EscribirU32(ENTRADA_HOJA(destino, posicion) + longitud_clave_, id_registro);
+        Nodo(destino)->numero_claves = static_cast<uint16_t>(numero + 1);
+    };
+
+    if (n < capacidad_hoja_) {
+        escribir_en_hoja(hoja, pos);
+        gestor_buffer_->UnpinPage(id_hoja, true);
+        meta_.numero_entradas++;
+        return GuardarMeta();
+    }
+
+    // Hoja llena: la mitad superior pasa a una hoja nueva a su derecha
+    BlockId id_nueva = INVALID_PAGE_ID;
+    Byte* nueva = nullptr;
+    estado = NuevoNodo(true, id_nueva, nueva);
+    if (estado != Status::OK) {
+        gestor_buffer_->UnpinPage(id_hoja, false);
+        return estado;
+    }
+    uint32_t mitad = n / 2;
+    std::memcpy(ENTRADA_HOJA(nueva, 0), ENTRADA_HOJA(hoja, mitad), (n - mitad) * TamañoEntradaHoja());
+    Nodo(nueva)->numero_claves = static_cast<uint16_t>(n - mitad);
+    Nodo(hoja)->numero_claves = static_cast<uint16_t>(mitad);
+
+    BlockId id_siguiente = Nodo(hoja)->hoja_siguiente;
+    Nodo(nueva)->hoja_anterior = id_hoja;
+    Nodo(nueva)->hoja_siguiente = id_siguiente;
+    Nodo(hoja)->hoja_siguiente = id_nueva;
+    if (id_siguiente != INVALID_PAGE_ID) {
+        Byte* siguiente = nullptr;
+        if (gestor_buffer_->PinPage(id_siguiente, siguiente) == Status::OK) {
+            Nodo(siguiente)->hoja_anterior = id_nueva;
+            gestor_buffer_->UnpinPage(id_siguiente, true);
+        }
+    }
+
+    if (pos <= mitad) {
+        escribir_en_hoja(hoja, pos);
+    } else {
+        escribir_en_hoja(nueva, pos - mitad);
+    }
+
+    // El separador es la primera entrada de la hoja nueva
+    Byte clave_separador[LONGITUD_MAXIMA_CLAVE];
+    std::memcpy(clave_separador, ENTRADA_HOJA(nueva, 0), longitud_clave_);
+    RecordId id_separador = LeerU32(ENTRADA_HOJA(nueva, 0) + longitud_clave_);
+    gestor_buffer_->UnpinPage(id_nueva, true);
+    gestor_buffer_->UnpinPage(id_hoja, true);
+
+    meta_.numero_entradas++;
+    estado = InsertarEnPadre(camino, id_hoja, clave_separador, id_separador, id_nueva);
+    Status estado_meta = GuardarMeta();
+    return (estado != Status::OK) ? estado : estado_meta;
+}
+
+Status ArbolBMasPaginado::Eliminar(const Byte* clave, RecordId id_registro) {
+    if (!EstaAbierto()) {
+        return Status::ERROR;
+    }
+    BlockId id_hoja = INVALID_PAGE_ID;
+    Status estado = DescenderHastaHoja(clave, id_registro, id_hoja, nullptr);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    Byte* hoja = nullptr;
+    estado = gestor_buffer_->PinPage(id_hoja, hoja);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    uint32_t n = Nodo(hoja)->numero_claves;
+    uint32_t pos = BuscarPosicionHoja(hoja, clave, id_registro);
+    if (pos >= n || Comparar(ENTRADA_HOJA(hoja, pos), LeerU32(ENTRADA_HOJA(hoja, pos) + longitud_clave_),
+                             clave, id_registro) != 0) {
+        gestor_buffer_->UnpinPage(id_hoja, false);
+        return Status::NOT_FOUND;
+    }
+    std::memmove(ENTRADA_HOJA(hoja, pos), ENTRADA_HOJA(hoja, pos + 1), (n - pos - 1) * TamañoEntradaHoja());
+    Nodo(hoja)->numero_claves = static_cast<uint16_t>(n - 1);
+    gestor_buffer_->UnpinPage(id_hoja, true);
+
+    meta_.numero_entradas--;
+    return GuardarMeta();
+}
+
+Status ArbolBMasPaginado::Buscar(const Byte* clave, std::vector<RecordId>& ids_registro) const {
+    ids_registro.clear();
+    if (!EstaAbierto()) {
+        return Status::ERROR;
+    }
+    BlockId id_hoja = INVALID_PAGE_ID;
+    Status estado = DescenderHastaHoja(clave, 0, id_hoja, nullptr);
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    // Las entradas de la clave empiezan en esta hoja y pueden seguir en las siguientes
+    uint32_t pos = 0;
+    bool primera = true;
+    while (id_hoja != INVALID_PAGE_ID) {
+        Byte* hoja = nullptr;
+        if (gestor_buffer_->PinPage(id_hoja, hoja) != Status::OK) {
+            return Status::IO_ERROR;
+        }
+        uint32_t n = Nodo(hoja)->numero_claves;
+        pos = primera ? BuscarPosicionHoja(hoja, clave, 0) : 0;
+        primera = false;
+        for (; pos < n; ++pos) {
+            const Byte* entrada = ENTRADA_HOJA(hoja, pos);
+            if (std::memcmp(entrada, clave, longitud_clave_) != 0) {
+                gestor_buffer_->UnpinPage(id_hoja, false);
+                return ids_registro.empty() ? Status::NOT_FOUND : Status::OK;
+            }
+            ids_registro.push_back(LeerU32(entrada + longitud_clave_));
+        }
+        BlockId id_siguiente = Nodo(hoja)->hoja_siguiente;
+        gestor_buffer_->UnpinPage(id_hoja, false);
+        id_hoja = id_siguiente;
+    }
+    return ids_registro.empty() ? Status::NOT_FOUND : Status::OK;
+}
+
+// ===== RECORRIDOS POR RANGO =====
+
+static_assert(ArbolBMasPaginado::LONGITUD_MAXIMA_CLAVE == 64,
+              "IteradorRangoArbol reserva 64 bytes por límite");
+
+Status ArbolBMasPaginado::AbrirRango(const Byte* inferior, bool incluir_inferior, const Byte* superior,
+                                     uint32_t longitud_superior, bool incluir_superior,
+                                     IteradorRangoArbol& iterador) const {
+    iterador.Cerrar();
+    if (!EstaAbierto()) {
+        return Status::ERROR;
+    }
+    if (superior && (longitud_superior == 0 || longitud_superior > longitud_clave_)) {
+        return Status::INVALID_ARGUMENT;
+    }
+
+    // Sin límite inferior se baja con la clave mínima (todo ceros) hasta la primera hoja.
+    // Con límite exclusivo se baja detrás de sus entradas y se salta la que pudiera quedar.
+    Byte clave_minima[LONGITUD_MAXIMA_CLAVE] = {};
+    const Byte* clave_inicio = inferior ? inferior : clave_minima;
+    RecordId id_inicio = (inferior && !incluir_inferior) ? INVALID_RECORD_ID : 0;
+
+    BlockId id_hoja = INVALID_PAGE_ID;
+    Status estado = DescenderHastaHoja(clave_inicio, id_inicio, id_hoja, nullptr);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    Byte* hoja = nullptr;
+    estado = gestor_buffer_->PinPage(id_hoja, hoja);
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    iterador.gestor_buffer_ = gestor_buffer_;
+    iterador.longitud_clave_ = longitud_clave_;
+    iterador.id_hoja_ = id_hoja;
+    iterador.datos_hoja_ = hoja;
+    iterador.posicion_ = BuscarPosicionHoja(hoja, clave_inicio, id_inicio);
+    iterador.saltando_inferior_ = inferior && !incluir_inferior;
+    if (iterador.saltando_inferior_) {
+        std::memcpy(iterador.inferior_excluido_, inferior, longitud_clave_);
+    }
+    iterador.longitud_superior_ = superior ? longitud_superior : 0;
+    iterador.incluir_superior_ = incluir_superior;
+    if (superior) {
+        std::memcpy(iterador.superior_, superior, longitud_superior);
+    }
+    return Status::OK;
+}
+
+Status ArbolBMasPaginado::AbrirPrefijo(const Byte* prefijo, uint32_t longitud_prefijo,
+                                       IteradorRangoArbol& iterador) const {
+    if (longitud_prefijo == 0) {
+        return AbrirRango(nullptr, true, nullptr, 0, true, iterador);
+    }
+    if (longitud_prefijo > longitud_clave_) {
+        return Status::INVALID_ARGUMENT;
+    }
+    // El prefijo rellenado con ceros es la menor clave que empieza por él
+    Byte inferior[LONGITUD_MAXIMA_CLAVE] = {};
+    std::memcpy(inferior, prefijo, longitud_prefijo);
+    return AbrirRango(inferior, true, prefijo, longitud_prefijo, true, iterador);
+}
+
+bool IteradorRangoArbol::Siguiente(const Byte*& clave, RecordId& id_registro) {
+    const uint32_t tamano_entrada = longitud_clave_ + sizeof(RecordId);
+    while (datos_hoja_ != nullptr) {
+        if (posicion_ >= Nodo(datos_hoja_)->numero_claves) {
+            // Fin de la hoja: se ancla la siguiente antes de soltar la actual
+            BlockId id_siguiente = Nodo(datos_hoja_)->hoja_siguiente;
+            Byte* siguiente = nullptr;
+            if (id_siguiente == INVALID_PAGE_ID || gestor_buffer_->PinPage(id_siguiente, siguiente) != Status::OK) {
+                Cerrar();
+                return false;
+            }
+            gestor_buffer_->UnpinPage(id_hoja_, false);
+            id_hoja_ = id_siguiente;
+            datos_hoja_ = siguiente;
+            posicion_ = 0;
+            continue;
+        }
+        const Byte* entrada = datos_hoja_ + ArbolBMasPaginado::INICIO_NODO + posicion_ * tamano_entrada;
+        posicion_++;
+        if (saltando_inferior_) {
+            if (std::memcmp(entrada, inferior_excluido_, longitud_clave_) == 0) {
+                continue;
+            }
+            saltando_inferior_ = false;
+        }
+        if (longitud_superior_ > 0) {
+            int comparacion = std::memcmp(entrada, superior_, longitud_superior_);
+            if (comparacion > 0 || (comparacion == 0 && !incluir_superior_)) {
+                Cerrar();
+                return false;
+            }
+        }
+        clave = entrada;
+        id_registro = LeerU32(entrada + longitud_clave_);
+        return true;
+    }
+    return false;
+}
+
+void IteradorRangoArbol::Cerrar() {
+    if (datos_hoja_ != nullptr) {
+        gestor_buffer_->UnpinPage(id_hoja_, false);
+    }
+    datos_hoja_ = nullptr;
+    id_hoja_ = INVALID_PAGE_ID;
+}
+
+void ArbolBMasPaginado::ImprimirEstructura() const {
+    std::cout << "\n=== ÁRBOL B+ PAGINADO (meta " << id_meta_ << ") ===" << std::endl;
+    if (!EstaAbierto()) {
+        std::cout << "Árbol no abierto" << std::endl;
+        return;
+    }
+    std::cout << "Raíz: " << meta_.id_raiz << ", altura: " << meta_.altura << std::endl;
+    std::cout << "Entradas: " << meta_.numero_entradas << std::endl;
+    std::cout << "Longitud de clave: " << longitud_clave_ << " bytes" << std::endl;
+    std::cout << "Capacidad por hoja / nodo interno: " << capacidad_hoja_ << " / " << capacidad_interno_ << std::endl;
+
+    // Recorrer el borde izquierdo hasta la primera hoja y contar las hojas enlazadas
+    BlockId id_nodo = meta_.id_raiz;
+    for (uint32_t nivel = 1; nivel < meta_.altura; ++nivel) {
+        Byte* nodo = nullptr;
+        if (gestor_buffer_->PinPage(id_nodo, nodo) != Status::OK) return;
+        BlockId hijo = LeerU32(nodo + INICIO_NODO);
+        gestor_buffer_->UnpinPage(id_nodo, false);
+        id_nodo = hijo;
+    }
+    uint32_t numero_hojas = 0;
+    uint64_t entradas_en_hojas = 0;
+    while (id_nodo != INVALID_PAGE_ID) {
+        Byte* hoja = nullptr;
+        if (gestor_buffer_->PinPage(id_nodo, hoja) != Status::OK) break;
+        numero_hojas++;
+        entradas_en_hojas += Nodo(hoja)->numero_claves;
+        BlockId siguiente = Nodo(hoja)->hoja_siguiente;
+        gestor_buffer_->UnpinPage(id_nodo, false);
+        id_nodo = siguiente;
+    }
+    std::cout << "Hojas: " << numero_hojas << " (ocupación media: "
+              << (numero_hojas ? entradas_en_hojas * 100 / (static_cast<uint64_t>(numero_hojas) * capacidad_hoja_) : 0)
+              << "%)" << std::endl;
+}
+
+// ===== CONSTRUCCIÓN MASIVA =====
+
+Status ArbolBMasPaginado::ConstruirMasivo(const FuenteEntradasOrdenadas& siguiente, double factor_llenado) {
+    if (EstaAbierto()) {
+        return Status::ERROR;
+    }
+    if (!(factor_llenado > 0.0 && factor_llenado <= 1.0)) {
+        return Status::INVALID_ARGUMENT;
+    }
+    Status estado = Crear(); // La hoja raíz vacía pasa a ser la primera hoja
+    if (estado != Status::OK) {
+        return estado;
+    }
+    uint32_t objetivo_hoja = std::max<uint32_t>(static_cast<uint32_t>(capacidad_hoja_ * factor_llenado), 1);
+    uint32_t objetivo_interno = std::max<uint32_t>(static_cast<uint32_t>(capacidad_interno_ * factor_llenado), 1);
+
+    std::vector<NodoAbierto> niveles; // niveles[0] es la hoja que se está llenando
+    Byte* primera_hoja = nullptr;
+    estado = gestor_buffer_->PinPage(meta_.id_raiz, primera_hoja);
+    if (estado != Status::OK) {
+        id_meta_ = INVALID_PAGE_ID;
+        return estado;
+    }
+    niveles.push_back({meta_.id_raiz, primera_hoja});
+
+    Byte clave[LONGITUD_MAXIMA_CLAVE];
+    Byte clave_anterior[LONGITUD_MAXIMA_CLAVE];
+    RecordId id_registro = 0;
+    RecordId id_anterior = 0;
+    uint32_t total = 0;
+    while (siguiente(clave, id_registro)) {
+        if (total > 0 && Comparar(clave_anterior, id_anterior, clave, id_registro) >= 0) {
+            estado = Status::INVALID_ARGUMENT;
+            break;
+        }
+        if (Nodo(niveles[0].datos)->numero_claves >= objetivo_hoja) {
+            BlockId id_nueva = INVALID_PAGE_ID;
+            Byte* nueva = nullptr;
+            estado = NuevoNodo(true, id_nueva, nueva);
+            if (estado != Status::OK) {
+                break;
+            }
+            BlockId id_cerrada = niveles[0].id;
+            Nodo(nueva)->hoja_anterior = id_cerrada;
+            Nodo(niveles[0].datos)->hoja_siguiente = id_nueva;
+            gestor_buffer_->UnpinPage(id_cerrada, true);
+            niveles[0] = {id_nueva, nueva};
+            estado = AñadirSeparadorMasivo(niveles, 1, clave, id_registro, id_cerrada, id_nueva, objetivo_interno);
+            if (estado != Status::OK) {
+                break;
+            }
+        }
+        Byte* hoja = niveles[0].datos;
+        uint32_t n = Nodo(hoja)->numero_claves;
+        std::memcpy(ENTRADA_HOJA(hoja, n), clave, longitud_clave_);
+        EscribirU32(ENTRADA_HOJA(hoja, n) + longitud_clave_, id_registro);
+        Nodo(hoja)->numero_claves = static_cast<uint16_t>(n + 1);
+
+        std::memcpy(clave_anterior, clave, longitud_clave_);
+        id_anterior = id_registro;
+        total++;
+    }
+
+    for (const auto& nodo : niveles) {
+        gestor_buffer_->UnpinPage(nodo.id, true);
+    }
+    if (estado != Status::OK) {
+        // Las páginas ya escritas quedan sin referenciar; el árbol no se da por creado
+        id_meta_ = INVALID_PAGE_ID;
+        return estado;
+    }
+    meta_.id_raiz = niveles.back().id;
+    meta_.altura = static_cast<uint32_t>(niveles.size());
+    meta_.numero_entradas = total;
+    return GuardarMeta();
+}
+
+Status ArbolBMasPaginado::AñadirSeparadorMasivo(std::vector<NodoAbierto>& niveles, size_t nivel, const Byte* clave,
+                                                RecordId id, BlockId hijo_izquierdo, BlockId hijo_derecho,
+                                                uint32_t objetivo_interno) {
+    if (nivel == niveles.size()) {
+        // Primer separador de este nivel: nace el nodo que por ahora es la raíz
+        BlockId id_nodo = INVALID_PAGE_ID;
+        Byte* nodo = nullptr;
+        Status estado = NuevoNodo(false, id_nodo, nodo);
+        if (estado != Status::OK) {
+            return estado;
+        }
+        EscribirU32(nodo + INICIO_NODO, hijo_izquierdo);
+        std::memcpy(ENTRADA_INTERNO(nodo, 0), clave, longitud_clave_);
+        EscribirU32(ENTRADA_INTERNO(nodo, 0) + longitud_clave_, id);
+        EscribirU32(ENTRADA_INTERNO(nodo, 0) + longitud_clave_ + sizeof(RecordId), hijo_derecho);
+        Nodo(nodo)->numero_claves = 1;
+        niveles.push_back({id_nodo, nodo});
+        return Status::OK;
+    }
+
+    Byte* nodo = niveles[nivel].datos;
+    uint32_t n = Nodo(nodo)->numero_claves;
+    if (n < objetivo_interno) {
+        std::memcpy(ENTRADA_INTERNO(nodo, n), clave, longitud_clave_);
+        EscribirU32(ENTRADA_INTERNO(nodo, n) + longitud_clave_, id);
+        EscribirU32(ENTRADA_INTERNO(nodo, n) + longitud_clave_ + sizeof(RecordId), hijo_derecho);
+        Nodo(nodo)->numero_claves = static_cast<uint16_t>(n + 1);
+        return Status::OK;
+    }
+
+    // Nodo lleno: el separador sube y hijo_derecho pasa a ser hijo0 de un nodo nuevo
+    BlockId id_nuevo = INVALID_PAGE_ID;
+    Byte* nuevo = nullptr;
+    Status estado = NuevoNodo(false, id_nuevo, nuevo);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    EscribirU32(nuevo + INICIO_NODO, hijo_derecho);
+    BlockId id_cerrado = niveles[nivel].id;
+    gestor_buffer_->UnpinPage(id_cerrado, true);
+    niveles[nivel] = {id_nuevo, nuevo};
+    return AñadirSeparadorMasivo(niveles, nivel + 1, clave, id, id_cerrado, id_nuevo, objetivo_interno);
+}
+
+// ===== CODIFICACIÓN DE CLAVES =====
+
+void ArbolBMasPaginado::CodificarEntero(int64_t valor, Byte* destino) {
+    uint64_t sin_signo = static_cast<uint64_t>(valor) ^ (1ULL << 63);
+    for (int i = LONGITUD_CLAVE_ENTERA - 1; i >= 0; --i) {
+        destino[i] = static_cast<Byte>(sin_signo & 0xFF);
+        sin_signo >>= 8;
+    }
+}
+
+void ArbolBMasPaginado::CodificarCadena(const std::string& valor, Byte* destino, uint32_t longitud) {
+    std::memset(destino, 0, longitud);
+    std::memcpy(destino, valor.data(), std::min<size_t>(valor.size(), longitud));
+}
+
+// ===== AUXILIARES PRIVADOS =====
+
+int ArbolBMasPaginado::Comparar(const Byte* clave_a, RecordId id_a, const Byte* clave_b, RecordId id_b) const {
+    int resultado = std::memcmp(clave_a, clave_b, longitud_clave_);
+    if (resultado != 0) {
+        return resultado;
+    }
+    return (id_a < id_b) ? -1 : (id_a > id_b ? 1 : 0);
+}
+
+uint32_t ArbolBMasPaginado::BuscarPosicionHoja(const Byte* nodo, const Byte* clave, RecordId id) const {
+    uint32_t inicio = 0;
+    uint32_t fin = Nodo(nodo)->numero_claves;
+    while (inicio < fin) {
+        uint32_t medio = inicio + (fin - inicio) / 2;
+        const Byte* entrada = ENTRADA_HOJA(nodo, medio);
+        if (Comparar(entrada, LeerU32(entrada + longitud_clave_), clave, id) < 0) {
+            inicio = medio + 1;
+        } else {
+            fin = medio;
+        }
+    }
+    return inicio;
+}
+
+uint32_t ArbolBMasPaginado::BuscarHijo(const Byte* nodo, const Byte* clave, RecordId id) const {
+    uint32_t inicio = 0;
+    uint32_t fin = Nodo(nodo)->numero_claves;
+    while (inicio < fin) {
+        uint32_t medio = inicio + (fin - inicio) / 2;
+        const Byte* entrada = ENTRADA_INTERNO(nodo, medio);
+        if (Comparar(entrada, LeerU32(entrada + longitud_clave_), clave, id) <= 0) {
+            inicio = medio + 1;
+        } else {
+            fin = medio;
+        }
+    }
+    return inicio;
+}
+
+Status ArbolBMasPaginado::DescenderHastaHoja(const Byte* clave, RecordId id, BlockId& id_hoja,
+                                             std::vector<BlockId>* camino) const {
+    BlockId id_nodo = meta_.id_raiz;
+    for (uint32_t nivel = 1; nivel < meta_.altura; ++nivel) {
+        Byte* nodo = nullptr;
+        Status estado = gestor_buffer_->PinPage(id_nodo, nodo);
+        if (estado != Status::OK) {
+            return estado;
+        }
+        if (!EsPaginaIndice(nodo) || Nodo(nodo)->es_hoja) {
+            gestor_buffer_->UnpinPage(id_nodo, false);
+            return Status::INVALID_PAGE_TYPE;
+        }
+        uint32_t hijo = BuscarHijo(nodo, clave, id);
+        BlockId id_hijo = (hijo == 0) ? LeerU32(nodo + INICIO_NODO)
+                                      : LeerU32(ENTRADA_INTERNO(nodo, hijo - 1) + longitud_clave_ + sizeof(RecordId));
+        gestor_buffer_->UnpinPage(id_nodo, false);
+        if (camino) {
+            camino->push_back(id_nodo);
+        }
+        id_nodo = id_hijo;
+    }
+    id_hoja = id_nodo;
+    return Status::OK;
+}
+
+Status ArbolBMasPaginado::NuevoNodo(bool es_hoja, BlockId& id_nodo, Byte*& datos) {
+    Status estado = gestor_buffer_->NewPage(id_nodo, datos);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    std::memset(datos, 0, BLOCK_SIZE);
+    CabeceraComun cabecera;
+    cabecera.id_bloque = id_nodo;
+    cabecera.tipo_pagina = PageType::INDEX;
+    std::memcpy(datos, &cabecera, sizeof(cabecera));
+    CabeceraNodo* nodo = Nodo(datos);
+    nodo->es_hoja = es_hoja ? 1 : 0;
+    nodo->numero_claves = 0;
+    nodo->hoja_anterior = INVALID_PAGE_ID;
+    nodo->hoja_siguiente = INVALID_PAGE_ID;
+    return Status::OK;
+}
+
+Status ArbolBMasPaginado::InsertarEnPadre(std::vector<BlockId>& camino, BlockId hijo_izquierdo,
+                                          const Byte* clave, RecordId id, BlockId hijo_derecho) {
+    if (camino.empty()) {
+        // Se ha dividido la raíz: el árbol crece un nivel
+        BlockId id_raiz = INVALID_PAGE_ID;
+        Byte* raiz = nullptr;
+        Status estado = NuevoNodo(false, id_raiz, raiz);
+        if (estado != Status::OK) {
+            return estado;
+        }
+        EscribirU32(raiz + INICIO_NODO, hijo_izquierdo);
+        std::memcpy(ENTRADA_INTERNO(raiz, 0), clave, longitud_clave_);
+        EscribirU32(ENTRADA_INTERNO(raiz, 0) + longitud_clave_, id);
+        EscribirU32(ENTRADA_INTERNO(raiz, 0) + longitud_clave_ + sizeof(RecordId), hijo_derecho);
+        Nodo(raiz)->numero_claves = 1;
+        gestor_buffer_->UnpinPage(id_raiz, true);
+        meta_.id_raiz = id_raiz;
+        meta_.altura++;
+        return Status::OK;
+    }
+
+    BlockId id_padre = camino.back();
+    camino.pop_back();
+    Byte* padre = nullptr;
+    Status estado = gestor_buffer_->PinPage(id_padre, padre);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    uint32_t n = Nodo(padre)->numero_claves;
+    uint32_t pos = BuscarHijo(padre, clave, id);
+    uint32_t tam = TamañoEntradaInterno();
+
+    if (n < capacidad_interno_) {
+        std::memmove(ENTRADA_INTERNO(padre, pos + 1), ENTRADA_INTERNO(padre, pos), (n - pos) * tam);
+        std::memcpy(ENTRADA_INTERNO(padre, pos), clave, longitud_clave_);
+        EscribirU32(ENTRADA_INTERNO(padre, pos) + longitud_clave_, id);
+        EscribirU32(ENTRADA_INTERNO(padre, pos) + longitud_clave_ + sizeof(RecordId), hijo_derecho);
+        Nodo(padre)->numero_claves = static_cast<uint16_t>(n + 1);
+        gestor_buffer_->UnpinPage(id_padre, true);
+        return Status::OK;
+    }
+
+    // Nodo interno lleno: se arma la secuencia con el separador nuevo y se parte por la mitad.
+    // El separador central sube al padre y su hijo derecho pasa a ser hijo0 del nodo nuevo.
+    uint32_t total = n + 1;
+    std::vector<Byte> entradas(static_cast<size_t>(total) * tam);
+    std::memcpy(entradas.data(), ENTRADA_INTERNO(padre, 0), static_cast<size_t>(pos) * tam);
+    Byte* insertada = entradas.data() + static_cast<size_t>(pos) * tam;
+    std::memcpy(insertada, clave, longitud_clave_);
+    EscribirU32(insertada + longitud_clave_, id);
+    EscribirU32(insertada + longitud_clave_ + sizeof(RecordId), hijo_derecho);
+    std::memcpy(insertada + tam, ENTRADA_INTERNO(padre, pos), static_cast<size_t>(n - pos) * tam);
+
+    BlockId id_nuevo = INVALID_PAGE_ID;
+    Byte* nuevo = nullptr;
+    estado = NuevoNodo(false, id_nuevo, nuevo);
+    if (estado != Status::OK) {
+        gestor_buffer_->UnpinPage(id_padre, false);
+        return estado;
+    }
+    uint32_t mitad = total / 2;
+    const Byte* central = entradas.data() + static_cast<size_t>(mitad) * tam;
+    Byte clave_central[LONGITUD_MAXIMA_CLAVE];
+    std::memcpy(clave_central, central, longitud_clave_);
+    RecordId id_central = LeerU32(central + longitud_clave_);
+
+    std::memcpy(ENTRADA_INTERNO(padre, 0), entradas.data(), static_cast<size_t>(mitad) * tam);
+    Nodo(padre)->numero_claves = static_cast<uint16_t>(mitad);
+    EscribirU32(nuevo + INICIO_NODO, LeerU32(central + longitud_clave_ + sizeof(RecordId)));
+    std::memcpy(ENTRADA_INTERNO(nuevo, 0), central + tam, static_cast<size_t>(total - mitad - 1) * tam);
+    Nodo(nuevo)->numero_claves = static_cast<uint16_t>(total - mitad - 1);
+
+    gestor_buffer_->UnpinPage(id_nuevo, true);
+    gestor_buffer_->UnpinPage(id_padre, true);
+    return InsertarEnPadre(camino, id_padre, clave_central, id_central, id_nuevo);
+}
+
+Status ArbolBMasPaginado::GuardarMeta() {
+    Byte* datos_meta = nullptr;
+    Status estado = gestor_buffer_->PinPage(id_meta_, datos_meta);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    std::memcpy(datos_meta + sizeof(CabeceraComun), &meta_, sizeof(meta_));
+    gestor_buffer_->UnpinPage(id_meta_, true);
+    return Status::OK;
+}
+
+#undef ENTRADA_HOJA
+#undef ENTRADA_INTERNO
@@ -0,0 +1,257 @@
+// index/arbol_bmas_paginado.h - Árbol B+ cuyos nodos son páginas INDEX del GestorBuffer
+// Sustituye a los árboles de nodos en el heap (orden 4) reconstruidos desde texto al arrancar
+
+#ifndef ARBOL_BMAS_PAGINADO_H
+#define ARBOL_BMAS_PAGINADO_H
+
+#include "../include/common.h"
+#include "../data_storage/gestor_buffer.h"
+#include "../data_storage/cabeceras_bloques.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+class ArbolBMasPaginado;
+
+/**
+ * @brief Recorrido ascendente de un rango de claves por la cadena de hojas.
+ *
+ * Mantiene anclada solo la hoja actual y devuelve punteros a la clave dentro
+ * del frame, sin copiar resultados. Se abre con ArbolBMasPaginado::AbrirRango() o
+ * AbrirPrefijo(); Cerrar() (o destruirlo) desancla la hoja.
+ */
+class IteradorRangoArbol {
+public:
+    IteradorRangoArbol() = default;
+    ~IteradorRangoArbol() { Cerrar(); }
+
+    IteradorRangoArbol(const IteradorRangoArbol&) = delete;
+    IteradorRangoArbol& operator=(const IteradorRangoArbol&) = delete;
+
+    /**
+     * @brief Avanza a la siguiente entrada del rango.
+     * @param clave [out] Clave codificada; válida hasta la siguiente llamada o Cerrar()
+     * @param id_registro [out] RecordId de la entrada
+     * @return false al salir del rango (el iterador se cierra solo)
+     */
+    bool Siguiente(const Byte*& clave, RecordId& id_registro);
+
+    void Cerrar();
+    bool EstaAbierto() const { return datos_hoja_ != nullptr; }
+
+private:
+    friend class ArbolBMasPaginado;
+
+    GestorBuffer* gestor_buffer_ = nullptr;
+    uint32_t longitud_clave_ = 0;
+    BlockId id_hoja_ = INVALID_PAGE_ID;
+    Byte* datos_hoja_ = nullptr;
+    uint32_t posicion_ = 0;
+
+    Byte inferior_excluido_[64];        // Clave que se salta al principio (límite inferior exclusivo)
+    bool saltando_inferior_ = false;
+    Byte superior_[64];
+    uint32_t longitud_superior_ = 0;    // 0 = sin límite superior
+    bool incluir_superior_ = true;
+};
+
+/**
+ * @brief Árbol B+ persistente con un nodo por página.
+ *
+ * PÁGINAS (todas de tipo PageType::INDEX, tras la CabeceraComun):
+ * - Meta: CabeceraMetaArbol con la raíz, la altura y el número de entradas. Su
+ *   BlockId identifica el índice: basta con guardarlo para reabrirlo sin cargar nada.
+ * - Hoja: CabeceraNodoArbol + entradas [clave][RecordId] ordenadas, enlazadas con
+ *   la hoja anterior y la siguiente para recorrer rangos.
+ * - Interno: CabeceraNodoArbol + hijo0 + entradas [clave][RecordId][hijo].
+ *
+ * CLAVES:
+ * - De longitud fija (longitud_clave bytes) y comparadas con memcmp. Codificar*()
+ *   las convierte para que el orden de bytes coincida con el orden del valor.
+ * - Las claves repetidas se guardan como entradas (clave, RecordId) contiguas y
+ *   ordenadas por RecordId: cada clave tiene su lista de RecordIds en las hojas sin
+ *   reservar memoria aparte, y los separadores internos usan el par completo, así que
+ *   una lista puede ocupar varias hojas.
+ *
+ * El orden (fan-out) sale de BLOCK_SIZE: con claves de 8 bytes caben más de 300
+ * entradas por nodo, por lo que tres niveles bastan para decenas de millones de claves.
+ * Los nodos se buscan con búsqueda binaria. Eliminar no fusiona nodos: una hoja
+ * puede quedar vacía y se salta al recorrer.
+ *
+ * No es seguro para hilos: quien lo usa debe serializar el acceso.
+ */
+class ArbolBMasPaginado {
+public:
+    static constexpr uint32_t MAGIC_ARBOL_BMAS = 0x54504D42; // "BMPT" en ASCII
+    static constexpr uint32_t LONGITUD_MAXIMA_CLAVE = 64;
+    static constexpr uint32_t LONGITUD_CLAVE_ENTERA = sizeof(int64_t);
+
+    struct CabeceraMetaArbol {
+        uint32_t magic_number;
+        uint32_t longitud_clave;
+        BlockId id_raiz;
+        uint32_t altura;            // 1 = la raíz es una hoja
+        uint32_t numero_entradas;
+    };
+
+    struct CabeceraNodoArbol {
+        uint16_t es_hoja;
+        uint16_t numero_claves;
+        BlockId hoja_anterior;      // Solo en hojas; INVALID_PAGE_ID en los extremos
+        BlockId hoja_siguiente;
+    };
+
+    static constexpr uint32_t INICIO_NODO = sizeof(CabeceraComun) + sizeof(CabeceraNodoArbol);
+
+    /**
+     * @brief Lanza std::invalid_argument si la longitud de clave es 0 o mayor que
+     *        LONGITUD_MAXIMA_CLAVE.
+     * @param gestor_buffer Gestor que aloja las páginas del árbol
+     * @param longitud_clave Bytes de cada clave codificada
+     */
+    ArbolBMasPaginado(GestorBuffer& gestor_buffer, uint32_t longitud_clave);
+
+    /**
+     * @brief Crea un árbol vacío: una página meta y una hoja raíz.
+     */
+    Status Crear();
+
+    /**
+     * @brief Productor de entradas para ConstruirMasivo(): escribe la siguiente clave
+     *        (longitud_clave bytes) y su RecordId, o devuelve false al terminar.
+     */
+    using FuenteEntradasOrdenadas = std::function<bool(Byte* clave, RecordId& id_registro)>;
+
+    /**
+     * @brief Crea el árbol de abajo arriba a partir de entradas ordenadas por (clave, RecordId).
+     *
+     * Llena las hojas de izquierda a derecha y va subiendo el primer par de cada hoja
+     * nueva al nivel superior, así que cada página se escribe una sola vez y no hay
+     * divisiones. Solo se mantiene anclado un nodo por nivel.
+     *
+     * @param factor_llenado Fracción de cada nodo que se ocupa (0, 1]; el resto queda
+     *        libre para inserciones posteriores sin dividir
+     * @return ERROR si el árbol ya estaba abierto; INVALID_ARGUMENT si las entradas no
+     *         llegan en orden estrictamente creciente
+     */
+    Status ConstruirMasivo(const FuenteEntradasOrdenadas& siguiente, double factor_llenado);
+
+    /**
+     * @brief Abre un árbol existente desde su página meta.
+     * @return INVALID_FORMAT si la página no es la meta de un árbol con esta longitud de clave
+     */
+    Status Abrir(BlockId id_meta);
+
+    bool EstaAbierto() const { return id_meta_ != INVALID_PAGE_ID; }
+    BlockId ObtenerIdMeta() const { return id_meta_; }
+    uint32_t ObtenerLongitudClave() const { return longitud_clave_; }
+    uint32_t ObtenerAltura() const { return meta_.altura; }
+    uint32_t ObtenerNumeroEntradas() const { return meta_.numero_entradas; }
+    uint32_t ObtenerCapacidadHoja() const { return capacidad_hoja_; }
+    uint32_t ObtenerCapacidadInterno() const { return capacidad_interno_; }
+
+    /**
+     * @brief Inserta la entrada (clave, id_registro).
+     * @return DUPLICATE_ENTRY si ya existía exactamente esa entrada
+     */
+    Status Insertar(const Byte* clave, RecordId id_registro);
+
+    /**
+     * @brief Elimina la entrada (clave, id_registro).
+     * @return NOT_FOUND si no existía
+     */
+    Status Eliminar(const Byte* clave, RecordId id_registro);
+
+    /**
+     * @brief Devuelve los RecordId asociados a una clave, en orden.
+     * @return NOT_FOUND si la clave no tiene entradas
+     */
+    Status Buscar(const Byte* clave, std::vector<RecordId>& ids_registro) const;
+
+    /**
+     * @brief Abre un recorrido ascendente entre dos límites.
+     * @param inferior Clave inicial (longitud_clave bytes), o nullptr para empezar por la primera hoja
+     * @param superior Límite superior, o nullptr para llegar hasta el final. Solo se comparan sus
+     *        primeros longitud_superior bytes: con menos de longitud_clave actúa como prefijo y,
+     *        si es inclusivo, entran todas las claves que empiezan por él.
+     * @return Status de la operación; un rango vacío devuelve OK y el iterador no da entradas
+     */
+    Status AbrirRango(const Byte* inferior, bool incluir_inferior, const Byte* superior,
+                      uint32_t longitud_superior, bool incluir_superior, IteradorRangoArbol& iterador) const;
+
+    /**
+     * @brief Abre un recorrido por las claves que empiezan por los primeros longitud_prefijo bytes.
+     */
+    Status AbrirPrefijo(const Byte* prefijo, uint32_t longitud_prefijo, IteradorRangoArbol& iterador) const;
+
+    void ImprimirEstructura() const;
+
+    // ===== CODIFICACIÓN DE CLAVES =====
+
+    /**
+     * @brief Entero big-endian con el bit de signo invertido (orden de memcmp = orden numérico).
+     */
+    static void CodificarEntero(int64_t valor, Byte* destino);
+
+    /**
+     * @brief Cadena rellenada con ceros o truncada a longitud bytes. Las cadenas más
+     *        largas se comparan por su prefijo: el llamador debe confirmar la coincidencia.
+     */
+    static void CodificarCadena(const std::string& valor, Byte* destino, uint32_t longitud);
+
+private:
+    GestorBuffer* gestor_buffer_;
+    uint32_t longitud_clave_;
+    uint32_t capacidad_hoja_;
+    uint32_t capacidad_interno_;
+    BlockId id_meta_;
+    CabeceraMetaArbol meta_;
+
+    uint32_t TamañoEntradaHoja() const { return longitud_clave_ + sizeof(RecordId); }
+    uint32_t TamañoEntradaInterno() const { return longitud_clave_ + sizeof(RecordId) + sizeof(BlockId); }
+
+    int Comparar(const Byte* clave_a, RecordId id_a, const Byte* clave_b, RecordId id_b) const;
+
+    /**
+     * @brief Primera posición de la hoja cuya entrada es >= (clave, id).
+     */
+    uint32_t BuscarPosicionHoja(const Byte* nodo, const Byte* clave, RecordId id) const;
+
+    /**
+     * @brief Hijo por el que continuar: número de separadores <= (clave, id).
+     */
+    uint32_t BuscarHijo(const Byte* nodo, const Byte* clave, RecordId id) const;
+
+    /**
+     * @brief Baja hasta la hoja que debe contener (clave, id).
+     * @param camino [out] Opcional: nodos internos visitados, de la raíz hacia abajo
+     */
+    Status DescenderHastaHoja(const Byte* clave, RecordId id, BlockId& id_hoja,
+                              std::vector<BlockId>* camino) const;
+
+    Status NuevoNodo(bool es_hoja, BlockId& id_nodo, Byte*& datos);
+
+    /**
+     * @brief Inserta el separador (clave, id) -> hijo_derecho en el padre, dividiendo
+     *        hacia arriba si hace falta.
+     */
+    Status InsertarEnPadre(std::vector<BlockId>& camino, BlockId hijo_izquierdo,
+                           const Byte* clave, RecordId id, BlockId hijo_derecho);
+
+    Status GuardarMeta();
+
+    struct NodoAbierto {
+        BlockId id;
+        Byte* datos;
+    };
+
+    /**
+     * @brief Construcción masiva: añade el separador (clave, id) -> hijo_derecho al nodo
+     *        abierto del nivel indicado, abriendo uno nuevo (o la raíz) si está lleno.
+     */
+    Status AñadirSeparadorMasivo(std::vector<NodoAbierto>& niveles, size_t nivel, const Byte* clave,
+                                 RecordId id, BlockId hijo_izquierdo, BlockId hijo_derecho,
+                                 uint32_t objetivo_interno);
+};
+
+#endif // ARBOL_BMAS_PAGINADO_H
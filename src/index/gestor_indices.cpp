@@ -1,9 +1,14 @@
 #include "gestor_indices.h"
 #include "../include/common.h"
+#include "../include/metricas.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
 
 // Constructor
 GestorIndices::GestorIndices(GestorCatalogo* catalogo_ptr)
@@ -159,7 +164,7 @@ ColumnType GestorIndices::ObtenerTipoColumna(const std::string& nombre_tabla, co
 }
 
 // Crear multiples indices automaticos
-Status GestorIndices::CrearIndicesAutomaticosMasivos(const std::string& nombre_tabla, const std::vector<std::string>& columnas) {
+Status GestorIndices::CrearIndicesAutomaticosPorTabla(const std::string& nombre_tabla, const std::vector<std::string>& columnas) {
     if (nombre_tabla.empty() || columnas.empty()) {
         std::cout << "❌ Error: Parametros invalidos para creacion masiva" << std::endl;
         return Status::INVALID_ARGUMENT;
@@ -192,14 +197,332 @@ Status GestorIndices::CrearIndicesAutomaticosMasivos(const std::string& nombre_t
     return (exitosos > 0) ? Status::SUCCESS : Status::OPERATION_FAILED;
 }
 
-// Cargar indices automaticamente
+// Construccion masiva: un recorrido, ordenacion externa y empaquetado de abajo arriba
+Status GestorIndices::ConstruirIndicesMasivos(const std::string& nombre_tabla, const std::vector<std::string>& columnas,
+                                              const FuenteFilasIndice& siguiente_fila,
+                                              const OpcionesConstruccionMasiva& opciones) {
+    if (nombre_tabla.empty() || columnas.empty() || !siguiente_fila || !gestor_buffer_) {
+        std::cout << "❌ Error: Parametros invalidos para construccion masiva" << std::endl;
+        return Status::INVALID_ARGUMENT;
+    }
+
+    struct ConstruccionColumna {
+        std::string nombre;
+        size_t posicion;                                // Posicion del valor en la fila
+        TipoIndice tipo;
+        std::unique_ptr<IndiceBase> indice;
+        IndiceBTreePaginado* arbol = nullptr;           // nullptr en los indices hash
+        std::unique_ptr<OrdenadorEntradasIndice> ordenador;
+        Status estado = Status::OK;
+        uint64_t valores_invalidos = 0;
+    };
+
+    uint32_t hilos = opciones.hilos ? opciones.hilos : std::max(1u, std::thread::hardware_concurrency());
+    std::string directorio_temporal = opciones.directorio_temporal.empty()
+        ? std::filesystem::temp_directory_path().string() : opciones.directorio_temporal;
+
+    std::vector<ConstruccionColumna> construcciones;
+    for (size_t i = 0; i < columnas.size(); ++i) {
+        if (ExisteIndice(nombre_tabla, columnas[i])) {
+            std::cout << "⚠️  Indice ya existe para " << nombre_tabla << "." << columnas[i] << std::endl;
+            continue;
+        }
+        ConstruccionColumna construccion;
+        construccion.nombre = columnas[i];
+        construccion.posicion = i;
+        construccion.tipo = SeleccionarTipoIndiceAutomatico(nombre_tabla, columnas[i]);
+        construcciones.push_back(std::move(construccion));
+    }
+    if (construcciones.empty()) {
+        return Status::DUPLICATE_KEY;
+    }
+
+    // Memoria e hilos de ordenacion se reparten entre las columnas, que se ordenan a la vez
+    size_t memoria_por_columna = opciones.memoria_maxima_bytes / construcciones.size();
+    uint32_t hilos_por_columna = std::max<uint32_t>(1, hilos / static_cast<uint32_t>(construcciones.size()));
+    for (auto& construccion : construcciones) {
+        std::unique_ptr<IndiceBTreePaginado> arbol;
+        switch (construccion.tipo) {
+            case TipoIndice::BTREE_ENTERO:
+                arbol = std::make_unique<IndiceBTreeEntero>(*gestor_buffer_);
+                break;
+            case TipoIndice::BTREE_CADENA:
+                arbol = std::make_unique<IndiceBTreeCadena>(*gestor_buffer_);
+                break;
+            default:
+                construccion.indice = std::make_unique<IndiceHashCadena>();
+                break;
+        }
+        if (arbol) {
+            construccion.arbol = arbol.get();
+            construccion.ordenador = std::make_unique<OrdenadorEntradasIndice>(
+                arbol->ObtenerLongitudClave(), memoria_por_columna, directorio_temporal, hilos_por_columna);
+            construccion.indice = std::move(arbol);
+        }
+    }
+
+    std::cout << "🚀 Construccion masiva de " << construcciones.size() << " indices sobre " << nombre_tabla << std::endl;
+
+    // Fase 1: un unico recorrido de la tabla alimenta todas las columnas
+    RecordId id_registro;
+    std::vector<std::string> valores;
+    Byte clave[ArbolBMasPaginado::LONGITUD_MAXIMA_CLAVE];
+    uint64_t filas = 0;
+    while (siguiente_fila(id_registro, valores)) {
+        filas++;
+        for (auto& construccion : construcciones) {
+            if (construccion.estado != Status::OK || construccion.posicion >= valores.size()) {
+                continue;
+            }
+            const std::string& valor = valores[construccion.posicion];
+            int64_t valor_entero = 0;
+            if (construccion.tipo == TipoIndice::BTREE_ENTERO) {
+                // Mismo rango que la columna INT (int64): ningún valor válido queda fuera del índice
+                char* fin = nullptr;
+                errno = 0;
+                long long convertido = std::strtoll(valor.c_str(), &fin, 10);
+                if (valor.empty() || *fin != '\0' || errno == ERANGE) {
+                    construccion.valores_invalidos++;
+                    continue;
+                }
+                valor_entero = static_cast<int64_t>(convertido);
+            }
+            if (construccion.arbol) {
+                construccion.arbol->CodificarClave(valor, valor_entero, clave);
+                construccion.estado = construccion.ordenador->Añadir(clave, id_registro);
+            } else {
+                construccion.indice->Insertar(valor, valor_entero, id_registro);
+            }
+        }
+    }
+
+    // Fase 2: cada arbol se ordena y se empaqueta en su propio hilo
+    std::vector<std::thread> constructores;
+    for (auto& construccion : construcciones) {
+        if (!construccion.arbol || construccion.estado != Status::OK) {
+            continue;
+        }
+        constructores.emplace_back([&construccion, &opciones]() {
+            construccion.estado = construccion.ordenador->Finalizar();
+            if (construccion.estado == Status::OK) {
+                construccion.estado = construccion.arbol->ConstruirMasivo(*construccion.ordenador, opciones.factor_llenado);
+            }
+            construccion.ordenador.reset(); // Libera la memoria y borra los runs
+        });
+    }
+    for (auto& constructor : constructores) {
+        constructor.join();
+    }
+
+    // Registro de los indices construidos
+    int exitosos = 0;
+    for (auto& construccion : construcciones) {
+        if (construccion.valores_invalidos > 0) {
+            std::cout << "⚠️  " << construccion.nombre << ": " << construccion.valores_invalidos
+                      << " valores no enteros omitidos" << std::endl;
+        }
+        if (construccion.estado != Status::OK) {
+            std::cout << "❌ " << construccion.nombre << ": " << StatusToString(construccion.estado) << std::endl;
+            continue;
+        }
+        auto info = std::make_unique<InformacionIndice>(nombre_tabla, construccion.nombre, construccion.tipo);
+        info->indice = std::move(construccion.indice);
+        info->timestamp_creacion = ObtenerTimestampActual();
+        info->timestamp_modificacion = info->timestamp_creacion;
+        std::cout << "✅ " << construccion.nombre << ": " << info->indice->ObtenerNumeroEntradas()
+                  << " entradas, altura " << info->indice->ObtenerAltura() << std::endl;
+        indices_[nombre_tabla][construccion.nombre] = std::move(info);
+
+        estadisticas_.indices_creados++;
+        switch (construccion.tipo) {
+            case TipoIndice::BTREE_ENTERO: estadisticas_.indices_btree_entero++; break;
+            case TipoIndice::BTREE_CADENA: estadisticas_.indices_btree_cadena++; break;
+            default: estadisticas_.indices_hash_cadena++; break;
+        }
+        if (persistencia_automatica_) {
+            PersistirIndice(nombre_tabla, construccion.nombre);
+        }
+        exitosos++;
+    }
+
+    std::cout << "📊 Filas recorridas: " << filas << ", indices creados: " << exitosos
+              << "/" << construcciones.size() << std::endl;
+    return (exitosos > 0) ? Status::OK : Status::OPERATION_FAILED;
+}
+
+// Ruta del archivo de un indice: <directorio>/<tabla>.<columna>.idx
+std::string GestorIndices::GenerarRutaArchivo(const std::string& tabla, const std::string& columna) const {
+    return (std::filesystem::path(directorio_indices_) / (tabla + "." + columna + ".idx")).string();
+}
+
+// Indice listo para consultar; los registrados al arrancar se cargan aqui la primera vez
+IndiceBase* GestorIndices::ObtenerIndiceDisponible(const std::string& nombre_tabla,
+                                                   const std::string& nombre_columna) const {
+    auto tabla = indices_.find(nombre_tabla);
+    if (tabla == indices_.end()) {
+        return nullptr;
+    }
+    auto columna = tabla->second.find(nombre_columna);
+    if (columna == tabla->second.end() || !columna->second->indice) {
+        return nullptr;
+    }
+    InformacionIndice& info = *columna->second;
+    std::lock_guard<std::mutex> lock(mutex_carga_);
+    if (!info.esta_activo) {
+        return nullptr;
+    }
+    if (info.pendiente_carga) {
+        info.pendiente_carga = false;
+        Status estado = info.indice->Cargar(info.ruta_archivo);
+        if (estado != Status::OK) {
+            std::cout << "❌ No se pudo cargar el indice " << nombre_tabla << "." << nombre_columna
+                      << ": " << StatusToString(estado) << std::endl;
+            info.esta_activo = false;
+            return nullptr;
+        }
+        std::cout << "💾 Indice " << nombre_tabla << "." << nombre_columna << " cargado ("
+                  << info.indice->ObtenerNumeroEntradas() << " entradas)" << std::endl;
+    }
+    return info.indice.get();
+}
+
+// Mantenimiento de un indice tras insertar un registro; carga antes el indice si estaba
+// pendiente, para no insertar en un indice vacio que luego pisaria su archivo
+Status GestorIndices::InsertarEnIndice(const std::string& nombre_tabla, const std::string& nombre_columna,
+                                       const std::string& valor_cadena, int64_t valor_entero, RecordId id_registro) {
+    IndiceBase* indice = ObtenerIndiceDisponible(nombre_tabla, nombre_columna);
+    if (!indice) {
+        return Status::NOT_FOUND;
+    }
+    Status estado = indice->Insertar(valor_cadena, valor_entero, id_registro);
+    if (estado == Status::OK) {
+        indices_[nombre_tabla][nombre_columna]->timestamp_modificacion = ObtenerTimestampActual();
+        estadisticas_.inserciones_realizadas++;
+    }
+    return estado;
+}
+
+// Mantenimiento de un indice tras eliminar un registro o cambiar su clave
+Status GestorIndices::EliminarDeIndice(const std::string& nombre_tabla, const std::string& nombre_columna,
+                                       const std::string& valor_cadena, int64_t valor_entero, RecordId id_registro) {
+    IndiceBase* indice = ObtenerIndiceDisponible(nombre_tabla, nombre_columna);
+    if (!indice) {
+        return Status::NOT_FOUND;
+    }
+    Status estado = indice->Eliminar(valor_cadena, valor_entero, id_registro);
+    if (estado == Status::OK) {
+        indices_[nombre_tabla][nombre_columna]->timestamp_modificacion = ObtenerTimestampActual();
+        estadisticas_.eliminaciones_realizadas++;
+    }
+    return estado;
+}
+
+// Busqueda por igualdad; la latencia se registra por tabla
+std::optional<std::set<RecordId>> GestorIndices::BuscarEnIndice(const std::string& nombre_tabla,
+                                                                const std::string& nombre_columna,
+                                                                const std::string& valor_cadena,
+                                                                int64_t valor_entero) const {
+    MedidorLatencia medidor(OperacionMetrica::BUSQUEDA_INDICE, PageType::INDEX, &nombre_tabla);
+    IndiceBase* indice = ObtenerIndiceDisponible(nombre_tabla, nombre_columna);
+    if (!indice) {
+        medidor.Cancelar();
+        return std::nullopt;
+    }
+    if (medidor.Activo()) {
+        medidor.EstablecerDetalle(nombre_columna);
+    }
+    return indice->Buscar(valor_cadena, valor_entero);
+}
+
+// Recorrido por rango sobre un indice B+ Tree
+Status GestorIndices::AbrirRangoEnIndice(const std::string& nombre_tabla, const std::string& nombre_columna,
+                                         const LimiteRangoIndice& inferior, const LimiteRangoIndice& superior,
+                                         IteradorRangoArbol& iterador) const {
+    iterador.Cerrar();
+    IndiceBase* indice = ObtenerIndiceDisponible(nombre_tabla, nombre_columna);
+    if (!indice) {
+        return Status::NOT_FOUND;
+    }
+    const auto* arbol = dynamic_cast<const IndiceBTreePaginado*>(indice);
+    if (!arbol) {
+        return Status::INVALID_ARGUMENT; // Los indices hash no guardan orden
+    }
+    return arbol->AbrirRango(inferior, superior, iterador);
+}
+
+// Recorrido por prefijo sobre un indice B+ Tree de cadena
+Status GestorIndices::AbrirPrefijoEnIndice(const std::string& nombre_tabla, const std::string& nombre_columna,
+                                           const std::string& prefijo, IteradorRangoArbol& iterador) const {
+    iterador.Cerrar();
+    IndiceBase* indice = ObtenerIndiceDisponible(nombre_tabla, nombre_columna);
+    if (!indice) {
+        return Status::NOT_FOUND;
+    }
+    const auto* arbol = dynamic_cast<const IndiceBTreeCadena*>(indice);
+    if (!arbol) {
+        return Status::INVALID_ARGUMENT;
+    }
+    return arbol->AbrirPrefijo(prefijo, iterador);
+}
+
+// Registrar los indices persistidos; cada uno se carga con su primera consulta
 Status GestorIndices::CargarIndicesAutomaticamente() {
-    std::cout << "💾 Cargando indices desde disco..." << std::endl;
-    
-    // TODO: Implementar carga desde archivos de texto
-    // Por ahora, simular carga exitosa
-    
-    std::cout << "✅ Indices cargados automaticamente" << std::endl;
+    std::error_code error;
+    if (!std::filesystem::is_directory(directorio_indices_, error)) {
+        std::cout << "ℹ️  No hay indices persistidos en " << directorio_indices_ << std::endl;
+        return Status::SUCCESS;
+    }
+
+    uint32_t registrados = 0;
+    for (const auto& entrada : std::filesystem::directory_iterator(directorio_indices_, error)) {
+        if (!entrada.is_regular_file(error) || entrada.path().extension() != ".idx") {
+            continue;
+        }
+        // <tabla>.<columna>.idx (ver GenerarRutaArchivo)
+        std::string nombre = entrada.path().stem().string();
+        size_t punto = nombre.find('.');
+        if (punto == std::string::npos || punto == 0 || punto + 1 == nombre.size()) {
+            continue;
+        }
+        std::string nombre_tabla = nombre.substr(0, punto);
+        std::string nombre_columna = nombre.substr(punto + 1);
+        auto tabla = indices_.find(nombre_tabla);
+        if (tabla != indices_.end() && tabla->second.count(nombre_columna)) {
+            continue; // Ya esta en memoria
+        }
+
+        // Solo la primera linea: el tipo decide que objeto se registra
+        std::ifstream archivo(entrada.path());
+        std::string linea;
+        if (!std::getline(archivo, linea) || linea.rfind("TIPO_INDICE:", 0) != 0) {
+            std::cout << "⚠️  Archivo de indice no reconocido: " << entrada.path().string() << std::endl;
+            continue;
+        }
+        std::string nombre_tipo = linea.substr(12);
+        std::unique_ptr<IndiceBase> indice;
+        TipoIndice tipo = TipoIndice::HASH_CADENA;
+        if (nombre_tipo == ::TipoIndiceToString(TipoIndice::HASH_CADENA)) {
+            indice = std::make_unique<IndiceHashCadena>();
+        } else if (gestor_buffer_ && nombre_tipo == ::TipoIndiceToString(TipoIndice::BTREE_ENTERO)) {
+            tipo = TipoIndice::BTREE_ENTERO;
+            indice = std::make_unique<IndiceBTreeEntero>(*gestor_buffer_);
+        } else if (gestor_buffer_ && nombre_tipo == ::TipoIndiceToString(TipoIndice::BTREE_CADENA)) {
+            tipo = TipoIndice::BTREE_CADENA;
+            indice = std::make_unique<IndiceBTreeCadena>(*gestor_buffer_);
+        } else {
+            std::cout << "⚠️  Tipo de indice no soportado en " << entrada.path().string() << std::endl;
+            continue;
+        }
+
+        auto info = std::make_unique<InformacionIndice>(nombre_tabla, nombre_columna, tipo);
+        info->indice = std::move(indice);
+        info->ruta_archivo = entrada.path().string();
+        info->pendiente_carga = true;
+        indices_[nombre_tabla][nombre_columna] = std::move(info);
+        registrados++;
+    }
+
+    std::cout << "✅ " << registrados << " indices registrados (se cargan con la primera consulta)" << std::endl;
     return Status::SUCCESS;
 }
 
@@ -5,11 +5,16 @@
 
 #include "../include/common.h"
 #include "../data_storage/cabeceras_especificas.h"
+#include "arbol_bmas_paginado.h"
+#include "ordenador_entradas_indice.h"
 #include <string>
 #include <unordered_map>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
+#include <deque>
 #include <vector>
 #include <iostream>
 
@@ -50,9 +55,10 @@ public:
     virtual ~IndiceBase() = default;
     
     // Métodos virtuales puros que deben implementar las clases derivadas
-    virtual Status Insertar(const std::string& clave_str, int clave_int, RecordId id_registro) = 0;
-    virtual Status Eliminar(const std::string& clave_str, int clave_int, RecordId id_registro) = 0;
-    virtual std::optional<std::set<RecordId>> Buscar(const std::string& clave_str, int clave_int) const = 0;
+    virtual Status Insertar(const std::string& clave_str, int64_t clave_int, RecordId id_registro) = 0;
+    virtual Status Eliminar(const std::string& clave_str, int64_t clave_int, RecordId id_registro) = 0;
+    // Conjunto vacío si ninguna entrada coincide; std::nullopt solo si el índice no se pudo leer
+    virtual std::optional<std::set<RecordId>> Buscar(const std::string& clave_str, int64_t clave_int) const = 0;
     virtual Status Persistir(const std::string& ruta_archivo) const = 0;
     virtual Status Cargar(const std::string& ruta_archivo) = 0;
     virtual void ImprimirEstructura() const = 0;
@@ -62,163 +68,176 @@ public:
 };
 
 /**
- * Implementación de índice B+ Tree para valores enteros
+ * Límite de un recorrido por rango sobre un índice B+ Tree
+ * Se usa clave_int en los índices enteros y clave_str en los de cadena.
  */
-class IndiceBTreeEntero : public IndiceBase {
-private:
-    static const uint32_t ORDEN_ARBOL = 4;  // Orden del árbol B+
-    
-    struct NodoInterno;
-    struct NodoHoja;
+struct LimiteRangoIndice {
+    bool presente = false;              // false = rango abierto por este lado
+    std::string clave_str;
+    int64_t clave_int = 0;
+    bool inclusivo = true;
+    
+    static LimiteRangoIndice SinLimite() { return LimiteRangoIndice(); }
+    static LimiteRangoIndice Entero(int64_t valor, bool inclusivo) {
+        LimiteRangoIndice limite;
+        limite.presente = true;
+        limite.clave_int = valor;
+        limite.inclusivo = inclusivo;
+        return limite;
+    }
+    static LimiteRangoIndice Cadena(const std::string& valor, bool inclusivo) {
+        LimiteRangoIndice limite;
+        limite.presente = true;
+        limite.clave_str = valor;
+        limite.inclusivo = inclusivo;
+        return limite;
+    }
+};
+
+/**
+ * Base de los índices B+ Tree: los nodos son páginas del GestorBuffer (ver
+ * ArbolBMasPaginado). El árbol se crea con la primera inserción o con
+ * ConstruirMasivo(), y Cargar() lo reabre desde su página meta.
+ * Las derivadas solo deciden cómo se codifica la clave.
+ */
+class IndiceBTreePaginado : public IndiceBase {
+protected:
+    ArbolBMasPaginado arbol_;
     
-    struct NodoBase {
-        bool es_hoja;
-        uint32_t numero_claves;
-        NodoBase* padre;
-        
-        NodoBase(bool hoja) : es_hoja(hoja), numero_claves(0), padre(nullptr) {}
-        virtual ~NodoBase() = default;
-    };
+    IndiceBTreePaginado(GestorBuffer& gestor_buffer, uint32_t longitud_clave)
+        : arbol_(gestor_buffer, longitud_clave) {}
     
-    struct NodoInterno : public NodoBase {
-        int claves[ORDEN_ARBOL - 1];
-        NodoBase* hijos[ORDEN_ARBOL];
-        
-        NodoInterno() : NodoBase(false) {
-            for (uint32_t i = 0; i < ORDEN_ARBOL; ++i) {
-                hijos[i] = nullptr;
-            }
-        }
-    };
+public:
+    ~IndiceBTreePaginado() override = default;
     
-    struct NodoHoja : public NodoBase {
-        EntradaIndice<int> entradas[ORDEN_ARBOL - 1];
-        NodoHoja* siguiente;
-        
-        NodoHoja() : NodoBase(true), siguiente(nullptr) {}
-    };
+    /**
+     * @brief Escribe en destino (ObtenerLongitudClave() bytes) la clave del valor.
+     */
+    virtual void CodificarClave(const std::string& clave_str, int64_t clave_int, Byte* destino) const = 0;
     
-    NodoBase* raiz_;
-    uint32_t altura_;
-    uint32_t numero_entradas_;
+    /**
+     * @brief Construye el índice vacío desde entradas ya codificadas y ordenadas.
+     * @param ordenador Ordenador ya finalizado
+     * @param factor_llenado Fracción de cada nodo que se ocupa
+     */
+    Status ConstruirMasivo(OrdenadorEntradasIndice& ordenador, double factor_llenado);
     
-    // Métodos auxiliares privados
-    NodoHoja* BuscarHoja(int clave) const;
-    Status InsertarEnHoja(NodoHoja* hoja, int clave, RecordId id_registro);
-    Status DividirHoja(NodoHoja* hoja);
-    Status EliminarDeHoja(NodoHoja* hoja, int clave, RecordId id_registro);
-    void LiberarNodo(NodoBase* nodo);
+    uint32_t ObtenerLongitudClave() const { return arbol_.ObtenerLongitudClave(); }
     
-public:
-    IndiceBTreeEntero();
-    ~IndiceBTreeEntero() override;
+    /**
+     * @brief Abre un recorrido ascendente por las entradas entre dos límites.
+     * En los índices de cadena, un límite más largo que la clave se compara por su
+     * prefijo y el rango puede incluir valores de más: el llamador filtra.
+     */
+    Status AbrirRango(const LimiteRangoIndice& inferior, const LimiteRangoIndice& superior,
+                      IteradorRangoArbol& iterador) const;
     
-    Status Insertar(const std::string& clave_str, int clave_int, RecordId id_registro) override;
-    Status Eliminar(const std::string& clave_str, int clave_int, RecordId id_registro) override;
-    std::optional<std::set<RecordId>> Buscar(const std::string& clave_str, int clave_int) const override;
+    Status Insertar(const std::string& clave_str, int64_t clave_int, RecordId id_registro) override;
+    Status Eliminar(const std::string& clave_str, int64_t clave_int, RecordId id_registro) override;
+    std::optional<std::set<RecordId>> Buscar(const std::string& clave_str, int64_t clave_int) const override;
     Status Persistir(const std::string& ruta_archivo) const override;
     Status Cargar(const std::string& ruta_archivo) override;
     void ImprimirEstructura() const override;
+    uint32_t ObtenerNumeroEntradas() const override { return arbol_.ObtenerNumeroEntradas(); }
+    uint32_t ObtenerAltura() const override { return arbol_.ObtenerAltura(); }
+};
+
+/**
+ * Implementación de índice B+ Tree para valores enteros
+ */
+class IndiceBTreeEntero : public IndiceBTreePaginado {
+public:
+    explicit IndiceBTreeEntero(GestorBuffer& gestor_buffer)
+        : IndiceBTreePaginado(gestor_buffer, ArbolBMasPaginado::LONGITUD_CLAVE_ENTERA) {}
+    
+    void CodificarClave(const std::string& clave_str, int64_t clave_int, Byte* destino) const override;
     TipoIndice ObtenerTipo() const override { return TipoIndice::BTREE_ENTERO; }
-    uint32_t ObtenerNumeroEntradas() const override { return numero_entradas_; }
-    uint32_t ObtenerAltura() const override { return altura_; }
 };
 
 /**
  * Implementación de índice B+ Tree para valores de cadena
+ * Indexa los primeros longitud_clave bytes de cada cadena: si dos valores comparten
+ * ese prefijo, Buscar() devuelve los RecordId de ambos y el llamador debe comprobar
+ * el valor completo en el registro.
  */
-class IndiceBTreeCadena : public IndiceBase {
-private:
-    static const uint32_t ORDEN_ARBOL = 4;
-    
-    struct NodoInterno;
-    struct NodoHoja;
-    
-    struct NodoBase {
-        bool es_hoja;
-        uint32_t numero_claves;
-        NodoBase* padre;
-        
-        NodoBase(bool hoja) : es_hoja(hoja), numero_claves(0), padre(nullptr) {}
-        virtual ~NodoBase() = default;
-    };
-    
-    struct NodoInterno : public NodoBase {
-        std::string claves[ORDEN_ARBOL - 1];
-        NodoBase* hijos[ORDEN_ARBOL];
-        
-        NodoInterno() : NodoBase(false) {
-            for (uint32_t i = 0; i < ORDEN_ARBOL; ++i) {
-                hijos[i] = nullptr;
-            }
-        }
-    };
-    
-    struct NodoHoja : public NodoBase {
-        EntradaIndice<std::string> entradas[ORDEN_ARBOL - 1];
-        NodoHoja* siguiente;
-        
-        NodoHoja() : NodoBase(true), siguiente(nullptr) {}
-    };
-    
-    NodoBase* raiz_;
-    uint32_t altura_;
-    uint32_t numero_entradas_;
-    
-    // Métodos auxiliares privados
-    NodoHoja* BuscarHoja(const std::string& clave) const;
-    Status InsertarEnHoja(NodoHoja* hoja, const std::string& clave, RecordId id_registro);
-    Status DividirHoja(NodoHoja* hoja);
-    Status EliminarDeHoja(NodoHoja* hoja, const std::string& clave, RecordId id_registro);
-    void LiberarNodo(NodoBase* nodo);
-    
+class IndiceBTreeCadena : public IndiceBTreePaginado {
 public:
-    IndiceBTreeCadena();
-    ~IndiceBTreeCadena() override;
+    explicit IndiceBTreeCadena(GestorBuffer& gestor_buffer,
+                               uint32_t longitud_clave = ArbolBMasPaginado::LONGITUD_MAXIMA_CLAVE)
+        : IndiceBTreePaginado(gestor_buffer, longitud_clave) {}
     
-    Status Insertar(const std::string& clave_str, int clave_int, RecordId id_registro) override;
-    Status Eliminar(const std::string& clave_str, int clave_int, RecordId id_registro) override;
-    std::optional<std::set<RecordId>> Buscar(const std::string& clave_str, int clave_int) const override;
-    Status Persistir(const std::string& ruta_archivo) const override;
-    Status Cargar(const std::string& ruta_archivo) override;
-    void ImprimirEstructura() const override;
+    void CodificarClave(const std::string& clave_str, int64_t clave_int, Byte* destino) const override;
     TipoIndice ObtenerTipo() const override { return TipoIndice::BTREE_CADENA; }
-    uint32_t ObtenerNumeroEntradas() const override { return numero_entradas_; }
-    uint32_t ObtenerAltura() const override { return altura_; }
+    
+    /**
+     * @brief Abre un recorrido por los valores que empiezan por prefijo (LIKE 'prefijo%').
+     */
+    Status AbrirPrefijo(const std::string& prefijo, IteradorRangoArbol& iterador) const;
 };
 
 /**
  * Implementación de índice Hash para valores de cadena
+ *
+ * Direccionamiento abierto: cada slot guarda un byte de control con 7 bits del hash
+ * (etiqueta), o VACIO/BORRADO, y la posición de su entrada en entradas_. Los slots
+ * se prueban en grupos de 16 bytes de control, comparados de una vez con SSE2 cuando
+ * está disponible: casi todos los candidatos se descartan por la etiqueta sin tocar
+ * la entrada.
+ *
+ * Al superar FACTOR_CARGA_MAXIMO se reserva la tabla nueva (solo control y
+ * posiciones, 5 bytes por slot) y los slots se migran poco a poco
+ * (SLOTS_MIGRADOS_POR_OPERACION por inserción o eliminación); mientras tanto las
+ * búsquedas consultan las dos tablas. Las entradas no se mueven nunca: ninguna
+ * operación paga la redimensión completa.
  */
 class IndiceHashCadena : public IndiceBase {
 private:
     static const uint32_t TAMAÑO_TABLA_HASH = 1024;  // Tamaño inicial de la tabla hash
     static constexpr double FACTOR_CARGA_MAXIMO = 0.75;   // Factor de carga máximo antes de redimensionar
+    static const uint32_t TAMAÑO_GRUPO = 16;
+    static const uint32_t SLOTS_MIGRADOS_POR_OPERACION = 64;
+    
+    struct EntradaHash {
+        uint32_t hash;
+        RecordId id_registro;
+        std::string clave;
+    };
     
-    struct Bucket {
-        std::vector<EntradaIndice<std::string>> entradas;
+    struct TablaHash {
+        std::vector<uint8_t> control;       // Etiqueta (0..0x7F), VACIO o BORRADO
+        std::vector<uint32_t> posiciones;   // Índice en entradas_ de cada slot ocupado
+        uint32_t ocupados = 0;
+        uint32_t borrados = 0;
         
-        void AgregarEntrada(const std::string& clave, RecordId id_registro);
-        bool EliminarEntrada(const std::string& clave, RecordId id_registro);
-        std::optional<std::set<RecordId>> BuscarEntrada(const std::string& clave) const;
+        void Reservar(uint32_t capacidad);
+        void Liberar();
+        uint32_t Capacidad() const { return static_cast<uint32_t>(control.size()); }
     };
     
-    std::vector<Bucket> tabla_hash_;
+    std::deque<EntradaHash> entradas_;  // Por bloques: crecer no mueve las entradas existentes
+    std::vector<uint32_t> entradas_libres_;
+    TablaHash tabla_;                   // Recibe todas las inserciones
+    TablaHash tabla_anterior_;          // Solo durante una migración
+    uint32_t posicion_migracion_;
     uint32_t numero_entradas_;
-    uint32_t numero_buckets_;
     
     // Métodos auxiliares privados
     uint32_t FuncionHash(const std::string& clave) const;
-    Status Redimensionar();
-    void RehashearEntradas(const std::vector<Bucket>& tabla_anterior);
+    bool BuscarSlot(const TablaHash& tabla, uint32_t hash, const std::string& clave,
+                    RecordId id_registro, uint32_t& slot) const;
+    void RecogerCoincidencias(const TablaHash& tabla, uint32_t hash, const std::string& clave,
+                              std::set<RecordId>& ids) const;
+    void Colocar(TablaHash& tabla, uint32_t hash, uint32_t posicion_entrada);
+    void IniciarRedimension();
+    void AvanzarMigracion(uint32_t slots);
     
 public:
     IndiceHashCadena();
     ~IndiceHashCadena() override = default;
     
-    Status Insertar(const std::string& clave_str, int clave_int, RecordId id_registro) override;
-    Status Eliminar(const std::string& clave_str, int clave_int, RecordId id_registro) override;
-    std::optional<std::set<RecordId>> Buscar(const std::string& clave_str, int clave_int) const override;
+    Status Insertar(const std::string& clave_str, int64_t clave_int, RecordId id_registro) override;
+    Status Eliminar(const std::string& clave_str, int64_t clave_int, RecordId id_registro) override;
+    std::optional<std::set<RecordId>> Buscar(const std::string& clave_str, int64_t clave_int) const override;
     Status Persistir(const std::string& ruta_archivo) const override;
     Status Cargar(const std::string& ruta_archivo) override;
     void ImprimirEstructura() const override;
@@ -228,7 +247,8 @@ public:
     
     // Métodos específicos del índice hash
     double ObtenerFactorCarga() const;
-    uint32_t ObtenerNumeroBuckets() const { return numero_buckets_; }
+    uint32_t ObtenerNumeroBuckets() const { return tabla_.Capacidad(); }
+    bool EstaMigrando() const { return tabla_anterior_.Capacidad() > 0; }
 };
 
 /**
@@ -242,10 +262,12 @@ struct InformacionIndice {
     uint64_t timestamp_creacion;       // Timestamp de creación
     uint64_t timestamp_modificacion;   // Timestamp de última modificación
     bool esta_activo;                  // Si el índice está activo
+    std::string ruta_archivo;          // Archivo del que se carga el índice registrado al arrancar
+    bool pendiente_carga;              // Registrado pero aún sin cargar (ver CargarIndicesAutomaticamente)
     
     InformacionIndice(const std::string& tabla, const std::string& columna, TipoIndice t)
         : nombre_tabla(tabla), nombre_columna(columna), tipo(t), 
-          timestamp_creacion(0), timestamp_modificacion(0), esta_activo(true) {}
+          timestamp_creacion(0), timestamp_modificacion(0), esta_activo(true), pendiente_carga(false) {}
 };
 
 /**
@@ -265,6 +287,22 @@ struct EstadisticasIndices {
     uint64_t tiempo_total_eliminaciones_ms = 0;
 };
 
+/**
+ * Parámetros de GestorIndices::ConstruirIndicesMasivos
+ */
+struct OpcionesConstruccionMasiva {
+    double factor_llenado = 0.9;                  // Ocupación de cada nodo B+ al empaquetar
+    size_t memoria_maxima_bytes = 64u << 20;      // Memoria de ordenación, repartida entre columnas
+    uint32_t hilos = 0;                           // 0 = std::thread::hardware_concurrency()
+    std::string directorio_temporal;              // Vacío = directorio temporal del sistema
+};
+
+/**
+ * Productor de filas para la construcción masiva: escribe el RecordId de la fila y
+ * el valor (como texto) de cada columna pedida, en el mismo orden. Devuelve false al terminar.
+ */
+using FuenteFilasIndice = std::function<bool(RecordId& id_registro, std::vector<std::string>& valores)>;
+
 /**
  * Clase principal del Gestor de Índices
  * Maneja la creación, mantenimiento y consulta de índices para el SGBD
@@ -286,6 +324,7 @@ private:
     std::string directorio_indices_;    // Directorio donde se almacenan los índices
     bool persistencia_automatica_;     // Si se debe persistir automáticamente
     uint32_t max_indices_por_tabla_;   // Máximo número de índices por tabla
+    mutable std::mutex mutex_carga_;   // Serializa la carga diferida de los índices registrados
     
     // Métodos auxiliares privados
     std::string GenerarClaveIndice(const std::string& tabla, const std::string& columna) const;
@@ -295,6 +334,13 @@ private:
     Status CrearDirectorioIndices() const;
     uint64_t ObtenerTimestampActual() const;
     
+    /**
+     * @brief Índice activo de una columna, listo para consultar: si solo estaba
+     *        registrado se carga ahora desde su archivo (una vez).
+     * @return nullptr si no existe, está inactivo o su carga falla (queda inactivo)
+     */
+    IndiceBase* ObtenerIndiceDisponible(const std::string& nombre_tabla, const std::string& nombre_columna) const;
+    
     // Métodos para selección automática de índices según estrategia del usuario
     TipoIndice SeleccionarTipoIndiceAutomatico(const std::string& nombre_tabla, 
                                                const std::string& nombre_columna) const;
@@ -326,7 +372,28 @@ public:
     Status CrearIndicesAutomaticosPorTabla(const std::string& nombre_tabla, 
                                             const std::vector<std::string>& columnas);
     
-    // Método para cargar automáticamente todos los índices persistidos al iniciar
+    /**
+     * @brief Crea los índices de varias columnas con un solo recorrido de la tabla.
+     *
+     * Los pares (clave, RecordId) de cada columna B+ Tree se ordenan (en paralelo y
+     * volcando a disco si superan la memoria) y el árbol se empaqueta de abajo arriba;
+     * cada columna se ordena y empaqueta en su propio hilo. Los índices hash se
+     * rellenan durante el recorrido. Las columnas que ya tienen índice se omiten.
+     *
+     * @param siguiente_fila Recorrido de la tabla (ver GestorRegistros::ConstruirIndicesTabla)
+     * @return OK si se creó algún índice; OPERATION_FAILED si fallaron todos
+     */
+    Status ConstruirIndicesMasivos(const std::string& nombre_tabla, const std::vector<std::string>& columnas,
+                                   const FuenteFilasIndice& siguiente_fila,
+                                   const OpcionesConstruccionMasiva& opciones = OpcionesConstruccionMasiva());
+    
+    /**
+     * @brief Registra los índices persistidos en directorio_indices_ sin cargarlos.
+     *
+     * De cada archivo <tabla>.<columna>.idx solo se lee la línea TIPO_INDICE; el
+     * índice se carga con la primera búsqueda o recorrido que lo usa, así que el
+     * arranque no depende del tamaño de los índices.
+     */
     Status CargarIndicesAutomaticamente();
     
     Status EliminarIndice(const std::string& nombre_tabla, const std::string& nombre_columna);
@@ -335,13 +402,29 @@ public:
     
     // Métodos de operaciones sobre índices
     Status InsertarEnIndice(const std::string& nombre_tabla, const std::string& nombre_columna,
-                           const std::string& valor_cadena, int valor_entero, RecordId id_registro);
+                           const std::string& valor_cadena, int64_t valor_entero, RecordId id_registro);
     Status EliminarDeIndice(const std::string& nombre_tabla, const std::string& nombre_columna,
-                           const std::string& valor_cadena, int valor_entero, RecordId id_registro);
+                           const std::string& valor_cadena, int64_t valor_entero, RecordId id_registro);
+    // std::nullopt si la columna no tiene índice utilizable; un conjunto vacío es "ninguna fila"
     std::optional<std::set<RecordId>> BuscarEnIndice(const std::string& nombre_tabla, 
                                                     const std::string& nombre_columna,
                                                     const std::string& valor_cadena, 
-                                                    int valor_entero) const;
+                                                    int64_t valor_entero) const;
+    
+    /**
+     * @brief Abre un recorrido por rango sobre el índice B+ Tree de una columna.
+     * @return NOT_FOUND si no hay índice; INVALID_ARGUMENT si es hash (no guarda orden)
+     */
+    Status AbrirRangoEnIndice(const std::string& nombre_tabla, const std::string& nombre_columna,
+                              const LimiteRangoIndice& inferior, const LimiteRangoIndice& superior,
+                              IteradorRangoArbol& iterador) const;
+    
+    /**
+     * @brief Abre un recorrido por prefijo sobre el índice B+ Tree de cadena de una columna.
+     * @return NOT_FOUND si no hay índice; INVALID_ARGUMENT si no es BTREE_CADENA
+     */
+    Status AbrirPrefijoEnIndice(const std::string& nombre_tabla, const std::string& nombre_columna,
+                                const std::string& prefijo, IteradorRangoArbol& iterador) const;
     
     // Métodos de consulta y información
     bool ExisteIndice(const std::string& nombre_tabla, const std::string& nombre_columna) const;
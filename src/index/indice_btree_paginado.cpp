@@ -0,0 +1,152 @@
+// index/indice_btree_paginado.cpp - Adaptadores de IndiceBase sobre ArbolBMasPaginado
+#include "gestor_indices.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+// === PERSISTENCIA COMÚN DE LOS ÁRBOLES B+ ===
+// El archivo del índice solo guarda la página meta: los nodos ya están en disco,
+// así que cargar un índice no recorre ni reconstruye nada.
+
+namespace {
+
+Status EscribirDescriptorArbol(const std::string& ruta_archivo, const char* tipo,
+                               const ArbolBMasPaginado& arbol) {
+    std::ofstream archivo(ruta_archivo);
+    if (!archivo.is_open()) {
+        return Status::ERROR;
+    }
+    archivo << "TIPO_INDICE:" << tipo << "\n";
+    archivo << "ID_META:" << arbol.ObtenerIdMeta() << "\n";
+    archivo << "LONGITUD_CLAVE:" << arbol.ObtenerLongitudClave() << "\n";
+    archivo << "NUMERO_ENTRADAS:" << arbol.ObtenerNumeroEntradas() << "\n";
+    archivo << "ALTURA:" << arbol.ObtenerAltura() << "\n";
+    return archivo.good() ? Status::OK : Status::IO_ERROR;
+}
+
+Status AbrirDesdeDescriptor(const std::string& ruta_archivo, const char* tipo, ArbolBMasPaginado& arbol) {
+    std::ifstream archivo(ruta_archivo);
+    if (!archivo.is_open()) {
+        return Status::ERROR;
+    }
+    std::string linea;
+    std::string tipo_leido;
+    BlockId id_meta = INVALID_PAGE_ID;
+    while (std::getline(archivo, linea)) {
+        if (linea.rfind("TIPO_INDICE:", 0) == 0) {
+            tipo_leido = linea.substr(12);
+        } else if (linea.rfind("ID_META:", 0) == 0) {
+            id_meta = static_cast<BlockId>(std::stoul(linea.substr(8)));
+        }
+    }
+    if (tipo_leido != tipo) {
+        return Status::INVALID_FORMAT;
+    }
+    if (id_meta == INVALID_PAGE_ID) {
+        return Status::OK; // Índice sin entradas: el árbol se creará con la primera inserción
+    }
+    return arbol.Abrir(id_meta);
+}
+
+} // namespace
+
+// === IMPLEMENTACIÓN DE INDICEBTREEPAGINADO ===
+
+Status IndiceBTreePaginado::Insertar(const std::string& clave_str, int64_t clave_int, RecordId id_registro) {
+    if (!arbol_.EstaAbierto()) {
+        Status status = arbol_.Crear();
+        if (status != Status::OK) {
+            return status;
+        }
+    }
+    Byte clave[ArbolBMasPaginado::LONGITUD_MAXIMA_CLAVE];
+    CodificarClave(clave_str, clave_int, clave);
+    return arbol_.Insertar(clave, id_registro);
+}
+
+Status IndiceBTreePaginado::Eliminar(const std::string& clave_str, int64_t clave_int, RecordId id_registro) {
+    if (!arbol_.EstaAbierto()) {
+        return Status::NOT_FOUND;
+    }
+    Byte clave[ArbolBMasPaginado::LONGITUD_MAXIMA_CLAVE];
+    CodificarClave(clave_str, clave_int, clave);
+    return arbol_.Eliminar(clave, id_registro);
+}
+
+std::optional<std::set<RecordId>> IndiceBTreePaginado::Buscar(const std::string& clave_str, int64_t clave_int) const {
+    if (!arbol_.EstaAbierto()) {
+        return std::set<RecordId>(); // Índice vacío: ninguna coincidencia
+    }
+    Byte clave[ArbolBMasPaginado::LONGITUD_MAXIMA_CLAVE];
+    CodificarClave(clave_str, clave_int, clave);
+    std::vector<RecordId> ids;
+    Status estado = arbol_.Buscar(clave, ids);
+    if (estado == Status::NOT_FOUND) {
+        return std::set<RecordId>();
+    }
+    if (estado != Status::OK) {
+        return std::nullopt;
+    }
+    // Las hojas ya devuelven los RecordId ordenados
+    return std::set<RecordId>(ids.begin(), ids.end());
+}
+
+Status IndiceBTreePaginado::ConstruirMasivo(OrdenadorEntradasIndice& ordenador, double factor_llenado) {
+    return arbol_.ConstruirMasivo(
+        [&ordenador](Byte* clave, RecordId& id_registro) { return ordenador.Siguiente(clave, id_registro); },
+        factor_llenado);
+}
+
+Status IndiceBTreePaginado::AbrirRango(const LimiteRangoIndice& inferior, const LimiteRangoIndice& superior,
+                                       IteradorRangoArbol& iterador) const {
+    if (!arbol_.EstaAbierto()) {
+        iterador.Cerrar();
+        return Status::OK; // Índice vacío: rango vacío
+    }
+    // Un límite de cadena truncado a la clave no es exacto: se relaja a inclusivo
+    auto inclusivo = [this](const LimiteRangoIndice& limite) {
+        return limite.inclusivo ||
+               (ObtenerTipo() == TipoIndice::BTREE_CADENA && limite.clave_str.size() > arbol_.ObtenerLongitudClave());
+    };
+    Byte clave_inferior[ArbolBMasPaginado::LONGITUD_MAXIMA_CLAVE];
+    Byte clave_superior[ArbolBMasPaginado::LONGITUD_MAXIMA_CLAVE];
+    if (inferior.presente) {
+        CodificarClave(inferior.clave_str, inferior.clave_int, clave_inferior);
+    }
+    if (superior.presente) {
+        CodificarClave(superior.clave_str, superior.clave_int, clave_superior);
+    }
+    return arbol_.AbrirRango(inferior.presente ? clave_inferior : nullptr, inclusivo(inferior),
+                             superior.presente ? clave_superior : nullptr, arbol_.ObtenerLongitudClave(),
+                             inclusivo(superior), iterador);
+}
+
+Status IndiceBTreePaginado::Persistir(const std::string& ruta_archivo) const {
+    return EscribirDescriptorArbol(ruta_archivo, TipoIndiceToString(ObtenerTipo()).c_str(), arbol_);
+}
+
+Status IndiceBTreePaginado::Cargar(const std::string& ruta_archivo) {
+    return AbrirDesdeDescriptor(ruta_archivo, TipoIndiceToString(ObtenerTipo()).c_str(), arbol_);
+}
+
+void IndiceBTreePaginado::ImprimirEstructura() const {
+    std::cout << "\n=== ESTRUCTURA DEL ÍNDICE " << TipoIndiceToString(ObtenerTipo()) << " ===" << std::endl;
+    arbol_.ImprimirEstructura();
+}
+
+void IndiceBTreeEntero::CodificarClave(const std::string& /*clave_str*/, int64_t clave_int, Byte* destino) const {
+    ArbolBMasPaginado::CodificarEntero(clave_int, destino);
+}
+
+void IndiceBTreeCadena::CodificarClave(const std::string& clave_str, int64_t /*clave_int*/, Byte* destino) const {
+    ArbolBMasPaginado::CodificarCadena(clave_str, destino, arbol_.ObtenerLongitudClave());
+}
+
+Status IndiceBTreeCadena::AbrirPrefijo(const std::string& prefijo, IteradorRangoArbol& iterador) const {
+    if (!arbol_.EstaAbierto()) {
+        iterador.Cerrar();
+        return Status::OK;
+    }
+    uint32_t longitud = static_cast<uint32_t>(std::min<size_t>(prefijo.size(), arbol_.ObtenerLongitudClave()));
+    return arbol_.AbrirPrefijo(prefijo.data(), longitud, iterador);
+}
@@ -0,0 +1,323 @@
+// index/indice_hash_cadena.cpp - Índice hash de cadenas con direccionamiento abierto
+#include "gestor_indices.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr uint8_t CONTROL_VACIO = 0x80;
+constexpr uint8_t CONTROL_BORRADO = 0xFE;
+
+// Los slots ocupados guardan los 7 bits altos del hash; VACIO y BORRADO tienen el bit alto a 1
+inline uint8_t Etiqueta(uint32_t hash) { return static_cast<uint8_t>(hash >> 25); }
+
+// Máscaras de 16 bits sobre un grupo de bytes de control
+#if defined(__SSE2__)
+inline uint32_t MascaraIguales(const uint8_t* grupo, uint8_t valor) {
+    __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(grupo));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(static_cast<char>(valor)))));
+}
+inline uint32_t MascaraLibres(const uint8_t* grupo) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(grupo))));
+}
+#else
+inline uint32_t MascaraIguales(const uint8_t* grupo, uint8_t valor) {
+    uint32_t mascara = 0;
+    for (uint32_t i = 0; i < 16; ++i) {
+        mascara |= static_cast<uint32_t>(grupo[i] == valor) << i;
+    }
+    return mascara;
+}
+inline uint32_t MascaraLibres(const uint8_t* grupo) {
+    uint32_t mascara = 0;
+    for (uint32_t i = 0; i < 16; ++i) {
+        mascara |= static_cast<uint32_t>(grupo[i] >> 7) << i;
+    }
+    return mascara;
+}
+#endif
+
+inline uint32_t PrimerBit(uint32_t mascara) { return static_cast<uint32_t>(__builtin_ctz(mascara)); }
+
+} // namespace
+
+// === TABLA ===
+
+void IndiceHashCadena::TablaHash::Reservar(uint32_t capacidad) {
+    control.assign(capacidad, CONTROL_VACIO);
+    posiciones.assign(capacidad, 0);
+    ocupados = 0;
+    borrados = 0;
+}
+
+void IndiceHashCadena::TablaHash::Liberar() {
+    std::vector<uint8_t>().swap(control);
+    std::vector<uint32_t>().swap(posiciones);
+    ocupados = 0;
+    borrados = 0;
+}
+
+// === IMPLEMENTACIÓN DE INDICEHASHCADENA ===
+
+IndiceHashCadena::IndiceHashCadena() : posicion_migracion_(0), numero_entradas_(0) {
+    tabla_.Reservar(TAMAÑO_TABLA_HASH);
+}
+
+Status IndiceHashCadena::Insertar(const std::string& clave_str, int64_t /*clave_int*/, RecordId id_registro) {
+    uint32_t hash = FuncionHash(clave_str);
+    uint32_t slot;
+    if (BuscarSlot(tabla_, hash, clave_str, id_registro, slot) ||
+        (EstaMigrando() && BuscarSlot(tabla_anterior_, hash, clave_str, id_registro, slot))) {
+        return Status::DUPLICATE_ENTRY;
+    }
+
+    if (tabla_.ocupados + tabla_.borrados + 1 > tabla_.Capacidad() * FACTOR_CARGA_MAXIMO) {
+        if (EstaMigrando()) {
+            AvanzarMigracion(tabla_anterior_.Capacidad()); // No debería ocurrir: terminar la anterior
+        }
+        IniciarRedimension();
+    }
+    uint32_t posicion_entrada;
+    if (!entradas_libres_.empty()) {
+        posicion_entrada = entradas_libres_.back();
+        entradas_libres_.pop_back();
+        entradas_[posicion_entrada] = EntradaHash{hash, id_registro, clave_str};
+    } else {
+        posicion_entrada = static_cast<uint32_t>(entradas_.size());
+        entradas_.push_back(EntradaHash{hash, id_registro, clave_str});
+    }
+    Colocar(tabla_, hash, posicion_entrada);
+    numero_entradas_++;
+
+    if (EstaMigrando()) {
+        AvanzarMigracion(SLOTS_MIGRADOS_POR_OPERACION);
+    }
+    return Status::OK;
+}
+
+Status IndiceHashCadena::Eliminar(const std::string& clave_str, int64_t /*clave_int*/, RecordId id_registro) {
+    uint32_t hash = FuncionHash(clave_str);
+    TablaHash* tabla = &tabla_;
+    uint32_t slot;
+    if (!BuscarSlot(tabla_, hash, clave_str, id_registro, slot)) {
+        if (!EstaMigrando() || !BuscarSlot(tabla_anterior_, hash, clave_str, id_registro, slot)) {
+            return Status::NOT_FOUND;
+        }
+        tabla = &tabla_anterior_;
+    }
+    tabla->control[slot] = CONTROL_BORRADO;
+    uint32_t posicion_entrada = tabla->posiciones[slot];
+    std::string().swap(entradas_[posicion_entrada].clave);
+    entradas_libres_.push_back(posicion_entrada);
+    tabla->ocupados--;
+    tabla->borrados++;
+    numero_entradas_--;
+
+    if (EstaMigrando()) {
+        AvanzarMigracion(SLOTS_MIGRADOS_POR_OPERACION);
+    }
+    return Status::OK;
+}
+
+std::optional<std::set<RecordId>> IndiceHashCadena::Buscar(const std::string& clave_str, int64_t /*clave_int*/) const {
+    uint32_t hash = FuncionHash(clave_str);
+    std::set<RecordId> ids;
+    RecogerCoincidencias(tabla_, hash, clave_str, ids);
+    if (EstaMigrando()) {
+        RecogerCoincidencias(tabla_anterior_, hash, clave_str, ids);
+    }
+    return ids;
+}
+
+Status IndiceHashCadena::Persistir(const std::string& ruta_archivo) const {
+    std::ofstream archivo(ruta_archivo);
+    if (!archivo.is_open()) {
+        return Status::ERROR;
+    }
+    archivo << "TIPO_INDICE:HASH_CADENA\n";
+    archivo << "NUMERO_ENTRADAS:" << numero_entradas_ << "\n";
+    // Una entrada por línea: RecordId, longitud de la clave y la clave (puede contener espacios)
+    for (const TablaHash* tabla : {&tabla_, &tabla_anterior_}) {
+        for (uint32_t slot = 0; slot < tabla->Capacidad(); ++slot) {
+            if ((tabla->control[slot] & 0x80) == 0) {
+                const EntradaHash& entrada = entradas_[tabla->posiciones[slot]];
+                archivo << entrada.id_registro << " " << entrada.clave.size() << " " << entrada.clave << "\n";
+            }
+        }
+    }
+    return archivo.good() ? Status::OK : Status::IO_ERROR;
+}
+
+Status IndiceHashCadena::Cargar(const std::string& ruta_archivo) {
+    std::ifstream archivo(ruta_archivo);
+    if (!archivo.is_open()) {
+        return Status::ERROR;
+    }
+    std::string linea;
+    if (!std::getline(archivo, linea) || linea != "TIPO_INDICE:HASH_CADENA") {
+        return Status::INVALID_FORMAT;
+    }
+    uint32_t entradas_esperadas = 0;
+    if (std::getline(archivo, linea) && linea.rfind("NUMERO_ENTRADAS:", 0) == 0) {
+        try {
+            entradas_esperadas = static_cast<uint32_t>(std::stoul(linea.substr(16)));
+        } catch (const std::exception&) {
+            return Status::INVALID_FORMAT; // Cabecera truncada o no numérica
+        }
+    }
+
+    // Se dimensiona una sola vez para todas las entradas: la carga no migra
+    uint32_t capacidad = TAMAÑO_TABLA_HASH;
+    while (capacidad * FACTOR_CARGA_MAXIMO < entradas_esperadas + 1.0) {
+        capacidad *= 2;
+    }
+    tabla_anterior_.Liberar();
+    tabla_.Reservar(capacidad);
+    entradas_.clear();
+    entradas_libres_.clear();
+    posicion_migracion_ = 0;
+    numero_entradas_ = 0;
+
+    RecordId id_registro;
+    size_t longitud;
+    while (archivo >> id_registro >> longitud) {
+        archivo.get(); // Separador
+        std::string clave(longitud, '\0');
+        archivo.read(&clave[0], static_cast<std::streamsize>(longitud));
+        archivo.get(); // Fin de línea
+        if (!archivo) {
+            return Status::INVALID_FORMAT;
+        }
+        Insertar(clave, 0, id_registro); // Una entrada repetida en el archivo se ignora
+    }
+    return Status::OK;
+}
+
+void IndiceHashCadena::ImprimirEstructura() const {
+    std::cout << "\n=== ESTRUCTURA DEL ÍNDICE HASH (CADENA) ===" << std::endl;
+    std::cout << "Slots: " << tabla_.Capacidad() << " (grupos de " << TAMAÑO_GRUPO << ")" << std::endl;
+    std::cout << "Número de entradas: " << numero_entradas_ << std::endl;
+    std::cout << "Slots borrados: " << tabla_.borrados << std::endl;
+    std::cout << "Factor de carga: " << ObtenerFactorCarga() << std::endl;
+    if (EstaMigrando()) {
+        std::cout << "Migrando desde " << tabla_anterior_.Capacidad() << " slots: "
+                  << posicion_migracion_ << " revisados, " << tabla_anterior_.ocupados << " pendientes" << std::endl;
+    }
+}
+
+double IndiceHashCadena::ObtenerFactorCarga() const {
+    return tabla_.Capacidad() ? static_cast<double>(tabla_.ocupados + tabla_.borrados) / tabla_.Capacidad() : 0.0;
+}
+
+// === AUXILIARES PRIVADOS ===
+
+uint32_t IndiceHashCadena::FuncionHash(const std::string& clave) const {
+    // FNV-1a de 64 bits con mezcla final: los bits altos (etiqueta) y bajos (grupo) quedan independientes
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : clave) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return static_cast<uint32_t>(hash);
+}
+
+// La secuencia de grupos es triangular (g, g+1, g+3, g+6...): con un número de
+// grupos potencia de dos recorre todos. Una búsqueda termina en el primer grupo con
+// algún slot VACIO, porque una inserción nunca habría seguido más allá.
+
+bool IndiceHashCadena::BuscarSlot(const TablaHash& tabla, uint32_t hash, const std::string& clave,
+                                  RecordId id_registro, uint32_t& slot) const {
+    uint32_t mascara_grupos = tabla.Capacidad() / TAMAÑO_GRUPO - 1;
+    uint32_t grupo = hash & mascara_grupos;
+    uint8_t etiqueta = Etiqueta(hash);
+    for (uint32_t salto = 1; salto <= mascara_grupos + 1; ++salto) {
+        const uint8_t* control = &tabla.control[grupo * TAMAÑO_GRUPO];
+        for (uint32_t candidatos = MascaraIguales(control, etiqueta); candidatos; candidatos &= candidatos - 1) {
+            uint32_t posicion = grupo * TAMAÑO_GRUPO + PrimerBit(candidatos);
+            const EntradaHash& entrada = entradas_[tabla.posiciones[posicion]];
+            if (entrada.id_registro == id_registro && entrada.hash == hash && entrada.clave == clave) {
+                slot = posicion;
+                return true;
+            }
+        }
+        if (MascaraIguales(control, CONTROL_VACIO)) {
+            return false;
+        }
+        grupo = (grupo + salto) & mascara_grupos;
+    }
+    return false;
+}
+
+void IndiceHashCadena::RecogerCoincidencias(const TablaHash& tabla, uint32_t hash, const std::string& clave,
+                                            std::set<RecordId>& ids) const {
+    uint32_t mascara_grupos = tabla.Capacidad() / TAMAÑO_GRUPO - 1;
+    uint32_t grupo = hash & mascara_grupos;
+    uint8_t etiqueta = Etiqueta(hash);
+    for (uint32_t salto = 1; salto <= mascara_grupos + 1; ++salto) {
+        const uint8_t* control = &tabla.control[grupo * TAMAÑO_GRUPO];
+        for (uint32_t candidatos = MascaraIguales(control, etiqueta); candidatos; candidatos &= candidatos - 1) {
+            const EntradaHash& entrada = entradas_[tabla.posiciones[grupo * TAMAÑO_GRUPO + PrimerBit(candidatos)]];
+            if (entrada.hash == hash && entrada.clave == clave) {
+                ids.insert(entrada.id_registro);
+            }
+        }
+        if (MascaraIguales(control, CONTROL_VACIO)) {
+            return;
+        }
+        grupo = (grupo + salto) & mascara_grupos;
+    }
+}
+
+void IndiceHashCadena::Colocar(TablaHash& tabla, uint32_t hash, uint32_t posicion_entrada) {
+    uint32_t mascara_grupos = tabla.Capacidad() / TAMAÑO_GRUPO - 1;
+    uint32_t grupo = hash & mascara_grupos;
+    for (uint32_t salto = 1;; ++salto) {
+        uint32_t libres = MascaraLibres(&tabla.control[grupo * TAMAÑO_GRUPO]);
+        if (libres) {
+            uint32_t posicion = grupo * TAMAÑO_GRUPO + PrimerBit(libres);
+            if (tabla.control[posicion] == CONTROL_BORRADO) {
+                tabla.borrados--;
+            }
+            tabla.control[posicion] = Etiqueta(hash);
+            tabla.posiciones[posicion] = posicion_entrada;
+            tabla.ocupados++;
+            return;
+        }
+        grupo = (grupo + salto) & mascara_grupos; // El factor de carga garantiza un hueco
+    }
+}
+
+void IndiceHashCadena::IniciarRedimension() {
+    // Con muchas lápidas y pocas entradas basta con reconstruir al mismo tamaño
+    uint32_t capacidad = tabla_.Capacidad();
+    uint32_t nueva_capacidad = (tabla_.ocupados > capacidad / 2) ? capacidad * 2 : capacidad;
+    tabla_anterior_ = std::move(tabla_);
+    tabla_ = TablaHash();
+    tabla_.Reservar(nueva_capacidad);
+    posicion_migracion_ = 0;
+}
+
+void IndiceHashCadena::AvanzarMigracion(uint32_t slots) {
+    uint32_t fin = std::min<uint32_t>(posicion_migracion_ + slots, tabla_anterior_.Capacidad());
+    for (; posicion_migracion_ < fin; ++posicion_migracion_) {
+        uint32_t slot = posicion_migracion_;
+        if ((tabla_anterior_.control[slot] & 0x80) == 0) {
+            uint32_t posicion_entrada = tabla_anterior_.posiciones[slot];
+            Colocar(tabla_, entradas_[posicion_entrada].hash, posicion_entrada);
+            tabla_anterior_.control[slot] = CONTROL_BORRADO;
+            tabla_anterior_.ocupados--;
+        }
+    }
+    if (posicion_migracion_ >= tabla_anterior_.Capacidad() || tabla_anterior_.ocupados == 0) {
+        tabla_anterior_.Liberar();
+        posicion_migracion_ = 0;
+    }
+}
@@ -0,0 +1,228 @@
+// index/ordenador_entradas_indice.cpp - Implementación de la ordenación externa de entradas
+#include "ordenador_entradas_indice.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#ifdef _WIN32
+    #include <process.h> // _getpid
+#else
+    #include <unistd.h>  // getpid
+#endif
+
+namespace {
+std::atomic<uint64_t> contador_runs{0}; // Nombres únicos entre ordenadores concurrentes
+
+// El PID separa los runs de dos procesos que comparten el directorio temporal
+std::string PrefijoRuns() {
+#ifdef _WIN32
+    return "orden_indice_" + std::to_string(_getpid()) + "_";
+#else
+    return "orden_indice_" + std::to_string(getpid()) + "_";
+#endif
+}
+}
+
+OrdenadorEntradasIndice::OrdenadorEntradasIndice(uint32_t longitud_clave, size_t memoria_maxima_bytes,
+                                                 std::string directorio_temporal, uint32_t hilos)
+    : longitud_clave_(longitud_clave), tamano_entrada_(longitud_clave + sizeof(RecordId)),
+      directorio_temporal_(std::move(directorio_temporal)), hilos_(std::max<uint32_t>(hilos, 1)) {
+    if (longitud_clave == 0) {
+        throw std::invalid_argument("OrdenadorEntradasIndice: la longitud de clave no puede ser 0");
+    }
+    // Cada entrada ocupa tamano_entrada_ bytes en buffer_ y 4 en orden_
+    max_entradas_memoria_ = std::max<size_t>(memoria_maxima_bytes / (tamano_entrada_ + sizeof(uint32_t)), 1024);
+    if (!directorio_temporal_.empty() && directorio_temporal_.back() != '/') {
+        directorio_temporal_ += '/';
+    }
+}
+
+OrdenadorEntradasIndice::~OrdenadorEntradasIndice() {
+    runs_.clear();
+    for (const auto& ruta : rutas_runs_) {
+        std::remove(ruta.c_str());
+    }
+}
+
+// ===== ACUMULACIÓN =====
+
+Status OrdenadorEntradasIndice::Añadir(const Byte* clave, RecordId id_registro) {
+    if (finalizado_) {
+        return Status::ERROR;
+    }
+    size_t inicio = buffer_.size();
+    buffer_.resize(inicio + tamano_entrada_);
+    std::memcpy(buffer_.data() + inicio, clave, longitud_clave_);
+    std::memcpy(buffer_.data() + inicio + longitud_clave_, &id_registro, sizeof(id_registro));
+    numero_entradas_++;
+
+    if (buffer_.size() / tamano_entrada_ >= max_entradas_memoria_) {
+        return VolcarRun();
+    }
+    return Status::OK;
+}
+
+Status OrdenadorEntradasIndice::Finalizar() {
+    if (finalizado_) {
+        return Status::OK;
+    }
+    finalizado_ = true;
+
+    if (rutas_runs_.empty()) {
+        // Todo cupo en memoria: se devuelve directamente desde el buffer ordenado
+        OrdenarBuffer();
+        posicion_memoria_ = 0;
+        return Status::OK;
+    }
+
+    if (!buffer_.empty()) {
+        Status estado = VolcarRun();
+        if (estado != Status::OK) {
+            return estado;
+        }
+    }
+    std::vector<Byte>().swap(buffer_);
+    std::vector<uint32_t>().swap(orden_);
+
+    cabezas_.assign(rutas_runs_.size() * tamano_entrada_, 0);
+    for (uint32_t run = 0; run < rutas_runs_.size(); ++run) {
+        auto archivo = std::make_unique<std::ifstream>(rutas_runs_[run], std::ios::binary);
+        if (!archivo->is_open()) {
+            std::cerr << "Error: No se pudo abrir el run temporal " << rutas_runs_[run] << std::endl;
+            return Status::IO_ERROR;
+        }
+        runs_.push_back(std::move(archivo));
+        if (LeerCabeza(run)) {
+            monticulo_.push_back(run);
+        }
+    }
+    auto mayor = [this](uint32_t a, uint32_t b) {
+        return Menor(&cabezas_[static_cast<size_t>(b) * tamano_entrada_], &cabezas_[static_cast<size_t>(a) * tamano_entrada_]);
+    };
+    std::make_heap(monticulo_.begin(), monticulo_.end(), mayor);
+    return Status::OK;
+}
+
+// ===== SALIDA ORDENADA =====
+
+bool OrdenadorEntradasIndice::Siguiente(Byte* clave, RecordId& id_registro) {
+    if (!finalizado_) {
+        return false;
+    }
+    if (rutas_runs_.empty()) {
+        if (posicion_memoria_ >= orden_.size()) {
+            return false;
+        }
+        const Byte* entrada = buffer_.data() + static_cast<size_t>(orden_[posicion_memoria_++]) * tamano_entrada_;
+        std::memcpy(clave, entrada, longitud_clave_);
+        std::memcpy(&id_registro, entrada + longitud_clave_, sizeof(id_registro));
+        return true;
+    }
+
+    if (monticulo_.empty()) {
+        return false;
+    }
+    auto mayor = [this](uint32_t a, uint32_t b) {
+        return Menor(&cabezas_[static_cast<size_t>(b) * tamano_entrada_], &cabezas_[static_cast<size_t>(a) * tamano_entrada_]);
+    };
+    std::pop_heap(monticulo_.begin(), monticulo_.end(), mayor);
+    uint32_t run = monticulo_.back();
+    const Byte* entrada = &cabezas_[static_cast<size_t>(run) * tamano_entrada_];
+    std::memcpy(clave, entrada, longitud_clave_);
+    std::memcpy(&id_registro, entrada + longitud_clave_, sizeof(id_registro));
+
+    if (LeerCabeza(run)) {
+        std::push_heap(monticulo_.begin(), monticulo_.end(), mayor);
+    } else {
+        monticulo_.pop_back();
+    }
+    return true;
+}
+
+// ===== AUXILIARES PRIVADOS =====
+
+bool OrdenadorEntradasIndice::Menor(const Byte* a, const Byte* b) const {
+    int comparacion = std::memcmp(a, b, longitud_clave_);
+    if (comparacion != 0) {
+        return comparacion < 0;
+    }
+    RecordId id_a, id_b;
+    std::memcpy(&id_a, a + longitud_clave_, sizeof(id_a));
+    std::memcpy(&id_b, b + longitud_clave_, sizeof(id_b));
+    return id_a < id_b;
+}
+
+void OrdenadorEntradasIndice::OrdenarBuffer() {
+    size_t n = buffer_.size() / tamano_entrada_;
+    orden_.resize(n);
+    std::iota(orden_.begin(), orden_.end(), 0u);
+    auto menor = [this](uint32_t a, uint32_t b) {
+        return Menor(buffer_.data() + static_cast<size_t>(a) * tamano_entrada_,
+                     buffer_.data() + static_cast<size_t>(b) * tamano_entrada_);
+    };
+
+    // Tramos de al menos 16K entradas: por debajo no compensa lanzar hilos
+    size_t tramos = std::min<size_t>(hilos_, std::max<size_t>(n / 16384, 1));
+    if (tramos <= 1) {
+        std::sort(orden_.begin(), orden_.end(), menor);
+        return;
+    }
+    std::vector<size_t> limites(tramos + 1);
+    for (size_t i = 0; i <= tramos; ++i) {
+        limites[i] = n * i / tramos;
+    }
+    std::vector<std::thread> hilos;
+    for (size_t i = 0; i < tramos; ++i) {
+        hilos.emplace_back([&, i]() {
+            std::sort(orden_.begin() + limites[i], orden_.begin() + limites[i + 1], menor);
+        });
+    }
+    for (auto& hilo : hilos) {
+        hilo.join();
+    }
+
+    // Mezcla por parejas; las parejas de una misma ronda son independientes
+    for (size_t paso = 1; paso < tramos; paso *= 2) {
+        hilos.clear();
+        for (size_t i = 0; i + paso < tramos; i += 2 * paso) {
+            size_t inicio = limites[i];
+            size_t medio = limites[i + paso];
+            size_t fin = limites[std::min(i + 2 * paso, tramos)];
+            hilos.emplace_back([&, inicio, medio, fin]() {
+                std::inplace_merge(orden_.begin() + inicio, orden_.begin() + medio, orden_.begin() + fin, menor);
+            });
+        }
+        for (auto& hilo : hilos) {
+            hilo.join();
+        }
+    }
+}
+
+Status OrdenadorEntradasIndice::VolcarRun() {
+    OrdenarBuffer();
+    std::string ruta = directorio_temporal_ + PrefijoRuns() + std::to_string(contador_runs++) + ".run";
+    std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+    if (!archivo.is_open()) {
+        std::cerr << "Error: No se pudo crear el run temporal " << ruta << std::endl;
+        return Status::IO_ERROR;
+    }
+    rutas_runs_.push_back(ruta);
+    for (uint32_t posicion : orden_) {
+        archivo.write(buffer_.data() + static_cast<size_t>(posicion) * tamano_entrada_, tamano_entrada_);
+    }
+    if (!archivo.good()) {
+        return Status::IO_ERROR;
+    }
+    buffer_.clear();
+    orden_.clear();
+    return Status::OK;
+}
+
+bool OrdenadorEntradasIndice::LeerCabeza(uint32_t run) {
+    runs_[run]->read(&cabezas_[static_cast<size_t>(run) * tamano_entrada_], tamano_entrada_);
+    return runs_[run]->gcount() == static_cast<std::streamsize>(tamano_entrada_);
+}
@@ -0,0 +1,85 @@
+// index/ordenador_entradas_indice.h - Ordenación externa de entradas (clave, RecordId)
+// Alimenta la construcción masiva de árboles B+ (ArbolBMasPaginado::ConstruirMasivo)
+
+#ifndef ORDENADOR_ENTRADAS_INDICE_H
+#define ORDENADOR_ENTRADAS_INDICE_H
+
+#include "../include/common.h"
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Ordena entradas de longitud fija [clave][RecordId] por (clave, RecordId).
+ *
+ * USO: Añadir() ... Añadir() -> Finalizar() -> Siguiente() hasta que devuelva false.
+ *
+ * - Las entradas se acumulan en memoria hasta memoria_maxima_bytes. Al superarlo,
+ *   el bloque se ordena y se vuelca a un archivo temporal (run); Finalizar() mezcla
+ *   los runs con un montículo de k vías. Si nunca se supera, no se escribe nada.
+ * - Cada bloque se ordena en paralelo: se reparte en tramos, uno por hilo, y los
+ *   tramos se mezclan por parejas.
+ * - Los runs se borran al destruir el ordenador.
+ */
+class OrdenadorEntradasIndice {
+public:
+    /**
+     * @brief Lanza std::invalid_argument si la longitud de clave es 0.
+     * @param longitud_clave Bytes de cada clave codificada
+     * @param memoria_maxima_bytes Memoria para entradas antes de volcar un run
+     * @param directorio_temporal Directorio donde se escriben los runs
+     * @param hilos Hilos para ordenar cada bloque (0 = uno)
+     */
+    OrdenadorEntradasIndice(uint32_t longitud_clave, size_t memoria_maxima_bytes,
+                            std::string directorio_temporal, uint32_t hilos);
+    ~OrdenadorEntradasIndice();
+
+    OrdenadorEntradasIndice(const OrdenadorEntradasIndice&) = delete;
+    OrdenadorEntradasIndice& operator=(const OrdenadorEntradasIndice&) = delete;
+
+    /**
+     * @return IO_ERROR si no se pudo volcar un run; ERROR si ya se llamó a Finalizar()
+     */
+    Status Añadir(const Byte* clave, RecordId id_registro);
+
+    /**
+     * @brief Ordena lo que queda en memoria y prepara la mezcla de los runs.
+     */
+    Status Finalizar();
+
+    /**
+     * @brief Devuelve la siguiente entrada en orden.
+     * @return false al agotarse las entradas
+     */
+    bool Siguiente(Byte* clave, RecordId& id_registro);
+
+    uint64_t NumeroEntradas() const { return numero_entradas_; }
+    size_t NumeroRunsEnDisco() const { return rutas_runs_.size(); }
+
+private:
+    uint32_t longitud_clave_;
+    uint32_t tamano_entrada_;
+    size_t max_entradas_memoria_;
+    std::string directorio_temporal_;
+    uint32_t hilos_;
+
+    std::vector<Byte> buffer_;          // Entradas contiguas del bloque actual
+    std::vector<uint32_t> orden_;       // Permutación ordenada de buffer_
+    size_t posicion_memoria_ = 0;       // Siguiente entrada de orden_ a devolver
+
+    std::vector<std::string> rutas_runs_;
+    std::vector<std::unique_ptr<std::ifstream>> runs_;
+    std::vector<Byte> cabezas_;         // Entrada actual de cada run
+    std::vector<uint32_t> monticulo_;   // Runs con entradas pendientes, como min-heap
+
+    bool finalizado_ = false;
+    uint64_t numero_entradas_ = 0;
+
+    bool Menor(const Byte* a, const Byte* b) const;
+    void OrdenarBuffer();
+    Status VolcarRun();
+    bool LeerCabeza(uint32_t run);
+};
+
+#endif // ORDENADOR_ENTRADAS_INDICE_H
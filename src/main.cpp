@@ -22,11 +22,14 @@
 #include <algorithm> // Para std::replace
 #include <iomanip>  // Para std::setw, std::setfill
 #include <regex>
+#include <chrono> // Para medir el tiempo de cada sentencia en modo lote
+#include <unordered_map>
 
 // Incluir los headers de los componentes del SGBD (refactorizados en español)
 #include "data_storage/gestor_disco.h"
 #include "data_storage/bloque.h"
 #include "data_storage/gestor_buffer.h"
+#include "data_storage/gestor_wal.h"
 #include "replacement_policies/lru_espanol.h" // Incluir la política LRU en español
 #include "replacement_policies/clock_espanol.h" // Incluir la política CLOCK en español
 #include "record_manager/gestor_registros.h" // Incluir el GestorRegistros
@@ -34,14 +37,23 @@
 #include "include/common.h" // Para Status, BlockSizeType, SectorSizeType, PageType, ColumnMetadata
 #include "index/gestor_indices.h"
 #include "Catalog_Manager/gestor_tablas_avanzado.h" // Incluir el GestorTablasAvanzado
+#include "query_processor/analizador_sql.h" // Tokenizador, planes y caché de sentencias
+#include "include/metricas.h" // Histogramas de latencia de los gestores
+#include "audio_processor/cliente_voz.h" // Servicio persistente de voz a SQL
+#ifdef SGBD_CON_PORTAUDIO
+#include "audio_processor/grabadora_voz.h" // Grabación a memoria sin grabadora_audio.exe
+#endif
 
 // Punteros globales para los managers (refactorizados en español)
 std::unique_ptr<GestorDisco> g_gestor_disco = nullptr;
+std::unique_ptr<GestorWAL> g_gestor_wal = nullptr; // Antes que el buffer: se destruye después de él
 std::unique_ptr<GestorBuffer> g_gestor_buffer = nullptr;
 std::unique_ptr<GestorRegistros> g_gestor_registros = nullptr;
 std::unique_ptr<GestorCatalogo> g_gestor_catalogo = nullptr;
 std::unique_ptr<GestorIndices> g_gestor_indices = nullptr;
 std::unique_ptr<GestorTablasAvanzado> g_gestor_tablas_avanzado = nullptr;
+std::unique_ptr<ClienteVoz> g_cliente_voz = nullptr; // Conexión con servicio_voz.py, abierta en la primera consulta de voz
+std::string g_ultima_transcripcion_voz; // El servicio no escribe transcripcion.txt
 
 // Aliases para compatibilidad con nombres en inglés usados en el código
 auto& g_disk_manager = g_gestor_disco;
@@ -59,6 +71,8 @@ using IndexManager = GestorIndices;
 
 // ===== DECLARACIONES DE FUNCIONES =====
 void HandleQueryProcessor();
+void HandleQueryProcessor(const std::string& query);
+void AttachWriteAheadLog(const std::string& disk_name);
 
 // Función auxiliar para limpiar el buffer de entrada
 void ClearInputBuffer() {
@@ -117,43 +131,212 @@ ColumnType GetColumnTypeFromUser() {
     }
 }
 
-// Función auxiliar para parsear condiciones WHERE simples con AND
-struct Condition {
-    std::string col;
-    std::string val;
+// Busca una columna del esquema sin distinguir mayúsculas; -1 si no existe
+int FindColumnIndex(const FullTableSchema& schema, const std::string& name) {
+    std::string lower_name = name;
+    std::transform(lower_name.begin(), lower_name.end(), lower_name.begin(), ::tolower);
+    for (size_t i = 0; i < schema.columns.size(); ++i) {
+        std::string schema_col_name(schema.columns[i].name);
+        std::transform(schema_col_name.begin(), schema_col_name.end(), schema_col_name.begin(), ::tolower);
+        if (lower_name == schema_col_name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Los CHAR se guardan rellenos con espacios hasta su tamaño (ver ValidateAndConvertValues)
+// y así entran en los índices: las claves de búsqueda se rellenan igual.
+std::string PadCharValue(const ColumnMetadata& column, const std::string& value) {
+    std::string padded = value;
+    if (column.type == ColumnType::CHAR && padded.size() < column.size) {
+        padded.resize(column.size, ' ');
+    }
+    return padded;
+}
+
+// Compila las condiciones WHERE contra el esquema una sola vez (ver FiltroCompilado);
+// el cursor lo evalúa después sobre páginas enteras.
+// Devuelve false si alguna columna no existe o una constante no es del tipo de su columna.
+bool BuildWhereFilter(const FullTableSchema& schema, const std::vector<CondicionFiltro>& conds,
+                      std::shared_ptr<const FiltroCompilado>& filter) {
+    auto compiled = std::make_shared<FiltroCompilado>();
+    if (FiltroCompilado::Compilar(schema.columns, conds, *compiled) != Status::OK) {
+        return false;
+    }
+    filter = std::move(compiled);
+    return true;
+}
+
+// --- Selección del camino de acceso ---
+// Para cada consulta con WHERE se elige entre recorrer la tabla entera o visitar solo
+// los RecordId que devuelve un índice sobre alguna de las columnas de la condición.
+// El filtro WHERE completo se vuelve a evaluar sobre cada candidato, así que el índice
+// solo tiene que devolver un superconjunto (p. ej. prefijos truncados en BTREE_CADENA).
+
+// Selectividades supuestas mientras no haya histogramas: igualdad 1/10, rango cerrado
+// 1/4, rango abierto 1/3. Un índice deja de compensar si devuelve más de la cuarta
+// parte de la tabla: visitar esos ids cuesta casi lo mismo que leer todas las páginas.
+constexpr double kEqualitySelectivity = 0.10;
+constexpr double kClosedRangeSelectivity = 0.25;
+constexpr double kOpenRangeSelectivity = 0.33;
+constexpr double kMaxIndexFraction = 0.25;
+
+enum class AccessPathKind { FULL_SCAN, INDEX_LOOKUP, INDEX_RANGE };
+
+struct AccessPath {
+    AccessPathKind kind = AccessPathKind::FULL_SCAN;
+    std::string column;
+    std::vector<RecordId> record_ids; // Candidatos del índice (vacío en FULL_SCAN)
+    double estimated_rows = 0.0;
 };
-std::vector<Condition> ParseWhereConditions(const std::string& where_str) {
-    std::vector<Condition> conds;
-    size_t start = 0, end = 0;
-    std::string temp_where_str = where_str; // Copia modificable
-    
-    // Convertir a minúsculas para coincidencia sin distinción de mayúsculas y minúsculas
-    std::transform(temp_where_str.begin(), temp_where_str.end(), temp_where_str.begin(), ::tolower);
-
-    while ((end = temp_where_str.find("and", start)) != std::string::npos) {
-        std::string cond = temp_where_str.substr(start, end - start);
-        size_t eq = cond.find('=');
-        if (eq != std::string::npos) {
-            std::string col = cond.substr(0, eq);
-            std::string val = cond.substr(eq + 1);
-            col.erase(std::remove_if(col.begin(), col.end(), ::isspace), col.end());
-            val.erase(std::remove_if(val.begin(), val.end(), ::isspace), val.end()); // Corregido: val.end()
-            if (val.front() == '\'' && val.back() == '\'') val = val.substr(1, val.size()-2);
-            conds.push_back({col, val});
-        }
-        start = end + 3;
-    }
-    std::string cond = temp_where_str.substr(start);
-    size_t eq = cond.find('=');
-    if (eq != std::string::npos) {
-        std::string col = cond.substr(0, eq);
-        std::string val = cond.substr(eq + 1);
-        col.erase(std::remove_if(col.begin(), col.end(), ::isspace), col.end());
-        val.erase(std::remove_if(val.begin(), val.end(), ::isspace), val.end()); // Corregido: val.end()
-        if (val.front() == '\'' && val.back() == '\'') val = val.substr(1, val.size()-2);
-        conds.push_back({col, val});
-    }
-    return conds;
+
+std::string DescribeAccessPath(const AccessPath& path, uint64_t table_rows) {
+    switch (path.kind) {
+        case AccessPathKind::INDEX_LOOKUP:
+            return "búsqueda en índice sobre '" + path.column + "' (" + std::to_string(path.record_ids.size()) + " candidatos)";
+        case AccessPathKind::INDEX_RANGE:
+            return "rango en índice sobre '" + path.column + "' (" + std::to_string(path.record_ids.size()) + " candidatos)";
+        case AccessPathKind::FULL_SCAN:
+            break;
+    }
+    return "recorrido completo (" + std::to_string(table_rows) + " registros)";
+}
+
+AccessPath ChooseAccessPath(const std::string& table_name, const FullTableSchema& schema, const std::vector<CondicionFiltro>& conds) {
+    AccessPath best;
+    if (!g_index_manager || conds.empty()) {
+        return best;
+    }
+    const double table_rows = static_cast<double>(schema.base_metadata.num_records);
+    const size_t max_candidates = static_cast<size_t>(table_rows * kMaxIndexFraction);
+
+    // Una entrada por columna indexada: igualdad o rango acumulado de sus condiciones
+    struct Candidate {
+        int col_idx;
+        bool equality = false;
+        std::string eq_value;
+        LimiteRangoIndice lower = LimiteRangoIndice::SinLimite();
+        LimiteRangoIndice upper = LimiteRangoIndice::SinLimite();
+        double estimated_rows = 0.0;
+    };
+    std::vector<Candidate> candidates;
+    for (const auto& cond : conds) {
+        if (cond.operador == OperadorComparacion::DISTINTO || cond.valor == DisposicionRegistro::VALOR_NULO) {
+            continue;
+        }
+        int col_idx = FindColumnIndex(schema, cond.columna);
+        if (col_idx == -1) {
+            continue;
+        }
+        const ColumnMetadata& column = schema.columns[col_idx];
+        if (!g_index_manager->ExisteIndice(table_name, column.name)) {
+            continue;
+        }
+        TipoIndice type = g_index_manager->ObtenerTipoIndice(table_name, column.name);
+        if (cond.operador != OperadorComparacion::IGUAL && type == TipoIndice::HASH_CADENA) {
+            continue; // El hash no conserva el orden de las claves
+        }
+        auto it = std::find_if(candidates.begin(), candidates.end(),
+                               [col_idx](const Candidate& c) { return c.col_idx == col_idx; });
+        if (it == candidates.end()) {
+            Candidate candidate;
+            candidate.col_idx = col_idx;
+            candidates.push_back(candidate);
+            it = candidates.end() - 1;
+        }
+        std::string value = PadCharValue(column, cond.valor);
+        bool inclusive = cond.operador != OperadorComparacion::MENOR && cond.operador != OperadorComparacion::MAYOR;
+        LimiteRangoIndice bound;
+        if (type == TipoIndice::BTREE_ENTERO) {
+            try {
+                bound = LimiteRangoIndice::Entero(std::stoll(cond.valor), inclusive);
+            } catch (...) {
+                continue;
+            }
+        } else {
+            bound = LimiteRangoIndice::Cadena(value, inclusive);
+        }
+        if (cond.operador == OperadorComparacion::IGUAL) {
+            it->equality = true;
+            it->eq_value = value;
+        } else if (cond.operador == OperadorComparacion::MAYOR || cond.operador == OperadorComparacion::MAYOR_IGUAL) {
+            it->lower = bound; // Si hay varios límites por el mismo lado, el predicado aplica el resto
+        } else {
+            it->upper = bound;
+        }
+    }
+    for (auto& c : candidates) {
+        double selectivity = c.equality ? kEqualitySelectivity
+                           : (c.lower.presente && c.upper.presente) ? kClosedRangeSelectivity
+                           : kOpenRangeSelectivity;
+        c.estimated_rows = table_rows * selectivity;
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.estimated_rows < b.estimated_rows; });
+
+    // Se prueba el candidato más selectivo primero; si el índice devuelve más filas
+    // de las que compensan, se pasa al siguiente y, al final, al recorrido completo
+    for (const auto& c : candidates) {
+        const std::string column_name = schema.columns[c.col_idx].name;
+        AccessPath path;
+        path.column = column_name;
+        path.estimated_rows = c.estimated_rows;
+        if (c.equality) {
+            int64_t int_value = 0;
+            if (g_index_manager->ObtenerTipoIndice(table_name, column_name) == TipoIndice::BTREE_ENTERO) {
+                try { int_value = std::stoll(c.eq_value); } catch (...) { continue; }
+            }
+            // Sin coincidencias el índice devuelve un conjunto vacío, que es un plan
+            // válido (cero filas); nullopt significa que el índice no se pudo usar
+            auto ids = g_index_manager->BuscarEnIndice(table_name, column_name, c.eq_value, int_value);
+            if (!ids) {
+                continue;
+            }
+            if (ids->size() > max_candidates) {
+                continue;
+            }
+            path.kind = AccessPathKind::INDEX_LOOKUP;
+            path.record_ids.assign(ids->begin(), ids->end());
+        } else {
+            IteradorRangoArbol iterator;
+            if (g_index_manager->AbrirRangoEnIndice(table_name, column_name, c.lower, c.upper, iterator) != Status::OK) {
+                continue;
+            }
+            const Byte* key = nullptr;
+            RecordId record_id;
+            bool too_many = false;
+            while (iterator.Siguiente(key, record_id)) {
+                if (path.record_ids.size() >= max_candidates) {
+                    too_many = true; // No hace falta terminar el rango para descartarlo
+                    break;
+                }
+                path.record_ids.push_back(record_id);
+            }
+            iterator.Cerrar();
+            if (too_many) {
+                continue;
+            }
+            path.kind = AccessPathKind::INDEX_RANGE;
+        }
+        return path;
+    }
+    return best;
+}
+
+// Abre el cursor según el camino de acceso elegido e informa del plan
+bool OpenQueryCursor(const std::string& table_name, const FullTableSchema& schema, const std::vector<CondicionFiltro>& conds,
+                     std::shared_ptr<const FiltroCompilado> filter, CursorRegistros& cursor) {
+    AccessPath path = ChooseAccessPath(table_name, schema, conds);
+    std::cout << "Plan: " << DescribeAccessPath(path, schema.base_metadata.num_records) << std::endl;
+    Status status = (path.kind == AccessPathKind::FULL_SCAN)
+                        ? g_record_manager->AbrirCursorFiltrado(table_name, cursor, std::move(filter))
+                        : g_record_manager->AbrirCursorPorIds(table_name, std::move(path.record_ids), cursor, std::move(filter));
+    if (status != Status::OK) {
+        std::cerr << "Error al abrir el recorrido de la tabla '" << table_name << "'." << std::endl;
+        return false;
+    }
+    return true;
 }
 
 // Función auxiliar para validar y convertir valores según el tipo de columna
@@ -169,8 +352,8 @@ bool ValidateAndConvertValues(const std::vector<std::string>& values, const std:
         switch (static_cast<uint8_t>(col.type)) { // Corrección: Cast explícito a uint8_t
             case static_cast<uint8_t>(ColumnType::INT): // Corrección: Cast explícito a uint8_t
                 try {
-                    // Intentar convertir a int y luego a string para asegurar el formato
-                    out_values.push_back(std::to_string(std::stoi(val)));
+                    // Convertir a int64 (el tipo de la columna) y luego a string para asegurar el formato
+                    out_values.push_back(std::to_string(std::stoll(val)));
                 } catch (...) {
                     error = "Valor '" + val + "' no es un INT válido para la columna '" + col.name + "'.";
                     return false;
@@ -236,7 +419,8 @@ void DisplayBufferPoolManagementMenu() {
     std::cout << "3. Ver Tabla de Páginas del Buffer Pool" << std::endl;
     std::cout << "4. Cambiar Tamaño del Buffer Pool [No implementado]" << std::endl;
     std::cout << "5. Cambiar Algoritmo de Reemplazo [No implementado]" << std::endl;
-    std::cout << "6. Volver al Menú Principal" << std::endl;
+    std::cout << "6. Exportar Métricas de Latencia (JSON / Prometheus)" << std::endl;
+    std::cout << "7. Volver al Menú Principal" << std::endl;
     std::cout << "Ingrese su opción: ";
 }
 
@@ -500,6 +684,8 @@ void CreateNewDisk() {
     std::cout << "Seleccione la política de reemplazo para el Buffer Pool:" << std::endl;
     std::cout << "  0. LRU (Least Recently Used)" << std::endl;
     std::cout << "  1. CLOCK" << std::endl;
+    std::cout << "  2. 2Q (resistente a recorridos secuenciales)" << std::endl;
+    std::cout << "  3. CLOCK atómico (sin bloqueos)" << std::endl;
     replacement_policy_choice = GetNumericInput<int>("Opción: ");
 
     try {
@@ -519,6 +705,10 @@ void CreateNewDisk() {
             policy = std::make_unique<LRUReplacementPolicy>();
         } else if (replacement_policy_choice == 1) {
             policy = std::make_unique<ClockReplacementPolicy>();
+        } else if (replacement_policy_choice == 2) {
+            policy = std::make_unique<TwoQueueReplacementPolicy>(buffer_pool_size);
+        } else if (replacement_policy_choice == 3) {
+            policy = std::make_unique<LockFreeClockReplacementPolicy>(buffer_pool_size);
         } else {
             std::cout << "Opción de política de reemplazo inválida. Usando LRU por defecto." << std::endl;
             policy = std::make_unique<LRUReplacementPolicy>();
@@ -535,18 +725,114 @@ void CreateNewDisk() {
         g_index_manager = std::make_unique<IndexManager>();
         g_record_manager->SetIndexManager(g_index_manager.get());
 
+        AttachWriteAheadLog(disk_name);
         g_catalog_manager->InitCatalog();
 
     } catch (const std::exception& e) {
         std::cerr << "Error al crear el disco: " << e.what() << std::endl;
         g_disk_manager.reset();
         g_buffer_manager.reset();
+        if (g_catalog_manager) {
+            g_catalog_manager->EstablecerWAL(nullptr); // Se guarda al destruirse, ya sin WAL
+        }
+        g_gestor_wal.reset();
         g_record_manager.reset();
         g_catalog_manager.reset();
         g_index_manager.reset(); // Asegurarse de resetear el index manager también
     }
 }
 
+std::unique_ptr<IReplacementPolicy> CreateReplacementPolicy(int replacement_policy_choice, uint32_t buffer_pool_size) {
+    if (replacement_policy_choice == 0) {
+        return std::make_unique<LRUReplacementPolicy>();
+    } else if (replacement_policy_choice == 1) {
+        return std::make_unique<ClockReplacementPolicy>();
+    } else if (replacement_policy_choice == 2) {
+        return std::make_unique<TwoQueueReplacementPolicy>(buffer_pool_size);
+    } else if (replacement_policy_choice == 3) {
+        return std::make_unique<LockFreeClockReplacementPolicy>(buffer_pool_size);
+    }
+    std::cout << "Opción de política de reemplazo inválida. Usando LRU por defecto." << std::endl;
+    return std::make_unique<LRUReplacementPolicy>();
+}
+
+// Abre el WAL del disco, rehace lo confirmado que no llegó a las páginas y lo asocia a los managers
+void AttachWriteAheadLog(const std::string& disk_name) {
+    g_gestor_wal = std::make_unique<GestorWAL>((fs::path("Discos") / disk_name).string());
+    Status status = g_gestor_wal->Abrir();
+    if (status == Status::OK) {
+        status = g_gestor_wal->Recuperar(*g_buffer_manager, &GestorRegistros::AplicarRegistroWAL);
+    }
+    if (status != Status::OK) {
+        throw std::runtime_error("No se pudo recuperar el WAL del disco: " + StatusToString(status));
+    }
+    g_record_manager->SetGestorWAL(g_gestor_wal.get());
+    g_catalog_manager->EstablecerWAL(g_gestor_wal.get());
+}
+
+// Crea el buffer pool y los managers sobre g_disk_manager, ya cargado. En solo lectura
+// no se abre el WAL: una réplica de consulta no puede rehacer nada en la imagen
+void InitializeManagersForLoadedDisk(uint32_t buffer_pool_size, std::unique_ptr<IReplacementPolicy> policy) {
+    g_buffer_manager = std::make_unique<BufferManager>(*g_disk_manager, buffer_pool_size, g_disk_manager->GetBlockSize(), std::move(policy));
+    
+    // Inicializar RecordManager y CatalogManager con constructores simplificados
+    // Ahora sus constructores solo requieren BufferManager, resolviendo la dependencia circular inicial.
+    g_record_manager = std::make_unique<RecordManager>(*g_buffer_manager);
+    g_catalog_manager = std::make_unique<CatalogManager>(*g_buffer_manager);
+    g_record_manager->SetCatalogManager(*g_catalog_manager);
+    g_catalog_manager->SetRecordManager(*g_record_manager);
+    g_index_manager = std::make_unique<IndexManager>();
+    g_record_manager->SetIndexManager(g_index_manager.get());
+
+    if (!g_disk_manager->EsSoloLectura()) {
+        AttachWriteAheadLog(g_disk_manager->GetDiskName());
+    }
+    g_catalog_manager->InitCatalog();
+    if (g_gestor_wal && g_gestor_wal->ObtenerEstadisticas().registros_recuperados > 0) {
+        // El catálogo guarda los contadores de registros de forma perezosa
+        g_record_manager->RecontarRegistros();
+    }
+}
+
+void ResetManagers() {
+    g_disk_manager.reset();
+    g_buffer_manager.reset();
+    if (g_catalog_manager) {
+        g_catalog_manager->EstablecerWAL(nullptr); // Se guarda al destruirse, ya sin WAL
+    }
+    g_gestor_wal.reset(); // Después del buffer, que lo usa al volcar
+    g_record_manager.reset();
+    g_catalog_manager.reset();
+    g_index_manager.reset(); // Asegurarse de resetear el index manager también
+}
+
+// Abre un disco existente sin preguntar nada (modo lote). Con read_only la imagen se
+// proyecta en memoria y ni el catálogo ni los metadatos se escriben al cerrar
+bool OpenExistingDisk(const std::string& disk_name, uint32_t buffer_pool_size, int replacement_policy_choice,
+                      bool read_only) {
+    fs::path disk_path = fs::path("Discos") / disk_name;
+    if (!fs::exists(disk_path)) {
+        std::cerr << "Error: El disco '" << disk_name << "' no existe en " << disk_path << std::endl;
+        return false;
+    }
+    try {
+        g_disk_manager = std::make_unique<DiskManager>(disk_name, 1, 1, 1, 1, 512, 512, false);
+        g_disk_manager->EstablecerSoloLectura(read_only);
+        Status status = g_disk_manager->LoadDiskMetadata();
+        if (status != Status::OK) {
+            std::cerr << "Error al cargar los metadatos del disco: " << StatusToString(status) << std::endl;
+            g_disk_manager.reset();
+            return false;
+        }
+        InitializeManagersForLoadedDisk(buffer_pool_size, CreateReplacementPolicy(replacement_policy_choice, buffer_pool_size));
+    } catch (const std::exception& e) {
+        std::cerr << "Error al cargar el disco: " << e.what() << std::endl;
+        ResetManagers();
+        return false;
+    }
+    return true;
+}
+
 void LoadExistingDisk() {
     std::string disk_name;
     uint32_t buffer_pool_size;
@@ -579,38 +865,15 @@ void LoadExistingDisk() {
         std::cout << "Seleccione la política de reemplazo para el Buffer Pool:" << std::endl;
         std::cout << "  0. LRU (Least Recently Used)" << std::endl;
         std::cout << "  1. CLOCK" << std::endl;
+        std::cout << "  2. 2Q (resistente a recorridos secuenciales)" << std::endl;
+        std::cout << "  3. CLOCK atómico (sin bloqueos)" << std::endl;
         replacement_policy_choice = GetNumericInput<int>("Opción: ");
 
-        std::unique_ptr<IReplacementPolicy> policy;
-        if (replacement_policy_choice == 0) {
-            policy = std::make_unique<LRUReplacementPolicy>();
-        } else if (replacement_policy_choice == 1) {
-            policy = std::make_unique<ClockReplacementPolicy>();
-        } else {
-            std::cout << "Opción de política de reemplazo inválida. Usando LRU por defecto." << std::endl;
-            policy = std::make_unique<LRUReplacementPolicy>();
-        }
-
-        g_buffer_manager = std::make_unique<BufferManager>(*g_disk_manager, buffer_pool_size, g_disk_manager->GetBlockSize(), std::move(policy));
-        
-        // Inicializar RecordManager y CatalogManager con constructores simplificados
-        // Ahora sus constructores solo requieren BufferManager, resolviendo la dependencia circular inicial.
-        g_record_manager = std::make_unique<RecordManager>(*g_buffer_manager);
-        g_catalog_manager = std::make_unique<CatalogManager>(*g_buffer_manager);
-        g_record_manager->SetCatalogManager(*g_catalog_manager);
-        g_catalog_manager->SetRecordManager(*g_record_manager);
-        g_index_manager = std::make_unique<IndexManager>();
-        g_record_manager->SetIndexManager(g_index_manager.get());
-
-        g_catalog_manager->InitCatalog();
+        InitializeManagersForLoadedDisk(buffer_pool_size, CreateReplacementPolicy(replacement_policy_choice, buffer_pool_size));
 
     } catch (const std::exception& e) {
         std::cerr << "Error al cargar el disco: " << e.what() << std::endl;
-        g_disk_manager.reset();
-        g_buffer_manager.reset();
-        g_record_manager.reset();
-        g_catalog_manager.reset();
-        g_index_manager.reset(); // Asegurarse de resetear el index manager también
+        ResetManagers();
     }
 }
 
@@ -630,6 +893,10 @@ void DeleteDisk() {
             if (g_disk_manager && g_disk_manager->GetDiskName() == disk_name_to_delete) {
                 g_disk_manager.reset();
                 g_buffer_manager.reset();
+                if (g_catalog_manager) {
+                    g_catalog_manager->EstablecerWAL(nullptr); // Se guarda al destruirse, ya sin WAL
+                }
+                g_gestor_wal.reset();
                 g_record_manager.reset();
                 g_catalog_manager.reset();
                 g_index_manager.reset(); // Asegurarse de resetear el index manager también
@@ -669,6 +936,34 @@ void FlushAllPages() {
     }
 }
 
+// Exporta los histogramas de latencia de todos los gestores (pin, fallos, E/S,
+// desalojos, índices y sentencias) a pantalla o a un archivo
+void ExportMetrics() {
+    std::cout << "\n--- Exportar Métricas de Latencia ---" << std::endl;
+    std::cout << "1. JSON" << std::endl;
+    std::cout << "2. Texto de Prometheus" << std::endl;
+    int formato = GetNumericInput<int>("Formato: ");
+    if (formato != 1 && formato != 2) {
+        std::cout << "Formato inválido." << std::endl;
+        return;
+    }
+    const RegistroMetricas& registro = RegistroMetricas::Global();
+    std::string contenido = (formato == 1) ? registro.ExportarJSON() : registro.ExportarPrometheus();
+
+    std::string ruta = GetStringInput("Archivo de salida (vacío = pantalla): ");
+    if (ruta.empty()) {
+        std::cout << contenido << std::endl;
+        return;
+    }
+    std::ofstream salida(ruta);
+    if (!salida.is_open()) {
+        std::cerr << "Error: No se pudo abrir el archivo '" << ruta << "' para escribir las métricas." << std::endl;
+        return;
+    }
+    salida << contenido << std::endl;
+    std::cout << "Métricas escritas en '" << ruta << "'." << std::endl;
+}
+
 // NUEVO: Función para ver la tabla de páginas del Buffer Pool
 void ViewBufferPoolTable() {
     if (!g_buffer_manager) {
@@ -836,38 +1131,22 @@ void SelectRecords() {
     uint32_t total_records_found = 0;
     std::cout << "Registros en la tabla '" << table_name << "':" << std::endl;
 
-    for (PageId page_id : schema.base_metadata.data_page_ids) {
-        uint32_t num_slots;
-        // Obtener el número total de slots en la página (ocupados o no)
-        Byte* page_data_peek = g_buffer_manager->FetchPage(page_id);
-        if (page_data_peek == nullptr) {
-            std::cerr << "Advertencia: No se pudo obtener la página " << page_id << " para seleccionar registros. Saltando esta página." << std::endl;
-            continue;
-        }
-        BlockHeader header_peek = g_record_manager->ReadBlockHeader(page_data_peek);
-        num_slots = header_peek.num_slots;
-        g_buffer_manager->UnpinPage(page_id, false);
-
-        std::cout << "  --- Página " << page_id << " (Slots: " << num_slots << ") ---" << std::endl;
-        for (uint32_t i = 0; i < num_slots; ++i) { // Iterar sobre todos los slots
-            RecordData fetched_rec_data; // Usar RecordData
-            Status status = g_record_manager->GetRecord(page_id, i, fetched_rec_data);
-            if (status == Status::OK) {
-                std::cout << "    Page " << page_id << ", Slot " << i << ": ";
-                bool first_field = true;
-                for (const auto& field : fetched_rec_data.fields) {
-                    if (!first_field) std::cout << ", ";
-                    std::cout << field;
-                    first_field = false;
-                }
-                std::cout << std::endl;
-                total_records_found++;
-            } else if (status == Status::NOT_FOUND) {
-                // std::cout << "    Page " << page_id << ", Slot " << i << ": [Vacío]" << std::endl;
-            } else {
-                std::cerr << "    Error al leer Page " << page_id << ", Slot " << i << ": " << StatusToString(status) << std::endl;
-            }
+    CursorRegistros cursor;
+    Status open_status = g_record_manager->AbrirCursor(table_name, cursor);
+    if (open_status != Status::OK) {
+        std::cerr << "Error al abrir el recorrido de la tabla '" << table_name << "': " << StatusToString(open_status) << std::endl;
+        return;
+    }
+    RecordId record_id;
+    VistaRegistro view;
+    while (cursor.Siguiente(record_id, view)) { // Una sola página anclada a la vez
+        std::cout << "    Page " << PaginaDeRecordId(record_id) << ", Slot " << SlotDeRecordId(record_id) << ": ";
+        for (uint32_t i = 0; i < view.NumeroColumnas(); ++i) {
+            if (i > 0) std::cout << ", ";
+            std::cout << view.ObtenerComoTexto(i);
         }
+        std::cout << std::endl;
+        total_records_found++;
     }
     std::cout << "Total de registros encontrados en la tabla '" << table_name << "': " << total_records_found << std::endl;
 }
@@ -1224,83 +1503,142 @@ void DeleteTable() {
 // --- Funciones de Integración con Módulo de Audio ---
 
 /**
- * Función para ejecutar el módulo de procesamiento de audio
- * Permite grabar audio y generar consulta SQL automáticamente
+ * Obtiene las muestras de la grabación en memoria: con PortAudio se graba aquí
+ * mismo; sin él se usa grabadora_audio.exe y se lee el WAV que deja.
+ */
+bool CapturarAudioVoz(std::vector<int16_t>& muestras, uint32_t& frecuencia, uint16_t& canales) {
+#ifdef SGBD_CON_PORTAUDIO
+    frecuencia = SAMPLE_RATE;
+    canales = NUM_CHANNELS;
+    return recordFromMicrophone(muestras) && !muestras.empty();
+#else
+    std::cout << "Ejecutando: src/audio_processor/grabadora_audio.exe" << std::endl;
+    if (system("cd src/audio_processor && grabadora_audio.exe") != 0) {
+        std::cout << "Error: Fallo al ejecutar la grabadora de audio." << std::endl;
+        std::cout << "Verifique que el archivo grabadora_audio.exe existe en src/audio_processor/" << std::endl;
+        return false;
+    }
+    Status status = ClienteVoz::LeerWAV("src/audio_processor/grabacion.wav", muestras, frecuencia, canales);
+    if (status != Status::OK) {
+        std::cerr << "Error al leer la grabación: " << StatusToString(status) << std::endl;
+        return false;
+    }
+    return !muestras.empty();
+#endif
+}
+
+/**
+ * Pregunta al usuario por cada palabra que no es una tabla o columna válida
+ * y devuelve las correcciones elegidas (original, elegida).
+ */
+std::vector<std::pair<std::string, std::string>> ElegirCorreccionesVoz(const std::vector<RevisionVoz>& revisiones) {
+    std::vector<std::pair<std::string, std::string>> correcciones;
+    if (revisiones.empty()) {
+        return correcciones;
+    }
+    std::cout << "\n⚠️ Se encontraron posibles inconsistencias con las tablas/columnas válidas." << std::endl;
+    for (const auto& revision : revisiones) {
+        std::vector<std::string> opciones = {revision.original};
+        opciones.insert(opciones.end(), revision.sugerencias.begin(), revision.sugerencias.end());
+        std::cout << "\nLa palabra '" << revision.original << "' no parece ser una tabla o columna válida." << std::endl;
+        std::cout << "Posibles traducciones o correcciones:" << std::endl;
+        for (size_t i = 0; i < opciones.size(); ++i) {
+            std::cout << "  " << (i + 1) << ". " << opciones[i] << std::endl;
+        }
+        int seleccion = 0;
+        while (seleccion < 1 || seleccion > static_cast<int>(opciones.size())) {
+            seleccion = GetNumericInput<int>("Elija la opción correcta (1-" + std::to_string(opciones.size()) + "): ");
+        }
+        correcciones.emplace_back(revision.original, opciones[seleccion - 1]);
+    }
+    return correcciones;
+}
+
+/**
+ * Función para ejecutar el módulo de procesamiento de audio.
+ * Graba el comando de voz y lo envía en memoria al servicio de voz (servicio_voz.py),
+ * que mantiene cargados Whisper y el vocabulario entre consultas; la SQL vuelve por
+ * el mismo socket y puede ejecutarse directamente.
  */
 void EjecutarModuloAudio() {
     std::cout << "\n=== MÓDULO DE PROCESAMIENTO DE AUDIO ===" << std::endl;
     std::cout << "Este módulo permite convertir comandos de voz en consultas SQL." << std::endl;
     std::cout << "\nPasos del proceso:" << std::endl;
     std::cout << "1. Grabar audio con comando de voz" << std::endl;
-    std::cout << "2. Transcribir audio a texto" << std::endl;
-    std::cout << "3. Compilar texto natural a consulta SQL" << std::endl;
-    std::cout << "4. Generar archivo consulta_para_gestor.txt" << std::endl;
+    std::cout << "2. Transcribir audio a texto (servicio de voz)" << std::endl;
+    std::cout << "3. Compilar texto natural a consulta SQL (servicio de voz)" << std::endl;
+    std::cout << "4. Ejecutar la consulta en el procesador de consultas" << std::endl;
     
     std::string confirmacion = GetStringInput("\n¿Desea ejecutar el módulo de audio? (s/n): ");
     if (confirmacion != "s" && confirmacion != "S" && confirmacion != "si" && confirmacion != "SI") {
         std::cout << "Operación cancelada." << std::endl;
         return;
     }
-    
-    std::cout << "\n--- Ejecutando Grabadora de Audio ---" << std::endl;
-    std::cout << "Ejecutando: src/audio_processor/grabadora_audio.exe" << std::endl;
-    
-    // Cambiar al directorio del módulo de audio
-    std::string comando_grabadora = "cd src/audio_processor && grabadora_audio.exe";
-    int resultado_grabadora = system(comando_grabadora.c_str());
-    
-    if (resultado_grabadora != 0) {
-        std::cout << "Error: Fallo al ejecutar la grabadora de audio." << std::endl;
-        std::cout << "Verifique que el archivo grabadora_audio.exe existe en src/audio_processor/" << std::endl;
+
+    // Conectar antes de grabar: si hay que lanzar el servicio, Whisper carga mientras se habla
+    if (!g_cliente_voz) {
+        g_cliente_voz = std::make_unique<ClienteVoz>();
+    }
+    Status status = g_cliente_voz->Conectar();
+    if (status != Status::OK) {
+        std::cout << "Error: No se pudo conectar con el servicio de voz." << std::endl;
+        std::cout << "Verifique que Python está instalado y servicio_voz.py existe en src/audio_processor/" << std::endl;
         return;
     }
-    
-    std::cout << "\n--- Ejecutando Transcripción de Audio ---" << std::endl;
-    std::cout << "Ejecutando: python transcribir_audio.py" << std::endl;
-    
-    std::string comando_transcripcion = "cd src/audio_processor && python transcribir_audio.py";
-    int resultado_transcripcion = system(comando_transcripcion.c_str());
-    
-    if (resultado_transcripcion != 0) {
-        std::cout << "Error: Fallo al ejecutar la transcripción de audio." << std::endl;
-        std::cout << "Verifique que Python está instalado y transcribir_audio.py existe." << std::endl;
+
+    std::cout << "\n--- Grabando Audio ---" << std::endl;
+    std::vector<int16_t> muestras;
+    uint32_t frecuencia = 0;
+    uint16_t canales = 0;
+    if (!CapturarAudioVoz(muestras, frecuencia, canales)) {
+        std::cout << "No se capturó audio." << std::endl;
         return;
     }
-    
-    std::cout << "\n--- Ejecutando Compilador de Lenguaje Natural a SQL ---" << std::endl;
-    std::cout << "Ejecutando: python compilador.py" << std::endl;
-    
-    std::string comando_compilador = "cd src/audio_processor && python compilador.py";
-    int resultado_compilador = system(comando_compilador.c_str());
-    
-    if (resultado_compilador != 0) {
-        std::cout << "Error: Fallo al ejecutar el compilador de consultas." << std::endl;
-        std::cout << "Verifique que compilador.py existe y está funcionando correctamente." << std::endl;
+
+    std::cout << "\n--- Transcribiendo y Compilando ---" << std::endl;
+    auto inicio = std::chrono::steady_clock::now();
+    RespuestaVoz respuesta;
+    status = g_cliente_voz->TranscribirYCompilar(muestras, frecuencia, canales, respuesta);
+    if (status != Status::OK) {
+        std::cerr << "Error en el servicio de voz: "
+                  << (respuesta.mensaje.empty() ? StatusToString(status) : respuesta.mensaje) << std::endl;
         return;
     }
-    
-    std::cout << "\n=== PROCESAMIENTO DE AUDIO COMPLETADO ===" << std::endl;
-    std::cout << "La consulta SQL ha sido generada en: src/audio_processor/consulta_para_gestor.txt" << std::endl;
-    std::cout << "Ahora puede usar la opción 'Procesador de Consultas' para ejecutar la consulta." << std::endl;
-    
-    // Mostrar el contenido generado
-    std::ifstream archivo_generado("src/audio_processor/consulta_para_gestor.txt");
-    if (archivo_generado.is_open()) {
-        std::string consulta_generada;
-        std::getline(archivo_generado, consulta_generada);
-        archivo_generado.close();
-        
-        if (!consulta_generada.empty()) {
-            std::cout << "\n--- Consulta SQL Generada ---" << std::endl;
-            std::cout << "Consulta: " << consulta_generada << std::endl;
-            
-            std::string ejecutar_ahora = GetStringInput("\n¿Desea ejecutar esta consulta ahora? (s/n): ");
-            if (ejecutar_ahora == "s" || ejecutar_ahora == "S" || ejecutar_ahora == "si" || ejecutar_ahora == "SI") {
-                std::cout << "\nRedirigiendo al procesador de consultas..." << std::endl;
-                HandleQueryProcessor();
-            }
+    g_ultima_transcripcion_voz = respuesta.transcripcion;
+    std::cout << "Transcripción: " << respuesta.transcripcion << std::endl;
+    if (respuesta.sql.empty()) {
+        std::cout << "No se reconoció ningún comando en la grabación." << std::endl;
+        return;
+    }
+
+    auto correcciones = ElegirCorreccionesVoz(respuesta.revisiones);
+    if (!correcciones.empty()) {
+        std::string transcripcion = respuesta.transcripcion;
+        status = g_cliente_voz->Compilar(transcripcion, correcciones, respuesta);
+        if (status != Status::OK) {
+            std::cerr << "Error al aplicar las correcciones: " << respuesta.mensaje << std::endl;
+            return;
         }
     }
+    auto duracion_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - inicio).count();
+
+    std::cout << "\n=== PROCESAMIENTO DE AUDIO COMPLETADO (" << duracion_ms << " ms) ===" << std::endl;
+    std::cout << "Consulta: " << respuesta.sql << std::endl;
+
+    // Se conserva para la opción 2 de ObtenerConsultaSQL()
+    std::ofstream archivo_generado("src/audio_processor/consulta_para_gestor.txt");
+    if (archivo_generado.is_open()) {
+        archivo_generado << respuesta.sql;
+    }
+
+    if (respuesta.sql.rfind("--", 0) == 0) {
+        return; // El compilador no pudo generar una sentencia
+    }
+    std::string ejecutar_ahora = GetStringInput("\n¿Desea ejecutar esta consulta ahora? (s/n): ");
+    if (ejecutar_ahora == "s" || ejecutar_ahora == "S" || ejecutar_ahora == "si" || ejecutar_ahora == "SI") {
+        HandleQueryProcessor(respuesta.sql);
+    }
 }
 
 /**
@@ -1312,6 +1650,7 @@ void MostrarEstadoModuloAudio() {
     // Verificar archivos del módulo
     std::vector<std::pair<std::string, std::string>> archivos_modulo = {
         {"src/audio_processor/grabadora_audio.exe", "Grabadora de Audio"},
+        {"src/audio_processor/servicio_voz.py", "Servicio de Voz a SQL"},
         {"src/audio_processor/transcribir_audio.py", "Transcriptor de Audio"},
         {"src/audio_processor/compilador.py", "Compilador SQL"},
         {"src/audio_processor/voz.cpp", "Interfaz C++ Audio"},
@@ -1328,10 +1667,23 @@ void MostrarEstadoModuloAudio() {
         verificar.close();
     }
     
+    // Estado del servicio de voz (sin lanzarlo si no está en marcha)
+    OpcionesServicioVoz opciones;
+    opciones.arrancar_si_no_responde = false;
+    ClienteVoz sonda(opciones);
+    std::string mensaje;
+    if (sonda.Ping(mensaje) == Status::OK) {
+        std::cout << "\nServicio de voz: ✓ En marcha (" << mensaje << ")" << std::endl;
+    } else {
+        std::cout << "\nServicio de voz: ✗ Detenido (se inicia con la primera consulta de voz)" << std::endl;
+    }
+
     // Mostrar contenido de archivos de salida si existen
     std::cout << "\n--- Última Transcripción ---" << std::endl;
     std::ifstream transcripcion("src/audio_processor/transcripcion.txt");
-    if (transcripcion.is_open()) {
+    if (!g_ultima_transcripcion_voz.empty()) {
+        std::cout << g_ultima_transcripcion_voz << std::endl; // Del servicio de voz, en esta sesión
+    } else if (transcripcion.is_open()) {
         std::string contenido;
         std::getline(transcripcion, contenido);
         std::cout << (contenido.empty() ? "(vacío)" : contenido) << std::endl;
@@ -1425,6 +1777,7 @@ std::string ObtenerConsultaSQL() {
             std::cout << "Ejemplos de consultas soportadas:" << std::endl;
             std::cout << "  SELECT nombre,edad FROM clientes WHERE id = 5" << std::endl;
             std::cout << "  SELECT * FROM clientes" << std::endl;
+            std::cout << "  SELECT COUNT(*), AVG(edad) FROM clientes WHERE edad > 18" << std::endl;
             std::cout << "  INSERT INTO clientes VALUES (1,'Juan Perez',30)" << std::endl;
             std::cout << "  UPDATE clientes SET Edad = 31 WHERE Nombre = 'Juan Perez'" << std::endl;
             std::cout << "  DELETE FROM clientes WHERE ID = 1" << std::endl;
@@ -1592,7 +1945,8 @@ void CrearIndicesAutomaticosPorTablaMenu() {
     std::cin >> confirmacion;
     
     if (confirmacion == 's' || confirmacion == 'S') {
-        Status status = g_gestor_indices->CrearIndicesAutomaticosPorTabla(tabla, columnas);
+        // Un solo recorrido de la tabla; los árboles se empaquetan de abajo arriba
+        Status status = g_record_manager->ConstruirIndicesTabla(tabla, columnas, OpcionesConstruccionMasiva());
         if (status == Status::OK) {
             std::cout << "\n✅ ¡Creación masiva completada exitosamente!" << std::endl;
         } else {
@@ -1782,10 +2136,11 @@ void HandleBufferPoolManagement() {
             case 3: ViewBufferPoolTable(); break;
             case 4: std::cout << "Funcionalidad no implementada aún." << std::endl; break;
             case 5: std::cout << "Funcionalidad no implementada aún." << std::endl; break;
-            case 6: std::cout << "Volviendo al Menú Principal." << std::endl; break;
+            case 6: ExportMetrics(); break;
+            case 7: std::cout << "Volviendo al Menú Principal." << std::endl; break;
             default: std::cout << "Opción inválida. Intente de nuevo." << std::endl; break;
         }
-    } while (choice != 6); // Cambiado a 6
+    } while (choice != 7);
 }
 
 void HandleDataManagement() {
@@ -1925,398 +2280,446 @@ void HandleIndexManagement() {
     } while (choice != 10);
 }
 
-void HandleQueryProcessor() {
-    if (!g_record_manager || !g_catalog_manager || !g_index_manager) {
-        std::cout << "Managers no inicializados. Cargue o cree un disco primero." << std::endl;
-        return;
-    }
-    
-    std::cout << "\n=== PROCESADOR DE CONSULTAS SQL ===" << std::endl;
-    std::cout << "Soporta entrada manual y desde archivos de audio." << std::endl;
-    
-    // Usar la nueva función de entrada dual
-    std::string query = ObtenerConsultaSQL();
-    
-    if (query.empty()) {
-        std::cout << "Error: No se obtuvo ninguna consulta válida." << std::endl;
-        return;
-    }
-    
-    std::cout << "\n--- Procesando Consulta ---" << std::endl;
-    std::cout << "Consulta a ejecutar: " << query << std::endl;
-    std::smatch match;
+// --- Procesador de consultas ---
+// Cada sentencia se analiza a un SentenciaSQL (query_processor/analizador_sql.h) y se
+// ejecuta desde el plan. Las sentencias que solo cambian en sus literales reutilizan
+// el plan de la caché, y PREPARE/EXECUTE guardan planes con parámetros '?' por nombre.
+CacheSentencias g_statement_cache;
+std::unordered_map<std::string, SentenciaPreparada> g_prepared_statements;
 
-    // --- INSERT ---
-    std::regex insert_regex(R"(INSERT\s+INTO\s+(\w+)\s+VALUES\s*\(([^\)]*)\))", std::regex::icase);
-    if (std::regex_match(query, match, insert_regex)) {
-        std::string table_name = match[1];
-        std::string values_str = match[2];
-        
-        FullTableSchema schema;
-        if (g_catalog_manager->GetTableSchema(table_name, schema) != Status::OK) {
-            std::cout << "Error: Tabla '" << table_name << "' no encontrada." << std::endl;
-            return;
-        }
+Status ExecuteInsert(const SentenciaSQL& stmt) {
+    const std::string& table_name = stmt.tabla;
+    std::shared_ptr<MetadataTabla> table = g_catalog_manager->ObtenerMetadataTabla(table_name);
+    if (!table) {
+        std::cout << "Error: Tabla '" << table_name << "' no encontrada." << std::endl;
+        return Status::NOT_FOUND;
+    }
 
-        RecordData new_record_data = PrepareRecordData(values_str, schema);
-        if (new_record_data.fields.empty() && !values_str.empty()) {
-            std::cerr << "Fallo al preparar los datos del registro para la inserción. Consulta cancelada." << std::endl;
-            return;
-        }
+    // Los valores ya vienen separados y sin comillas: una coma dentro de una cadena no los parte
+    DatosRegistro new_record_data;
+    std::string error_msg;
+    if (!ValidateAndConvertValues(stmt.valores, table->ObtenerEsquema(), new_record_data.campos, error_msg)) {
+        std::cerr << "Error de validación de datos: " << error_msg << std::endl;
+        std::cerr << "Fallo al preparar los datos del registro para la inserción. Consulta cancelada." << std::endl;
+        return Status::INVALID_ARGUMENT;
+    }
 
-        uint32_t slot_id;
-        PageId target_page_id = 0;
-        Status status = Status::ERROR;
+    // GestorRegistros elige la página con el mapa de espacio libre, registra el cambio
+    // en el WAL, mantiene los índices, actualiza el número de registros de la tabla e
+    // informa de la página y el RecordId
+    Status status = g_record_manager->InsertarRegistro(table_name, new_record_data);
+    if (status != Status::OK) {
+        std::cerr << "Error al insertar registro: " << StatusToString(status) << std::endl;
+    }
+    return status;
+}
 
-        for (PageId page_id : schema.base_metadata.data_page_ids) {
-            BlockSizeType free_space;
-            Status get_space_status = g_record_manager->GetFreeSpace(page_id, free_space);
-            // Estimación del tamaño del registro serializado para verificar espacio
-            size_t estimated_record_size = new_record_data.fields.size() * 10 + sizeof(SlotDirectoryEntry); // Estimación simple
-            if (get_space_status == Status::OK && free_space >= estimated_record_size) {
-                status = g_record_manager->InsertRecord(page_id, new_record_data, slot_id);
-                if (status == Status::OK) {
-                    target_page_id = page_id;
-                    break;
-                }
-            }
+// SELECT con agregados y sin GROUP BY: una sola fila de resultados.
+// Si un índice reduce los candidatos se acumula sobre su cursor; si no, la tabla se
+// reparte entre los hilos de recorrido y cada uno acumula sus propios parciales.
+Status ExecuteAggregateSelect(const SentenciaSQL& stmt, const FullTableSchema& schema,
+                              std::shared_ptr<const FiltroCompilado> filter) {
+    const std::string& table_name = stmt.tabla;
+    std::vector<AgregadoParcial> results;
+    AccessPath path = ChooseAccessPath(table_name, schema, stmt.condiciones);
+    if (path.kind == AccessPathKind::FULL_SCAN) {
+        EstadisticasEscaneoParalelo scan_stats;
+        Status status = g_record_manager->AgregarEnParalelo(table_name, std::move(filter), stmt.agregados, results, &scan_stats);
+        if (status != Status::OK) {
+            return status;
         }
-        
-        if (status != Status::OK) { // Si no se encontró espacio en ninguna página existente
-            PageId new_data_page_id;
-            Byte* new_page_data = g_buffer_manager->NewPage(new_data_page_id, PageType::DATA_PAGE);
-            if (new_page_data == nullptr) {
-                std::cerr << "Error: Fallo al crear una nueva página de datos para la tabla." << std::endl;
-                return;
-            }
-            Status init_status = g_record_manager->InitDataPage(new_data_page_id);
-            if (init_status != Status::OK) {
-                std::cerr << "Error: Fallo al inicializar la nueva página de datos." << std::endl;
-                g_buffer_manager->DeletePage(new_data_page_id);
-                return;
-            }
-            Status add_page_status = g_catalog_manager->AddDataPageToTable(table_name, new_data_page_id);
-            if (add_page_status != Status::OK) {
-                std::cerr << "Error: Fallo al añadir la nueva página al catálogo de la tabla." << std::endl;
-                return;
-            }
-            status = g_record_manager->InsertRecord(new_data_page_id, new_record_data, slot_id);
-            if (status == Status::OK) {
-                target_page_id = new_data_page_id;
+        std::cout << "Plan: recorrido paralelo (" << scan_stats.trabajadores << " hilos, " << scan_stats.morsels
+                  << " morsels, " << scan_stats.morsels_robados << " robados, "
+                  << scan_stats.registros_examinados << " registros examinados)" << std::endl;
+    } else {
+        std::cout << "Plan: " << DescribeAccessPath(path, schema.base_metadata.num_records) << std::endl;
+        Status status = EscaneoParalelo::PrepararAgregados(schema.columns, stmt.agregados, results);
+        if (status != Status::OK) {
+            return status;
+        }
+        CursorRegistros cursor;
+        if (g_record_manager->AbrirCursorPorIds(table_name, std::move(path.record_ids), cursor, std::move(filter)) != Status::OK) {
+            std::cerr << "Error al abrir el recorrido de la tabla '" << table_name << "'." << std::endl;
+            return Status::ERROR;
+        }
+        RecordId record_id;
+        VistaRegistro view;
+        while (cursor.Siguiente(record_id, view)) {
+            for (AgregadoParcial& result : results) {
+                result.Acumular(view);
             }
         }
+    }
 
-        if (status == Status::OK) {
-            std::cout << "Registro insertado exitosamente en Page " << target_page_id << ", Slot " << slot_id << "." << std::endl;
-            schema.base_metadata.num_records++;
-            g_catalog_manager->UpdateTableNumRecords(table_name, schema.base_metadata.num_records);
-        } else {
-            std::cerr << "Error al insertar registro: " << StatusToString(status) << std::endl;
-        }
-        return;
+    for (const EspecificacionAgregado& aggregate : stmt.agregados) {
+        std::cout << std::left << std::setw(18) << AgregadoParcial::Etiqueta(aggregate);
+    }
+    std::cout << std::endl << std::string(18 * stmt.agregados.size(), '-') << std::endl;
+    for (const AgregadoParcial& result : results) {
+        std::cout << std::left << std::setw(18) << result.ComoTexto();
     }
+    std::cout << std::endl;
+    return Status::OK;
+}
 
-    // --- SELECT multi-condición ---
-    std::regex select_regex(R"(SELECT\s+([\w\*, ]+)\s+FROM\s+(\w+)(?:\s+WHERE\s+(.+))?)", std::regex::icase);
-    if (std::regex_match(query, match, select_regex)) {
-        std::string select_cols_str = match[1];
-        std::string table_name = match[2];
-        std::string where_str;
-        bool has_where = false;
-        if (match.size() > 3 && match[3].matched) {
-            where_str = match[3];
-            has_where = true;
-        }
+Status ExecuteSelect(const SentenciaSQL& stmt) {
+    const std::string& table_name = stmt.tabla;
+    FullTableSchema schema;
+    if (g_catalog_manager->GetTableSchema(table_name, schema) != Status::OK) {
+        std::cout << "Error: Tabla '" << table_name << "' no encontrada." << std::endl;
+        return Status::NOT_FOUND;
+    }
 
-        FullTableSchema schema;
-        if (g_catalog_manager->GetTableSchema(table_name, schema) != Status::OK) {
-            std::cout << "Error: Tabla '" << table_name << "' no encontrada." << std::endl;
-            return;
+    if (!stmt.agregados.empty()) {
+        std::shared_ptr<const FiltroCompilado> filter;
+        if (!BuildWhereFilter(schema, stmt.condiciones, filter)) {
+            return Status::INVALID_ARGUMENT;
         }
+        return ExecuteAggregateSelect(stmt, schema, std::move(filter));
+    }
 
-        std::vector<int> select_idxs;
-        if (select_cols_str == "*" || select_cols_str == " *") {
-            for (size_t i = 0; i < schema.columns.size(); ++i) select_idxs.push_back(i);
-        } else {
-            std::stringstream ss(select_cols_str);
-            std::string col_name;
-            while (std::getline(ss, col_name, ',')) {
-                col_name.erase(std::remove_if(col_name.begin(), col_name.end(), ::isspace), col_name.end());
-                bool found = false;
-                for (size_t i = 0; i < schema.columns.size(); ++i) {
-                    // Comparar sin distinción de mayúsculas y minúsculas
-                    std::string schema_col_name(schema.columns[i].name);
-                    std::transform(schema_col_name.begin(), schema_col_name.end(), schema_col_name.begin(), ::tolower);
-                    std::transform(col_name.begin(), col_name.end(), col_name.begin(), ::tolower);
-                    if (col_name == schema_col_name) {
-                        select_idxs.push_back(i);
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    std::cerr << "Advertencia: Columna '" << col_name << "' no encontrada en el esquema de la tabla '" << table_name << "'." << std::endl;
-                }
+    std::vector<int> select_idxs;
+    if (stmt.columnas.empty()) {
+        for (size_t i = 0; i < schema.columns.size(); ++i) select_idxs.push_back(i);
+    } else {
+        for (const std::string& col_name : stmt.columnas) {
+            int idx = FindColumnIndex(schema, col_name); // Sin distinción de mayúsculas y minúsculas
+            if (idx == -1) {
+                std::cerr << "Advertencia: Columna '" << col_name << "' no encontrada en el esquema de la tabla '" << table_name << "'." << std::endl;
+                continue;
             }
+            select_idxs.push_back(idx);
         }
+    }
 
-        std::vector<Condition> conds;
-        if (has_where) {
-            conds = ParseWhereConditions(where_str);
-        }
-
-        // Imprimir cabecera de la tabla de resultados
-        for (int idx : select_idxs) {
-            std::cout << std::left << std::setw(15) << schema.columns[idx].name;
-        }
-        std::cout << std::endl;
-        for (int idx : select_idxs) {
-            std::cout << std::string(15, '-');
-        }
-        std::cout << std::endl;
+    std::shared_ptr<const FiltroCompilado> filter;
+    if (!BuildWhereFilter(schema, stmt.condiciones, filter)) {
+        return Status::INVALID_ARGUMENT;
+    }
 
-        uint32_t records_displayed = 0;
-        for (PageId page_id : schema.base_metadata.data_page_ids) {
-            uint32_t num_slots;
-            Byte* page_data_peek = g_buffer_manager->FetchPage(page_id);
-            if (page_data_peek == nullptr) {
-                std::cerr << "Advertencia: No se pudo obtener la página " << page_id << ". Saltando." << std::endl;
-                continue;
-            }
-            BlockHeader header_peek = g_record_manager->ReadBlockHeader(page_data_peek);
-            num_slots = header_peek.num_slots;
-            g_buffer_manager->UnpinPage(page_id, false);
-
-            for (uint32_t slot = 0; slot < num_slots; ++slot) {
-                RecordData rec_data;
-                Status get_rec_status = g_record_manager->GetRecord(page_id, slot, rec_data);
-                if (get_rec_status == Status::OK) {
-                    bool match = true;
-                    if (has_where) {
-                        for (const auto& cond : conds) {
-                            int col_idx = -1;
-                            for (size_t i = 0; i < schema.columns.size(); ++i) {
-                                std::string schema_col_name(schema.columns[i].name);
-                                std::transform(schema_col_name.begin(), schema_col_name.end(), schema_col_name.begin(), ::tolower);
-                                if (cond.col == schema_col_name) { // Cond.col ya está en minúsculas
-                                    col_idx = i;
-                                    break;
-                                }
-                            }
-                            if (col_idx == -1 || col_idx >= rec_data.fields.size()) {
-                                match = false; // Columna de condición no encontrada o fuera de límites
-                                break;
-                            }
-                            // Comparar el valor del registro con el valor de la condición
-                            // Se asume que los valores en rec_data.fields ya están en el formato correcto
-                            // y que cond.val también está preparado (ej. sin comillas).
-                            if (rec_data.fields[col_idx] != cond.val) {
-                                match = false;
-                                break;
-                            }
-                        }
-                    }
+    // Imprimir cabecera de la tabla de resultados
+    for (int idx : select_idxs) {
+        std::cout << std::left << std::setw(15) << schema.columns[idx].name;
+    }
+    std::cout << std::endl;
+    for (size_t i = 0; i < select_idxs.size(); ++i) {
+        std::cout << std::string(15, '-');
+    }
+    std::cout << std::endl;
 
-                    if (match) {
-                        for (int idx : select_idxs) {
-                            if (idx < rec_data.fields.size()) {
-                                std::cout << std::left << std::setw(15) << rec_data.fields[idx];
-                            } else {
-                                std::cout << std::left << std::setw(15) << "N/A";
-                            }
-                        }
-                        std::cout << std::endl;
-                        records_displayed++;
-                    }
-                }
+    uint32_t records_displayed = 0;
+    CursorRegistros cursor;
+    if (!OpenQueryCursor(table_name, schema, stmt.condiciones, filter, cursor)) {
+        return Status::ERROR;
+    }
+    RecordId record_id;
+    VistaRegistro view;
+    while (cursor.Siguiente(record_id, view)) { // Solo llegan los registros que cumplen el WHERE
+        for (int idx : select_idxs) {
+            if (static_cast<uint32_t>(idx) < view.NumeroColumnas()) {
+                std::cout << std::left << std::setw(15) << view.ObtenerComoTexto(idx);
+            } else {
+                std::cout << std::left << std::setw(15) << "N/A";
             }
         }
-        std::cout << "\nTotal de registros seleccionados: " << records_displayed << std::endl;
-        return;
+        std::cout << std::endl;
+        records_displayed++;
     }
+    std::cout << "\nTotal de registros seleccionados: " << records_displayed << std::endl;
+    return Status::OK;
+}
 
-    // --- UPDATE multi-condición y actualización de índices ---
-    std::regex update_regex(R"(UPDATE\s+(\w+)\s+SET\s+([\w]+)\s*=\s*('?[^']+'?)\s+WHERE\s+(.+))", std::regex::icase); // Regex mejorada para set_val
-    if (std::regex_match(query, match, update_regex)) {
-        std::string table_name = match[1];
-        std::string set_col_name = match[2];
-        std::string set_val_str = match[3];
-        std::string where_str = match[4];
+Status ExecuteUpdate(const SentenciaSQL& stmt) {
+    const std::string& table_name = stmt.tabla;
+    FullTableSchema schema;
+    if (g_catalog_manager->GetTableSchema(table_name, schema) != Status::OK) {
+        std::cout << "Error: Tabla '" << table_name << "' no encontrada." << std::endl;
+        return Status::NOT_FOUND;
+    }
 
-        // Eliminar comillas de set_val_str si existen
-        if (set_val_str.length() >= 2 && set_val_str.front() == '\'' && set_val_str.back() == '\'') {
-            set_val_str = set_val_str.substr(1, set_val_str.length() - 2);
+    // Validar y convertir los valores SET una vez para todos los registros
+    std::vector<std::pair<int, std::string>> assignments;
+    for (const auto& assignment : stmt.asignaciones) {
+        int set_col_idx = FindColumnIndex(schema, assignment.first);
+        if (set_col_idx == -1) {
+            std::cout << "Error: Columna '" << assignment.first << "' no encontrada en la tabla '" << table_name << "'." << std::endl;
+            return Status::NOT_FOUND;
+        }
+        std::vector<std::string> temp_values = {assignment.second};
+        std::vector<ColumnMetadata> temp_cols = {schema.columns[set_col_idx]};
+        std::vector<std::string> validated_set_val;
+        std::string error_msg;
+        if (!ValidateAndConvertValues(temp_values, temp_cols, validated_set_val, error_msg)) {
+            std::cerr << "Error de validación para el valor SET: " << error_msg << "." << std::endl;
+            return Status::INVALID_ARGUMENT;
+        }
+        assignments.push_back({set_col_idx, validated_set_val[0]});
+    }
+
+    std::shared_ptr<const FiltroCompilado> filter;
+    if (!BuildWhereFilter(schema, stmt.condiciones, filter)) {
+        return Status::INVALID_ARGUMENT;
+    }
+    CursorRegistros cursor;
+    if (!OpenQueryCursor(table_name, schema, stmt.condiciones, filter, cursor)) {
+        return Status::ERROR;
+    }
+    uint32_t records_updated = 0;
+    RecordId record_id;
+    VistaRegistro view;
+    while (cursor.Siguiente(record_id, view)) {
+        DatosRegistro new_rec_data; // Copiar datos existentes
+        for (uint32_t i = 0; i < view.NumeroColumnas(); ++i) {
+            new_rec_data.campos.push_back(view.ObtenerComoTexto(i));
+        }
+        for (const auto& assignment : assignments) {
+            new_rec_data.campos[assignment.first] = assignment.second; // Asignar el valor validado
+        }
+
+        // El RecordId no cambia al actualizar, así que el cursor sigue en su sitio; si va
+        // por índice, los candidatos se obtuvieron antes de empezar a modificar
+        Status update_status = g_record_manager->ActualizarRegistro(table_name, record_id, new_rec_data);
+        if (update_status == Status::OK) {
+            std::cout << "Registro actualizado en Page " << PaginaDeRecordId(record_id) << ", Slot " << SlotDeRecordId(record_id) << "." << std::endl;
+            records_updated++;
+        } else {
+            std::cerr << "Error al actualizar registro en Page " << PaginaDeRecordId(record_id) << ", Slot " << SlotDeRecordId(record_id) << ": " << StatusToString(update_status) << std::endl;
         }
+    }
+    std::cout << "\nTotal de registros actualizados: " << records_updated << std::endl;
+    return Status::OK;
+}
 
-        FullTableSchema schema;
-        if (g_catalog_manager->GetTableSchema(table_name, schema) != Status::OK) {
-            std::cout << "Error: Tabla '" << table_name << "' no encontrada." << std::endl;
-            return;
+Status ExecuteDelete(const SentenciaSQL& stmt) {
+    const std::string& table_name = stmt.tabla;
+    FullTableSchema schema;
+    if (g_catalog_manager->GetTableSchema(table_name, schema) != Status::OK) {
+        std::cout << "Error: Tabla '" << table_name << "' no encontrada." << std::endl;
+        return Status::NOT_FOUND;
+    }
+
+    std::shared_ptr<const FiltroCompilado> filter;
+    if (!BuildWhereFilter(schema, stmt.condiciones, filter)) {
+        return Status::INVALID_ARGUMENT;
+    }
+    CursorRegistros cursor;
+    if (!OpenQueryCursor(table_name, schema, stmt.condiciones, filter, cursor)) {
+        return Status::ERROR;
+    }
+    // Eliminar libera el slot sin mover los demás: se puede borrar durante el recorrido.
+    // EliminarRegistroPorID ya actualiza el número de registros de la tabla.
+    uint32_t records_deleted = 0;
+    RecordId record_id;
+    VistaRegistro view;
+    while (cursor.Siguiente(record_id, view)) {
+        Status delete_status = g_record_manager->EliminarRegistroPorID(table_name, record_id);
+        if (delete_status == Status::OK) {
+            std::cout << "Registro eliminado en Page " << PaginaDeRecordId(record_id) << ", Slot " << SlotDeRecordId(record_id) << "." << std::endl;
+            records_deleted++;
+        } else {
+            std::cerr << "Error al eliminar registro en Page " << PaginaDeRecordId(record_id) << ", Slot " << SlotDeRecordId(record_id) << ": " << StatusToString(delete_status) << std::endl;
         }
+    }
+    std::cout << "\nTotal de registros eliminados: " << records_deleted << std::endl;
+    return Status::OK;
+}
 
-        int set_col_idx = -1;
-        for (size_t i = 0; i < schema.columns.size(); ++i) {
-            std::string schema_col_name(schema.columns[i].name);
-            std::transform(schema_col_name.begin(), schema_col_name.end(), schema_col_name.begin(), ::tolower);
-            std::string temp_set_col_name = set_col_name;
-            std::transform(temp_set_col_name.begin(), temp_set_col_name.end(), temp_set_col_name.begin(), ::tolower);
-            if (temp_set_col_name == schema_col_name) {
-                set_col_idx = i;
-                break;
+Status ExecuteStatement(const SentenciaSQL& stmt) {
+    // Latencia por tabla; un EXECUTE se mide en la llamada con la sentencia vinculada
+    MedidorLatencia medidor(OperacionMetrica::EJECUCION_SENTENCIA, PageType::INVALID_PAGE, &stmt.tabla);
+    if (stmt.tipo == TipoSentencia::PREPARE || stmt.tipo == TipoSentencia::EXECUTE) {
+        medidor.Cancelar();
+    }
+    switch (stmt.tipo) {
+        case TipoSentencia::INSERT: return ExecuteInsert(stmt);
+        case TipoSentencia::SELECT: return ExecuteSelect(stmt);
+        case TipoSentencia::UPDATE: return ExecuteUpdate(stmt);
+        case TipoSentencia::DELETE: return ExecuteDelete(stmt);
+        case TipoSentencia::PREPARE:
+            g_prepared_statements[stmt.nombre] = SentenciaPreparada(*stmt.cuerpo);
+            std::cout << "Sentencia '" << stmt.nombre << "' preparada (" << stmt.cuerpo->parametros.size() << " parámetros)." << std::endl;
+            return Status::OK;
+        case TipoSentencia::EXECUTE: {
+            auto prepared = g_prepared_statements.find(stmt.nombre);
+            if (prepared == g_prepared_statements.end()) {
+                std::cerr << "Error: No hay ninguna sentencia preparada llamada '" << stmt.nombre << "'." << std::endl;
+                return Status::NOT_FOUND;
             }
+            SentenciaSQL bound;
+            std::string error;
+            Status bind_status = prepared->second.Vincular(stmt.valores, bound, error);
+            if (bind_status != Status::OK) {
+                std::cerr << "Error en EXECUTE " << stmt.nombre << ": " << error << "." << std::endl;
+                return bind_status;
+            }
+            return ExecuteStatement(bound);
         }
-        if (set_col_idx == -1) {
-            std::cout << "Error: Columna '" << set_col_name << "' no encontrada en la tabla '" << table_name << "'." << std::endl;
-            return;
-        }
-
-        std::vector<Condition> conds = ParseWhereConditions(where_str);
-        uint32_t records_updated = 0;
+    }
+    return Status::ERROR;
+}
 
-        for (PageId page_id : schema.base_metadata.data_page_ids) {
-            uint32_t num_slots;
-            Byte* page_data_peek = g_buffer_manager->FetchPage(page_id);
-            if (page_data_peek == nullptr) {
-                std::cerr << "Advertencia: No se pudo obtener la página " << page_id << " para actualización. Saltando." << std::endl;
-                continue;
-            }
-            BlockHeader header_peek = g_record_manager->ReadBlockHeader(page_data_peek);
-            num_slots = header_peek.num_slots;
-            g_buffer_manager->UnpinPage(page_id, false);
-
-            for (uint32_t slot = 0; slot < num_slots; ++slot) {
-                RecordData old_rec_data;
-                Status get_rec_status = g_record_manager->GetRecord(page_id, slot, old_rec_data);
-                if (get_rec_status == Status::OK) {
-                    bool match = true;
-                    for (const auto& cond : conds) {
-                        int col_idx = -1;
-                        for (size_t i = 0; i < schema.columns.size(); ++i) {
-                            std::string schema_col_name(schema.columns[i].name);
-                            std::transform(schema_col_name.begin(), schema_col_name.end(), schema_col_name.begin(), ::tolower);
-                            if (cond.col == schema_col_name) {
-                                col_idx = i;
-                                break;
-                            }
-                        }
-                        if (col_idx == -1 || col_idx >= old_rec_data.fields.size() || old_rec_data.fields[col_idx] != cond.val) {
-                            match = false;
-                            break;
-                        }
-                    }
+Status ExecuteSQL(const std::string& query) {
+    SentenciaSQL stmt;
+    std::string error;
+    Status parse_status = g_statement_cache.Obtener(query, stmt, error);
+    if (parse_status != Status::OK) {
+        std::cout << "Consulta no reconocida o formato no soportado: " << error << "." << std::endl;
+        return parse_status;
+    }
+    return ExecuteStatement(stmt);
+}
 
-                    if (match) {
-                        RecordData new_rec_data = old_rec_data; // Copiar datos existentes
-                        // Validar y convertir el nuevo valor para la columna SET
-                        std::vector<std::string> temp_values = {set_val_str};
-                        std::vector<ColumnMetadata> temp_cols = {schema.columns[set_col_idx]};
-                        std::vector<std::string> validated_set_val;
-                        std::string error_msg;
-                        if (!ValidateAndConvertValues(temp_values, temp_cols, validated_set_val, error_msg)) {
-                            std::cerr << "Error de validación para el valor SET: " << error_msg << ". Saltando actualización." << std::endl;
-                            continue; // Saltar a la siguiente ranura
-                        }
-                        new_rec_data.fields[set_col_idx] = validated_set_val[0]; // Asignar el valor validado
-
-                        Status update_status = g_record_manager->UpdateRecord(page_id, slot, new_rec_data);
-                        if (update_status == Status::OK) {
-                            std::cout << "Registro actualizado en Page " << page_id << ", Slot " << slot << "." << std::endl;
-                            records_updated++;
-                        } else {
-                            std::cerr << "Error al actualizar registro en Page " << page_id << ", Slot " << slot << ": " << StatusToString(update_status) << std::endl;
-                        }
-                    }
-                }
-            }
-        }
-        std::cout << "\nTotal de registros actualizados: " << records_updated << std::endl;
+void HandleQueryProcessor() {
+    if (!g_record_manager || !g_catalog_manager || !g_index_manager) {
+        std::cout << "Managers no inicializados. Cargue o cree un disco primero." << std::endl;
         return;
     }
+    
+    std::cout << "\n=== PROCESADOR DE CONSULTAS SQL ===" << std::endl;
+    std::cout << "Soporta entrada manual y desde archivos de audio." << std::endl;
+    
+    // Usar la nueva función de entrada dual
+    std::string query = ObtenerConsultaSQL();
+    
+    if (query.empty()) {
+        std::cout << "Error: No se obtuvo ninguna consulta válida." << std::endl;
+        return;
+    }
+    
+    HandleQueryProcessor(query);
+}
 
-    // --- DELETE multi-condición y actualización de índices ---
-    std::regex delete_regex(R"(DELETE\s+FROM\s+(\w+)\s+WHERE\s+(.+))", std::regex::icase);
-    if (std::regex_match(query, match, delete_regex)) {
-        std::string table_name = match[1];
-        std::string where_str = match[2];
+// Ejecuta una consulta ya obtenida (p. ej. la SQL devuelta por el servicio de voz)
+void HandleQueryProcessor(const std::string& query) {
+    if (!g_record_manager || !g_catalog_manager || !g_index_manager) {
+        std::cout << "Managers no inicializados. Cargue o cree un disco primero." << std::endl;
+        return;
+    }
+    std::cout << "\n--- Procesando Consulta ---" << std::endl;
+    std::cout << "Consulta a ejecutar: " << query << std::endl;
+    ExecuteSQL(query);
+}
 
-        FullTableSchema schema;
-        if (g_catalog_manager->GetTableSchema(table_name, schema) != Status::OK) {
-            std::cout << "Error: Tabla '" << table_name << "' no encontrada." << std::endl;
-            return;
-        }
+// --- Modo lote ---
+// Lee sentencias separadas por ';' (fuera de comillas) de un archivo o de stdin y
+// las ejecuta sin pasar por el menú. Las líneas que empiezan por "--" son comentarios.
+bool IsBlank(const std::string& text) {
+    return text.find_first_not_of(" \t\r\n") == std::string::npos;
+}
 
-        std::vector<Condition> conds = ParseWhereConditions(where_str);
-        uint32_t records_deleted = 0;
-        
-        // Recopilar PageId y SlotId de los registros a eliminar
-        std::vector<std::pair<PageId, uint32_t>> records_to_delete;
-
-        for (PageId page_id : schema.base_metadata.data_page_ids) {
-            uint32_t num_slots;
-            Byte* page_data_peek = g_buffer_manager->FetchPage(page_id);
-            if (page_data_peek == nullptr) {
-                std::cerr << "Advertencia: No se pudo obtener la página " << page_id << " para eliminación. Saltando." << std::endl;
+bool ReadNextStatement(std::istream& input, std::string& statement) {
+    statement.clear();
+    char quote = '\0';
+    bool line_start = true; // Solo espacios desde el último salto de línea
+    char c;
+    while (input.get(c)) {
+        if (quote == '\0') {
+            if (line_start && c == '-' && input.peek() == '-') {
+                std::string comment;
+                std::getline(input, comment);
                 continue;
             }
-            BlockHeader header_peek = g_record_manager->ReadBlockHeader(page_data_peek);
-            num_slots = header_peek.num_slots;
-            g_buffer_manager->UnpinPage(page_id, false);
-
-            for (uint32_t slot = 0; slot < num_slots; ++slot) {
-                RecordData rec_data;
-                Status get_rec_status = g_record_manager->GetRecord(page_id, slot, rec_data);
-                if (get_rec_status == Status::OK) {
-                    bool match = true;
-                    for (const auto& cond : conds) {
-                        int col_idx = -1;
-                        for (size_t i = 0; i < schema.columns.size(); ++i) {
-                            std::string schema_col_name(schema.columns[i].name);
-                            std::transform(schema_col_name.begin(), schema_col_name.end(), schema_col_name.begin(), ::tolower);
-                            if (cond.col == schema_col_name) {
-                                col_idx = i;
-                                break;
-                            }
-                        }
-                        if (col_idx == -1 || col_idx >= rec_data.fields.size() || rec_data.fields[col_idx] != cond.val) {
-                            match = false;
-                            break;
-                        }
-                    }
-                    if (match) {
-                        records_to_delete.push_back({page_id, slot});
-                    }
-                }
+            if (c == '\n') {
+                line_start = true;
+                statement += ' ';
+                continue;
             }
-        }
-
-        // Ahora eliminar los registros y actualizar los contadores
-        for (const auto& rec_loc : records_to_delete) {
-            PageId page_id = rec_loc.first;
-            uint32_t slot = rec_loc.second;
-            Status delete_status = g_record_manager->DeleteRecord(page_id, slot);
-            if (delete_status == Status::OK) {
-                std::cout << "Registro eliminado en Page " << page_id << ", Slot " << slot << "." << std::endl;
-                records_deleted++;
-                // Actualizar num_records en TableMetadata.
-                if (schema.base_metadata.num_records > 0) {
-                    schema.base_metadata.num_records--;
-                    g_catalog_manager->UpdateTableNumRecords(table_name, schema.base_metadata.num_records);
+            if (c == ' ' || c == '\t' || c == '\r') {
+                statement += ' ';
+                continue;
+            }
+            line_start = false;
+            if (c == ';') {
+                if (IsBlank(statement)) {
+                    statement.clear();
+                    continue;
                 }
-            } else {
-                std::cerr << "Error al eliminar registro en Page " << page_id << ", Slot " << slot << ": " << StatusToString(delete_status) << std::endl;
+                return true;
+            }
+            if (c == '\'' || c == '"') {
+                quote = c;
             }
+        } else if (c == quote) {
+            quote = '\0'; // Una comilla duplicada cierra y vuelve a abrir: el resultado es el mismo
         }
-        std::cout << "\nTotal de registros eliminados: " << records_deleted << std::endl;
-        return;
+        statement += c;
     }
+    return !IsBlank(statement); // Última sentencia sin ';'
+}
 
-    std::cout << "Consulta no reconocida o formato no soportado." << std::endl;
+int RunBatch(std::istream& input) {
+    using Clock = std::chrono::steady_clock;
+    uint32_t executed = 0;
+    uint32_t failed = 0;
+    double total_ms = 0.0;
+    std::string statement;
+    while (ReadNextStatement(input, statement)) {
+        executed++;
+        Clock::time_point start = Clock::now();
+        Status status = ExecuteSQL(statement);
+        double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        total_ms += elapsed_ms;
+        if (status != Status::OK) {
+            failed++;
+        }
+        std::cout << "[" << executed << "] " << StatusToString(status) << " " << std::fixed << std::setprecision(3)
+                  << elapsed_ms << " ms" << std::defaultfloat << std::endl;
+    }
+    std::cout << "\n=== RESUMEN DEL LOTE ===" << std::endl;
+    std::cout << "Sentencias ejecutadas: " << executed << " (fallidas: " << failed << ")" << std::endl;
+    std::cout << "Tiempo total: " << std::fixed << std::setprecision(3) << total_ms << " ms" << std::defaultfloat << std::endl;
+    std::cout << "Caché de planes: " << g_statement_cache.Aciertos() << " aciertos, "
+              << g_statement_cache.Fallos() << " análisis" << std::endl;
+    return failed == 0 ? 0 : 1;
 }
 
+void PrintUsage(const char* program) {
+    std::cout << "Uso: " << program << "                                    (menú interactivo)" << std::endl;
+    std::cout << "     " << program << " --lote <script.sql|-> --disco <nombre> [--buffer N] [--politica 0-3] [--solo-lectura]" << std::endl;
+    std::cout << "     Ejecuta las sentencias del script (o de stdin con '-') sin pasar por el menú." << std::endl;
+    std::cout << "     Con --solo-lectura abre el disco como réplica de consulta: sin WAL y sin escrituras." << std::endl;
+}
 
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "Directorio de trabajo actual: " << fs::current_path() << std::endl; // Debug output
 
+    if (argc > 1) {
+        std::string script_path;
+        std::string disk_name;
+        uint32_t buffer_pool_size = 64;
+        int replacement_policy_choice = 2; // 2Q: el lote suele recorrer tablas enteras
+        bool read_only = false;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool has_value = i + 1 < argc;
+            if (arg == "--lote" && has_value) script_path = argv[++i];
+            else if (arg == "--disco" && has_value) disk_name = argv[++i];
+            else if (arg == "--buffer" && has_value) buffer_pool_size = static_cast<uint32_t>(std::stoul(argv[++i]));
+            else if (arg == "--politica" && has_value) replacement_policy_choice = std::stoi(argv[++i]);
+            else if (arg == "--solo-lectura") read_only = true;
+            else {
+                PrintUsage(argv[0]);
+                return 2;
+            }
+        }
+        if (script_path.empty() || disk_name.empty()) {
+            PrintUsage(argv[0]);
+            return 2;
+        }
+        if (!OpenExistingDisk(disk_name, buffer_pool_size, replacement_policy_choice, read_only)) {
+            return 1;
+        }
+        if (script_path == "-") {
+            return RunBatch(std::cin);
+        }
+        std::ifstream script(script_path);
+        if (!script.is_open()) {
+            std::cerr << "Error: No se pudo abrir el script '" << script_path << "'." << std::endl;
+            return 1;
+        }
+        return RunBatch(script);
+    }
+
     int choice;
     do {
         DisplayMainMenu();
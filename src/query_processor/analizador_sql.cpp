@@ -0,0 +1,516 @@
+// query_processor/analizador_sql.cpp - Implementación del tokenizador, el analizador y la caché de planes
+#include "analizador_sql.h"
+#include <cctype>
+
+namespace {
+
+bool EsInicioPalabra(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool EsParteDePalabra(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.';
+}
+
+bool EsDigito(char c) {
+    return std::isdigit(static_cast<unsigned char>(c)) != 0;
+}
+
+bool IgualSinMayusculas(const std::string& a, const char* b) {
+    size_t i = 0;
+    for (; i < a.size() && b[i] != '\0'; ++i) {
+        if (std::toupper(static_cast<unsigned char>(a[i])) != b[i]) {
+            return false;
+        }
+    }
+    return i == a.size() && b[i] == '\0';
+}
+
+/**
+ * @brief Analizador descendente recursivo sobre un vector de tokens terminado en FIN.
+ */
+class Analizador {
+public:
+    Analizador(const std::vector<TokenSQL>& tokens, std::string& error) : tokens_(tokens), error_(error) {}
+
+    Status Sentencia(SentenciaSQL& sentencia) {
+        sentencia = SentenciaSQL();
+        bool correcto = false;
+        if (Acepta("INSERT")) correcto = Insert(sentencia);
+        else if (Acepta("SELECT")) correcto = Select(sentencia);
+        else if (Acepta("UPDATE")) correcto = Update(sentencia);
+        else if (Acepta("DELETE")) correcto = Delete(sentencia);
+        else if (Acepta("PREPARE")) correcto = Prepare(sentencia);
+        else if (Acepta("EXECUTE")) correcto = Execute(sentencia);
+        else return Fallo("se esperaba INSERT, SELECT, UPDATE, DELETE, PREPARE o EXECUTE");
+        if (!correcto) {
+            return Status::INVALID_FORMAT;
+        }
+        AceptaSimbolo(";");
+        if (Actual().tipo != TokenSQL::Tipo::FIN) {
+            return Fallo("texto sobrante tras la sentencia");
+        }
+        return Status::OK;
+    }
+
+private:
+    const std::vector<TokenSQL>& tokens_;
+    std::string& error_;
+    size_t posicion_ = 0;
+
+    const TokenSQL& Actual() const { return tokens_[posicion_]; }
+
+    Status Fallo(const std::string& mensaje) {
+        const TokenSQL& token = Actual();
+        error_ = mensaje + " (posición " + std::to_string(token.posicion) +
+                 (token.tipo == TokenSQL::Tipo::FIN ? ", fin de la sentencia)" : ", cerca de '" + token.texto + "')");
+        return Status::INVALID_FORMAT;
+    }
+
+    bool Acepta(const char* palabra_clave) {
+        if (Actual().tipo == TokenSQL::Tipo::PALABRA && IgualSinMayusculas(Actual().texto, palabra_clave)) {
+            posicion_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool Espera(const char* palabra_clave) {
+        if (Acepta(palabra_clave)) {
+            return true;
+        }
+        Fallo(std::string("se esperaba ") + palabra_clave);
+        return false;
+    }
+
+    bool AceptaSimbolo(const char* simbolo) {
+        if (Actual().tipo == TokenSQL::Tipo::SIMBOLO && Actual().texto == simbolo) {
+            posicion_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool EsperaSimbolo(const char* simbolo) {
+        if (AceptaSimbolo(simbolo)) {
+            return true;
+        }
+        Fallo(std::string("se esperaba '") + simbolo + "'");
+        return false;
+    }
+
+    bool Identificador(std::string& nombre, const char* que) {
+        if (Actual().tipo != TokenSQL::Tipo::PALABRA) {
+            Fallo(std::string("se esperaba ") + que);
+            return false;
+        }
+        nombre = tokens_[posicion_++].texto;
+        return true;
+    }
+
+    // Literal de valor; si es '?' se registra el parámetro en su destino
+    bool Valor(SentenciaSQL& sentencia, SentenciaSQL::Parametro::Destino destino, size_t indice, std::string& valor) {
+        const TokenSQL& token = Actual();
+        switch (token.tipo) {
+            case TokenSQL::Tipo::PARAMETRO:
+                sentencia.parametros.push_back({destino, indice});
+                valor.clear();
+                break;
+            case TokenSQL::Tipo::NUMERO:
+            case TokenSQL::Tipo::CADENA:
+            case TokenSQL::Tipo::PALABRA: // NULL, true, false o texto sin comillas
+                valor = token.texto;
+                break;
+            default:
+                Fallo("se esperaba un valor");
+                return false;
+        }
+        posicion_++;
+        return true;
+    }
+
+    bool Operador(OperadorComparacion& operador) {
+        const TokenSQL& token = Actual();
+        if (token.tipo != TokenSQL::Tipo::SIMBOLO) {
+            Fallo("se esperaba un operador de comparación");
+            return false;
+        }
+        if (token.texto == "=") operador = OperadorComparacion::IGUAL;
+        else if (token.texto == "<>" || token.texto == "!=") operador = OperadorComparacion::DISTINTO;
+        else if (token.texto == "<") operador = OperadorComparacion::MENOR;
+        else if (token.texto == "<=") operador = OperadorComparacion::MENOR_IGUAL;
+        else if (token.texto == ">") operador = OperadorComparacion::MAYOR;
+        else if (token.texto == ">=") operador = OperadorComparacion::MAYOR_IGUAL;
+        else {
+            Fallo("se esperaba un operador de comparación");
+            return false;
+        }
+        posicion_++;
+        return true;
+    }
+
+    bool Where(SentenciaSQL& sentencia) {
+        do {
+            CondicionFiltro condicion;
+            if (!Identificador(condicion.columna, "una columna") || !Operador(condicion.operador) ||
+                !Valor(sentencia, SentenciaSQL::Parametro::Destino::VALOR_CONDICION,
+                       sentencia.condiciones.size(), condicion.valor)) {
+                return false;
+            }
+            sentencia.condiciones.push_back(std::move(condicion));
+        } while (Acepta("AND"));
+        return true;
+    }
+
+    // INSERT INTO tabla VALUES (valor, ...)
+    bool Insert(SentenciaSQL& sentencia) {
+        sentencia.tipo = TipoSentencia::INSERT;
+        if (!Espera("INTO") || !Identificador(sentencia.tabla, "el nombre de la tabla") ||
+            !Espera("VALUES") || !EsperaSimbolo("(")) {
+            return false;
+        }
+        do {
+            std::string valor;
+            if (!Valor(sentencia, SentenciaSQL::Parametro::Destino::VALOR_INSERT, sentencia.valores.size(), valor)) {
+                return false;
+            }
+            sentencia.valores.push_back(std::move(valor));
+        } while (AceptaSimbolo(","));
+        return EsperaSimbolo(")");
+    }
+
+    bool EsFuncionAgregado(const std::string& palabra, FuncionAgregado& funcion) const {
+        if (IgualSinMayusculas(palabra, "COUNT")) funcion = FuncionAgregado::COUNT;
+        else if (IgualSinMayusculas(palabra, "SUM")) funcion = FuncionAgregado::SUM;
+        else if (IgualSinMayusculas(palabra, "MIN")) funcion = FuncionAgregado::MIN;
+        else if (IgualSinMayusculas(palabra, "MAX")) funcion = FuncionAgregado::MAX;
+        else if (IgualSinMayusculas(palabra, "AVG")) funcion = FuncionAgregado::AVG;
+        else return false;
+        return true;
+    }
+
+    // COUNT(*) | COUNT(columna) | SUM/MIN/MAX/AVG(columna); el nombre ya se ha consumido
+    bool Agregado(FuncionAgregado funcion, SentenciaSQL& sentencia) {
+        EspecificacionAgregado agregado;
+        agregado.funcion = funcion;
+        if (!EsperaSimbolo("(")) {
+            return false;
+        }
+        if (!(funcion == FuncionAgregado::COUNT && AceptaSimbolo("*")) &&
+            !Identificador(agregado.columna, "una columna")) {
+            return false;
+        }
+        sentencia.agregados.push_back(std::move(agregado));
+        return EsperaSimbolo(")");
+    }
+
+    // SELECT (* | elemento, ...) FROM tabla [WHERE condiciones]
+    // Los elementos son columnas o agregados, sin mezclar (no hay GROUP BY)
+    bool Select(SentenciaSQL& sentencia) {
+        sentencia.tipo = TipoSentencia::SELECT;
+        if (!AceptaSimbolo("*")) {
+            do {
+                std::string columna;
+                if (!Identificador(columna, "una columna o '*'")) {
+                    return false;
+                }
+                FuncionAgregado funcion = FuncionAgregado::COUNT;
+                if (Actual().tipo == TokenSQL::Tipo::SIMBOLO && Actual().texto == "(" && EsFuncionAgregado(columna, funcion)) {
+                    if (!Agregado(funcion, sentencia)) {
+                        return false;
+                    }
+                } else {
+                    sentencia.columnas.push_back(std::move(columna));
+                }
+                if (!sentencia.columnas.empty() && !sentencia.agregados.empty()) {
+                    Fallo("no se pueden mezclar columnas y agregados sin GROUP BY");
+                    return false;
+                }
+            } while (AceptaSimbolo(","));
+        }
+        if (!Espera("FROM") || !Identificador(sentencia.tabla, "el nombre de la tabla")) {
+            return false;
+        }
+        return !Acepta("WHERE") || Where(sentencia);
+    }
+
+    // UPDATE tabla SET columna = valor, ... WHERE condiciones
+    bool Update(SentenciaSQL& sentencia) {
+        sentencia.tipo = TipoSentencia::UPDATE;
+        if (!Identificador(sentencia.tabla, "el nombre de la tabla") || !Espera("SET")) {
+            return false;
+        }
+        do {
+            std::pair<std::string, std::string> asignacion;
+            if (!Identificador(asignacion.first, "una columna") || !EsperaSimbolo("=") ||
+                !Valor(sentencia, SentenciaSQL::Parametro::Destino::VALOR_SET,
+                       sentencia.asignaciones.size(), asignacion.second)) {
+                return false;
+            }
+            sentencia.asignaciones.push_back(std::move(asignacion));
+        } while (AceptaSimbolo(","));
+        // Sin WHERE se actualizaría la tabla entera: se exige, como antes
+        return Espera("WHERE") && Where(sentencia);
+    }
+
+    // DELETE FROM tabla WHERE condiciones
+    bool Delete(SentenciaSQL& sentencia) {
+        sentencia.tipo = TipoSentencia::DELETE;
+        return Espera("FROM") && Identificador(sentencia.tabla, "el nombre de la tabla") &&
+               Espera("WHERE") && Where(sentencia);
+    }
+
+    // PREPARE nombre AS sentencia
+    bool Prepare(SentenciaSQL& sentencia) {
+        sentencia.tipo = TipoSentencia::PREPARE;
+        if (!Identificador(sentencia.nombre, "el nombre de la sentencia preparada") || !Espera("AS")) {
+            return false;
+        }
+        if (Actual().tipo == TokenSQL::Tipo::PALABRA &&
+            (IgualSinMayusculas(Actual().texto, "PREPARE") || IgualSinMayusculas(Actual().texto, "EXECUTE"))) {
+            Fallo("no se puede preparar un PREPARE o EXECUTE");
+            return false;
+        }
+        auto cuerpo = std::make_shared<SentenciaSQL>();
+        bool correcto = false;
+        if (Acepta("INSERT")) correcto = Insert(*cuerpo);
+        else if (Acepta("SELECT")) correcto = Select(*cuerpo);
+        else if (Acepta("UPDATE")) correcto = Update(*cuerpo);
+        else if (Acepta("DELETE")) correcto = Delete(*cuerpo);
+        else Fallo("se esperaba INSERT, SELECT, UPDATE o DELETE");
+        sentencia.cuerpo = cuerpo;
+        return correcto;
+    }
+
+    // EXECUTE nombre [(valor, ...)]
+    bool Execute(SentenciaSQL& sentencia) {
+        sentencia.tipo = TipoSentencia::EXECUTE;
+        if (!Identificador(sentencia.nombre, "el nombre de la sentencia preparada")) {
+            return false;
+        }
+        if (!AceptaSimbolo("(")) {
+            return true;
+        }
+        do {
+            if (Actual().tipo == TokenSQL::Tipo::PARAMETRO) {
+                Fallo("EXECUTE necesita valores, no '?'");
+                return false;
+            }
+            std::string valor;
+            if (!Valor(sentencia, SentenciaSQL::Parametro::Destino::VALOR_INSERT, sentencia.valores.size(), valor)) {
+                return false;
+            }
+            sentencia.valores.push_back(std::move(valor));
+        } while (AceptaSimbolo(","));
+        return EsperaSimbolo(")");
+    }
+};
+
+} // namespace
+
+// ===== TOKENIZADOR =====
+
+Status TokenizarSQL(const std::string& texto, std::vector<TokenSQL>& tokens, std::string& error) {
+    tokens.clear();
+    size_t i = 0;
+    const size_t n = texto.size();
+    while (i < n) {
+        char c = texto[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            i++;
+            continue;
+        }
+        TokenSQL token;
+        token.posicion = i;
+        if (EsInicioPalabra(c)) {
+            size_t inicio = i;
+            while (i < n && EsParteDePalabra(texto[i])) i++;
+            token.tipo = TokenSQL::Tipo::PALABRA;
+            token.texto = texto.substr(inicio, i - inicio);
+        } else if (EsDigito(c) || ((c == '-' || c == '+') && i + 1 < n && (EsDigito(texto[i + 1]) || texto[i + 1] == '.'))) {
+            size_t inicio = i++;
+            while (i < n && (EsDigito(texto[i]) || texto[i] == '.')) i++;
+            if (i < n && (texto[i] == 'e' || texto[i] == 'E')) {
+                size_t exponente = i + 1;
+                if (exponente < n && (texto[exponente] == '-' || texto[exponente] == '+')) exponente++;
+                if (exponente < n && EsDigito(texto[exponente])) {
+                    i = exponente;
+                    while (i < n && EsDigito(texto[i])) i++;
+                }
+            }
+            token.tipo = TokenSQL::Tipo::NUMERO;
+            token.texto = texto.substr(inicio, i - inicio);
+        } else if (c == '\'' || c == '"') {
+            // La comilla se escapa duplicándola: 'O''Brien'
+            i++;
+            bool cerrada = false;
+            while (i < n) {
+                if (texto[i] == c) {
+                    if (i + 1 < n && texto[i + 1] == c) {
+                        token.texto += c;
+                        i += 2;
+                        continue;
+                    }
+                    i++;
+                    cerrada = true;
+                    break;
+                }
+                token.texto += texto[i++];
+            }
+            if (!cerrada) {
+                error = "cadena sin cerrar (posición " + std::to_string(token.posicion) + ")";
+                return Status::INVALID_FORMAT;
+            }
+            token.tipo = TokenSQL::Tipo::CADENA;
+        } else if (c == '?') {
+            token.tipo = TokenSQL::Tipo::PARAMETRO;
+            token.texto = "?";
+            i++;
+        } else if (c == '<' || c == '>' || c == '!') {
+            char siguiente = (i + 1 < n) ? texto[i + 1] : '\0';
+            bool doble = (siguiente == '=') || (c == '<' && siguiente == '>');
+            if (c == '!' && !doble) {
+                error = "carácter '!' inesperado (posición " + std::to_string(i) + ")";
+                return Status::INVALID_FORMAT;
+            }
+            token.tipo = TokenSQL::Tipo::SIMBOLO;
+            token.texto = texto.substr(i, doble ? 2 : 1);
+            i += token.texto.size();
+        } else if (c == '(' || c == ')' || c == ',' || c == '*' || c == ';' || c == '=') {
+            token.tipo = TokenSQL::Tipo::SIMBOLO;
+            token.texto = std::string(1, c);
+            i++;
+        } else {
+            error = std::string("carácter '") + c + "' inesperado (posición " + std::to_string(i) + ")";
+            return Status::INVALID_FORMAT;
+        }
+        tokens.push_back(std::move(token));
+    }
+    TokenSQL fin;
+    fin.posicion = n;
+    tokens.push_back(fin);
+    return Status::OK;
+}
+
+// ===== ANALIZADOR =====
+
+Status AnalizarTokensSQL(const std::vector<TokenSQL>& tokens, SentenciaSQL& sentencia, std::string& error) {
+    if (tokens.empty() || tokens.back().tipo != TokenSQL::Tipo::FIN) {
+        error = "secuencia de tokens sin terminar";
+        return Status::INVALID_FORMAT;
+    }
+    Analizador analizador(tokens, error);
+    return analizador.Sentencia(sentencia);
+}
+
+Status AnalizarSQL(const std::string& texto, SentenciaSQL& sentencia, std::string& error) {
+    std::vector<TokenSQL> tokens;
+    Status estado = TokenizarSQL(texto, tokens, error);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    return AnalizarTokensSQL(tokens, sentencia, error);
+}
+
+// ===== SENTENCIAS PREPARADAS =====
+
+Status SentenciaPreparada::Preparar(const std::string& texto, SentenciaPreparada& preparada, std::string& error) {
+    SentenciaSQL plan;
+    Status estado = AnalizarSQL(texto, plan, error);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    if (plan.tipo == TipoSentencia::PREPARE || plan.tipo == TipoSentencia::EXECUTE) {
+        error = "no se puede preparar un PREPARE o EXECUTE";
+        return Status::INVALID_ARGUMENT;
+    }
+    preparada.plan_ = std::move(plan);
+    return Status::OK;
+}
+
+Status SentenciaPreparada::Vincular(const std::vector<std::string>& valores, SentenciaSQL& sentencia,
+                                    std::string& error) const {
+    if (valores.size() != plan_.parametros.size()) {
+        error = "se esperaban " + std::to_string(plan_.parametros.size()) + " valores y se recibieron " +
+                std::to_string(valores.size());
+        return Status::INVALID_ARGUMENT;
+    }
+    sentencia = plan_;
+    for (size_t i = 0; i < valores.size(); ++i) {
+        const SentenciaSQL::Parametro& parametro = plan_.parametros[i];
+        switch (parametro.destino) {
+            case SentenciaSQL::Parametro::Destino::VALOR_INSERT:
+                sentencia.valores[parametro.indice] = valores[i];
+                break;
+            case SentenciaSQL::Parametro::Destino::VALOR_SET:
+                sentencia.asignaciones[parametro.indice].second = valores[i];
+                break;
+            case SentenciaSQL::Parametro::Destino::VALOR_CONDICION:
+                sentencia.condiciones[parametro.indice].valor = valores[i];
+                break;
+        }
+    }
+    sentencia.parametros.clear();
+    return Status::OK;
+}
+
+// ===== CACHÉ DE PLANES =====
+
+CacheSentencias::CacheSentencias(size_t capacidad) : capacidad_(capacidad == 0 ? 1 : capacidad) {}
+
+Status CacheSentencias::Obtener(const std::string& texto, SentenciaSQL& sentencia, std::string& error) {
+    std::vector<TokenSQL> tokens;
+    Status estado = TokenizarSQL(texto, tokens, error);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    // PREPARE y EXECUTE no se cachean: sus literales no son parámetros de un plan
+    if (tokens.front().tipo == TokenSQL::Tipo::PALABRA &&
+        (IgualSinMayusculas(tokens.front().texto, "PREPARE") || IgualSinMayusculas(tokens.front().texto, "EXECUTE"))) {
+        return AnalizarTokensSQL(tokens, sentencia, error);
+    }
+
+    // Clave: la secuencia de tokens con cada literal numérico o de cadena cambiado por '?'
+    std::string clave;
+    std::vector<std::string> literales;
+    for (TokenSQL& token : tokens) {
+        if (token.tipo == TokenSQL::Tipo::PARAMETRO) {
+            error = "los parámetros '?' solo se admiten en PREPARE (posición " + std::to_string(token.posicion) + ")";
+            return Status::INVALID_ARGUMENT;
+        }
+        if (token.tipo == TokenSQL::Tipo::NUMERO || token.tipo == TokenSQL::Tipo::CADENA) {
+            literales.push_back(std::move(token.texto));
+            token.tipo = TokenSQL::Tipo::PARAMETRO;
+            token.texto = "?";
+        }
+        clave += static_cast<char>('0' + static_cast<int>(token.tipo));
+        clave += token.texto;
+        clave += '\x1f';
+    }
+
+    auto encontrada = entradas_.find(clave);
+    if (encontrada != entradas_.end()) {
+        aciertos_++;
+        orden_uso_.splice(orden_uso_.begin(), orden_uso_, encontrada->second.uso);
+        return encontrada->second.preparada.Vincular(literales, sentencia, error);
+    }
+
+    fallos_++;
+    SentenciaSQL plan;
+    estado = AnalizarTokensSQL(tokens, plan, error);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    if (entradas_.size() >= capacidad_) {
+        entradas_.erase(orden_uso_.back());
+        orden_uso_.pop_back();
+    }
+    orden_uso_.push_front(clave);
+    auto insertada = entradas_.emplace(std::move(clave), Entrada{SentenciaPreparada(std::move(plan)), orden_uso_.begin()});
+    return insertada.first->second.preparada.Vincular(literales, sentencia, error);
+}
+
+void CacheSentencias::Limpiar() {
+    entradas_.clear();
+    orden_uso_.clear();
+}
@@ -0,0 +1,159 @@
+// query_processor/analizador_sql.h - Tokenizador y analizador del subconjunto SQL del SGBD
+// Sustituye a las expresiones regulares que HandleQueryProcessor compilaba en cada consulta
+
+#ifndef ANALIZADOR_SQL_H
+#define ANALIZADOR_SQL_H
+
+#include "../include/common.h"
+#include "../record_manager/filtro_compilado.h"
+#include "../record_manager/escaneo_paralelo.h" // Para EspecificacionAgregado
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Token léxico de una sentencia.
+ */
+struct TokenSQL {
+    enum class Tipo : uint8_t {
+        PALABRA,    // Identificador o palabra clave (se distinguen al analizar)
+        NUMERO,     // Entero o real, con signo opcional
+        CADENA,     // Literal entre comillas, ya sin ellas
+        PARAMETRO,  // '?'
+        SIMBOLO,    // ( ) , * ; = <> != < <= > >=
+        FIN
+    };
+    Tipo tipo = Tipo::FIN;
+    std::string texto;
+    size_t posicion = 0;    // Offset en el texto original, para los mensajes de error
+};
+
+/**
+ * @brief Divide el texto en tokens. Las palabras conservan su forma original.
+ * @param error [out] Descripción del error si el texto tiene caracteres no válidos
+ *        o una cadena sin cerrar
+ * @return INVALID_FORMAT en caso de error
+ */
+Status TokenizarSQL(const std::string& texto, std::vector<TokenSQL>& tokens, std::string& error);
+
+enum class TipoSentencia : uint8_t {
+    INSERT = 0,
+    SELECT,
+    UPDATE,
+    DELETE,
+    PREPARE,    // PREPARE nombre AS <sentencia>
+    EXECUTE     // EXECUTE nombre (valor, ...)
+};
+
+/**
+ * @brief Plan de una sentencia ya analizada; se ejecuta sin volver a mirar el texto.
+ *
+ * Los literales se guardan como texto sin comillas y se convierten al tipo de su
+ * columna al ejecutar (ValidateAndConvertValues / FiltroCompilado). Cada '?' que
+ * aparece en VALUES, SET o WHERE queda registrado en parametros, en orden.
+ */
+struct SentenciaSQL {
+    /**
+     * @brief Dónde hay que escribir el valor de un parámetro al vincularlo.
+     */
+    struct Parametro {
+        enum class Destino : uint8_t { VALOR_INSERT, VALOR_SET, VALOR_CONDICION };
+        Destino destino;
+        size_t indice;
+    };
+
+    TipoSentencia tipo = TipoSentencia::SELECT;
+    std::string tabla;
+    std::vector<std::string> columnas;                           // SELECT; vacío = *
+    std::vector<EspecificacionAgregado> agregados;               // SELECT COUNT/SUM/MIN/MAX/AVG
+    std::vector<std::string> valores;                            // INSERT VALUES / EXECUTE
+    std::vector<std::pair<std::string, std::string>> asignaciones; // UPDATE SET columna = valor
+    std::vector<CondicionFiltro> condiciones;                    // WHERE, unidas por AND
+    std::vector<Parametro> parametros;
+    std::string nombre;                                          // PREPARE / EXECUTE
+    std::shared_ptr<const SentenciaSQL> cuerpo;                  // PREPARE: sentencia tras AS
+};
+
+/**
+ * @brief Analiza una sentencia ya tokenizada.
+ * @param error [out] Descripción del error con la posición del token
+ * @return INVALID_FORMAT si la sentencia no pertenece a la gramática
+ */
+Status AnalizarTokensSQL(const std::vector<TokenSQL>& tokens, SentenciaSQL& sentencia, std::string& error);
+
+/**
+ * @brief Tokeniza y analiza una sentencia.
+ */
+Status AnalizarSQL(const std::string& texto, SentenciaSQL& sentencia, std::string& error);
+
+/**
+ * @brief Sentencia analizada una vez y ejecutable con distintos valores de sus '?'.
+ */
+class SentenciaPreparada {
+public:
+    SentenciaPreparada() = default;
+    explicit SentenciaPreparada(SentenciaSQL plan) : plan_(std::move(plan)) {}
+
+    /**
+     * @return INVALID_FORMAT si el texto no se puede analizar; INVALID_ARGUMENT si es
+     *         un PREPARE o EXECUTE
+     */
+    static Status Preparar(const std::string& texto, SentenciaPreparada& preparada, std::string& error);
+
+    /**
+     * @brief Copia el plan sustituyendo cada '?' por su valor, en orden.
+     * @return INVALID_ARGUMENT si el número de valores no coincide con el de parámetros
+     */
+    Status Vincular(const std::vector<std::string>& valores, SentenciaSQL& sentencia, std::string& error) const;
+
+    size_t NumeroParametros() const { return plan_.parametros.size(); }
+    const SentenciaSQL& Plan() const { return plan_; }
+
+private:
+    SentenciaSQL plan_;
+};
+
+/**
+ * @brief Caché de planes para sentencias que solo se diferencian en sus literales.
+ *
+ * Obtener() tokeniza el texto y sustituye cada literal de valor por '?': la
+ * secuencia resultante es la clave. Si ya estaba, el plan guardado se vincula con
+ * los literales extraídos sin volver a analizar; si no, se analiza una vez y se
+ * guarda. Las sentencias de un ETL (mismo INSERT con otros valores) analizan así
+ * solo la primera.
+ *
+ * Al llenarse se descarta la clave usada hace más tiempo.
+ */
+class CacheSentencias {
+public:
+    explicit CacheSentencias(size_t capacidad = 256);
+
+    /**
+     * @return INVALID_FORMAT si el texto no se puede analizar; INVALID_ARGUMENT si
+     *         contiene '?' (esas sentencias se preparan con PREPARE)
+     */
+    Status Obtener(const std::string& texto, SentenciaSQL& sentencia, std::string& error);
+
+    uint64_t Aciertos() const { return aciertos_; }
+    uint64_t Fallos() const { return fallos_; }
+    size_t Tamaño() const { return entradas_.size(); }
+    void Limpiar();
+
+private:
+    using ListaUso = std::list<std::string>;
+    struct Entrada {
+        SentenciaPreparada preparada;
+        ListaUso::iterator uso;
+    };
+
+    size_t capacidad_;
+    std::unordered_map<std::string, Entrada> entradas_;
+    ListaUso orden_uso_;            // Más reciente al principio
+    uint64_t aciertos_ = 0;
+    uint64_t fallos_ = 0;
+};
+
+#endif // ANALIZADOR_SQL_H
@@ -0,0 +1,250 @@
+// record_manager/cursor_registros.cpp - Implementación del cursor de recorrido de tablas
+#include "cursor_registros.h"
+#include "gestor_registros.h" // Para DatosRegistro
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+// ===== APERTURA Y CIERRE =====
+
+void CursorRegistros::Abrir(GestorBuffer* gestor_buffer, const DisposicionRegistro* disposicion,
+                            FormatoAlmacenamiento formato, std::vector<PageId> paginas, PredicadoRegistro predicado,
+                            std::shared_ptr<const FiltroCompilado> filtro) {
+    Cerrar();
+    gestor_buffer_ = gestor_buffer;
+    disposicion_ = disposicion;
+    lector_ = LectorPaginaDatos(disposicion, formato);
+    paginas_ = std::move(paginas);
+    if (gestor_buffer_ && !paginas_.empty()) {
+        // Secuencia propia del cursor: el buffer no guarda nada de ella
+        limite_lectura_secuencial_ = gestor_buffer_->DeclararLecturaSecuencial(paginas_);
+    }
+    predicado_ = std::move(predicado);
+    filtro_ = std::move(filtro);
+    indice_pagina_ = 0;
+    siguiente_slot_ = 0;
+    registros_examinados_ = 0;
+    registros_devueltos_ = 0;
+    paginas_descartadas_ = 0;
+}
+
+void CursorRegistros::AbrirPorIds(GestorBuffer* gestor_buffer, const DisposicionRegistro* disposicion,
+                                  FormatoAlmacenamiento formato, std::vector<RecordId> ids,
+                                  std::shared_ptr<const FiltroCompilado> filtro) {
+    Abrir(gestor_buffer, disposicion, formato, {}, nullptr, std::move(filtro));
+    // Ordenar por RecordId es ordenar por (página, slot)
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    ids_ = std::move(ids);
+    indice_id_ = 0;
+    por_ids_ = true;
+}
+
+void CursorRegistros::Cerrar() {
+    DesanclarPagina();
+    limite_lectura_secuencial_ = 0;
+    gestor_buffer_ = nullptr;
+    disposicion_ = nullptr;
+    predicado_ = nullptr;
+    filtro_.reset();
+    paginas_.clear();
+    indice_pagina_ = 0;
+    por_ids_ = false;
+    ids_.clear();
+    indice_id_ = 0;
+    vistas_pagina_.clear();
+    slots_pagina_.clear();
+    seleccion_.clear();
+    indice_seleccion_ = 0;
+}
+
+// ===== RECORRIDO =====
+
+bool CursorRegistros::Siguiente(RecordId& id_registro, VistaRegistro& vista) {
+    if (!EstaAbierto()) {
+        return false;
+    }
+    if (por_ids_) {
+        return SiguientePorId(id_registro, vista);
+    }
+    if (filtro_) {
+        return SiguienteFiltrado(id_registro, vista);
+    }
+    while (datos_pagina_ != nullptr || AvanzarPagina()) {
+        lector_.Refrescar(); // El registro anterior pudo actualizarse o eliminarse
+        while (siguiente_slot_ < lector_.NumeroSlots()) {
+            uint32_t slot = siguiente_slot_++;
+            const Byte* registro = nullptr;
+            uint32_t longitud = 0;
+            if (!lector_.Obtener(slot, registro, longitud)) {
+                continue; // Slot libre
+            }
+            VistaRegistro candidata(registro, longitud, *disposicion_);
+            if (!candidata.EsValida()) {
+                continue;
+            }
+            registros_examinados_++;
+            if (predicado_ && !predicado_(candidata)) {
+                continue;
+            }
+            id_registro = ConstruirRecordId(pagina_anclada_, slot);
+            vista = candidata;
+            registros_devueltos_++;
+            return true;
+        }
+        DesanclarPagina();
+    }
+    Cerrar();
+    return false;
+}
+
+size_t CursorRegistros::SiguienteLote(std::vector<DatosRegistro>& lote, std::vector<RecordId>* ids,
+                                      size_t max_registros) {
+    lote.clear();
+    if (ids) {
+        ids->clear();
+    }
+    RecordId id_registro;
+    VistaRegistro vista;
+    while (lote.size() < max_registros && Siguiente(id_registro, vista)) {
+        DatosRegistro registro;
+        registro.campos.reserve(vista.NumeroColumnas());
+        for (uint32_t i = 0; i < vista.NumeroColumnas(); ++i) {
+            registro.campos.push_back(vista.ObtenerComoTexto(i));
+        }
+        lote.push_back(std::move(registro));
+        if (ids) {
+            ids->push_back(id_registro);
+        }
+    }
+    return lote.size();
+}
+
+// ===== AUXILIARES PRIVADOS =====
+
+bool CursorRegistros::AvanzarPagina() {
+    DesanclarPagina();
+    while (indice_pagina_ < paginas_.size()) {
+        gestor_buffer_->AvanzarLecturaSecuencial(paginas_, indice_pagina_, limite_lectura_secuencial_);
+        if (AnclarPagina(paginas_[indice_pagina_++])) {
+            siguiente_slot_ = 0;
+            if (filtro_) {
+                FiltrarPagina();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CursorRegistros::SiguientePorId(RecordId& id_registro, VistaRegistro& vista) {
+    while (indice_id_ < ids_.size()) {
+        RecordId candidato = ids_[indice_id_++];
+        PageId id_pagina = PaginaDeRecordId(candidato);
+        if (id_pagina != pagina_anclada_) {
+            DesanclarPagina();
+            if (!AnclarPagina(id_pagina)) {
+                // Se descartan los demás ids de la página en lugar de reintentar con cada uno
+                while (indice_id_ < ids_.size() && PaginaDeRecordId(ids_[indice_id_]) == id_pagina) {
+                    indice_id_++;
+                }
+                continue;
+            }
+        }
+        lector_.Refrescar();
+        const Byte* registro = nullptr;
+        uint32_t longitud = 0;
+        if (!lector_.Obtener(SlotDeRecordId(candidato), registro, longitud)) {
+            continue; // El índice apuntaba a un slot ya liberado
+        }
+        VistaRegistro candidata(registro, longitud, *disposicion_);
+        if (!candidata.EsValida()) {
+            continue;
+        }
+        registros_examinados_++;
+        if ((predicado_ && !predicado_(candidata)) || (filtro_ && !filtro_->Evaluar(candidata))) {
+            continue;
+        }
+        id_registro = candidato;
+        vista = candidata;
+        registros_devueltos_++;
+        return true;
+    }
+    Cerrar();
+    return false;
+}
+
+bool CursorRegistros::SiguienteFiltrado(RecordId& id_registro, VistaRegistro& vista) {
+    while (datos_pagina_ != nullptr || AvanzarPagina()) {
+        lector_.Refrescar();
+        while (indice_seleccion_ < seleccion_.size()) {
+            uint32_t slot = slots_pagina_[seleccion_[indice_seleccion_++]];
+            // Se relee el slot: una actualización anterior puede haber compactado la página
+            const Byte* registro = nullptr;
+            uint32_t longitud = 0;
+            if (!lector_.Obtener(slot, registro, longitud)) {
+                continue;
+            }
+            VistaRegistro candidata(registro, longitud, *disposicion_);
+            if (!candidata.EsValida() || (predicado_ && !predicado_(candidata))) {
+                continue;
+            }
+            id_registro = ConstruirRecordId(pagina_anclada_, slot);
+            vista = candidata;
+            registros_devueltos_++;
+            return true;
+        }
+        DesanclarPagina();
+    }
+    Cerrar();
+    return false;
+}
+
+void CursorRegistros::FiltrarPagina() {
+    vistas_pagina_.clear();
+    slots_pagina_.clear();
+    for (uint32_t slot = 0; slot < lector_.NumeroSlots(); ++slot) {
+        const Byte* registro = nullptr;
+        uint32_t longitud = 0;
+        if (!lector_.Obtener(slot, registro, longitud)) {
+            continue;
+        }
+        VistaRegistro candidata(registro, longitud, *disposicion_);
+        if (candidata.EsValida()) {
+            vistas_pagina_.push_back(candidata);
+            slots_pagina_.push_back(slot);
+        }
+    }
+    registros_examinados_ += vistas_pagina_.size();
+    filtro_->FiltrarLote(vistas_pagina_, seleccion_);
+    indice_seleccion_ = 0;
+}
+
+bool CursorRegistros::AnclarPagina(PageId id_pagina) {
+    Byte* datos = nullptr;
+    if (gestor_buffer_->PinPage(id_pagina, datos) != Status::OK || datos == nullptr) {
+        std::cerr << "Advertencia: No se pudo anclar la página " << id_pagina << " durante el recorrido." << std::endl;
+        return false;
+    }
+    // El descarte por rango se decide con el descriptor, antes de decodificar la página
+    if (filtro_ && filtro_->DescartaPagina(datos)) {
+        gestor_buffer_->UnpinPage(id_pagina, false);
+        paginas_descartadas_++;
+        return false;
+    }
+    if (!lector_.Cargar(datos)) {
+        gestor_buffer_->UnpinPage(id_pagina, false);
+        return false;
+    }
+    pagina_anclada_ = id_pagina;
+    datos_pagina_ = datos;
+    return true;
+}
+
+void CursorRegistros::DesanclarPagina() {
+    if (datos_pagina_ != nullptr) {
+        gestor_buffer_->UnpinPage(pagina_anclada_, false);
+    }
+    datos_pagina_ = nullptr;
+    pagina_anclada_ = INVALID_PAGE_ID;
+}
@@ -0,0 +1,135 @@
+// record_manager/cursor_registros.h - Cursor de recorrido secuencial de una tabla
+// Sustituye a materializar la tabla entera en un vector de DatosRegistro
+
+#ifndef CURSOR_REGISTROS_H
+#define CURSOR_REGISTROS_H
+
+#include "../include/common.h"
+#include "../data_storage/gestor_buffer.h"
+#include "formato_registro.h"
+#include "filtro_compilado.h"
+#include "pagina_pax.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+struct DatosRegistro;
+class GestorRegistros;
+
+/**
+ * @brief Filtro que se evalúa sobre el registro binario, antes de deserializarlo.
+ * Los registros que no lo cumplen no generan copias ni DatosRegistro.
+ */
+using PredicadoRegistro = std::function<bool(const VistaRegistro&)>;
+
+/**
+ * @brief Cursor de tipo "pull" sobre los registros de una tabla
+ *        (Abrir -> Siguiente/SiguienteLote -> Cerrar).
+ *
+ * - Solo mantiene anclada la página que está recorriendo; al pasar a la siguiente
+ *   desancla la anterior, así que la memoria no depende del tamaño de la tabla.
+ * - Las páginas se recorren en el orden de la tabla y, dentro de cada una, en
+ *   orden de slot. Como los slots son estables, se puede actualizar o eliminar el
+ *   registro actual por su RecordId sin perder la posición del cursor.
+ * - Cerrar() (o destruir el cursor) desancla la página actual: un LIMIT
+ *   basta con dejar de pedir registros.
+ *
+ * Con un FiltroCompilado (GestorRegistros::AbrirCursorFiltrado) cada página se
+ * filtra entera al anclarla y Siguiente() solo recorre los slots seleccionados.
+ * Los registros seleccionados se vuelven a leer de la página al devolverlos, así
+ * que actualizar o eliminar el registro actual no invalida los siguientes. En las
+ * tablas COLUMNAS_PAX el filtro descarta además, sin decodificarlas, las páginas
+ * cuyo mínimo y máximo por columna lo hacen imposible.
+ *
+ * Se abre con GestorRegistros::AbrirCursor() para recorrer la tabla entera o con
+ * GestorRegistros::AbrirCursorPorIds() para visitar solo los RecordId obtenidos de
+ * un índice. En el segundo caso los ids se visitan ordenados, de modo que cada
+ * página se ancla una sola vez. La disposición de la tabla pertenece al
+ * GestorRegistros y debe seguir viva mientras el cursor esté abierto.
+ */
+class CursorRegistros {
+public:
+    CursorRegistros() = default;
+    ~CursorRegistros() { Cerrar(); }
+
+    CursorRegistros(const CursorRegistros&) = delete;
+    CursorRegistros& operator=(const CursorRegistros&) = delete;
+
+    /**
+     * @brief Avanza al siguiente registro que cumple el predicado.
+     * @param id_registro [out] RecordId del registro
+     * @param vista [out] Vista sobre el registro; válida hasta la siguiente llamada o Cerrar()
+     * @return false cuando no quedan registros (el cursor se cierra solo)
+     */
+    bool Siguiente(RecordId& id_registro, VistaRegistro& vista);
+
+    /**
+     * @brief Deserializa hasta max_registros registros en un lote.
+     * @param lote [out] Se vacía y se rellena con los registros leídos
+     * @param ids [out] Opcional: RecordId de cada registro del lote
+     * @param max_registros Tamaño máximo del lote
+     * @return Número de registros del lote (0 al terminar)
+     */
+    size_t SiguienteLote(std::vector<DatosRegistro>& lote, std::vector<RecordId>* ids, size_t max_registros);
+
+    /**
+     * @brief Desancla la página actual y deja el cursor agotado.
+     */
+    void Cerrar();
+
+    bool EstaAbierto() const { return gestor_buffer_ != nullptr; }
+    uint64_t RegistrosExaminados() const { return registros_examinados_; }
+    uint64_t RegistrosDevueltos() const { return registros_devueltos_; }
+    uint64_t PaginasDescartadas() const { return paginas_descartadas_; }
+
+private:
+    friend class GestorRegistros;
+
+    GestorBuffer* gestor_buffer_ = nullptr;
+    const DisposicionRegistro* disposicion_ = nullptr;
+    LectorPaginaDatos lector_;          // Registros de la página anclada, en cualquier formato
+    PredicadoRegistro predicado_;
+    std::shared_ptr<const FiltroCompilado> filtro_;
+    std::vector<PageId> paginas_;
+    size_t limite_lectura_secuencial_ = 0; // Posiciones de paginas_ ya solicitadas a la lectura anticipada
+    size_t indice_pagina_ = 0;
+    PageId pagina_anclada_ = INVALID_PAGE_ID;
+    Byte* datos_pagina_ = nullptr;
+    uint32_t siguiente_slot_ = 0;
+    bool por_ids_ = false;              // Recorre ids_ en lugar de paginas_
+    std::vector<RecordId> ids_;         // Ordenados y sin repetidos
+    size_t indice_id_ = 0;
+    std::vector<VistaRegistro> vistas_pagina_;  // Registros válidos de la página (con filtro_)
+    std::vector<uint32_t> slots_pagina_;        // Slot de cada vista de vistas_pagina_
+    std::vector<uint32_t> seleccion_;           // Posiciones de vistas_pagina_ que cumplen filtro_
+    size_t indice_seleccion_ = 0;
+    uint64_t registros_examinados_ = 0;
+    uint64_t registros_devueltos_ = 0;
+    uint64_t paginas_descartadas_ = 0;
+
+    void Abrir(GestorBuffer* gestor_buffer, const DisposicionRegistro* disposicion, FormatoAlmacenamiento formato,
+               std::vector<PageId> paginas, PredicadoRegistro predicado,
+               std::shared_ptr<const FiltroCompilado> filtro = nullptr);
+    void AbrirPorIds(GestorBuffer* gestor_buffer, const DisposicionRegistro* disposicion, FormatoAlmacenamiento formato,
+                     std::vector<RecordId> ids, std::shared_ptr<const FiltroCompilado> filtro);
+
+    /**
+     * @brief Desancla la página actual y ancla la siguiente página de datos legible.
+     * @return false si no quedan páginas
+     */
+    bool AvanzarPagina();
+    bool SiguientePorId(RecordId& id_registro, VistaRegistro& vista);
+    bool SiguienteFiltrado(RecordId& id_registro, VistaRegistro& vista);
+    /**
+     * @brief Evalúa filtro_ sobre todos los registros de la página recién anclada.
+     */
+    void FiltrarPagina();
+    /**
+     * @brief Ancla una página si es una página de datos legible y el filtro no la descarta.
+     * @return false si no se pudo anclar, no es de datos o se descartó (no queda nada anclado)
+     */
+    bool AnclarPagina(PageId id_pagina);
+    void DesanclarPagina();
+};
+
+#endif // CURSOR_REGISTROS_H
@@ -0,0 +1,320 @@
+// record_manager/escaneo_paralelo.cpp - Implementación del recorrido paralelo por morsels
+#include "escaneo_paralelo.h"
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+// ===== AGREGADOS =====
+
+void AgregadoParcial::Acumular(const VistaRegistro& vista) {
+    if (columna < 0) {
+        valores++;
+        return;
+    }
+    uint32_t posicion = static_cast<uint32_t>(columna);
+    if (vista.EsNulo(posicion)) {
+        return;
+    }
+    valores++;
+    if (funcion == FuncionAgregado::COUNT) {
+        return;
+    }
+    if (tipo == ColumnType::INT) {
+        int64_t valor = vista.ObtenerEntero(posicion);
+        suma_entera += valor;
+        minimo_entero = std::min(minimo_entero, valor);
+        maximo_entero = std::max(maximo_entero, valor);
+    } else {
+        double valor = vista.ObtenerReal(posicion);
+        suma_real += valor;
+        minimo_real = std::min(minimo_real, valor);
+        maximo_real = std::max(maximo_real, valor);
+    }
+}
+
+void AgregadoParcial::Combinar(const AgregadoParcial& otro) {
+    valores += otro.valores;
+    suma_entera += otro.suma_entera;
+    minimo_entero = std::min(minimo_entero, otro.minimo_entero);
+    maximo_entero = std::max(maximo_entero, otro.maximo_entero);
+    suma_real += otro.suma_real;
+    minimo_real = std::min(minimo_real, otro.minimo_real);
+    maximo_real = std::max(maximo_real, otro.maximo_real);
+}
+
+std::string AgregadoParcial::ComoTexto() const {
+    if (funcion == FuncionAgregado::COUNT) {
+        return std::to_string(valores);
+    }
+    if (valores == 0) {
+        return DisposicionRegistro::VALOR_NULO;
+    }
+    const bool entero = (tipo == ColumnType::INT);
+    std::ostringstream salida;
+    switch (funcion) {
+        case FuncionAgregado::SUM:
+            if (entero) salida << suma_entera; else salida << suma_real;
+            break;
+        case FuncionAgregado::MIN:
+            if (entero) salida << minimo_entero; else salida << minimo_real;
+            break;
+        case FuncionAgregado::MAX:
+            if (entero) salida << maximo_entero; else salida << maximo_real;
+            break;
+        case FuncionAgregado::AVG:
+            salida << (entero ? static_cast<double>(suma_entera) : suma_real) / static_cast<double>(valores);
+            break;
+        case FuncionAgregado::COUNT:
+            break;
+    }
+    return salida.str();
+}
+
+std::string AgregadoParcial::Etiqueta(const EspecificacionAgregado& especificacion) {
+    static const char* const NOMBRES[] = {"COUNT", "SUM", "MIN", "MAX", "AVG"};
+    return std::string(NOMBRES[static_cast<uint8_t>(especificacion.funcion)]) + "(" +
+           (especificacion.columna.empty() ? "*" : especificacion.columna) + ")";
+}
+
+Status EscaneoParalelo::PrepararAgregados(const std::vector<ColumnMetadata>& columnas,
+                                          const std::vector<EspecificacionAgregado>& especificaciones,
+                                          std::vector<AgregadoParcial>& agregados) {
+    agregados.clear();
+    for (const auto& especificacion : especificaciones) {
+        AgregadoParcial agregado;
+        agregado.funcion = especificacion.funcion;
+        if (!especificacion.columna.empty()) {
+            for (uint32_t i = 0; i < columnas.size(); ++i) {
+                const std::string& nombre = columnas[i].name;
+                if (nombre.size() == especificacion.columna.size() &&
+                    std::equal(nombre.begin(), nombre.end(), especificacion.columna.begin(), [](char a, char b) {
+                        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+                    })) {
+                    agregado.columna = static_cast<int32_t>(i);
+                    break;
+                }
+            }
+            if (agregado.columna < 0) {
+                std::cerr << "Error: Columna '" << especificacion.columna << "' de "
+                          << AgregadoParcial::Etiqueta(especificacion) << " no encontrada en el esquema." << std::endl;
+                agregados.clear();
+                return Status::NOT_FOUND;
+            }
+            agregado.tipo = columnas[agregado.columna].type;
+            if (agregado.funcion != FuncionAgregado::COUNT &&
+                agregado.tipo != ColumnType::INT && agregado.tipo != ColumnType::REAL) {
+                std::cerr << "Error: " << AgregadoParcial::Etiqueta(especificacion)
+                          << " solo admite columnas INT o REAL." << std::endl;
+                agregados.clear();
+                return Status::INVALID_ARGUMENT;
+            }
+        } else if (agregado.funcion != FuncionAgregado::COUNT) {
+            std::cerr << "Error: " << AgregadoParcial::Etiqueta(especificacion) << " necesita una columna." << std::endl;
+            agregados.clear();
+            return Status::INVALID_ARGUMENT;
+        }
+        agregados.push_back(agregado);
+    }
+    return Status::OK;
+}
+
+// ===== RECORRIDO =====
+
+/**
+ * @brief Tramo [inicio, fin) de morsels pendientes de un trabajador.
+ * El dueño avanza inicio y los ladrones retroceden fin, así que cada uno
+ * recorre páginas consecutivas la mayor parte del tiempo.
+ */
+struct EscaneoParalelo::ColaMorsels {
+    std::mutex mutex;
+    size_t inicio = 0;
+    size_t fin = 0;
+
+    bool TomarPrimero(size_t& morsel) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (inicio >= fin) return false;
+        morsel = inicio++;
+        return true;
+    }
+
+    bool RobarUltimo(size_t& morsel) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (inicio >= fin) return false;
+        morsel = --fin;
+        return true;
+    }
+};
+
+EscaneoParalelo::EscaneoParalelo(GestorBuffer& gestor_buffer, const DisposicionRegistro& disposicion,
+                                 FormatoAlmacenamiento formato, std::vector<PageId> paginas, std::shared_ptr<const FiltroCompilado> filtro,
+                                 uint32_t hilos_pool, const OpcionesEscaneoParalelo& opciones)
+    : gestor_buffer_(gestor_buffer)
+    , disposicion_(disposicion)
+    , formato_(formato)
+    , paginas_(std::move(paginas))
+    , filtro_(std::move(filtro))
+    , paginas_por_morsel_(std::max<uint32_t>(1, opciones.paginas_por_morsel)) {
+    if (filtro_ && filtro_->EstaVacio()) {
+        filtro_.reset();
+    }
+    numero_morsels_ = (paginas_.size() + paginas_por_morsel_ - 1) / paginas_por_morsel_;
+    uint32_t trabajadores = opciones.numero_hilos == 0 ? hilos_pool : std::min(opciones.numero_hilos, hilos_pool);
+    // Cada trabajador mantiene una página anclada: se deja la mitad del pool para los demás
+    uint32_t limite_buffer = std::max<uint32_t>(1, gestor_buffer_.GetPoolSize() / 2);
+    trabajadores = std::min<uint32_t>({trabajadores, limite_buffer, static_cast<uint32_t>(std::max<size_t>(1, numero_morsels_))});
+    numero_trabajadores_ = std::max<uint32_t>(1, trabajadores);
+}
+
+Status EscaneoParalelo::Ejecutar(PoolHilos& pool, const ProcesadorPagina& procesador, const std::vector<bool>& columnas) {
+    estadisticas_ = EstadisticasEscaneoParalelo();
+    estadisticas_.trabajadores = numero_trabajadores_;
+    estadisticas_.morsels = numero_morsels_;
+    if (numero_morsels_ == 0) {
+        return Status::OK;
+    }
+    std::vector<bool> proyeccion;
+    if (!columnas.empty()) {
+        proyeccion = columnas;
+        proyeccion.resize(disposicion_.NumeroColumnas(), false);
+        if (filtro_) {
+            filtro_->ColumnasUsadas(proyeccion);
+        }
+    }
+
+    // Tramos contiguos y del mismo tamaño (±1) por trabajador
+    std::vector<std::unique_ptr<ColaMorsels>> colas;
+    colas.reserve(numero_trabajadores_);
+    for (uint32_t t = 0; t < numero_trabajadores_; ++t) {
+        auto cola = std::make_unique<ColaMorsels>();
+        cola->inicio = numero_morsels_ * t / numero_trabajadores_;
+        cola->fin = numero_morsels_ * (t + 1) / numero_trabajadores_;
+        colas.push_back(std::move(cola));
+    }
+
+    std::vector<std::future<EstadisticasEscaneoParalelo>> trabajadores;
+    trabajadores.reserve(numero_trabajadores_);
+    for (uint32_t t = 0; t < numero_trabajadores_; ++t) {
+        trabajadores.push_back(pool.Encolar([this, t, &colas, &procesador, &proyeccion]() {
+            return Trabajar(t, colas, procesador, proyeccion);
+        }));
+    }
+    for (auto& trabajador : trabajadores) {
+        EstadisticasEscaneoParalelo parcial = trabajador.get();
+        estadisticas_.morsels_robados += parcial.morsels_robados;
+        estadisticas_.paginas += parcial.paginas;
+        estadisticas_.paginas_descartadas += parcial.paginas_descartadas;
+        estadisticas_.registros_examinados += parcial.registros_examinados;
+        estadisticas_.registros_seleccionados += parcial.registros_seleccionados;
+    }
+    return Status::OK;
+}
+
+Status EscaneoParalelo::Agregar(PoolHilos& pool, std::vector<AgregadoParcial>& agregados) {
+    std::vector<std::vector<AgregadoParcial>> parciales(numero_trabajadores_, agregados);
+    // Solo se decodifican las columnas de los agregados (ninguna para COUNT(*)) y las del filtro
+    std::vector<bool> columnas(disposicion_.NumeroColumnas(), false);
+    for (const AgregadoParcial& agregado : agregados) {
+        if (agregado.columna >= 0) {
+            columnas[agregado.columna] = true;
+        }
+    }
+    Status estado = Ejecutar(pool, [&parciales](uint32_t trabajador, size_t, PageId,
+                                                const std::vector<VistaRegistro>& vistas,
+                                                const std::vector<uint32_t>&,
+                                                const std::vector<uint32_t>& seleccion) {
+        for (AgregadoParcial& agregado : parciales[trabajador]) {
+            for (uint32_t posicion : seleccion) {
+                agregado.Acumular(vistas[posicion]);
+            }
+        }
+    }, columnas);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    for (const auto& parcial : parciales) {
+        for (size_t i = 0; i < agregados.size(); ++i) {
+            agregados[i].Combinar(parcial[i]);
+        }
+    }
+    return Status::OK;
+}
+
+EstadisticasEscaneoParalelo EscaneoParalelo::Trabajar(uint32_t trabajador, std::vector<std::unique_ptr<ColaMorsels>>& colas,
+                                                      const ProcesadorPagina& procesador,
+                                                      const std::vector<bool>& columnas) {
+    EstadisticasEscaneoParalelo parcial;
+    LectorPaginaDatos lector(&disposicion_, formato_, columnas);
+    std::vector<VistaRegistro> vistas;
+    std::vector<uint32_t> slots;
+    std::vector<uint32_t> seleccion;
+    // Solo se precarga si los morsels de todos los trabajadores caben holgadamente en el pool
+    const bool precargar = static_cast<uint64_t>(numero_trabajadores_) * paginas_por_morsel_ * 2 <= gestor_buffer_.GetPoolSize();
+
+    size_t morsel = 0;
+    while (true) {
+        bool encontrado = colas[trabajador]->TomarPrimero(morsel);
+        for (uint32_t paso = 1; !encontrado && paso < numero_trabajadores_; ++paso) {
+            if (colas[(trabajador + paso) % numero_trabajadores_]->RobarUltimo(morsel)) {
+                encontrado = true;
+                parcial.morsels_robados++;
+            }
+        }
+        if (!encontrado) {
+            break;
+        }
+
+        size_t primera = morsel * paginas_por_morsel_;
+        size_t ultima = std::min(paginas_.size(), primera + paginas_por_morsel_);
+        if (precargar) {
+            gestor_buffer_.PrecargarPaginas(std::vector<BlockId>(paginas_.begin() + primera, paginas_.begin() + ultima));
+        }
+        for (size_t i = primera; i < ultima; ++i) {
+            PageId id_pagina = paginas_[i];
+            Byte* datos = nullptr;
+            if (gestor_buffer_.PinPage(id_pagina, datos) != Status::OK || datos == nullptr) {
+                std::cerr << "Advertencia: No se pudo anclar la página " << id_pagina << " durante el recorrido paralelo." << std::endl;
+                continue;
+            }
+            if (filtro_ && filtro_->DescartaPagina(datos)) {
+                parcial.paginas_descartadas++;
+                gestor_buffer_.UnpinPage(id_pagina, false);
+                continue;
+            }
+            if (!lector.Cargar(datos)) {
+                gestor_buffer_.UnpinPage(id_pagina, false);
+                continue;
+            }
+            vistas.clear();
+            slots.clear();
+            for (uint32_t slot = 0; slot < lector.NumeroSlots(); ++slot) {
+                const Byte* registro = nullptr;
+                uint32_t longitud = 0;
+                if (!lector.Obtener(slot, registro, longitud)) {
+                    continue;
+                }
+                VistaRegistro vista(registro, longitud, disposicion_);
+                if (vista.EsValida()) {
+                    vistas.push_back(vista);
+                    slots.push_back(slot);
+                }
+            }
+            if (filtro_) {
+                filtro_->FiltrarLote(vistas, seleccion);
+            } else {
+                seleccion.resize(vistas.size());
+                for (uint32_t k = 0; k < seleccion.size(); ++k) {
+                    seleccion[k] = k;
+                }
+            }
+            parcial.paginas++;
+            parcial.registros_examinados += vistas.size();
+            parcial.registros_seleccionados += seleccion.size();
+            procesador(trabajador, morsel, id_pagina, vistas, slots, seleccion);
+            gestor_buffer_.UnpinPage(id_pagina, false);
+        }
+    }
+    return parcial;
+}
@@ -0,0 +1,173 @@
+// record_manager/escaneo_paralelo.h - Recorrido de tablas en paralelo por morsels, con agregados parciales
+// Reparte las páginas de datos entre varios hilos en lugar de recorrerlas en el hilo que consulta
+
+#ifndef ESCANEO_PARALELO_H
+#define ESCANEO_PARALELO_H
+
+#include "../include/common.h"
+#include "../include/pool_hilos.h"
+#include "../data_storage/gestor_buffer.h"
+#include "formato_registro.h"
+#include "filtro_compilado.h"
+#include "pagina_pax.h"
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class FuncionAgregado : uint8_t {
+    COUNT = 0,
+    SUM,
+    MIN,
+    MAX,
+    AVG
+};
+
+/**
+ * @brief Agregado pedido en un SELECT: función y columna (vacía = COUNT(*)).
+ */
+struct EspecificacionAgregado {
+    FuncionAgregado funcion = FuncionAgregado::COUNT;
+    std::string columna;
+};
+
+/**
+ * @brief Estado de un agregado sobre una parte de la tabla.
+ *
+ * Cada trabajador acumula en su propia copia y las copias se combinan al terminar,
+ * así que acumular no necesita sincronización. Las columnas INT se suman en
+ * int64_t (exacto) y las REAL en double; los nulos no cuentan salvo en COUNT(*).
+ */
+struct AgregadoParcial {
+    FuncionAgregado funcion = FuncionAgregado::COUNT;
+    int32_t columna = -1;                   // -1 = COUNT(*)
+    ColumnType tipo = ColumnType::INT;
+    uint64_t valores = 0;                   // Filas (COUNT(*)) o valores no nulos
+    int64_t suma_entera = 0;
+    int64_t minimo_entero = std::numeric_limits<int64_t>::max();
+    int64_t maximo_entero = std::numeric_limits<int64_t>::min();
+    double suma_real = 0.0;
+    double minimo_real = std::numeric_limits<double>::infinity();
+    double maximo_real = -std::numeric_limits<double>::infinity();
+
+    void Acumular(const VistaRegistro& vista);
+    void Combinar(const AgregadoParcial& otro);
+
+    /**
+     * @brief Resultado final como texto; VALOR_NULO si SUM/MIN/MAX/AVG no vieron valores.
+     */
+    std::string ComoTexto() const;
+
+    /**
+     * @brief Nombre de la columna del resultado, p. ej. "SUM(precio)".
+     */
+    static std::string Etiqueta(const EspecificacionAgregado& especificacion);
+};
+
+struct OpcionesEscaneoParalelo {
+    uint32_t numero_hilos = 0;              // 0 = todos los hilos del pool
+    uint32_t paginas_por_morsel = 16;
+};
+
+struct EstadisticasEscaneoParalelo {
+    uint32_t trabajadores = 0;
+    uint64_t morsels = 0;
+    uint64_t morsels_robados = 0;           // Tomados de la cola de otro trabajador
+    uint64_t paginas = 0;
+    uint64_t paginas_descartadas = 0;       // PAX: el mínimo/máximo de la página excluye el filtro
+    uint64_t registros_examinados = 0;
+    uint64_t registros_seleccionados = 0;
+};
+
+/**
+ * @brief Recorrido paralelo de una lista de páginas de datos.
+ *
+ * La lista se divide en morsels de paginas_por_morsel páginas consecutivas y cada
+ * trabajador recibe un tramo contiguo de morsels en su propia cola. Un trabajador
+ * toma morsels del principio de su cola y, cuando se vacía, roba del final de la
+ * cola de otro: si unas páginas cuestan más que otras (más registros, fallos de
+ * buffer) los hilos que terminan antes ayudan a los demás.
+ *
+ * Cada trabajador ancla una página cada vez, evalúa el FiltroCompilado sobre la
+ * página entera (FiltrarLote) y pasa los registros seleccionados al procesador
+ * mientras la página sigue anclada. Al tomar un morsel se pide su precarga
+ * asíncrona, ya que la lectura secuencial declarada supone un único recorrido.
+ * En las tablas COLUMNAS_PAX las páginas que el filtro descarta por su rango no
+ * se decodifican, y de las demás solo las columnas que se van a leer.
+ *
+ * El GestorBuffer admite anclajes concurrentes; el recorrido solo lee, así que no
+ * debe ejecutarse a la vez que modificaciones de la misma tabla. Ejecutar() espera
+ * a los trabajadores del pool: no debe llamarse desde una tarea del mismo pool.
+ */
+class EscaneoParalelo {
+public:
+    /**
+     * @brief Procesa una página anclada.
+     * @param trabajador Índice del trabajador (0..NumeroTrabajadores()-1); un mismo
+     *        trabajador nunca llama dos veces a la vez
+     * @param morsel Índice del morsel, en el orden de la lista de páginas
+     * @param vistas Registros válidos de la página
+     * @param slots Slot de cada vista, para construir su RecordId
+     * @param seleccion Posiciones en vistas de los registros que cumplen el filtro
+     */
+    using ProcesadorPagina = std::function<void(uint32_t trabajador, size_t morsel, PageId id_pagina,
+                                                const std::vector<VistaRegistro>& vistas,
+                                                const std::vector<uint32_t>& slots,
+                                                const std::vector<uint32_t>& seleccion)>;
+
+    EscaneoParalelo(GestorBuffer& gestor_buffer, const DisposicionRegistro& disposicion,
+                    FormatoAlmacenamiento formato, std::vector<PageId> paginas, std::shared_ptr<const FiltroCompilado> filtro,
+                    uint32_t hilos_pool, const OpcionesEscaneoParalelo& opciones = OpcionesEscaneoParalelo());
+
+    uint32_t NumeroTrabajadores() const { return numero_trabajadores_; }
+    size_t NumeroMorsels() const { return numero_morsels_; }
+
+    /**
+     * @brief Recorre todas las páginas y espera a que terminen los trabajadores.
+     * @param columnas Columnas que lee el procesador (vacío = todas); en páginas PAX
+     *        las demás, salvo las del filtro, no se decodifican y salen nulas
+     * @return Status::OK; las páginas que no se pueden anclar se saltan con un aviso
+     */
+    Status Ejecutar(PoolHilos& pool, const ProcesadorPagina& procesador, const std::vector<bool>& columnas = {});
+
+    /**
+     * @brief Calcula los agregados: parciales por trabajador, combinados al final.
+     * @param agregados [in/out] Preparados con PrepararAgregados; salen con el resultado
+     */
+    Status Agregar(PoolHilos& pool, std::vector<AgregadoParcial>& agregados);
+
+    /**
+     * @brief Resuelve las columnas de los agregados (sin distinguir mayúsculas).
+     * También sirve para acumular a mano sobre un cursor con Acumular().
+     * @param columnas Columnas de la tabla, en orden
+     * @return NOT_FOUND si una columna no existe; INVALID_ARGUMENT si SUM, AVG, MIN
+     *         o MAX se piden sobre una columna que no es INT ni REAL
+     */
+    static Status PrepararAgregados(const std::vector<ColumnMetadata>& columnas,
+                                    const std::vector<EspecificacionAgregado>& especificaciones,
+                                    std::vector<AgregadoParcial>& agregados);
+
+    const EstadisticasEscaneoParalelo& Estadisticas() const { return estadisticas_; }
+
+private:
+    GestorBuffer& gestor_buffer_;
+    const DisposicionRegistro& disposicion_;
+    FormatoAlmacenamiento formato_;
+    std::vector<PageId> paginas_;
+    std::shared_ptr<const FiltroCompilado> filtro_;
+    uint32_t paginas_por_morsel_;
+    size_t numero_morsels_;
+    uint32_t numero_trabajadores_;
+    EstadisticasEscaneoParalelo estadisticas_;
+
+    struct ColaMorsels;
+
+    /**
+     * @brief Bucle de un trabajador: vacía su cola y después roba de las demás.
+     */
+    EstadisticasEscaneoParalelo Trabajar(uint32_t trabajador, std::vector<std::unique_ptr<ColaMorsels>>& colas,
+                                         const ProcesadorPagina& procesador, const std::vector<bool>& columnas);
+};
+
+#endif // ESCANEO_PARALELO_H
@@ -0,0 +1,393 @@
+// record_manager/filtro_compilado.cpp - Implementación de los filtros WHERE compilados
+#include "filtro_compilado.h"
+#include "pagina_pax.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <numeric>
+#include <string_view>
+
+namespace {
+
+std::string Minusculas(std::string texto) {
+    std::transform(texto.begin(), texto.end(), texto.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return texto;
+}
+
+std::string RecortarEspacios(const std::string& texto) {
+    size_t inicio = texto.find_first_not_of(" \t\r\n");
+    if (inicio == std::string::npos) {
+        return std::string();
+    }
+    size_t fin = texto.find_last_not_of(" \t\r\n");
+    return texto.substr(inicio, fin - inicio + 1);
+}
+
+// Los CHAR pueden llegar rellenados con espacios hasta su tamaño
+std::string_view SinRellenoFinal(std::string_view texto) {
+    size_t fin = texto.find_last_not_of(' ');
+    return (fin == std::string_view::npos) ? std::string_view() : texto.substr(0, fin + 1);
+}
+
+bool EsFinDePalabra(const std::string& texto, size_t posicion) {
+    return posicion >= texto.size() || std::isspace(static_cast<unsigned char>(texto[posicion]));
+}
+
+bool ParsearCondicion(const std::string& texto, CondicionFiltro& condicion) {
+    size_t posicion = texto.find_first_of("=<>!");
+    if (posicion == std::string::npos) {
+        return false;
+    }
+    char primero = texto[posicion];
+    char segundo = (posicion + 1 < texto.size()) ? texto[posicion + 1] : '\0';
+    size_t longitud_operador = 2;
+    if (primero == '<' && segundo == '=') condicion.operador = OperadorComparacion::MENOR_IGUAL;
+    else if (primero == '>' && segundo == '=') condicion.operador = OperadorComparacion::MAYOR_IGUAL;
+    else if ((primero == '<' && segundo == '>') || (primero == '!' && segundo == '=')) condicion.operador = OperadorComparacion::DISTINTO;
+    else {
+        longitud_operador = 1;
+        if (primero == '<') condicion.operador = OperadorComparacion::MENOR;
+        else if (primero == '>') condicion.operador = OperadorComparacion::MAYOR;
+        else if (primero == '=') condicion.operador = OperadorComparacion::IGUAL;
+        else return false; // '!' suelto
+    }
+
+    condicion.columna = RecortarEspacios(texto.substr(0, posicion));
+    condicion.valor = RecortarEspacios(texto.substr(posicion + longitud_operador));
+    const std::string& valor = condicion.valor;
+    if (valor.size() >= 2 && (valor.front() == '\'' || valor.front() == '"') && valor.back() == valor.front()) {
+        condicion.valor = valor.substr(1, valor.size() - 2);
+    }
+    return !condicion.columna.empty();
+}
+
+template <typename T>
+bool Comparar(const T& izquierda, const T& derecha, OperadorComparacion operador) {
+    switch (operador) {
+        case OperadorComparacion::IGUAL: return izquierda == derecha;
+        case OperadorComparacion::DISTINTO: return !(izquierda == derecha);
+        case OperadorComparacion::MENOR: return izquierda < derecha;
+        case OperadorComparacion::MENOR_IGUAL: return !(derecha < izquierda);
+        case OperadorComparacion::MAYOR: return derecha < izquierda;
+        case OperadorComparacion::MAYOR_IGUAL: return !(izquierda < derecha);
+    }
+    return false;
+}
+
+// Bucle sin saltos sobre arrays contiguos, para que el compilador lo vectorice
+template <typename T, typename Comparador>
+void CompararBloque(const T* valores, const uint8_t* nulos, size_t n, T constante, uint8_t* mascara,
+                    Comparador comparador) {
+    for (size_t k = 0; k < n; ++k) {
+        mascara[k] = static_cast<uint8_t>(comparador(valores[k], constante)) & static_cast<uint8_t>(nulos[k] ^ 1u);
+    }
+}
+
+template <typename T>
+void CompararBloque(const T* valores, const uint8_t* nulos, size_t n, T constante, uint8_t* mascara,
+                    OperadorComparacion operador) {
+    switch (operador) {
+        case OperadorComparacion::IGUAL: CompararBloque(valores, nulos, n, constante, mascara, std::equal_to<T>()); break;
+        case OperadorComparacion::DISTINTO: CompararBloque(valores, nulos, n, constante, mascara, std::not_equal_to<T>()); break;
+        case OperadorComparacion::MENOR: CompararBloque(valores, nulos, n, constante, mascara, std::less<T>()); break;
+        case OperadorComparacion::MENOR_IGUAL: CompararBloque(valores, nulos, n, constante, mascara, std::less_equal<T>()); break;
+        case OperadorComparacion::MAYOR: CompararBloque(valores, nulos, n, constante, mascara, std::greater<T>()); break;
+        case OperadorComparacion::MAYOR_IGUAL: CompararBloque(valores, nulos, n, constante, mascara, std::greater_equal<T>()); break;
+    }
+}
+
+// Con los valores de la página en [minimo, maximo], indica si alguno puede cumplir la comparación
+template <typename T>
+bool RangoPuedeCumplir(const T& minimo, const T& maximo, const T& constante, OperadorComparacion operador) {
+    switch (operador) {
+        case OperadorComparacion::IGUAL: return !(constante < minimo) && !(maximo < constante);
+        case OperadorComparacion::DISTINTO: return !(minimo == constante && maximo == constante);
+        case OperadorComparacion::MENOR: return minimo < constante;
+        case OperadorComparacion::MENOR_IGUAL: return !(constante < minimo);
+        case OperadorComparacion::MAYOR: return constante < maximo;
+        case OperadorComparacion::MAYOR_IGUAL: return !(maximo < constante);
+    }
+    return true;
+}
+
+} // namespace
+
+// ===== PARSEO =====
+
+Status ParsearCondiciones(const std::string& texto, std::vector<CondicionFiltro>& condiciones) {
+    condiciones.clear();
+    // AND solo separa si va entre espacios: no corta columnas o valores que lo contengan
+    const std::string minusculas = Minusculas(texto);
+    size_t inicio = 0;
+    while (true) {
+        size_t fin = minusculas.find("and", inicio);
+        while (fin != std::string::npos && !((fin == 0 || EsFinDePalabra(minusculas, fin - 1)) && EsFinDePalabra(minusculas, fin + 3))) {
+            fin = minusculas.find("and", fin + 1);
+        }
+        std::string fragmento = texto.substr(inicio, fin == std::string::npos ? std::string::npos : fin - inicio);
+        CondicionFiltro condicion;
+        if (!ParsearCondicion(fragmento, condicion)) {
+            std::cerr << "Error: Condición inválida '" << RecortarEspacios(fragmento) << "'. Use 'columna operador valor'." << std::endl;
+            condiciones.clear();
+            return Status::INVALID_ARGUMENT;
+        }
+        condiciones.push_back(std::move(condicion));
+        if (fin == std::string::npos) {
+            break;
+        }
+        inicio = fin + 3;
+    }
+    return Status::OK;
+}
+
+// ===== COMPILACIÓN =====
+
+Status FiltroCompilado::Compilar(const std::vector<ColumnMetadata>& columnas,
+                                 const std::vector<CondicionFiltro>& condiciones, FiltroCompilado& filtro) {
+    std::vector<Instruccion> programa;
+    for (const auto& condicion : condiciones) {
+        const std::string buscada = Minusculas(condicion.columna);
+        auto columna = std::find_if(columnas.begin(), columnas.end(), [&](const ColumnMetadata& c) {
+            return Minusculas(std::string(c.name)) == buscada;
+        });
+        if (columna == columnas.end()) {
+            std::cerr << "Error: Columna de condición '" << condicion.columna << "' no encontrada en el esquema." << std::endl;
+            return Status::NOT_FOUND;
+        }
+
+        Instruccion instruccion{static_cast<uint32_t>(columna - columnas.begin()), columna->type, condicion.operador,
+                               condicion.valor == DisposicionRegistro::VALOR_NULO, 0, 0.0, std::string()};
+        if (!instruccion.constante_nula) {
+            const std::string& valor = condicion.valor;
+            size_t consumidos = 0;
+            try {
+                switch (instruccion.tipo) {
+                    case ColumnType::INT:
+                        instruccion.entero = std::stoll(valor, &consumidos);
+                        break;
+                    case ColumnType::REAL:
+                        instruccion.real = std::stod(valor, &consumidos);
+                        break;
+                    case ColumnType::BOOL: {
+                        std::string booleano = Minusculas(valor);
+                        if (booleano != "true" && booleano != "false" && booleano != "1" && booleano != "0") {
+                            throw std::invalid_argument(valor);
+                        }
+                        instruccion.entero = (booleano == "true" || booleano == "1") ? 1 : 0;
+                        consumidos = valor.size();
+                        break;
+                    }
+                    case ColumnType::CHAR:
+                        instruccion.texto = std::string(SinRellenoFinal(valor));
+                        consumidos = valor.size();
+                        break;
+                    case ColumnType::VARCHAR:
+                        instruccion.texto = valor;
+                        consumidos = valor.size();
+                        break;
+                }
+            } catch (const std::exception&) {
+                consumidos = std::string::npos;
+            }
+            if (consumidos != valor.size()) {
+                std::cerr << "Error: Valor '" << valor << "' no es válido para la columna '" << columna->name << "'." << std::endl;
+                return Status::INVALID_ARGUMENT;
+            }
+        }
+        programa.push_back(std::move(instruccion));
+    }
+
+    // Primero las comparaciones de ancho fijo: descartan filas antes de tocar los textos
+    std::stable_partition(programa.begin(), programa.end(), [](const Instruccion& instruccion) {
+        return instruccion.tipo != ColumnType::CHAR && instruccion.tipo != ColumnType::VARCHAR;
+    });
+    filtro.programa_ = std::move(programa);
+    filtro.numero_columnas_ = static_cast<uint32_t>(columnas.size());
+    return Status::OK;
+}
+
+// ===== EVALUACIÓN =====
+
+bool FiltroCompilado::Evaluar(const VistaRegistro& vista) const {
+    if (!programa_.empty() && vista.NumeroColumnas() < numero_columnas_) {
+        return false; // Registro de otra disposición
+    }
+    for (const auto& instruccion : programa_) {
+        if (!EvaluarInstruccion(instruccion, vista)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t FiltroCompilado::FiltrarLote(const std::vector<VistaRegistro>& vistas, std::vector<uint32_t>& seleccion) const {
+    seleccion.resize(vistas.size());
+    std::iota(seleccion.begin(), seleccion.end(), 0u);
+    if (programa_.empty() || vistas.empty()) {
+        return seleccion.size();
+    }
+    if (vistas.front().NumeroColumnas() < numero_columnas_) {
+        seleccion.clear();
+        return 0;
+    }
+
+    std::vector<uint8_t> nulos;
+    std::vector<uint8_t> mascara;
+    std::vector<int64_t> enteros;
+    std::vector<double> reales;
+    for (const auto& instruccion : programa_) {
+        const size_t n = seleccion.size();
+        if (n == 0) {
+            break;
+        }
+        nulos.resize(n);
+        mascara.resize(n);
+        for (size_t k = 0; k < n; ++k) {
+            nulos[k] = vistas[seleccion[k]].EsNulo(instruccion.columna) ? 1 : 0;
+        }
+
+        if (instruccion.constante_nula) {
+            for (size_t k = 0; k < n; ++k) {
+                mascara[k] = (instruccion.operador == OperadorComparacion::IGUAL) ? nulos[k]
+                           : (instruccion.operador == OperadorComparacion::DISTINTO) ? static_cast<uint8_t>(nulos[k] ^ 1u)
+                           : 0;
+            }
+        } else {
+            switch (instruccion.tipo) {
+                case ColumnType::INT:
+                case ColumnType::BOOL:
+                    enteros.resize(n);
+                    for (size_t k = 0; k < n; ++k) {
+                        const VistaRegistro& vista = vistas[seleccion[k]];
+                        enteros[k] = (instruccion.tipo == ColumnType::INT) ? vista.ObtenerEntero(instruccion.columna)
+                                                                          : (vista.ObtenerBooleano(instruccion.columna) ? 1 : 0);
+                    }
+                    CompararBloque<int64_t>(enteros.data(), nulos.data(), n, instruccion.entero, mascara.data(), instruccion.operador);
+                    break;
+                case ColumnType::REAL:
+                    reales.resize(n);
+                    for (size_t k = 0; k < n; ++k) {
+                        reales[k] = vistas[seleccion[k]].ObtenerReal(instruccion.columna);
+                    }
+                    CompararBloque<double>(reales.data(), nulos.data(), n, instruccion.real, mascara.data(), instruccion.operador);
+                    break;
+                case ColumnType::CHAR:
+                case ColumnType::VARCHAR:
+                    for (size_t k = 0; k < n; ++k) {
+                        mascara[k] = (!nulos[k] && EvaluarInstruccion(instruccion, vistas[seleccion[k]])) ? 1 : 0;
+                    }
+                    break;
+            }
+        }
+
+        // Compactación sin saltos del vector de selección
+        size_t escritos = 0;
+        for (size_t k = 0; k < n; ++k) {
+            seleccion[escritos] = seleccion[k];
+            escritos += mascara[k];
+        }
+        seleccion.resize(escritos);
+    }
+    return seleccion.size();
+}
+
+std::function<bool(const VistaRegistro&)> FiltroCompilado::ComoPredicado() const {
+    FiltroCompilado copia = *this;
+    return [copia](const VistaRegistro& vista) { return copia.Evaluar(vista); };
+}
+
+bool FiltroCompilado::DescartaPagina(const Byte* datos_pagina) const {
+    if (programa_.empty() || !PaginaPAX::EsPaginaPAX(datos_pagina)) {
+        return false;
+    }
+    for (const Instruccion& instruccion : programa_) {
+        RangoColumnaPAX rango;
+        if (!PaginaPAX::LeerRango(datos_pagina, instruccion.columna, instruccion.tipo, rango)) {
+            return false;
+        }
+        if (instruccion.constante_nula) {
+            if (instruccion.operador == OperadorComparacion::IGUAL && !rango.con_nulos) return true;
+            if (instruccion.operador == OperadorComparacion::DISTINTO && !rango.con_valores) return true;
+            if (instruccion.operador != OperadorComparacion::IGUAL && instruccion.operador != OperadorComparacion::DISTINTO) return true;
+            continue;
+        }
+        if (!rango.con_valores) {
+            return true; // Solo nulos: ninguna comparación con una constante se cumple
+        }
+        if (!rango.con_rango) {
+            continue;
+        }
+        bool puede_cumplir = true;
+        switch (instruccion.tipo) {
+            case ColumnType::INT:
+            case ColumnType::BOOL:
+                puede_cumplir = RangoPuedeCumplir(rango.minimo_entero, rango.maximo_entero, instruccion.entero, instruccion.operador);
+                break;
+            case ColumnType::REAL:
+                puede_cumplir = RangoPuedeCumplir(rango.minimo_real, rango.maximo_real, instruccion.real, instruccion.operador);
+                break;
+            case ColumnType::CHAR:
+            case ColumnType::VARCHAR: {
+                // Con prefijos el orden se conserva pero no la igualdad: p(x) < p(y) implica x < y
+                std::string_view prefijo = std::string_view(instruccion.texto).substr(0, sizeof(DescriptorMinipagina::minimo));
+                switch (instruccion.operador) {
+                    case OperadorComparacion::IGUAL:
+                        puede_cumplir = !(prefijo < rango.prefijo_minimo) && !(rango.prefijo_maximo < prefijo);
+                        break;
+                    case OperadorComparacion::MENOR:
+                    case OperadorComparacion::MENOR_IGUAL:
+                        puede_cumplir = !(prefijo < rango.prefijo_minimo);
+                        break;
+                    case OperadorComparacion::MAYOR:
+                    case OperadorComparacion::MAYOR_IGUAL:
+                        puede_cumplir = !(rango.prefijo_maximo < prefijo);
+                        break;
+                    case OperadorComparacion::DISTINTO:
+                        break;
+                }
+                break;
+            }
+        }
+        if (!puede_cumplir) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FiltroCompilado::ColumnasUsadas(std::vector<bool>& columnas) const {
+    for (const Instruccion& instruccion : programa_) {
+        if (instruccion.columna < columnas.size()) {
+            columnas[instruccion.columna] = true;
+        }
+    }
+}
+
+// ===== AUXILIARES PRIVADOS =====
+
+bool FiltroCompilado::EvaluarInstruccion(const Instruccion& instruccion, const VistaRegistro& vista) const {
+    bool nulo = vista.EsNulo(instruccion.columna);
+    if (instruccion.constante_nula) {
+        if (instruccion.operador == OperadorComparacion::IGUAL) return nulo;
+        if (instruccion.operador == OperadorComparacion::DISTINTO) return !nulo;
+        return false;
+    }
+    if (nulo) {
+        return false;
+    }
+    switch (instruccion.tipo) {
+        case ColumnType::INT:
+            return Comparar<int64_t>(vista.ObtenerEntero(instruccion.columna), instruccion.entero, instruccion.operador);
+        case ColumnType::BOOL:
+            return Comparar<int64_t>(vista.ObtenerBooleano(instruccion.columna) ? 1 : 0, instruccion.entero, instruccion.operador);
+        case ColumnType::REAL:
+            return Comparar<double>(vista.ObtenerReal(instruccion.columna), instruccion.real, instruccion.operador);
+        case ColumnType::CHAR:
+            return Comparar<std::string_view>(SinRellenoFinal(vista.ObtenerTexto(instruccion.columna)), instruccion.texto, instruccion.operador);
+        case ColumnType::VARCHAR:
+            // Los textos se comparan sobre el frame, sin copiarlos
+            return Comparar<std::string_view>(vista.ObtenerTexto(instruccion.columna), instruccion.texto, instruccion.operador);
+    }
+    return false;
+}
@@ -0,0 +1,122 @@
+// record_manager/filtro_compilado.h - Condiciones WHERE compiladas contra la disposición de la tabla
+// Sustituye a interpretar cada condición, con comparaciones de texto, en cada registro
+
+#ifndef FILTRO_COMPILADO_H
+#define FILTRO_COMPILADO_H
+
+#include "../include/common.h"
+#include "formato_registro.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class OperadorComparacion : uint8_t {
+    IGUAL = 0,
+    DISTINTO,
+    MENOR,
+    MENOR_IGUAL,
+    MAYOR,
+    MAYOR_IGUAL
+};
+
+/**
+ * @brief Condición "columna operador valor" tal como se escribe en un WHERE.
+ */
+struct CondicionFiltro {
+    std::string columna;
+    OperadorComparacion operador = OperadorComparacion::IGUAL;
+    std::string valor;      // Sin comillas; VALOR_NULO para comparar con NULL
+};
+
+/**
+ * @brief Separa un WHERE en condiciones unidas por AND (sin distinguir mayúsculas).
+ * Operadores: =, <>, !=, <, <=, >, >=. Los valores pueden ir entre comillas simples
+ * o dobles. La columna y el valor se conservan tal como se escribieron.
+ * @return INVALID_ARGUMENT si alguna condición no tiene operador o columna
+ */
+Status ParsearCondiciones(const std::string& texto, std::vector<CondicionFiltro>& condiciones);
+
+/**
+ * @brief Conjunción de condiciones compilada una vez contra las columnas de la tabla.
+ *
+ * Compilar() resuelve cada columna a su posición en el esquema y convierte cada
+ * constante al tipo de la columna, así que evaluar un registro ya no convierte ni
+ * busca nada. Las condiciones sobre columnas de ancho fijo se evalúan antes que
+ * las de texto.
+ *
+ * FiltrarLote() evalúa una página entera columna a columna: cada condición lee su
+ * columna de todos los registros que siguen seleccionados a un array contiguo,
+ * compara ese array con la constante en un bucle sin saltos (el compilador lo
+ * vectoriza) y compacta el vector de selección con el resultado.
+ *
+ * Semántica: NULL solo cumple "= NULL" y "<> NULL"; cualquier otra comparación con
+ * un nulo es falsa. Los CHAR se comparan sin los espacios de relleno finales.
+ */
+class FiltroCompilado {
+public:
+    /**
+     * @brief Compila las condiciones; las columnas se buscan sin distinguir mayúsculas.
+     * @param columnas Columnas de la tabla, en orden
+     * @param condiciones Condiciones unidas por AND (vacío = acepta todo)
+     * @param filtro [out] Filtro compilado
+     * @return NOT_FOUND si una columna no existe; INVALID_ARGUMENT si una constante
+     *         no es del tipo de su columna
+     */
+    static Status Compilar(const std::vector<ColumnMetadata>& columnas,
+                           const std::vector<CondicionFiltro>& condiciones, FiltroCompilado& filtro);
+
+    /**
+     * @brief Evalúa el filtro sobre un solo registro.
+     */
+    bool Evaluar(const VistaRegistro& vista) const;
+
+    /**
+     * @brief Evalúa el filtro sobre un lote de registros de la misma tabla.
+     * @param vistas Registros válidos del lote
+     * @param seleccion [out] Posiciones en vistas de los registros que lo cumplen, en orden
+     * @return Número de registros seleccionados
+     */
+    size_t FiltrarLote(const std::vector<VistaRegistro>& vistas, std::vector<uint32_t>& seleccion) const;
+
+    /**
+     * @brief Adapta el filtro a PredicadoRegistro para las APIs registro a registro.
+     */
+    std::function<bool(const VistaRegistro&)> ComoPredicado() const;
+
+    /**
+     * @brief Indica, con solo el mínimo y el máximo de cada columna en el descriptor de
+     *        una página PAX, que ningún registro de la página cumple el filtro.
+     * Los textos se comparan por sus primeros 8 bytes, así que puede no descartar
+     * páginas que tampoco tienen coincidencias. Con otras páginas devuelve false.
+     */
+    bool DescartaPagina(const Byte* datos_pagina) const;
+
+    /**
+     * @brief Marca en columnas (una entrada por columna de la tabla) las que lee el filtro.
+     */
+    void ColumnasUsadas(std::vector<bool>& columnas) const;
+
+    bool EstaVacio() const { return programa_.empty(); }
+    size_t NumeroCondiciones() const { return programa_.size(); }
+
+private:
+    /**
+     * @brief Una condición resuelta contra el esquema.
+     */
+    struct Instruccion {
+        uint32_t columna;
+        ColumnType tipo;
+        OperadorComparacion operador;
+        bool constante_nula;
+        int64_t entero;             // INT y BOOL
+        double real;
+        std::string texto;          // CHAR (sin relleno) y VARCHAR
+    };
+
+    std::vector<Instruccion> programa_;
+    uint32_t numero_columnas_ = 0;
+
+    bool EvaluarInstruccion(const Instruccion& instruccion, const VistaRegistro& vista) const;
+};
+
+#endif // FILTRO_COMPILADO_H
@@ -0,0 +1,233 @@
+// record_manager/formato_registro.cpp - Implementación del formato binario de registros
+#include "formato_registro.h"
+#include <iostream>  // Para std::cerr
+#include <cstdio>    // Para std::snprintf
+#include <cstdlib>   // Para std::strtoll, std::strtod
+#include <cerrno>
+
+// ===== DISPOSICIÓN =====
+
+DisposicionRegistro::DisposicionRegistro(const std::vector<ColumnMetadata>& columnas)
+    : columnas_(columnas)
+    , offsets_fijos_(columnas.size(), SIN_INDICE)
+    , indices_variables_(columnas.size(), SIN_INDICE)
+    , offset_tabla_variables_(0)
+    , num_variables_(0) {
+    if (columnas_.empty()) {
+        throw std::invalid_argument("DisposicionRegistro: El esquema no tiene columnas.");
+    }
+    uint32_t offset = sizeof(CabeceraRegistro) + static_cast<uint32_t>((columnas_.size() + 7) / 8);
+    for (size_t i = 0; i < columnas_.size(); ++i) {
+        const ColumnMetadata& columna = columnas_[i];
+        if (columna.type == ColumnType::VARCHAR) {
+            indices_variables_[i] = num_variables_++;
+            continue;
+        }
+        if (columna.type == ColumnType::CHAR && columna.size == 0) {
+            throw std::invalid_argument("DisposicionRegistro: La columna CHAR '" + columna.name + "' no tiene tamaño.");
+        }
+        offsets_fijos_[i] = offset;
+        offset += TamañoFijo(columna);
+    }
+    offset_tabla_variables_ = offset;
+    if (TamañoMinimo() > BLOCK_SIZE) {
+        throw std::invalid_argument("DisposicionRegistro: La parte fija del registro no cabe en un bloque.");
+    }
+}
+
+uint32_t DisposicionRegistro::TamañoFijo(const ColumnMetadata& columna) {
+    switch (columna.type) {
+        case ColumnType::INT:  return sizeof(int64_t);
+        case ColumnType::REAL: return sizeof(double);
+        case ColumnType::BOOL: return 1;
+        case ColumnType::CHAR: return columna.size;
+        default:               return 0;
+    }
+}
+
+bool DisposicionRegistro::Coincide(const std::vector<ColumnMetadata>& columnas) const {
+    if (columnas.size() != columnas_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < columnas.size(); ++i) {
+        if (columnas[i].type != columnas_[i].type || columnas[i].size != columnas_[i].size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ===== CODIFICACIÓN =====
+
+namespace {
+
+bool ParsearBooleano(const std::string& texto, bool& valor) {
+    std::string minusculas = texto;
+    std::transform(minusculas.begin(), minusculas.end(), minusculas.begin(), ::tolower);
+    if (minusculas == "1" || minusculas == "true") { valor = true; return true; }
+    if (minusculas == "0" || minusculas == "false") { valor = false; return true; }
+    return false;
+}
+
+} // namespace
+
+Status DisposicionRegistro::Codificar(const std::vector<std::string>& campos, std::vector<Byte>& salida) const {
+    if (campos.size() != columnas_.size()) {
+        std::cerr << "Error (Codificar): Se esperaban " << columnas_.size() << " campos y se recibieron "
+                  << campos.size() << "." << std::endl;
+        return Status::INVALID_ARGUMENT;
+    }
+
+    // Decidir una sola vez qué campos son nulos: ambas pasadas deben coincidir,
+    // o el buffer se dimensionaría sin un VARCHAR que luego sí se copia
+    std::vector<bool> nulos(columnas_.size(), false);
+    for (size_t i = 0; i < columnas_.size(); ++i) {
+        nulos[i] = columnas_[i].is_nullable && campos[i] == VALOR_NULO;
+    }
+
+    // Calcular primero el tamaño total para reservar una sola vez
+    uint32_t longitud = TamañoMinimo();
+    for (size_t i = 0; i < columnas_.size(); ++i) {
+        if (indices_variables_[i] != SIN_INDICE && !nulos[i]) {
+            longitud += static_cast<uint32_t>(campos[i].size());
+        }
+    }
+    if (longitud > UINT16_MAX) {
+        std::cerr << "Error (Codificar): El registro ocupa " << longitud << " bytes, demasiado grande." << std::endl;
+        return Status::INVALID_ARGUMENT;
+    }
+    salida.assign(longitud, 0);
+
+    CabeceraRegistro cabecera{static_cast<uint16_t>(longitud), static_cast<uint16_t>(columnas_.size())};
+    std::memcpy(salida.data(), &cabecera, sizeof(cabecera));
+
+    uint32_t fin_variables = OffsetDatosVariables();
+    for (size_t i = 0; i < columnas_.size(); ++i) {
+        const ColumnMetadata& columna = columnas_[i];
+        const std::string& campo = campos[i];
+        bool es_nulo = nulos[i];
+        if (es_nulo) {
+            salida[OffsetMapaNulos() + i / 8] |= static_cast<Byte>(1u << (i % 8));
+        }
+        Byte* destino = salida.data() + (offsets_fijos_[i] == SIN_INDICE ? 0 : offsets_fijos_[i]);
+
+        switch (columna.type) {
+            case ColumnType::INT: {
+                if (es_nulo) break;
+                errno = 0;
+                char* fin = nullptr;
+                long long valor = std::strtoll(campo.c_str(), &fin, 10);
+                if (campo.empty() || *fin != '\0' || errno == ERANGE) {
+                    std::cerr << "Error (Codificar): '" << campo << "' no es un INT válido para '" << columna.name << "'." << std::endl;
+                    return Status::INVALID_ARGUMENT;
+                }
+                int64_t entero = static_cast<int64_t>(valor);
+                std::memcpy(destino, &entero, sizeof(entero));
+                break;
+            }
+            case ColumnType::REAL: {
+                if (es_nulo) break;
+                char* fin = nullptr;
+                double valor = std::strtod(campo.c_str(), &fin);
+                if (campo.empty() || *fin != '\0') {
+                    std::cerr << "Error (Codificar): '" << campo << "' no es un REAL válido para '" << columna.name << "'." << std::endl;
+                    return Status::INVALID_ARGUMENT;
+                }
+                std::memcpy(destino, &valor, sizeof(valor));
+                break;
+            }
+            case ColumnType::BOOL: {
+                if (es_nulo) break;
+                bool valor = false;
+                if (!ParsearBooleano(campo, valor)) {
+                    std::cerr << "Error (Codificar): '" << campo << "' no es un BOOL válido para '" << columna.name << "'." << std::endl;
+                    return Status::INVALID_ARGUMENT;
+                }
+                *destino = valor ? 1 : 0;
+                break;
+            }
+            case ColumnType::CHAR: {
+                if (es_nulo) break;
+                if (campo.size() > columna.size) {
+                    std::cerr << "Error (Codificar): '" << columna.name << "' excede su tamaño CHAR(" << columna.size << ")." << std::endl;
+                    return Status::INVALID_ARGUMENT;
+                }
+                std::memcpy(destino, campo.data(), campo.size()); // El resto queda a cero
+                break;
+            }
+            case ColumnType::VARCHAR: {
+                if (!es_nulo) {
+                    if (columna.size > 0 && campo.size() > columna.size) {
+                        std::cerr << "Error (Codificar): '" << columna.name << "' excede su tamaño VARCHAR(" << columna.size << ")." << std::endl;
+                        return Status::INVALID_ARGUMENT;
+                    }
+                    std::memcpy(salida.data() + fin_variables, campo.data(), campo.size());
+                    fin_variables += static_cast<uint32_t>(campo.size());
+                }
+                uint16_t fin = static_cast<uint16_t>(fin_variables);
+                std::memcpy(salida.data() + offset_tabla_variables_ + indices_variables_[i] * sizeof(uint16_t), &fin, sizeof(fin));
+                break;
+            }
+        }
+    }
+    return Status::OK;
+}
+
+// ===== VISTA =====
+
+VistaRegistro::VistaRegistro(const Byte* datos, uint32_t longitud_disponible, const DisposicionRegistro& disposicion)
+    : datos_(nullptr), disposicion_(&disposicion), longitud_(0) {
+    if (datos == nullptr || longitud_disponible < disposicion.TamañoMinimo()) {
+        return;
+    }
+    DisposicionRegistro::CabeceraRegistro cabecera;
+    std::memcpy(&cabecera, datos, sizeof(cabecera));
+    if (cabecera.numero_columnas != disposicion.NumeroColumnas() ||
+        cabecera.longitud_total < disposicion.TamañoMinimo() ||
+        cabecera.longitud_total > longitud_disponible) {
+        return; // Registro dañado o de otra tabla: la vista queda inválida
+    }
+    datos_ = datos;
+    longitud_ = cabecera.longitud_total;
+}
+
+std::string_view VistaRegistro::ObtenerTexto(uint32_t columna) const {
+    const ColumnMetadata& metadata = disposicion_->Columna(columna);
+    if (metadata.type == ColumnType::CHAR) {
+        const Byte* inicio = datos_ + disposicion_->OffsetFijo(columna);
+        const void* terminador = std::memchr(inicio, '\0', metadata.size);
+        size_t longitud = terminador ? static_cast<const Byte*>(terminador) - inicio : metadata.size;
+        return std::string_view(inicio, longitud);
+    }
+    uint32_t indice = disposicion_->IndiceVariable(columna);
+    if (indice == DisposicionRegistro::SIN_INDICE) {
+        return std::string_view();
+    }
+    uint32_t inicio = (indice == 0) ? disposicion_->OffsetDatosVariables() : LeerOffsetVariable(indice - 1);
+    uint32_t fin = LeerOffsetVariable(indice);
+    if (fin < inicio || fin > longitud_) {
+        return std::string_view();
+    }
+    return std::string_view(datos_ + inicio, fin - inicio);
+}
+
+std::string VistaRegistro::ObtenerComoTexto(uint32_t columna) const {
+    if (EsNulo(columna)) {
+        return DisposicionRegistro::VALOR_NULO;
+    }
+    switch (disposicion_->Columna(columna).type) {
+        case ColumnType::INT:
+            return std::to_string(ObtenerEntero(columna));
+        case ColumnType::REAL: {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.15g", ObtenerReal(columna));
+            return buffer;
+        }
+        case ColumnType::BOOL:
+            return ObtenerBooleano(columna) ? "true" : "false";
+        case ColumnType::CHAR:
+        case ColumnType::VARCHAR:
+            return std::string(ObtenerTexto(columna));
+    }
+    return std::string();
+}
@@ -0,0 +1,146 @@
+// record_manager/formato_registro.h - Formato binario de registros y vista sin copia
+// Sustituye a la serialización en texto con delimitadores '|'
+
+#ifndef FORMATO_REGISTRO_H
+#define FORMATO_REGISTRO_H
+
+#include "../include/common.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+
+/**
+ * @brief Disposición binaria de los registros de una tabla, calculada desde su esquema.
+ *
+ * FORMATO DE UN REGISTRO:
+ *   [CabeceraRegistro][mapa de nulos][región fija][offsets VARCHAR][datos VARCHAR]
+ *
+ * - CabeceraRegistro: longitud total del registro y número de columnas.
+ * - Mapa de nulos: un bit por columna (1 = NULL), ceil(columnas / 8) bytes.
+ * - Región fija: INT (int64), REAL (double), BOOL (1 byte) y CHAR (size bytes,
+ *   rellenado con ceros) en offsets fijos conocidos desde el esquema.
+ * - Offsets VARCHAR: un uint16 por columna VARCHAR con el offset (desde el inicio
+ *   del registro) donde TERMINAN sus datos; el primero empieza tras la tabla.
+ *
+ * Así cualquier campo se lee en O(1) sin recorrer los anteriores.
+ */
+class DisposicionRegistro {
+public:
+    /**
+     * @brief Cabecera de cada registro serializado.
+     */
+    struct CabeceraRegistro {
+        uint16_t longitud_total;
+        uint16_t numero_columnas;
+    };
+
+    static constexpr uint32_t SIN_INDICE = UINT32_MAX;
+    static constexpr const char* VALOR_NULO = "NULL"; // Representación textual de un valor nulo
+
+    /**
+     * @brief Calcula la disposición. Lanza std::invalid_argument si el esquema está vacío,
+     *        si un CHAR no tiene tamaño o si la parte fija no cabe en un bloque.
+     * @param columnas Columnas de la tabla, en orden
+     */
+    explicit DisposicionRegistro(const std::vector<ColumnMetadata>& columnas);
+
+    /**
+     * @brief Convierte los campos en texto al formato binario.
+     * @param campos Un valor por columna; VALOR_NULO en columnas que admiten nulos
+     * @param salida [out] Registro serializado
+     * @return Status::INVALID_ARGUMENT si algún valor no corresponde a su tipo
+     */
+    Status Codificar(const std::vector<std::string>& campos, std::vector<Byte>& salida) const;
+
+    /**
+     * @brief Indica si la disposición sigue correspondiendo a estas columnas.
+     */
+    bool Coincide(const std::vector<ColumnMetadata>& columnas) const;
+
+    uint32_t NumeroColumnas() const { return static_cast<uint32_t>(columnas_.size()); }
+    const ColumnMetadata& Columna(uint32_t i) const { return columnas_[i]; }
+    uint32_t OffsetFijo(uint32_t i) const { return offsets_fijos_[i]; }
+    uint32_t IndiceVariable(uint32_t i) const { return indices_variables_[i]; }
+    uint32_t OffsetMapaNulos() const { return sizeof(CabeceraRegistro); }
+    uint32_t OffsetTablaVariables() const { return offset_tabla_variables_; }
+    uint32_t OffsetDatosVariables() const { return offset_tabla_variables_ + num_variables_ * sizeof(uint16_t); }
+    uint32_t TamañoMinimo() const { return OffsetDatosVariables(); }
+
+    static uint32_t TamañoFijo(const ColumnMetadata& columna);
+
+private:
+    std::vector<ColumnMetadata> columnas_;
+    std::vector<uint32_t> offsets_fijos_;      // Offset en la región fija, o SIN_INDICE si es VARCHAR
+    std::vector<uint32_t> indices_variables_;  // Posición en la tabla de offsets, o SIN_INDICE
+    uint32_t offset_tabla_variables_;
+    uint32_t num_variables_;
+};
+
+/**
+ * @brief Vista de solo lectura sobre un registro binario, normalmente dentro de un
+ *        frame anclado. No copia datos: los textos se devuelven como string_view
+ *        que apuntan al frame, por lo que solo son válidos mientras siga anclado.
+ */
+class VistaRegistro {
+public:
+    VistaRegistro() : datos_(nullptr), disposicion_(nullptr), longitud_(0) {}
+
+    /**
+     * @brief Crea la vista y valida la cabecera del registro.
+     * @param datos Inicio del registro
+     * @param longitud_disponible Bytes legibles desde datos (hasta el final de la página)
+     * @param disposicion Disposición de la tabla
+     */
+    VistaRegistro(const Byte* datos, uint32_t longitud_disponible, const DisposicionRegistro& disposicion);
+
+    bool EsValida() const { return datos_ != nullptr; }
+    uint32_t ObtenerLongitud() const { return longitud_; }
+    uint32_t NumeroColumnas() const { return disposicion_->NumeroColumnas(); }
+    ColumnType TipoColumna(uint32_t columna) const { return disposicion_->Columna(columna).type; }
+    const Byte* ObtenerDatos() const { return datos_; }
+
+    bool EsNulo(uint32_t columna) const {
+        uint8_t byte = static_cast<uint8_t>(datos_[disposicion_->OffsetMapaNulos() + columna / 8]);
+        return (byte >> (columna % 8)) & 1u;
+    }
+
+    int64_t ObtenerEntero(uint32_t columna) const {
+        int64_t valor;
+        std::memcpy(&valor, datos_ + disposicion_->OffsetFijo(columna), sizeof(valor));
+        return valor;
+    }
+
+    double ObtenerReal(uint32_t columna) const {
+        double valor;
+        std::memcpy(&valor, datos_ + disposicion_->OffsetFijo(columna), sizeof(valor));
+        return valor;
+    }
+
+    bool ObtenerBooleano(uint32_t columna) const {
+        return datos_[disposicion_->OffsetFijo(columna)] != 0;
+    }
+
+    /**
+     * @brief Texto de una columna CHAR (sin el relleno) o VARCHAR.
+     */
+    std::string_view ObtenerTexto(uint32_t columna) const;
+
+    /**
+     * @brief Valor de la columna convertido a texto (VALOR_NULO si es nulo).
+     */
+    std::string ObtenerComoTexto(uint32_t columna) const;
+
+private:
+    const Byte* datos_;
+    const DisposicionRegistro* disposicion_;
+    uint32_t longitud_;
+
+    uint16_t LeerOffsetVariable(uint32_t indice) const {
+        uint16_t offset;
+        std::memcpy(&offset, datos_ + disposicion_->OffsetTablaVariables() + indice * sizeof(uint16_t), sizeof(offset));
+        return offset;
+    }
+};
+
+#endif // FORMATO_REGISTRO_H
@@ -3,10 +3,12 @@
 
 #include "gestor_registros.h"
 #include "../Catalog_Manager/gestor_catalogo.h"
+#include "../index/gestor_indices.h"
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <chrono>
+#include <iterator>
 #include <stdexcept> // Para std::runtime_error
 
 // === CONSTRUCTOR Y DESTRUCTOR ===
@@ -15,6 +17,7 @@ GestorRegistros::GestorRegistros(GestorBuffer& gestor_buffer)
     : gestor_buffer_(&gestor_buffer)
     , gestor_catalogo_(nullptr)
     , gestor_indices_(nullptr)
+    , gestor_wal_(nullptr)
     , total_inserciones_(0)
     , total_actualizaciones_(0)
     , total_eliminaciones_(0)
@@ -35,35 +38,80 @@ GestorRegistros::~GestorRegistros() {
 
 // === FUNCIÓN UTILITARIA ===
 
-uint64_t GestorRegistros::ObtenerTimestampActual() const {
-    return std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+MapaEspacioLibre* GestorRegistros::ObtenerMapaEspacioLibre(const std::shared_ptr<MetadataTabla>& metadata_tabla) {
+    uint32_t id_tabla = metadata_tabla->ObtenerIdTabla();
+    auto it = mapas_espacio_libre_.find(id_tabla);
+    if (it != mapas_espacio_libre_.end()) {
+        return it->second.get();
+    }
+
+    BlockId id_mapa = metadata_tabla->ObtenerIdMapaEspacioLibre();
+    auto mapa = std::make_unique<MapaEspacioLibre>(*gestor_buffer_, id_mapa);
+    if (mapa->Inicializar() != Status::OK) {
+        std::cerr << "Error: No se pudo inicializar el mapa de espacio libre de la tabla '"
+                  << metadata_tabla->ObtenerNombreTabla() << "'." << std::endl;
+        return nullptr;
+    }
+
+    if (id_mapa == INVALID_PAGE_ID) {
+        // Tabla sin mapa: registrar sus páginas actuales una única vez
+        for (PageId page_id : metadata_tabla->ObtenerPaginasDatos()) {
+            Byte* datos_pagina = nullptr;
+            if (gestor_buffer_->PinPage(page_id, datos_pagina) != Status::OK) {
+                continue;
+            }
+            CabeceraBloqueDatos* cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
+            mapa->RegistrarPagina(page_id, cabecera_datos->espacio_libre_total);
+            gestor_buffer_->UnpinPage(page_id, false);
+        }
+        metadata_tabla->EstablecerIdMapaEspacioLibre(mapa->ObtenerIdPrimeraPagina());
+        gestor_catalogo_->ActualizarMetadataTabla(metadata_tabla);
+    }
+
+    MapaEspacioLibre* resultado = mapa.get();
+    mapas_espacio_libre_[id_tabla] = std::move(mapa);
+    return resultado;
 }
 
-// === MÉTODOS PÚBLICOS ===
+void GestorRegistros::NotificarEspacioLibre(PageId id_pagina, uint32_t espacio_libre) {
+    // Pocas tablas abiertas a la vez: basta con preguntar a cada mapa cargado
+    for (auto& entrada : mapas_espacio_libre_) {
+        if (entrada.second->Contiene(id_pagina)) {
+            entrada.second->Actualizar(id_pagina, espacio_libre);
+            return;
+        }
+    }
+}
 
-Status GestorRegistros::InsertarRegistro(const std::string& nombre_tabla, const DatosRegistro& datos_registro) {
+Status GestorRegistros::PrepararCursor(const std::string& nombre_tabla, std::shared_ptr<MetadataTabla>& metadata_tabla,
+                                       const DisposicionRegistro*& disposicion) {
     if (!gestor_catalogo_) {
         std::cerr << "Error: GestorCatalogo no está configurado." << std::endl;
         return Status::ERROR;
     }
 
-    std::shared_ptr<MetadataTabla> metadata_tabla = gestor_catalogo_->ObtenerMetadataTabla(nombre_tabla);
+    metadata_tabla = gestor_catalogo_->ObtenerMetadataTabla(nombre_tabla);
     if (!metadata_tabla) {
         std::cerr << "Error: Tabla '" << nombre_tabla << "' no encontrada." << std::endl;
         return Status::NOT_FOUND;
     }
 
+    EsquemaTablaCompleto esquema = ConstruirEsquema(*metadata_tabla);
+
+    disposicion = ObtenerDisposicion(esquema);
+    return disposicion ? Status::OK : Status::INVALID_ARGUMENT;
+}
+
+EsquemaTablaCompleto GestorRegistros::ConstruirEsquema(const MetadataTabla& metadata_tabla) const {
     EsquemaTablaCompleto esquema;
-    esquema.base_metadata.table_id = metadata_tabla->ObtenerIdTabla();
-    std::strncpy(esquema.base_metadata.table_name, metadata_tabla->ObtenerNombreTabla().c_str(), 63);
+    esquema.base_metadata.table_id = metadata_tabla.ObtenerIdTabla();
+    std::strncpy(esquema.base_metadata.table_name, metadata_tabla.ObtenerNombreTabla().c_str(), 63);
     esquema.base_metadata.table_name[63] = '\0';
-    esquema.base_metadata.is_fixed_length_record = metadata_tabla->EsLongitudFija();
-    esquema.base_metadata.num_records = metadata_tabla->ObtenerNumeroRegistros();
-    esquema.base_metadata.fixed_record_size = metadata_tabla->ObtenerTamanoRegistroFijo();
+    esquema.base_metadata.is_fixed_length_record = metadata_tabla.EsLongitudFija();
+    esquema.base_metadata.num_records = metadata_tabla.ObtenerNumeroRegistros();
+    esquema.base_metadata.fixed_record_size = metadata_tabla.ObtenerTamanoRegistroFijo();
 
-    for (const auto& col_meta : metadata_tabla->ObtenerColumnas()) {
+    for (const auto& col_meta : metadata_tabla.ObtenerColumnas()) {
         ColumnMetadata cm;
         std::strncpy(cm.name, col_meta.nombre.c_str(), 63);
         cm.name[63] = '\0';
@@ -71,13 +119,71 @@ Status GestorRegistros::InsertarRegistro(const std::string& nombre_tabla, const
         cm.size = col_meta.tamano;
         esquema.columns.push_back(cm);
     }
+    return esquema;
+}
+
+const DisposicionRegistro* GestorRegistros::ObtenerDisposicion(const EsquemaTablaCompleto& esquema) {
+    uint32_t id_tabla = esquema.base_metadata.table_id;
+    auto it = disposiciones_.find(id_tabla);
+    if (it != disposiciones_.end() && it->second->Coincide(esquema.columns)) {
+        return it->second.get();
+    }
+    try {
+        auto disposicion = std::make_unique<DisposicionRegistro>(esquema.columns);
+        DisposicionRegistro* resultado = disposicion.get();
+        disposiciones_[id_tabla] = std::move(disposicion);
+        return resultado;
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: Esquema no válido para la tabla '" << esquema.base_metadata.table_name
+                  << "': " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+uint64_t GestorRegistros::ObtenerTimestampActual() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+}
+
+// === MÉTODOS PÚBLICOS ===
+
+Status GestorRegistros::InsertarRegistro(const std::string& nombre_tabla, const DatosRegistro& datos_registro) {
+    RecordId id_registro;
+    return InsertarRegistro(nombre_tabla, datos_registro, id_registro);
+}
+
+Status GestorRegistros::InsertarRegistro(const std::string& nombre_tabla, const DatosRegistro& datos_registro,
+                                         RecordId& id_registro_salida) {
+    id_registro_salida = INVALID_RECORD_ID;
+    if (!gestor_catalogo_) {
+        std::cerr << "Error: GestorCatalogo no está configurado." << std::endl;
+        return Status::ERROR;
+    }
+
+    std::shared_ptr<MetadataTabla> metadata_tabla = gestor_catalogo_->ObtenerMetadataTabla(nombre_tabla);
+    if (!metadata_tabla) {
+        std::cerr << "Error: Tabla '" << nombre_tabla << "' no encontrada." << std::endl;
+        return Status::NOT_FOUND;
+    }
+
+    EsquemaTablaCompleto esquema = ConstruirEsquema(*metadata_tabla);
+
+    const DisposicionRegistro* disposicion = ObtenerDisposicion(esquema);
+    if (!disposicion) {
+        return Status::INVALID_ARGUMENT;
+    }
 
     if (!ValidarDatosRegistro(datos_registro, esquema)) {
         std::cerr << "Error: Datos de registro no válidos para el esquema de la tabla." << std::endl;
         return Status::INVALID_ARGUMENT;
     }
 
-    std::vector<Byte> datos_raw = SerializarRegistro(datos_registro, esquema);
+    std::vector<Byte> datos_raw;
+    Status estado_serializacion = SerializarRegistro(datos_registro, *disposicion, datos_raw);
+    if (estado_serializacion != Status::OK) {
+        return estado_serializacion;
+    }
     uint32_t tamano_registro_raw = datos_raw.size();
 
     // Buscar una página existente con espacio o crear una nueva
@@ -86,83 +192,79 @@ Status GestorRegistros::InsertarRegistro(const std::string& nombre_tabla, const
     CabeceraBloqueDatos* cabecera_datos = nullptr;
     Pagina pagina_info;
 
-    // Iterar sobre las páginas de datos de la tabla para encontrar espacio
-    for (PageId page_id : metadata_tabla->ObtenerPaginasDatos()) {
+    // Pedir una página candidata al mapa de espacio libre en lugar de recorrer la tabla.
+    // El mapa es una pista: si la página no tiene el espacio que indicaba, se corrige
+    // su entrada y se pide otra.
+    MapaEspacioLibre* mapa_espacio = ObtenerMapaEspacioLibre(metadata_tabla);
+    if (!mapa_espacio) {
+        return Status::ERROR;
+    }
+    PageId page_id;
+    uint32_t slot = 0;
+    while ((page_id = mapa_espacio->BuscarPaginaConEspacio(tamano_registro_raw)) != INVALID_PAGE_ID) {
         Status pin_status = gestor_buffer_->PinPage(page_id, pagina_info);
-        if (pin_status == Status::OK) {
-            datos_pagina = gestor_buffer_->GetPageData(page_id);
-            if (!datos_pagina) {
-                gestor_buffer_->UnpinPage(page_id, false);
-                continue;
-            }
-            // Acceder a la cabecera del bloque de datos
-            CabeceraComun* cabecera_comun = reinterpret_cast<CabeceraComun*>(datos_pagina);
-            if (cabecera_comun->tipo_bloque == PageType::DATA_PAGE) { // Use tipo_bloque
-                cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
-
-                // Verificar si hay espacio suficiente en esta página
-                // Asumimos un modelo simple de slots o espacio contiguo
-                if (cabecera_datos->espacio_libre_total >= tamano_registro_raw) {
-                    // Encontrado espacio en una página existente
-                    id_pagina_destino = page_id;
-                    break;
-                }
-            }
-            gestor_buffer_->UnpinPage(page_id, false); // Desanclar si no se usa
+        if (pin_status != Status::OK) {
+            mapa_espacio->Actualizar(page_id, 0); // No usar una página que no se puede leer
+            continue;
         }
+        datos_pagina = gestor_buffer_->GetPageData(page_id);
+        if (!datos_pagina) {
+            gestor_buffer_->UnpinPage(page_id, false);
+            mapa_espacio->Actualizar(page_id, 0);
+            continue;
+        }
+        // Acceder a la cabecera del bloque de datos
+        if (!PaginaRanurada(datos_pagina).EsPaginaDatos()) {
+            gestor_buffer_->UnpinPage(page_id, false);
+            mapa_espacio->Actualizar(page_id, 0);
+            continue;
+        }
+        cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
+        if (cabecera_datos->espacio_libre_total >= tamano_registro_raw &&
+            InsertarEnPagina(*metadata_tabla, *disposicion, page_id, datos_pagina, datos_raw, slot) == Status::OK) {
+            id_pagina_destino = page_id;
+            break;
+        }
+        // En PAX lo que ocupa el registro depende de la codificación de la página: aunque
+        // el espacio libre alcance puede no caber, y no debe volver a proponerse para este tamaño
+        mapa_espacio->Actualizar(page_id, std::min(cabecera_datos->espacio_libre_total, tamano_registro_raw - 1));
+        gestor_buffer_->UnpinPage(page_id, false); // Desanclar si no se usa
     }
 
     // Si no se encontró espacio en páginas existentes, crear una nueva página
     if (id_pagina_destino == INVALID_FRAME_ID) {
-        Status new_page_status = gestor_buffer_->NewPage(id_pagina_destino, pagina_info);
+        Status new_page_status = CrearPaginaDatos(*metadata_tabla, id_pagina_destino, datos_pagina);
         if (new_page_status != Status::OK) {
             std::cerr << "Error: No se pudo crear una nueva página para insertar el registro." << std::endl;
             return new_page_status;
         }
-        // La nueva página ya está anclada, obtener sus datos y cabecera
-        datos_pagina = gestor_buffer_->GetPageData(id_pagina_destino);
-        if (!datos_pagina) {
+        if (id_pagina_destino > MAX_PAGINA_RECORD_ID) {
+            std::cerr << "Error: La página " << id_pagina_destino << " no es direccionable por un RecordId." << std::endl;
             gestor_buffer_->UnpinPage(id_pagina_destino, false);
-            return Status::ERROR;
+            return Status::OUT_OF_SPACE_FOR_UPDATE;
         }
-        CabeceraComun* cabecera_comun = reinterpret_cast<CabeceraComun*>(datos_pagina);
+        // Inicializar las cabeceras (directorio de slots vacío o cabecera PAX)
+        InicializarPaginaDatos(*metadata_tabla, *disposicion, id_pagina_destino, datos_pagina);
         cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
 
-        // Inicializar la cabecera de datos para la nueva página
-        // Estos campos se inicializaron en el constructor de CabeceraBloqueDatos
-        // Asegurarse de que el espacio libre inicial sea correcto
-        cabecera_datos->espacio_libre_total = BLOCK_SIZE - sizeof(CabeceraComun) - sizeof(CabeceraBloqueDatos);
-        cabecera_datos->numero_registros_activos = 0;
-        cabecera_datos->numero_registros_eliminados = 0;
-        cabecera_datos->offset_directorio_slots = BLOCK_SIZE; // Directorio crece hacia abajo
-        cabecera_datos->tamano_directorio_slots = 0;
-        cabecera_datos->factor_carga_porcentaje = 0;
-        cabecera_datos->necesita_compactacion = false;
-
-        // Añadir la nueva página a la metadata de la tabla
+        // Añadir la nueva página a la metadata de la tabla y al mapa de espacio libre
         metadata_tabla->AñadirPaginaDatos(id_pagina_destino);
         gestor_catalogo_->ActualizarMetadataTabla(metadata_tabla); // Persistir cambio
+        mapa_espacio->RegistrarPagina(id_pagina_destino, cabecera_datos->espacio_libre_total);
+
+        // Insertar el registro en un slot de la página: el RecordId es (página, slot)
+        // y no cambia aunque la página se compacte
+        Status estado_insercion = InsertarEnPagina(*metadata_tabla, *disposicion, id_pagina_destino, datos_pagina,
+                                                   datos_raw, slot);
+        if (estado_insercion != Status::OK) {
+            std::cerr << "Error: No hay espacio suficiente en la página " << id_pagina_destino << " para el registro." << std::endl;
+            gestor_buffer_->UnpinPage(id_pagina_destino, false);
+            return estado_insercion;
+        }
     }
-
-    // Insertar el registro en la página
-    uint32_t offset_insercion;
-    if (!CalcularOffsetInsercion(datos_pagina, tamano_registro_raw, offset_insercion)) {
-        std::cerr << "Error: No hay espacio contiguo suficiente en la página " << id_pagina_destino << " para el registro." << std::endl;
-        gestor_buffer_->UnpinPage(id_pagina_destino, false);
-        return Status::OUT_OF_SPACE_FOR_UPDATE;
-    }
-
-    std::memcpy(datos_pagina + offset_insercion, datos_raw.data(), tamano_registro_raw);
-
-    // Actualizar cabecera del bloque de datos
-    cabecera_datos->espacio_libre_total -= tamano_registro_raw;
-    cabecera_datos->numero_registros_activos++;
-    // Aquí se debería gestionar el directorio de slots si la tabla es de longitud variable
-    // Para longitud fija, RecordId podría ser simplemente (id_pagina * MAX_RECORDS_PER_PAGE) + slot_idx
-    // Para simplificar, asumimos que el RecordId es global y asignado secuencialmente por el gestor de registros
-    // Se necesitaría un mecanismo para asignar RecordId único y persistente.
-    // Por ahora, usaremos un RecordId simple para la prueba.
-    RecordId nuevo_record_id = metadata_tabla->ObtenerNumeroRegistros() + 1; // Asignación simple
+    mapa_espacio->Actualizar(id_pagina_destino, cabecera_datos->espacio_libre_total);
+    RecordId nuevo_record_id = ConstruirRecordId(id_pagina_destino, slot);
+    id_registro_salida = nuevo_record_id;
 
     metadata_tabla->IncrementarNumeroRegistros();
     gestor_catalogo_->ActualizarMetadataTabla(metadata_tabla); // Persistir cambio
@@ -174,16 +276,29 @@ Status GestorRegistros::InsertarRegistro(const std::string& nombre_tabla, const
     gestor_buffer_->UnpinPage(id_pagina_destino, true);
 
     total_inserciones_++;
+    MantenerIndices(nombre_tabla, *metadata_tabla, *disposicion, nullptr, &datos_registro, nuevo_record_id);
+    Status estado_confirmacion = ConfirmarCambios();
+    if (estado_confirmacion != Status::OK) {
+        return estado_confirmacion;
+    }
     std::cout << "Registro insertado exitosamente en tabla '" << nombre_tabla 
               << "', página " << id_pagina_destino << ", RecordId " << nuevo_record_id << "." << std::endl;
     return Status::OK;
 }
 
-Status GestorRegistros::ConsultarRegistroPorID(const std::string& nombre_tabla, RecordId id_registro, DatosRegistro& datos_registro_salida) {
+Status GestorRegistros::InsertarRegistrosLote(const std::string& nombre_tabla, const std::vector<DatosRegistro>& lote,
+                                              uint32_t& registros_insertados, std::vector<RecordId>* ids_salida) {
+    registros_insertados = 0;
+    if (ids_salida) {
+        ids_salida->clear();
+    }
     if (!gestor_catalogo_) {
         std::cerr << "Error: GestorCatalogo no está configurado." << std::endl;
         return Status::ERROR;
     }
+    if (lote.empty()) {
+        return Status::OK;
+    }
 
     std::shared_ptr<MetadataTabla> metadata_tabla = gestor_catalogo_->ObtenerMetadataTabla(nombre_tabla);
     if (!metadata_tabla) {
@@ -191,89 +306,249 @@ Status GestorRegistros::ConsultarRegistroPorID(const std::string& nombre_tabla,
         return Status::NOT_FOUND;
     }
 
-    EsquemaTablaCompleto esquema;
-    esquema.base_metadata.table_id = metadata_tabla->ObtenerIdTabla();
-    std::strncpy(esquema.base_metadata.table_name, metadata_tabla->ObtenerNombreTabla().c_str(), 63);
-    esquema.base_metadata.table_name[63] = '\0';
-    esquema.base_metadata.is_fixed_length_record = metadata_tabla->EsLongitudFija();
-    esquema.base_metadata.num_records = metadata_tabla->ObtenerNumeroRegistros();
-    esquema.base_metadata.fixed_record_size = metadata_tabla->ObtenerTamanoRegistroFijo();
+    // El esquema y la disposición se calculan una sola vez para todo el lote
+    EsquemaTablaCompleto esquema = ConstruirEsquema(*metadata_tabla);
 
-    for (const auto& col_meta : metadata_tabla->ObtenerColumnas()) {
-        ColumnMetadata cm;
-        std::strncpy(cm.name, col_meta.nombre.c_str(), 63);
-        cm.name[63] = '\0';
-        cm.type = col_meta.tipo;
-        cm.size = col_meta.tamano;
-        esquema.columns.push_back(cm);
+    const DisposicionRegistro* disposicion = ObtenerDisposicion(esquema);
+    if (!disposicion) {
+        return Status::INVALID_ARGUMENT;
+    }
+    MapaEspacioLibre* mapa_espacio = ObtenerMapaEspacioLibre(metadata_tabla);
+    if (!mapa_espacio) {
+        return Status::ERROR;
     }
 
-    // Para una consulta por ID, necesitaríamos un índice o un mapeo RecordId -> (PageId, Offset)
-    // Para simplificar, haremos un escaneo lineal de todas las páginas de la tabla.
-    // En un sistema real, se usaría un índice para esto.
+    // Índices de la tabla: las entradas se acumulan y se insertan al final del lote
+    std::vector<std::pair<uint32_t, std::string>> columnas_indexadas = ObtenerColumnasIndexadas(nombre_tabla, *metadata_tabla);
+    std::vector<RecordId> ids_insertados;
+    std::vector<size_t> filas_insertadas; // Posición en el lote de cada RecordId insertado
+    ids_insertados.reserve(lote.size());
+    filas_insertadas.reserve(lote.size());
 
-    for (PageId page_id : metadata_tabla->ObtenerPaginasDatos()) {
-        Pagina pagina_info;
-        Status pin_status = gestor_buffer_->PinPage(page_id, pagina_info);
-        if (pin_status != Status::OK) {
-            std::cerr << "Advertencia: No se pudo anclar la página " << page_id << " para consulta." << std::endl;
+    // Las páginas se llenan en orden: la página actual sigue anclada hasta que se llena
+    PageId id_pagina_actual = INVALID_PAGE_ID;
+    Byte* datos_pagina = nullptr;
+    bool paginas_nuevas = false;
+    uint32_t registros_fallidos = 0;
+    std::vector<Byte> datos_raw;
+    Status estado_lote = Status::OK;
+
+    // En PAX la página actual se llena decodificada y se codifica una sola vez, al soltarla
+    const bool columnar = metadata_tabla->ObtenerFormatoAlmacenamiento() == FormatoAlmacenamiento::COLUMNAS_PAX;
+    ContenidoPaginaPAX contenido_pax(*disposicion, metadata_tabla->UsaCodificacionLigera());
+    auto insertar = [&](PageId id_pagina, Byte* datos, uint32_t& slot) {
+        if (columnar) {
+            return contenido_pax.Añadir(VistaRegistro(datos_raw.data(), static_cast<uint32_t>(datos_raw.size()), *disposicion), slot);
+        }
+        return InsertarEnPagina(*metadata_tabla, *disposicion, id_pagina, datos, datos_raw, slot) == Status::OK;
+    };
+
+    auto soltar_pagina_actual = [&]() {
+        if (id_pagina_actual != INVALID_PAGE_ID) {
+            if (columnar) {
+                PaginaPAX(datos_pagina, *disposicion).Escribir(contenido_pax); // Añadir() ya comprobó que cabe
+                RegistrarCambioPagina(id_pagina_actual, datos_pagina, TipoRegistroWAL::IMAGEN_PAGINA, 0,
+                                      datos_pagina, BLOCK_SIZE);
+            }
+            mapa_espacio->Actualizar(id_pagina_actual, PaginaRanurada(datos_pagina).EspacioLibre());
+            ActualizarEstadisticasPagina(id_pagina_actual, "insercion");
+            gestor_buffer_->UnpinPage(id_pagina_actual, true);
+        }
+        id_pagina_actual = INVALID_PAGE_ID;
+        datos_pagina = nullptr;
+    };
+
+    for (size_t fila = 0; fila < lote.size(); ++fila) {
+        const DatosRegistro& registro = lote[fila];
+        if (!ValidarDatosRegistro(registro, esquema) ||
+            SerializarRegistro(registro, *disposicion, datos_raw) != Status::OK) {
+            registros_fallidos++;
             continue;
         }
+        uint32_t tamano_registro_raw = datos_raw.size();
 
-        Byte* datos_pagina = gestor_buffer_->GetPageData(page_id);
-        if (!datos_pagina) {
-            gestor_buffer_->UnpinPage(page_id, false);
+        uint32_t slot = 0;
+        if (datos_pagina && insertar(id_pagina_actual, datos_pagina, slot)) {
+            ids_insertados.push_back(ConstruirRecordId(id_pagina_actual, slot));
+            filas_insertadas.push_back(fila);
             continue;
         }
 
-        CabeceraComun* cabecera_comun = reinterpret_cast<CabeceraComun*>(datos_pagina);
-        CabeceraBloqueDatos* cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
+        // La página actual está llena: pasar a una con espacio según el mapa, o a una nueva
+        soltar_pagina_actual();
+        PageId page_id;
+        while ((page_id = mapa_espacio->BuscarPaginaConEspacio(tamano_registro_raw)) != INVALID_PAGE_ID) {
+            Byte* candidata = nullptr;
+            if (gestor_buffer_->PinPage(page_id, candidata) != Status::OK || !candidata) {
+                mapa_espacio->Actualizar(page_id, 0);
+                continue;
+            }
+            PaginaRanurada pagina(candidata);
+            bool legible = columnar ? PaginaPAX(candidata, *disposicion).Leer(contenido_pax) == Status::OK
+                                    : pagina.EsPaginaDatos();
+            if (legible && insertar(page_id, candidata, slot)) {
+                id_pagina_actual = page_id;
+                datos_pagina = candidata;
+                break;
+            }
+            // Ver InsertarRegistro(): en PAX puede no caber aunque el espacio libre alcance
+            mapa_espacio->Actualizar(page_id, legible ? std::min(pagina.EspacioLibre(), tamano_registro_raw - 1) : 0);
+            gestor_buffer_->UnpinPage(page_id, false);
+        }
+        if (id_pagina_actual == INVALID_PAGE_ID) {
+            Byte* nueva = nullptr;
+            PageId id_nueva = INVALID_PAGE_ID;
+            Status estado_nueva = CrearPaginaDatos(*metadata_tabla, id_nueva, nueva);
+            if (estado_nueva != Status::OK || !nueva) {
+                std::cerr << "Error: No se pudo crear una nueva página para la carga masiva." << std::endl;
+                estado_lote = (estado_nueva != Status::OK) ? estado_nueva : Status::ERROR;
+                break;
+            }
+            if (id_nueva > MAX_PAGINA_RECORD_ID) {
+                std::cerr << "Error: La página " << id_nueva << " no es direccionable por un RecordId." << std::endl;
+                gestor_buffer_->UnpinPage(id_nueva, false);
+                estado_lote = Status::OUT_OF_SPACE_FOR_UPDATE;
+                break;
+            }
+            if (columnar) {
+                // Sin registro en el WAL: la imagen de la página al soltarla la incluye
+                PaginaPAX(nueva, *disposicion).Inicializar(id_nueva, metadata_tabla->UsaCodificacionLigera());
+                contenido_pax.Vaciar();
+            } else {
+                InicializarPaginaDatos(*metadata_tabla, *disposicion, id_nueva, nueva);
+            }
+            metadata_tabla->AñadirPaginaDatos(id_nueva); // Se persiste una vez al final del lote
+            mapa_espacio->RegistrarPagina(id_nueva, PaginaRanurada(nueva).EspacioLibre());
+            paginas_nuevas = true;
+            id_pagina_actual = id_nueva;
+            datos_pagina = nueva;
+            if (!insertar(id_nueva, nueva, slot)) {
+                registros_fallidos++; // No cabe ni en una página vacía
+                continue;
+            }
+        }
+        ids_insertados.push_back(ConstruirRecordId(id_pagina_actual, slot));
+        filas_insertadas.push_back(fila);
+    }
+    soltar_pagina_actual();
+
+    // Número de registros y lista de páginas: una sola actualización del catálogo por lote
+    registros_insertados = static_cast<uint32_t>(ids_insertados.size());
+    if (registros_insertados > 0 || paginas_nuevas) {
+        metadata_tabla->EstablecerNumeroRegistros(metadata_tabla->ObtenerNumeroRegistros() + registros_insertados);
+        gestor_catalogo_->ActualizarMetadataTabla(metadata_tabla);
+    }
+    total_inserciones_ += registros_insertados;
 
-        // Asumimos un esquema simple donde RecordId es el índice del registro en la página
-        // y los registros están empaquetados secuencialmente.
-        // Esto es una simplificación; un sistema real usaría un directorio de slots o un índice.
-        uint32_t record_size_guess = esquema.base_metadata.is_fixed_length_record ? 
-                                     esquema.base_metadata.fixed_record_size : 128; // Estimado para variable
+    // Todo el lote se hace duradero con un único punto de confirmación
+    Status estado_confirmacion = ConfirmarCambios();
+    if (estado_confirmacion != Status::OK) {
+        return estado_confirmacion;
+    }
 
-        for (uint32_t i = 0; i < cabecera_datos->numero_registros_activos + cabecera_datos->numero_registros_eliminados; ++i) {
-            uint32_t current_record_offset = sizeof(CabeceraComun) + sizeof(CabeceraBloqueDatos) + (i * record_size_guess);
-            if (current_record_offset + record_size_guess > BLOCK_SIZE) {
-                break; // Fuera de los límites del bloque
+    // Mantenimiento de índices por columna, con las claves ordenadas para recorrer
+    // cada índice de forma secuencial
+    for (const auto& columna : columnas_indexadas) {
+        bool es_entero = (esquema.columns[columna.first].type == ColumnType::INT);
+        std::vector<std::pair<int64_t, size_t>> claves_enteras; // (clave, posición en ids_insertados)
+        std::vector<std::pair<std::string, size_t>> claves_texto;
+        for (size_t i = 0; i < ids_insertados.size(); ++i) {
+            const DatosRegistro& registro = lote[filas_insertadas[i]];
+            if (columna.first >= registro.campos.size()) continue;
+            const std::string& valor = registro.campos[columna.first];
+            if (es_entero) {
+                try { claves_enteras.push_back({std::stoll(valor), i}); } catch (...) { continue; }
+            } else {
+                claves_texto.push_back({valor, i});
             }
+        }
+        std::sort(claves_enteras.begin(), claves_enteras.end());
+        std::sort(claves_texto.begin(), claves_texto.end());
+        for (const auto& clave : claves_enteras) {
+            const std::string& valor = lote[filas_insertadas[clave.second]].campos[columna.first];
+            gestor_indices_->InsertarEnIndice(nombre_tabla, columna.second, valor, clave.first, ids_insertados[clave.second]);
+        }
+        for (const auto& clave : claves_texto) {
+            gestor_indices_->InsertarEnIndice(nombre_tabla, columna.second, clave.first, 0, ids_insertados[clave.second]);
+        }
+    }
 
-            // Aquí se necesitaría una forma de obtener el RecordId real del registro
-            // y verificar si coincide con id_registro.
-            // Para esta simulación, asumiremos que los registros tienen un campo 'id'
-            // y lo deserializaremos para verificar.
-            std::vector<Byte> record_data_raw(datos_pagina + current_record_offset, 
-                                              datos_pagina + current_record_offset + record_size_guess);
-            DatosRegistro temp_registro = DeserializarRegistro(record_data_raw, esquema);
+    if (ids_salida) {
+        *ids_salida = std::move(ids_insertados);
+    }
+    if (estado_lote != Status::OK) {
+        return estado_lote;
+    }
+    return (registros_fallidos == 0) ? Status::OK : Status::OPERATION_FAILED;
+}
 
-            // Supongamos que el primer campo es el ID y es un INT
-            if (!temp_registro.campos.empty() && esquema.columns[0].type == ColumnType::INT) {
-                try {
-                    RecordId current_found_id = std::stoul(temp_registro.campos[0]);
-                    if (current_found_id == id_registro) {
-                        datos_registro_salida = temp_registro;
-                        gestor_buffer_->UnpinPage(page_id, false);
-                        ActualizarEstadisticasPagina(page_id, "consulta");
-                        total_consultas_++;
-                        std::cout << "Registro " << id_registro << " encontrado en tabla '" << nombre_tabla << "'." << std::endl;
-                        return Status::OK;
-                    }
-                } catch (const std::exception& e) {
-                    std::cerr << "Advertencia: Error al parsear ID de registro en página " << page_id << ": " << e.what() << std::endl;
-                }
-            }
+bool GestorRegistros::LeerRegistroAnclado(const MetadataTabla& metadata_tabla, const DisposicionRegistro& disposicion,
+                                          Byte* datos_pagina, RecordId id_registro, DatosRegistro& datos_salida) const {
+    const Byte* registro = nullptr;
+    uint32_t longitud = 0;
+    VistaRegistro vista;
+    std::vector<Byte> reconstruido; // PAX: el registro se decodifica fuera de la página
+    if (metadata_tabla.ObtenerFormatoAlmacenamiento() == FormatoAlmacenamiento::COLUMNAS_PAX) {
+        if (PaginaPAX(datos_pagina, disposicion).Obtener(SlotDeRecordId(id_registro), reconstruido)) {
+            vista = VistaRegistro(reconstruido.data(), static_cast<uint32_t>(reconstruido.size()), disposicion);
         }
-        gestor_buffer_->UnpinPage(page_id, false);
+    } else if (PaginaRanurada(datos_pagina).Obtener(SlotDeRecordId(id_registro), registro, longitud)) {
+        vista = VistaRegistro(registro, longitud, disposicion);
     }
+    if (!vista.EsValida()) {
+        return false;
+    }
+    datos_salida = DeserializarRegistro(vista);
+    return true;
+}
 
-    std::cout << "Registro " << id_registro << " no encontrado en tabla '" << nombre_tabla << "'." << std::endl;
-    return Status::NOT_FOUND;
+std::vector<std::pair<uint32_t, std::string>> GestorRegistros::ObtenerColumnasIndexadas(
+    const std::string& nombre_tabla, const MetadataTabla& metadata_tabla) const {
+    std::vector<std::pair<uint32_t, std::string>> columnas_indexadas;
+    if (!gestor_indices_) {
+        return columnas_indexadas;
+    }
+    for (const std::string& nombre_columna : gestor_indices_->ObtenerIndicesDeTabla(nombre_tabla)) {
+        int32_t indice = metadata_tabla.BuscarColumna(nombre_columna);
+        if (indice >= 0) {
+            columnas_indexadas.push_back({static_cast<uint32_t>(indice), nombre_columna});
+        }
+    }
+    return columnas_indexadas;
 }
 
-Status GestorRegistros::ConsultarTodosLosRegistros(const std::string& nombre_tabla, std::vector<DatosRegistro>& resultados) {
+void GestorRegistros::MantenerIndices(const std::string& nombre_tabla, const MetadataTabla& metadata_tabla,
+                                      const DisposicionRegistro& disposicion, const DatosRegistro* anterior,
+                                      const DatosRegistro* nuevo, RecordId id_registro) {
+    for (const auto& columna : ObtenerColumnasIndexadas(nombre_tabla, metadata_tabla)) {
+        const uint32_t posicion = columna.first;
+        const std::string* valor_anterior =
+            (anterior && posicion < anterior->campos.size()) ? &anterior->campos[posicion] : nullptr;
+        const std::string* valor_nuevo = (nuevo && posicion < nuevo->campos.size()) ? &nuevo->campos[posicion] : nullptr;
+        if (valor_anterior && valor_nuevo && *valor_anterior == *valor_nuevo) {
+            continue; // La clave no cambia: la entrada sigue apuntando al mismo slot
+        }
+        // Igual que en la carga masiva, las claves INT que no son enteros no se indexan
+        const bool es_entero = disposicion.Columna(posicion).type == ColumnType::INT;
+        auto clave_entera = [es_entero](const std::string& valor, int64_t& entero) {
+            if (!es_entero) {
+                entero = 0;
+                return true;
+            }
+            try { entero = std::stoll(valor); } catch (...) { return false; }
+            return true;
+        };
+        int64_t entero = 0;
+        if (valor_anterior && clave_entera(*valor_anterior, entero)) {
+            gestor_indices_->EliminarDeIndice(nombre_tabla, columna.second, *valor_anterior, entero, id_registro);
+        }
+        if (valor_nuevo && clave_entera(*valor_nuevo, entero)) {
+            gestor_indices_->InsertarEnIndice(nombre_tabla, columna.second, *valor_nuevo, entero, id_registro);
+        }
+    }
+}
+
+Status GestorRegistros::ConsultarRegistroPorID(const std::string& nombre_tabla, RecordId id_registro, DatosRegistro& datos_registro_salida) {
     if (!gestor_catalogo_) {
         std::cerr << "Error: GestorCatalogo no está configurado." << std::endl;
         return Status::ERROR;
@@ -285,173 +560,384 @@ Status GestorRegistros::ConsultarTodosLosRegistros(const std::string& nombre_tab
         return Status::NOT_FOUND;
     }
 
-    EsquemaTablaCompleto esquema;
-    esquema.base_metadata.table_id = metadata_tabla->ObtenerIdTabla();
-    std::strncpy(esquema.base_metadata.table_name, metadata_tabla->ObtenerNombreTabla().c_str(), 63);
-    esquema.base_metadata.table_name[63] = '\0';
-    esquema.base_metadata.is_fixed_length_record = metadata_tabla->EsLongitudFija();
-    esquema.base_metadata.num_records = metadata_tabla->ObtenerNumeroRegistros();
-    esquema.base_metadata.fixed_record_size = metadata_tabla->ObtenerTamanoRegistroFijo();
+    EsquemaTablaCompleto esquema = ConstruirEsquema(*metadata_tabla);
 
-    for (const auto& col_meta : metadata_tabla->ObtenerColumnas()) {
-        ColumnMetadata cm;
-        std::strncpy(cm.name, col_meta.nombre.c_str(), 63);
-        cm.name[63] = '\0';
-        cm.type = col_meta.tipo;
-        cm.size = col_meta.tamano;
-        esquema.columns.push_back(cm);
+    const DisposicionRegistro* disposicion = ObtenerDisposicion(esquema);
+    if (!disposicion) {
+        return Status::INVALID_ARGUMENT;
     }
 
-    resultados.clear(); // Limpiar resultados anteriores
+    // El RecordId indica la página y el slot: basta con anclar una sola página
+    Byte* datos_pagina = nullptr;
+    Status estado = AnclarPaginaRegistro(metadata_tabla, id_registro, datos_pagina);
+    if (estado != Status::OK) {
+        std::cout << "Registro " << id_registro << " no encontrado en tabla '" << nombre_tabla << "'." << std::endl;
+        return (estado == Status::INVALID_PAGE_TYPE) ? Status::NOT_FOUND : estado;
+    }
+    PageId id_pagina = PaginaDeRecordId(id_registro);
 
-    for (PageId page_id : metadata_tabla->ObtenerPaginasDatos()) {
-        Pagina pagina_info;
-        Status pin_status = gestor_buffer_->PinPage(page_id, pagina_info);
-        if (pin_status != Status::OK) {
-            std::cerr << "Advertencia: No se pudo anclar la página " << page_id << " para consulta de todos los registros." << std::endl;
-            continue;
-        }
+    if (!LeerRegistroAnclado(*metadata_tabla, *disposicion, datos_pagina, id_registro, datos_registro_salida)) {
+        gestor_buffer_->UnpinPage(id_pagina, false);
+        std::cout << "Registro " << id_registro << " no encontrado en tabla '" << nombre_tabla << "'." << std::endl;
+        return Status::NOT_FOUND;
+    }
+    gestor_buffer_->UnpinPage(id_pagina, false);
+    total_consultas_++;
+    return Status::OK;
+}
 
-        Byte* datos_pagina = gestor_buffer_->GetPageData(page_id);
-        if (!datos_pagina) {
-            gestor_buffer_->UnpinPage(page_id, false);
-            continue;
-        }
+Status GestorRegistros::AbrirCursor(const std::string& nombre_tabla, CursorRegistros& cursor, PredicadoRegistro predicado) {
+    cursor.Cerrar();
+    std::shared_ptr<MetadataTabla> metadata_tabla;
+    const DisposicionRegistro* disposicion = nullptr;
+    Status estado = PrepararCursor(nombre_tabla, metadata_tabla, disposicion);
+    if (estado != Status::OK) {
+        return estado;
+    }
 
-        CabeceraComun* cabecera_comun = reinterpret_cast<CabeceraComun*>(datos_pagina);
-        CabeceraBloqueDatos* cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
+    cursor.Abrir(gestor_buffer_, disposicion, metadata_tabla->ObtenerFormatoAlmacenamiento(),
+                 metadata_tabla->ObtenerPaginasDatos(), std::move(predicado));
+    total_consultas_++;
+    return Status::OK;
+}
 
-        uint32_t record_size_guess = esquema.base_metadata.is_fixed_length_record ? 
-                                     esquema.base_metadata.fixed_record_size : 128; // Estimado
+Status GestorRegistros::AbrirCursorPorIds(const std::string& nombre_tabla, std::vector<RecordId> ids,
+                                          CursorRegistros& cursor, std::shared_ptr<const FiltroCompilado> filtro) {
+    cursor.Cerrar();
+    std::shared_ptr<MetadataTabla> metadata_tabla;
+    const DisposicionRegistro* disposicion = nullptr;
+    Status estado = PrepararCursor(nombre_tabla, metadata_tabla, disposicion);
+    if (estado != Status::OK) {
+        return estado;
+    }
 
-        for (uint32_t i = 0; i < cabecera_datos->numero_registros_activos; ++i) { // Solo registros activos
-            uint32_t current_record_offset = sizeof(CabeceraComun) + sizeof(CabeceraBloqueDatos) + (i * record_size_guess);
-            if (current_record_offset + record_size_guess > BLOCK_SIZE) {
-                break; // Fuera de los límites del bloque
-            }
+    // Acceso disperso: no se declara lectura secuencial
+    cursor.AbrirPorIds(gestor_buffer_, disposicion, metadata_tabla->ObtenerFormatoAlmacenamiento(),
+                       std::move(ids), std::move(filtro));
+    total_consultas_++;
+    return Status::OK;
+}
 
-            std::vector<Byte> record_data_raw(datos_pagina + current_record_offset, 
-                                              datos_pagina + current_record_offset + record_size_guess);
-            resultados.push_back(DeserializarRegistro(record_data_raw, esquema));
-        }
-        gestor_buffer_->UnpinPage(page_id, false);
-        ActualizarEstadisticasPagina(page_id, "consulta");
+Status GestorRegistros::AbrirCursorFiltrado(const std::string& nombre_tabla, CursorRegistros& cursor,
+                                            std::shared_ptr<const FiltroCompilado> filtro) {
+    cursor.Cerrar();
+    std::shared_ptr<MetadataTabla> metadata_tabla;
+    const DisposicionRegistro* disposicion = nullptr;
+    Status estado = PrepararCursor(nombre_tabla, metadata_tabla, disposicion);
+    if (estado != Status::OK) {
+        return estado;
     }
 
+    cursor.Abrir(gestor_buffer_, disposicion, metadata_tabla->ObtenerFormatoAlmacenamiento(),
+                 metadata_tabla->ObtenerPaginasDatos(), nullptr, std::move(filtro));
     total_consultas_++;
-    std::cout << "Consultados " << resultados.size() << " registros de la tabla '" << nombre_tabla << "'." << std::endl;
     return Status::OK;
 }
 
-Status GestorRegistros::ActualizarRegistro(const std::string& nombre_tabla, RecordId id_registro, const DatosRegistro& nuevos_datos) {
-    if (!gestor_catalogo_) {
-        std::cerr << "Error: GestorCatalogo no está configurado." << std::endl;
-        return Status::ERROR;
+Status GestorRegistros::CompilarFiltro(const std::string& nombre_tabla, const std::vector<CondicionFiltro>& condiciones,
+                                       std::shared_ptr<const FiltroCompilado>& filtro) {
+    std::shared_ptr<MetadataTabla> metadata_tabla;
+    const DisposicionRegistro* disposicion = nullptr;
+    Status estado = PrepararCursor(nombre_tabla, metadata_tabla, disposicion);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    std::vector<ColumnMetadata> columnas;
+    for (uint32_t i = 0; i < disposicion->NumeroColumnas(); ++i) {
+        columnas.push_back(disposicion->Columna(i));
+    }
+    auto compilado = std::make_shared<FiltroCompilado>();
+    estado = FiltroCompilado::Compilar(columnas, condiciones, *compilado);
+    if (estado != Status::OK) {
+        return estado;
     }
+    filtro = std::move(compilado);
+    return Status::OK;
+}
 
+Status GestorRegistros::ConstruirIndicesTabla(const std::string& nombre_tabla, const std::vector<std::string>& columnas,
+                                              const OpcionesConstruccionMasiva& opciones) {
+    if (!gestor_indices_ || !gestor_catalogo_) {
+        std::cerr << "Error: GestorIndices o GestorCatalogo no está configurado." << std::endl;
+        return Status::ERROR;
+    }
     std::shared_ptr<MetadataTabla> metadata_tabla = gestor_catalogo_->ObtenerMetadataTabla(nombre_tabla);
     if (!metadata_tabla) {
         std::cerr << "Error: Tabla '" << nombre_tabla << "' no encontrada." << std::endl;
         return Status::NOT_FOUND;
     }
+    std::vector<uint32_t> posiciones;
+    for (const std::string& nombre_columna : columnas) {
+        int32_t indice = metadata_tabla->BuscarColumna(nombre_columna);
+        if (indice < 0) {
+            std::cerr << "Error: Columna '" << nombre_columna << "' no existe en '" << nombre_tabla << "'." << std::endl;
+            return Status::NOT_FOUND;
+        }
+        posiciones.push_back(static_cast<uint32_t>(indice));
+    }
 
-    EsquemaTablaCompleto esquema;
-    esquema.base_metadata.table_id = metadata_tabla->ObtenerIdTabla();
-    std::strncpy(esquema.base_metadata.table_name, metadata_tabla->ObtenerNombreTabla().c_str(), 63);
-    esquema.base_metadata.table_name[63] = '\0';
-    esquema.base_metadata.is_fixed_length_record = metadata_tabla->EsLongitudFija();
-    esquema.base_metadata.num_records = metadata_tabla->ObtenerNumeroRegistros();
-    esquema.base_metadata.fixed_record_size = metadata_tabla->ObtenerTamanoRegistroFijo();
-
-    for (const auto& col_meta : metadata_tabla->ObtenerColumnas()) {
-        ColumnMetadata cm;
-        std::strncpy(cm.name, col_meta.nombre.c_str(), 63);
-        cm.name[63] = '\0';
-        cm.type = col_meta.tipo;
-        cm.size = col_meta.tamano;
-        esquema.columns.push_back(cm);
+    CursorRegistros cursor;
+    Status estado = AbrirCursor(nombre_tabla, cursor);
+    if (estado != Status::OK) {
+        return estado;
     }
+    // Solo se extraen las columnas indexadas; el resto del registro no se deserializa
+    VistaRegistro vista;
+    FuenteFilasIndice siguiente_fila = [&](RecordId& id_registro, std::vector<std::string>& valores) {
+        if (!cursor.Siguiente(id_registro, vista)) {
+            return false;
+        }
+        valores.resize(posiciones.size());
+        for (size_t i = 0; i < posiciones.size(); ++i) {
+            valores[i] = vista.ObtenerComoTexto(posiciones[i]);
+        }
+        return true;
+    };
+    return gestor_indices_->ConstruirIndicesMasivos(nombre_tabla, columnas, siguiente_fila, opciones);
+}
 
-    if (!ValidarDatosRegistro(nuevos_datos, esquema)) {
-        std::cerr << "Error: Nuevos datos de registro no válidos para el esquema de la tabla." << std::endl;
-        return Status::INVALID_ARGUMENT;
+Status GestorRegistros::ConsultarTodosLosRegistros(const std::string& nombre_tabla, std::vector<DatosRegistro>& resultados) {
+    Status estado = ConsultarEnParalelo(nombre_tabla, nullptr, resultados);
+    if (estado != Status::OK) {
+        return estado;
     }
+    std::cout << "Consultados " << resultados.size() << " registros de la tabla '" << nombre_tabla << "'." << std::endl;
+    return Status::OK;
+}
 
-    std::vector<Byte> nuevos_datos_raw = SerializarRegistro(nuevos_datos, esquema);
-    uint32_t nuevo_tamano_registro = nuevos_datos_raw.size();
+// === REGISTRO DE ESCRITURA ANTICIPADA ===
 
-    // Necesitaríamos un índice o un mapeo RecordId -> (PageId, Offset) para encontrar el registro
-    // Para simplificar, escanearemos linealmente y actualizaremos si el tamaño es el mismo.
-    // Si el tamaño cambia, es una operación más compleja (eliminar y reinsertar).
+void GestorRegistros::RegistrarCambioPagina(PageId id_pagina, Byte* datos_pagina, TipoRegistroWAL tipo,
+                                            uint32_t slot, const Byte* datos, uint32_t longitud) {
+    if (!gestor_wal_) {
+        return;
+    }
+    // El LSN de recuperación se toma antes de añadir el registro, así lo cubre
+    // aunque un punto de control se ejecute entre las dos llamadas
+    gestor_buffer_->MarcarModificada(id_pagina, gestor_wal_->LSNFinal());
+    LSN lsn = gestor_wal_->Añadir(tipo, id_pagina, slot, datos, longitud);
+    if (lsn != LSN_INVALIDO) {
+        reinterpret_cast<CabeceraComun*>(datos_pagina)->lsn_pagina = lsn;
+    }
+}
 
-    for (PageId page_id : metadata_tabla->ObtenerPaginasDatos()) {
-        Pagina pagina_info;
-        Status pin_status = gestor_buffer_->PinPage(page_id, pagina_info);
-        if (pin_status != Status::OK) {
-            std::cerr << "Advertencia: No se pudo anclar la página " << page_id << " para actualización." << std::endl;
-            continue;
+Status GestorRegistros::CrearPaginaDatos(MetadataTabla& metadata_tabla, PageId& id_pagina, Byte*& datos_pagina) {
+    id_pagina = metadata_tabla.ObtenerPaginaReservada();
+    if (id_pagina == INVALID_PAGE_ID) {
+        // Crecimiento geométrico: la tabla duplica sus páginas con cada extensión
+        uint32_t paginas_deseadas = std::min(PAGINAS_EXTENSION_MAXIMA,
+                                             std::max(PAGINAS_EXTENSION_INICIAL, metadata_tabla.ObtenerNumeroPaginasAsignadas()));
+        BlockId primer_bloque = INVALID_PAGE_ID;
+        uint32_t paginas_reservadas = 0;
+        Status estado = gestor_buffer_->ReservarExtension(paginas_deseadas, primer_bloque, paginas_reservadas);
+        if (estado != Status::OK) {
+            return estado;
         }
+        metadata_tabla.AñadirExtension(primer_bloque, paginas_reservadas);
+        id_pagina = primer_bloque;
+    }
+    return gestor_buffer_->NewPageInExtent(id_pagina, datos_pagina);
+}
 
-        Byte* datos_pagina = gestor_buffer_->GetPageData(page_id);
-        if (!datos_pagina) {
-            gestor_buffer_->UnpinPage(page_id, false);
-            continue;
+void GestorRegistros::InicializarPaginaDatos(const MetadataTabla& metadata_tabla, const DisposicionRegistro& disposicion,
+                                             PageId id_pagina, Byte* datos_pagina) {
+    if (metadata_tabla.ObtenerFormatoAlmacenamiento() == FormatoAlmacenamiento::COLUMNAS_PAX) {
+        PaginaPAX(datos_pagina, disposicion).Inicializar(id_pagina, metadata_tabla.UsaCodificacionLigera());
+        RegistrarCambioPagina(id_pagina, datos_pagina, TipoRegistroWAL::IMAGEN_PAGINA, 0, datos_pagina, BLOCK_SIZE);
+        return;
+    }
+    PaginaRanurada(datos_pagina).Inicializar(id_pagina);
+    RegistrarCambioPagina(id_pagina, datos_pagina, TipoRegistroWAL::INICIALIZAR_PAGINA);
+}
+
+Status GestorRegistros::InsertarEnPagina(const MetadataTabla& metadata_tabla, const DisposicionRegistro& disposicion,
+                                         PageId id_pagina, Byte* datos_pagina, const std::vector<Byte>& registro,
+                                         uint32_t& slot) {
+    const uint32_t longitud = static_cast<uint32_t>(registro.size());
+    if (metadata_tabla.ObtenerFormatoAlmacenamiento() == FormatoAlmacenamiento::COLUMNAS_PAX) {
+        // La página se recodifica entera: se registra su imagen, no el registro
+        Status estado = PaginaPAX(datos_pagina, disposicion).Insertar(registro.data(), longitud, slot);
+        if (estado == Status::OK) {
+            RegistrarCambioPagina(id_pagina, datos_pagina, TipoRegistroWAL::IMAGEN_PAGINA, 0, datos_pagina, BLOCK_SIZE);
         }
+        return estado;
+    }
+    Status estado = PaginaRanurada(datos_pagina).Insertar(registro.data(), longitud, slot);
+    if (estado == Status::OK) {
+        RegistrarCambioPagina(id_pagina, datos_pagina, TipoRegistroWAL::INSERTAR, slot, registro.data(), longitud);
+    }
+    return estado;
+}
 
-        CabeceraComun* cabecera_comun = reinterpret_cast<CabeceraComun*>(datos_pagina);
-        CabeceraBloqueDatos* cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
+Status GestorRegistros::ConfirmarCambios() {
+    if (!gestor_wal_) {
+        return Status::OK;
+    }
+    // Las páginas nuevas de la tabla forman parte de la misma operación; el número
+    // de registros no: se escribe con GuardarCatalogo() y se recuenta tras una caída
+    if (gestor_catalogo_) {
+        Status estado_catalogo = gestor_catalogo_->PersistirCambiosPendientes();
+        if (estado_catalogo != Status::OK) {
+            std::cerr << "Error: No se pudo escribir el catálogo de la operación: " << StatusToString(estado_catalogo) << std::endl;
+            return estado_catalogo;
+        }
+    }
+    Status estado = gestor_wal_->Confirmar();
+    if (estado != Status::OK) {
+        std::cerr << "Error: No se pudo hacer duradero el log de la operación: " << StatusToString(estado) << std::endl;
+        return estado;
+    }
+    if (gestor_wal_->NecesitaPuntoControl()) {
+        // Los contadores y estadísticas del catálogo no pasan por el punto de confirmación
+        if (gestor_catalogo_ && gestor_catalogo_->GuardarCatalogo() != Status::OK) {
+            std::cerr << "Advertencia: No se pudo guardar el catálogo en el punto de control." << std::endl;
+        }
+        Status estado_punto_control = gestor_wal_->PuntoControl(*gestor_buffer_);
+        if (estado_punto_control != Status::OK) {
+            std::cerr << "Advertencia: Falló el punto de control del WAL: " << StatusToString(estado_punto_control) << std::endl;
+        }
+    }
+    return Status::OK;
+}
 
-        uint32_t record_size_guess = esquema.base_metadata.is_fixed_length_record ? 
-                                     esquema.base_metadata.fixed_record_size : 128; // Estimado
+Status GestorRegistros::AplicarRegistroWAL(const RegistroWAL& registro, Byte* datos_pagina) {
+    PaginaRanurada pagina(datos_pagina);
+    if (registro.tipo == TipoRegistroWAL::INICIALIZAR_PAGINA) {
+        pagina.Inicializar(registro.id_bloque);
+        return Status::OK;
+    }
+    if (registro.tipo == TipoRegistroWAL::IMAGEN_PAGINA) {
+        if (registro.datos.size() != BLOCK_SIZE) {
+            return Status::INVALID_FORMAT;
+        }
+        std::memcpy(datos_pagina, registro.datos.data(), BLOCK_SIZE);
+        return Status::OK;
+    }
+    if (!pagina.EsPaginaDatos()) {
+        return Status::INVALID_PAGE_TYPE;
+    }
 
-        for (uint32_t i = 0; i < cabecera_datos->numero_registros_activos; ++i) {
-            uint32_t current_record_offset = sizeof(CabeceraComun) + sizeof(CabeceraBloqueDatos) + (i * record_size_guess);
-            if (current_record_offset + record_size_guess > BLOCK_SIZE) {
-                break;
+    const Byte* datos = registro.datos.data();
+    uint32_t longitud = static_cast<uint32_t>(registro.datos.size());
+    switch (registro.tipo) {
+        case TipoRegistroWAL::INSERTAR: {
+            // La página pudo escribirse a disco después del cambio y antes de copiar su LSN
+            const Byte* actual = nullptr;
+            uint32_t longitud_actual = 0;
+            if (pagina.Obtener(registro.slot, actual, longitud_actual) && longitud_actual == longitud &&
+                std::memcmp(actual, datos, longitud) == 0) {
+                return Status::OK;
             }
+            std::vector<Byte> copia(datos_pagina, datos_pagina + BLOCK_SIZE);
+            uint32_t slot = 0;
+            Status estado = pagina.Insertar(datos, longitud, slot);
+            if (estado == Status::OK && slot != registro.slot) {
+                std::memcpy(datos_pagina, copia.data(), BLOCK_SIZE);
+                return Status::ERROR; // La página no está en el estado en que se registró
+            }
+            return estado;
+        }
+        case TipoRegistroWAL::ACTUALIZAR:
+            return pagina.Actualizar(registro.slot, datos, longitud);
+        case TipoRegistroWAL::ELIMINAR: {
+            Status estado = pagina.Eliminar(registro.slot);
+            return (estado == Status::NOT_FOUND) ? Status::OK : estado; // Ya estaba eliminado
+        }
+        case TipoRegistroWAL::COMPACTAR:
+            pagina.Compactar();
+            return Status::OK;
+        default:
+            return Status::INVALID_ARGUMENT;
+    }
+}
 
-            std::vector<Byte> old_record_data_raw(datos_pagina + current_record_offset, 
-                                                  datos_pagina + current_record_offset + record_size_guess);
-            DatosRegistro old_registro = DeserializarRegistro(old_record_data_raw, esquema);
+// === RECORRIDOS PARALELOS ===
 
-            if (!old_registro.campos.empty() && esquema.columns[0].type == ColumnType::INT) {
-                try {
-                    RecordId current_found_id = std::stoul(old_registro.campos[0]);
-                    if (current_found_id == id_registro) {
-                        // Encontrado el registro. Ahora verificar si el tamaño es compatible.
-                        // Para esta simulación, solo actualizamos si el tamaño es el mismo.
-                        if (nuevo_tamano_registro <= record_size_guess) { // Permitir actualización si el nuevo es igual o más pequeño
-                            std::memcpy(datos_pagina + current_record_offset, nuevos_datos_raw.data(), nuevo_tamano_registro);
-                            // Rellenar el resto con ceros si el nuevo es más pequeño
-                            if (nuevo_tamano_registro < record_size_guess) {
-                                std::memset(datos_pagina + current_record_offset + nuevo_tamano_registro, 0, record_size_guess - nuevo_tamano_registro);
-                            }
-                            gestor_buffer_->UnpinPage(page_id, true); // Marcar sucia
-                            ActualizarEstadisticasPagina(page_id, "actualizacion");
-                            total_actualizaciones_++;
-                            std::cout << "Registro " << id_registro << " actualizado exitosamente en tabla '" << nombre_tabla << "'." << std::endl;
-                            return Status::OK;
-                        } else {
-                            std::cerr << "Error: Nuevo tamaño de registro (" << nuevo_tamano_registro 
-                                      << ") excede el tamaño del slot existente (" << record_size_guess << "). "
-                                      << "Se requiere operación de eliminación/reinserción." << std::endl;
-                            gestor_buffer_->UnpinPage(page_id, false);
-                            return Status::OUT_OF_SPACE_FOR_UPDATE;
-                        }
-                    }
-                } catch (const std::exception& e) {
-                    std::cerr << "Advertencia: Error al parsear ID de registro en página " << page_id << " durante actualización: " << e.what() << std::endl;
-                }
+PoolHilos& GestorRegistros::ObtenerPoolEscaneo() {
+    std::call_once(inicializacion_pool_escaneo_, [this]() {
+        pool_escaneo_ = std::make_unique<PoolHilos>();
+    });
+    return *pool_escaneo_;
+}
+
+Status GestorRegistros::AgregarEnParalelo(const std::string& nombre_tabla, std::shared_ptr<const FiltroCompilado> filtro,
+                                          const std::vector<EspecificacionAgregado>& especificaciones,
+                                          std::vector<AgregadoParcial>& agregados,
+                                          EstadisticasEscaneoParalelo* estadisticas,
+                                          const OpcionesEscaneoParalelo& opciones) {
+    std::shared_ptr<MetadataTabla> metadata_tabla;
+    const DisposicionRegistro* disposicion = nullptr;
+    Status estado = PrepararCursor(nombre_tabla, metadata_tabla, disposicion);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    std::vector<ColumnMetadata> columnas;
+    for (uint32_t i = 0; i < disposicion->NumeroColumnas(); ++i) {
+        columnas.push_back(disposicion->Columna(i));
+    }
+    estado = EscaneoParalelo::PrepararAgregados(columnas, especificaciones, agregados);
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    PoolHilos& pool = ObtenerPoolEscaneo();
+    EscaneoParalelo escaneo(*gestor_buffer_, *disposicion, metadata_tabla->ObtenerFormatoAlmacenamiento(),
+                            metadata_tabla->ObtenerPaginasDatos(), std::move(filtro), pool.ObtenerNumeroHilos(), opciones);
+    estado = escaneo.Agregar(pool, agregados);
+    if (estadisticas) {
+        *estadisticas = escaneo.Estadisticas();
+    }
+    total_consultas_++;
+    return estado;
+}
+
+Status GestorRegistros::ConsultarEnParalelo(const std::string& nombre_tabla, std::shared_ptr<const FiltroCompilado> filtro,
+                                            std::vector<DatosRegistro>& resultados, std::vector<RecordId>* ids,
+                                            const OpcionesEscaneoParalelo& opciones) {
+    resultados.clear();
+    if (ids) {
+        ids->clear();
+    }
+    std::shared_ptr<MetadataTabla> metadata_tabla;
+    const DisposicionRegistro* disposicion = nullptr;
+    Status estado = PrepararCursor(nombre_tabla, metadata_tabla, disposicion);
+    if (estado != Status::OK) {
+        return estado;
+    }
+
+    PoolHilos& pool = ObtenerPoolEscaneo();
+    EscaneoParalelo escaneo(*gestor_buffer_, *disposicion, metadata_tabla->ObtenerFormatoAlmacenamiento(),
+                            metadata_tabla->ObtenerPaginasDatos(), std::move(filtro), pool.ObtenerNumeroHilos(), opciones);
+    // Un morsel lo recorre un solo trabajador: su vector no necesita sincronización
+    std::vector<std::vector<DatosRegistro>> registros_morsel(escaneo.NumeroMorsels());
+    std::vector<std::vector<RecordId>> ids_morsel(ids ? escaneo.NumeroMorsels() : 0);
+    estado = escaneo.Ejecutar(pool, [&](uint32_t, size_t morsel, PageId id_pagina,
+                                         const std::vector<VistaRegistro>& vistas,
+                                         const std::vector<uint32_t>& slots,
+                                         const std::vector<uint32_t>& seleccion) {
+        for (uint32_t posicion : seleccion) {
+            registros_morsel[morsel].push_back(DeserializarRegistro(vistas[posicion]));
+            if (ids) {
+                ids_morsel[morsel].push_back(ConstruirRecordId(id_pagina, slots[posicion]));
             }
         }
-        gestor_buffer_->UnpinPage(page_id, false);
+    });
+    if (estado != Status::OK) {
+        return estado;
     }
 
-    std::cout << "Registro " << id_registro << " no encontrado en tabla '" << nombre_tabla << "' para actualizar." << std::endl;
-    return Status::NOT_FOUND;
+    resultados.reserve(escaneo.Estadisticas().registros_seleccionados);
+    for (size_t m = 0; m < registros_morsel.size(); ++m) {
+        std::move(registros_morsel[m].begin(), registros_morsel[m].end(), std::back_inserter(resultados));
+        if (ids) {
+            ids->insert(ids->end(), ids_morsel[m].begin(), ids_morsel[m].end());
+        }
+    }
+    total_consultas_++;
+    return Status::OK;
 }
 
-Status GestorRegistros::EliminarRegistroPorID(const std::string& nombre_tabla, RecordId id_registro) {
+Status GestorRegistros::ActualizarRegistro(const std::string& nombre_tabla, RecordId id_registro, const DatosRegistro& nuevos_datos) {
     if (!gestor_catalogo_) {
         std::cerr << "Error: GestorCatalogo no está configurado." << std::endl;
         return Status::ERROR;
@@ -463,80 +949,144 @@ Status GestorRegistros::EliminarRegistroPorID(const std::string& nombre_tabla, R
         return Status::NOT_FOUND;
     }
 
-    EsquemaTablaCompleto esquema;
-    esquema.base_metadata.table_id = metadata_tabla->ObtenerIdTabla();
-    std::strncpy(esquema.base_metadata.table_name, metadata_tabla->ObtenerNombreTabla().c_str(), 63);
-    esquema.base_metadata.table_name[63] = '\0';
-    esquema.base_metadata.is_fixed_length_record = metadata_tabla->EsLongitudFija();
-    esquema.base_metadata.num_records = metadata_tabla->ObtenerNumeroRegistros();
-    esquema.base_metadata.fixed_record_size = metadata_tabla->ObtenerTamanoRegistroFijo();
+    EsquemaTablaCompleto esquema = ConstruirEsquema(*metadata_tabla);
 
-    for (const auto& col_meta : metadata_tabla->ObtenerColumnas()) {
-        ColumnMetadata cm;
-        std::strncpy(cm.name, col_meta.nombre.c_str(), 63);
-        cm.name[63] = '\0';
-        cm.type = col_meta.tipo;
-        cm.size = col_meta.tamano;
-        esquema.columns.push_back(cm);
+    const DisposicionRegistro* disposicion = ObtenerDisposicion(esquema);
+    if (!disposicion) {
+        return Status::INVALID_ARGUMENT;
     }
 
-    for (PageId page_id : metadata_tabla->ObtenerPaginasDatos()) {
-        Pagina pagina_info;
-        Status pin_status = gestor_buffer_->PinPage(page_id, pagina_info);
-        if (pin_status != Status::OK) {
-            std::cerr << "Advertencia: No se pudo anclar la página " << page_id << " para eliminación." << std::endl;
-            continue;
-        }
+    if (!ValidarDatosRegistro(nuevos_datos, esquema)) {
+        std::cerr << "Error: Nuevos datos de registro no válidos para el esquema de la tabla." << std::endl;
+        return Status::INVALID_ARGUMENT;
+    }
 
-        Byte* datos_pagina = gestor_buffer_->GetPageData(page_id);
-        if (!datos_pagina) {
-            gestor_buffer_->UnpinPage(page_id, false);
-            continue;
+    std::vector<Byte> nuevos_datos_raw;
+    Status estado_serializacion = SerializarRegistro(nuevos_datos, *disposicion, nuevos_datos_raw);
+    if (estado_serializacion != Status::OK) {
+        return estado_serializacion;
+    }
+    uint32_t nuevo_tamano_registro = nuevos_datos_raw.size();
+
+    Byte* datos_pagina = nullptr;
+    Status estado = AnclarPaginaRegistro(metadata_tabla, id_registro, datos_pagina);
+    if (estado != Status::OK) {
+        std::cout << "Registro " << id_registro << " no encontrado en tabla '" << nombre_tabla << "' para actualizar." << std::endl;
+        return (estado == Status::INVALID_PAGE_TYPE) ? Status::NOT_FOUND : estado;
+    }
+    PageId id_pagina = PaginaDeRecordId(id_registro);
+
+    // Los índices necesitan las claves anteriores para retirar las que cambian
+    const bool con_indices = !ObtenerColumnasIndexadas(nombre_tabla, *metadata_tabla).empty();
+    DatosRegistro datos_anteriores;
+    if (con_indices && !LeerRegistroAnclado(*metadata_tabla, *disposicion, datos_pagina, id_registro, datos_anteriores)) {
+        gestor_buffer_->UnpinPage(id_pagina, false);
+        std::cout << "Registro " << id_registro << " no encontrado en tabla '" << nombre_tabla << "' para actualizar." << std::endl;
+        return Status::NOT_FOUND;
+    }
+
+    // El registro conserva su slot: si crece se reubica dentro de la misma página
+    PaginaRanurada pagina(datos_pagina);
+    const bool columnar = metadata_tabla->ObtenerFormatoAlmacenamiento() == FormatoAlmacenamiento::COLUMNAS_PAX;
+    if (columnar) {
+        estado = PaginaPAX(datos_pagina, *disposicion).Actualizar(SlotDeRecordId(id_registro), nuevos_datos_raw.data(),
+                                                                  nuevo_tamano_registro);
+    } else {
+        estado = pagina.Actualizar(SlotDeRecordId(id_registro), nuevos_datos_raw.data(), nuevo_tamano_registro);
+    }
+    if (estado != Status::OK) {
+        if (estado == Status::OUT_OF_SPACE_FOR_UPDATE) {
+            std::cerr << "Error: El nuevo registro (" << nuevo_tamano_registro << " bytes) no cabe en la página "
+                      << id_pagina << ". Se requiere operación de eliminación/reinserción." << std::endl;
+        } else {
+            std::cout << "Registro " << id_registro << " no encontrado en tabla '" << nombre_tabla << "' para actualizar." << std::endl;
         }
+        gestor_buffer_->UnpinPage(id_pagina, false);
+        return estado;
+    }
+    if (columnar) {
+        RegistrarCambioPagina(id_pagina, datos_pagina, TipoRegistroWAL::IMAGEN_PAGINA, 0, datos_pagina, BLOCK_SIZE);
+    } else {
+        RegistrarCambioPagina(id_pagina, datos_pagina, TipoRegistroWAL::ACTUALIZAR, SlotDeRecordId(id_registro),
+                              nuevos_datos_raw.data(), nuevo_tamano_registro);
+    }
+    NotificarEspacioLibre(id_pagina, pagina.EspacioLibre());
+    gestor_buffer_->UnpinPage(id_pagina, true); // Marcar sucia
+    ActualizarEstadisticasPagina(id_pagina, "actualizacion");
+    total_actualizaciones_++;
+    if (con_indices) {
+        MantenerIndices(nombre_tabla, *metadata_tabla, *disposicion, &datos_anteriores, &nuevos_datos, id_registro);
+    }
+    estado = ConfirmarCambios();
+    if (estado != Status::OK) {
+        return estado;
+    }
+    std::cout << "Registro " << id_registro << " actualizado exitosamente en tabla '" << nombre_tabla << "'." << std::endl;
+    return Status::OK;
+}
 
-        CabeceraComun* cabecera_comun = reinterpret_cast<CabeceraComun*>(datos_pagina);
-        CabeceraBloqueDatos* cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
+Status GestorRegistros::EliminarRegistroPorID(const std::string& nombre_tabla, RecordId id_registro) {
+    if (!gestor_catalogo_) {
+        std::cerr << "Error: GestorCatalogo no está configurado." << std::endl;
+        return Status::ERROR;
+    }
 
-        uint32_t record_size_guess = esquema.base_metadata.is_fixed_length_record ? 
-                                     esquema.base_metadata.fixed_record_size : 128; // Estimado
+    std::shared_ptr<MetadataTabla> metadata_tabla = gestor_catalogo_->ObtenerMetadataTabla(nombre_tabla);
+    if (!metadata_tabla) {
+        std::cerr << "Error: Tabla '" << nombre_tabla << "' no encontrada." << std::endl;
+        return Status::NOT_FOUND;
+    }
 
-        for (uint32_t i = 0; i < cabecera_datos->numero_registros_activos + cabecera_datos->numero_registros_eliminados; ++i) {
-            uint32_t current_record_offset = sizeof(CabeceraComun) + sizeof(CabeceraBloqueDatos) + (i * record_size_guess);
-            if (current_record_offset + record_size_guess > BLOCK_SIZE) {
-                break;
+    // PAX necesita la disposición para recodificar la página sin el registro, y los
+    // índices para leer las claves que hay que retirar
+    const bool columnar = metadata_tabla->ObtenerFormatoAlmacenamiento() == FormatoAlmacenamiento::COLUMNAS_PAX;
+    const bool con_indices = !ObtenerColumnasIndexadas(nombre_tabla, *metadata_tabla).empty();
+    const DisposicionRegistro* disposicion = nullptr;
+    if ((columnar || con_indices) && PrepararCursor(nombre_tabla, metadata_tabla, disposicion) != Status::OK) {
+        return Status::INVALID_ARGUMENT;
+    }
+
+    Byte* datos_pagina = nullptr;
+    Status estado = AnclarPaginaRegistro(metadata_tabla, id_registro, datos_pagina);
+    DatosRegistro datos_anteriores;
+    if (estado == Status::OK && con_indices &&
+        !LeerRegistroAnclado(*metadata_tabla, *disposicion, datos_pagina, id_registro, datos_anteriores)) {
+        gestor_buffer_->UnpinPage(PaginaDeRecordId(id_registro), false);
+        estado = Status::NOT_FOUND;
+    }
+    if (estado == Status::OK) {
+        PageId id_pagina = PaginaDeRecordId(id_registro);
+        PaginaRanurada pagina(datos_pagina);
+        estado = columnar ? PaginaPAX(datos_pagina, *disposicion).Eliminar(SlotDeRecordId(id_registro))
+                          : pagina.Eliminar(SlotDeRecordId(id_registro));
+        if (estado == Status::OK) {
+            // El slot queda libre y sus bytes como fragmentación hasta la próxima compactación
+            // (en PAX la página se recodifica sin él)
+            if (columnar) {
+                RegistrarCambioPagina(id_pagina, datos_pagina, TipoRegistroWAL::IMAGEN_PAGINA, 0, datos_pagina, BLOCK_SIZE);
+            } else {
+                RegistrarCambioPagina(id_pagina, datos_pagina, TipoRegistroWAL::ELIMINAR, SlotDeRecordId(id_registro));
             }
+            NotificarEspacioLibre(id_pagina, pagina.EspacioLibre());
 
-            std::vector<Byte> record_data_raw(datos_pagina + current_record_offset, 
-                                              datos_pagina + current_record_offset + record_size_guess);
-            DatosRegistro temp_registro = DeserializarRegistro(record_data_raw, esquema);
+            metadata_tabla->DecrementarNumeroRegistros();
+            gestor_catalogo_->ActualizarMetadataTabla(metadata_tabla);
 
-            if (!temp_registro.campos.empty() && esquema.columns[0].type == ColumnType::INT) {
-                try {
-                    RecordId current_found_id = std::stoul(temp_registro.campos[0]);
-                    if (current_found_id == id_registro) {
-                        // Marcar el registro como eliminado (no borrar físicamente para permitir compactación)
-                        // Para simulación, rellenaremos con un patrón o ceros para indicar eliminación
-                        std::memset(datos_pagina + current_record_offset, 0xDD, record_size_guess); // Patrón de "eliminado"
-
-                        cabecera_datos->numero_registros_activos--;
-                        cabecera_datos->numero_registros_eliminados++;
-                        cabecera_datos->necesita_compactacion = true; // La página necesita compactación
-
-                        metadata_tabla->DecrementarNumeroRegistros();
-                        gestor_catalogo_->ActualizarMetadataTabla(metadata_tabla);
-
-                        gestor_buffer_->UnpinPage(page_id, true); // Marcar sucia
-                        ActualizarEstadisticasPagina(page_id, "eliminacion");
-                        total_eliminaciones_++;
-                        std::cout << "Registro " << id_registro << " marcado para eliminación en tabla '" << nombre_tabla << "'." << std::endl;
-                        return Status::OK;
-                    }
-                } catch (const std::exception& e) {
-                    std::cerr << "Advertencia: Error al parsear ID de registro en página " << page_id << " durante eliminación: " << e.what() << std::endl;
-                }
+            gestor_buffer_->UnpinPage(id_pagina, true); // Marcar sucia
+            ActualizarEstadisticasPagina(id_pagina, "eliminacion");
+            total_eliminaciones_++;
+            if (con_indices) {
+                // Sin esto un slot reutilizado heredaría las entradas del registro borrado
+                MantenerIndices(nombre_tabla, *metadata_tabla, *disposicion, &datos_anteriores, nullptr, id_registro);
             }
+            estado = ConfirmarCambios();
+            if (estado != Status::OK) {
+                return estado;
+            }
+            std::cout << "Registro " << id_registro << " eliminado de la tabla '" << nombre_tabla << "'." << std::endl;
+            return Status::OK;
         }
-        gestor_buffer_->UnpinPage(page_id, false);
+        gestor_buffer_->UnpinPage(id_pagina, false);
     }
 
     std::cout << "Registro " << id_registro << " no encontrado en tabla '" << nombre_tabla << "' para eliminar." << std::endl;
@@ -557,75 +1107,68 @@ Status GestorRegistros::CompactarPagina(PageId id_pagina) {
         return Status::ERROR;
     }
 
-    CabeceraComun* cabecera_comun = reinterpret_cast<CabeceraComun*>(datos_pagina);
-    CabeceraBloqueDatos* cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
-
-    if (!cabecera_datos->necesita_compactacion) {
+    PaginaRanurada pagina(datos_pagina);
+    if (!pagina.Cabecera()->necesita_compactacion) {
         std::cout << "Página " << id_pagina << " no necesita compactación." << std::endl;
         gestor_buffer_->UnpinPage(id_pagina, false);
         return Status::OK;
     }
 
-    std::vector<DatosRegistro> registros_activos;
-    uint32_t record_size_guess = 128; // Estimado, se debería obtener del esquema de la tabla
-
-    // Necesitamos el esquema de la tabla para deserializar correctamente
-    // Esto implicaría buscar la tabla a la que pertenece esta página, lo cual
-    // es complejo sin un mapeo PageId -> TableId.
-    // Para esta simulación, asumiremos un esquema genérico o lo pasaremos como parámetro.
-    // O, más simple, compactaremos basándonos en el patrón de "eliminado" (0xDD)
-    // y el tamaño fijo o estimado.
+    // Los registros se juntan y se reescriben los offsets del directorio;
+    // los números de slot (y por tanto los RecordId) no cambian
+    pagina.Compactar();
+    RegistrarCambioPagina(id_pagina, datos_pagina, TipoRegistroWAL::COMPACTAR);
+    NotificarEspacioLibre(id_pagina, pagina.EspacioLibre());
 
-    // En un sistema real, se iteraría el directorio de slots, moviendo registros activos
-    // al inicio del espacio de datos y actualizando los offsets en el directorio.
-
-    // SIMPLIFICACIÓN: Reconstruir la página solo con registros no marcados con 0xDD
-    std::vector<Byte> temp_buffer(BLOCK_SIZE, 0); // Buffer temporal para la compactación
-    uint32_t current_write_offset = sizeof(CabeceraComun) + sizeof(CabeceraBloqueDatos);
-    uint32_t records_moved = 0;
-
-    // Copiar la cabecera común y la de datos al buffer temporal
-    std::memcpy(temp_buffer.data(), datos_pagina, sizeof(CabeceraComun) + sizeof(CabeceraBloqueDatos));
+    gestor_buffer_->UnpinPage(id_pagina, true); // Marcar sucia
+    ActualizarEstadisticasPagina(id_pagina, "compactacion");
+    total_compactaciones_++;
+    Status estado_confirmacion = ConfirmarCambios();
+    if (estado_confirmacion != Status::OK) {
+        return estado_confirmacion;
+    }
+    std::cout << "Página " << id_pagina << " compactada exitosamente. Registros activos: "
+              << pagina.Cabecera()->numero_registros_activos << std::endl;
+    return Status::OK;
+}
 
-    // Iterar sobre los registros existentes
-    for (uint32_t i = 0; i < cabecera_datos->numero_registros_activos + cabecera_datos->numero_registros_eliminados; ++i) {
-        uint32_t current_read_offset = sizeof(CabeceraComun) + sizeof(CabeceraBloqueDatos) + (i * record_size_guess);
-        if (current_read_offset + record_size_guess > BLOCK_SIZE) {
-            break;
+Status GestorRegistros::RecontarRegistros() {
+    if (!gestor_catalogo_) {
+        return Status::ERROR;
+    }
+    Status resultado = Status::OK;
+    for (const std::string& nombre_tabla : gestor_catalogo_->ListarTablas()) {
+        std::shared_ptr<MetadataTabla> metadata_tabla = gestor_catalogo_->ObtenerMetadataTabla(nombre_tabla);
+        if (!metadata_tabla) {
+            continue;
         }
-
-        // Verificar si el registro está "eliminado" (marcado con 0xDD)
-        bool is_deleted = true;
-        for (uint32_t byte_idx = 0; byte_idx < record_size_guess; ++byte_idx) {
-            if (datos_pagina[current_read_offset + byte_idx] != (Byte)0xDD) {
-                is_deleted = false;
+        uint64_t total = 0;
+        bool completo = true;
+        for (PageId id_pagina : metadata_tabla->ObtenerPaginasDatos()) {
+            Byte* datos_pagina = nullptr;
+            if (gestor_buffer_->PinPage(id_pagina, datos_pagina) != Status::OK || !datos_pagina) {
+                std::cerr << "Advertencia: No se pudo anclar la página " << id_pagina << " al recontar '"
+                          << nombre_tabla << "'." << std::endl;
+                completo = false;
                 break;
             }
+            PaginaRanurada pagina(datos_pagina);
+            if (pagina.EsPaginaDatos()) {
+                total += pagina.Cabecera()->numero_registros_activos; // También en páginas PAX
+            }
+            gestor_buffer_->UnpinPage(id_pagina, false);
         }
-
-        if (!is_deleted) {
-            // Es un registro activo, moverlo al espacio compactado
-            std::memcpy(temp_buffer.data() + current_write_offset, datos_pagina + current_read_offset, record_size_guess);
-            current_write_offset += record_size_guess;
-            records_moved++;
+        if (!completo) {
+            resultado = Status::IO_ERROR;
+            continue;
+        }
+        if (total != metadata_tabla->ObtenerNumeroRegistros()) {
+            std::cout << "GestorRegistros: '" << nombre_tabla << "' tiene " << total << " registros (el catálogo decía "
+                      << metadata_tabla->ObtenerNumeroRegistros() << ")." << std::endl;
+            metadata_tabla->EstablecerNumeroRegistros(static_cast<uint32_t>(total));
         }
     }
-
-    // Copiar los datos compactados de vuelta a la página original
-    std::memcpy(datos_pagina, temp_buffer.data(), BLOCK_SIZE);
-
-    // Actualizar la cabecera de datos después de la compactación
-    cabecera_datos->numero_registros_activos = records_moved;
-    cabecera_datos->numero_registros_eliminados = 0; // Todos los eliminados fueron removidos
-    cabecera_datos->espacio_libre_total = BLOCK_SIZE - current_write_offset; // Update free space
-    cabecera_datos->fragmentacion_interna = 0; // No hay fragmentación interna después de compactar
-    cabecera_datos->necesita_compactacion = false;
-
-    gestor_buffer_->UnpinPage(id_pagina, true); // Marcar sucia
-    ActualizarEstadisticasPagina(id_pagina, "compactacion");
-    total_compactaciones_++;
-    std::cout << "Página " << id_pagina << " compactada exitosamente. Registros activos: " << records_moved << std::endl;
-    return Status::OK;
+    return resultado;
 }
 
 void GestorRegistros::ImprimirEstadisticasTabla(const std::string& nombre_tabla) {
@@ -644,6 +1187,11 @@ void GestorRegistros::ImprimirEstadisticasTabla(const std::string& nombre_tabla)
     std::cout << "ID de Tabla: " << metadata_tabla->ObtenerIdTabla() << std::endl;
     std::cout << "Número de Registros: " << metadata_tabla->ObtenerNumeroRegistros() << std::endl;
     std::cout << "Longitud Fija: " << (metadata_tabla->EsLongitudFija() ? "Sí" : "No") << std::endl;
+    std::cout << "Formato de Almacenamiento: " << FormatoAlmacenamientoToString(metadata_tabla->ObtenerFormatoAlmacenamiento());
+    if (metadata_tabla->ObtenerFormatoAlmacenamiento() == FormatoAlmacenamiento::COLUMNAS_PAX) {
+        std::cout << (metadata_tabla->UsaCodificacionLigera() ? " (codificación ligera)" : " (sin codificación)");
+    }
+    std::cout << std::endl;
     if (metadata_tabla->EsLongitudFija()) {
         std::cout << "Tamaño Registro Fijo: " << metadata_tabla->ObtenerTamanoRegistroFijo() << " bytes" << std::endl;
     }
@@ -673,6 +1221,18 @@ void GestorRegistros::ImprimirEstadisticasTabla(const std::string& nombre_tabla)
             std::cout << "  Página " << page_id << ": Estadísticas no disponibles." << std::endl;
         }
     }
+    // Las estadísticas por página solo cubren las páginas tocadas en esta sesión: se cuenta la tabla real
+    std::vector<AgregadoParcial> conteo;
+    EstadisticasEscaneoParalelo recorrido;
+    if (AgregarEnParalelo(nombre_tabla, nullptr, {EspecificacionAgregado()}, conteo, &recorrido) == Status::OK) {
+        std::cout << "\nRegistros vivos (recorrido paralelo): " << conteo[0].ComoTexto() << " en "
+                  << recorrido.paginas << " páginas, " << recorrido.trabajadores << " hilos, "
+                  << recorrido.morsels_robados << "/" << recorrido.morsels << " morsels robados" << std::endl;
+    }
+    auto it_mapa = mapas_espacio_libre_.find(metadata_tabla->ObtenerIdTabla());
+    if (it_mapa != mapas_espacio_libre_.end()) {
+        std::cout << it_mapa->second->ObtenerEstadisticas();
+    }
     std::cout << "---------------------------------------" << std::endl;
 }
 
@@ -727,76 +1287,42 @@ void GestorRegistros::ImprimirEstadisticasGenerales() {
 
 // === MÉTODOS AUXILIARES PRIVADOS ===
 
-std::vector<Byte> GestorRegistros::SerializarRegistro(const DatosRegistro& datos_registro, 
-                                                     const EsquemaTablaCompleto& esquema) const {
-    std::vector<Byte> buffer;
-    std::stringstream ss;
-
-    // Para simplificar, serializaremos los campos como strings separados por un delimitador
-    // En un sistema real, se usaría un formato binario más eficiente y preciso.
-    for (size_t i = 0; i < datos_registro.campos.size(); ++i) {
-        ss << datos_registro.campos[i];
-        if (i < datos_registro.campos.size() - 1) {
-            ss << "|"; // Delimitador simple
-        }
-    }
-    std::string serialized_string = ss.str();
-    
-    // Copiar la cadena serializada al buffer de bytes
-    buffer.resize(serialized_string.length());
-    std::memcpy(buffer.data(), serialized_string.c_str(), serialized_string.length());
-
-    return buffer;
+Status GestorRegistros::SerializarRegistro(const DatosRegistro& datos_registro, 
+                                           const DisposicionRegistro& disposicion,
+                                           std::vector<Byte>& datos_raw) const {
+    return disposicion.Codificar(datos_registro.campos, datos_raw);
 }
 
-DatosRegistro GestorRegistros::DeserializarRegistro(const std::vector<Byte>& datos_raw, 
-                                                   const EsquemaTablaCompleto& esquema) const {
+DatosRegistro GestorRegistros::DeserializarRegistro(const VistaRegistro& vista) const {
     DatosRegistro registro;
-    if (datos_raw.empty()) {
+    if (!vista.EsValida()) {
         return registro;
     }
-
-    std::string raw_string(datos_raw.begin(), datos_raw.end());
-    std::stringstream ss(raw_string);
-    std::string segment;
-
-    // Deserializar campos basados en el esquema
-    for (size_t i = 0; i < esquema.columns.size(); ++i) {
-        if (std::getline(ss, segment, '|')) { // Usar el mismo delimitador
-            registro.AñadirCampo(esquema.columns[i].name, segment);
-        } else {
-            // No hay suficientes segmentos, rellenar con vacío o error
-            registro.AñadirCampo(esquema.columns[i].name, ""); 
-        }
+    registro.campos.reserve(vista.NumeroColumnas());
+    for (uint32_t i = 0; i < vista.NumeroColumnas(); ++i) {
+        registro.campos.push_back(vista.ObtenerComoTexto(i));
     }
     return registro;
 }
 
-bool GestorRegistros::BuscarSlotLibre(Byte* datos_pagina, const CabeceraBloqueDatos& cabecera_datos, 
-                                    uint32_t& id_slot_libre) {
-    // Para tablas de longitud fija, un slot libre es simplemente un espacio no usado.
-    // Para tablas de longitud variable, se necesitaría un directorio de slots.
-    // En esta simulación, asumimos que los registros se insertan de forma contigua
-    // y el "slot libre" es el siguiente espacio disponible.
-
-    // Si la página tiene registros eliminados, se podría implementar lógica para reutilizar esos slots.
-    // Por ahora, solo buscamos el siguiente espacio después del último registro activo.
-    
-    // Este método es una simplificación. En un SGBD real, la gestión de slots es más compleja.
-    // Si la tabla es de longitud fija, el id_slot_libre podría ser el índice del registro.
-    // Si es de longitud variable, se buscaría en el directorio de slots.
-
-    // Dada la estructura actual de CabeceraBloqueDatos, no hay un "directorio de slots" explícito aquí.
-    // La lógica de "espacio libre" se basa en `espacio_libre_total` y `offset_espacio_libre`.
-    // Para esta implementación simplificada, `BuscarSlotLibre` no es directamente aplicable
-    // a cómo se gestiona el espacio en `InsertarRegistro`.
-    // La lógica de `CalcularOffsetInsercion` ya maneja la búsqueda de espacio.
-    // Este método podría ser más relevante si tuviéramos un bitmap de slots o un directorio.
-
-    // Retornamos false para indicar que la búsqueda de un "slot libre" específico
-    // no es el enfoque principal con la implementación actual de espacio contiguo.
-    id_slot_libre = 0; // Valor por defecto
-    return false;
+Status GestorRegistros::AnclarPaginaRegistro(const std::shared_ptr<MetadataTabla>& metadata_tabla,
+                                             RecordId id_registro, Byte*& datos_pagina) {
+    PageId id_pagina = PaginaDeRecordId(id_registro);
+    MapaEspacioLibre* mapa_espacio = ObtenerMapaEspacioLibre(metadata_tabla);
+    // El mapa de espacio libre conoce todas las páginas de la tabla: comprobación O(1)
+    if (id_registro == INVALID_RECORD_ID || !mapa_espacio || !mapa_espacio->Contiene(id_pagina)) {
+        return Status::NOT_FOUND;
+    }
+    Status estado = gestor_buffer_->PinPage(id_pagina, datos_pagina);
+    if (estado != Status::OK) {
+        std::cerr << "Error: No se pudo anclar la página " << id_pagina << " del registro " << id_registro << "." << std::endl;
+        return estado;
+    }
+    if (!PaginaRanurada(datos_pagina).EsPaginaDatos()) {
+        gestor_buffer_->UnpinPage(id_pagina, false);
+        return Status::INVALID_PAGE_TYPE;
+    }
+    return Status::OK;
 }
 
 void GestorRegistros::ActualizarEstadisticasPagina(PageId id_pagina, const std::string& tipo_operacion) {
@@ -832,7 +1358,7 @@ void GestorRegistros::ActualizarEstadisticasPagina(PageId id_pagina, const std::
 
     stats.timestamp_ultima_actualizacion = ObtenerTimestampActual();
 
-    gestor_buffer_->UnpinPage(id_pagina, true); // Marcar sucia si las estadísticas de la cabecera cambiaron
+    gestor_buffer_->UnpinPage(id_pagina, false); // Solo se ha leído la cabecera
 }
 
 bool GestorRegistros::ValidarDatosRegistro(const DatosRegistro& datos_registro, 
@@ -865,8 +1391,10 @@ bool GestorRegistros::ValidarDatosRegistro(const DatosRegistro& datos_registro,
                     return false;
                 }
                 break;
-            case ColumnType::STRING:
-                // No hay validación de tamaño máximo para STRING aquí, pero se podría añadir
+            case ColumnType::VARCHAR:
+            case ColumnType::REAL:
+            case ColumnType::BOOL:
+                // El formato y el tamaño máximo se comprueban al codificar el registro
                 break;
             default:
                 std::cerr << "Error de validación: Tipo de columna desconocido para '" << columna.name << "'." << std::endl;
@@ -875,22 +1403,3 @@ bool GestorRegistros::ValidarDatosRegistro(const DatosRegistro& datos_registro,
     }
     return true;
 }
-
-bool GestorRegistros::CalcularOffsetInsercion(Byte* datos_pagina, uint32_t tamaño_registro, 
-                                            uint32_t& offset_insercion) {
-    CabeceraComun* cabecera_comun = reinterpret_cast<CabeceraComun*>(datos_pagina);
-    CabeceraBloqueDatos* cabecera_datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
-
-    // En un esquema simple de registros contiguos, el offset de inserción es
-    // después del último byte usado.
-    uint32_t current_used_space = BLOCK_SIZE - cabecera_datos->espacio_libre_total;
-    offset_insercion = current_used_space;
-
-    if (cabecera_datos->espacio_libre_total >= tamaño_registro) {
-        // Asegurarse de que el offset no sobrepase los límites del bloque
-        if (offset_insercion + tamaño_registro <= BLOCK_SIZE) {
-            return true;
-        }
-    }
-    return false;
-}
@@ -6,8 +6,15 @@
 
 #include "../include/common.h"
 #include "../data_storage/gestor_buffer.h"
+#include "../data_storage/gestor_wal.h"
 #include "../data_storage/cabeceras_especificas.h"
 #include "../Catalog_Manager/gestor_catalogo.h"
+#include "mapa_espacio_libre.h"
+#include "formato_registro.h"
+#include "pagina_ranurada.h"
+#include "pagina_pax.h"
+#include "cursor_registros.h"
+#include "escaneo_paralelo.h"
 #include <vector>
 #include <string>
 #include <memory>
@@ -15,15 +22,19 @@
 #include <unordered_map> // Added for std::unordered_map
 #include <iostream>
 #include <cstring>
+#include <mutex>
 
 // Declaraciones adelantadas para evitar dependencias circulares
 class GestorCatalogo;
 class GestorIndices;
+struct OpcionesConstruccionMasiva;
 struct EsquemaTablaCompleto;
 
 /**
  * Estructura para representar los datos de un registro de forma estructurada
- * Facilita la manipulación antes de serialización/deserialización
+ * Facilita la manipulación antes de serialización/deserialización.
+ * campos_por_nombre solo se rellena con AñadirCampo(); los registros leídos de
+ * disco traen únicamente los campos por posición (para leer sin copiar, VistaRegistro).
  */
 struct DatosRegistro {
     std::vector<std::string> campos;                    // Campos del registro como strings
@@ -87,6 +98,8 @@ struct EstadisticasPagina {
  * - Mantener estadísticas sobre el uso de las páginas y registros.
  * - Integración con el GestorCatalogo para obtener esquemas de tablas.
  * - Integración con el GestorIndices para mantener los índices actualizados.
+ * - Con un GestorWAL, registro de cada cambio de página de datos antes de soltarla
+ *   y confirmación (log duradero) al final de cada operación pública.
  */
 class GestorRegistros {
 public:
@@ -113,6 +126,22 @@ public:
      */
     void SetGestorIndices(GestorIndices* indices) { gestor_indices_ = indices; }
 
+    /**
+     * @brief Establece el WAL en el que se registran los cambios de las páginas de datos.
+     * El WAL debe estar abierto y recuperado (GestorWAL::Recuperar con AplicarRegistroWAL).
+     * @param wal Puntero al GestorWAL; nullptr vuelve a la durabilidad por FlushAllPages.
+     */
+    void SetGestorWAL(GestorWAL* wal) { gestor_wal_ = wal; }
+
+    /**
+     * @brief Rehace un registro del WAL sobre una página de datos (aplicador de la recuperación).
+     * Es idempotente: una inserción cuyo slot ya contiene los mismos bytes no se repite.
+     * @param registro Registro leído del log.
+     * @param datos_pagina Página anclada.
+     * @return INVALID_PAGE_TYPE si la página no es de datos; ERROR si el slot no coincide.
+     */
+    static Status AplicarRegistroWAL(const RegistroWAL& registro, Byte* datos_pagina);
+
     /**
      * @brief Inserta un nuevo registro en la tabla especificada.
      * @param nombre_tabla Nombre de la tabla.
@@ -121,10 +150,34 @@ public:
      */
     Status InsertarRegistro(const std::string& nombre_tabla, const DatosRegistro& datos_registro);
 
+    /**
+     * @brief Inserta un nuevo registro y devuelve su RecordId.
+     * @param nombre_tabla Nombre de la tabla.
+     * @param datos_registro Datos del registro a insertar.
+     * @param id_registro_salida RecordId asignado (página, slot); estable hasta que se elimine.
+     * @return Status de la operación.
+     */
+    Status InsertarRegistro(const std::string& nombre_tabla, const DatosRegistro& datos_registro,
+                            RecordId& id_registro_salida);
+
+    /**
+     * @brief Inserta un lote de registros con una sola actualización del catálogo.
+     * Las páginas se llenan de forma secuencial (la página actual permanece anclada
+     * hasta llenarse), el esquema se resuelve una vez y los índices de la tabla se
+     * actualizan al final, con las claves de cada columna ordenadas.
+     * @param nombre_tabla Nombre de la tabla.
+     * @param lote Registros a insertar.
+     * @param registros_insertados Número de registros insertados (salida).
+     * @param ids_salida Opcional: RecordId de cada registro insertado, en orden.
+     * @return OPERATION_FAILED si algún registro no era válido (los demás se insertan).
+     */
+    Status InsertarRegistrosLote(const std::string& nombre_tabla, const std::vector<DatosRegistro>& lote,
+                                 uint32_t& registros_insertados, std::vector<RecordId>* ids_salida = nullptr);
+
     /**
      * @brief Consulta registros de una tabla por ID.
      * @param nombre_tabla Nombre de la tabla.
-     * @param id_registro ID del registro a consultar.
+     * @param id_registro RecordId devuelto por InsertarRegistro (página, slot).
      * @param datos_registro_salida Datos del registro encontrado (salida).
      * @return Status de la operación.
      */
@@ -132,12 +185,101 @@ public:
 
     /**
      * @brief Consulta todos los registros de una tabla.
+     * Materializa la tabla entera (en paralelo, ver ConsultarEnParalelo); para
+     * tablas grandes usar AbrirCursor().
      * @param nombre_tabla Nombre de la tabla.
      * @param resultados Vector de DatosRegistro donde se almacenarán los resultados (salida).
      * @return Status de la operación.
      */
     Status ConsultarTodosLosRegistros(const std::string& nombre_tabla, std::vector<DatosRegistro>& resultados);
 
+    /**
+     * @brief Abre un cursor sobre los registros de una tabla, una página anclada cada vez.
+     * @param nombre_tabla Nombre de la tabla.
+     * @param cursor Cursor a abrir (salida); si ya estaba abierto se cierra antes.
+     * @param predicado Filtro opcional evaluado sobre cada registro antes de devolverlo.
+     * @return Status de la operación.
+     */
+    Status AbrirCursor(const std::string& nombre_tabla, CursorRegistros& cursor,
+                       PredicadoRegistro predicado = nullptr);
+
+    /**
+     * @brief Abre un cursor que solo visita los registros indicados (p. ej. los
+     *        devueltos por un índice), en orden de página y slot.
+     * @param nombre_tabla Nombre de la tabla.
+     * @param ids RecordId candidatos; los repetidos se visitan una vez y los de slots
+     *        ya liberados se ignoran.
+     * @param cursor Cursor a abrir (salida).
+     * @param filtro Filtro que se vuelve a evaluar sobre cada candidato.
+     * @return Status de la operación.
+     */
+    Status AbrirCursorPorIds(const std::string& nombre_tabla, std::vector<RecordId> ids,
+                             CursorRegistros& cursor, std::shared_ptr<const FiltroCompilado> filtro = nullptr);
+
+    /**
+     * @brief Abre un cursor que filtra cada página entera con un FiltroCompilado
+     *        en lugar de evaluar un predicado registro a registro.
+     * @param nombre_tabla Nombre de la tabla.
+     * @param cursor Cursor a abrir (salida).
+     * @param filtro Filtro compilado contra las columnas de la tabla (ver CompilarFiltro).
+     * @return Status de la operación.
+     */
+    Status AbrirCursorFiltrado(const std::string& nombre_tabla, CursorRegistros& cursor,
+                               std::shared_ptr<const FiltroCompilado> filtro);
+
+    /**
+     * @brief Compila condiciones WHERE contra el esquema actual de la tabla.
+     * @param nombre_tabla Nombre de la tabla.
+     * @param condiciones Condiciones unidas por AND.
+     * @param filtro Filtro compilado (salida).
+     * @return Status de la operación; NOT_FOUND si la tabla o una columna no existe.
+     */
+    Status CompilarFiltro(const std::string& nombre_tabla, const std::vector<CondicionFiltro>& condiciones,
+                          std::shared_ptr<const FiltroCompilado>& filtro);
+
+    /**
+     * @brief Calcula agregados sobre los registros que cumplen el filtro repartiendo
+     *        las páginas de la tabla entre los hilos de recorrido (ver EscaneoParalelo).
+     * @param nombre_tabla Nombre de la tabla.
+     * @param filtro Filtro compilado; nullptr = todos los registros.
+     * @param especificaciones Agregados pedidos.
+     * @param agregados Un resultado por especificación, en el mismo orden (salida).
+     * @param estadisticas Opcional: trabajadores, morsels robados y registros examinados (salida).
+     * @param opciones Hilos y páginas por morsel.
+     * @return Status de la operación; NOT_FOUND si la tabla o una columna no existe.
+     */
+    Status AgregarEnParalelo(const std::string& nombre_tabla, std::shared_ptr<const FiltroCompilado> filtro,
+                             const std::vector<EspecificacionAgregado>& especificaciones,
+                             std::vector<AgregadoParcial>& agregados,
+                             EstadisticasEscaneoParalelo* estadisticas = nullptr,
+                             const OpcionesEscaneoParalelo& opciones = OpcionesEscaneoParalelo());
+
+    /**
+     * @brief Deserializa en paralelo los registros que cumplen el filtro.
+     * Cada morsel se materializa por separado y se concatenan en orden, así que el
+     * resultado sale en el mismo orden que con un cursor.
+     * @param nombre_tabla Nombre de la tabla.
+     * @param filtro Filtro compilado; nullptr = todos los registros.
+     * @param resultados Registros seleccionados (salida).
+     * @param ids Opcional: RecordId de cada registro (salida).
+     * @param opciones Hilos y páginas por morsel.
+     * @return Status de la operación.
+     */
+    Status ConsultarEnParalelo(const std::string& nombre_tabla, std::shared_ptr<const FiltroCompilado> filtro,
+                               std::vector<DatosRegistro>& resultados, std::vector<RecordId>* ids = nullptr,
+                               const OpcionesEscaneoParalelo& opciones = OpcionesEscaneoParalelo());
+
+    /**
+     * @brief Crea los índices de varias columnas recorriendo la tabla una sola vez
+     *        (ver GestorIndices::ConstruirIndicesMasivos).
+     * @param nombre_tabla Nombre de la tabla.
+     * @param columnas Columnas a indexar.
+     * @param opciones Factor de llenado, memoria de ordenación e hilos.
+     * @return Status de la operación; NOT_FOUND si alguna columna no existe.
+     */
+    Status ConstruirIndicesTabla(const std::string& nombre_tabla, const std::vector<std::string>& columnas,
+                                 const OpcionesConstruccionMasiva& opciones);
+
     /**
      * @brief Actualiza un registro existente en la tabla.
      * @param nombre_tabla Nombre de la tabla.
@@ -162,6 +304,14 @@ public:
      */
     Status CompactarPagina(PageId id_pagina);
 
+    /**
+     * @brief Recalcula el número de registros de cada tabla desde las cabeceras de
+     *        sus páginas. El catálogo escribe los contadores de forma perezosa, así
+     *        que tras una recuperación del WAL pueden estar atrasados.
+     * @return Status de la operación; una página que no se puede anclar deja su tabla como estaba
+     */
+    Status RecontarRegistros();
+
     /**
      * @brief Imprime las estadísticas de uso de las páginas de una tabla.
      * @param nombre_tabla Nombre de la tabla.
@@ -177,6 +327,7 @@ private:
     GestorBuffer* gestor_buffer_;             // Puntero al gestor de buffer
     GestorCatalogo* gestor_catalogo_;         // Puntero al gestor de catálogo
     GestorIndices* gestor_indices_;           // Puntero al gestor de índices
+    GestorWAL* gestor_wal_;                   // Registro de escritura anticipada (opcional)
 
     // Estadísticas generales
     uint64_t total_inserciones_;
@@ -188,36 +339,134 @@ private:
     // Mapa para almacenar estadísticas por página
     std::unordered_map<PageId, EstadisticasPagina> estadisticas_paginas_;
 
+    // Mapas de espacio libre cargados, por ID de tabla
+    std::unordered_map<uint32_t, std::unique_ptr<MapaEspacioLibre>> mapas_espacio_libre_;
+
+    // Disposiciones binarias de registro calculadas, por ID de tabla
+    std::unordered_map<uint32_t, std::unique_ptr<DisposicionRegistro>> disposiciones_;
+
+    // Hilos de los recorridos paralelos; se crean con el primer recorrido
+    std::unique_ptr<PoolHilos> pool_escaneo_;
+    std::once_flag inicializacion_pool_escaneo_;
+
+    // Extensiones de las tablas: la primera de 8 páginas y cada una del tamaño
+    // de la tabla, hasta 256 páginas
+    static constexpr uint32_t PAGINAS_EXTENSION_INICIAL = 8;
+    static constexpr uint32_t PAGINAS_EXTENSION_MAXIMA = 256;
+
     // === MÉTODOS AUXILIARES PRIVADOS ===
 
     /**
-     * @brief Serializa un registro a un vector de bytes.
-     * @param datos_registro Datos del registro.
-     * @param esquema Esquema de la tabla.
-     * @return Vector de bytes serializado.
+     * @brief Crea y ancla una página de datos para la tabla: la siguiente reservada de
+     *        su última extensión o la primera de una extensión nueva. El llamador la
+     *        inicializa y la añade con AñadirPaginaDatos().
+     */
+    Status CrearPaginaDatos(MetadataTabla& metadata_tabla, PageId& id_pagina, Byte*& datos_pagina);
+
+    /**
+     * @brief Inicializa una página recién creada en el formato de la tabla y lo
+     *        registra en el WAL (INICIALIZAR_PAGINA o, en PAX, IMAGEN_PAGINA).
+     */
+    void InicializarPaginaDatos(const MetadataTabla& metadata_tabla, const DisposicionRegistro& disposicion,
+                                PageId id_pagina, Byte* datos_pagina);
+
+    /**
+     * @brief Inserta un registro serializado en una página de datos anclada, en el
+     *        formato de la tabla, y lo registra en el WAL.
+     * @return OUT_OF_SPACE_FOR_UPDATE si no cabe (la página no cambia)
+     */
+    Status InsertarEnPagina(const MetadataTabla& metadata_tabla, const DisposicionRegistro& disposicion,
+                            PageId id_pagina, Byte* datos_pagina, const std::vector<Byte>& registro, uint32_t& slot);
+
+    /**
+     * @brief Registra en el WAL un cambio ya aplicado a una página anclada y copia
+     *        el LSN del registro a su cabecera. Sin WAL no hace nada.
      */
-    std::vector<Byte> SerializarRegistro(const DatosRegistro& datos_registro, 
-                                         const EsquemaTablaCompleto& esquema) const;
+    void RegistrarCambioPagina(PageId id_pagina, Byte* datos_pagina, TipoRegistroWAL tipo,
+                               uint32_t slot = 0, const Byte* datos = nullptr, uint32_t longitud = 0);
 
     /**
-     * @brief Deserializa un registro desde un vector de bytes.
-     * @param datos_raw Vector de bytes del registro.
+     * @brief Decodifica el registro de un slot de una página de datos ya anclada.
+     * @return false si el slot está libre o el registro no es válido
+     */
+    bool LeerRegistroAnclado(const MetadataTabla& metadata_tabla, const DisposicionRegistro& disposicion,
+                             Byte* datos_pagina, RecordId id_registro, DatosRegistro& datos_salida) const;
+
+    /**
+     * @brief Columnas de la tabla con índice, como (posición, nombre).
+     */
+    std::vector<std::pair<uint32_t, std::string>> ObtenerColumnasIndexadas(const std::string& nombre_tabla,
+                                                                           const MetadataTabla& metadata_tabla) const;
+
+    /**
+     * @brief Lleva a los índices de la tabla el cambio de un registro: retira las claves
+     *        de anterior e inserta las de nuevo (cualquiera de los dos puede ser nullptr).
+     *        Las columnas cuya clave no cambia no se tocan.
+     */
+    void MantenerIndices(const std::string& nombre_tabla, const MetadataTabla& metadata_tabla,
+                         const DisposicionRegistro& disposicion, const DatosRegistro* anterior,
+                         const DatosRegistro* nuevo, RecordId id_registro);
+
+    /**
+     * @brief Punto de confirmación de una operación: espera a que su log sea duradero
+     *        y hace un punto de control si el log ha crecido lo suficiente.
+     */
+    Status ConfirmarCambios();
+
+    /**
+     * @brief Devuelve el pool de los recorridos paralelos (un hilo por núcleo).
+     */
+    PoolHilos& ObtenerPoolEscaneo();
+
+    /**
+     * @brief Construye el esquema completo de una tabla a partir de su metadata del catálogo.
+     */
+    EsquemaTablaCompleto ConstruirEsquema(const MetadataTabla& metadata_tabla) const;
+
+    /**
+     * @brief Devuelve la disposición binaria de registro de la tabla, calculándola
+     *        si no existe o si el esquema ha cambiado.
      * @param esquema Esquema de la tabla.
+     * @return Puntero a la disposición, o nullptr si el esquema no es válido.
+     */
+    const DisposicionRegistro* ObtenerDisposicion(const EsquemaTablaCompleto& esquema);
+
+    /**
+     * @brief Resuelve la metadata y la disposición que necesita un cursor.
+     * @return NOT_FOUND si la tabla no existe; INVALID_ARGUMENT si su esquema no es válido.
+     */
+    Status PrepararCursor(const std::string& nombre_tabla, std::shared_ptr<MetadataTabla>& metadata_tabla,
+                          const DisposicionRegistro*& disposicion);
+
+    /**
+     * @brief Serializa un registro al formato binario de la tabla.
+     * @param datos_registro Datos del registro.
+     * @param disposicion Disposición binaria de la tabla.
+     * @param datos_raw [out] Registro serializado.
+     * @return Status::INVALID_ARGUMENT si algún campo no corresponde a su tipo.
+     */
+    Status SerializarRegistro(const DatosRegistro& datos_registro, 
+                              const DisposicionRegistro& disposicion,
+                              std::vector<Byte>& datos_raw) const;
+
+    /**
+     * @brief Convierte un registro binario en DatosRegistro (copia los campos como texto).
+     * Los recorridos que solo filtran deberían leer de la VistaRegistro sin llamar a este método.
+     * @param vista Vista del registro dentro de la página anclada.
      * @return DatosRegistro deserializado.
      */
-    DatosRegistro DeserializarRegistro(const std::vector<Byte>& datos_raw, 
-                                       const EsquemaTablaCompleto& esquema) const;
+    DatosRegistro DeserializarRegistro(const VistaRegistro& vista) const;
 
     /**
-     * @brief Busca un slot libre en una página de datos.
-     * @param datos_pagina Puntero a los datos de la página.
-     * @param cabecera_datos Cabecera del bloque de datos.
-     * @param id_slot_libre ID del slot libre encontrado (salida).
-     * @return true si se encontró un slot libre.
+     * @brief Comprueba que la página del RecordId pertenece a la tabla y la ancla.
+     * @param metadata_tabla Metadata de la tabla
+     * @param id_registro RecordId (página, slot)
+     * @param datos_pagina [out] Datos de la página anclada; el llamador la desancla
+     * @return Status::NOT_FOUND si la página no es de la tabla, INVALID_PAGE_TYPE si no es de datos
      */
-    bool BuscarSlotLibre(Byte* datos_pagina, const CabeceraBloqueDatos& cabecera_datos, 
-                        uint32_t& id_slot_libre);
-    
+    Status AnclarPaginaRegistro(const std::shared_ptr<MetadataTabla>& metadata_tabla,
+                                RecordId id_registro, Byte*& datos_pagina);
+
     /**
      * Actualiza las estadísticas de una página después de una operación
      * @param id_pagina ID de la página
@@ -235,15 +484,21 @@ private:
                              const EsquemaTablaCompleto& esquema) const;
     
     /**
-     * Calcula el offset donde debe insertarse un nuevo registro
-     * @param datos_pagina Puntero a los datos de la página
-     * @param tamaño_registro Tamaño del registro a insertar
-     * @param offset_insercion Offset calculado (salida)
-     * @return true si hay espacio suficiente
+     * Devuelve el mapa de espacio libre de la tabla, cargándolo si hace falta.
+     * Si la tabla aún no tiene mapa lo crea a partir de sus páginas (una sola vez)
+     * y guarda su primera página en la metadata de la tabla.
+     * @param metadata_tabla Metadata de la tabla
+     * @return Puntero al mapa, o nullptr si no se pudo crear ni cargar
      */
-    bool CalcularOffsetInsercion(Byte* datos_pagina, uint32_t tamaño_registro, 
-                                uint32_t& offset_insercion);
-    
+    MapaEspacioLibre* ObtenerMapaEspacioLibre(const std::shared_ptr<MetadataTabla>& metadata_tabla);
+
+    /**
+     * Notifica el espacio libre actual de una página al mapa de la tabla que la contiene
+     * @param id_pagina ID de la página
+     * @param espacio_libre Bytes libres de la página
+     */
+    void NotificarEspacioLibre(PageId id_pagina, uint32_t espacio_libre);
+
     /**
      * Obtiene el timestamp actual en milisegundos desde epoch
      * @return Timestamp actual
@@ -0,0 +1,226 @@
+// record_manager/mapa_espacio_libre.cpp - Implementación del mapa de espacio libre
+#include "mapa_espacio_libre.h"
+#include <iostream>  // Para std::cout, std::cerr
+#include <sstream>   // Para std::ostringstream
+#include <cstring>   // Para std::memset
+
+// ===== CONSTRUCTOR E INICIALIZACIÓN =====
+
+MapaEspacioLibre::MapaEspacioLibre(GestorBuffer& gestor_buffer, BlockId id_primera_pagina)
+    : gestor_buffer_(&gestor_buffer)
+    , id_primera_pagina_(id_primera_pagina)
+    , mascara_cubetas_(0) {
+}
+
+Status MapaEspacioLibre::Inicializar() {
+    if (id_primera_pagina_ == INVALID_PAGE_ID) {
+        return AñadirPaginaMapa();
+    }
+    return CargarDesdeDisco();
+}
+
+uint8_t MapaEspacioLibre::CalcularCategoria(uint32_t espacio_libre) {
+    uint32_t categoria = espacio_libre / TAMAÑO_CATEGORIA;
+    return static_cast<uint8_t>(std::min(categoria, NUM_CATEGORIAS - 1));
+}
+
+// ===== OPERACIONES PÚBLICAS =====
+
+Status MapaEspacioLibre::RegistrarPagina(PageId id_pagina, uint32_t espacio_libre) {
+    if (Contiene(id_pagina)) {
+        return Status::ALREADY_EXISTS;
+    }
+    uint32_t posicion = static_cast<uint32_t>(paginas_.size());
+    if (posicion / ENTRADAS_POR_PAGINA >= paginas_mapa_.size()) {
+        Status estado = AñadirPaginaMapa();
+        if (estado != Status::OK) {
+            return estado;
+        }
+    }
+
+    uint8_t categoria = CalcularCategoria(espacio_libre);
+    paginas_.push_back(id_pagina);
+    categorias_.push_back(categoria);
+    espacios_conocidos_.push_back(static_cast<uint16_t>(std::min<uint32_t>(espacio_libre, BLOCK_SIZE)));
+    indice_en_cubeta_.push_back(0);
+    posicion_por_pagina_[id_pagina] = posicion;
+    InsertarEnCubeta(posicion, categoria);
+    return EscribirEntrada(posicion);
+}
+
+Status MapaEspacioLibre::Actualizar(PageId id_pagina, uint32_t espacio_libre) {
+    auto it = posicion_por_pagina_.find(id_pagina);
+    if (it == posicion_por_pagina_.end()) {
+        return Status::NOT_FOUND;
+    }
+    uint32_t posicion = it->second;
+    uint8_t categoria = CalcularCategoria(espacio_libre);
+    espacios_conocidos_[posicion] = static_cast<uint16_t>(std::min<uint32_t>(espacio_libre, BLOCK_SIZE));
+    if (categorias_[posicion] == categoria) {
+        return Status::OK;
+    }
+    QuitarDeCubeta(posicion);
+    categorias_[posicion] = categoria;
+    InsertarEnCubeta(posicion, categoria);
+    return EscribirEntrada(posicion);
+}
+
+PageId MapaEspacioLibre::BuscarPaginaConEspacio(uint32_t tamaño_necesario) const {
+    uint32_t categoria_minima = (tamaño_necesario + TAMAÑO_CATEGORIA - 1) / TAMAÑO_CATEGORIA;
+    if (categoria_minima >= NUM_CATEGORIAS) {
+        // Solo la última categoría puede servir, pero no garantiza el tamaño: buscar
+        // un ajuste exacto. Cuando quien inserta corrige una candidata que no cabía,
+        // su espacio conocido baja de tamaño_necesario y no se vuelve a proponer.
+        for (uint32_t posicion : cubetas_[NUM_CATEGORIAS - 1]) {
+            if (espacios_conocidos_[posicion] >= tamaño_necesario) {
+                return paginas_[posicion];
+            }
+        }
+        return INVALID_PAGE_ID;
+    }
+    if (categoria_minima == 0) {
+        categoria_minima = 1; // La categoría 0 no garantiza ningún byte
+    }
+    uint32_t candidatas = mascara_cubetas_ & ~((1u << categoria_minima) - 1);
+    if (candidatas == 0) {
+        return INVALID_PAGE_ID;
+    }
+    uint32_t categoria = static_cast<uint32_t>(__builtin_ctz(candidatas));
+    return paginas_[cubetas_[categoria].back()];
+}
+
+std::string MapaEspacioLibre::ObtenerEstadisticas() const {
+    std::ostringstream ss;
+    ss << "Mapa de espacio libre: " << paginas_.size() << " páginas de datos en "
+       << paginas_mapa_.size() << " páginas de mapa\n";
+    for (uint32_t c = 0; c < NUM_CATEGORIAS; ++c) {
+        if (cubetas_[c].empty()) continue;
+        ss << "  >= " << (c * TAMAÑO_CATEGORIA) << " bytes libres: " << cubetas_[c].size() << " páginas\n";
+    }
+    return ss.str();
+}
+
+// ===== PERSISTENCIA =====
+
+Status MapaEspacioLibre::CargarDesdeDisco() {
+    paginas_mapa_.clear();
+    paginas_.clear();
+    categorias_.clear();
+    espacios_conocidos_.clear();
+    indice_en_cubeta_.clear();
+    posicion_por_pagina_.clear();
+    for (auto& cubeta : cubetas_) cubeta.clear();
+    mascara_cubetas_ = 0;
+
+    BlockId actual = id_primera_pagina_;
+    while (actual != INVALID_PAGE_ID) {
+        Byte* datos = nullptr;
+        Status estado = gestor_buffer_->PinPage(actual, datos);
+        if (estado != Status::OK) {
+            std::cerr << "Error: No se pudo leer la página " << actual << " del mapa de espacio libre." << std::endl;
+            return estado;
+        }
+        const auto* cabecera = reinterpret_cast<const CabeceraPaginaMapa*>(datos);
+        if (cabecera->magic_number != MAGIC_MAPA_ESPACIO || cabecera->tipo_pagina != PageType::FREE_SPACE_MAP ||
+            cabecera->numero_entradas > ENTRADAS_POR_PAGINA) {
+            std::cerr << "Error: La página " << actual << " no es una página válida del mapa de espacio libre." << std::endl;
+            gestor_buffer_->UnpinPage(actual, false);
+            return Status::INVALID_PAGE_TYPE;
+        }
+        paginas_mapa_.push_back(actual);
+
+        const auto* entradas = reinterpret_cast<const EntradaMapa*>(datos + sizeof(CabeceraPaginaMapa));
+        for (uint32_t i = 0; i < cabecera->numero_entradas; ++i) {
+            uint32_t posicion = static_cast<uint32_t>(paginas_.size());
+            uint8_t categoria = std::min<uint8_t>(entradas[i].categoria, NUM_CATEGORIAS - 1);
+            paginas_.push_back(entradas[i].id_pagina);
+            categorias_.push_back(categoria);
+            // En disco solo está la categoría: la última cubeta se toma como llena hasta
+            // el final del bloque y quien inserta corrige la cifra si no cabe
+            espacios_conocidos_.push_back(static_cast<uint16_t>(
+                categoria == NUM_CATEGORIAS - 1 ? BLOCK_SIZE : categoria * TAMAÑO_CATEGORIA));
+            indice_en_cubeta_.push_back(0);
+            posicion_por_pagina_[entradas[i].id_pagina] = posicion;
+            InsertarEnCubeta(posicion, categoria);
+        }
+        BlockId siguiente = cabecera->siguiente_pagina;
+        gestor_buffer_->UnpinPage(actual, false);
+        actual = siguiente;
+    }
+    return Status::OK;
+}
+
+Status MapaEspacioLibre::AñadirPaginaMapa() {
+    BlockId id_nueva = INVALID_PAGE_ID;
+    Byte* datos = nullptr;
+    Status estado = gestor_buffer_->NewPage(id_nueva, datos);
+    if (estado != Status::OK) {
+        std::cerr << "Error: No se pudo crear una página para el mapa de espacio libre." << std::endl;
+        return estado;
+    }
+    auto* cabecera = reinterpret_cast<CabeceraPaginaMapa*>(datos);
+    cabecera->magic_number = MAGIC_MAPA_ESPACIO;
+    cabecera->tipo_pagina = PageType::FREE_SPACE_MAP;
+    cabecera->numero_entradas = 0;
+    cabecera->siguiente_pagina = INVALID_PAGE_ID;
+    gestor_buffer_->UnpinPage(id_nueva, true);
+
+    if (paginas_mapa_.empty()) {
+        id_primera_pagina_ = id_nueva;
+    } else {
+        // Enlazar desde la última página del encadenamiento
+        BlockId anterior = paginas_mapa_.back();
+        estado = gestor_buffer_->PinPage(anterior, datos);
+        if (estado != Status::OK) {
+            return estado;
+        }
+        reinterpret_cast<CabeceraPaginaMapa*>(datos)->siguiente_pagina = id_nueva;
+        gestor_buffer_->UnpinPage(anterior, true);
+    }
+    paginas_mapa_.push_back(id_nueva);
+    return Status::OK;
+}
+
+Status MapaEspacioLibre::EscribirEntrada(uint32_t posicion) {
+    BlockId id_pagina_mapa = paginas_mapa_[posicion / ENTRADAS_POR_PAGINA];
+    uint32_t indice = posicion % ENTRADAS_POR_PAGINA;
+
+    Byte* datos = nullptr;
+    Status estado = gestor_buffer_->PinPage(id_pagina_mapa, datos);
+    if (estado != Status::OK) {
+        std::cerr << "Error: No se pudo actualizar la página " << id_pagina_mapa << " del mapa de espacio libre." << std::endl;
+        return estado;
+    }
+    auto* cabecera = reinterpret_cast<CabeceraPaginaMapa*>(datos);
+    auto* entradas = reinterpret_cast<EntradaMapa*>(datos + sizeof(CabeceraPaginaMapa));
+    std::memset(&entradas[indice], 0, sizeof(EntradaMapa));
+    entradas[indice].id_pagina = paginas_[posicion];
+    entradas[indice].categoria = categorias_[posicion];
+    if (cabecera->numero_entradas <= indice) {
+        cabecera->numero_entradas = indice + 1;
+    }
+    return gestor_buffer_->UnpinPage(id_pagina_mapa, true);
+}
+
+// ===== CUBETAS EN MEMORIA =====
+
+void MapaEspacioLibre::InsertarEnCubeta(uint32_t posicion, uint8_t categoria) {
+    auto& cubeta = cubetas_[categoria];
+    indice_en_cubeta_[posicion] = static_cast<uint32_t>(cubeta.size());
+    cubeta.push_back(posicion);
+    mascara_cubetas_ |= (1u << categoria);
+}
+
+void MapaEspacioLibre::QuitarDeCubeta(uint32_t posicion) {
+    uint8_t categoria = categorias_[posicion];
+    auto& cubeta = cubetas_[categoria];
+    // Intercambiar con el último para borrar en O(1)
+    uint32_t indice = indice_en_cubeta_[posicion];
+    uint32_t ultima = cubeta.back();
+    cubeta[indice] = ultima;
+    indice_en_cubeta_[ultima] = indice;
+    cubeta.pop_back();
+    if (cubeta.empty()) {
+        mascara_cubetas_ &= ~(1u << categoria);
+    }
+}
@@ -0,0 +1,136 @@
+// record_manager/mapa_espacio_libre.h - Mapa persistente de espacio libre por tabla
+// Permite elegir la página destino de una inserción sin recorrer la tabla
+
+#ifndef MAPA_ESPACIO_LIBRE_H
+#define MAPA_ESPACIO_LIBRE_H
+
+#include "../include/common.h"
+#include "../data_storage/gestor_buffer.h"
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <string>
+
+/**
+ * @brief Mapa de espacio libre (FSM) de una tabla.
+ *
+ * Cada página de datos de la tabla tiene una entrada con su CATEGORÍA de espacio
+ * libre: categoria = espacio_libre / TAMAÑO_CATEGORIA, acotada a NUM_CATEGORIAS - 1.
+ * Una página de categoría c tiene al menos c * TAMAÑO_CATEGORIA bytes libres, así
+ * que basta con buscar en las categorías >= ceil(tamaño / TAMAÑO_CATEGORIA).
+ *
+ * EN MEMORIA:
+ * - Una cubeta por categoría con las posiciones de sus páginas y una máscara de
+ *   cubetas no vacías: BuscarPaginaConEspacio es O(NUM_CATEGORIAS), sin anclar páginas.
+ *
+ * EN DISCO:
+ * - Páginas propias de tipo PageType::FREE_SPACE_MAP, encadenadas desde la primera
+ *   (cuyo BlockId guarda la metadata de la tabla). La entrada i vive en la página
+ *   i / ENTRADAS_POR_PAGINA del encadenamiento.
+ * - Cada cambio de categoría se escribe en su página del mapa a través del
+ *   GestorBuffer, que se encarga de llevarla a disco.
+ *
+ * El mapa es una pista: quien inserta comprueba el espacio real de la página y,
+ * si no coincide, corrige la entrada con Actualizar() y vuelve a buscar.
+ */
+class MapaEspacioLibre {
+public:
+    static constexpr uint32_t NUM_CATEGORIAS = 16;
+    static constexpr uint32_t TAMAÑO_CATEGORIA = BLOCK_SIZE / NUM_CATEGORIAS;
+    static constexpr uint32_t MAGIC_MAPA_ESPACIO = 0x504D5346; // "FSMP" en ASCII
+
+    /**
+     * @brief Cabecera de una página del mapa.
+     */
+    struct CabeceraPaginaMapa {
+        uint32_t magic_number;
+        PageType tipo_pagina;
+        uint32_t numero_entradas;
+        BlockId siguiente_pagina;   // INVALID_PAGE_ID al final del encadenamiento
+    };
+
+    /**
+     * @brief Entrada del mapa: una página de datos y su categoría.
+     */
+    struct EntradaMapa {
+        PageId id_pagina;
+        uint8_t categoria;
+        uint8_t relleno[3];
+    };
+
+    static constexpr uint32_t ENTRADAS_POR_PAGINA =
+        (BLOCK_SIZE - sizeof(CabeceraPaginaMapa)) / sizeof(EntradaMapa);
+
+    /**
+     * @brief Constructor. No hace E/S: el mapa se crea o carga con Inicializar().
+     * @param gestor_buffer GestorBuffer a través del que se leen y escriben las páginas del mapa
+     * @param id_primera_pagina Primera página del mapa, o INVALID_PAGE_ID para crear uno nuevo
+     */
+    MapaEspacioLibre(GestorBuffer& gestor_buffer, BlockId id_primera_pagina = INVALID_PAGE_ID);
+
+    /**
+     * @brief Crea la primera página del mapa o carga el encadenamiento existente.
+     * @return Status de la operación
+     */
+    Status Inicializar();
+
+    /**
+     * @brief Añade una página de datos nueva al mapa.
+     * @param id_pagina Página de datos
+     * @param espacio_libre Bytes libres de la página
+     * @return Status::ALREADY_EXISTS si la página ya estaba registrada
+     */
+    Status RegistrarPagina(PageId id_pagina, uint32_t espacio_libre);
+
+    /**
+     * @brief Actualiza el espacio libre de una página tras insertar, eliminar o compactar.
+     * Solo escribe en disco si cambia la categoría.
+     * @param id_pagina Página de datos
+     * @param espacio_libre Bytes libres actuales de la página
+     * @return Status::NOT_FOUND si la página no está en el mapa
+     */
+    Status Actualizar(PageId id_pagina, uint32_t espacio_libre);
+
+    /**
+     * @brief Busca una página cuya categoría garantice al menos tamaño_necesario bytes.
+     * Prefiere la categoría más baja que sirva, para no fragmentar páginas vacías.
+     * Por encima de (NUM_CATEGORIAS - 1) * TAMAÑO_CATEGORIA la última categoría ya no
+     * garantiza nada: solo se devuelve una página cuyo último espacio conocido baste.
+     * @param tamaño_necesario Bytes que necesita la inserción
+     * @return PageId candidata, o INVALID_PAGE_ID si ninguna sirve
+     */
+    PageId BuscarPaginaConEspacio(uint32_t tamaño_necesario) const;
+
+    bool Contiene(PageId id_pagina) const { return posicion_por_pagina_.count(id_pagina) > 0; }
+    BlockId ObtenerIdPrimeraPagina() const { return id_primera_pagina_; }
+    uint32_t ObtenerNumeroPaginas() const { return static_cast<uint32_t>(paginas_.size()); }
+
+    /**
+     * @brief Resumen de la ocupación por categorías.
+     */
+    std::string ObtenerEstadisticas() const;
+
+    static uint8_t CalcularCategoria(uint32_t espacio_libre);
+
+private:
+    GestorBuffer* gestor_buffer_;
+    BlockId id_primera_pagina_;
+    std::vector<BlockId> paginas_mapa_;                  // Encadenamiento de páginas del mapa
+
+    std::vector<PageId> paginas_;                        // Página de datos de cada posición
+    std::vector<uint8_t> categorias_;                    // Categoría de cada posición
+    std::vector<uint16_t> espacios_conocidos_;           // Último espacio libre exacto (solo en memoria)
+    std::vector<uint32_t> indice_en_cubeta_;             // Posición dentro de su cubeta
+    std::unordered_map<PageId, uint32_t> posicion_por_pagina_;
+    std::array<std::vector<uint32_t>, NUM_CATEGORIAS> cubetas_;
+    uint32_t mascara_cubetas_;                           // Bit c = cubeta c no vacía
+
+    Status CargarDesdeDisco();
+    Status AñadirPaginaMapa();
+    Status EscribirEntrada(uint32_t posicion);
+
+    void InsertarEnCubeta(uint32_t posicion, uint8_t categoria);
+    void QuitarDeCubeta(uint32_t posicion);
+};
+
+#endif // MAPA_ESPACIO_LIBRE_H
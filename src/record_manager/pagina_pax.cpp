@@ -0,0 +1,978 @@
+// record_manager/pagina_pax.cpp - Implementación de las páginas PAX y de su codificación
+#include "pagina_pax.h"
+#include "pagina_ranurada.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+uint32_t BytesMapa(uint64_t bits) {
+    return static_cast<uint32_t>((bits + 7) / 8);
+}
+
+uint8_t BitsNecesarios(uint64_t valor) {
+    uint8_t bits = 0;
+    while (valor != 0) {
+        bits++;
+        valor >>= 1;
+    }
+    return bits;
+}
+
+bool LeerBit(const uint8_t* mapa, uint32_t indice) {
+    return (mapa[indice / 8] >> (indice % 8)) & 1u;
+}
+
+void PonerBit(uint8_t* mapa, uint32_t indice) {
+    mapa[indice / 8] |= static_cast<uint8_t>(1u << (indice % 8));
+}
+
+// Valores de ancho bits empaquetados uno tras otro desde el bit menos significativo;
+// el destino debe estar a cero
+void EscribirBits(uint8_t* destino, uint32_t indice, uint8_t ancho, uint64_t valor) {
+    uint64_t bit = static_cast<uint64_t>(indice) * ancho;
+    uint32_t escritos = 0;
+    while (escritos < ancho) {
+        uint32_t desplazamiento = static_cast<uint32_t>(bit & 7);
+        uint32_t trozo = std::min<uint32_t>(8 - desplazamiento, ancho - escritos);
+        uint8_t bits = static_cast<uint8_t>((valor >> escritos) & ((1u << trozo) - 1));
+        destino[bit >> 3] |= static_cast<uint8_t>(bits << desplazamiento);
+        escritos += trozo;
+        bit += trozo;
+    }
+}
+
+uint64_t LeerBits(const uint8_t* origen, uint32_t indice, uint8_t ancho) {
+    uint64_t bit = static_cast<uint64_t>(indice) * ancho;
+    uint64_t valor = 0;
+    uint32_t leidos = 0;
+    while (leidos < ancho) {
+        uint32_t desplazamiento = static_cast<uint32_t>(bit & 7);
+        uint32_t trozo = std::min<uint32_t>(8 - desplazamiento, ancho - leidos);
+        uint64_t bits = (origen[bit >> 3] >> desplazamiento) & ((1u << trozo) - 1);
+        valor |= bits << leidos;
+        leidos += trozo;
+        bit += trozo;
+    }
+    return valor;
+}
+
+uint16_t LeerU16(const uint8_t* origen, uint32_t indice) {
+    uint16_t valor;
+    std::memcpy(&valor, origen + indice * sizeof(uint16_t), sizeof(valor));
+    return valor;
+}
+
+void EscribirU16(uint8_t* destino, uint32_t indice, uint32_t valor) {
+    uint16_t u16 = static_cast<uint16_t>(valor);
+    std::memcpy(destino + indice * sizeof(uint16_t), &u16, sizeof(u16));
+}
+
+bool EsTexto(ColumnType tipo) {
+    return tipo == ColumnType::CHAR || tipo == ColumnType::VARCHAR;
+}
+
+// Los filtros comparan los CHAR sin los espacios de relleno: el rango se calcula igual
+std::string_view ValorDeRango(ColumnType tipo, std::string_view texto) {
+    if (tipo != ColumnType::CHAR) {
+        return texto;
+    }
+    size_t fin = texto.find_last_not_of(' ');
+    return (fin == std::string_view::npos) ? std::string_view() : texto.substr(0, fin + 1);
+}
+
+const DescriptorMinipagina* Descriptores(const Byte* datos_pagina) {
+    return reinterpret_cast<const DescriptorMinipagina*>(datos_pagina + PaginaPAX::INICIO_PAX + sizeof(CabeceraPaginaPAX));
+}
+
+/**
+ * @brief Acceso por slot a una minipágina ya escrita, sin decodificar las demás.
+ */
+class LectorMinipagina {
+public:
+    bool Preparar(const Byte* datos_pagina, const DescriptorMinipagina& descriptor, ColumnType tipo, uint32_t slots) {
+        tipo_ = tipo;
+        codificacion_ = static_cast<CodificacionMinipagina>(descriptor.codificacion);
+        ancho_ = descriptor.ancho_bits;
+        con_valores_ = (descriptor.banderas & MINIPAGINA_CON_VALORES) != 0;
+        nulos_ = nullptr;
+        if (!con_valores_) {
+            return true; // Todo nulo: la minipágina no tiene bytes
+        }
+        if (static_cast<uint32_t>(descriptor.offset) + descriptor.longitud > BLOCK_SIZE || ancho_ > 64) {
+            return false;
+        }
+        const uint8_t* inicio = reinterpret_cast<const uint8_t*>(datos_pagina) + descriptor.offset;
+        const uint8_t* fin = inicio + descriptor.longitud;
+        const uint8_t* cursor = inicio;
+        if (descriptor.banderas & MINIPAGINA_CON_NULOS) {
+            nulos_ = cursor;
+            cursor += BytesMapa(slots);
+        }
+        valores_ = cursor;
+        std::memcpy(&referencia_, descriptor.minimo, sizeof(referencia_));
+
+        uint64_t necesarios = 0;
+        switch (tipo_) {
+            case ColumnType::INT:
+                necesarios = (codificacion_ == CodificacionMinipagina::REFERENCIA_BITS)
+                                 ? BytesMapa(static_cast<uint64_t>(slots) * ancho_) : uint64_t(slots) * sizeof(int64_t);
+                break;
+            case ColumnType::REAL:
+                necesarios = uint64_t(slots) * sizeof(double);
+                break;
+            case ColumnType::BOOL:
+                necesarios = BytesMapa(slots);
+                break;
+            case ColumnType::CHAR:
+            case ColumnType::VARCHAR: {
+                uint32_t fines = slots;
+                if (codificacion_ == CodificacionMinipagina::DICCIONARIO) {
+                    if (fin - cursor < static_cast<ptrdiff_t>(sizeof(uint16_t))) return false;
+                    entradas_ = LeerU16(cursor, 0);
+                    cursor += sizeof(uint16_t);
+                    fines = entradas_;
+                }
+                fines_ = cursor;
+                bytes_ = cursor + uint64_t(fines) * sizeof(uint16_t);
+                if (bytes_ > fin) return false;
+                longitud_bytes_ = (fines == 0) ? 0 : LeerU16(fines_, fines - 1);
+                codigos_ = bytes_ + longitud_bytes_;
+                necesarios = uint64_t(codigos_ - valores_);
+                if (codificacion_ == CodificacionMinipagina::DICCIONARIO) {
+                    necesarios += BytesMapa(static_cast<uint64_t>(slots) * ancho_);
+                }
+                break;
+            }
+        }
+        return static_cast<uint64_t>(fin - valores_) >= necesarios;
+    }
+
+    bool EsNulo(uint32_t slot) const {
+        return !con_valores_ || (nulos_ != nullptr && LeerBit(nulos_, slot));
+    }
+
+    int64_t Entero(uint32_t slot) const {
+        if (tipo_ == ColumnType::BOOL) {
+            return LeerBit(valores_, slot) ? 1 : 0;
+        }
+        if (codificacion_ == CodificacionMinipagina::REFERENCIA_BITS) {
+            return static_cast<int64_t>(static_cast<uint64_t>(referencia_) + LeerBits(valores_, slot, ancho_));
+        }
+        int64_t valor;
+        std::memcpy(&valor, valores_ + uint64_t(slot) * sizeof(valor), sizeof(valor));
+        return valor;
+    }
+
+    double Real(uint32_t slot) const {
+        double valor;
+        std::memcpy(&valor, valores_ + uint64_t(slot) * sizeof(valor), sizeof(valor));
+        return valor;
+    }
+
+    std::string_view Texto(uint32_t slot) const {
+        uint32_t indice = slot;
+        if (codificacion_ == CodificacionMinipagina::DICCIONARIO) {
+            indice = static_cast<uint32_t>(LeerBits(codigos_, slot, ancho_));
+            if (indice >= entradas_) {
+                return std::string_view();
+            }
+        }
+        uint32_t inicio = (indice == 0) ? 0 : LeerU16(fines_, indice - 1);
+        uint32_t fin = LeerU16(fines_, indice);
+        if (fin < inicio || fin > longitud_bytes_) {
+            return std::string_view();
+        }
+        return std::string_view(reinterpret_cast<const char*>(bytes_) + inicio, fin - inicio);
+    }
+
+private:
+    ColumnType tipo_ = ColumnType::INT;
+    CodificacionMinipagina codificacion_ = CodificacionMinipagina::PLANA;
+    uint8_t ancho_ = 0;
+    bool con_valores_ = false;
+    const uint8_t* nulos_ = nullptr;
+    const uint8_t* valores_ = nullptr;
+    int64_t referencia_ = 0;
+    const uint8_t* fines_ = nullptr;        // Texto: fin de cada valor (o entrada del diccionario)
+    const uint8_t* bytes_ = nullptr;
+    uint32_t longitud_bytes_ = 0;
+    const uint8_t* codigos_ = nullptr;      // Diccionario: código de cada slot
+    uint32_t entradas_ = 0;
+};
+
+/**
+ * @brief Escribe un registro en el formato de fila de la disposición a partir de
+ *        funciones que dan el valor de cada columna.
+ */
+template <typename Nulo, typename Entero, typename Real, typename Texto>
+void ConstruirFila(const DisposicionRegistro& disposicion, std::vector<Byte>& registro,
+                   Nulo es_nulo, Entero entero, Real real, Texto texto) {
+    const uint32_t columnas = disposicion.NumeroColumnas();
+    uint32_t longitud = disposicion.TamañoMinimo();
+    for (uint32_t i = 0; i < columnas; ++i) {
+        if (disposicion.Columna(i).type == ColumnType::VARCHAR && !es_nulo(i)) {
+            longitud += static_cast<uint32_t>(texto(i).size());
+        }
+    }
+    registro.assign(longitud, 0);
+    DisposicionRegistro::CabeceraRegistro cabecera{static_cast<uint16_t>(longitud), static_cast<uint16_t>(columnas)};
+    std::memcpy(registro.data(), &cabecera, sizeof(cabecera));
+
+    uint32_t fin_variables = disposicion.OffsetDatosVariables();
+    for (uint32_t i = 0; i < columnas; ++i) {
+        const ColumnMetadata& columna = disposicion.Columna(i);
+        const bool nulo = es_nulo(i);
+        if (nulo) {
+            registro[disposicion.OffsetMapaNulos() + i / 8] |= static_cast<Byte>(1u << (i % 8));
+        }
+        Byte* destino = registro.data() + (columna.type == ColumnType::VARCHAR ? 0 : disposicion.OffsetFijo(i));
+        switch (columna.type) {
+            case ColumnType::INT:
+                if (!nulo) {
+                    int64_t valor = entero(i);
+                    std::memcpy(destino, &valor, sizeof(valor));
+                }
+                break;
+            case ColumnType::REAL:
+                if (!nulo) {
+                    double valor = real(i);
+                    std::memcpy(destino, &valor, sizeof(valor));
+                }
+                break;
+            case ColumnType::BOOL:
+                if (!nulo) {
+                    *destino = entero(i) ? 1 : 0;
+                }
+                break;
+            case ColumnType::CHAR:
+                if (!nulo) {
+                    std::string_view valor = texto(i);
+                    std::memcpy(destino, valor.data(), std::min<size_t>(valor.size(), columna.size));
+                }
+                break;
+            case ColumnType::VARCHAR: {
+                if (!nulo) {
+                    std::string_view valor = texto(i);
+                    std::memcpy(registro.data() + fin_variables, valor.data(), valor.size());
+                    fin_variables += static_cast<uint32_t>(valor.size());
+                }
+                uint16_t fin = static_cast<uint16_t>(fin_variables);
+                std::memcpy(registro.data() + disposicion.OffsetTablaVariables() +
+                            disposicion.IndiceVariable(i) * sizeof(uint16_t), &fin, sizeof(fin));
+                break;
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ===== CONTENIDO DECODIFICADO =====
+
+ContenidoPaginaPAX::ContenidoPaginaPAX(const DisposicionRegistro& disposicion, bool codificacion_ligera)
+    : disposicion_(&disposicion), codificacion_ligera_(codificacion_ligera) {
+    Vaciar();
+}
+
+void ContenidoPaginaPAX::Vaciar() {
+    columnas_.assign(disposicion_->NumeroColumnas(), Columna());
+    for (uint32_t i = 0; i < columnas_.size(); ++i) {
+        columnas_[i].tipo = disposicion_->Columna(i).type;
+    }
+    eliminados_.clear();
+    numero_eliminados_ = 0;
+    parcial_ = false;
+}
+
+bool ContenidoPaginaPAX::Añadir(const VistaRegistro& registro, uint32_t& slot) {
+    if (parcial_ || !registro.EsValida() || registro.NumeroColumnas() != columnas_.size()) {
+        return false;
+    }
+    uint32_t candidato = static_cast<uint32_t>(std::find(eliminados_.begin(), eliminados_.end(), 1) - eliminados_.begin());
+    if (candidato == NumeroSlots()) {
+        if (NumeroSlots() >= MAX_SLOTS_POR_PAGINA) {
+            return false;
+        }
+        AñadirSlotNulo();
+    }
+    AsignarRegistro(candidato, registro);
+    eliminados_[candidato] = 0;
+    numero_eliminados_--;
+    if (TamañoCodificado() > PaginaPAX::CAPACIDAD) {
+        Eliminar(candidato); // Vuelve a dejarlo nulo y, si era nuevo, lo recorta
+        return false;
+    }
+    slot = candidato;
+    return true;
+}
+
+bool ContenidoPaginaPAX::Reemplazar(uint32_t slot, const VistaRegistro& registro) {
+    if (parcial_ || !EstaVivo(slot) || !registro.EsValida() || registro.NumeroColumnas() != columnas_.size()) {
+        return false;
+    }
+    std::vector<Byte> anterior;
+    Materializar(slot, anterior);
+    AsignarRegistro(slot, registro);
+    if (TamañoCodificado() > PaginaPAX::CAPACIDAD) {
+        AsignarRegistro(slot, VistaRegistro(anterior.data(), static_cast<uint32_t>(anterior.size()), *disposicion_));
+        return false;
+    }
+    return true;
+}
+
+bool ContenidoPaginaPAX::Eliminar(uint32_t slot) {
+    if (parcial_ || !EstaVivo(slot)) {
+        return false;
+    }
+    for (Columna& columna : columnas_) {
+        QuitarValor(columna, slot);
+        columna.nulos[slot] = 1;
+        columna.numero_nulos++;
+    }
+    eliminados_[slot] = 1;
+    numero_eliminados_++;
+    RecortarFinal();
+    return true;
+}
+
+void ContenidoPaginaPAX::Materializar(uint32_t slot, std::vector<Byte>& registro) const {
+    ConstruirFila(*disposicion_, registro,
+                  [&](uint32_t i) { return columnas_[i].nulos[slot] != 0; },
+                  [&](uint32_t i) { return columnas_[i].enteros[slot]; },
+                  [&](uint32_t i) { return columnas_[i].reales[slot]; },
+                  [&](uint32_t i) { return std::string_view(columnas_[i].textos[slot]); });
+}
+
+uint32_t ContenidoPaginaPAX::TamañoCodificado() const {
+    uint64_t total = sizeof(CabeceraPaginaPAX) + columnas_.size() * sizeof(DescriptorMinipagina) + BytesMapa(NumeroSlots());
+    for (const Columna& columna : columnas_) {
+        CodificacionMinipagina codificacion;
+        uint8_t ancho_bits;
+        total += TamañoColumna(columna, codificacion, ancho_bits);
+    }
+    return static_cast<uint32_t>(std::min<uint64_t>(total, UINT32_MAX));
+}
+
+uint32_t ContenidoPaginaPAX::TamañoColumna(const Columna& columna, CodificacionMinipagina& codificacion,
+                                           uint8_t& ancho_bits) const {
+    const uint64_t slots = NumeroSlots();
+    codificacion = CodificacionMinipagina::PLANA;
+    ancho_bits = 0;
+    if (slots == columna.numero_nulos) {
+        return 0; // Sin valores: el descriptor basta
+    }
+    // Los slots eliminados son nulos en todas las columnas pero no van en el mapa de nulos:
+    // así eliminar nunca hace crecer la página
+    uint64_t tamaño = (columna.numero_nulos > numero_eliminados_) ? BytesMapa(slots) : 0;
+    switch (columna.tipo) {
+        case ColumnType::INT:
+            if (codificacion_ligera_) {
+                AsegurarRango(columna);
+                codificacion = CodificacionMinipagina::REFERENCIA_BITS;
+                ancho_bits = BitsNecesarios(static_cast<uint64_t>(columna.maximo) - static_cast<uint64_t>(columna.minimo));
+                tamaño += BytesMapa(slots * ancho_bits);
+            } else {
+                tamaño += slots * sizeof(int64_t);
+            }
+            break;
+        case ColumnType::REAL:
+            tamaño += slots * sizeof(double);
+            break;
+        case ColumnType::BOOL:
+            tamaño += BytesMapa(slots);
+            break;
+        case ColumnType::CHAR:
+        case ColumnType::VARCHAR: {
+            uint64_t plana = slots * sizeof(uint16_t) + columna.bytes_texto;
+            if (codificacion_ligera_) {
+                uint64_t entradas = columna.distintos.size();
+                uint8_t ancho = BitsNecesarios(entradas - 1);
+                uint64_t diccionario = sizeof(uint16_t) + entradas * sizeof(uint16_t) + columna.bytes_distintos +
+                                       BytesMapa(slots * ancho);
+                if (diccionario < plana) {
+                    codificacion = CodificacionMinipagina::DICCIONARIO;
+                    ancho_bits = ancho;
+                    tamaño += diccionario;
+                    break;
+                }
+            }
+            tamaño += plana;
+            break;
+        }
+    }
+    return static_cast<uint32_t>(std::min<uint64_t>(tamaño, UINT32_MAX));
+}
+
+void ContenidoPaginaPAX::AñadirSlotNulo() {
+    for (Columna& columna : columnas_) {
+        columna.nulos.push_back(1);
+        columna.numero_nulos++;
+        if (EsTexto(columna.tipo)) {
+            columna.textos.emplace_back();
+        } else if (columna.tipo == ColumnType::REAL) {
+            columna.reales.push_back(0.0);
+        } else {
+            columna.enteros.push_back(0);
+        }
+    }
+    eliminados_.push_back(1);
+    numero_eliminados_++;
+}
+
+void ContenidoPaginaPAX::AsignarRegistro(uint32_t slot, const VistaRegistro& registro) {
+    for (uint32_t i = 0; i < columnas_.size(); ++i) {
+        Columna& columna = columnas_[i];
+        QuitarValor(columna, slot);
+        if (registro.EsNulo(i)) {
+            columna.nulos[slot] = 1;
+            columna.numero_nulos++;
+            continue;
+        }
+        switch (columna.tipo) {
+            case ColumnType::INT: PonerEntero(columna, slot, registro.ObtenerEntero(i)); break;
+            case ColumnType::BOOL: PonerEntero(columna, slot, registro.ObtenerBooleano(i) ? 1 : 0); break;
+            case ColumnType::REAL: PonerReal(columna, slot, registro.ObtenerReal(i)); break;
+            case ColumnType::CHAR:
+            case ColumnType::VARCHAR: PonerTexto(columna, slot, registro.ObtenerTexto(i)); break;
+        }
+    }
+}
+
+void ContenidoPaginaPAX::QuitarValor(Columna& columna, uint32_t slot) {
+    if (columna.nulos[slot]) {
+        columna.numero_nulos--;
+        return;
+    }
+    if (columna.tipo == ColumnType::INT) {
+        int64_t valor = columna.enteros[slot];
+        if (valor == columna.minimo || valor == columna.maximo) {
+            columna.rango_al_dia = false;
+        }
+        columna.enteros[slot] = 0;
+    } else if (EsTexto(columna.tipo)) {
+        std::string& texto = columna.textos[slot];
+        columna.bytes_texto -= texto.size();
+        if (!parcial_) {
+            auto it = columna.distintos.find(texto);
+            if (it != columna.distintos.end() && --it->second == 0) {
+                columna.bytes_distintos -= texto.size();
+                columna.distintos.erase(it);
+            }
+        }
+        texto.clear();
+    }
+    // Transitorio: el llamador pone el valor nuevo o lo vuelve a marcar como nulo
+    columna.nulos[slot] = 0;
+}
+
+void ContenidoPaginaPAX::PonerEntero(Columna& columna, uint32_t slot, int64_t valor) {
+    columna.nulos[slot] = 0;
+    columna.enteros[slot] = valor;
+    if (columna.tipo != ColumnType::INT || !columna.rango_al_dia) {
+        return;
+    }
+    if (NumeroSlots() - columna.numero_nulos == 1) {
+        columna.minimo = columna.maximo = valor; // Primer valor no nulo
+    } else {
+        columna.minimo = std::min(columna.minimo, valor);
+        columna.maximo = std::max(columna.maximo, valor);
+    }
+}
+
+void ContenidoPaginaPAX::PonerReal(Columna& columna, uint32_t slot, double valor) {
+    columna.nulos[slot] = 0;
+    columna.reales[slot] = valor;
+}
+
+void ContenidoPaginaPAX::PonerTexto(Columna& columna, uint32_t slot, std::string_view valor) {
+    columna.nulos[slot] = 0;
+    columna.textos[slot].assign(valor.data(), valor.size());
+    columna.bytes_texto += valor.size();
+    if (!parcial_ && columna.distintos[columna.textos[slot]]++ == 0) {
+        columna.bytes_distintos += valor.size();
+    }
+}
+
+void ContenidoPaginaPAX::RecortarFinal() {
+    while (!eliminados_.empty() && eliminados_.back()) {
+        for (Columna& columna : columnas_) {
+            columna.nulos.pop_back();
+            columna.numero_nulos--; // Los slots eliminados son nulos en todas las columnas
+            if (EsTexto(columna.tipo)) {
+                columna.textos.pop_back();
+            } else if (columna.tipo == ColumnType::REAL) {
+                columna.reales.pop_back();
+            } else {
+                columna.enteros.pop_back();
+            }
+        }
+        eliminados_.pop_back();
+        numero_eliminados_--;
+    }
+}
+
+void ContenidoPaginaPAX::AsegurarRango(const Columna& columna) const {
+    if (columna.rango_al_dia) {
+        return;
+    }
+    bool primero = true;
+    for (size_t slot = 0; slot < columna.enteros.size(); ++slot) {
+        if (columna.nulos[slot]) continue;
+        int64_t valor = columna.enteros[slot];
+        columna.minimo = primero ? valor : std::min(columna.minimo, valor);
+        columna.maximo = primero ? valor : std::max(columna.maximo, valor);
+        primero = false;
+    }
+    columna.rango_al_dia = true;
+}
+
+// ===== PÁGINA =====
+
+void PaginaPAX::Inicializar(PageId id_pagina, bool codificacion_ligera) {
+    // Misma cabecera común y de datos que una página ranurada vacía
+    PaginaRanurada(datos_).Inicializar(id_pagina);
+    CabeceraPaginaPAX* cabecera = Cabecera();
+    cabecera->marca = MARCA_PAGINA_PAX;
+    cabecera->numero_columnas = static_cast<uint16_t>(disposicion_->NumeroColumnas());
+    cabecera->numero_slots = 0;
+    cabecera->version_contenido = 0;
+    cabecera->codificacion_ligera = codificacion_ligera ? 1 : 0;
+    ContenidoPaginaPAX vacio(*disposicion_, codificacion_ligera);
+    Escribir(vacio);
+}
+
+bool PaginaPAX::EsPaginaPAX(const Byte* datos_pagina) {
+    const CabeceraComun* comun = reinterpret_cast<const CabeceraComun*>(datos_pagina);
+    const CabeceraPaginaPAX* cabecera = reinterpret_cast<const CabeceraPaginaPAX*>(datos_pagina + INICIO_PAX);
+    return comun->tipo_pagina == PageType::DATA_PAGE && cabecera->marca == MARCA_PAGINA_PAX;
+}
+
+uint32_t PaginaPAX::VersionContenido(const Byte* datos_pagina) {
+    return EsPaginaPAX(datos_pagina)
+               ? reinterpret_cast<const CabeceraPaginaPAX*>(datos_pagina + INICIO_PAX)->version_contenido : 0;
+}
+
+bool PaginaPAX::CorrespondeADisposicion() const {
+    if (!EsPaginaPAX() || Cabecera()->numero_columnas != disposicion_->NumeroColumnas()) {
+        return false;
+    }
+    uint64_t cabeceras = INICIO_PAX + sizeof(CabeceraPaginaPAX) +
+                         uint64_t(Cabecera()->numero_columnas) * sizeof(DescriptorMinipagina) + BytesMapa(NumeroSlots());
+    return cabeceras <= BLOCK_SIZE && NumeroSlots() <= MAX_SLOTS_POR_PAGINA;
+}
+
+Status PaginaPAX::Leer(ContenidoPaginaPAX& contenido, const std::vector<bool>* columnas) const {
+    if (!CorrespondeADisposicion() || contenido.columnas_.size() != disposicion_->NumeroColumnas()) {
+        return Status::INVALID_FORMAT;
+    }
+    contenido.Vaciar();
+    contenido.codificacion_ligera_ = Cabecera()->codificacion_ligera != 0;
+    contenido.parcial_ = (columnas != nullptr);
+
+    const uint32_t slots = NumeroSlots();
+    const uint32_t numero_columnas = disposicion_->NumeroColumnas();
+    const uint8_t* mapa_eliminados = reinterpret_cast<const uint8_t*>(Descriptores(datos_) + numero_columnas);
+    for (uint32_t slot = 0; slot < slots; ++slot) {
+        contenido.AñadirSlotNulo();
+        if (!LeerBit(mapa_eliminados, slot)) {
+            contenido.eliminados_[slot] = 0;
+            contenido.numero_eliminados_--;
+        }
+    }
+
+    const DescriptorMinipagina* descriptores = Descriptores(datos_);
+    LectorMinipagina lector;
+    for (uint32_t i = 0; i < numero_columnas; ++i) {
+        if (columnas && (i >= columnas->size() || !(*columnas)[i])) {
+            continue; // Columna no pedida: se queda nula
+        }
+        ContenidoPaginaPAX::Columna& columna = contenido.columnas_[i];
+        if (!lector.Preparar(datos_, descriptores[i], columna.tipo, slots)) {
+            return Status::INVALID_FORMAT;
+        }
+        for (uint32_t slot = 0; slot < slots; ++slot) {
+            if (contenido.eliminados_[slot] || lector.EsNulo(slot)) {
+                continue;
+            }
+            columna.numero_nulos--; // El slot deja de ser nulo
+            switch (columna.tipo) {
+                case ColumnType::INT:
+                case ColumnType::BOOL: contenido.PonerEntero(columna, slot, lector.Entero(slot)); break;
+                case ColumnType::REAL: contenido.PonerReal(columna, slot, lector.Real(slot)); break;
+                case ColumnType::CHAR:
+                case ColumnType::VARCHAR: contenido.PonerTexto(columna, slot, lector.Texto(slot)); break;
+            }
+        }
+    }
+    return Status::OK;
+}
+
+Status PaginaPAX::Escribir(const ContenidoPaginaPAX& contenido) {
+    if (contenido.parcial_ || contenido.columnas_.size() != disposicion_->NumeroColumnas()) {
+        return Status::INVALID_ARGUMENT;
+    }
+    const uint32_t tamaño = contenido.TamañoCodificado();
+    if (tamaño > CAPACIDAD) {
+        return Status::OUT_OF_SPACE_FOR_UPDATE;
+    }
+    const uint32_t version = EsPaginaPAX() ? Cabecera()->version_contenido + 1 : 1;
+    const uint32_t slots = contenido.NumeroSlots();
+    const uint32_t numero_columnas = static_cast<uint32_t>(contenido.columnas_.size());
+
+    std::memset(datos_ + INICIO_PAX, 0, CAPACIDAD);
+    CabeceraPaginaPAX* cabecera = Cabecera();
+    cabecera->marca = MARCA_PAGINA_PAX;
+    cabecera->numero_columnas = static_cast<uint16_t>(numero_columnas);
+    cabecera->numero_slots = static_cast<uint16_t>(slots);
+    cabecera->version_contenido = version;
+    cabecera->codificacion_ligera = contenido.codificacion_ligera_ ? 1 : 0;
+
+    DescriptorMinipagina* descriptores = reinterpret_cast<DescriptorMinipagina*>(datos_ + INICIO_PAX + sizeof(CabeceraPaginaPAX));
+    uint8_t* mapa_eliminados = reinterpret_cast<uint8_t*>(descriptores + numero_columnas);
+    for (uint32_t slot = 0; slot < slots; ++slot) {
+        if (contenido.eliminados_[slot]) {
+            PonerBit(mapa_eliminados, slot);
+        }
+    }
+
+    uint32_t offset = INICIO_PAX + sizeof(CabeceraPaginaPAX) + numero_columnas * sizeof(DescriptorMinipagina) + BytesMapa(slots);
+    for (uint32_t i = 0; i < numero_columnas; ++i) {
+        DescriptorMinipagina& descriptor = descriptores[i];
+        CodificacionMinipagina codificacion;
+        uint8_t ancho_bits;
+        uint32_t longitud = contenido.TamañoColumna(contenido.columnas_[i], codificacion, ancho_bits);
+        descriptor.offset = static_cast<uint16_t>(offset);
+        descriptor.longitud = static_cast<uint16_t>(longitud);
+        descriptor.codificacion = static_cast<uint8_t>(codificacion);
+        descriptor.ancho_bits = ancho_bits;
+        CodificarColumna(contenido, i, datos_ + offset, descriptor);
+        offset += longitud;
+    }
+
+    // La cabecera de datos refleja la página como la de una página ranurada
+    CabeceraBloqueDatos* datos = reinterpret_cast<CabeceraBloqueDatos*>(datos_ + sizeof(CabeceraComun));
+    datos->espacio_libre_total = CAPACIDAD - tamaño;
+    datos->fragmentacion_interna = 0;
+    datos->offset_espacio_libre = INICIO_PAX + tamaño;
+    datos->numero_registros_activos = contenido.RegistrosActivos();
+    datos->numero_registros_eliminados = contenido.numero_eliminados_;
+    datos->offset_directorio_slots = BLOCK_SIZE;
+    datos->tamano_directorio_slots = slots;
+    datos->factor_carga_porcentaje = tamaño * 100 / CAPACIDAD;
+    datos->necesita_compactacion = false;
+    datos->pista_slot_libre = 0;
+    return Status::OK;
+}
+
+void PaginaPAX::CodificarColumna(const ContenidoPaginaPAX& contenido, uint32_t indice, Byte* destino,
+                                 DescriptorMinipagina& descriptor) {
+    const ContenidoPaginaPAX::Columna& columna = contenido.columnas_[indice];
+    const uint32_t slots = contenido.NumeroSlots();
+    descriptor.banderas = 0;
+    descriptor.longitudes_prefijo = 0;
+    if (columna.numero_nulos == slots) {
+        return; // Todos nulos (un INT constante también ocupa 0 bytes, pero tiene valores)
+    }
+    descriptor.banderas = MINIPAGINA_CON_VALORES | MINIPAGINA_CON_RANGO;
+    uint8_t* salida = reinterpret_cast<uint8_t*>(destino);
+    if (columna.numero_nulos > contenido.numero_eliminados_) {
+        descriptor.banderas |= MINIPAGINA_CON_NULOS;
+        for (uint32_t slot = 0; slot < slots; ++slot) {
+            if (columna.nulos[slot] && !contenido.eliminados_[slot]) {
+                PonerBit(salida, slot);
+            }
+        }
+        salida += BytesMapa(slots);
+    }
+    const auto codificacion = static_cast<CodificacionMinipagina>(descriptor.codificacion);
+
+    switch (columna.tipo) {
+        case ColumnType::INT:
+        case ColumnType::BOOL: {
+            int64_t minimo = 0;
+            int64_t maximo = 0;
+            if (columna.tipo == ColumnType::INT) {
+                contenido.AsegurarRango(columna);
+                minimo = columna.minimo;
+                maximo = columna.maximo;
+            } else {
+                bool primero = true;
+                for (uint32_t slot = 0; slot < slots; ++slot) {
+                    if (columna.nulos[slot]) continue;
+                    minimo = primero ? columna.enteros[slot] : std::min(minimo, columna.enteros[slot]);
+                    maximo = primero ? columna.enteros[slot] : std::max(maximo, columna.enteros[slot]);
+                    primero = false;
+                }
+            }
+            std::memcpy(descriptor.minimo, &minimo, sizeof(minimo));
+            std::memcpy(descriptor.maximo, &maximo, sizeof(maximo));
+            for (uint32_t slot = 0; slot < slots; ++slot) {
+                if (columna.nulos[slot]) continue;
+                int64_t valor = columna.enteros[slot];
+                if (columna.tipo == ColumnType::BOOL) {
+                    if (valor) PonerBit(salida, slot);
+                } else if (codificacion == CodificacionMinipagina::REFERENCIA_BITS) {
+                    EscribirBits(salida, slot, descriptor.ancho_bits, static_cast<uint64_t>(valor) - static_cast<uint64_t>(minimo));
+                } else {
+                    std::memcpy(salida + uint64_t(slot) * sizeof(valor), &valor, sizeof(valor));
+                }
+            }
+            break;
+        }
+        case ColumnType::REAL: {
+            bool primero = true;
+            double minimo = 0.0;
+            double maximo = 0.0;
+            for (uint32_t slot = 0; slot < slots; ++slot) {
+                double valor = columna.reales[slot];
+                std::memcpy(salida + uint64_t(slot) * sizeof(valor), &valor, sizeof(valor));
+                if (columna.nulos[slot]) continue;
+                if (std::isnan(valor)) {
+                    descriptor.banderas &= static_cast<uint8_t>(~MINIPAGINA_CON_RANGO);
+                    continue;
+                }
+                minimo = primero ? valor : std::min(minimo, valor);
+                maximo = primero ? valor : std::max(maximo, valor);
+                primero = false;
+            }
+            std::memcpy(descriptor.minimo, &minimo, sizeof(minimo));
+            std::memcpy(descriptor.maximo, &maximo, sizeof(maximo));
+            break;
+        }
+        case ColumnType::CHAR:
+        case ColumnType::VARCHAR: {
+            std::string_view minimo;
+            std::string_view maximo;
+            bool primero = true;
+            for (uint32_t slot = 0; slot < slots; ++slot) {
+                if (columna.nulos[slot]) continue;
+                std::string_view valor = ValorDeRango(columna.tipo, columna.textos[slot]);
+                if (primero || valor < minimo) minimo = valor;
+                if (primero || maximo < valor) maximo = valor;
+                primero = false;
+            }
+            uint8_t longitud_minimo = static_cast<uint8_t>(std::min<size_t>(minimo.size(), sizeof(descriptor.minimo)));
+            uint8_t longitud_maximo = static_cast<uint8_t>(std::min<size_t>(maximo.size(), sizeof(descriptor.maximo)));
+            std::memcpy(descriptor.minimo, minimo.data(), longitud_minimo);
+            std::memcpy(descriptor.maximo, maximo.data(), longitud_maximo);
+            descriptor.longitudes_prefijo = static_cast<uint8_t>(longitud_minimo | (longitud_maximo << 4));
+
+            if (codificacion == CodificacionMinipagina::DICCIONARIO) {
+                std::vector<std::string_view> entradas;
+                entradas.reserve(columna.distintos.size());
+                for (const auto& distinto : columna.distintos) {
+                    entradas.push_back(distinto.first);
+                }
+                std::sort(entradas.begin(), entradas.end());
+                EscribirU16(salida, 0, static_cast<uint32_t>(entradas.size()));
+                uint8_t* fines = salida + sizeof(uint16_t);
+                uint8_t* bytes = fines + entradas.size() * sizeof(uint16_t);
+                uint32_t fin = 0;
+                for (size_t e = 0; e < entradas.size(); ++e) {
+                    std::memcpy(bytes + fin, entradas[e].data(), entradas[e].size());
+                    fin += static_cast<uint32_t>(entradas[e].size());
+                    EscribirU16(fines, static_cast<uint32_t>(e), fin);
+                }
+                uint8_t* codigos = bytes + fin;
+                for (uint32_t slot = 0; slot < slots; ++slot) {
+                    if (columna.nulos[slot]) continue;
+                    auto it = std::lower_bound(entradas.begin(), entradas.end(), std::string_view(columna.textos[slot]));
+                    EscribirBits(codigos, slot, descriptor.ancho_bits, static_cast<uint64_t>(it - entradas.begin()));
+                }
+            } else {
+                uint8_t* fines = salida;
+                uint8_t* bytes = fines + uint64_t(slots) * sizeof(uint16_t);
+                uint32_t fin = 0;
+                for (uint32_t slot = 0; slot < slots; ++slot) {
+                    const std::string& valor = columna.textos[slot];
+                    std::memcpy(bytes + fin, valor.data(), valor.size());
+                    fin += static_cast<uint32_t>(valor.size());
+                    EscribirU16(fines, slot, fin);
+                }
+            }
+            break;
+        }
+    }
+}
+
+Status PaginaPAX::Insertar(const Byte* registro, uint32_t longitud, uint32_t& slot) {
+    VistaRegistro vista(registro, longitud, *disposicion_);
+    if (!vista.EsValida()) {
+        return Status::INVALID_ARGUMENT;
+    }
+    ContenidoPaginaPAX contenido(*disposicion_, Cabecera()->codificacion_ligera != 0);
+    Status estado = Leer(contenido);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    if (!contenido.Añadir(vista, slot)) {
+        return Status::OUT_OF_SPACE_FOR_UPDATE;
+    }
+    return Escribir(contenido);
+}
+
+bool PaginaPAX::Obtener(uint32_t slot, std::vector<Byte>& registro) const {
+    if (!CorrespondeADisposicion() || slot >= NumeroSlots()) {
+        return false;
+    }
+    const uint32_t numero_columnas = disposicion_->NumeroColumnas();
+    const uint8_t* mapa_eliminados = reinterpret_cast<const uint8_t*>(Descriptores(datos_) + numero_columnas);
+    if (LeerBit(mapa_eliminados, slot)) {
+        return false;
+    }
+    std::vector<LectorMinipagina> lectores(numero_columnas);
+    for (uint32_t i = 0; i < numero_columnas; ++i) {
+        if (!lectores[i].Preparar(datos_, Descriptores(datos_)[i], disposicion_->Columna(i).type, NumeroSlots())) {
+            return false;
+        }
+    }
+    ConstruirFila(*disposicion_, registro,
+                  [&](uint32_t i) { return lectores[i].EsNulo(slot); },
+                  [&](uint32_t i) { return lectores[i].Entero(slot); },
+                  [&](uint32_t i) { return lectores[i].Real(slot); },
+                  [&](uint32_t i) { return lectores[i].Texto(slot); });
+    return true;
+}
+
+Status PaginaPAX::Actualizar(uint32_t slot, const Byte* registro, uint32_t longitud) {
+    VistaRegistro vista(registro, longitud, *disposicion_);
+    if (!vista.EsValida()) {
+        return Status::INVALID_ARGUMENT;
+    }
+    ContenidoPaginaPAX contenido(*disposicion_, Cabecera()->codificacion_ligera != 0);
+    Status estado = Leer(contenido);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    if (!contenido.EstaVivo(slot)) {
+        return Status::NOT_FOUND;
+    }
+    if (!contenido.Reemplazar(slot, vista)) {
+        return Status::OUT_OF_SPACE_FOR_UPDATE;
+    }
+    return Escribir(contenido);
+}
+
+Status PaginaPAX::Eliminar(uint32_t slot) {
+    ContenidoPaginaPAX contenido(*disposicion_, Cabecera()->codificacion_ligera != 0);
+    Status estado = Leer(contenido);
+    if (estado != Status::OK) {
+        return estado;
+    }
+    if (!contenido.Eliminar(slot)) {
+        return Status::NOT_FOUND;
+    }
+    return Escribir(contenido);
+}
+
+bool PaginaPAX::LeerRango(const Byte* datos_pagina, uint32_t columna, ColumnType tipo, RangoColumnaPAX& rango) {
+    rango = RangoColumnaPAX();
+    if (!EsPaginaPAX(datos_pagina)) {
+        return false;
+    }
+    const CabeceraPaginaPAX* cabecera = reinterpret_cast<const CabeceraPaginaPAX*>(datos_pagina + INICIO_PAX);
+    if (columna >= cabecera->numero_columnas ||
+        INICIO_PAX + sizeof(CabeceraPaginaPAX) + (columna + 1) * sizeof(DescriptorMinipagina) > BLOCK_SIZE) {
+        return false;
+    }
+    const DescriptorMinipagina& descriptor = Descriptores(datos_pagina)[columna];
+    rango.con_valores = (descriptor.banderas & MINIPAGINA_CON_VALORES) != 0;
+    const CabeceraBloqueDatos* datos = reinterpret_cast<const CabeceraBloqueDatos*>(datos_pagina + sizeof(CabeceraComun));
+    rango.con_nulos = (descriptor.banderas & MINIPAGINA_CON_NULOS) != 0 ||
+                      (!rango.con_valores && datos->numero_registros_activos > 0);
+    rango.con_rango = rango.con_valores && (descriptor.banderas & MINIPAGINA_CON_RANGO) != 0;
+    switch (tipo) {
+        case ColumnType::INT:
+        case ColumnType::BOOL:
+            std::memcpy(&rango.minimo_entero, descriptor.minimo, sizeof(rango.minimo_entero));
+            std::memcpy(&rango.maximo_entero, descriptor.maximo, sizeof(rango.maximo_entero));
+            break;
+        case ColumnType::REAL:
+            std::memcpy(&rango.minimo_real, descriptor.minimo, sizeof(rango.minimo_real));
+            std::memcpy(&rango.maximo_real, descriptor.maximo, sizeof(rango.maximo_real));
+            break;
+        case ColumnType::CHAR:
+        case ColumnType::VARCHAR:
+            rango.prefijo_minimo = std::string_view(descriptor.minimo, descriptor.longitudes_prefijo & 0x0F);
+            rango.prefijo_maximo = std::string_view(descriptor.maximo, descriptor.longitudes_prefijo >> 4);
+            break;
+    }
+    return true;
+}
+
+// ===== LECTOR PARA LOS RECORRIDOS =====
+
+LectorPaginaDatos::LectorPaginaDatos(const DisposicionRegistro* disposicion, FormatoAlmacenamiento formato,
+                                     std::vector<bool> columnas)
+    : disposicion_(disposicion), formato_(formato), columnas_(std::move(columnas)) {
+    if (EsColumnar()) {
+        // Leer con columnas deja el contenido en modo consulta, sin estadísticas
+        columnas_.resize(disposicion_->NumeroColumnas(), columnas_.empty());
+        contenido_ = std::make_unique<ContenidoPaginaPAX>(*disposicion_, true);
+    }
+}
+
+bool LectorPaginaDatos::Cargar(Byte* datos_pagina) {
+    datos_pagina_ = datos_pagina;
+    if (!EsColumnar()) {
+        if (!PaginaRanurada(datos_pagina).EsPaginaDatos()) {
+            datos_pagina_ = nullptr;
+            return false;
+        }
+        return true;
+    }
+    return DecodificarPAX();
+}
+
+void LectorPaginaDatos::Refrescar() {
+    if (EsColumnar() && datos_pagina_ != nullptr && PaginaPAX::VersionContenido(datos_pagina_) != version_) {
+        DecodificarPAX();
+    }
+}
+
+uint32_t LectorPaginaDatos::NumeroSlots() const {
+    if (datos_pagina_ == nullptr) {
+        return 0;
+    }
+    if (!EsColumnar()) {
+        return PaginaRanurada(datos_pagina_).NumeroSlots();
+    }
+    return inicio_fila_.empty() ? 0 : static_cast<uint32_t>(inicio_fila_.size() - 1);
+}
+
+bool LectorPaginaDatos::Obtener(uint32_t slot, const Byte*& registro, uint32_t& longitud) const {
+    if (datos_pagina_ == nullptr) {
+        return false;
+    }
+    if (!EsColumnar()) {
+        return PaginaRanurada(datos_pagina_).Obtener(slot, registro, longitud);
+    }
+    if (slot + 1 >= inicio_fila_.size() || inicio_fila_[slot + 1] == inicio_fila_[slot]) {
+        return false; // Slot eliminado
+    }
+    registro = filas_.data() + inicio_fila_[slot];
+    longitud = inicio_fila_[slot + 1] - inicio_fila_[slot];
+    return true;
+}
+
+bool LectorPaginaDatos::DecodificarPAX() {
+    filas_.clear();
+    inicio_fila_.clear();
+    if (!PaginaPAX::EsPaginaPAX(datos_pagina_) ||
+        PaginaPAX(datos_pagina_, *disposicion_).Leer(*contenido_, &columnas_) != Status::OK) {
+        datos_pagina_ = nullptr;
+        return false;
+    }
+    version_ = PaginaPAX::VersionContenido(datos_pagina_);
+    for (uint32_t slot = 0; slot < contenido_->NumeroSlots(); ++slot) {
+        inicio_fila_.push_back(static_cast<uint32_t>(filas_.size()));
+        if (contenido_->EstaVivo(slot)) {
+            contenido_->Materializar(slot, temporal_);
+            filas_.insert(filas_.end(), temporal_.begin(), temporal_.end());
+        }
+    }
+    inicio_fila_.push_back(static_cast<uint32_t>(filas_.size()));
+    return true;
+}
@@ -0,0 +1,282 @@
+// record_manager/pagina_pax.h - Página de datos por columnas (PAX) con codificación ligera
+// Alternativa a PaginaRanurada para las tablas que se recorren leyendo pocas columnas
+
+#ifndef PAGINA_PAX_H
+#define PAGINA_PAX_H
+
+#include "../include/common.h"
+#include "../data_storage/cabeceras_bloques.h"
+#include "formato_registro.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Rango de valores de una columna en una página PAX, leído de su descriptor.
+ */
+struct RangoColumnaPAX {
+    bool con_valores = false;       // Algún valor no nulo
+    bool con_nulos = false;         // Algún nulo entre los registros vivos
+    bool con_rango = false;         // Los campos siguientes son válidos
+    int64_t minimo_entero = 0;      // INT y BOOL
+    int64_t maximo_entero = 0;
+    double minimo_real = 0.0;
+    double maximo_real = 0.0;
+    std::string_view prefijo_minimo; // CHAR/VARCHAR: hasta 8 bytes, apuntan a la página
+    std::string_view prefijo_maximo;
+};
+
+/**
+ * @brief Registros de una página PAX decodificados, columna a columna.
+ *
+ * Mantiene al día lo necesario para saber cuánto ocuparía la página codificada
+ * (nulos, mínimo y máximo de los INT, bytes y valores distintos de los textos),
+ * así que comprobar si cabe un registro más cuesta O(columnas) y una carga masiva
+ * puede llenar la página en memoria y escribirla una sola vez.
+ *
+ * Un slot eliminado conserva su número y queda con todas sus columnas a nulo;
+ * Añadir() reutiliza el primero que encuentre.
+ */
+class ContenidoPaginaPAX {
+public:
+    ContenidoPaginaPAX(const DisposicionRegistro& disposicion, bool codificacion_ligera);
+
+    /**
+     * @brief Añade un registro si la página codificada lo admite.
+     * @param registro Registro en el formato de fila de la tabla
+     * @param slot [out] Slot asignado
+     * @return false si no cabe (el contenido queda como estaba)
+     */
+    bool Añadir(const VistaRegistro& registro, uint32_t& slot);
+
+    /**
+     * @brief Sustituye un registro vivo conservando su slot.
+     * @return false si el slot no está vivo o el nuevo registro no cabe (sin cambios)
+     */
+    bool Reemplazar(uint32_t slot, const VistaRegistro& registro);
+
+    /**
+     * @brief Elimina un registro vivo y recorta los slots eliminados del final.
+     */
+    bool Eliminar(uint32_t slot);
+
+    /**
+     * @brief Reconstruye un registro en el formato de fila para leerlo con VistaRegistro.
+     * Las columnas que no se decodificaron (ver PaginaPAX::Leer) salen como nulas.
+     */
+    void Materializar(uint32_t slot, std::vector<Byte>& registro) const;
+
+    uint32_t NumeroSlots() const { return static_cast<uint32_t>(eliminados_.size()); }
+    uint32_t RegistrosActivos() const { return NumeroSlots() - numero_eliminados_; }
+    bool EstaVivo(uint32_t slot) const { return slot < NumeroSlots() && !eliminados_[slot]; }
+    bool CodificacionLigera() const { return codificacion_ligera_; }
+    const DisposicionRegistro& Disposicion() const { return *disposicion_; }
+
+    /**
+     * @brief Bytes que ocupa la página codificada desde PaginaPAX::INICIO_PAX.
+     */
+    uint32_t TamañoCodificado() const;
+
+    /**
+     * @brief Vacía el contenido para reutilizarlo con otra página.
+     */
+    void Vaciar();
+
+    /**
+     * @brief Indica si se leyó solo para consultar (PaginaPAX::Leer con columnas):
+     *        no lleva estadísticas y no admite cambios ni Escribir().
+     */
+    bool EsParcial() const { return parcial_; }
+
+private:
+    friend class PaginaPAX;
+
+    struct Columna {
+        ColumnType tipo;
+        std::vector<uint8_t> nulos;
+        std::vector<int64_t> enteros;   // INT y BOOL
+        std::vector<double> reales;
+        std::vector<std::string> textos;
+        uint32_t numero_nulos = 0;
+        mutable bool rango_al_dia = true;   // Quitar un valor puede reducir el rango: se recalcula al medir
+        mutable int64_t minimo = 0;         // INT, sobre los valores no nulos
+        mutable int64_t maximo = 0;
+        uint64_t bytes_texto = 0;
+        std::unordered_map<std::string, uint32_t> distintos; // Texto -> apariciones
+        uint64_t bytes_distintos = 0;
+    };
+
+    const DisposicionRegistro* disposicion_;
+    bool codificacion_ligera_;
+    std::vector<Columna> columnas_;
+    std::vector<uint8_t> eliminados_;
+    uint32_t numero_eliminados_ = 0;
+    bool parcial_ = false;
+
+    void AñadirSlotNulo();
+    void AsignarRegistro(uint32_t slot, const VistaRegistro& registro);
+    void QuitarValor(Columna& columna, uint32_t slot);
+    void PonerEntero(Columna& columna, uint32_t slot, int64_t valor);
+    void PonerReal(Columna& columna, uint32_t slot, double valor);
+    void PonerTexto(Columna& columna, uint32_t slot, std::string_view valor);
+    void RecortarFinal();
+    void AsegurarRango(const Columna& columna) const;
+
+    /**
+     * @brief Bytes de la minipágina de una columna y codificación con la que se escribiría.
+     */
+    uint32_t TamañoColumna(const Columna& columna, CodificacionMinipagina& codificacion, uint8_t& ancho_bits) const;
+};
+
+/**
+ * @brief Vista de una página de datos PAX sobre los bytes de un frame anclado.
+ *
+ * DISPOSICIÓN:
+ *   [CabeceraComun][CabeceraBloqueDatos][CabeceraPaginaPAX][DescriptorMinipagina x columnas]
+ *   [mapa de eliminados][minipágina columna 0][minipágina columna 1]...
+ *
+ * Cada minipágina lleva, si hace falta, su mapa de nulos y después los valores de
+ * todos los slots: INT con referencia al mínimo y empaquetado de bits, textos con
+ * diccionario cuando ocupa menos que guardarlos tal cual. Con codificacion_ligera
+ * desactivada todo se guarda en codificación PLANA.
+ *
+ * Todas las codificaciones admiten acceso directo por slot, así que Obtener() solo
+ * decodifica el registro pedido. Las modificaciones decodifican la página,
+ * la cambian y la vuelven a escribir entera; el llamador registra la imagen de la
+ * página en el WAL y la marca sucia, como con PaginaRanurada.
+ */
+class PaginaPAX {
+public:
+    static constexpr uint32_t INICIO_PAX = sizeof(CabeceraComun) + sizeof(CabeceraBloqueDatos);
+    static constexpr uint32_t CAPACIDAD = BLOCK_SIZE - INICIO_PAX;
+
+    PaginaPAX(Byte* datos_pagina, const DisposicionRegistro& disposicion)
+        : datos_(datos_pagina), disposicion_(&disposicion) {}
+
+    /**
+     * @brief Inicializa las cabeceras de una página PAX vacía.
+     */
+    void Inicializar(PageId id_pagina, bool codificacion_ligera);
+
+    /**
+     * @brief Decodifica la página.
+     * @param columnas Opcional: solo se decodifican las columnas marcadas (las demás
+     *        quedan nulas) y el contenido queda parcial, solo para consultar
+     * @return INVALID_FORMAT si la página no es PAX o no corresponde a la disposición
+     */
+    Status Leer(ContenidoPaginaPAX& contenido, const std::vector<bool>* columnas = nullptr) const;
+
+    /**
+     * @brief Codifica el contenido en la página y actualiza sus cabeceras.
+     * @return OUT_OF_SPACE_FOR_UPDATE si no cabe (la página no cambia)
+     */
+    Status Escribir(const ContenidoPaginaPAX& contenido);
+
+    /**
+     * @brief Inserta un registro en formato de fila.
+     * @return Status::OUT_OF_SPACE_FOR_UPDATE si no cabe en la página
+     */
+    Status Insertar(const Byte* registro, uint32_t longitud, uint32_t& slot);
+
+    /**
+     * @brief Reconstruye un registro en formato de fila decodificando solo su slot.
+     * @return false si el slot no existe o está eliminado
+     */
+    bool Obtener(uint32_t slot, std::vector<Byte>& registro) const;
+
+    /**
+     * @brief Reemplaza un registro conservando su slot.
+     * @return Status::OUT_OF_SPACE_FOR_UPDATE si no cabe; NOT_FOUND si el slot no está vivo
+     */
+    Status Actualizar(uint32_t slot, const Byte* registro, uint32_t longitud);
+
+    /**
+     * @brief Elimina un registro.
+     * @return Status::NOT_FOUND si el slot no existe o ya estaba eliminado
+     */
+    Status Eliminar(uint32_t slot);
+
+    bool EsPaginaPAX() const { return EsPaginaPAX(datos_); }
+    uint32_t NumeroSlots() const { return Cabecera()->numero_slots; }
+    uint32_t EspacioLibre() const { return reinterpret_cast<const CabeceraBloqueDatos*>(datos_ + sizeof(CabeceraComun))->espacio_libre_total; }
+
+    /**
+     * @brief Indica si la página es de datos y tiene cabecera PAX.
+     */
+    static bool EsPaginaPAX(const Byte* datos_pagina);
+
+    /**
+     * @brief Cambia con cada escritura: quien guarda registros decodificados lo compara para releer.
+     */
+    static uint32_t VersionContenido(const Byte* datos_pagina);
+
+    /**
+     * @brief Lee el rango de una columna del descriptor, sin tocar la minipágina.
+     * @return false si la página no es PAX o no tiene esa columna
+     */
+    static bool LeerRango(const Byte* datos_pagina, uint32_t columna, ColumnType tipo, RangoColumnaPAX& rango);
+
+private:
+    Byte* datos_;
+    const DisposicionRegistro* disposicion_;
+
+    CabeceraPaginaPAX* Cabecera() { return reinterpret_cast<CabeceraPaginaPAX*>(datos_ + INICIO_PAX); }
+    const CabeceraPaginaPAX* Cabecera() const { return reinterpret_cast<const CabeceraPaginaPAX*>(datos_ + INICIO_PAX); }
+    bool CorrespondeADisposicion() const;
+
+    /**
+     * @brief Escribe la minipágina de una columna y completa su descriptor
+     *        (offset, longitud y codificación ya rellenos).
+     */
+    static void CodificarColumna(const ContenidoPaginaPAX& contenido, uint32_t columna, Byte* destino,
+                                 DescriptorMinipagina& descriptor);
+};
+
+/**
+ * @brief Acceso de solo lectura a los registros de una página de datos anclada, en
+ *        cualquiera de los dos formatos, para los recorridos.
+ *
+ * Con FILAS devuelve punteros al frame. Con COLUMNAS_PAX decodifica al cargar la
+ * página solo las columnas pedidas y reconstruye cada registro en formato de fila
+ * en un buffer propio, así que VistaRegistro, los filtros y los agregados no
+ * cambian; las columnas no pedidas salen como nulas. Los buffers se reutilizan
+ * de una página a la siguiente.
+ */
+class LectorPaginaDatos {
+public:
+    LectorPaginaDatos() = default;
+    LectorPaginaDatos(const DisposicionRegistro* disposicion, FormatoAlmacenamiento formato,
+                      std::vector<bool> columnas = {});
+
+    /**
+     * @brief Prepara una página anclada.
+     * @return false si la página no es de datos del formato esperado
+     */
+    bool Cargar(Byte* datos_pagina);
+
+    /**
+     * @brief Vuelve a decodificar una página PAX si se modificó desde Cargar().
+     */
+    void Refrescar();
+
+    uint32_t NumeroSlots() const;
+    bool Obtener(uint32_t slot, const Byte*& registro, uint32_t& longitud) const;
+    bool EsColumnar() const { return formato_ == FormatoAlmacenamiento::COLUMNAS_PAX; }
+
+private:
+    const DisposicionRegistro* disposicion_ = nullptr;
+    FormatoAlmacenamiento formato_ = FormatoAlmacenamiento::FILAS;
+    std::vector<bool> columnas_;                // Vacío = todas
+    Byte* datos_pagina_ = nullptr;
+    uint32_t version_ = 0;
+    std::vector<Byte> filas_;                   // Registros reconstruidos, uno tras otro
+    std::vector<uint32_t> inicio_fila_;         // Offset en filas_ de cada slot; NumeroSlots()+1 entradas
+    std::vector<Byte> temporal_;
+    std::unique_ptr<ContenidoPaginaPAX> contenido_;
+
+    bool DecodificarPAX();
+};
+
+#endif // PAGINA_PAX_H
@@ -0,0 +1,207 @@
+// record_manager/pagina_ranurada.cpp - Implementación de la página con directorio de slots
+#include "pagina_ranurada.h"
+#include <algorithm>  // Para std::sort, std::min
+#include <cstring>    // Para std::memcpy, std::memmove, std::memset
+#include <vector>
+
+// ===== INICIALIZACIÓN =====
+
+void PaginaRanurada::Inicializar(PageId id_pagina) {
+    std::memset(datos_, 0, BLOCK_SIZE);
+    CabeceraComun* cabecera_comun = reinterpret_cast<CabeceraComun*>(datos_);
+    *cabecera_comun = CabeceraComun();
+    cabecera_comun->id_bloque = id_pagina;
+    cabecera_comun->tipo_pagina = PageType::DATA_PAGE;
+
+    CabeceraBloqueDatos* cabecera = Cabecera();
+    cabecera->fragmentacion_interna = 0;
+    cabecera->offset_espacio_libre = INICIO_REGISTROS;
+    cabecera->numero_registros_activos = 0;
+    cabecera->numero_registros_eliminados = 0;
+    cabecera->offset_directorio_slots = BLOCK_SIZE; // El directorio crece hacia abajo
+    cabecera->tamano_directorio_slots = 0;
+    cabecera->necesita_compactacion = false;
+    cabecera->pista_slot_libre = 0;
+    RecalcularEspacioLibre();
+}
+
+// ===== OPERACIONES SOBRE REGISTROS =====
+
+Status PaginaRanurada::Insertar(const Byte* registro, uint32_t longitud, uint32_t& slot) {
+    if (registro == nullptr || longitud == 0 || longitud > UINT16_MAX) {
+        return Status::INVALID_ARGUMENT;
+    }
+    CabeceraBloqueDatos* cabecera = Cabecera();
+    slot = BuscarSlotLibre();
+    bool slot_nuevo = (slot == NumeroSlots());
+    if (slot_nuevo && NumeroSlots() >= MAX_SLOTS_POR_PAGINA) {
+        return Status::OUT_OF_SPACE_FOR_UPDATE;
+    }
+    uint32_t necesario = longitud + (slot_nuevo ? sizeof(EntradaSlot) : 0);
+    if (HuecoContiguo() < necesario) {
+        if (HuecoContiguo() + cabecera->fragmentacion_interna < necesario) {
+            return Status::OUT_OF_SPACE_FOR_UPDATE;
+        }
+        Reorganizar(false);
+    }
+
+    uint32_t offset = cabecera->offset_espacio_libre;
+    std::memcpy(datos_ + offset, registro, longitud);
+    cabecera->offset_espacio_libre += longitud;
+    if (slot_nuevo) {
+        cabecera->tamano_directorio_slots++;
+        cabecera->offset_directorio_slots -= sizeof(EntradaSlot);
+    }
+    EntradaSlot* entrada = Slot(slot);
+    entrada->offset = static_cast<uint16_t>(offset);
+    entrada->longitud = static_cast<uint16_t>(longitud);
+    cabecera->numero_registros_activos++;
+    cabecera->pista_slot_libre = static_cast<uint16_t>(slot + 1); // Era el primer slot libre
+    RecalcularEspacioLibre();
+    return Status::OK;
+}
+
+bool PaginaRanurada::Obtener(uint32_t slot, const Byte*& registro, uint32_t& longitud) const {
+    if (slot >= NumeroSlots()) {
+        return false;
+    }
+    const EntradaSlot* entrada = Slot(slot);
+    if (entrada->offset == 0 || entrada->offset + entrada->longitud > Cabecera()->offset_espacio_libre) {
+        return false;
+    }
+    registro = datos_ + entrada->offset;
+    longitud = entrada->longitud;
+    return true;
+}
+
+Status PaginaRanurada::Eliminar(uint32_t slot) {
+    if (slot >= NumeroSlots() || Slot(slot)->offset == 0) {
+        return Status::NOT_FOUND;
+    }
+    CabeceraBloqueDatos* cabecera = Cabecera();
+    EntradaSlot* entrada = Slot(slot);
+    if (entrada->offset + entrada->longitud == cabecera->offset_espacio_libre) {
+        cabecera->offset_espacio_libre = entrada->offset; // Era el último: se recupera directamente
+    } else {
+        cabecera->fragmentacion_interna += entrada->longitud;
+        cabecera->necesita_compactacion = true;
+    }
+    entrada->offset = 0;
+    entrada->longitud = 0;
+    cabecera->numero_registros_activos--;
+    cabecera->numero_registros_eliminados++;
+    cabecera->pista_slot_libre = static_cast<uint16_t>(std::min<uint32_t>(cabecera->pista_slot_libre, slot));
+    RecalcularEspacioLibre();
+    return Status::OK;
+}
+
+Status PaginaRanurada::Actualizar(uint32_t slot, const Byte* registro, uint32_t longitud) {
+    if (registro == nullptr || longitud == 0 || longitud > UINT16_MAX) {
+        return Status::INVALID_ARGUMENT;
+    }
+    if (slot >= NumeroSlots() || Slot(slot)->offset == 0) {
+        return Status::NOT_FOUND;
+    }
+    CabeceraBloqueDatos* cabecera = Cabecera();
+    EntradaSlot* entrada = Slot(slot);
+    uint32_t longitud_actual = entrada->longitud;
+
+    if (longitud <= longitud_actual) {
+        std::memcpy(datos_ + entrada->offset, registro, longitud);
+        cabecera->fragmentacion_interna += longitud_actual - longitud;
+        entrada->longitud = static_cast<uint16_t>(longitud);
+        cabecera->necesita_compactacion = cabecera->fragmentacion_interna > 0;
+        RecalcularEspacioLibre();
+        return Status::OK;
+    }
+
+    // Más largo: el hueco antiguo pasa a ser fragmentación y el registro se reubica
+    if (HuecoContiguo() + cabecera->fragmentacion_interna + longitud_actual < longitud) {
+        return Status::OUT_OF_SPACE_FOR_UPDATE;
+    }
+    entrada->offset = 0;
+    entrada->longitud = 0;
+    cabecera->fragmentacion_interna += longitud_actual;
+    if (HuecoContiguo() < longitud) {
+        Reorganizar(false); // No recortar: el slot libre es el que se está actualizando
+    }
+    uint32_t offset = cabecera->offset_espacio_libre;
+    std::memcpy(datos_ + offset, registro, longitud);
+    cabecera->offset_espacio_libre += longitud;
+    entrada = Slot(slot);
+    entrada->offset = static_cast<uint16_t>(offset);
+    entrada->longitud = static_cast<uint16_t>(longitud);
+    cabecera->necesita_compactacion = cabecera->fragmentacion_interna > 0;
+    RecalcularEspacioLibre();
+    return Status::OK;
+}
+
+void PaginaRanurada::Compactar() {
+    Reorganizar(true);
+}
+
+// ===== AUXILIARES PRIVADOS =====
+
+void PaginaRanurada::Reorganizar(bool recortar_directorio) {
+    CabeceraBloqueDatos* cabecera = Cabecera();
+
+    // Mover los registros en orden de offset: el destino nunca pisa un registro pendiente
+    std::vector<uint32_t> ocupados;
+    ocupados.reserve(cabecera->numero_registros_activos);
+    for (uint32_t i = 0; i < NumeroSlots(); ++i) {
+        if (Slot(i)->offset != 0) {
+            ocupados.push_back(i);
+        }
+    }
+    std::sort(ocupados.begin(), ocupados.end(), [this](uint32_t a, uint32_t b) {
+        return Slot(a)->offset < Slot(b)->offset;
+    });
+
+    uint32_t escritura = INICIO_REGISTROS;
+    for (uint32_t i : ocupados) {
+        EntradaSlot* entrada = Slot(i);
+        if (entrada->offset != escritura) {
+            std::memmove(datos_ + escritura, datos_ + entrada->offset, entrada->longitud);
+            entrada->offset = static_cast<uint16_t>(escritura);
+        }
+        escritura += entrada->longitud;
+    }
+    cabecera->offset_espacio_libre = escritura;
+    cabecera->fragmentacion_interna = 0;
+    cabecera->numero_registros_eliminados = 0;
+    cabecera->necesita_compactacion = false;
+
+    if (recortar_directorio) {
+        while (cabecera->tamano_directorio_slots > 0 && Slot(cabecera->tamano_directorio_slots - 1)->offset == 0) {
+            cabecera->tamano_directorio_slots--;
+            cabecera->offset_directorio_slots += sizeof(EntradaSlot);
+        }
+        cabecera->pista_slot_libre = static_cast<uint16_t>(
+            std::min<uint32_t>(cabecera->pista_slot_libre, cabecera->tamano_directorio_slots));
+    }
+    RecalcularEspacioLibre();
+}
+
+uint32_t PaginaRanurada::BuscarSlotLibre() const {
+    // La pista es una cota inferior: el resultado es el mismo que recorriendo desde 0
+    // (la recuperación del WAL depende de ello), pero llenar una página ya no es O(n²)
+    for (uint32_t i = Cabecera()->pista_slot_libre; i < NumeroSlots(); ++i) {
+        if (Slot(i)->offset == 0) {
+            return i;
+        }
+    }
+    return NumeroSlots();
+}
+
+void PaginaRanurada::RecalcularEspacioLibre() {
+    CabeceraBloqueDatos* cabecera = Cabecera();
+    uint32_t disponible = HuecoContiguo() + cabecera->fragmentacion_interna;
+    if (BuscarSlotLibre() == NumeroSlots()) {
+        // Un registro nuevo necesitará además su entrada en el directorio
+        disponible = (NumeroSlots() >= MAX_SLOTS_POR_PAGINA || disponible < sizeof(EntradaSlot))
+                         ? 0 : disponible - static_cast<uint32_t>(sizeof(EntradaSlot));
+    }
+    cabecera->espacio_libre_total = disponible;
+    uint32_t capacidad = BLOCK_SIZE - INICIO_REGISTROS;
+    cabecera->factor_carga_porcentaje = 100 - (HuecoContiguo() + cabecera->fragmentacion_interna) * 100 / capacidad;
+}
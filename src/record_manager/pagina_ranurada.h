@@ -0,0 +1,102 @@
+// record_manager/pagina_ranurada.h - Página de datos con directorio de slots
+// Los registros se localizan por número de slot, que no cambia al compactar
+
+#ifndef PAGINA_RANURADA_H
+#define PAGINA_RANURADA_H
+
+#include "../include/common.h"
+#include "../data_storage/cabeceras_bloques.h"
+
+/**
+ * @brief Vista de una página de datos (slotted page) sobre los bytes de un frame anclado.
+ *
+ * DISPOSICIÓN:
+ *   [CabeceraComun][CabeceraBloqueDatos][registros →  ...hueco...  ← directorio de slots]
+ *
+ * - Un registro queda identificado por su slot: compactar mueve los bytes y
+ *   reescribe los offsets del directorio, pero el número de slot se conserva.
+ * - Eliminar libera el slot (offset 0) y deja sus bytes como fragmentación; un
+ *   slot libre se reutiliza en la siguiente inserción. La cabecera guarda una
+ *   pista (pista_slot_libre) desde la que buscarlo, así que insertar es O(1)
+ *   amortizado en lugar de recorrer el directorio entero.
+ * - Si el hueco contiguo no basta pero sí con la fragmentación, Insertar() y
+ *   Actualizar() compactan la página antes de escribir.
+ *
+ * No es propietaria de los datos: quien la usa debe mantener la página anclada
+ * y marcarla como sucia al desanclarla si ha llamado a un método modificador.
+ */
+class PaginaRanurada {
+public:
+    static constexpr uint32_t INICIO_REGISTROS = sizeof(CabeceraComun) + sizeof(CabeceraBloqueDatos);
+
+    explicit PaginaRanurada(Byte* datos_pagina) : datos_(datos_pagina) {}
+
+    /**
+     * @brief Inicializa las cabeceras de una página de datos vacía.
+     * @param id_pagina ID de la página
+     */
+    void Inicializar(PageId id_pagina);
+
+    /**
+     * @brief Inserta un registro en un slot libre o en uno nuevo.
+     * @param registro Bytes del registro
+     * @param longitud Longitud del registro
+     * @param slot [out] Slot asignado
+     * @return Status::OUT_OF_SPACE_FOR_UPDATE si no cabe ni compactando
+     */
+    Status Insertar(const Byte* registro, uint32_t longitud, uint32_t& slot);
+
+    /**
+     * @brief Localiza un registro.
+     * @return false si el slot no existe o está libre
+     */
+    bool Obtener(uint32_t slot, const Byte*& registro, uint32_t& longitud) const;
+
+    /**
+     * @brief Libera el slot de un registro.
+     * @return Status::NOT_FOUND si el slot no existe o ya estaba libre
+     */
+    Status Eliminar(uint32_t slot);
+
+    /**
+     * @brief Reemplaza un registro conservando su slot. Si el nuevo es más largo
+     *        se reubica dentro de la página.
+     * @return Status::OUT_OF_SPACE_FOR_UPDATE si no cabe en la página
+     */
+    Status Actualizar(uint32_t slot, const Byte* registro, uint32_t longitud);
+
+    /**
+     * @brief Junta los registros al principio de la zona de datos y recorta los
+     *        slots libres del final del directorio.
+     */
+    void Compactar();
+
+    uint32_t NumeroSlots() const { return Cabecera()->tamano_directorio_slots; }
+    uint32_t EspacioLibre() const { return Cabecera()->espacio_libre_total; }
+    bool EsPaginaDatos() const { return reinterpret_cast<const CabeceraComun*>(datos_)->tipo_pagina == PageType::DATA_PAGE; }
+
+    CabeceraBloqueDatos* Cabecera() { return reinterpret_cast<CabeceraBloqueDatos*>(datos_ + sizeof(CabeceraComun)); }
+    const CabeceraBloqueDatos* Cabecera() const { return reinterpret_cast<const CabeceraBloqueDatos*>(datos_ + sizeof(CabeceraComun)); }
+
+private:
+    Byte* datos_;
+
+    EntradaSlot* Slot(uint32_t slot) {
+        return reinterpret_cast<EntradaSlot*>(datos_ + BLOCK_SIZE - (slot + 1) * sizeof(EntradaSlot));
+    }
+    const EntradaSlot* Slot(uint32_t slot) const {
+        return reinterpret_cast<const EntradaSlot*>(datos_ + BLOCK_SIZE - (slot + 1) * sizeof(EntradaSlot));
+    }
+
+    uint32_t HuecoContiguo() const { return Cabecera()->offset_directorio_slots - Cabecera()->offset_espacio_libre; }
+    uint32_t BuscarSlotLibre() const;
+    void RecalcularEspacioLibre();
+
+    /**
+     * @brief Compacta la zona de registros; si recortar_directorio, quita también los
+     *        slots libres del final (nunca mientras se reubica un registro).
+     */
+    void Reorganizar(bool recortar_directorio);
+};
+
+#endif // PAGINA_RANURADA_H
@@ -0,0 +1,79 @@
+// test_formato_registro.cpp - Archivo de prueba para el formato binario de registros
+// Regresión: el texto "NULL" en una columna NOT NULL se escribía fuera del buffer
+
+#include "formato_registro.h"
+#include <iostream>
+#include <cassert>
+
+/**
+ * Verifica que el tamaño calculado y los bytes escritos coinciden cuando una
+ * columna VARCHAR NOT NULL contiene literalmente el texto "NULL"
+ */
+void PruebaTextoNuloEnColumnaNoNula() {
+    std::cout << "\n=== PRUEBA: TEXTO \"NULL\" EN COLUMNA NOT NULL ===" << std::endl;
+
+    try {
+        std::vector<ColumnMetadata> columnas = {
+            ColumnMetadata("id", ColumnType::INT, 0, true, false),
+            ColumnMetadata("nombre", ColumnType::VARCHAR, 20, false, false),
+            ColumnMetadata("apodo", ColumnType::VARCHAR, 20, false, true)
+        };
+        DisposicionRegistro disposicion(columnas);
+
+        std::vector<Byte> salida;
+        Status estado = disposicion.Codificar({"7", DisposicionRegistro::VALOR_NULO, "Pepe"}, salida);
+        assert(estado == Status::OK);
+
+        VistaRegistro vista(salida.data(), static_cast<uint32_t>(salida.size()), disposicion);
+        assert(vista.EsValida());
+        assert(vista.ObtenerLongitud() == salida.size());
+        assert(!vista.EsNulo(1));
+        assert(vista.ObtenerTexto(1) == "NULL");
+        assert(vista.ObtenerTexto(2) == "Pepe");
+
+        std::cout << "✓ \"NULL\" se guarda como texto en una columna NOT NULL" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en la prueba: " << e.what() << std::endl;
+        assert(false);
+    }
+}
+
+/**
+ * Verifica que VALOR_NULO sí marca el bit de nulo en una columna que lo admite
+ * y que el registro no reserva datos para ella
+ */
+void PruebaValorNuloEnColumnaNullable() {
+    std::cout << "\n=== PRUEBA: VALOR NULO EN COLUMNA NULLABLE ===" << std::endl;
+
+    try {
+        std::vector<ColumnMetadata> columnas = {
+            ColumnMetadata("id", ColumnType::INT, 0, true, false),
+            ColumnMetadata("nombre", ColumnType::VARCHAR, 20, false, false),
+            ColumnMetadata("apodo", ColumnType::VARCHAR, 20, false, true)
+        };
+        DisposicionRegistro disposicion(columnas);
+
+        std::vector<Byte> salida;
+        Status estado = disposicion.Codificar({"8", "Ana", DisposicionRegistro::VALOR_NULO}, salida);
+        assert(estado == Status::OK);
+        assert(salida.size() == disposicion.OffsetDatosVariables() + 3);
+
+        VistaRegistro vista(salida.data(), static_cast<uint32_t>(salida.size()), disposicion);
+        assert(vista.EsValida());
+        assert(!vista.EsNulo(1));
+        assert(vista.EsNulo(2));
+        assert(vista.ObtenerComoTexto(2) == DisposicionRegistro::VALOR_NULO);
+
+        std::cout << "✓ VALOR_NULO se codifica como nulo sin datos variables" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en la prueba: " << e.what() << std::endl;
+        assert(false);
+    }
+}
+
+int main() {
+    PruebaTextoNuloEnColumnaNoNula();
+    PruebaValorNuloEnColumnaNullable();
+    std::cout << "\n=== PRUEBAS DEL FORMATO DE REGISTRO COMPLETADAS ===" << std::endl;
+    return 0;
+}
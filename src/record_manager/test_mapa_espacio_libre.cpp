@@ -0,0 +1,76 @@
+// test_mapa_espacio_libre.cpp - Archivo de prueba para el MapaEspacioLibre
+// Regresión: una inserción mayor que la última categoría recibía siempre la misma página
+
+#include "mapa_espacio_libre.h"
+#include "../data_storage/gestor_disco.h"
+#include "../data_storage/gestor_buffer.h"
+#include "../replacement_policies/lru_espanol.h"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+/**
+ * Simula el bucle de inserción con un registro que no cabe en ninguna categoría
+ * completa: cada candidata que no sirve se corrige y no debe volver a proponerse
+ */
+void PruebaBusquedaRegistroGrande() {
+    std::cout << "\n=== PRUEBA: BÚSQUEDA DE ESPACIO PARA UN REGISTRO GRANDE ===" << std::endl;
+
+    fs::path ruta = fs::temp_directory_path() / "test_mapa_espacio_libre";
+    std::error_code error;
+    fs::remove_all(ruta, error);
+    fs::create_directories(ruta, error);
+
+    try {
+        auto disco = std::make_shared<GestorDisco>(ruta.string(), "fsm", 1, 1, 16, 16, BLOCK_SIZE);
+        disco->EstablecerModoRegistroAcceso(ModoRegistroAcceso::DESACTIVADO);
+        Status estado = disco->Inicializar();
+        assert(estado == Status::OK);
+        GestorBuffer buffer(disco, 16, BLOCK_SIZE, std::make_unique<PoliticaLRU>());
+
+        MapaEspacioLibre mapa(buffer);
+        estado = mapa.Inicializar();
+        assert(estado == Status::OK);
+
+        const uint32_t tamaño_registro = (MapaEspacioLibre::NUM_CATEGORIAS - 1) * MapaEspacioLibre::TAMAÑO_CATEGORIA + 100;
+        const PageId pagina_pequeña = 100;
+        const PageId pagina_justa = 101;
+
+        // Ambas caen en la última categoría, pero solo una tiene sitio de verdad
+        estado = mapa.RegistrarPagina(pagina_pequeña, tamaño_registro - 50);
+        assert(estado == Status::OK);
+        assert(mapa.BuscarPaginaConEspacio(tamaño_registro) == INVALID_PAGE_ID);
+        std::cout << "✓ Una página de la última categoría sin sitio suficiente no se propone" << std::endl;
+
+        estado = mapa.RegistrarPagina(pagina_justa, tamaño_registro + 10);
+        assert(estado == Status::OK);
+        assert(mapa.BuscarPaginaConEspacio(tamaño_registro) == pagina_justa);
+        std::cout << "✓ Se propone la página cuyo espacio conocido basta" << std::endl;
+
+        // Quien inserta descubre que no cabía (p. ej. por la cabecera del slot): el bucle termina
+        uint32_t intentos = 0;
+        PageId candidata = mapa.BuscarPaginaConEspacio(tamaño_registro);
+        while (candidata != INVALID_PAGE_ID) {
+            ++intentos;
+            assert(intentos <= mapa.ObtenerNumeroPaginas());
+            estado = mapa.Actualizar(candidata, tamaño_registro - 1);
+            assert(estado == Status::OK);
+            candidata = mapa.BuscarPaginaConEspacio(tamaño_registro);
+        }
+        assert(intentos == 1);
+        std::cout << "✓ Una candidata corregida no vuelve a proponerse: la búsqueda termina" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en la prueba: " << e.what() << std::endl;
+        assert(false);
+    }
+
+    fs::remove_all(ruta, error);
+}
+
+int main() {
+    PruebaBusquedaRegistroGrande();
+    std::cout << "\n=== PRUEBAS DEL MAPA DE ESPACIO LIBRE COMPLETADAS ===" << std::endl;
+    return 0;
+}
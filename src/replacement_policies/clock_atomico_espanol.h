@@ -0,0 +1,237 @@
+// replacement_policies/clock_atomico_espanol.h - Política CLOCK sin bloqueos en Español
+// Variante del algoritmo de reloj con bits de referencia atómicos
+
+#ifndef CLOCK_ATOMICO_ESPANOL_H
+#define CLOCK_ATOMICO_ESPANOL_H
+
+#include "ipolitica_reemplazo.h"
+#include "../include/metricas.h"
+#include <atomic>
+#include <memory>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+
+/**
+ * @brief Implementación de CLOCK cuyo estado son arreglos atómicos indexados por FrameId
+ * * A diferencia de PoliticaClock no hay mapa FrameId → posición: la posición en el
+ * reloj es el propio FrameId. Acceder() solo escribe el bit de referencia con un
+ * store atómico, así que el GestorBuffer puede registrar aciertos de caché desde
+ * varios hilos sin tomar el mutex de la política (EsSeguraEntreHilos() == true).
+ * * ESTRUCTURA DE DATOS:
+ * - presente_[f]: el frame f está gestionado por la política
+ * - referencia_[f]: bit de referencia del algoritmo CLOCK
+ * - anclado_[f]: el frame no puede ser desalojado
+ * - Manecilla atómica que avanza con fetch_add
+ * * COMPLEJIDAD:
+ * - Acceder, AgregarFrame, RemoverFrame: O(1), sin bloqueos (Acceder no escribe
+ *   ninguna línea compartida salvo la del bit de referencia, si estaba a 0)
+ * - Desalojar: O(1) amortizado; como máximo dos vueltas de reloj
+ * * La capacidad se fija en el constructor o en Initialize() y no cambia después.
+ */
+class PoliticaClockAtomico : public IPoliticaReemplazo {
+private:
+    uint32_t capacidad_;
+    std::unique_ptr<std::atomic<bool>[]> presente_;
+    std::unique_ptr<std::atomic<bool>[]> referencia_;
+    std::unique_ptr<std::atomic<bool>[]> anclado_;
+    std::atomic<uint64_t> manecilla_{0};
+    std::atomic<uint32_t> frames_presentes_{0};
+
+    // Estadísticas de la política (relajadas: solo informativas). Los accesos se
+    // cuentan por fragmentos de hilo: un único contador compartido volvería a poner
+    // una línea de caché disputada en cada acierto del buffer
+    struct EstadisticasClockAtomico {
+        ContadorMetrica total_accesos;
+        std::atomic<uint64_t> total_desalojos{0};
+        std::atomic<uint64_t> bits_referencia_limpiados{0};
+        std::atomic<uint64_t> frames_agregados{0};
+        std::atomic<uint64_t> frames_removidos{0};
+    } estadisticas_;
+
+    void ReservarArreglos(uint32_t capacidad) {
+        capacidad_ = capacidad;
+        presente_ = std::make_unique<std::atomic<bool>[]>(capacidad_);
+        referencia_ = std::make_unique<std::atomic<bool>[]>(capacidad_);
+        anclado_ = std::make_unique<std::atomic<bool>[]>(capacidad_);
+        for (uint32_t i = 0; i < capacidad_; ++i) {
+            presente_[i].store(false, std::memory_order_relaxed);
+            referencia_[i].store(false, std::memory_order_relaxed);
+            anclado_[i].store(false, std::memory_order_relaxed);
+        }
+        manecilla_.store(0);
+        frames_presentes_.store(0);
+    }
+
+    bool EnRango(FrameId id_frame) const {
+        return id_frame < capacidad_;
+    }
+
+public:
+    /**
+     * @brief Constructor de la política CLOCK atómica
+     * @param capacidad Número de frames del pool (0 = se fija en Initialize)
+     */
+    explicit PoliticaClockAtomico(uint32_t capacidad = 0) : capacidad_(0) {
+        ReservarArreglos(capacidad);
+        std::cout << "Política CLOCK atómica inicializada con capacidad: " << capacidad_ << std::endl;
+    }
+
+    /**
+     * @brief Destructor de la política CLOCK atómica
+     */
+    ~PoliticaClockAtomico() override {
+        std::cout << "Política CLOCK atómica destruida. Estadísticas finales:" << std::endl;
+        std::cout << ObtenerEstadisticas() << std::endl;
+    }
+
+    /**
+     * @brief Fija la capacidad. Solo debe llamarse antes de agregar frames.
+     * @param pool_size Tamaño del buffer pool
+     */
+    void Initialize(uint32_t pool_size) override {
+        if (pool_size != capacidad_ && frames_presentes_.load() == 0) {
+            ReservarArreglos(pool_size);
+        }
+    }
+
+    bool EsSeguraEntreHilos() const override {
+        return true;
+    }
+
+    void Anclar(FrameId id_frame) override {
+        if (!EnRango(id_frame)) return;
+        anclado_[id_frame].store(true, std::memory_order_release);
+        referencia_[id_frame].store(true, std::memory_order_relaxed);
+    }
+
+    void Desanclar(FrameId id_frame) override {
+        if (!EnRango(id_frame)) return;
+        anclado_[id_frame].store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief Registra el acceso a un frame (un único store atómico)
+     * @param id_frame ID del frame accedido
+     */
+    void Acceder(FrameId id_frame) override {
+        if (!EnRango(id_frame)) return;
+        estadisticas_.total_accesos.Sumar();
+        // Evitar invalidar la línea de caché si el bit ya está puesto
+        if (!referencia_[id_frame].load(std::memory_order_relaxed)) {
+            referencia_[id_frame].store(true, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief La manecilla ya avanzó sobre el candidato: no hace falta marcarlo
+     * @param id_frame ID del frame a posponer
+     */
+    void Posponer(FrameId id_frame) override {
+        (void)id_frame;
+    }
+
+    /**
+     * @brief Selecciona un frame para desalojar según el algoritmo CLOCK
+     * @return FrameId del frame a desalojar, o INVALID_FRAME_ID si no hay ninguno disponible
+     */
+    FrameId Desalojar() override {
+        if (capacidad_ == 0 || frames_presentes_.load(std::memory_order_relaxed) == 0) {
+            return INVALID_FRAME_ID;
+        }
+        // Dos vueltas: la primera puede limpiar todos los bits de referencia
+        const uint64_t max_pasos = static_cast<uint64_t>(capacidad_) * 2;
+        for (uint64_t paso = 0; paso < max_pasos; ++paso) {
+            FrameId posicion = static_cast<FrameId>(manecilla_.fetch_add(1, std::memory_order_relaxed) % capacidad_);
+            if (!presente_[posicion].load(std::memory_order_acquire) ||
+                anclado_[posicion].load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (referencia_[posicion].exchange(false, std::memory_order_acq_rel)) {
+                estadisticas_.bits_referencia_limpiados.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            estadisticas_.total_desalojos.fetch_add(1, std::memory_order_relaxed);
+            return posicion;
+        }
+        return INVALID_FRAME_ID;
+    }
+
+    void AgregarFrame(FrameId id_frame) override {
+        if (!EnRango(id_frame)) {
+            std::cerr << "Error: Frame fuera de la capacidad del reloj atómico: " << id_frame << std::endl;
+            return;
+        }
+        referencia_[id_frame].store(true, std::memory_order_relaxed);
+        if (!presente_[id_frame].exchange(true, std::memory_order_acq_rel)) {
+            frames_presentes_.fetch_add(1, std::memory_order_relaxed);
+            estadisticas_.frames_agregados.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Agrega un frame con el bit de referencia a 0
+     * @param id_frame ID del frame a agregar
+     */
+    void AgregarFrameBajaPrioridad(FrameId id_frame) override {
+        AgregarFrame(id_frame);
+        if (EnRango(id_frame)) {
+            referencia_[id_frame].store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void RemoverFrame(FrameId id_frame) override {
+        if (!EnRango(id_frame)) return;
+        if (presente_[id_frame].exchange(false, std::memory_order_acq_rel)) {
+            frames_presentes_.fetch_sub(1, std::memory_order_relaxed);
+            estadisticas_.frames_removidos.fetch_add(1, std::memory_order_relaxed);
+        }
+        referencia_[id_frame].store(false, std::memory_order_relaxed);
+        anclado_[id_frame].store(false, std::memory_order_relaxed);
+    }
+
+    void Reiniciar() override {
+        ReservarArreglos(capacidad_);
+        estadisticas_.total_accesos.Reiniciar();
+        estadisticas_.total_desalojos = 0;
+        estadisticas_.bits_referencia_limpiados = 0;
+        estadisticas_.frames_agregados = 0;
+        estadisticas_.frames_removidos = 0;
+        std::cout << "Política CLOCK atómica reiniciada correctamente." << std::endl;
+    }
+
+    std::string ObtenerNombre() const override {
+        return "CLOCK Atómico (sin bloqueos)";
+    }
+
+    std::string ObtenerEstadisticas() const override {
+        std::ostringstream ss;
+        ss << "\n=== ESTADÍSTICAS POLÍTICA CLOCK ATÓMICA ===\n";
+        ss << "Total de accesos: " << estadisticas_.total_accesos.Valor() << "\n";
+        ss << "Total de desalojos: " << estadisticas_.total_desalojos.load() << "\n";
+        ss << "Bits de referencia limpiados: " << estadisticas_.bits_referencia_limpiados.load() << "\n";
+        ss << "Frames agregados: " << estadisticas_.frames_agregados.load() << "\n";
+        ss << "Frames removidos: " << estadisticas_.frames_removidos.load() << "\n";
+        ss << "Frames presentes: " << frames_presentes_.load() << "/" << capacidad_ << "\n";
+        ss << "Posición actual de la manecilla: " << (capacidad_ ? manecilla_.load() % capacidad_ : 0) << "\n";
+        return ss.str();
+    }
+
+    bool PuedeSerDesalojado(FrameId id_frame) const override {
+        return EnRango(id_frame) && presente_[id_frame].load() && !anclado_[id_frame].load();
+    }
+
+    uint32_t ObtenerNumeroFrames() const override {
+        return frames_presentes_.load();
+    }
+
+    Status ValidarConsistencia() const override {
+        uint32_t contador = 0;
+        for (uint32_t i = 0; i < capacidad_; ++i) {
+            if (presente_[i].load()) contador++;
+        }
+        return (contador == frames_presentes_.load()) ? Status::OK : Status::ERROR;
+    }
+};
+
+#endif // CLOCK_ATOMICO_ESPANOL_H
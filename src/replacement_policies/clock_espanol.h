@@ -131,6 +131,17 @@ public:
         std::cout << ObtenerEstadisticas() << std::endl;
     }
     
+    /**
+     * @brief Ajusta el tamaño del reloj al del buffer pool si este es mayor
+     * @param pool_size Tamaño del buffer pool
+     */
+    void Initialize(uint32_t pool_size) override {
+        if (pool_size > tamaño_maximo_) {
+            tamaño_maximo_ = pool_size;
+            reloj_.resize(tamaño_maximo_);
+        }
+    }
+    
     /**
      * @brief Ancla un frame, impidiendo que sea desalojado
      * @param id_frame ID del frame a anclar
@@ -263,6 +274,20 @@ public:
         estadisticas_.frames_agregados++;
     }
     
+    /**
+     * @brief Agrega un frame con el bit de referencia a 0
+     * El reloj lo desalojará en su primera pasada salvo que se acceda antes.
+     * @param id_frame ID del frame a agregar
+     */
+    void AgregarFrameBajaPrioridad(FrameId id_frame) override {
+        AgregarFrame(id_frame);
+        auto it = mapa_posiciones_.find(id_frame);
+        if (it != mapa_posiciones_.end()) {
+            reloj_[it->second].bit_referencia = false;
+            reloj_[it->second].contador_accesos = 0;
+        }
+    }
+    
     /**
      * @brief Remueve un frame de la política
      * @param id_frame ID del frame a remover
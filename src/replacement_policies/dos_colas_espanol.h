@@ -0,0 +1,487 @@
+// replacement_policies/dos_colas_espanol.h - Política de Reemplazo 2Q en Español
+// 2Q completo (Johnson y Shasha): A1in, A1out y Am; resistente a recorridos secuenciales
+
+#ifndef DOS_COLAS_ESPANOL_H
+#define DOS_COLAS_ESPANOL_H
+
+#include "ipolitica_reemplazo.h"
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+
+/**
+ * @brief Implementación de la política de reemplazo 2Q (dos colas)
+ * * Una página leída por primera vez entra en la cola A1in (FIFO). Las referencias
+ * mientras sigue en A1in no la promocionan: suelen ser accesos correlacionados del
+ * mismo recorrido. Al desalojarla de A1in se recuerda su BlockId en A1out, una cola
+ * fantasma sin datos. Solo si se vuelve a leer mientras está en A1out entra en Am
+ * (LRU), que contiene el conjunto de trabajo. Así un recorrido secuencial no
+ * desplaza a las páginas calientes de Am.
+ * * ESTRUCTURA DE DATOS:
+ * - A1in y Am: listas doblemente enlazadas intrusivas sobre vectores indexados por
+ *   FrameId (sin reservas de memoria por acceso)
+ * - A1out: lista de BlockIds con índice hash, limitada a proporcion_a1out del pool
+ * - Bloque de cada frame (AsignarBloque) y vector de frames anclados
+ * * CRITERIO DE DESALOJO:
+ * - Si A1in supera su cuota (proporcion_a1 del pool) se desaloja la cabeza de A1in
+ * - En otro caso se desaloja el menos recientemente usado de Am (o de A1in si Am está vacía)
+ * * COMPLEJIDAD:
+ * - Acceder, AgregarFrame, RemoverFrame: O(1)
+ * - Desalojar: O(1) salvo frames anclados
+ */
+class PoliticaDosColas : public IPoliticaReemplazo {
+private:
+    static constexpr uint32_t SIN_ENLACE = UINT32_MAX;
+
+    enum class Cola : uint8_t {
+        NINGUNA = 0,
+        A1,     // A1in: primera referencia (FIFO)
+        AM      // Referenciados más de una vez (LRU)
+    };
+
+    /**
+     * @brief Lista doblemente enlazada cuyos nodos son los propios FrameId
+     * La cabeza es el extremo de desalojo; la cola, el de inserción.
+     */
+    struct ListaFrames {
+        FrameId cabeza = SIN_ENLACE;
+        FrameId cola = SIN_ENLACE;
+        uint32_t tamaño = 0;
+    };
+
+    std::vector<FrameId> anterior_;
+    std::vector<FrameId> siguiente_;
+    std::vector<Cola> cola_frame_;
+    std::vector<bool> anclado_;
+    std::vector<BlockId> bloque_frame_;
+    std::vector<bool> precargado_;      // Agregado por lectura anticipada, aún sin referencias
+
+    ListaFrames a1_;
+    ListaFrames am_;
+
+    // A1out: BlockIds desalojados de A1in, del más antiguo (frente) al más reciente
+    std::list<BlockId> a1out_;
+    std::unordered_map<BlockId, std::list<BlockId>::iterator> posicion_a1out_;
+
+    FrameId candidato_desalojo_ = INVALID_FRAME_ID; // Último devuelto por Desalojar()
+
+    uint32_t capacidad_;
+    double proporcion_a1_;
+    double proporcion_a1out_;
+
+    // Estadísticas de la política
+    struct EstadisticasDosColas {
+        uint64_t total_accesos = 0;
+        uint64_t total_desalojos = 0;
+        uint64_t desalojos_a1 = 0;
+        uint64_t desalojos_am = 0;
+        uint64_t promociones_a_am = 0;  // Relecturas de páginas recordadas en A1out
+        uint64_t total_anclajes = 0;
+        uint64_t total_desanclajes = 0;
+        uint64_t frames_agregados = 0;
+        uint64_t frames_removidos = 0;
+    } estadisticas_;
+
+    ListaFrames& ObtenerLista(Cola cola) {
+        return (cola == Cola::A1) ? a1_ : am_;
+    }
+
+    /**
+     * @brief Asegura que los vectores pueden indexar el frame dado
+     */
+    void AsegurarCapacidad(FrameId id_frame) {
+        if (id_frame >= cola_frame_.size()) {
+            size_t nuevo_tamaño = static_cast<size_t>(id_frame) + 1;
+            anterior_.resize(nuevo_tamaño, SIN_ENLACE);
+            siguiente_.resize(nuevo_tamaño, SIN_ENLACE);
+            cola_frame_.resize(nuevo_tamaño, Cola::NINGUNA);
+            anclado_.resize(nuevo_tamaño, false);
+            bloque_frame_.resize(nuevo_tamaño, INVALID_PAGE_ID);
+            precargado_.resize(nuevo_tamaño, false);
+        }
+    }
+
+    uint32_t CuotaA1out() const {
+        return std::max<uint32_t>(1, static_cast<uint32_t>(capacidad_ * proporcion_a1out_));
+    }
+
+    /**
+     * @brief Recuerda en A1out un bloque desalojado de A1in, olvidando el más antiguo si no cabe
+     */
+    void RecordarDesalojado(BlockId id_bloque) {
+        if (id_bloque == INVALID_PAGE_ID || posicion_a1out_.count(id_bloque)) {
+            return;
+        }
+        while (a1out_.size() >= CuotaA1out()) {
+            posicion_a1out_.erase(a1out_.front());
+            a1out_.pop_front();
+        }
+        posicion_a1out_[id_bloque] = a1out_.insert(a1out_.end(), id_bloque);
+    }
+
+    /**
+     * @brief Retira un bloque de A1out
+     * @return true si estaba recordado
+     */
+    bool OlvidarDesalojado(BlockId id_bloque) {
+        auto it = posicion_a1out_.find(id_bloque);
+        if (it == posicion_a1out_.end()) {
+            return false;
+        }
+        a1out_.erase(it->second);
+        posicion_a1out_.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Inserta un frame en un extremo de la lista
+     * @param al_final true = extremo de inserción (más reciente), false = extremo de desalojo
+     */
+    void Insertar(Cola cola, FrameId id_frame, bool al_final) {
+        ListaFrames& lista = ObtenerLista(cola);
+        if (al_final) {
+            anterior_[id_frame] = lista.cola;
+            siguiente_[id_frame] = SIN_ENLACE;
+            if (lista.cola != SIN_ENLACE) siguiente_[lista.cola] = id_frame;
+            lista.cola = id_frame;
+            if (lista.cabeza == SIN_ENLACE) lista.cabeza = id_frame;
+        } else {
+            anterior_[id_frame] = SIN_ENLACE;
+            siguiente_[id_frame] = lista.cabeza;
+            if (lista.cabeza != SIN_ENLACE) anterior_[lista.cabeza] = id_frame;
+            lista.cabeza = id_frame;
+            if (lista.cola == SIN_ENLACE) lista.cola = id_frame;
+        }
+        cola_frame_[id_frame] = cola;
+        lista.tamaño++;
+    }
+
+    /**
+     * @brief Desenlaza un frame de la lista en la que esté
+     */
+    void Desenlazar(FrameId id_frame) {
+        ListaFrames& lista = ObtenerLista(cola_frame_[id_frame]);
+        FrameId ant = anterior_[id_frame];
+        FrameId sig = siguiente_[id_frame];
+        if (ant != SIN_ENLACE) siguiente_[ant] = sig; else lista.cabeza = sig;
+        if (sig != SIN_ENLACE) anterior_[sig] = ant; else lista.cola = ant;
+        anterior_[id_frame] = SIN_ENLACE;
+        siguiente_[id_frame] = SIN_ENLACE;
+        cola_frame_[id_frame] = Cola::NINGUNA;
+        lista.tamaño--;
+    }
+
+    /**
+     * @brief Primer frame no anclado desde el extremo de desalojo de una lista
+     */
+    FrameId BuscarVictima(const ListaFrames& lista) const {
+        for (FrameId actual = lista.cabeza; actual != SIN_ENLACE; actual = siguiente_[actual]) {
+            if (!anclado_[actual]) {
+                return actual;
+            }
+        }
+        return INVALID_FRAME_ID;
+    }
+
+    bool Contiene(FrameId id_frame) const {
+        return id_frame < cola_frame_.size() && cola_frame_[id_frame] != Cola::NINGUNA;
+    }
+
+public:
+    /**
+     * @brief Constructor de la política 2Q
+     * @param capacidad Número de frames del pool (se ajusta en Initialize)
+     * @param proporcion_a1 Fracción del pool reservada a la cola A1in (típicamente 0.25)
+     * @param proporcion_a1out BlockIds recordados en A1out, como fracción del pool (típicamente 0.5)
+     */
+    explicit PoliticaDosColas(uint32_t capacidad = 0, double proporcion_a1 = 0.25, double proporcion_a1out = 0.5)
+        : capacidad_(capacidad), proporcion_a1_(proporcion_a1), proporcion_a1out_(proporcion_a1out) {
+        if (capacidad_ > 0) {
+            AsegurarCapacidad(capacidad_ - 1);
+        }
+        std::cout << "Política 2Q inicializada correctamente." << std::endl;
+    }
+
+    /**
+     * @brief Destructor de la política 2Q
+     */
+    ~PoliticaDosColas() override {
+        std::cout << "Política 2Q destruida. Estadísticas finales:" << std::endl;
+        std::cout << ObtenerEstadisticas() << std::endl;
+    }
+
+    void Initialize(uint32_t pool_size) override {
+        capacidad_ = pool_size;
+        if (pool_size > 0) {
+            AsegurarCapacidad(pool_size - 1);
+        }
+    }
+
+    /**
+     * @brief Ancla un frame, impidiendo que sea desalojado
+     * @param id_frame ID del frame a anclar
+     */
+    void Anclar(FrameId id_frame) override {
+        AsegurarCapacidad(id_frame);
+        anclado_[id_frame] = true;
+        estadisticas_.total_anclajes++;
+    }
+
+    /**
+     * @brief Desancla un frame, permitiendo que pueda ser desalojado
+     * @param id_frame ID del frame a desanclar
+     */
+    void Desanclar(FrameId id_frame) override {
+        if (id_frame < anclado_.size()) {
+            anclado_[id_frame] = false;
+        }
+        estadisticas_.total_desanclajes++;
+    }
+
+    /**
+     * @brief Registra el acceso a un frame. En Am pasa a ser el más reciente; en A1in
+     * no cambia de sitio, salvo la primera referencia a una página precargada, que
+     * cuenta como su entrada real en el pool
+     * @param id_frame ID del frame accedido
+     */
+    void Acceder(FrameId id_frame) override {
+        estadisticas_.total_accesos++;
+        if (!Contiene(id_frame)) {
+            std::cerr << "Advertencia: Intento de acceder a frame inexistente: "
+                      << id_frame << std::endl;
+            return;
+        }
+        if (cola_frame_[id_frame] == Cola::AM) {
+            Desenlazar(id_frame);
+            Insertar(Cola::AM, id_frame, true);
+            return;
+        }
+        if (precargado_[id_frame]) {
+            precargado_[id_frame] = false;
+            Desenlazar(id_frame);
+            bool recordado = OlvidarDesalojado(bloque_frame_[id_frame]);
+            if (recordado) estadisticas_.promociones_a_am++;
+            Insertar(recordado ? Cola::AM : Cola::A1, id_frame, true);
+        }
+    }
+
+    /**
+     * @brief Guarda el bloque del frame, para recordarlo en A1out al desalojarlo
+     */
+    void AsignarBloque(FrameId id_frame, BlockId id_bloque) override {
+        AsegurarCapacidad(id_frame);
+        bloque_frame_[id_frame] = id_bloque;
+    }
+
+    /**
+     * @brief Aparta un candidato que no pudo desalojarse sin contarlo como referencia
+     * @param id_frame ID del frame a posponer
+     */
+    void Posponer(FrameId id_frame) override {
+        if (!Contiene(id_frame)) {
+            return;
+        }
+        Cola cola = cola_frame_[id_frame];
+        Desenlazar(id_frame);
+        Insertar(cola, id_frame, true);
+    }
+
+    /**
+     * @brief Selecciona un frame para desalojar según 2Q
+     * @return FrameId del frame a desalojar, o INVALID_FRAME_ID si no hay ninguno disponible
+     */
+    FrameId Desalojar() override {
+        uint32_t cuota_a1 = std::max<uint32_t>(1, static_cast<uint32_t>(capacidad_ * proporcion_a1_));
+
+        FrameId victima = INVALID_FRAME_ID;
+        if (a1_.tamaño > cuota_a1 || am_.tamaño == 0) {
+            victima = BuscarVictima(a1_);
+            if (victima == INVALID_FRAME_ID) victima = BuscarVictima(am_);
+        } else {
+            victima = BuscarVictima(am_);
+            if (victima == INVALID_FRAME_ID) victima = BuscarVictima(a1_);
+        }
+
+        candidato_desalojo_ = victima;
+        if (victima != INVALID_FRAME_ID) {
+            estadisticas_.total_desalojos++;
+            if (cola_frame_[victima] == Cola::A1) estadisticas_.desalojos_a1++;
+            else estadisticas_.desalojos_am++;
+        }
+        return victima;
+    }
+
+    /**
+     * @brief Agrega un nuevo frame a la política: al final de Am si su bloque está
+     * recordado en A1out, al final de A1in en otro caso
+     * @param id_frame ID del frame a agregar
+     */
+    void AgregarFrame(FrameId id_frame) override {
+        AsegurarCapacidad(id_frame);
+        if (Contiene(id_frame)) {
+            std::cerr << "Advertencia: Intento de agregar frame existente: "
+                      << id_frame << std::endl;
+            return;
+        }
+        precargado_[id_frame] = false;
+        bool recordado = OlvidarDesalojado(bloque_frame_[id_frame]);
+        if (recordado) estadisticas_.promociones_a_am++;
+        Insertar(recordado ? Cola::AM : Cola::A1, id_frame, true);
+        estadisticas_.frames_agregados++;
+    }
+
+    /**
+     * @brief Agrega un frame en la cabeza de A1in: primer candidato a desalojo.
+     * Una precarga no es una referencia: no consulta A1out hasta el primer acceso
+     * @param id_frame ID del frame a agregar
+     */
+    void AgregarFrameBajaPrioridad(FrameId id_frame) override {
+        AsegurarCapacidad(id_frame);
+        if (Contiene(id_frame)) {
+            std::cerr << "Advertencia: Intento de agregar frame existente: "
+                      << id_frame << std::endl;
+            return;
+        }
+        precargado_[id_frame] = true;
+        Insertar(Cola::A1, id_frame, false);
+        estadisticas_.frames_agregados++;
+    }
+
+    /**
+     * @brief Remueve un frame de la política. Si es la víctima que acaba de proponer
+     * Desalojar() y venía de A1in con alguna referencia, su bloque pasa a A1out
+     * @param id_frame ID del frame a remover
+     */
+    void RemoverFrame(FrameId id_frame) override {
+        if (!Contiene(id_frame)) {
+            std::cerr << "Advertencia: Intento de remover frame inexistente: "
+                      << id_frame << std::endl;
+            return;
+        }
+        if (id_frame == candidato_desalojo_ && cola_frame_[id_frame] == Cola::A1 && !precargado_[id_frame]) {
+            RecordarDesalojado(bloque_frame_[id_frame]);
+        }
+        if (id_frame == candidato_desalojo_) {
+            candidato_desalojo_ = INVALID_FRAME_ID;
+        }
+        Desenlazar(id_frame);
+        anclado_[id_frame] = false;
+        precargado_[id_frame] = false;
+        estadisticas_.frames_removidos++;
+    }
+
+    /**
+     * @brief Reinicia la política a su estado inicial
+     */
+    void Reiniciar() override {
+        std::fill(anterior_.begin(), anterior_.end(), SIN_ENLACE);
+        std::fill(siguiente_.begin(), siguiente_.end(), SIN_ENLACE);
+        std::fill(cola_frame_.begin(), cola_frame_.end(), Cola::NINGUNA);
+        std::fill(anclado_.begin(), anclado_.end(), false);
+        std::fill(bloque_frame_.begin(), bloque_frame_.end(), INVALID_PAGE_ID);
+        std::fill(precargado_.begin(), precargado_.end(), false);
+        a1_ = ListaFrames{};
+        am_ = ListaFrames{};
+        a1out_.clear();
+        posicion_a1out_.clear();
+        candidato_desalojo_ = INVALID_FRAME_ID;
+        estadisticas_ = EstadisticasDosColas{};
+
+        std::cout << "Política 2Q reiniciada correctamente." << std::endl;
+    }
+
+    /**
+     * @brief Obtiene el nombre de la política
+     * @return std::string nombre de la política
+     */
+    std::string ObtenerNombre() const override {
+        return "2Q (Dos Colas, resistente a recorridos)";
+    }
+
+    /**
+     * @brief Obtiene estadísticas detalladas de la política
+     * @return std::string con las estadísticas formateadas
+     */
+    std::string ObtenerEstadisticas() const override {
+        std::ostringstream ss;
+        ss << "\n=== ESTADÍSTICAS POLÍTICA 2Q ===\n";
+        ss << "Total de accesos: " << estadisticas_.total_accesos << "\n";
+        ss << "Total de desalojos: " << estadisticas_.total_desalojos
+           << " (A1: " << estadisticas_.desalojos_a1 << ", Am: " << estadisticas_.desalojos_am << ")\n";
+        ss << "Promociones A1out → Am: " << estadisticas_.promociones_a_am << "\n";
+        ss << "Total de anclajes: " << estadisticas_.total_anclajes << "\n";
+        ss << "Total de desanclajes: " << estadisticas_.total_desanclajes << "\n";
+        ss << "Frames agregados: " << estadisticas_.frames_agregados << "\n";
+        ss << "Frames removidos: " << estadisticas_.frames_removidos << "\n";
+        ss << "Frames en A1in: " << a1_.tamaño << "\n";
+        ss << "Frames en Am: " << am_.tamaño << "\n";
+        ss << "Bloques recordados en A1out: " << a1out_.size() << " (máximo " << CuotaA1out() << ")\n";
+
+        if (estadisticas_.total_accesos > 0) {
+            double tasa_desalojos = (double)estadisticas_.total_desalojos / estadisticas_.total_accesos * 100.0;
+            ss << "Tasa de desalojos: " << std::fixed << std::setprecision(2) << tasa_desalojos << "%\n";
+        }
+
+        return ss.str();
+    }
+
+    /**
+     * @brief Verifica si un frame puede ser desalojado
+     * @param id_frame ID del frame a verificar
+     * @return true si puede ser desalojado, false en caso contrario
+     */
+    bool PuedeSerDesalojado(FrameId id_frame) const override {
+        return Contiene(id_frame) && !anclado_[id_frame];
+    }
+
+    /**
+     * @brief Obtiene el número de frames gestionados
+     * @return uint32_t número de frames
+     */
+    uint32_t ObtenerNumeroFrames() const override {
+        return a1_.tamaño + am_.tamaño;
+    }
+
+    /**
+     * @brief Valida la consistencia interna de la política
+     * @return Status::OK si es consistente, error en caso contrario
+     */
+    Status ValidarConsistencia() const override {
+        // Recorrer cada lista comprobando enlaces, pertenencia y tamaño
+        const ListaFrames* listas[] = {&a1_, &am_};
+        const Cola colas[] = {Cola::A1, Cola::AM};
+        uint32_t total_enlazados = 0;
+        for (int i = 0; i < 2; ++i) {
+            uint32_t contador = 0;
+            FrameId previo = SIN_ENLACE;
+            for (FrameId actual = listas[i]->cabeza; actual != SIN_ENLACE; actual = siguiente_[actual]) {
+                if (cola_frame_[actual] != colas[i] || anterior_[actual] != previo) {
+                    return Status::ERROR;
+                }
+                previo = actual;
+                if (++contador > cola_frame_.size()) {
+                    return Status::ERROR; // Ciclo en la lista
+                }
+            }
+            if (contador != listas[i]->tamaño || previo != listas[i]->cola) {
+                return Status::ERROR;
+            }
+            total_enlazados += contador;
+        }
+
+        uint32_t total_marcados = 0;
+        for (Cola cola : cola_frame_) {
+            if (cola != Cola::NINGUNA) total_marcados++;
+        }
+        if (a1out_.size() != posicion_a1out_.size() || a1out_.size() > CuotaA1out()) {
+            return Status::ERROR;
+        }
+        return (total_marcados == total_enlazados) ? Status::OK : Status::ERROR;
+    }
+};
+
+#endif // DOS_COLAS_ESPANOL_H
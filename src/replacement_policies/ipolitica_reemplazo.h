@@ -17,6 +17,8 @@
  * POLÍTICAS SOPORTADAS:
  * - LRU (Least Recently Used): Reemplaza la página menos recientemente usada
  * - CLOCK: Algoritmo de reloj con bit de referencia
+ * - CLOCK ATÓMICO: Reloj sin bloqueos con bits de referencia atómicos
+ * - 2Q: Dos colas (A1 FIFO + Am LRU), resistente a recorridos secuenciales
  * - FIFO: First In, First Out (opcional)
  * - RANDOM: Selección aleatoria (opcional para pruebas)
  */
@@ -94,6 +96,59 @@ public:
      */
     virtual void RemoverFrame(FrameId id_frame) = 0;
 
+    /**
+     * @brief Añade un frame con prioridad baja (por ejemplo, una página precargada)
+     * 
+     * Las páginas traídas por lectura anticipada todavía no han sido usadas, así que
+     * no deben desplazar al conjunto de trabajo: la política las coloca donde serán
+     * las primeras candidatas a desalojo. Un acceso posterior las promociona como
+     * a cualquier otro frame. Por defecto equivale a AgregarFrame.
+     * 
+     * @param id_frame El ID del frame que ha sido añadido
+     */
+    virtual void AgregarFrameBajaPrioridad(FrameId id_frame) {
+        AgregarFrame(id_frame);
+    }
+
+    /**
+     * @brief Informa del bloque que va a ocupar un frame, justo antes de agregarlo
+     * 
+     * Solo lo necesitan las políticas que recuerdan páginas ya desalojadas (la
+     * cola A1out de 2Q guarda BlockIds, no frames). Por defecto no hace nada.
+     * 
+     * @param id_frame El ID del frame que se va a agregar
+     * @param id_bloque El bloque que contendrá
+     */
+    virtual void AsignarBloque(FrameId id_frame, BlockId id_bloque) {
+        (void)id_frame;
+        (void)id_bloque;
+    }
+
+    /**
+     * @brief Aparta un candidato a desalojo que el GestorBuffer no pudo desalojar
+     * 
+     * Se llama cuando la víctima propuesta está anclada o sucia. No debe contar
+     * como una referencia real (en 2Q no promociona el frame). Por defecto
+     * equivale a Acceder.
+     * 
+     * @param id_frame El ID del frame a posponer
+     */
+    virtual void Posponer(FrameId id_frame) {
+        Acceder(id_frame);
+    }
+
+    /**
+     * @brief Indica si Acceder puede llamarse concurrentemente sin exclusión externa
+     * 
+     * Si es true, el GestorBuffer registra los aciertos de caché sin tomar el
+     * mutex de la política; el resto de operaciones siguen serializadas.
+     * 
+     * @return true si Acceder es seguro entre hilos
+     */
+    virtual bool EsSeguraEntreHilos() const {
+        return false;
+    }
+
     /**
      * @brief Reinicia la política a su estado inicial
      * 
@@ -6,6 +6,7 @@
 
 #include "ipolitica_reemplazo.h"
 #include <list>
+#include <iterator> // Para std::prev
 #include <unordered_map>
 #include <unordered_set>
 #include <chrono>
@@ -186,6 +187,26 @@ public:
         estadisticas_.frames_agregados++;
     }
     
+    /**
+     * @brief Agrega un frame en el extremo menos recientemente usado de la lista
+     * @param id_frame ID del frame a agregar
+     */
+    void AgregarFrameBajaPrioridad(FrameId id_frame) override {
+        if (mapa_frames_.find(id_frame) != mapa_frames_.end()) {
+            std::cerr << "Advertencia: Intento de agregar frame existente: " 
+                      << id_frame << std::endl;
+            return;
+        }
+        
+        // Al final de la lista: será desalojado antes que el conjunto de trabajo
+        lista_lru_.emplace_back(id_frame);
+        auto iterador = std::prev(lista_lru_.end());
+        iterador->timestamp_acceso = ObtenerTimestampActual();
+        mapa_frames_[id_frame] = iterador;
+        
+        estadisticas_.frames_agregados++;
+    }
+    
     /**
      * @brief Remueve un frame de la política
      * @param id_frame ID del frame a remover